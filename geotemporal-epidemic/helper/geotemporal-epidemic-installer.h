@@ -120,9 +120,22 @@ private:
    *   vehicles during the entire 'low' density simulation, 6,370 vehicles
    *   for the 'medium' density simulation, and 9,080 vehicles for the
    *   'high' density simulation.
+   * 
+   * - custom: Uses the input files whose names start with the prefix in
+   *   <code>m_mobility_scenario_files_prefix</code>.
    */
   std::string m_mobility_scenario_id;
 
+  /**
+   * Prefix of the names of the input files of the custom mobility scenario.
+   * Only used when the custom mobility scenario is selected.
+   * 
+   * The names of the input files are made of the prefix followed by 
+   * ".graph.txt", ".junctions.txt", ".routes.txt", ".ns2.mob.tcl", 
+   * ".random_geo_temporal_areas.txt" and ".geo_temporal_areas_visitor_nodes.txt".
+   */
+  std::string m_mobility_scenario_files_prefix;
+
   /** 
    * The number of vehicle nodes to create. Only actively used when the fixed 
    * mobility scenario is selected.
@@ -181,6 +194,15 @@ private:
    */
   uint32_t m_data_packet_hops_count;
 
+  /** Indicates if the packet headers use the compact coordinates encoding. */
+  bool m_compact_header_encoding;
+
+  /** Encoding of the summary vectors (Explicit, DeltaCoded or BloomFilter). */
+  std::string m_summary_vector_encoding;
+
+  /** False positive rate of the Bloom filters of the summary vectors. */
+  double m_summary_vector_false_positive_rate;
+
 
   // --------------------------
   // Input files
@@ -217,6 +239,17 @@ private:
   std::string m_statistics_output_filename;
 
 
+  // --------------------------
+  // Results
+  // --------------------------
+
+  /** Number of events executed by the simulator during the simulation. */
+  uint64_t m_simulator_events_count;
+
+  /** The statistics computed in the last call to <code>Report</code>. */
+  SimulationStatisticsValues m_statistics_values;
+
+
 public:
 
   GeoTemporalEpidemicInstaller ();
@@ -230,6 +263,24 @@ public:
     return m_node_id_to_ip;
   }
 
+  /** Returns the number of events executed by the simulator during the simulation. */
+  inline uint64_t
+  GetSimulatorEventsCount () const
+  {
+    return m_simulator_events_count;
+  }
+
+  /**
+   * Returns the statistics computed in the last call to <code>Report</code>.
+   * Their values are not initialized if the statistics weren't computed (e.g. 
+   * in the fixed mobility scenario).
+   */
+  inline const SimulationStatisticsValues &
+  GetStatisticsValues () const
+  {
+    return m_statistics_values;
+  }
+
 
   /**
    * Receives user input and configures the simulation, mobility and routing 
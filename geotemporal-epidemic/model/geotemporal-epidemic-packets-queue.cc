@@ -43,6 +43,51 @@ namespace ns3
 namespace geotemporal_epidemic
 {
 
+// =============================================================================
+//                              DisjointVectorFilter
+// =============================================================================
+
+/**
+ * Forwarding filter of the disjoint vector of the Geo-Temporal Epidemic
+ * protocol. A packet is forwarded if:
+ * 1. the other node is NOT the source node of the packet, and
+ * 2. the packet has a hop count greater than 1 or equal to 1 and the other
+ *    node is inside the packet's destination geo-temporal area.
+ */
+class DisjointVectorFilter
+{
+private:
+
+  const Ipv4Address & m_destination_node_ip;
+  const GeoTemporalLibrary::LibraryUtils::Vector2D & m_receiver_node_position;
+  const Time m_current_time;
+
+public:
+
+  DisjointVectorFilter (const Ipv4Address & destination_node_ip,
+                        const GeoTemporalLibrary::LibraryUtils::Vector2D & receiver_node_position)
+  : m_destination_node_ip (destination_node_ip), m_receiver_node_position (receiver_node_position),
+  m_current_time (Simulator::Now ()) { }
+
+  bool
+  operator() (const PacketQueueEntry & entry) const
+  {
+    // If destination node is the source node, don't insert it into disjoint vector.
+    if (entry.GetSourceNodeIp () == m_destination_node_ip)
+      return false;
+
+    const uint32_t hops_count = entry.GetHopsCount ();
+    NS_ABORT_MSG_IF (hops_count == 0u,
+                     "The hops count of the packets shouldn't be equal to 0.");
+
+    // If packet's hops count is 1 AND the destination node is not inside the
+    // destination geo-temporal area, then don't insert it into disjoint vector.
+    return hops_count > 1u
+            || entry.GetDataPacket ().GetDestinationGeoTemporalArea ()
+            .IsInsideGeoTemporalArea (m_receiver_node_position, m_current_time);
+  }
+};
+
 // =============================================================================
 //                                PacketQueueEntry
 // =============================================================================
@@ -85,15 +130,11 @@ PacketQueueEntry::ToString () const
 PacketsQueue::PacketsQueue () : PacketsQueue (128u) { }
 
 PacketsQueue::PacketsQueue (uint32_t maximum_queue_length)
-: m_max_queue_length (maximum_queue_length),
-m_packets_dropped_counter (0u),
-m_packets_table (),
+: m_packets_table (maximum_queue_length),
 m_data_packet_reception_stats () { }
 
 PacketsQueue::PacketsQueue (const PacketsQueue& copy)
-: m_max_queue_length (copy.m_max_queue_length),
-m_packets_dropped_counter (copy.m_packets_dropped_counter),
-m_packets_table (copy.m_packets_table),
+: m_packets_table (copy.m_packets_table),
 m_data_packet_reception_stats (copy.m_data_packet_reception_stats) { }
 
 
@@ -178,68 +219,28 @@ PacketsQueue::ProcessDisjointVector (const SummaryVectorHeader& summary_vector_h
   // Clean the disjoint vector.
   disjoint_vector.clear ();
 
-  uint32_t hops_count = 0u, added_packets_counter = 0u;
+  // The packets in queue that are not contained in the summary vector are 
+  // found in a single merge pass over the sorted identifiers of both. A Bloom
+  // filter can't be listed, so the packets in queue are tested against it.
+  std::vector<DataIdentifier> unknown_packets;
 
-  const Time current_time = Simulator::Now ();
-  const std::set<DataIdentifier> & summary_vector = summary_vector_header.GetSummaryVector ();
-  const GeoTemporalLibrary::LibraryUtils::Vector2D & receiver_node_position
-          = summary_vector_header.GetPosition ();
+  if (summary_vector_header.GetSummaryVectorEncoding () == SummaryVectorEncoding::BloomFilter)
+    m_packets_table.GetUnknownPackets (summary_vector_header.GetBloomFilter (), unknown_packets);
+  else
+    m_packets_table.GetUnknownPackets (summary_vector_header.GetSummaryVector (), unknown_packets);
 
-  // Iterate through all the packets in queue
-  for (ConstIterator_t entry_it = m_packets_table.begin ();
-          entry_it != m_packets_table.end (); ++entry_it)
-    {
-      /* Check if the data identifier of the current packet exists in the 
-       * received summary vector. If it doesn't exist then insert it into the 
-       * disjoint vector.
-       * 
-       * Also check that:
-       * 1. the other node is NOT the source node of the packet, and
-       * 2. the packet has a hop count greater than 1 or equal to 1 and the
-       *    other node is inside the packet's destination geo-temporal area.
-       */
-
-      // If packet is contained in the summary vector, don't insert it into disjoint vector.
-      if (summary_vector.find (entry_it->first) != summary_vector.end ())
-        continue;
-
-      // If destination node is the source node, don't insert it into disjoint vector.
-      if (entry_it->second.GetSourceNodeIp () == destination_node_ip)
-        continue;
-
-      hops_count = entry_it->second.GetHopsCount ();
-      NS_ABORT_MSG_IF (hops_count == 0u,
-                       "The hops count of the packets shouldn't be equal to 0.");
-
-      // If packet's hops count is 1 AND the destination node is not inside the
-      // destination geo-temporal area, then don't insert it into disjoint vector.
-      if (hops_count == 1u
-          && !entry_it->second.GetDataPacket ().GetDestinationGeoTemporalArea ()
-          .IsInsideGeoTemporalArea (receiver_node_position, current_time))
-        continue;
-
-      /* At this point the packet fulfills all of the following:
-       * - Is not contained in the summary vector.
-       * - Destination node is not the source node.
-       * - It has at least 1 hop left.
-       * 
-       * Add it to the disjoint vector.
-       */
-      disjoint_vector.insert (entry_it->first);
-      ++added_packets_counter;
-    }
+  // Add to the disjoint vector the unknown packets that the other node can
+  // receive.
+  const uint32_t added_packets_counter
+          = m_packets_table.FilterPackets (unknown_packets,
+                                           DisjointVectorFilter (destination_node_ip,
+                                                                 summary_vector_header.GetPosition ()),
+                                           disjoint_vector);
 
   NS_LOG_DEBUG (added_packets_counter << " / " << m_packets_table.size ()
                 << " packets added to the disjoint vector.");
 }
 
-bool
-PacketsQueue::ComparePacketEntriesExpirationTime (const std::map<DataIdentifier, PacketQueueEntry>::value_type& entry_1,
-                                                  const std::map<DataIdentifier, PacketQueueEntry>::value_type& entry_2)
-{
-  return entry_1.second.GetExpirationTime () < entry_2.second.GetExpirationTime ();
-}
-
 bool
 PacketsQueue::Enqueue (const DataHeader& data_header, const Ipv4Address& transmitter_ip)
 {
@@ -258,26 +259,22 @@ PacketsQueue::Enqueue (const DataHeader& data_header, const Ipv4Address& transmi
       return false;
     }
 
-  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_max_queue_length
+  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_packets_table.GetMaxLength ()
                 << " packets before insertion.");
 
   // Check if the queue is full.
-  if (m_packets_table.size () == m_max_queue_length)
+  if (m_packets_table.IsFull ())
     {
-      ++m_packets_dropped_counter;
-
       // Find oldest entry
-      Iterator_t entry_to_delete_it = std::min_element (m_packets_table.begin (),
-                                                        m_packets_table.end (),
-                                                        ComparePacketEntriesExpirationTime);
+      const DataIdentifier packet_to_drop = m_packets_table.SelectPacketToDrop ()->first;
 
       NS_LOG_DEBUG ("Drops the oldest packet due to full queue : "
-                    << entry_to_delete_it->second);
+                    << m_packets_table.at (packet_to_drop));
 
       // Log statistics about the packet drop
-      LogPacketDropped (entry_to_delete_it->first);
+      LogPacketDropped (packet_to_drop);
 
-      m_packets_table.erase (entry_to_delete_it);
+      m_packets_table.DropPacket (packet_to_drop);
     }
 
   std::pair<Iterator_t, bool> inserted_result;
@@ -285,7 +282,7 @@ PacketsQueue::Enqueue (const DataHeader& data_header, const Ipv4Address& transmi
                                                             PacketQueueEntry (data_header)));
 
   NS_LOG_DEBUG ("Packet successfully inserted : " << inserted_result.first->second);
-  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_max_queue_length
+  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_packets_table.GetMaxLength ()
                 << " packets after insertion.");
 
   // Save statistics about the packet reception.
@@ -300,19 +297,11 @@ PacketsQueue::Purge ()
 {
   NS_LOG_FUNCTION (this);
 
-  for (ConstIterator_t entry_it = m_packets_table.begin (); entry_it != m_packets_table.end ();)
-    {
-      if (entry_it->second.GetExpirationTime () <= Seconds (0))
-        {
-          NS_LOG_LOGIC ("Drops expired data packet entry : " << entry_it->second);
-          // m_packets_table.erase (entry_it++); // For C++03
-          entry_it = m_packets_table.erase (entry_it); // For C++11
-        }
-      else
-        {
-          ++entry_it;
-        }
-    }
+  std::vector<DataIdentifier> purged_packets;
+  m_packets_table.Purge (Simulator::Now (), &purged_packets);
+
+  if (!purged_packets.empty ())
+    NS_LOG_LOGIC ("Drops " << purged_packets.size () << " expired data packet entries.");
 }
 
 
@@ -387,7 +376,7 @@ PacketsQueue::ToString () const
   std::sprintf (buffer, "%u", (uint32_t) m_packets_table.size ());
   std::string str = "Packets queue has " + std::string (buffer) + " / ";
 
-  std::sprintf (buffer, "%u", m_max_queue_length);
+  std::sprintf (buffer, "%u", m_packets_table.GetMaxLength ());
   str += std::string (buffer) + " packet entries";
 
   return str;
@@ -36,6 +36,7 @@
 
 #include <ns3/geotemporal-utils.h>
 #include <ns3/packet-utils.h>
+#include <ns3/packets-queue-core.h>
 #include <ns3/statistics-utils.h>
 
 using namespace GeoTemporalLibrary::LibraryUtils;
@@ -127,6 +128,13 @@ public:
     m_expiration_time = packet_time_period.GetEndTime ();
   }
 
+  /** Returns the simulation time at which the entry expires. */
+  inline const Time &
+  GetExpirationInstant () const
+  {
+    return m_expiration_time;
+  }
+
 
   void
   Print (std::ostream &os) const;
@@ -179,31 +187,29 @@ class PacketsQueue
 {
 private:
 
+  /** Data packets table. When the queue is full, the packet that expires first
+   * is dropped. */
+  typedef PacketsQueueCore<PacketQueueEntry, DropEarliestExpiration> PacketsTable_t;
+
   /** 
-   * Maximum number of packet entries that the queue can store at once.
+   * Data packets table, with the maximum number of packet entries that the
+   * queue can store at once and the counter of packets dropped due to a full
+   * queue.
    * 
    * If the queue reaches this maximum number of packet entries and a new packet
    * is stored, then the oldest packet will be dropped from the queue before 
    * inserting the new one.
    */
-  uint32_t m_max_queue_length;
-
-  /**
-   * The counter of all packets dropped due to a full queue.
-   */
-  uint32_t m_packets_dropped_counter;
-
-  /** Data packets table. */
-  std::map<DataIdentifier, PacketQueueEntry> m_packets_table;
+  PacketsTable_t m_packets_table;
 
   /** Data packets stats. */
   std::map<DataIdentifier, DataPacketReceptionStats> m_data_packet_reception_stats;
 
   /** Packets table iterator. */
-  typedef std::map<DataIdentifier, PacketQueueEntry>::iterator Iterator_t;
+  typedef PacketsTable_t::iterator Iterator_t;
 
   /** Packets table constant iterator. */
-  typedef std::map<DataIdentifier, PacketQueueEntry>::const_iterator ConstIterator_t;
+  typedef PacketsTable_t::const_iterator ConstIterator_t;
 
   /** Packet statistics iterator. */
   typedef std::map<DataIdentifier, DataPacketReceptionStats>::iterator StatsIterator_t;
@@ -243,7 +249,7 @@ public:
   inline uint32_t
   GetMaxLength () const
   {
-    return m_max_queue_length;
+    return m_packets_table.GetMaxLength ();
   }
 
   /**
@@ -259,7 +265,7 @@ public:
   inline void
   SetMaxLength (uint32_t maximum_queue_length)
   {
-    m_max_queue_length = maximum_queue_length;
+    m_packets_table.SetMaxLength (maximum_queue_length);
   }
 
   /**
@@ -268,7 +274,7 @@ public:
   inline uint32_t
   GetDroppedPacketsCounter () const
   {
-    return m_packets_dropped_counter;
+    return m_packets_table.GetDroppedPacketsCounter ();
   }
 
   /**
@@ -382,6 +388,10 @@ public:
    * processes the disjoint vector, that is, the set of data packet identifiers 
    * that aren't contained in the summary vector.
    * 
+   * If the summary vector is encoded as a Bloom filter, the packets that the
+   * filter may contain are considered known by the other node, so a false
+   * positive of the filter leaves a packet out of the disjoint vector.
+   * 
    * The <code>disjoint_vector</code> parameter is always emptied. And then the
    * processed data is stored into it. The <code>disjoint_vector</code> may 
    * remain empty if there's no data to insert into it.
@@ -400,25 +410,6 @@ public:
                          std::set<DataIdentifier> & disjoint_vector) const;
 
 
-private:
-
-  /**
-   * Compares the expiration time of 2 packet queue entries and returns 
-   * <code>true</code> if <code>entry_1</code> is <i>less</i> than
-   * <code>entry_2</code>.
-   * 
-   * This comparison function object satisfies the requirements of Compare.
-   * 
-   * @return <code>true</code> if <code>entry_1</code> is <i>less</i> than
-   * <code>entry_2</code>
-   */
-  static bool
-  ComparePacketEntriesExpirationTime (const std::map<DataIdentifier, PacketQueueEntry>::value_type & entry_1,
-                                      const std::map<DataIdentifier, PacketQueueEntry>::value_type & entry_2);
-
-
-public:
-
   /**
    * Inserts a new packet queue entry to the packets queue.
    * 
@@ -446,6 +437,8 @@ private:
 
   /**
    * Removes all expired data packet entries from the data packets queue.
+   * 
+   * It only visits the entries whose expiration instant has passed.
    */
   void
   Purge ();
@@ -513,9 +506,7 @@ public:
 inline bool
 operator== (const PacketsQueue & lhs, const PacketsQueue & rhs)
 {
-  return lhs.m_max_queue_length == rhs.m_max_queue_length
-          && lhs.m_packets_dropped_counter == rhs.m_packets_dropped_counter
-          && lhs.m_packets_table == rhs.m_packets_table
+  return lhs.m_packets_table == rhs.m_packets_table
           && lhs.m_data_packet_reception_stats == rhs.m_data_packet_reception_stats;
 }
 
@@ -28,14 +28,20 @@
 
 #include <ns3/address.h>
 #include <ns3/boolean.h>
+#include <ns3/double.h>
+#include <ns3/enum.h>
 #include <ns3/ipv4-l3-protocol.h>
 #include <ns3/log.h>
 #include <ns3/mobility-model.h>
 #include <ns3/node.h>
 #include <ns3/pointer.h>
 #include <ns3/string.h>
+#include <ns3/txop.h>
 #include <ns3/udp-socket-factory.h>
 #include <ns3/uinteger.h>
+#include <ns3/wifi-mac.h>
+#include <ns3/wifi-mac-queue.h>
+#include <ns3/wifi-net-device.h>
 
 
 namespace ns3
@@ -58,6 +64,11 @@ m_hello_timer (Timer::CANCEL_ON_DESTROY),
 m_packets_queue_capacity (128u),
 m_neighbor_expiration_time (Seconds (10)),
 m_default_packets_hops_count (8u),
+m_max_mac_queue_packets (4u),
+m_data_pacing_interval (MilliSeconds (1)),
+m_compact_header_encoding (false),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit),
+m_summary_vector_false_positive_rate (0.01),
 m_node_id (-1),
 m_ipv4 (0),
 m_selected_interface_index (-1),
@@ -70,7 +81,8 @@ m_packets_queue (m_packets_queue_capacity),
 m_neighbors_table (m_neighbor_expiration_time),
 m_duplicate_detector (MilliSeconds (5600)),
 m_tx_packets_counter (),
-m_created_data_packets ()
+m_created_data_packets (),
+m_data_pacers ()
 {
   NS_LOG_FUNCTION (this);
 }
@@ -103,6 +115,28 @@ RoutingProtocol::GetTypeId ()
                          UintegerValue (8),
                          MakeUintegerAccessor (&RoutingProtocol::m_default_packets_hops_count),
                          MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("MaxMacQueuePackets", "Maximum number of packets in the MAC queue of the WiFi device up to which pending DATA packets are passed to it.",
+                         UintegerValue (4),
+                         MakeUintegerAccessor (&RoutingProtocol::m_max_mac_queue_packets),
+                         MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("DataPacingInterval", "Time interval between the checks of the pending DATA packets of a neighbor.",
+                         TimeValue (MilliSeconds (1)),
+                         MakeTimeAccessor (&RoutingProtocol::m_data_pacing_interval),
+                         MakeTimeChecker ())
+          .AddAttribute ("CompactHeaderEncoding", "Transmit positions and areas with the compact (fixed-point, variable-length) encoding.",
+                         BooleanValue (false),
+                         MakeBooleanAccessor (&RoutingProtocol::m_compact_header_encoding),
+                         MakeBooleanChecker ())
+          .AddAttribute ("SummaryVectorEncoding", "Encoding of the summary vectors of the transmitted REPLY and REPLY_BACK packets.",
+                         EnumValue ((int) SummaryVectorEncoding::Explicit),
+                         MakeEnumAccessor (&RoutingProtocol::SetSummaryVectorEncoding),
+                         MakeEnumChecker ((int) SummaryVectorEncoding::Explicit, "Explicit",
+                                          (int) SummaryVectorEncoding::DeltaCoded, "DeltaCoded",
+                                          (int) SummaryVectorEncoding::BloomFilter, "BloomFilter"))
+          .AddAttribute ("SummaryVectorFalsePositiveRate", "False positive rate of the Bloom filters of the transmitted summary vectors.",
+                         DoubleValue (0.01),
+                         MakeDoubleAccessor (&RoutingProtocol::m_summary_vector_false_positive_rate),
+                         MakeDoubleChecker<double> (0.0001, 0.5))
           .AddAttribute ("UniformRv", "Access to the underlying UniformRandomVariable",
                          StringValue ("ns3::UniformRandomVariable"),
                          MakePointerAccessor (&RoutingProtocol::m_uniform_random_variable),
@@ -653,6 +687,8 @@ RoutingProtocol::RecvEpidemicPacket (Ptr<Socket> socket)
 
   NS_ASSERT (type_header.IsValid ());
 
+  const bool compact_encoding = type_header.IsCompactEncoding ();
+
   NS_LOG_DEBUG ("Epidemic " << type_header << " packet received from node "
                 << sender_node_ip);
 
@@ -662,13 +698,15 @@ RoutingProtocol::RecvEpidemicPacket (Ptr<Socket> socket)
       RecvHelloPacket (received_packet, sender_node_ip);
       return;
     case PacketType::Reply:
-      RecvSummaryVectorPacket (received_packet, sender_node_ip, PacketType::Reply);
+      RecvSummaryVectorPacket (received_packet, sender_node_ip, PacketType::Reply,
+                               compact_encoding, type_header.GetSummaryVectorEncoding ());
       return;
     case PacketType::ReplyBack:
-      RecvSummaryVectorPacket (received_packet, sender_node_ip, PacketType::ReplyBack);
+      RecvSummaryVectorPacket (received_packet, sender_node_ip, PacketType::ReplyBack,
+                               compact_encoding, type_header.GetSummaryVectorEncoding ());
       return;
     case PacketType::Data:
-      RecvDataPacket (received_packet, sender_node_ip);
+      RecvDataPacket (received_packet, sender_node_ip, compact_encoding);
       return;
     default:
       NS_ABORT_MSG ("ERROR: Unknown packet type.");
@@ -719,9 +757,12 @@ RoutingProtocol::RecvHelloPacket (Ptr<Packet> received_packet, const Ipv4Address
 void
 RoutingProtocol::RecvSummaryVectorPacket (Ptr<Packet> received_packet,
                                           const Ipv4Address& sender_node_ip,
-                                          const PacketType& reply_type)
+                                          const PacketType& reply_type,
+                                          bool compact_encoding,
+                                          SummaryVectorEncoding summary_vector_encoding)
 {
-  NS_LOG_FUNCTION (this << received_packet << sender_node_ip << reply_type);
+  NS_LOG_FUNCTION (this << received_packet << sender_node_ip << reply_type << compact_encoding
+                   << summary_vector_encoding);
 
   if (reply_type != PacketType::Reply && reply_type != PacketType::ReplyBack)
     NS_ABORT_MSG ("Packet type must be Reply or ReplyBack.");
@@ -729,6 +770,8 @@ RoutingProtocol::RecvSummaryVectorPacket (Ptr<Packet> received_packet,
   NS_LOG_DEBUG ("Processing " << reply_type << " packet received from " << sender_node_ip);
 
   SummaryVectorHeader summary_vector_header;
+  summary_vector_header.SetCompactEncoding (compact_encoding);
+  summary_vector_header.SetSummaryVectorEncoding (summary_vector_encoding);
   received_packet->RemoveHeader (summary_vector_header);
 
   NS_LOG_DEBUG ("Process summary vector with " << summary_vector_header.GetSummaryVectorSize ()
@@ -745,11 +788,13 @@ RoutingProtocol::RecvSummaryVectorPacket (Ptr<Packet> received_packet,
 }
 
 void
-RoutingProtocol::RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip)
+RoutingProtocol::RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip,
+                                 bool compact_encoding)
 {
-  NS_LOG_FUNCTION (this << received_packet << sender_node_ip);
+  NS_LOG_FUNCTION (this << received_packet << sender_node_ip << compact_encoding);
 
   DataHeader data_header;
+  data_header.SetCompactEncoding (compact_encoding);
   received_packet->RemoveHeader (data_header);
   NS_LOG_DEBUG ("Received DATA packet <" << data_header << "> from node " << sender_node_ip);
 
@@ -918,12 +963,24 @@ RoutingProtocol::SendSummaryVectorPacket (const Ipv4Address& destination_node,
 
   SummaryVectorHeader summary_vector_header (/*Summary vector*/ known_packets_vector,
                                              /*Position*/ my_position);
+  summary_vector_header.SetSummaryVectorEncoding (m_summary_vector_encoding);
+
+  if (m_summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+    {
+      summary_vector_header.SetBloomFilter (DataIdentifierBloomFilter (known_packets_vector,
+                                                                       m_summary_vector_false_positive_rate),
+                                            known_packets_vector.size ());
+    }
+
   NS_LOG_DEBUG ("Constructed SUMMARY VECTOR (" << reply_type << ") packet: "
                 << summary_vector_header);
 
+  summary_vector_header.SetCompactEncoding (m_compact_header_encoding);
+
   Ptr<Packet> packet_to_send = Create<Packet> ();
   packet_to_send->AddHeader (summary_vector_header);
-  packet_to_send->AddHeader (TypeHeader (reply_type));
+  packet_to_send->AddHeader (TypeHeader (reply_type, m_compact_header_encoding,
+                                         m_summary_vector_encoding));
 
   // Transmit the packet
   if (SendUnicastPacket (packet_to_send, destination_node))
@@ -957,55 +1014,40 @@ RoutingProtocol::SendDisjointVectorPackets (const SummaryVectorHeader& summary_v
                                          destination_ip,
                                          disjoint_vector);
 
-  // To avoid collisions, packets are sent X milliseconds apart of each other,
-  // where X is the value of incremental_time_slot.
-  uint16_t incremental_time_slot = 0u;
-
-  PacketQueueEntry packet_entry;
-
   if (disjoint_vector.empty ())
     {
       NS_LOG_DEBUG ("Disjoint vector empty, no packets to send to node " << destination_ip);
       return;
     }
 
-  NS_LOG_DEBUG ("Schedule to send " << disjoint_vector.size ()
-                << " packets from the disjoint vector.");
-
-  for (std::set<DataIdentifier>::const_iterator packet_it = disjoint_vector.begin ();
-          packet_it != disjoint_vector.end (); ++packet_it)
-    {
-      if (!m_packets_queue.Find (*packet_it, packet_entry))
-        {
-          NS_LOG_DEBUG ("Packet " << *packet_it << " not in packets queue.");
-          continue;
-        }
+  DataTransmitPacer & pacer = m_data_pacers[destination_ip];
+  pacer.m_pending_packets.insert (disjoint_vector.begin (), disjoint_vector.end ());
 
-      NS_LOG_DEBUG ("DATA packet to be sent: " << packet_entry.GetDataPacket ());
+  NS_LOG_DEBUG (pacer.m_pending_packets.size () << " packets pending to be sent to node "
+                << destination_ip);
 
-      Simulator::Schedule (MilliSeconds (incremental_time_slot),
-                           &RoutingProtocol::SendDataPacket,
-                           this,
-                           destination_ip,
-                           packet_entry.GetDataPacket ());
-      NS_LOG_DEBUG ("Scheduled DATA packet " << packet_entry.GetDataPacket ().GetDataIdentifier ()
-                    << " in " << incremental_time_slot << " milliseconds.");
-      ++incremental_time_slot;
+  if (pacer.m_send_event.IsRunning ())
+    {
+      NS_LOG_DEBUG ("Transmission to node " << destination_ip << " already scheduled.");
+      return;
     }
 
-  NS_LOG_DEBUG (disjoint_vector.size () << " were scheduled to be sent to node "
-                << destination_ip);
+  pacer.m_send_event = Simulator::ScheduleNow (&RoutingProtocol::SendPendingDataPackets,
+                                               this, destination_ip);
 }
 
 void
-RoutingProtocol::SendDataPacket (const Ipv4Address destination_ip,
-                                 const DataHeader data_to_send)
+RoutingProtocol::SendDataPacket (const Ipv4Address& destination_ip,
+                                 const DataHeader& data_to_send)
 {
   NS_LOG_FUNCTION (this << destination_ip << data_to_send);
 
+  DataHeader data_header (data_to_send);
+  data_header.SetCompactEncoding (m_compact_header_encoding);
+
   Ptr<Packet> packet_to_send = Create<Packet> ();
-  packet_to_send->AddHeader (data_to_send);
-  packet_to_send->AddHeader (TypeHeader (PacketType::Data));
+  packet_to_send->AddHeader (data_header);
+  packet_to_send->AddHeader (TypeHeader (PacketType::Data, m_compact_header_encoding));
 
   // Transmit the packet
   if (SendUnicastPacket (packet_to_send, destination_ip))
@@ -1027,6 +1069,103 @@ RoutingProtocol::SendDataPacket (const Ipv4Address destination_ip,
     }
 }
 
+void
+RoutingProtocol::SendPendingDataPackets (const Ipv4Address destination_ip)
+{
+  NS_LOG_FUNCTION (this << destination_ip);
+
+  std::map<Ipv4Address, DataTransmitPacer>::iterator pacer_it = m_data_pacers.find (destination_ip);
+
+  if (pacer_it == m_data_pacers.end ())
+    return;
+
+  std::set<DataIdentifier> & pending_packets = pacer_it->second.m_pending_packets;
+
+  // Number of packets that can be passed to the WiFi device now.
+  uint32_t packets_to_send = 1u;
+  uint32_t mac_queue_size = 0u;
+
+  if (GetMacQueueSize (mac_queue_size))
+    {
+      packets_to_send = mac_queue_size < m_max_mac_queue_packets
+              ? m_max_mac_queue_packets - mac_queue_size : 0u;
+      NS_LOG_DEBUG ("MAC queue has " << mac_queue_size << " packets, "
+                    << packets_to_send << " DATA packets can be sent.");
+    }
+
+  PacketQueueEntry packet_entry;
+
+  while (packets_to_send > 0u && !pending_packets.empty ())
+    {
+      const DataIdentifier data_id = *pending_packets.begin ();
+      pending_packets.erase (pending_packets.begin ());
+
+      // The packet may have been dropped since it was added to the pacer.
+      if (!m_packets_queue.Find (data_id, packet_entry))
+        {
+          NS_LOG_DEBUG ("Packet " << data_id << " not in packets queue.");
+          continue;
+        }
+
+      SendDataPacket (destination_ip, packet_entry.GetDataPacket ());
+      --packets_to_send;
+    }
+
+  if (pending_packets.empty ())
+    {
+      NS_LOG_DEBUG ("No more packets pending to be sent to node " << destination_ip);
+      m_data_pacers.erase (pacer_it);
+      return;
+    }
+
+  pacer_it->second.m_send_event = Simulator::Schedule (m_data_pacing_interval,
+                                                       &RoutingProtocol::SendPendingDataPackets,
+                                                       this, destination_ip);
+}
+
+void
+RoutingProtocol::CancelPendingDataPackets ()
+{
+  NS_LOG_FUNCTION (this);
+
+  for (std::map<Ipv4Address, DataTransmitPacer>::iterator pacer_it = m_data_pacers.begin ();
+          pacer_it != m_data_pacers.end (); ++pacer_it)
+    pacer_it->second.m_send_event.Cancel ();
+
+  m_data_pacers.clear ();
+}
+
+bool
+RoutingProtocol::GetMacQueueSize (uint32_t& queue_size) const
+{
+  if (m_ipv4 == 0 || m_selected_interface_index < 0)
+    return false;
+
+  Ptr<WifiNetDevice> wifi_device = DynamicCast<WifiNetDevice> (m_ipv4->GetNetDevice (m_selected_interface_index));
+
+  if (wifi_device == 0)
+    return false;
+
+  // Non-QoS MACs (like the IEEE 802.11p MAC) queue all the packets in the Txop,
+  // QoS MACs queue the best effort packets in the BE_Txop.
+  Ptr<WifiMac> wifi_mac = wifi_device->GetMac ();
+  BooleanValue qos_supported (false);
+  PointerValue txop_pointer;
+
+  wifi_mac->GetAttributeFailSafe ("QosSupported", qos_supported);
+
+  if (!wifi_mac->GetAttributeFailSafe (qos_supported.Get () ? "BE_Txop" : "Txop", txop_pointer))
+    return false;
+
+  Ptr<Txop> txop = txop_pointer.Get<Txop> ();
+
+  if (txop == 0 || txop->GetWifiMacQueue () == 0)
+    return false;
+
+  queue_size = txop->GetWifiMacQueue ()->GetNPackets ();
+  return true;
+}
+
 void
 RoutingProtocol::Start ()
 {
@@ -1060,6 +1199,7 @@ RoutingProtocol::Stop ()
   NS_LOG_FUNCTION (this);
 
   CancelHelloPacketTransmission ();
+  CancelPendingDataPackets ();
 
   // Clear memory that won't be used
   m_neighbors_table.Clear ();
@@ -26,6 +26,7 @@
 #define GEOTEMPORAL_EPIDEMIC_ROUTING_PROTOCOL_H
 
 #include <map>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -37,6 +38,7 @@
 #include <ns3/packet-utils.h>
 #include <ns3/statistics-utils.h>
 
+#include <ns3/event-id.h>
 #include <ns3/ipv4-address.h>
 #include <ns3/ipv4-interface-address.h>
 #include <ns3/ipv4-routing-protocol.h>
@@ -56,6 +58,12 @@ namespace ns3
 namespace geotemporal_epidemic
 {
 
+/* Forward declaration */
+namespace test
+{
+class RoutingProtocolTest;
+}
+
 using GeoTemporalLibrary::LibraryUtils::Vector2D;
 
 // =============================================================================
@@ -92,6 +100,27 @@ private:
   /** Maximum number of hops that the data packets are flooded before being discarded. */
   uint32_t m_default_packets_hops_count;
 
+  /** Maximum number of packets in the MAC queue of the WiFi device up to which
+   * pending DATA packets are passed to it. */
+  uint32_t m_max_mac_queue_packets;
+
+  /** Time interval between the checks of the transmit pacers, and between the
+   * DATA packets sent to a neighbor when the MAC queue can't be checked. */
+  Time m_data_pacing_interval;
+
+  /**
+   * Indicates if the transmitted packets use the compact coordinates encoding
+   * for positions and areas. Received packets are decoded according to the
+   * flag in their type header regardless of this value.
+   */
+  bool m_compact_header_encoding;
+
+  /** Encoding of the summary vectors of the transmitted REPLY and REPLY_BACK packets. */
+  SummaryVectorEncoding m_summary_vector_encoding;
+
+  /** False positive rate of the Bloom filters of the transmitted summary vectors. */
+  double m_summary_vector_false_positive_rate;
+
 
   // ---------------------
   // Internal variables
@@ -167,6 +196,21 @@ private:
   /** Stores a list of the data packets created in this node and its creation time. */
   std::vector<std::pair<DataHeader, Time> > m_created_data_packets;
 
+  /** Paces the transmission of the DATA packets of the disjoint vector of a 
+   * neighbor node. */
+  struct DataTransmitPacer
+  {
+    /** Identifiers of the DATA packets pending to be sent, in transmission 
+     * order. */
+    std::set<DataIdentifier> m_pending_packets;
+
+    /** Event that sends the next pending DATA packets. */
+    EventId m_send_event;
+  };
+
+  /** Transmit pacers of the neighbor nodes with pending DATA packets. */
+  std::map<Ipv4Address, DataTransmitPacer> m_data_pacers;
+
 
 public:
 
@@ -213,6 +257,22 @@ public:
     m_node_id = node_id;
   }
 
+  inline SummaryVectorEncoding
+  GetSummaryVectorEncoding () const
+  {
+    return m_summary_vector_encoding;
+  }
+
+  /**
+   * Sets the encoding of the summary vectors of the transmitted REPLY and REPLY_BACK packets.
+   * It takes an integer to be used as the setter of the enum attribute.
+   */
+  inline void
+  SetSummaryVectorEncoding (int summary_vector_encoding)
+  {
+    m_summary_vector_encoding = static_cast<SummaryVectorEncoding> (summary_vector_encoding);
+  }
+
   /** Returns the statistics of all received data packets by the node. */
   inline const std::map<DataIdentifier, DataPacketReceptionStats> &
   GetNodePacketReceptionStats () const
@@ -326,11 +386,16 @@ private:
    * @param sender_node_ip [IN] IP address of the node that sent the packet.
    * @param packet_type [IN] To indicate if the received packet is a REPLY packet
    * or a REPLY_BACK packet. With other packet types it throws a fatal error.
+   * @param compact_encoding [IN] Indicates if the received header uses the
+   * compact coordinates encoding.
+   * @param summary_vector_encoding [IN] Encoding of the received summary vector.
    */
   void
   RecvSummaryVectorPacket (Ptr<Packet> received_packet,
                            const Ipv4Address & sender_node_ip,
-                           const PacketType & reply_type);
+                           const PacketType & reply_type,
+                           bool compact_encoding,
+                           SummaryVectorEncoding summary_vector_encoding);
 
   /**
    * Processes the received DATA packets.
@@ -339,9 +404,12 @@ private:
    * top. The packet is modified, so if you want to conserve the original make
    * sure to use a copy of the received packet.
    * @param sender_node_ip [IN] IP address of the node that sent the packet.
+   * @param compact_encoding [IN] Indicates if the received header uses the
+   * compact coordinates encoding.
    */
   void
-  RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip);
+  RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip,
+                  bool compact_encoding);
 
 
 
@@ -407,6 +475,9 @@ private:
    * Summary Vector header to determine if it can send packets with only 1 hops
    * count remaining.
    * 
+   * The identifiers of the packets are added to the transmit pacer of the node,
+   * which sends them with <code>SendPendingDataPackets</code>.
+   * 
    * @param summary_vector_header [IN] Received summary vector header.
    * @param destination_ip [IN] IP address of the destination node.
    */
@@ -419,7 +490,34 @@ private:
    * IP address.
    */
   void
-  SendDataPacket (const Ipv4Address destination_ip, const DataHeader data_to_send);
+  SendDataPacket (const Ipv4Address & destination_ip, const DataHeader & data_to_send);
+
+  /**
+   * Sends the next pending DATA packets of the transmit pacer of the node with
+   * the specified IP address, and schedules the next call if there are still
+   * pending packets.
+   * 
+   * Packets are passed to the WiFi device while its MAC queue has less than 
+   * <code>MaxMacQueuePackets</code> packets. If the MAC queue can't be checked,
+   * one packet is sent per <code>DataPacingInterval</code>. Packets that are no
+   * longer in the packets queue are skipped.
+   */
+  void
+  SendPendingDataPackets (const Ipv4Address destination_ip);
+
+  /** Cancels the transmission of all the pending DATA packets. */
+  void
+  CancelPendingDataPackets ();
+
+  /**
+   * Stores the number of packets in the MAC queue of the WiFi device of the 
+   * selected interface in the output parameter <code>queue_size</code>.
+   * 
+   * Returns <code>false</code> if the device isn't a WiFi device or its MAC 
+   * queue can't be accessed.
+   */
+  bool
+  GetMacQueueSize (uint32_t & queue_size) const;
 
 
 
@@ -496,6 +594,7 @@ public:
   /** Disables the node. When disabled, it can not send nor receive packets. */
   void Disable ();
 
+  friend test::RoutingProtocolTest;
 };
 
 } // namespace geotemporal_epidemic
@@ -34,6 +34,24 @@
 #include <ns3/packet.h>
 #include <ns3/packet-utils.h>
 
+#include <ns3/boolean.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/internet-stack-helper.h>
+#include <ns3/ipv4.h>
+#include <ns3/ipv4-address-helper.h>
+#include <ns3/net-device-container.h>
+#include <ns3/node.h>
+#include <ns3/node-container.h>
+#include <ns3/pointer.h>
+#include <ns3/txop.h>
+#include <ns3/wifi-helper.h>
+#include <ns3/wifi-mac.h>
+#include <ns3/wifi-mac-header.h>
+#include <ns3/wifi-mac-queue.h>
+#include <ns3/wifi-mac-queue-item.h>
+#include <ns3/wifi-net-device.h>
+#include <ns3/yans-wifi-helper.h>
+
 using namespace GeoTemporalLibrary::LibraryUtils;
 
 
@@ -233,6 +251,79 @@ public:
     NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
   }
 
+  void
+  TestCompactEncodingFlag ()
+  {
+    TypeHeader h1 (PacketType::Data, true);
+    NS_TEST_EXPECT_MSG_EQ (h1.IsCompactEncoding (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 1u, "Must be 1u");
+
+    TypeHeader h2 (PacketType::Data);
+    NS_TEST_EXPECT_MSG_EQ (h2.IsCompactEncoding (), false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ ((h1 == h2), false, "Must be different");
+
+    h2.SetCompactEncoding (true);
+    NS_TEST_EXPECT_MSG_EQ (h1, h2, "Must be equal");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (TypeHeader (PacketType::Hello));
+    packet->AddHeader (h1);
+
+    TypeHeader deserialized;
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetPacketType (), PacketType::Data, "Must be Data");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsCompactEncoding (), true, "Must be true");
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetPacketType (), PacketType::Hello, "Must be Hello");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsCompactEncoding (), false, "Must be false");
+  }
+
+  void
+  TestSummaryVectorEncoding ()
+  {
+    TypeHeader h1 (PacketType::Reply, true, SummaryVectorEncoding::BloomFilter);
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSummaryVectorEncoding (), SummaryVectorEncoding::BloomFilter,
+                           "Must be BloomFilter");
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 1u, "Must be 1u");
+
+    TypeHeader h2 (PacketType::ReplyBack, false, SummaryVectorEncoding::DeltaCoded);
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSummaryVectorEncoding (), SummaryVectorEncoding::DeltaCoded,
+                           "Must be DeltaCoded");
+
+    TypeHeader h3 (PacketType::ReplyBack);
+    NS_TEST_EXPECT_MSG_EQ (h3.GetSummaryVectorEncoding (), SummaryVectorEncoding::Explicit,
+                           "Must be Explicit");
+    NS_TEST_EXPECT_MSG_EQ ((h2 == h3), false, "Must be different");
+
+    h3.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+    NS_TEST_EXPECT_MSG_EQ (h2, h3, "Must be equal");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h2);
+    packet->AddHeader (h1);
+
+    TypeHeader deserialized;
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized, h1, "Serialization and deserialization works");
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized, h2, "Serialization and deserialization works");
+
+    // The incremental summary vector encoding (bits 5-6 set) isn't supported.
+    uint8_t incremental_encoding = 0x60 | (uint8_t) PacketType::Reply;
+    packet = Create<Packet> (&incremental_encoding, 1u);
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), false, "Must be false");
+  }
+
   void
   DoRun () override
   {
@@ -240,6 +331,8 @@ public:
     TestGettersSetters ();
     TestOverloadedOperators ();
     TestSerializationDeserialization ();
+    TestCompactEncodingFlag ();
+    TestSummaryVectorEncoding ();
   }
 };
 
@@ -528,6 +621,142 @@ public:
     NS_TEST_EXPECT_MSG_EQ (h.ToString (), expected_str, "Expected string: " + expected_str);
   }
 
+  void
+  TestCompactSerializationDeserialization ()
+  {
+    std::set<DataIdentifier> summary_vector = {DataIdentifier (Ipv4Address ("1.1.1.1"), 1),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 2),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 3)};
+
+    SummaryVectorHeader h1;
+    SummaryVectorHeader h2 (std::set<DataIdentifier>({DataIdentifier (Ipv4Address ("1.1.1.1"), 1)}),
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (-54, 23));
+    SummaryVectorHeader h3 (summary_vector, GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4));
+
+    h1.SetCompactEncoding (true);
+    h2.SetCompactEncoding (true);
+    h3.SetCompactEncoding (true);
+
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 4u, "Must be 4u");
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSerializedSize (), 14u, "Must be 14u");
+    NS_TEST_EXPECT_MSG_EQ (h3.GetSerializedSize (), 24u, "Must be 24u");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+    packet->AddHeader (h2);
+    packet->AddHeader (h3);
+
+    SummaryVectorHeader deserialized;
+    deserialized.SetCompactEncoding (true);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 24u, "Compact SummaryVectorHeader is 24 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h3, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 14u, "Compact SummaryVectorHeader is 14 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 4u, "Compact SummaryVectorHeader is 4 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+
+    // The packet metadata recreates the headers from their type ID.
+    NS_TEST_EXPECT_MSG_EQ (h3.GetInstanceTypeId (), CompactSummaryVectorHeader::GetTypeId (),
+                           "Must be the type ID of the compact header");
+    NS_TEST_EXPECT_MSG_EQ (SummaryVectorHeader ().GetInstanceTypeId (), SummaryVectorHeader::GetTypeId (),
+                           "Must be the type ID of the fixed-size header");
+
+    packet->AddHeader (h3);
+
+    Callback<ObjectBase *> constructor = h3.GetInstanceTypeId ().GetConstructor ();
+    SummaryVectorHeader * recreated = dynamic_cast<SummaryVectorHeader *> (constructor ());
+
+    NS_TEST_EXPECT_MSG_EQ (recreated->IsCompactEncoding (), true, "Must use the compact encoding");
+
+    read_bytes = packet->RemoveHeader (*recreated);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 24u, "Compact SummaryVectorHeader is 24 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h3, *recreated, "Serialization and deserialization works");
+
+    delete recreated;
+  }
+
+  void
+  TestDeltaCodedSerializationDeserialization ()
+  {
+    std::set<DataIdentifier> summary_vector = {DataIdentifier (Ipv4Address ("1.1.1.1"), 1),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 2),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 3),
+      DataIdentifier (Ipv4Address ("2.2.2.2"), 300)};
+
+    SummaryVectorHeader h1;
+    SummaryVectorHeader h2 (summary_vector,
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (5, -14));
+
+    h1.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+    h2.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+
+    // 1 byte of groups count, (4 + 1 + 1 + 2) bytes of the first group and
+    // (4 + 1 + 2) bytes of the second group.
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 19u + 1u, "Must be 20u");
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSerializedSize (), 19u + 16u, "Must be 35u");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+    packet->AddHeader (h2);
+
+    SummaryVectorHeader deserialized;
+    deserialized.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 35u, "Delta-coded SummaryVectorHeader is 35 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, deserialized, "Serialization and deserialization works");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVector (), summary_vector, "Must be equal");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 20u, "Delta-coded SummaryVectorHeader is 20 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+  }
+
+  void
+  TestBloomFilterSerializationDeserialization ()
+  {
+    std::set<DataIdentifier> summary_vector = {DataIdentifier (Ipv4Address ("1.1.1.1"), 1),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 2),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 3),
+      DataIdentifier (Ipv4Address ("2.2.2.2"), 300)};
+
+    DataIdentifierBloomFilter bloom_filter (summary_vector, 0.01);
+
+    SummaryVectorHeader h1 (std::set<DataIdentifier> (),
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (5, -14));
+    h1.SetSummaryVectorEncoding (SummaryVectorEncoding::BloomFilter);
+    h1.SetBloomFilter (bloom_filter, summary_vector.size ());
+
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSummaryVectorSize (), 4u, "Must be 4u");
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 19u + bloom_filter.GetSerializedSize (),
+                           "Must be the size of the filter plus 19 bytes");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+
+    SummaryVectorHeader deserialized;
+    deserialized.SetSummaryVectorEncoding (SummaryVectorEncoding::BloomFilter);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, h1.GetSerializedSize (), "Must be the serialized size");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVectorSize (), 4u, "Must be 4u");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVector ().empty (), true, "Must be true");
+
+    for (std::set<DataIdentifier>::const_iterator it = summary_vector.begin ();
+            it != summary_vector.end (); ++it)
+      {
+        NS_TEST_EXPECT_MSG_EQ (deserialized.GetBloomFilter ().MayContain (*it), true,
+                               "Must be true");
+      }
+  }
+
   void
   DoRun () override
   {
@@ -535,6 +764,9 @@ public:
     TestGettersSetters ();
     TestOverloadedOperators ();
     TestSerializationDeserialization ();
+    TestCompactSerializationDeserialization ();
+    TestDeltaCodedSerializationDeserialization ();
+    TestBloomFilterSerializationDeserialization ();
     TestToString ();
   }
 };
@@ -714,6 +946,64 @@ public:
     NS_TEST_EXPECT_MSG_EQ (h.ToString (), expected_str, "Expected string: " + expected_str);
   }
 
+  void
+  TestCompactSerializationDeserialization ()
+  {
+    DataIdentifier data_id (Ipv4Address ("1.2.3.4"), 5u);
+    GeoTemporalArea gta (TimePeriod (Seconds (10), Seconds (20)), Area (30, 40, 50, 60));
+
+    DataHeader h1;
+    DataHeader h2 (data_id, gta, "Different message", 2u); // Message length = 17
+    DataHeader h3 (data_id, gta, "packet's message", 5u); // Message length = 16
+
+    h1.SetCompactEncoding (true);
+    h2.SetCompactEncoding (true);
+    h3.SetCompactEncoding (true);
+
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 16u, "Must be 16u");
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSerializedSize (), 41u, "Must be 41u");
+    NS_TEST_EXPECT_MSG_EQ (h3.GetSerializedSize (), 40u, "Must be 40u");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+    packet->AddHeader (h2);
+    packet->AddHeader (h3);
+
+    DataHeader deserialized;
+    deserialized.SetCompactEncoding (true);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 40u, "Compact DataHeader is 40 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h3, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 41u, "Compact DataHeader is 41 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 16u, "Compact DataHeader is 16 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+
+    // The packet metadata recreates the headers from their type ID.
+    NS_TEST_EXPECT_MSG_EQ (h3.GetInstanceTypeId (), CompactDataHeader::GetTypeId (),
+                           "Must be the type ID of the compact header");
+    NS_TEST_EXPECT_MSG_EQ (DataHeader ().GetInstanceTypeId (), DataHeader::GetTypeId (),
+                           "Must be the type ID of the fixed-size header");
+
+    packet->AddHeader (h3);
+
+    Callback<ObjectBase *> constructor = h3.GetInstanceTypeId ().GetConstructor ();
+    DataHeader * recreated = dynamic_cast<DataHeader *> (constructor ());
+
+    NS_TEST_EXPECT_MSG_EQ (recreated->IsCompactEncoding (), true, "Must use the compact encoding");
+
+    read_bytes = packet->RemoveHeader (*recreated);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 40u, "Compact DataHeader is 40 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h3, *recreated, "Serialization and deserialization works");
+
+    delete recreated;
+  }
+
   void
   DoRun () override
   {
@@ -721,6 +1011,7 @@ public:
     TestGettersSetters ();
     TestOverloadedOperators ();
     TestSerializationDeserialization ();
+    TestCompactSerializationDeserialization ();
     TestToString ();
   }
 };
@@ -1901,6 +2192,28 @@ public:
       DataIdentifier ("2.2.2.2:3"), DataIdentifier ("2.2.2.2:4"),
       DataIdentifier ("2.2.2.2:5")};
     NS_TEST_EXPECT_MSG_EQ (disjoint_vector, expected_disjoint_vector, "Disjoint vector must be the expected.");
+
+    // The same summary vector as a Bloom filter: the packets that it contains
+    // are skipped (the filter of these packets has no false positives).
+    received_sv_header.SetSummaryVectorEncoding (SummaryVectorEncoding::BloomFilter);
+    received_sv_header.SetBloomFilter (DataIdentifierBloomFilter (received_sv_header.GetSummaryVector (), 0.01),
+                                       received_sv_header.GetSummaryVector ().size ());
+
+    // Destination node 9.9.9.9
+    m_packets_queue.ProcessDisjointVector (received_sv_header, Ipv4Address ("9.9.9.9"),
+                                           disjoint_vector);
+
+    expected_disjoint_vector = {DataIdentifier ("2.2.2.2:1"), DataIdentifier ("2.2.2.2:2"),
+      DataIdentifier ("2.2.2.2:3"), DataIdentifier ("2.2.2.2:4"),
+      DataIdentifier ("2.2.2.2:5")};
+    NS_TEST_EXPECT_MSG_EQ (disjoint_vector, expected_disjoint_vector, "Disjoint vector must be the expected.");
+
+    // Destination node 2.2.2.2
+    m_packets_queue.ProcessDisjointVector (received_sv_header, Ipv4Address ("2.2.2.2"),
+                                           disjoint_vector);
+
+    expected_disjoint_vector = std::set<DataIdentifier> ();
+    NS_TEST_EXPECT_MSG_EQ (disjoint_vector, expected_disjoint_vector, "Disjoint vector must be the expected.");
   }
 
   void
@@ -3181,6 +3494,227 @@ public:
 };
 
 
+// =============================================================================
+//                              RoutingProtocolTest
+// =============================================================================
+
+/**
+ * Tests the pacing of the DATA packets sent to a neighbor node, which depends on
+ * the number of packets in the MAC queue of the WiFi device.
+ */
+class RoutingProtocolTest : public TestCasePlus
+{
+public:
+
+  const Ipv4Address m_neighbor_ip;
+
+  Ptr<Node> m_node;
+  Ptr<WifiNetDevice> m_wifi_device;
+  Ptr<RoutingProtocol> m_routing_protocol;
+
+  RoutingProtocolTest ()
+  : TestCasePlus ("RoutingProtocol"), m_neighbor_ip ("2.2.2.2"), m_node (), m_wifi_device (),
+  m_routing_protocol () { }
+
+  /**
+   * Creates the routing protocol of a new node with an ad hoc WiFi device. The
+   * DATA packets of a QoS MAC are queued in its BE_Txop, the ones of a non-QoS
+   * MAC are queued in its Txop.
+   */
+  void
+  CreateRoutingProtocol (bool qos_supported)
+  {
+    NodeContainer nodes;
+    nodes.Create (1u);
+
+    m_node = nodes.Get (0u);
+    m_node->AggregateObject (CreateObject<ConstantPositionMobilityModel> ());
+
+    YansWifiPhyHelper wifi_phy_helper = YansWifiPhyHelper::Default ();
+    YansWifiChannelHelper wifi_channel_helper = YansWifiChannelHelper::Default ();
+    wifi_phy_helper.SetChannel (wifi_channel_helper.Create ());
+
+    WifiMacHelper wifi_mac_helper;
+    wifi_mac_helper.SetType ("ns3::AdhocWifiMac", "QosSupported", BooleanValue (qos_supported));
+
+    WifiHelper wifi_helper;
+    wifi_helper.SetStandard (WIFI_PHY_STANDARD_80211b);
+
+    NetDeviceContainer devices = wifi_helper.Install (wifi_phy_helper, wifi_mac_helper, nodes);
+    m_wifi_device = DynamicCast<WifiNetDevice> (devices.Get (0u));
+
+    InternetStackHelper internet;
+    internet.Install (nodes);
+
+    Ipv4AddressHelper ip_addresses_helper;
+    ip_addresses_helper.SetBase ("10.0.0.0", "255.255.255.0");
+    ip_addresses_helper.Assign (devices);
+
+    // Interface 0 is the loopback interface, interface 1 is the WiFi one.
+    m_routing_protocol = CreateObject<RoutingProtocol> ();
+    m_routing_protocol->m_ipv4 = m_node->GetObject<Ipv4> ();
+    m_routing_protocol->m_selected_interface_index = 1;
+  }
+
+  /** Returns the MAC queue where the WiFi device queues the DATA packets. */
+  Ptr<WifiMacQueue>
+  GetMacQueue (bool qos_supported) const
+  {
+    PointerValue txop_pointer;
+    m_wifi_device->GetMac ()->GetAttribute (qos_supported ? "BE_Txop" : "Txop", txop_pointer);
+
+    return txop_pointer.Get<Txop> ()->GetWifiMacQueue ();
+  }
+
+  /** Stores the given number of packets in the MAC queue. */
+  void
+  FillMacQueue (Ptr<WifiMacQueue> mac_queue, uint32_t packets_count) const
+  {
+    WifiMacHeader mac_header;
+    mac_header.SetType (WIFI_MAC_DATA);
+
+    for (uint32_t i = 0u; i < packets_count; ++i)
+      mac_queue->Enqueue (Create<WifiMacQueueItem> (Create<Packet> (100u), mac_header));
+  }
+
+  /**
+   * Stores the given number of DATA packets in the packets queue and sets them
+   * as pending to be sent to the neighbor node.
+   */
+  void
+  AddPendingPackets (uint32_t packets_count)
+  {
+    const Ipv4Address source_ip ("1.1.1.1");
+
+    for (uint32_t i = 0u; i < packets_count; ++i)
+      {
+        const DataHeader data_packet (/* Data ID */ DataIdentifier (source_ip, i),
+                                      /* Geo-temporal area */ GeoTemporalArea (TimePeriod (Seconds (0), Seconds (10)),
+                                                                               Area (0, 0, 100, 100)),
+                                      /* Message */ "Message",
+                                      /* Hops */ 5);
+
+        m_routing_protocol->m_packets_queue.Enqueue (data_packet, source_ip);
+        m_routing_protocol->m_data_pacers[m_neighbor_ip].m_pending_packets.insert (data_packet.GetDataIdentifier ());
+      }
+  }
+
+  /** Returns the number of DATA packets pending to be sent to the neighbor node. */
+  uint32_t
+  GetPendingPacketsCount () const
+  {
+    std::map<Ipv4Address, RoutingProtocol::DataTransmitPacer>::const_iterator pacer_it
+            = m_routing_protocol->m_data_pacers.find (m_neighbor_ip);
+
+    return pacer_it == m_routing_protocol->m_data_pacers.end () ? 0u : pacer_it->second.m_pending_packets.size ();
+  }
+
+  void
+  TestFullMacQueue ()
+  {
+    CreateRoutingProtocol (false);
+
+    Ptr<WifiMacQueue> mac_queue = GetMacQueue (false);
+    FillMacQueue (mac_queue, m_routing_protocol->m_max_mac_queue_packets);
+
+    uint32_t mac_queue_size = 0u;
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->GetMacQueueSize (mac_queue_size), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (mac_queue_size, 4u, "Must be 4");
+
+    // The MAC queue is full, so no packet is sent and the pacer tries later.
+    AddPendingPackets (3u);
+    m_routing_protocol->SendPendingDataPackets (m_neighbor_ip);
+
+    NS_TEST_EXPECT_MSG_EQ (GetPendingPacketsCount (), 3u, "Must be 3");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_data_pacers[m_neighbor_ip].m_send_event.IsRunning (), true,
+                           "Must be true");
+
+    m_routing_protocol->CancelPendingDataPackets ();
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_data_pacers.empty (), true, "Must be true");
+
+    m_routing_protocol->Dispose ();
+    Simulator::Destroy ();
+  }
+
+  void
+  TestDrainedMacQueue ()
+  {
+    CreateRoutingProtocol (true);
+
+    Ptr<WifiMacQueue> mac_queue = GetMacQueue (true);
+    FillMacQueue (mac_queue, 1u);
+
+    uint32_t mac_queue_size = 0u;
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->GetMacQueueSize (mac_queue_size), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (mac_queue_size, 1u, "Must be 1");
+
+    // Only the free slots of the MAC queue are used.
+    AddPendingPackets (6u);
+    m_routing_protocol->SendPendingDataPackets (m_neighbor_ip);
+
+    NS_TEST_EXPECT_MSG_EQ (GetPendingPacketsCount (), 3u, "Must be 3");
+
+    // Once the MAC queue is drained, the rest of the packets are sent and the
+    // pacer is removed.
+    mac_queue->Flush ();
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->GetMacQueueSize (mac_queue_size), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (mac_queue_size, 0u, "Must be 0");
+
+    m_routing_protocol->SendPendingDataPackets (m_neighbor_ip);
+
+    NS_TEST_EXPECT_MSG_EQ (GetPendingPacketsCount (), 0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_data_pacers.empty (), true, "Must be true");
+
+    m_routing_protocol->Dispose ();
+    Simulator::Destroy ();
+  }
+
+  void
+  TestMacQueueFallback ()
+  {
+    CreateRoutingProtocol (false);
+
+    uint32_t mac_queue_size = 0u;
+
+    // Without a selected interface, or with an interface without a WiFi device
+    // (the loopback one), there's no Txop nor BE_Txop to query, so the pacer
+    // sends one packet per call.
+    m_routing_protocol->m_selected_interface_index = -1;
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->GetMacQueueSize (mac_queue_size), false, "Must be false");
+
+    m_routing_protocol->m_selected_interface_index = 0;
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->GetMacQueueSize (mac_queue_size), false, "Must be false");
+
+    AddPendingPackets (2u);
+    m_routing_protocol->SendPendingDataPackets (m_neighbor_ip);
+
+    NS_TEST_EXPECT_MSG_EQ (GetPendingPacketsCount (), 1u, "Must be 1");
+
+    m_routing_protocol->SendPendingDataPackets (m_neighbor_ip);
+
+    NS_TEST_EXPECT_MSG_EQ (GetPendingPacketsCount (), 0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_data_pacers.empty (), true, "Must be true");
+
+    m_routing_protocol->Dispose ();
+    Simulator::Destroy ();
+  }
+
+  void
+  DoRun () override
+  {
+    TestFullMacQueue ();
+    TestDrainedMacQueue ();
+    TestMacQueueFallback ();
+  }
+};
+
+
 // =============================================================================
 //                          GeoTemporalEpidemicTestSuite
 // =============================================================================
@@ -3207,6 +3741,7 @@ public:
     AddTestCase (new PacketQueueEntryTest, TestCase::QUICK);
     AddTestCase (new PacketsQueueTest, TestCase::QUICK);
     AddTestCase (new DuplicatedPacketDetectorTest, TestCase::QUICK);
+    AddTestCase (new RoutingProtocolTest, TestCase::QUICK);
   }
 };
 
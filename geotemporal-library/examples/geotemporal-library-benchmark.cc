@@ -0,0 +1,377 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2019 Luis Ricardo Gallego Tercero <luiss_121314@hotmail.com>,
+ *                    Networks and Data Science Laboratory (NDS-Lab) at the
+ *                    Computing Research Center (CIC-IPN) <www.prime.cic.ipn.mx>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * This is a benchmark script of the data structures of the library that are
+ * used in the packets queues of the routing protocols.
+ *
+ * Each benchmark times the same operation implemented in two ways: the way
+ * the packets queues did it before (baseline) and the way they do it now
+ * (current). The average time of each one is printed along with the speedup.
+ *
+ * Available benchmarks:
+ * - area-set: tests the destination areas of the packets requested in a
+ *   disjoint vector against two positions. The baseline builds an AreaSet
+ *   with the areas of the requested packets in every call. The current one
+ *   tests the areas of the requested packets, by their slots, in the AreaSet
+ *   that the queue keeps up to date on every insertion and removal.
+ * - sorted-keys: replaces some packets of the queue and then gets the sorted
+ *   identifiers of the queue packets, as when a summary vector is built. The
+ *   baseline sorts all the identifiers again after the changes. The current
+ *   one uses the identifiers that the DataIdentifierMap keeps sorted on every
+ *   insertion and removal.
+ *
+ * Author: Luis Ricardo Gallego Tercero <luiss_121314@hotmail.com>
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <ns3/abort.h>
+#include <ns3/command-line.h>
+#include <ns3/ipv4-address.h>
+#include <ns3/geotemporal-library-module.h>
+
+using namespace GeoTemporalLibrary::LibraryUtils;
+using namespace ns3;
+
+
+// =============================================================================
+//                               Benchmark helpers
+// =============================================================================
+
+/**
+ * Result of a benchmark: average time (in milliseconds) of one call of the
+ * baseline and the current implementations.
+ */
+struct BenchmarkResult
+{
+  double m_baseline_time;
+  double m_current_time;
+};
+
+/**
+ * Returns the time (in milliseconds) elapsed since <code>start</code>.
+ */
+static double
+GetElapsedMilliseconds (const std::chrono::steady_clock::time_point & start)
+{
+  return std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - start).count ();
+}
+
+/**
+ * Prints the result of a benchmark.
+ */
+static void
+PrintBenchmarkResult (const std::string & benchmark_name, const std::string & parameters,
+                      const BenchmarkResult & result)
+{
+  char buffer[160];
+
+  std::sprintf (buffer, "%-12s %-40s baseline %10.4f ms   current %10.4f ms   speedup %6.2fx",
+                benchmark_name.c_str (), parameters.c_str (), result.m_baseline_time,
+                result.m_current_time, result.m_baseline_time / result.m_current_time);
+
+  std::cout << buffer << "\n";
+}
+
+/**
+ * Returns <code>count</code> distinct data identifiers.
+ */
+static std::vector<DataIdentifier>
+GenerateDataIdentifiers (uint32_t count, std::mt19937 & random_generator)
+{
+  std::vector<DataIdentifier> data_ids;
+  data_ids.reserve (count);
+
+  for (uint32_t i = 0u; i < count; ++i)
+    data_ids.push_back (DataIdentifier (Ipv4Address (0x0A000000u + (i % 256u) + 1u), (uint16_t) (i / 256u)));
+
+  std::shuffle (data_ids.begin (), data_ids.end (), random_generator);
+  return data_ids;
+}
+
+
+// =============================================================================
+//                              AreaSet benchmark
+// =============================================================================
+
+/**
+ * Times the test of the destination areas of the requested packets against the
+ * positions of the local node and a neighbor node.
+ *
+ * @param queue_size Number of packets in the queue.
+ * @param requested_packets_count Number of packets in the disjoint vector.
+ * @param iterations Number of times each implementation is run.
+ */
+static BenchmarkResult
+RunAreaSetBenchmark (uint32_t queue_size, uint32_t requested_packets_count, uint32_t iterations,
+                     std::mt19937 & random_generator)
+{
+  std::uniform_real_distribution<double> coordinate_distribution (0.0, 3000.0);
+  std::uniform_real_distribution<double> size_distribution (50.0, 400.0);
+
+  const std::vector<DataIdentifier> data_ids = GenerateDataIdentifiers (queue_size, random_generator);
+
+  // Queue: destination area of each packet (baseline) and slot of each packet
+  // in the area set kept by the queue (current).
+  DataIdentifierMap<Area> destination_areas;
+  DataIdentifierMap<uint32_t> areas_slots;
+  AreaSet queue_areas;
+
+  for (std::vector<DataIdentifier>::const_iterator data_id_it = data_ids.begin ();
+          data_id_it != data_ids.end (); ++data_id_it)
+    {
+      const double x = coordinate_distribution (random_generator);
+      const double y = coordinate_distribution (random_generator);
+      const Area area (x, y, x + size_distribution (random_generator), y + size_distribution (random_generator));
+
+      destination_areas.insert (std::make_pair (*data_id_it, area));
+      areas_slots.insert (std::make_pair (*data_id_it, queue_areas.Add (area)));
+    }
+
+  // Disjoint vector
+  const std::vector<DataIdentifier> requested_packets (data_ids.begin (),
+                                                       data_ids.begin () + std::min (requested_packets_count,
+                                                                                     queue_size));
+
+  // Positions of the local node and the neighbor node
+  const double local_x = coordinate_distribution (random_generator);
+  const double local_y = coordinate_distribution (random_generator);
+  const double neighbor_x = coordinate_distribution (random_generator);
+  const double neighbor_y = coordinate_distribution (random_generator);
+
+  const GeoTemporalLibrary::LibraryUtils::Vector2D local_position (local_x, local_y);
+  const GeoTemporalLibrary::LibraryUtils::Vector2D neighbor_position (neighbor_x, neighbor_y);
+
+  AreaSet::Bitmask_t inside_area_mask;
+  uint32_t baseline_inside_count = 0u, current_inside_count = 0u;
+  BenchmarkResult result;
+
+  // Baseline: build the area set of the requested packets in every call.
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+
+  for (uint32_t iteration = 0u; iteration < iterations; ++iteration)
+    {
+      AreaSet requested_areas;
+      requested_areas.Reserve (requested_packets.size ());
+
+      for (std::vector<DataIdentifier>::const_iterator data_id_it = requested_packets.begin ();
+              data_id_it != requested_packets.end (); ++data_id_it)
+        requested_areas.Add (destination_areas.at (*data_id_it));
+
+      requested_areas.ContainsAnyPoint (local_position, neighbor_position, inside_area_mask);
+
+      for (uint32_t index = 0u; index < requested_packets.size (); ++index)
+        baseline_inside_count += AreaSet::IsSet (inside_area_mask, index);
+    }
+
+  result.m_baseline_time = GetElapsedMilliseconds (start) / iterations;
+
+  // Current: test the area set kept by the queue.
+  std::vector<uint32_t> requested_packets_slots;
+  start = std::chrono::steady_clock::now ();
+
+  for (uint32_t iteration = 0u; iteration < iterations; ++iteration)
+    {
+      requested_packets_slots.clear ();
+      requested_packets_slots.reserve (requested_packets.size ());
+
+      for (std::vector<DataIdentifier>::const_iterator data_id_it = requested_packets.begin ();
+              data_id_it != requested_packets.end (); ++data_id_it)
+        requested_packets_slots.push_back (areas_slots.at (*data_id_it));
+
+      queue_areas.ContainsAnyPoint (local_position, neighbor_position, requested_packets_slots, inside_area_mask);
+
+      for (uint32_t index = 0u; index < requested_packets_slots.size (); ++index)
+        current_inside_count += AreaSet::IsSet (inside_area_mask, index);
+    }
+
+  result.m_current_time = GetElapsedMilliseconds (start) / iterations;
+
+  NS_ABORT_MSG_UNLESS (baseline_inside_count == current_inside_count,
+                       "Both implementations must find the same packets inside their areas.");
+  return result;
+}
+
+
+// =============================================================================
+//                            Sorted keys benchmark
+// =============================================================================
+
+/**
+ * Times getting the sorted identifiers of the packets of the queue after some
+ * of its packets are replaced by new ones.
+ *
+ * @param queue_size Number of packets in the queue.
+ * @param changes_count Number of packets replaced before each query.
+ * @param iterations Number of times each implementation is run.
+ */
+static BenchmarkResult
+RunSortedKeysBenchmark (uint32_t queue_size, uint32_t changes_count, uint32_t iterations,
+                        std::mt19937 & random_generator)
+{
+  // The oldest packet of the queue is replaced by a new one in each change.
+  const std::vector<DataIdentifier> data_ids = GenerateDataIdentifiers (queue_size + changes_count * iterations,
+                                                                        random_generator);
+  uint64_t baseline_keys_count = 0u, current_keys_count = 0u;
+  BenchmarkResult result;
+
+  // Baseline: sort all the identifiers of the queue in every query.
+  std::deque<DataIdentifier> queue_ids (data_ids.begin (), data_ids.begin () + queue_size);
+  std::vector<DataIdentifier> baseline_sorted_keys;
+  std::vector<DataIdentifier>::const_iterator new_id_it = data_ids.begin () + queue_size;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+
+  for (uint32_t iteration = 0u; iteration < iterations; ++iteration)
+    {
+      for (uint32_t change = 0u; change < changes_count; ++change, ++new_id_it)
+        {
+          queue_ids.pop_front ();
+          queue_ids.push_back (*new_id_it);
+        }
+
+      baseline_sorted_keys.assign (queue_ids.begin (), queue_ids.end ());
+      std::sort (baseline_sorted_keys.begin (), baseline_sorted_keys.end ());
+
+      baseline_keys_count += baseline_sorted_keys.size ();
+    }
+
+  result.m_baseline_time = GetElapsedMilliseconds (start) / iterations;
+
+  // Current: the map keeps its identifiers sorted.
+  DataIdentifierMap<uint32_t> queue_packets;
+  std::vector<DataIdentifier>::const_iterator old_id_it = data_ids.begin ();
+  new_id_it = data_ids.begin () + queue_size;
+
+  for (std::vector<DataIdentifier>::const_iterator data_id_it = data_ids.begin ();
+          data_id_it != new_id_it; ++data_id_it)
+    queue_packets.insert (std::make_pair (*data_id_it, 0u));
+
+  start = std::chrono::steady_clock::now ();
+
+  for (uint32_t iteration = 0u; iteration < iterations; ++iteration)
+    {
+      for (uint32_t change = 0u; change < changes_count; ++change, ++old_id_it, ++new_id_it)
+        {
+          queue_packets.erase (*old_id_it);
+          queue_packets.insert (std::make_pair (*new_id_it, 0u));
+        }
+
+      current_keys_count += queue_packets.GetSortedKeys ().size ();
+    }
+
+  result.m_current_time = GetElapsedMilliseconds (start) / iterations;
+
+  NS_ABORT_MSG_UNLESS (baseline_keys_count == current_keys_count
+                       && baseline_sorted_keys == queue_packets.GetSortedKeys (),
+                       "Both implementations must get the same sorted identifiers.");
+  return result;
+}
+
+
+// =============================================================================
+//                                     main
+// =============================================================================
+
+int
+main (int argc, char *argv[])
+{
+  std::string benchmarks = "area-set,sorted-keys";
+  uint32_t queue_size = 1000u;
+  uint32_t iterations = 20000u;
+  uint32_t seed = 1u;
+
+  CommandLine cmd;
+
+  cmd.AddValue ("benchmarks",
+                "Comma-separated list of the benchmarks to run. Valid values "
+                "are: area-set, sorted-keys. [Default value: area-set,sorted-keys]",
+                benchmarks);
+
+  cmd.AddValue ("queueSize",
+                "Number of packets in the queue. [Default value: 1000]",
+                queue_size);
+
+  cmd.AddValue ("iterations",
+                "Number of times each implementation is run. "
+                "[Default value: 20000]",
+                iterations);
+
+  cmd.AddValue ("seed",
+                "Seed of the random generator of the benchmark data. "
+                "[Default value: 1]",
+                seed);
+
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (queue_size == 0u || iterations == 0u,
+                   "The queue size and the number of iterations must be positive.");
+
+  std::vector<std::string> benchmarks_list = Split (benchmarks, ',');
+  std::mt19937 random_generator (seed);
+
+  for (std::vector<std::string>::iterator benchmark_it = benchmarks_list.begin ();
+          benchmark_it != benchmarks_list.end (); ++benchmark_it)
+    {
+      Trim (*benchmark_it);
+
+      if (*benchmark_it == "area-set")
+        {
+          // From a few requested packets to all the packets of the queue.
+          const uint32_t requested_percentages[] = {10u, 50u, 100u};
+
+          for (uint32_t i = 0u; i < 3u; ++i)
+            {
+              const uint32_t requested_packets_count = std::max (1u, queue_size * requested_percentages[i] / 100u);
+              const BenchmarkResult result = RunAreaSetBenchmark (queue_size, requested_packets_count,
+                                                                  iterations, random_generator);
+
+              PrintBenchmarkResult ("area-set", "queue " + std::to_string (queue_size) + ", requested "
+                                    + std::to_string (requested_packets_count), result);
+            }
+        }
+      else if (*benchmark_it == "sorted-keys")
+        {
+          // From one replaced packet per query to a tenth of the queue.
+          const uint32_t changes_counts[] = {1u, 10u, std::max (1u, queue_size / 10u)};
+
+          for (uint32_t i = 0u; i < 3u; ++i)
+            {
+              const BenchmarkResult result = RunSortedKeysBenchmark (queue_size, changes_counts[i],
+                                                                     iterations, random_generator);
+
+              PrintBenchmarkResult ("sorted-keys", "queue " + std::to_string (queue_size) + ", changes "
+                                    + std::to_string (changes_counts[i]), result);
+            }
+        }
+      else
+        {
+          NS_ABORT_MSG ("Unknown benchmark \"" << *benchmark_it << "\".");
+        }
+    }
+
+  return 0;
+}
@@ -3,6 +3,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <limits>
 
 #include "string-utils.h"
 
@@ -146,21 +147,169 @@ DestinationGeoTemporalArea::Print (std::ostream & os) const
 
 RandomDestinationGeoTemporalAreasLists::RandomDestinationGeoTemporalAreasLists ()
 : m_simulation_total_time (), m_lists_sets_number (), m_destination_areas_list (),
-m_list_lengths_in_set (), m_lists_sets () { }
+m_list_lengths_in_set (), m_lists_sets (), m_all_lists_loaded (true) { }
 
 RandomDestinationGeoTemporalAreasLists::RandomDestinationGeoTemporalAreasLists (const std::string & input_filename)
 : RandomDestinationGeoTemporalAreasLists ()
 {
   const std::string filename_trimmed = LibraryUtils::Trim_Copy (input_filename);
   std::ifstream input_file (filename_trimmed, std::ios::in);
-  std::string text_line;
-  std::vector<std::string> tokens;
 
   if (!input_file.is_open ())
     throw std::runtime_error ("Unable to open file \"" + filename_trimmed + "\".");
 
   std::cout << "Importing lists of random destination geo-temporal areas file \"" << filename_trimmed << "\"...";
 
+  const uint32_t areas_number = ImportSetupData (input_file);
+  ImportDestinationAreasList (input_file, areas_number, m_destination_areas_list);
+
+  // Sets of lists
+  std::map<uint32_t, std::vector<DestinationGeoTemporalArea> > lists_set;
+
+  for (uint32_t set_index = 0; set_index < m_lists_sets_number; ++set_index)
+    {
+      ImportListsSet (input_file, set_index, m_list_lengths_in_set, lists_set);
+
+      // Add set of lists to final list.
+      m_lists_sets.push_back (lists_set);
+      lists_set.clear ();
+    }
+
+  input_file.close ();
+
+  if (m_lists_sets.size () != m_lists_sets_number)
+    {
+      std::cout << " Error!\n";
+      throw std::runtime_error ("Corrupt file. The file does not match the correct format. "
+                                "Invalid number of sets.");
+    }
+
+  std::cout << " Done.\n";
+}
+
+RandomDestinationGeoTemporalAreasLists::RandomDestinationGeoTemporalAreasLists (const std::string & input_filename,
+                                                                                uint32_t set_number,
+                                                                                uint32_t list_length)
+: RandomDestinationGeoTemporalAreasLists ()
+{
+  const std::string filename_trimmed = LibraryUtils::Trim_Copy (input_filename);
+  std::ifstream input_file (filename_trimmed, std::ios::in);
+
+  if (!input_file.is_open ())
+    throw std::runtime_error ("Unable to open file \"" + filename_trimmed + "\".");
+
+  std::cout << "Importing list of length " << list_length << " of set " << set_number
+          << " of random destination geo-temporal areas file \"" << filename_trimmed << "\"...";
+
+  const uint32_t areas_number = ImportSetupData (input_file);
+  ImportDestinationAreasList (input_file, areas_number, m_destination_areas_list);
+
+  if (set_number < 1u || set_number > m_lists_sets_number)
+    {
+      input_file.close ();
+      std::cout << " Error!\n";
+      throw std::invalid_argument ("Invalid set number: it must be a positive integer between 1 and the number of sets, "
+                                   "including both limits.");
+    }
+
+  if (m_list_lengths_in_set.count (list_length) == 0u)
+    {
+      input_file.close ();
+      std::cout << " Error!\n";
+      throw std::invalid_argument ("Invalid list length: there aren't lists with the given length.");
+    }
+
+  // Move to the beginning of the requested set. If the index file has a valid
+  // offset for the set jump directly to it, otherwise skip the lines of the
+  // previous sets without parsing them (each set has 2 comment lines, one line
+  // per list length and 1 empty line).
+  const std::streampos first_set_position = input_file.tellg ();
+
+  if (!SeekIndexedListsSet (input_file, GetIndexFilename (filename_trimmed), set_number))
+    {
+      input_file.clear ();
+      input_file.seekg (first_set_position);
+
+      const uint32_t lines_per_set = m_list_lengths_in_set.size () + 3u;
+
+      for (uint32_t i = 0u; i < (set_number - 1u) * lines_per_set; ++i)
+        input_file.ignore (std::numeric_limits<std::streamsize>::max (), '\n');
+    }
+
+  if (!input_file.good ())
+    {
+      input_file.close ();
+      std::cout << " Error!\n";
+      throw std::runtime_error ("Corrupt file. The file does not match the correct format. "
+                                "Invalid number of sets.");
+    }
+
+  // All the sets are kept (so set numbers remain valid) but only the requested
+  // one contains a list.
+  m_lists_sets.resize (m_lists_sets_number);
+  m_all_lists_loaded = false;
+
+  ImportListsSet (input_file, set_number - 1u, std::set<uint32_t>{list_length},
+                  m_lists_sets.at (set_number - 1u));
+
+  input_file.close ();
+
+  std::cout << " Done.\n";
+}
+
+RandomDestinationGeoTemporalAreasLists::RandomDestinationGeoTemporalAreasLists (uint32_t simulation_total_time,
+                                                                                const std::vector<Area> & destination_areas_list,
+                                                                                const std::vector<std::map<uint32_t, std::vector<DestinationGeoTemporalArea> > > & lists_sets)
+: m_simulation_total_time (simulation_total_time), m_lists_sets_number (lists_sets.size ()),
+m_destination_areas_list (destination_areas_list), m_list_lengths_in_set (), m_lists_sets (lists_sets),
+m_all_lists_loaded (true)
+{
+  const std::set<Area> destination_areas (destination_areas_list.begin (), destination_areas_list.end ());
+
+  for (std::vector<std::map<uint32_t, std::vector<DestinationGeoTemporalArea> > >::const_iterator set_it = lists_sets.begin ();
+          set_it != lists_sets.end (); ++set_it)
+    {
+      std::set<uint32_t> list_lengths;
+
+      for (std::map<uint32_t, std::vector<DestinationGeoTemporalArea> >::const_iterator list_it = set_it->begin ();
+              list_it != set_it->end (); ++list_it)
+        {
+          if (list_it->second.size () != list_it->first)
+            throw std::invalid_argument ("Invalid list: the number of destination geo-temporal areas doesn't match "
+                                         "the length of the list.");
+
+          for (std::vector<DestinationGeoTemporalArea>::const_iterator temporal_area_it = list_it->second.begin ();
+                  temporal_area_it != list_it->second.end (); ++temporal_area_it)
+            {
+              if (destination_areas.count (temporal_area_it->GetArea ()) == 0u)
+                throw std::invalid_argument ("Invalid list: the area of a destination geo-temporal area isn't in the "
+                                             "list of destination areas.");
+            }
+
+          list_lengths.insert (list_it->first);
+        }
+
+      if (set_it == lists_sets.begin ())
+        m_list_lengths_in_set = list_lengths;
+      else if (list_lengths != m_list_lengths_in_set)
+        throw std::invalid_argument ("Invalid set: all the sets must contain lists of the same lengths.");
+    }
+}
+
+RandomDestinationGeoTemporalAreasLists::RandomDestinationGeoTemporalAreasLists (const RandomDestinationGeoTemporalAreasLists & copy)
+: m_simulation_total_time (copy.m_simulation_total_time),
+m_lists_sets_number (copy.m_lists_sets_number),
+m_destination_areas_list (copy.m_destination_areas_list),
+m_list_lengths_in_set (copy.m_list_lengths_in_set),
+m_lists_sets (copy.m_lists_sets),
+m_all_lists_loaded (copy.m_all_lists_loaded) { }
+
+uint32_t
+RandomDestinationGeoTemporalAreasLists::ImportSetupData (std::ifstream & input_file)
+{
+  std::string text_line;
+  std::vector<std::string> tokens;
+
   // Expected a comment.
   if (!LibraryUtils::GetInputStreamNextLine (input_file, text_line) || text_line.empty ()
       || text_line.at (0) != '#')
@@ -242,6 +391,19 @@ RandomDestinationGeoTemporalAreasLists::RandomDestinationGeoTemporalAreasLists (
       throw std::runtime_error ("Corrupt file. The file does not match the correct format.");
     }
 
+  return areas_number;
+}
+
+void
+RandomDestinationGeoTemporalAreasLists::ImportDestinationAreasList (std::ifstream & input_file, uint32_t areas_number,
+                                                                    std::vector<Area> & destination_areas_list)
+{
+  std::string text_line;
+  std::vector<std::string> tokens;
+
+  destination_areas_list.clear ();
+  destination_areas_list.reserve (areas_number);
+
   // Expected comment.
   if (!LibraryUtils::GetInputStreamNextLine (input_file, text_line) || text_line.empty ()
       || text_line.at (0) != '#')
@@ -282,10 +444,10 @@ RandomDestinationGeoTemporalAreasLists::RandomDestinationGeoTemporalAreasLists (
                                     " area IDs must be consecutive.");
         }
 
-      m_destination_areas_list.emplace_back (std::stod (tokens.at (1u)),
-                                             std::stod (tokens.at (2u)),
-                                             std::stod (tokens.at (3u)),
-                                             std::stod (tokens.at (4u)));
+      destination_areas_list.emplace_back (std::stod (tokens.at (1u)),
+                                           std::stod (tokens.at (2u)),
+                                           std::stod (tokens.at (3u)),
+                                           std::stod (tokens.at (4u)));
     }
 
   // Expected empty line.
@@ -295,154 +457,252 @@ RandomDestinationGeoTemporalAreasLists::RandomDestinationGeoTemporalAreasLists (
       std::cout << " Error!\n";
       throw std::runtime_error ("Corrupt file. The file does not match the correct format.");
     }
+}
 
-  // Sets of lists
+void
+RandomDestinationGeoTemporalAreasLists::ImportListsSet (std::ifstream & input_file, uint32_t set_index,
+                                                        const std::set<uint32_t> & list_lengths_to_import,
+                                                        std::map<uint32_t, std::vector<DestinationGeoTemporalArea> > & lists_set) const
+{
+  std::string text_line;
+  std::vector<std::string> tokens;
   std::vector<uint32_t> int_tokens;
   DestinationGeoTemporalArea destination_gta;
   std::vector<DestinationGeoTemporalArea> destinations_vector;
-  std::map<uint32_t, std::vector<DestinationGeoTemporalArea> > lists_set;
 
-  for (uint32_t set_index = 0; set_index < m_lists_sets_number; ++set_index)
+  // Expected comment.
+  if (!LibraryUtils::GetInputStreamNextLine (input_file, text_line) || text_line.empty ()
+      || text_line.at (0) != '#')
+    {
+      input_file.close ();
+      std::cout << " Error!\n";
+      throw std::runtime_error ("Corrupt file. The file does not match the correct format.");
+    }
+
+  // Expected comment.
+  if (!LibraryUtils::GetInputStreamNextLine (input_file, text_line) || text_line.empty ()
+      || text_line.at (0) != '#')
+    {
+      input_file.close ();
+      std::cout << " Error!\n";
+      throw std::runtime_error ("Corrupt file. The file does not match the correct format.");
+    }
+
+  // One list per each list length
+  for (std::set<uint32_t>::const_iterator list_length_it = m_list_lengths_in_set.begin ();
+          list_length_it != m_list_lengths_in_set.end (); ++list_length_it)
     {
-      // Expected comment.
-      if (!LibraryUtils::GetInputStreamNextLine (input_file, text_line) || text_line.empty ()
-          || text_line.at (0) != '#')
+      // Skip, without parsing it, the list of a length that wasn't requested
+      if (list_lengths_to_import.count (*list_length_it) == 0u)
+        {
+          input_file.ignore (std::numeric_limits<std::streamsize>::max (), '\n');
+          continue;
+        }
+
+      // Expected at least 2 integers
+      if (!LibraryUtils::GetInputStreamNextLine (input_file, text_line) || text_line.empty ())
         {
           input_file.close ();
           std::cout << " Error!\n";
           throw std::runtime_error ("Corrupt file. The file does not match the correct format.");
         }
 
-      // Expected comment.
-      if (!LibraryUtils::GetInputStreamNextLine (input_file, text_line) || text_line.empty ()
-          || text_line.at (0) != '#')
+      tokens = LibraryUtils::Split (text_line, ',');
+
+      // Set number, list length and 5 integers per destination
+      if (tokens.size () < 2u || (tokens.size () - 2u) % 5u != 0u
+          || (tokens.size () - 2u) / 5u != *list_length_it)
         {
           input_file.close ();
           std::cout << " Error!\n";
           throw std::runtime_error ("Corrupt file. The file does not match the correct format.");
         }
 
-      // One list per each list length
-      for (std::set<uint32_t>::const_iterator list_length_it = m_list_lengths_in_set.begin ();
-              list_length_it != m_list_lengths_in_set.end (); ++list_length_it)
+      int_tokens.clear ();
+
+      for (uint32_t i = 0; i < tokens.size (); ++i)
         {
-          // Expected at least 2 integers
-          if (!LibraryUtils::GetInputStreamNextLine (input_file, text_line) || text_line.empty ())
-            {
-              input_file.close ();
-              std::cout << " Error!\n";
-              throw std::runtime_error ("Corrupt file. The file does not match the correct format.");
-            }
+          LibraryUtils::Trim (tokens.at (i));
+          int_tokens.push_back ((uint32_t) std::stoi (tokens.at (i)));
+        }
 
-          tokens = LibraryUtils::Split (text_line, ',');
+      if (set_index + 1u != int_tokens.at (0u))
+        {
+          input_file.close ();
+          std::cout << " Error!\n";
+          throw std::runtime_error ("Corrupt file. The file does not match the correct format."
+                                    "Invalid set number.");
+        }
 
-          if (tokens.size () < 2u || (tokens.size () - 2) % 4 != 0)
-            {
-              input_file.close ();
-              std::cout << " Error!\n";
-              throw std::runtime_error ("Corrupt file. The file does not match the correct format.");
-            }
+      if (*list_length_it != int_tokens.at (1u))
+        {
+          input_file.close ();
+          std::cout << " Error!\n";
+          throw std::runtime_error ("Corrupt file. The file does not match the correct format."
+                                    " Invalid list length.");
+        }
 
-          int_tokens.clear ();
+      destinations_vector.clear ();
+      destinations_vector.reserve (*list_length_it);
 
-          for (uint32_t i = 0; i < tokens.size (); ++i)
-            {
-              LibraryUtils::Trim (tokens.at (i));
-              int_tokens.push_back ((uint32_t) std::stoi (tokens.at (i)));
-            }
+      // Each destination is 5 integers, after the 2 validated integers
+      for (uint32_t list_index = 0u, i = 2u; list_index < *list_length_it; ++list_index, i += 5u)
+        {
+          destination_gta = DestinationGeoTemporalArea (/*Node ID*/ int_tokens.at (i),
+                                                        /*Time period*/ TimePeriod (ns3::Seconds (int_tokens.at (i + 2u)),
+                                                                                    ns3::Seconds (int_tokens.at (i + 3u))),
+                                                        /*Area*/ m_destination_areas_list.at (int_tokens.at (i + 1u)));
+          destination_gta.SetCreationTime (ns3::Seconds (int_tokens.at (i + 4u)));
 
-          if (set_index + 1u != int_tokens.at (0u))
-            {
-              input_file.close ();
-              std::cout << " Error!\n";
-              throw std::runtime_error ("Corrupt file. The file does not match the correct format."
-                                        "Invalid set number.");
-            }
+          destinations_vector.push_back (destination_gta);
+        }
 
-          if (*list_length_it != int_tokens.at (1u))
-            {
-              input_file.close ();
-              std::cout << " Error!\n";
-              throw std::runtime_error ("Corrupt file. The file does not match the correct format."
-                                        " Invalid list length.");
-            }
+      if (destinations_vector.size () != *list_length_it)
+        {
+          input_file.close ();
+          std::cout << " Error!\n";
+          throw std::runtime_error ("Corrupt file. The file does not match the correct format."
+                                    " Invalid list length.");
+        }
 
-          // Discard validated information we don't need anymore
-          destinations_vector.clear ();
-          int_tokens.erase (int_tokens.begin (), int_tokens.begin () + 2);
+      // Add single list to set
+      lists_set.insert (std::make_pair (*list_length_it, destinations_vector));
+    }
 
-          for (uint32_t list_index = 0u; list_index < *list_length_it; ++list_index)
-            {
-              destination_gta = DestinationGeoTemporalArea (/*Node ID*/ int_tokens.at (0u),
-                                                            /*Time period*/ TimePeriod (ns3::Seconds (int_tokens.at (2u)),
-                                                                                        ns3::Seconds (int_tokens.at (3u))),
-                                                            /*Area*/ m_destination_areas_list.at (int_tokens.at (1u)));
-              destination_gta.SetCreationTime (ns3::Seconds (int_tokens.at (4u)));
+  // Expected empty line.
+  if (!LibraryUtils::GetInputStreamNextLine (input_file, text_line) || !text_line.empty ())
+    {
+      input_file.close ();
+      std::cout << " Error!\n";
+      throw std::runtime_error ("Corrupt file. The file does not match the correct format.");
+    }
+}
 
-              destinations_vector.push_back (destination_gta);
+bool
+RandomDestinationGeoTemporalAreasLists::ImportSetOffset (const std::string & index_filename, uint32_t set_number,
+                                                         std::streamoff & set_offset)
+{
+  std::ifstream index_file (index_filename, std::ios::in);
+  std::string text_line;
+  std::vector<std::string> tokens;
 
-              int_tokens.erase (int_tokens.begin (), int_tokens.begin () + 5);
-            }
+  if (!index_file.is_open ())
+    return false;
 
-          if (destinations_vector.size () != *list_length_it)
-            {
-              input_file.close ();
-              std::cout << " Error!\n";
-              throw std::runtime_error ("Corrupt file. The file does not match the correct format."
-                                        " Invalid list length.");
-            }
+  while (LibraryUtils::GetInputStreamNextLine (index_file, text_line))
+    {
+      if (text_line.empty () || text_line.at (0) == '#')
+        continue;
 
-          // Add single list to set
-          lists_set.insert (std::make_pair (*list_length_it, destinations_vector));
-        }
+      tokens = LibraryUtils::Split (text_line, ',');
 
-      // Add set of lists to final list.
-      m_lists_sets.push_back (lists_set);
-      lists_set.clear ();
+      // A malformed index is ignored, the set is then found by skipping lines.
+      if (tokens.size () != 2u)
+        break;
 
-      // Expected empty line.
-      if (!LibraryUtils::GetInputStreamNextLine (input_file, text_line) || !text_line.empty ())
+      LibraryUtils::Trim (tokens.at (0u));
+      LibraryUtils::Trim (tokens.at (1u));
+
+      try
         {
-          input_file.close ();
-          std::cout << " Error!\n";
-          throw std::runtime_error ("Corrupt file. The file does not match the correct format.");
+          if (set_number == (uint32_t) std::stoul (tokens.at (0u)))
+            {
+              set_offset = (std::streamoff) std::stoll (tokens.at (1u));
+              index_file.close ();
+              return set_offset >= 0;
+            }
+        }
+      catch (std::logic_error & ex)
+        {
+          // Not a number (invalid_argument) or too big (out_of_range)
+          break;
         }
     }
 
-  input_file.close ();
+  index_file.close ();
+  return false;
+}
 
-  if (m_lists_sets.size () != m_lists_sets_number)
-    {
-      std::cout << " Error!\n";
-      throw std::runtime_error ("Corrupt file. The file does not match the correct format. "
-                                "Invalid number of sets.");
-    }
+bool
+RandomDestinationGeoTemporalAreasLists::SeekIndexedListsSet (std::ifstream & input_file,
+                                                             const std::string & index_filename,
+                                                             uint32_t set_number)
+{
+  std::streamoff set_offset = 0;
+  std::string text_line;
 
-  std::cout << " Done.\n";
+  if (!ImportSetOffset (index_filename, set_number, set_offset))
+    return false;
+
+  // The index file may be stale (e.g. the lists file was regenerated without
+  // it), so the offset is only used if it points to the first line of the set.
+  input_file.seekg (set_offset);
+
+  if (!input_file.good () || !LibraryUtils::GetInputStreamNextLine (input_file, text_line)
+      || text_line != GetListsSetFirstLine (set_number))
+    return false;
+
+  input_file.seekg (set_offset);
+  return input_file.good ();
 }
 
-RandomDestinationGeoTemporalAreasLists::RandomDestinationGeoTemporalAreasLists (const RandomDestinationGeoTemporalAreasLists & copy)
-: m_simulation_total_time (copy.m_simulation_total_time),
-m_lists_sets_number (copy.m_lists_sets_number),
-m_destination_areas_list (copy.m_destination_areas_list),
-m_list_lengths_in_set (copy.m_list_lengths_in_set),
-m_lists_sets (copy.m_lists_sets) { }
+std::string
+RandomDestinationGeoTemporalAreasLists::GetListsSetFirstLine (uint32_t set_number)
+{
+  return "# -- Set " + std::to_string (set_number) + " --";
+}
+
+std::string
+RandomDestinationGeoTemporalAreasLists::GetIndexFilename (const std::string & filename)
+{
+  return LibraryUtils::Trim_Copy (filename) + ".index";
+}
 
 const std::vector<DestinationGeoTemporalArea> &
 RandomDestinationGeoTemporalAreasLists::GetDestinationGeoTemporalAreasList (uint32_t set_number, uint32_t list_length) const
 {
-  if (set_number < 1 && set_number > m_lists_sets.size ())
+  if (set_number < 1 || set_number > m_lists_sets.size ())
     throw std::invalid_argument ("Invalid set number: it must be a positive integer between 1 and the number of sets, "
                                  "including both limits.");
 
   if (m_list_lengths_in_set.count (list_length) == 0u)
     throw std::invalid_argument ("Invalid list length: there aren't lists with the given length.");
 
-  return m_lists_sets.at (set_number - 1u).at (list_length);
+  const std::map<uint32_t, std::vector<DestinationGeoTemporalArea> > & lists_set = m_lists_sets.at (set_number - 1u);
+  const std::map<uint32_t, std::vector<DestinationGeoTemporalArea> >::const_iterator list_it = lists_set.find (list_length);
+
+  if (list_it == lists_set.end ())
+    throw std::invalid_argument ("Invalid list: the list wasn't imported from the input file.");
+
+  return list_it->second;
+}
+
+std::vector<Area>
+RandomDestinationGeoTemporalAreasLists::ImportDestinationAreasList (const std::string & input_filename)
+{
+  const std::string filename_trimmed = LibraryUtils::Trim_Copy (input_filename);
+  std::ifstream input_file (filename_trimmed, std::ios::in);
+
+  if (!input_file.is_open ())
+    throw std::runtime_error ("Unable to open file \"" + filename_trimmed + "\".");
+
+  std::cout << "Importing list of destination areas of random destination geo-temporal areas file \""
+          << filename_trimmed << "\"...";
+
+  RandomDestinationGeoTemporalAreasLists lists;
+  const uint32_t areas_number = lists.ImportSetupData (input_file);
+
+  std::vector<Area> destination_areas_list;
+  ImportDestinationAreasList (input_file, areas_number, destination_areas_list);
+
+  input_file.close ();
+
+  std::cout << " Done.\n";
+  return destination_areas_list;
 }
 
 void
-RandomDestinationGeoTemporalAreasLists::ExportToFile (const std::string & filename) const
+RandomDestinationGeoTemporalAreasLists::ExportToFile (const std::string & filename, bool export_index_file) const
 {
   const std::string filename_trimmed = LibraryUtils::Trim_Copy (filename);
   const std::string end_line = "\n"; // LibraryUtils::SYSTEM_NEW_LINE_STRING ();
@@ -451,6 +711,11 @@ RandomDestinationGeoTemporalAreasLists::ExportToFile (const std::string & filena
   if (filename_trimmed.empty ())
     throw std::runtime_error ("Invalid filename: the filename cannot be empty.");
 
+  // Checked before opening the output file, otherwise a truncated file (and a
+  // stale index file) would be left behind.
+  if (!m_all_lists_loaded)
+    throw std::runtime_error ("Invalid export: only a single list was imported from the input file.");
+
   std::ofstream output_file (filename_trimmed, std::ios::out);
 
   if (!output_file.is_open ())
@@ -510,12 +775,14 @@ RandomDestinationGeoTemporalAreasLists::ExportToFile (const std::string & filena
   output_file << end_line;
 
   // 3 - Sets of lists
+  std::vector<std::streamoff> sets_offsets;
   uint32_t set_number;
   for (uint32_t set_index = 0u; set_index < m_lists_sets_number; ++set_index)
     {
       set_number = set_index + 1u;
+      sets_offsets.push_back ((std::streamoff) output_file.tellp ());
 
-      output_file << "# -- Set " << set_number << " --" << end_line;
+      output_file << GetListsSetFirstLine (set_number) << end_line;
       output_file << "# Set Number, List length[, Source node ID, Area ID, Start time, End time, Creation time]*" << end_line;
 
       for (std::set<uint32_t>::const_iterator list_length_it = m_list_lengths_in_set.begin ();
@@ -549,6 +816,25 @@ RandomDestinationGeoTemporalAreasLists::ExportToFile (const std::string & filena
     }
 
   output_file.close ();
+
+  if (!export_index_file)
+    {
+      std::cout << " Done.\n";
+      return;
+    }
+
+  // 4 - Index file with the offset of each set
+  std::ofstream index_file (GetIndexFilename (filename_trimmed), std::ios::out);
+
+  if (!index_file.is_open ())
+    throw std::runtime_error ("Unable to open file \"" + GetIndexFilename (filename_trimmed) + "\".");
+
+  index_file << "# Set number, Byte offset" << end_line;
+
+  for (uint32_t set_index = 0u; set_index < sets_offsets.size (); ++set_index)
+    index_file << (set_index + 1u) << ", " << sets_offsets.at (set_index) << end_line;
+
+  index_file.close ();
   std::cout << " Done.\n";
 }
 
@@ -2,6 +2,9 @@
 #ifndef UTILS_GEOTEMPORAL_UTILS_H
 #define UTILS_GEOTEMPORAL_UTILS_H
 
+#include <algorithm>
+#include <fstream>
+#include <functional>
 #include <map>
 #include <set>
 #include <string>
@@ -486,12 +489,55 @@ private:
   std::set<uint32_t> m_list_lengths_in_set;
   std::vector<std::map<uint32_t, std::vector<DestinationGeoTemporalArea> > > m_lists_sets;
 
+  /** Indicates if all the lists of all the sets are loaded (i.e. it wasn't
+   * created by importing a single list from a file). */
+  bool m_all_lists_loaded;
+
 public:
 
   RandomDestinationGeoTemporalAreasLists ();
 
   RandomDestinationGeoTemporalAreasLists (const std::string & input_filename);
 
+  /**
+   * Imports from the input file only the list with the given length of the 
+   * given set, along with the list of destination areas.
+   * 
+   * The rest of the lists are skipped without being parsed. If the index file 
+   * (see <code>GetIndexFilename</code>) exists and its offset of the requested
+   * set points to the beginning of the set, the reading jumps directly to it.
+   * Otherwise (no index file, or a stale or malformed one) the lines of the
+   * previous sets are skipped.
+   * 
+   * If the specified set number or list length doesn't exists then it throws an
+   * <code>invalid_argument</code> exception.
+   *
+   * @param input_filename Name of the input file.
+   * @param set_number Number of the set in which the desired list is located. This is 
+   * the set index + 1.
+   * @param list_length Length of the desired list.
+   */
+  RandomDestinationGeoTemporalAreasLists (const std::string & input_filename, uint32_t set_number,
+                                          uint32_t list_length);
+
+  /**
+   * Creates the sets of lists from data already in memory (e.g. generated by a
+   * tool instead of imported from a file).
+   *
+   * All the sets must contain lists of the same lengths, each list must have
+   * as many destination geo-temporal areas as its length, and the area of each
+   * destination geo-temporal area must be in the list of destination areas.
+   * Otherwise it throws an <code>invalid_argument</code> exception.
+   *
+   * @param simulation_total_time The total duration of the simulation (in seconds).
+   * @param destination_areas_list List of all the possible destination areas.
+   * @param lists_sets Sets of lists of destination geo-temporal areas keyed by
+   * the length of each list.
+   */
+  RandomDestinationGeoTemporalAreasLists (uint32_t simulation_total_time,
+                                          const std::vector<Area> & destination_areas_list,
+                                          const std::vector<std::map<uint32_t, std::vector<DestinationGeoTemporalArea> > > & lists_sets);
+
   RandomDestinationGeoTemporalAreasLists (const RandomDestinationGeoTemporalAreasLists & copy);
 
   /** 
@@ -508,8 +554,8 @@ public:
    * Returns a vector of destination geo-temporal areas from the desired set and length in a
    * const reference.
    *
-   * If the specified set number or list length doesn't exists then it throws an
-   * <code>invalid_argument</code> exception.
+   * If the specified set number or list length doesn't exists, or if the list
+   * wasn't imported, then it throws an <code>invalid_argument</code> exception.
    *
    * @param set_number Number of the set in which the desired list is located. This is 
    * the set index + 1.
@@ -520,9 +566,32 @@ public:
 
   /**
    * Exports the list of sets to a file.
+   * 
+   * All the lists must have been imported. If only a single list was imported
+   * then it throws a <code>runtime_error</code> exception before the output 
+   * file is opened, so no file is modified.
+   * 
    * @param filename Name of the output file.
+   * @param export_index_file If <code>true</code> the byte offset of each set
+   * is also exported to the index file of the output file (see
+   * <code>GetIndexFilename</code>). An existing index file is not modified
+   * otherwise.
+   */
+  void ExportToFile (const std::string & filename, bool export_index_file = false) const;
+
+  /**
+   * Imports from the input file only the list of destination areas, without
+   * reading any set of lists.
+   * @param input_filename Name of the input file.
+   */
+  static std::vector<Area> ImportDestinationAreasList (const std::string & input_filename);
+
+  /**
+   * Returns the name of the index file of the given lists file. The index file
+   * contains the byte offset of each set in the lists file.
+   * @param filename Name of the lists file.
    */
-  void ExportToFile (const std::string & filename) const;
+  static std::string GetIndexFilename (const std::string & filename);
 
   /**
    * Returns a <code>string</code> object containing the representation of this
@@ -534,6 +603,52 @@ public:
 
   friend bool
   operator== (const RandomDestinationGeoTemporalAreasLists & lhs, const RandomDestinationGeoTemporalAreasLists & rhs);
+
+private:
+
+  /**
+   * Imports the setup data and the lengths of the lists. Returns the number of
+   * destination areas.
+   */
+  uint32_t ImportSetupData (std::ifstream & input_file);
+
+  /**
+   * Imports, from the current position of the input file, the list of the
+   * given number of destination areas.
+   */
+  static void ImportDestinationAreasList (std::ifstream & input_file, uint32_t areas_number,
+                                          std::vector<Area> & destination_areas_list);
+
+  /**
+   * Imports, from the current position of the input file, the set with the 
+   * given index. Only the lists with the lengths in 
+   * <code>list_lengths_to_import</code> are parsed, the rest are skipped.
+   */
+  void ImportListsSet (std::ifstream & input_file, uint32_t set_index,
+                       const std::set<uint32_t> & list_lengths_to_import,
+                       std::map<uint32_t, std::vector<DestinationGeoTemporalArea> > & lists_set) const;
+
+  /**
+   * Reads from the index file the byte offset of the given set. Returns 
+   * <code>false</code> if the index file doesn't exist or doesn't contain the 
+   * set.
+   */
+  static bool ImportSetOffset (const std::string & index_filename, uint32_t set_number,
+                               std::streamoff & set_offset);
+
+  /**
+   * Moves the input file to the offset of the given set read from the index
+   * file. Returns <code>false</code>, without a meaningful position in the
+   * input file, if there is no offset for the set or if the offset doesn't
+   * point to the first line of the set (e.g. a stale index file).
+   */
+  static bool SeekIndexedListsSet (std::ifstream & input_file, const std::string & index_filename,
+                                   uint32_t set_number);
+
+  /**
+   * Returns the comment line that marks the beginning of the given set.
+   */
+  static std::string GetListsSetFirstLine (uint32_t set_number);
 };
 
 // RandomDestinationGeoTemporalAreasLists relational operators
@@ -563,6 +678,115 @@ operator<< (std::ostream & os, const RandomDestinationGeoTemporalAreasLists & ob
   return os;
 }
 
+
+// =============================================================================
+//                               ExpirationIndex
+// =============================================================================
+
+/**
+ * \ingroup geotemporal-library
+ * 
+ * Min-heap of (expiration time, key) pairs. The tables of the routing protocols
+ * use it to purge only their expired entries instead of checking the 
+ * expiration time of all the entries on every purge.
+ * 
+ * The index is lazy: the owner table pushes a new pair every time it sets the
+ * expiration time of an entry, and it doesn't remove the pairs of the entries 
+ * that it erases or whose expiration time it restarts. So when it pops the 
+ * expired pairs, the owner must ignore the keys that are no longer in the table
+ * or whose entries are not expired yet. When <code>NeedsRebuild</code> returns
+ * <code>true</code> most of the pairs are stale, and the owner should clear the
+ * index and push the pairs of its current entries.
+ * 
+ * The key type <code>Key</code> must have the less-than operator.
+ */
+template <typename Key>
+class ExpirationIndex
+{
+public:
+
+  typedef std::pair<ns3::Time, Key> value_type;
+
+private:
+
+  /** Minimum number of pairs in the index before it needs to be rebuilt. */
+  static const uint32_t MIN_REBUILD_SIZE = 64u;
+
+  /** Pairs of the index, ordered as a heap with the earliest pair on top. */
+  std::vector<value_type> m_heap;
+
+public:
+
+  ExpirationIndex () : m_heap () { }
+
+  ExpirationIndex (const ExpirationIndex & copy) : m_heap (copy.m_heap) { }
+
+  inline std::size_t
+  size () const
+  {
+    return m_heap.size ();
+  }
+
+  inline bool
+  empty () const
+  {
+    return m_heap.empty ();
+  }
+
+  inline void
+  clear ()
+  {
+    m_heap.clear ();
+  }
+
+  /**
+   * Adds a pair with the key of an entry and the (absolute) simulation time at
+   * which the entry expires.
+   */
+  void
+  Push (const Key & key, const ns3::Time & expiration_time)
+  {
+    m_heap.push_back (value_type (expiration_time, key));
+    std::push_heap (m_heap.begin (), m_heap.end (), std::greater<value_type> ());
+  }
+
+  /**
+   * Returns <code>true</code> if the earliest pair of the index expires at or
+   * before the given time instant.
+   */
+  inline bool
+  HasExpired (const ns3::Time & time_instant) const
+  {
+    return !m_heap.empty () && m_heap.front ().first <= time_instant;
+  }
+
+  /**
+   * Removes the earliest pair of the index and returns its key. The index must
+   * not be empty.
+   */
+  Key
+  Pop ()
+  {
+    std::pop_heap (m_heap.begin (), m_heap.end (), std::greater<value_type> ());
+    const Key key = m_heap.back ().second;
+    m_heap.pop_back ();
+    return key;
+  }
+
+  /**
+   * Returns <code>true</code> if the index has more than twice as many pairs as
+   * the given number of entries of its owner table.
+   */
+  inline bool
+  NeedsRebuild (std::size_t entries_count) const
+  {
+    return m_heap.size () > MIN_REBUILD_SIZE && m_heap.size () > 2u * entries_count;
+  }
+};
+
+template <typename Key>
+const uint32_t ExpirationIndex<Key>::MIN_REBUILD_SIZE;
+
 }
 }
 
@@ -216,7 +216,7 @@ VisitorNode::Print (std::ostream & os) const
 // =============================================================================
 
 GeoTemporalAreasVisitorNodes::GeoTemporalAreasVisitorNodes ()
-: m_geo_temporal_areas_visitors () { }
+: m_geo_temporal_areas_visitors (), m_visitors_index () { }
 
 GeoTemporalAreasVisitorNodes::GeoTemporalAreasVisitorNodes (const std::string & input_filename)
 : GeoTemporalAreasVisitorNodes ()
@@ -326,14 +326,12 @@ GeoTemporalAreasVisitorNodes::GeoTemporalAreasVisitorNodes (const std::string &
           for (uint32_t i = 3u; i < tokens.size (); ++i)
             int_tokens.push_back ((uint32_t) std::stoi (tokens.at (i)));
 
-          while (!int_tokens.empty ())
-            {
-              visitor_nodes.insert (VisitorNode (int_tokens.at (0u), int_tokens.at (1u)));
-              int_tokens.erase (int_tokens.begin (), int_tokens.begin () + 2);
-            }
+          for (uint32_t i = 0u; i < int_tokens.size (); i += 2u)
+            visitor_nodes.insert (VisitorNode (int_tokens.at (i), int_tokens.at (i + 1u)));
         }
 
       m_geo_temporal_areas_visitors.insert (std::make_pair (geo_temporal_area, visitor_nodes));
+      IndexVisitorNodes (geo_temporal_area, visitor_nodes);
     }
 
   input_file.close ();
@@ -341,7 +339,35 @@ GeoTemporalAreasVisitorNodes::GeoTemporalAreasVisitorNodes (const std::string &
 }
 
 GeoTemporalAreasVisitorNodes::GeoTemporalAreasVisitorNodes (const GeoTemporalAreasVisitorNodes & copy)
-: m_geo_temporal_areas_visitors (copy.m_geo_temporal_areas_visitors) { }
+: m_geo_temporal_areas_visitors (copy.m_geo_temporal_areas_visitors),
+m_visitors_index (copy.m_visitors_index) { }
+
+void
+GeoTemporalAreasVisitorNodes::IndexVisitorNodes (const LibraryUtils::GeoTemporalArea & geo_temporal_area,
+                                                 const std::set<VisitorNode> & visitor_nodes)
+{
+  std::unordered_map<uint32_t, VisitorNode> & area_index = m_visitors_index[geo_temporal_area];
+  area_index.reserve (area_index.size () + visitor_nodes.size ());
+
+  for (std::set<VisitorNode>::const_iterator visitor_node_it = visitor_nodes.begin ();
+          visitor_node_it != visitor_nodes.end (); ++visitor_node_it)
+    {
+      IndexVisitorNode (area_index, *visitor_node_it);
+    }
+}
+
+void
+GeoTemporalAreasVisitorNodes::IndexVisitorNode (std::unordered_map<uint32_t, VisitorNode> & area_index,
+                                                const VisitorNode & visitor_node)
+{
+  std::pair<std::unordered_map<uint32_t, VisitorNode>::iterator, bool> insertion_result =
+          area_index.insert (std::make_pair (visitor_node.GetNodeId (), visitor_node));
+
+  // Keep the earliest arrival of the node, which is the one that precedes the
+  // others in the ordered set of visitor nodes.
+  if (!insertion_result.second && visitor_node < insertion_result.first->second)
+    insertion_result.first->second = visitor_node;
+}
 
 bool
 GeoTemporalAreasVisitorNodes::AddGeoTemporalArea (const LibraryUtils::GeoTemporalArea & geo_temporal_area)
@@ -349,6 +375,7 @@ GeoTemporalAreasVisitorNodes::AddGeoTemporalArea (const LibraryUtils::GeoTempora
   if (m_geo_temporal_areas_visitors.count (geo_temporal_area) == 1u) return false;
 
   m_geo_temporal_areas_visitors.insert (std::make_pair (geo_temporal_area, std::set<VisitorNode> ()));
+  m_visitors_index.insert (std::make_pair (geo_temporal_area, std::unordered_map<uint32_t, VisitorNode> ()));
   return true;
 }
 
@@ -369,6 +396,8 @@ GeoTemporalAreasVisitorNodes::AddVisitorNode (const LibraryUtils::GeoTemporalAre
     {
       gta_entry_it->second.insert (visitor_node);
     }
+
+  IndexVisitorNode (m_visitors_index[geo_temporal_area], visitor_node);
 }
 
 bool
@@ -391,37 +420,73 @@ GeoTemporalAreasVisitorNodes::GetGeoTemporalAreaVisitorNodes (const LibraryUtils
 }
 
 bool
-GeoTemporalAreasVisitorNodes::NodeVisitedGeoTemporalArea (uint32_t node_id,
-                                                          const LibraryUtils::GeoTemporalArea & geo_temporal_area) const
+GeoTemporalAreasVisitorNodes::TryGetGeoTemporalAreaVisitorNodes (const LibraryUtils::GeoTemporalArea & geo_temporal_area,
+                                                                 const std::set<VisitorNode> * & visitor_nodes) const
 {
-  try
-    {
-      GetVisitorNode (node_id, geo_temporal_area);
-      return true;
-    }
-  catch (std::exception & exception)
+  std::map<LibraryUtils::GeoTemporalArea, std::set<VisitorNode> >::const_iterator geo_temporal_area_visitors_it =
+          m_geo_temporal_areas_visitors.find (geo_temporal_area);
+
+  if (geo_temporal_area_visitors_it == m_geo_temporal_areas_visitors.end ())
     {
+      visitor_nodes = nullptr;
       return false;
     }
+
+  visitor_nodes = &geo_temporal_area_visitors_it->second;
+  return true;
+}
+
+bool
+GeoTemporalAreasVisitorNodes::NodeVisitedGeoTemporalArea (uint32_t node_id,
+                                                          const LibraryUtils::GeoTemporalArea & geo_temporal_area) const
+{
+  return FindIndexedVisitorNode (node_id, geo_temporal_area) != nullptr;
+}
+
+const VisitorNode *
+GeoTemporalAreasVisitorNodes::FindIndexedVisitorNode (uint32_t node_id,
+                                                      const LibraryUtils::GeoTemporalArea & geo_temporal_area) const
+{
+  std::map<LibraryUtils::GeoTemporalArea, std::unordered_map<uint32_t, VisitorNode> >::const_iterator area_index_it =
+          m_visitors_index.find (geo_temporal_area);
+
+  if (area_index_it == m_visitors_index.end ())
+    return nullptr;
+
+  std::unordered_map<uint32_t, VisitorNode>::const_iterator visitor_node_it = area_index_it->second.find (node_id);
+
+  if (visitor_node_it == area_index_it->second.end ())
+    return nullptr;
+
+  return &visitor_node_it->second;
+}
+
+bool
+GeoTemporalAreasVisitorNodes::TryGetVisitorNode (uint32_t node_id,
+                                                 const LibraryUtils::GeoTemporalArea & geo_temporal_area,
+                                                 VisitorNode & visitor_node) const
+{
+  const VisitorNode * found_visitor_node = FindIndexedVisitorNode (node_id, geo_temporal_area);
+
+  if (found_visitor_node == nullptr)
+    return false;
+
+  visitor_node = *found_visitor_node;
+  return true;
 }
 
 const VisitorNode &
 GeoTemporalAreasVisitorNodes::GetVisitorNode (uint32_t node_id,
                                               const LibraryUtils::GeoTemporalArea & geo_temporal_area) const
 {
-  std::map<LibraryUtils::GeoTemporalArea, std::set<VisitorNode> >::const_iterator geo_temporal_area_visitors_it =
-          m_geo_temporal_areas_visitors.find (geo_temporal_area);
-
-  if (geo_temporal_area_visitors_it == m_geo_temporal_areas_visitors.end ())
+  if (m_visitors_index.count (geo_temporal_area) == 0u)
     throw std::out_of_range ("Error: the specified geo-temporal area \"" + geo_temporal_area.ToString ()
                              + "\" is not known.");
 
-  for (std::set<VisitorNode>::const_iterator visitor_node_it = geo_temporal_area_visitors_it->second.begin ();
-          visitor_node_it != geo_temporal_area_visitors_it->second.end (); ++visitor_node_it)
-    {
-      if (node_id == visitor_node_it->GetNodeId ())
-        return *visitor_node_it;
-    }
+  const VisitorNode * found_visitor_node = FindIndexedVisitorNode (node_id, geo_temporal_area);
+
+  if (found_visitor_node != nullptr)
+    return *found_visitor_node;
 
   char buffer[25];
   std::sprintf (buffer, "%u", node_id);
@@ -5,6 +5,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 
 #include "vehicle-routes.h"
 #include "geotemporal-utils.h"
@@ -252,6 +253,39 @@ private:
 
   std::map<LibraryUtils::GeoTemporalArea, std::set<VisitorNode> > m_geo_temporal_areas_visitors;
 
+  /**
+   * Index of the visitor nodes of each geo-temporal area keyed by node ID. It
+   * allows to find a visitor node by its ID without scanning the whole set of
+   * visitor nodes of the area.
+   *
+   * If a node visited the same geo-temporal area more than once, only its
+   * earliest arrival is indexed (the same one that would be found first in the
+   * ordered set).
+   */
+  std::map<LibraryUtils::GeoTemporalArea, std::unordered_map<uint32_t, VisitorNode> > m_visitors_index;
+
+  /**
+   * Adds all the given visitor nodes to the index of the specified geo-temporal
+   * area.
+   */
+  void
+  IndexVisitorNodes (const LibraryUtils::GeoTemporalArea & geo_temporal_area,
+                     const std::set<VisitorNode> & visitor_nodes);
+
+  /**
+   * Adds the visitor node to the given index of a geo-temporal area.
+   */
+  static void
+  IndexVisitorNode (std::unordered_map<uint32_t, VisitorNode> & area_index, const VisitorNode & visitor_node);
+
+  /**
+   * Returns a pointer to the indexed visitor node of the given node ID in the
+   * specified geo-temporal area, or <code>nullptr</code> if the area is not known
+   * or the node didn't visit it.
+   */
+  const VisitorNode *
+  FindIndexedVisitorNode (uint32_t node_id, const LibraryUtils::GeoTemporalArea & geo_temporal_area) const;
+
 public:
 
   GeoTemporalAreasVisitorNodes ();
@@ -298,6 +332,21 @@ public:
   const std::set<VisitorNode> &
   GetGeoTemporalAreaVisitorNodes (const LibraryUtils::GeoTemporalArea & geo_temporal_area) const;
 
+  /**
+   * Retrieves the set of nodes that visited the specified geo-temporal area
+   * without throwing an exception.
+   *
+   * @param geo_temporal_area [IN] Visited geo-temporal area.
+   * @param visitor_nodes [OUT] Pointer to the set of visitor nodes of the area.
+   * It is set to <code>nullptr</code> if the area is not known.
+   *
+   * @return <code>true</code> if the geo-temporal area is known, otherwise
+   * <code>false</code>.
+   */
+  bool
+  TryGetGeoTemporalAreaVisitorNodes (const LibraryUtils::GeoTemporalArea & geo_temporal_area,
+                                     const std::set<VisitorNode> * & visitor_nodes) const;
+
   /**
    * Returns <code>true</code> if a node with the given ID visited the specified
    * geo-temporal area. Returns <code>false</code> otherwise.
@@ -316,6 +365,22 @@ public:
   const VisitorNode &
   GetVisitorNode (uint32_t node_id, const LibraryUtils::GeoTemporalArea & geo_temporal_area) const;
 
+  /**
+   * Retrieves the <code>VisitorNode</code> object of the node if it visited the
+   * specified geo-temporal area, without throwing an exception.
+   *
+   * @param node_id [IN] ID of the visitor node.
+   * @param geo_temporal_area [IN] Visited geo-temporal area.
+   * @param visitor_node [OUT] The visitor node. It is modified only if the node
+   * visited the geo-temporal area.
+   *
+   * @return <code>true</code> if the node visited the geo-temporal area,
+   * otherwise <code>false</code>.
+   */
+  bool
+  TryGetVisitorNode (uint32_t node_id, const LibraryUtils::GeoTemporalArea & geo_temporal_area,
+                     VisitorNode & visitor_node) const;
+
   /**
    * Exports the list of sets to a file.
    * @param filename Name of the output file.
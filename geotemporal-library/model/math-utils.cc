@@ -1,6 +1,7 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 #include "math-utils.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <fstream>
@@ -217,5 +218,162 @@ Area::Print (std::ostream & os) const
   os << ToString ();
 }
 
+
+// =============================================================================
+//                                    AreaSet
+// =============================================================================
+
+AreaSet::AreaSet ()
+: m_min_x (), m_min_y (), m_max_x (), m_max_y () { }
+
+AreaSet::AreaSet (const std::vector<Area> & areas)
+: AreaSet ()
+{
+  Reserve (areas.size ());
+
+  for (std::vector<Area>::const_iterator area_it = areas.begin (); area_it != areas.end (); ++area_it)
+    Add (*area_it);
+}
+
+AreaSet::AreaSet (const AreaSet & copy)
+: m_min_x (copy.m_min_x), m_min_y (copy.m_min_y), m_max_x (copy.m_max_x),
+m_max_y (copy.m_max_y) { }
+
+Area
+AreaSet::Get (uint32_t index) const
+{
+  return Area (m_min_x.at (index), m_min_y.at (index), m_max_x.at (index), m_max_y.at (index));
+}
+
+uint32_t
+AreaSet::Add (const Area & area)
+{
+  // Area coordinates are already sorted: coordinate 1 is the minimum and 
+  // coordinate 2 is the maximum.
+  m_min_x.push_back (area.GetX1 ());
+  m_min_y.push_back (area.GetY1 ());
+  m_max_x.push_back (area.GetX2 ());
+  m_max_y.push_back (area.GetY2 ());
+
+  return m_min_x.size () - 1u;
+}
+
+void
+AreaSet::Remove (uint32_t index)
+{
+  m_min_x.at (index) = m_min_x.back ();
+  m_min_y[index] = m_min_y.back ();
+  m_max_x[index] = m_max_x.back ();
+  m_max_y[index] = m_max_y.back ();
+
+  m_min_x.pop_back ();
+  m_min_y.pop_back ();
+  m_max_x.pop_back ();
+  m_max_y.pop_back ();
+}
+
+void
+AreaSet::Reserve (uint32_t areas_count)
+{
+  m_min_x.reserve (areas_count);
+  m_min_y.reserve (areas_count);
+  m_max_x.reserve (areas_count);
+  m_max_y.reserve (areas_count);
+}
+
+void
+AreaSet::Clear ()
+{
+  m_min_x.clear ();
+  m_min_y.clear ();
+  m_max_x.clear ();
+  m_max_y.clear ();
+}
+
+void
+AreaSet::ContainsPoint (const Vector2D & point, Bitmask_t & inside_mask) const
+{
+  const uint32_t areas_count = Size ();
+  const double x = point.m_x, y = point.m_y;
+  const double * min_x = m_min_x.data (), * min_y = m_min_y.data ();
+  const double * max_x = m_max_x.data (), * max_y = m_max_y.data ();
+
+  inside_mask.assign ((areas_count + 63u) / 64u, 0u);
+
+  // One word of the bitmask (64 areas) per block. Non-short-circuit operators
+  // are used so the inner loop doesn't branch.
+  for (uint32_t block_begin = 0u, word = 0u; block_begin < areas_count; block_begin += 64u, ++word)
+    {
+      const uint32_t block_end = std::min (block_begin + 64u, areas_count);
+      uint64_t bits = 0u;
+
+      for (uint32_t i = block_begin; i < block_end; ++i)
+        {
+          const bool inside = (min_x[i] <= x) & (x <= max_x[i]) & (min_y[i] <= y) & (y <= max_y[i]);
+          bits |= (uint64_t) inside << (i - block_begin);
+        }
+
+      inside_mask[word] = bits;
+    }
+}
+
+void
+AreaSet::ContainsAnyPoint (const Vector2D & point_1, const Vector2D & point_2,
+                           Bitmask_t & inside_mask) const
+{
+  const uint32_t areas_count = Size ();
+  const double x_1 = point_1.m_x, y_1 = point_1.m_y;
+  const double x_2 = point_2.m_x, y_2 = point_2.m_y;
+  const double * min_x = m_min_x.data (), * min_y = m_min_y.data ();
+  const double * max_x = m_max_x.data (), * max_y = m_max_y.data ();
+
+  inside_mask.assign ((areas_count + 63u) / 64u, 0u);
+
+  for (uint32_t block_begin = 0u, word = 0u; block_begin < areas_count; block_begin += 64u, ++word)
+    {
+      const uint32_t block_end = std::min (block_begin + 64u, areas_count);
+      uint64_t bits = 0u;
+
+      for (uint32_t i = block_begin; i < block_end; ++i)
+        {
+          const bool inside_1 = (min_x[i] <= x_1) & (x_1 <= max_x[i]) & (min_y[i] <= y_1) & (y_1 <= max_y[i]);
+          const bool inside_2 = (min_x[i] <= x_2) & (x_2 <= max_x[i]) & (min_y[i] <= y_2) & (y_2 <= max_y[i]);
+          bits |= (uint64_t) (inside_1 | inside_2) << (i - block_begin);
+        }
+
+      inside_mask[word] = bits;
+    }
+}
+
+void
+AreaSet::ContainsAnyPoint (const Vector2D & point_1, const Vector2D & point_2,
+                           const std::vector<uint32_t> & indexes, Bitmask_t & inside_mask) const
+{
+  const uint32_t indexes_count = indexes.size ();
+  const double x_1 = point_1.m_x, y_1 = point_1.m_y;
+  const double x_2 = point_2.m_x, y_2 = point_2.m_y;
+  const double * min_x = m_min_x.data (), * min_y = m_min_y.data ();
+  const double * max_x = m_max_x.data (), * max_y = m_max_y.data ();
+  const uint32_t * indexes_data = indexes.data ();
+
+  inside_mask.assign ((indexes_count + 63u) / 64u, 0u);
+
+  for (uint32_t block_begin = 0u, word = 0u; block_begin < indexes_count; block_begin += 64u, ++word)
+    {
+      const uint32_t block_end = std::min (block_begin + 64u, indexes_count);
+      uint64_t bits = 0u;
+
+      for (uint32_t j = block_begin; j < block_end; ++j)
+        {
+          const uint32_t i = indexes_data[j];
+          const bool inside_1 = (min_x[i] <= x_1) & (x_1 <= max_x[i]) & (min_y[i] <= y_1) & (y_1 <= max_y[i]);
+          const bool inside_2 = (min_x[i] <= x_2) & (x_2 <= max_x[i]) & (min_y[i] <= y_2) & (y_2 <= max_y[i]);
+          bits |= (uint64_t) (inside_1 | inside_2) << (j - block_begin);
+        }
+
+      inside_mask[word] = bits;
+    }
+}
+
 }
 }
@@ -2,6 +2,7 @@
 #ifndef UTILS_MATH_UTILS_H
 #define UTILS_MATH_UTILS_H
 
+#include <cstdint>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -404,6 +405,121 @@ operator<< (std::ostream & os, const Area & obj)
   return os;
 }
 
+
+// =============================================================================
+//                                    AreaSet
+// =============================================================================
+
+/**
+ * Set of areas stored in structure-of-arrays form (an array for each of the 
+ * minimum X, minimum Y, maximum X and maximum Y coordinates) to test many areas
+ * against one or two points at once.
+ * 
+ * The result of a test is a bitmask with one bit per area, in the same order in
+ * which the areas were added: area <code>i</code> is stored in the bit 
+ * <code>i % 64</code> of the word <code>i / 64</code>. The evaluation loops 
+ * don't have branches so the compiler can vectorize them.
+ */
+class AreaSet
+{
+public:
+
+  typedef std::vector<uint64_t> Bitmask_t;
+
+private:
+
+  std::vector<double> m_min_x;
+  std::vector<double> m_min_y;
+  std::vector<double> m_max_x;
+  std::vector<double> m_max_y;
+
+public:
+
+  AreaSet ();
+
+  AreaSet (const std::vector<Area> & areas);
+
+  AreaSet (const AreaSet & copy);
+
+  /**
+   * Returns the number of areas in the set.
+   */
+  inline uint32_t
+  Size () const
+  {
+    return m_min_x.size ();
+  }
+
+  /**
+   * Returns the area with the given index.
+   */
+  Area Get (uint32_t index) const;
+
+  /**
+   * Adds the area at the end of the set and returns its index.
+   */
+  uint32_t Add (const Area & area);
+
+  /**
+   * Removes the area with the given index. The last area of the set is moved
+   * to its position.
+   */
+  void Remove (uint32_t index);
+
+  /**
+   * Requests that the set capacity be at least enough to contain 
+   * <code>areas_count</code> areas.
+   */
+  void Reserve (uint32_t areas_count);
+
+  /**
+   * Removes all the areas from the set.
+   */
+  void Clear ();
+
+  /**
+   * Computes which areas contain the given <code>point</code>.
+   * @param point [IN] Point to test.
+   * @param inside_mask [OUT] Bitmask with the bits of the areas that contain 
+   * the point set.
+   */
+  void ContainsPoint (const Vector2D & point, Bitmask_t & inside_mask) const;
+
+  /**
+   * Computes which areas contain at least one of the given points.
+   * @param point_1 [IN] First point to test.
+   * @param point_2 [IN] Second point to test.
+   * @param inside_mask [OUT] Bitmask with the bits of the areas that contain 
+   * <code>point_1</code> or <code>point_2</code> set.
+   */
+  void ContainsAnyPoint (const Vector2D & point_1, const Vector2D & point_2,
+                         Bitmask_t & inside_mask) const;
+
+  /**
+   * Computes which of the areas with the given indexes contain at least one of
+   * the given points. Only those areas are tested, so a subset of a large set
+   * is tested without building a new set.
+   * @param point_1 [IN] First point to test.
+   * @param point_2 [IN] Second point to test.
+   * @param indexes [IN] Indexes of the areas to test. They must be valid.
+   * @param inside_mask [OUT] Bitmask with the bit <code>j</code> set if the 
+   * area with index <code>indexes[j]</code> contains <code>point_1</code> or
+   * <code>point_2</code>.
+   */
+  void ContainsAnyPoint (const Vector2D & point_1, const Vector2D & point_2,
+                         const std::vector<uint32_t> & indexes, Bitmask_t & inside_mask) const;
+
+  /**
+   * Returns <code>true</code> if the bit of the area with the given index is 
+   * set in the bitmask, otherwise returns <code>false</code>.
+   */
+  static inline bool
+  IsSet (const Bitmask_t & mask, uint32_t index)
+  {
+    return (mask[index / 64u] >> (index % 64u)) & 1u;
+  }
+};
+
 }
 }
 
@@ -1,9 +1,16 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 #include "packet-utils.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
+#include <iterator>
+#include <stdexcept>
 #include <vector>
 
+#include <ns3/address-utils.h>
+#include <ns3/simulator.h>
+
 #include "string-utils.h"
 
 namespace GeoTemporalLibrary
@@ -139,6 +146,67 @@ DecodeFloatFromInteger (uint32_t encoded, uint8_t negative_sign_bit_flag,
 }
 
 
+// -----------------------------------
+// Variable-length integers encoding & decoding
+// -----------------------------------
+
+uint64_t
+ZigZagEncode (int64_t value)
+{
+  return (static_cast<uint64_t> (value) << 1) ^ static_cast<uint64_t> (value >> 63);
+}
+
+int64_t
+ZigZagDecode (uint64_t encoded)
+{
+  return static_cast<int64_t> (encoded >> 1) ^ -static_cast<int64_t> (encoded & 1u);
+}
+
+uint32_t
+GetVarIntSerializedSize (uint64_t value)
+{
+  uint32_t size = 1u;
+
+  while (value >= 0x80u)
+    {
+      value >>= 7;
+      ++size;
+    }
+
+  return size;
+}
+
+void
+WriteVarInt (ns3::Buffer::Iterator & it, uint64_t value)
+{
+  while (value >= 0x80u)
+    {
+      it.WriteU8 (static_cast<uint8_t> (value | 0x80u));
+      value >>= 7;
+    }
+
+  it.WriteU8 (static_cast<uint8_t> (value));
+}
+
+uint64_t
+ReadVarInt (ns3::Buffer::Iterator & it)
+{
+  uint64_t value = 0u;
+  uint32_t shift = 0u;
+  uint8_t byte;
+
+  do
+    {
+      byte = it.ReadU8 ();
+      value |= static_cast<uint64_t> (byte & 0x7Fu) << shift;
+      shift += 7u;
+    }
+  while ((byte & 0x80u) && shift < 64u);
+
+  return value;
+}
+
+
 
 // =============================================================================
 //                                DataIdentifier
@@ -178,6 +246,809 @@ DataIdentifier::Print (std::ostream & os) const
   os << ToString ();
 }
 
+
+// Sets of DataIdentifier encoding & decoding
+
+uint32_t
+GetDeltaCodedSerializedSize (const std::set<DataIdentifier>& data_ids)
+{
+  uint32_t groups_count = 0u;
+  uint32_t size = 0u;
+
+  std::set<DataIdentifier>::const_iterator group_it = data_ids.begin ();
+
+  while (group_it != data_ids.end ())
+    {
+      const ns3::Ipv4Address & source_ip = group_it->GetSourceIp ();
+      uint32_t group_size = 0u;
+      uint16_t previous_id = 0u;
+
+      std::set<DataIdentifier>::const_iterator it = group_it;
+
+      for (; it != data_ids.end () && it->GetSourceIp () == source_ip; ++it)
+        {
+          if (group_size == 0u)
+            size += GetVarIntSerializedSize (it->GetSourceId ());
+          else
+            size += GetVarIntSerializedSize (it->GetSourceId () - previous_id - 1u);
+
+          previous_id = it->GetSourceId ();
+          ++group_size;
+        }
+
+      size += 4u + GetVarIntSerializedSize (group_size);
+      ++groups_count;
+      group_it = it;
+    }
+
+  return GetVarIntSerializedSize (groups_count) + size;
+}
+
+void
+WriteDeltaCoded (ns3::Buffer::Iterator & it, const std::set<DataIdentifier>& data_ids)
+{
+  // Count the number of groups (different source IP addresses) and their sizes.
+  std::vector<uint32_t> groups_sizes;
+
+  for (std::set<DataIdentifier>::const_iterator data_it = data_ids.begin ();
+          data_it != data_ids.end (); ++data_it)
+    {
+      if (data_it == data_ids.begin ()
+          || std::prev (data_it)->GetSourceIp () != data_it->GetSourceIp ())
+        groups_sizes.push_back (0u);
+
+      ++groups_sizes.back ();
+    }
+
+  WriteVarInt (it, groups_sizes.size ());
+
+  std::set<DataIdentifier>::const_iterator data_it = data_ids.begin ();
+
+  for (uint32_t group = 0u; group < groups_sizes.size (); ++group)
+    {
+      WriteTo (it, data_it->GetSourceIp ());
+      WriteVarInt (it, groups_sizes[group]);
+
+      WriteVarInt (it, data_it->GetSourceId ());
+      uint16_t previous_id = data_it->GetSourceId ();
+      ++data_it;
+
+      for (uint32_t k = 1u; k < groups_sizes[group]; ++k, ++data_it)
+        {
+          WriteVarInt (it, data_it->GetSourceId () - previous_id - 1u);
+          previous_id = data_it->GetSourceId ();
+        }
+    }
+}
+
+void
+ReadDeltaCoded (ns3::Buffer::Iterator & it, std::set<DataIdentifier>& data_ids)
+{
+  data_ids.clear ();
+
+  const uint64_t groups_count = ReadVarInt (it);
+  ns3::Ipv4Address source_ip;
+
+  for (uint64_t group = 0u; group < groups_count; ++group)
+    {
+      ReadFrom (it, source_ip);
+      const uint64_t group_size = ReadVarInt (it);
+
+      uint16_t source_id = (uint16_t) ReadVarInt (it);
+      data_ids.insert (data_ids.end (), DataIdentifier (source_ip, source_id));
+
+      for (uint64_t k = 1u; k < group_size; ++k)
+        {
+          source_id = (uint16_t) (source_id + ReadVarInt (it) + 1u);
+          data_ids.insert (data_ids.end (), DataIdentifier (source_ip, source_id));
+        }
+    }
+}
+
+void
+MergeDisjointVectors (const std::vector<DataIdentifier> & sorted_ids,
+                      const std::set<DataIdentifier> & ids_set,
+                      std::vector<DataIdentifier> * only_in_sorted_ids,
+                      std::vector<DataIdentifier> * only_in_ids_set)
+{
+  std::vector<DataIdentifier>::const_iterator sorted_it = sorted_ids.begin ();
+  std::set<DataIdentifier>::const_iterator set_it = ids_set.begin ();
+
+  while (sorted_it != sorted_ids.end () && set_it != ids_set.end ())
+    {
+      if (*sorted_it < *set_it)
+        {
+          if (only_in_sorted_ids != 0) only_in_sorted_ids->push_back (*sorted_it);
+          ++sorted_it;
+        }
+      else if (*set_it < *sorted_it)
+        {
+          if (only_in_ids_set != 0) only_in_ids_set->push_back (*set_it);
+          ++set_it;
+        }
+      else
+        {
+          ++sorted_it;
+          ++set_it;
+        }
+    }
+
+  if (only_in_sorted_ids != 0)
+    only_in_sorted_ids->insert (only_in_sorted_ids->end (), sorted_it, sorted_ids.end ());
+
+  if (only_in_ids_set != 0)
+    only_in_ids_set->insert (only_in_ids_set->end (), set_it, ids_set.end ());
+}
+
+
+// =============================================================================
+//                          CompactCoordinatesEncoding
+// =============================================================================
+
+const double CompactCoordinatesEncoding::POSITION_RESOLUTION = 0.001;
+
+const double CompactCoordinatesEncoding::VELOCITY_RESOLUTION = 0.0001;
+
+const double CompactCoordinatesEncoding::AREA_RESOLUTION = 0.001;
+
+uint64_t
+CompactCoordinatesEncoding::ToFixedPoint (double value, double resolution)
+{
+  return ZigZagEncode (std::llround (value / resolution));
+}
+
+double
+CompactCoordinatesEncoding::FromFixedPoint (uint64_t encoded, double resolution)
+{
+  return (double) ZigZagDecode (encoded) * resolution;
+}
+
+uint32_t
+CompactCoordinatesEncoding::GetPositionSerializedSize (const Vector2D & position)
+{
+  return GetVarIntSerializedSize (ToFixedPoint (position.m_x, POSITION_RESOLUTION))
+          + GetVarIntSerializedSize (ToFixedPoint (position.m_y, POSITION_RESOLUTION));
+}
+
+void
+CompactCoordinatesEncoding::WritePosition (ns3::Buffer::Iterator & it, const Vector2D & position)
+{
+  WriteVarInt (it, ToFixedPoint (position.m_x, POSITION_RESOLUTION));
+  WriteVarInt (it, ToFixedPoint (position.m_y, POSITION_RESOLUTION));
+}
+
+Vector2D
+CompactCoordinatesEncoding::ReadPosition (ns3::Buffer::Iterator & it)
+{
+  const double x = FromFixedPoint (ReadVarInt (it), POSITION_RESOLUTION);
+  const double y = FromFixedPoint (ReadVarInt (it), POSITION_RESOLUTION);
+  return Vector2D (x, y);
+}
+
+uint32_t
+CompactCoordinatesEncoding::GetVelocitySerializedSize (const Vector2D & velocity)
+{
+  return GetVarIntSerializedSize (ToFixedPoint (velocity.m_x, VELOCITY_RESOLUTION))
+          + GetVarIntSerializedSize (ToFixedPoint (velocity.m_y, VELOCITY_RESOLUTION));
+}
+
+void
+CompactCoordinatesEncoding::WriteVelocity (ns3::Buffer::Iterator & it, const Vector2D & velocity)
+{
+  WriteVarInt (it, ToFixedPoint (velocity.m_x, VELOCITY_RESOLUTION));
+  WriteVarInt (it, ToFixedPoint (velocity.m_y, VELOCITY_RESOLUTION));
+}
+
+Vector2D
+CompactCoordinatesEncoding::ReadVelocity (ns3::Buffer::Iterator & it)
+{
+  const double x = FromFixedPoint (ReadVarInt (it), VELOCITY_RESOLUTION);
+  const double y = FromFixedPoint (ReadVarInt (it), VELOCITY_RESOLUTION);
+  return Vector2D (x, y);
+}
+
+uint32_t
+CompactCoordinatesEncoding::GetAreaSerializedSize (const Area & area)
+{
+  return GetVarIntSerializedSize (ToFixedPoint (area.GetX1 (), AREA_RESOLUTION))
+          + GetVarIntSerializedSize (ToFixedPoint (area.GetY1 (), AREA_RESOLUTION))
+          + GetVarIntSerializedSize (ToFixedPoint (area.GetX2 (), AREA_RESOLUTION))
+          + GetVarIntSerializedSize (ToFixedPoint (area.GetY2 (), AREA_RESOLUTION));
+}
+
+void
+CompactCoordinatesEncoding::WriteArea (ns3::Buffer::Iterator & it, const Area & area)
+{
+  WriteVarInt (it, ToFixedPoint (area.GetX1 (), AREA_RESOLUTION));
+  WriteVarInt (it, ToFixedPoint (area.GetY1 (), AREA_RESOLUTION));
+  WriteVarInt (it, ToFixedPoint (area.GetX2 (), AREA_RESOLUTION));
+  WriteVarInt (it, ToFixedPoint (area.GetY2 (), AREA_RESOLUTION));
+}
+
+Area
+CompactCoordinatesEncoding::ReadArea (ns3::Buffer::Iterator & it)
+{
+  const double x1 = FromFixedPoint (ReadVarInt (it), AREA_RESOLUTION);
+  const double y1 = FromFixedPoint (ReadVarInt (it), AREA_RESOLUTION);
+  const double x2 = FromFixedPoint (ReadVarInt (it), AREA_RESOLUTION);
+  const double y2 = FromFixedPoint (ReadVarInt (it), AREA_RESOLUTION);
+  return Area (x1, y1, x2, y2);
+}
+
+
+// =============================================================================
+//                           DataIdentifierBloomFilter
+// =============================================================================
+
+DataIdentifierBloomFilter::DataIdentifierBloomFilter ()
+: m_bits (), m_bits_count (0u), m_hash_functions_count (1u) { }
+
+DataIdentifierBloomFilter::DataIdentifierBloomFilter (uint32_t expected_entries,
+                                                      double false_positive_rate)
+: m_bits (), m_bits_count (0u), m_hash_functions_count (1u)
+{
+  if (false_positive_rate <= 0.0 || false_positive_rate >= 1.0)
+    throw std::invalid_argument ("Invalid false positive rate: it must be between 0 and 1.");
+
+  if (expected_entries == 0u) return;
+
+  // Optimal number of bits: m = -n ln (p) / ln (2)^2, rounded up to whole bytes.
+  const double ln_2 = std::log (2.0);
+  const double bits_count = std::ceil (-(double) expected_entries * std::log (false_positive_rate)
+                                       / (ln_2 * ln_2));
+  m_bits.assign (((uint32_t) bits_count + 7u) / 8u, 0u);
+  m_bits_count = m_bits.size () * 8u;
+
+  // Optimal number of hash functions: k = (m / n) ln (2)
+  const double hash_functions_count = std::round (((double) m_bits_count / expected_entries) * ln_2);
+  m_hash_functions_count = (uint8_t) std::min (std::max (hash_functions_count, 1.0), 16.0);
+}
+
+DataIdentifierBloomFilter::DataIdentifierBloomFilter (const std::set<DataIdentifier>& data_ids,
+                                                      double false_positive_rate)
+: DataIdentifierBloomFilter (data_ids.size (), false_positive_rate)
+{
+  for (std::set<DataIdentifier>::const_iterator it = data_ids.begin ();
+          it != data_ids.end (); ++it)
+    {
+      Insert (*it);
+    }
+}
+
+DataIdentifierBloomFilter::DataIdentifierBloomFilter (const DataIdentifierBloomFilter& copy)
+: m_bits (copy.m_bits), m_bits_count (copy.m_bits_count),
+m_hash_functions_count (copy.m_hash_functions_count) { }
+
+uint64_t
+DataIdentifierBloomFilter::Hash (const DataIdentifier& data_id)
+{
+  return HashDataIdentifier (data_id);
+}
+
+void
+DataIdentifierBloomFilter::Insert (const DataIdentifier& data_id)
+{
+  if (m_bits_count == 0u)
+    throw std::out_of_range ("The bloom filter has no bits to insert the identifier.");
+
+  // Double hashing: the i-th bit index is h1 + i * h2
+  const uint64_t hash = Hash (data_id);
+  const uint32_t h1 = (uint32_t) hash;
+  const uint32_t h2 = (uint32_t) (hash >> 32) | 1u;
+
+  for (uint8_t i = 0u; i < m_hash_functions_count; ++i)
+    {
+      const uint32_t bit_index = (uint32_t) ((h1 + (uint64_t) i * h2) % m_bits_count);
+      m_bits[bit_index / 8u] |= (uint8_t) (1u << (bit_index % 8u));
+    }
+}
+
+bool
+DataIdentifierBloomFilter::MayContain (const DataIdentifier& data_id) const
+{
+  if (m_bits_count == 0u) return false;
+
+  const uint64_t hash = Hash (data_id);
+  const uint32_t h1 = (uint32_t) hash;
+  const uint32_t h2 = (uint32_t) (hash >> 32) | 1u;
+
+  for (uint8_t i = 0u; i < m_hash_functions_count; ++i)
+    {
+      const uint32_t bit_index = (uint32_t) ((h1 + (uint64_t) i * h2) % m_bits_count);
+
+      if ((m_bits[bit_index / 8u] & (1u << (bit_index % 8u))) == 0u)
+        return false;
+    }
+
+  return true;
+}
+
+uint32_t
+DataIdentifierBloomFilter::GetSerializedSize () const
+{
+  return 1u + GetVarIntSerializedSize (m_bits.size ()) + m_bits.size ();
+}
+
+void
+DataIdentifierBloomFilter::Serialize (ns3::Buffer::Iterator & it) const
+{
+  it.WriteU8 (m_hash_functions_count);
+  WriteVarInt (it, m_bits.size ());
+
+  if (!m_bits.empty ())
+    it.Write (m_bits.data (), m_bits.size ());
+}
+
+void
+DataIdentifierBloomFilter::Deserialize (ns3::Buffer::Iterator & it)
+{
+  m_hash_functions_count = it.ReadU8 ();
+  m_bits.assign ((uint32_t) ReadVarInt (it), 0u);
+  m_bits_count = m_bits.size () * 8u;
+
+  if (!m_bits.empty ())
+    it.Read (m_bits.data (), m_bits.size ());
+}
+
+
+// =============================================================================
+//                             SummaryVectorEncoding
+// =============================================================================
+
+std::string
+ToString (const SummaryVectorEncoding& obj)
+{
+  switch (obj)
+    {
+    case SummaryVectorEncoding::Explicit:
+      return "Explicit";
+    case SummaryVectorEncoding::DeltaCoded:
+      return "DeltaCoded";
+    case SummaryVectorEncoding::BloomFilter:
+      return "BloomFilter";
+    case SummaryVectorEncoding::Incremental:
+      return "Incremental";
+    default:
+      return "Unknown";
+    }
+}
+
+
+// =============================================================================
+//                              CachedPacketIdSet
+// =============================================================================
+
+const uint32_t CachedPacketIdSet::MIN_SLOTS_COUNT;
+
+CachedPacketIdSet::CachedPacketIdSet ()
+: m_slots (), m_used_slots (), m_expiration_queue () { }
+
+CachedPacketIdSet::CachedPacketIdSet (const CachedPacketIdSet & copy)
+: m_slots (copy.m_slots), m_used_slots (copy.m_used_slots),
+m_expiration_queue (copy.m_expiration_queue) { }
+
+bool
+CachedPacketIdSet::Find (const ns3::Ipv4Address & source_ip, uint32_t packet_id) const
+{
+  if (m_slots.empty ()) return false;
+
+  return m_used_slots[FindSlot (GetKey (source_ip, packet_id))];
+}
+
+bool
+CachedPacketIdSet::Insert (const ns3::Ipv4Address & source_ip, uint32_t packet_id,
+                           const ns3::Time & expiration_time)
+{
+  const uint64_t key = GetKey (source_ip, packet_id);
+
+  if (!m_slots.empty () && m_used_slots[FindSlot (key)])
+    return false;
+
+  // Keep the load factor of the hash set at 3/4 at most.
+  if ((m_expiration_queue.size () + 1u) * 4u > m_slots.size () * 3u)
+    Rehash (std::max<std::size_t> (MIN_SLOTS_COUNT, m_slots.size () * 2u));
+
+  const uint32_t slot = FindSlot (key);
+  m_slots[slot] = key;
+  m_used_slots[slot] = true;
+
+  // Pairs expire in the order they are inserted unless the expiration time 
+  // used by the owner decreases, so the position is searched from the back.
+  std::deque<std::pair<ns3::Time, uint64_t> >::iterator position = m_expiration_queue.end ();
+
+  while (position != m_expiration_queue.begin () && (position - 1)->first > expiration_time)
+    --position;
+
+  m_expiration_queue.insert (position, std::make_pair (expiration_time, key));
+  return true;
+}
+
+void
+CachedPacketIdSet::Purge (const ns3::Time & time_instant)
+{
+  while (!m_expiration_queue.empty () && m_expiration_queue.front ().first < time_instant)
+    {
+      EraseSlot (FindSlot (m_expiration_queue.front ().second));
+      m_expiration_queue.pop_front ();
+    }
+}
+
+void
+CachedPacketIdSet::Clear ()
+{
+  m_expiration_queue.clear ();
+  std::fill (m_used_slots.begin (), m_used_slots.end (), false);
+}
+
+uint32_t
+CachedPacketIdSet::FindSlot (uint64_t key) const
+{
+  const uint32_t mask = m_slots.size () - 1u;
+  uint32_t slot = HomeSlot (key);
+
+  while (m_used_slots[slot] && m_slots[slot] != key)
+    slot = (slot + 1u) & mask;
+
+  return slot;
+}
+
+void
+CachedPacketIdSet::EraseSlot (uint32_t slot)
+{
+  const uint32_t mask = m_slots.size () - 1u;
+  uint32_t next = (slot + 1u) & mask;
+
+  while (m_used_slots[next])
+    {
+      const uint32_t home = HomeSlot (m_slots[next]);
+
+      // The key can be moved back if its home slot is not between the empty 
+      // slot (exclusive) and its current slot.
+      if (((next - home) & mask) >= ((next - slot) & mask))
+        {
+          m_slots[slot] = m_slots[next];
+          m_used_slots[slot] = true;
+          slot = next;
+        }
+
+      next = (next + 1u) & mask;
+    }
+
+  m_used_slots[slot] = false;
+}
+
+void
+CachedPacketIdSet::Rehash (std::size_t slots_count)
+{
+  m_slots.assign (slots_count, 0u);
+  m_used_slots.assign (slots_count, false);
+
+  for (std::deque<std::pair<ns3::Time, uint64_t> >::const_iterator it = m_expiration_queue.begin ();
+          it != m_expiration_queue.end (); ++it)
+    {
+      const uint32_t slot = FindSlot (it->second);
+      m_slots[slot] = it->second;
+      m_used_slots[slot] = true;
+    }
+}
+
+
+
+// =============================================================================
+//                           DuplicatedPacketDetector
+// =============================================================================
+
+DuplicatedPacketDetector::DuplicatedPacketDetector ()
+: DuplicatedPacketDetector (ns3::Seconds (5)) { }
+
+DuplicatedPacketDetector::DuplicatedPacketDetector (const ns3::Time& expiration_time)
+: m_cache (), m_expiration_time (expiration_time) { }
+
+DuplicatedPacketDetector::DuplicatedPacketDetector (const DuplicatedPacketDetector& copy)
+: m_cache (copy.m_cache), m_expiration_time (copy.m_expiration_time) { }
+
+uint32_t
+DuplicatedPacketDetector::Size ()
+{
+  Purge ();
+  return m_cache.Size ();
+}
+
+void
+DuplicatedPacketDetector::Purge ()
+{
+  m_cache.Purge (ns3::Simulator::Now ());
+}
+
+bool
+DuplicatedPacketDetector::IsDuplicate (const ns3::Ipv4Address& source_ip,
+                                       const uint32_t packet_id)
+{
+  Purge ();
+
+  // The insertion fails if the identifier is already in the cache
+  return !m_cache.Insert (source_ip, packet_id, m_expiration_time + ns3::Simulator::Now ());
+}
+
+bool
+DuplicatedPacketDetector::IsDuplicate (ns3::Ptr<const ns3::Packet> packet_ptr,
+                                       const ns3::Ipv4Header& ipv4_header)
+{
+  return IsDuplicate (ipv4_header.GetSource (), packet_ptr->GetUid ());
+}
+
+
+
+// =============================================================================
+//                                Ipv4AddressSet
+// =============================================================================
+
+const uint32_t Ipv4AddressSet::MAX_SORTED_ADDRESSES;
+
+Ipv4AddressSet::Ipv4AddressSet ()
+: m_values (), m_bitmap_base (0u), m_size (0u), m_bitmap_form (false) { }
+
+Ipv4AddressSet::Ipv4AddressSet (const Ipv4AddressSet & copy)
+: m_values (copy.m_values), m_bitmap_base (copy.m_bitmap_base), m_size (copy.m_size),
+m_bitmap_form (copy.m_bitmap_form) { }
+
+bool
+Ipv4AddressSet::Contains (const ns3::Ipv4Address & ip) const
+{
+  const uint32_t address = ip.Get ();
+
+  if (!m_bitmap_form)
+    return std::binary_search (m_values.begin (), m_values.end (), address);
+
+  if (address < m_bitmap_base) return false;
+
+  const uint32_t offset = address - m_bitmap_base;
+
+  if (offset / 32u >= m_values.size ()) return false;
+
+  return (m_values[offset / 32u] >> (offset % 32u)) & 1u;
+}
+
+bool
+Ipv4AddressSet::Insert (const ns3::Ipv4Address & ip)
+{
+  const uint32_t address = ip.Get ();
+
+  if (m_bitmap_form)
+    {
+      if (Contains (ip)) return false;
+
+      const uint32_t first_address = std::min (address, m_bitmap_base);
+      const uint32_t last_address = std::max (address, m_bitmap_base + (uint32_t) m_values.size () * 32u - 1u);
+
+      // Go back to the sorted vector if the bitmap would become too sparse.
+      if (GetBitmapWordsCount (first_address, last_address) > 2u * (m_size + 1u))
+        {
+          ToSortedForm ();
+        }
+      else
+        {
+          if (address < m_bitmap_base)
+            {
+              const uint32_t new_bitmap_base = address & ~31u;
+              m_values.insert (m_values.begin (), (m_bitmap_base - new_bitmap_base) / 32u, 0u);
+              m_bitmap_base = new_bitmap_base;
+            }
+          else if ((address - m_bitmap_base) / 32u >= m_values.size ())
+            {
+              m_values.resize ((address - m_bitmap_base) / 32u + 1u, 0u);
+            }
+
+          const uint32_t offset = address - m_bitmap_base;
+          m_values[offset / 32u] |= 1u << (offset % 32u);
+          ++m_size;
+          return true;
+        }
+    }
+
+  std::vector<uint32_t>::iterator it = std::lower_bound (m_values.begin (), m_values.end (), address);
+
+  if (it != m_values.end () && *it == address) return false;
+
+  m_values.insert (it, address);
+  ++m_size;
+
+  // The bitmap takes less memory when it has no more words than addresses.
+  if (m_size > MAX_SORTED_ADDRESSES
+      && GetBitmapWordsCount (m_values.front (), m_values.back ()) <= m_size)
+    ToBitmapForm ();
+
+  return true;
+}
+
+void
+Ipv4AddressSet::Clear ()
+{
+  std::vector<uint32_t> ().swap (m_values);
+  m_bitmap_base = 0u;
+  m_size = 0u;
+  m_bitmap_form = false;
+}
+
+void
+Ipv4AddressSet::GetAddresses (std::set<ns3::Ipv4Address> & addresses) const
+{
+  addresses.clear ();
+
+  if (!m_bitmap_form)
+    {
+      for (std::vector<uint32_t>::const_iterator it = m_values.begin (); it != m_values.end (); ++it)
+        addresses.insert (addresses.end (), ns3::Ipv4Address (*it));
+      return;
+    }
+
+  for (uint32_t word = 0u; word < m_values.size (); ++word)
+    for (uint32_t bit = 0u; bit < 32u; ++bit)
+      if ((m_values[word] >> bit) & 1u)
+        addresses.insert (addresses.end (), ns3::Ipv4Address (m_bitmap_base + word * 32u + bit));
+}
+
+void
+Ipv4AddressSet::ToBitmapForm ()
+{
+  const uint32_t bitmap_base = m_values.front () & ~31u;
+  std::vector<uint32_t> bitmap (GetBitmapWordsCount (m_values.front (), m_values.back ()), 0u);
+
+  for (std::vector<uint32_t>::const_iterator it = m_values.begin (); it != m_values.end (); ++it)
+    bitmap[(*it - bitmap_base) / 32u] |= 1u << ((*it - bitmap_base) % 32u);
+
+  m_values.swap (bitmap);
+  m_bitmap_base = bitmap_base;
+  m_bitmap_form = true;
+}
+
+void
+Ipv4AddressSet::ToSortedForm ()
+{
+  std::vector<uint32_t> sorted_addresses;
+  sorted_addresses.reserve (m_size + 1u);
+
+  for (uint32_t word = 0u; word < m_values.size (); ++word)
+    for (uint32_t bit = 0u; bit < 32u; ++bit)
+      if ((m_values[word] >> bit) & 1u)
+        sorted_addresses.push_back (m_bitmap_base + word * 32u + bit);
+
+  m_values.swap (sorted_addresses);
+  m_bitmap_base = 0u;
+  m_bitmap_form = false;
+}
+
+// Ipv4AddressSet relational operators
+
+bool
+operator== (const Ipv4AddressSet & lhs, const Ipv4AddressSet & rhs)
+{
+  if (lhs.m_size != rhs.m_size) return false;
+
+  if (lhs.m_bitmap_form == rhs.m_bitmap_form)
+    return lhs.m_bitmap_base == rhs.m_bitmap_base && lhs.m_values == rhs.m_values;
+
+  // The same addresses may be kept in different forms.
+  std::set<ns3::Ipv4Address> lhs_addresses, rhs_addresses;
+  lhs.GetAddresses (lhs_addresses);
+  rhs.GetAddresses (rhs_addresses);
+
+  return lhs_addresses == rhs_addresses;
+}
+
+
+
+// =============================================================================
+//                                SharedMessage
+// =============================================================================
+
+SharedMessage::SharedMessage ()
+: m_buffer () { }
+
+SharedMessage::SharedMessage (const std::string & message)
+: m_buffer ()
+{
+  if (!message.empty ())
+    m_buffer = ns3::Create<MessageBuffer> (message);
+}
+
+SharedMessage::SharedMessage (const SharedMessage & copy)
+: m_buffer (copy.m_buffer) { }
+
+const std::string &
+SharedMessage::Get () const
+{
+  static const std::string empty_message;
+
+  return m_buffer == 0 ? empty_message : m_buffer->m_message;
+}
+
+void
+SharedMessage::Write (ns3::Buffer::Iterator & it) const
+{
+  if (m_buffer != 0)
+    it.Write ((const uint8_t *) m_buffer->m_message.data (), m_buffer->m_message.size ());
+
+  it.WriteU8 (0u);
+}
+
+void
+SharedMessage::Read (ns3::Buffer::Iterator & it)
+{
+  // Find the length of the message by counting the characters before the null
+  // terminator character.
+  ns3::Buffer::Iterator temporal_it = it;
+  uint32_t message_length = 0u;
+
+  while (temporal_it.ReadU8 () != 0u)
+    ++message_length;
+
+  std::string message (message_length, '\0');
+
+  if (message_length > 0u)
+    it.Read ((uint8_t *) &message[0], message_length);
+
+  it.ReadU8 (); // Null terminator
+
+  *this = SharedMessage (message);
+}
+
+
+// =============================================================================
+//                            ReplicaAllocationPolicy
+// =============================================================================
+
+ReplicaAllocationPolicy::~ReplicaAllocationPolicy () { }
+
+FixedReplicaAllocationPolicy::FixedReplicaAllocationPolicy (uint32_t replicas)
+: m_replicas (replicas) { }
+
+uint32_t
+FixedReplicaAllocationPolicy::GetInitialReplicas (double, const ns3::Time &) const
+{
+  return m_replicas;
+}
+
+DensityAdaptiveReplicaAllocationPolicy::DensityAdaptiveReplicaAllocationPolicy (uint32_t reference_replicas,
+                                                                                uint32_t min_replicas,
+                                                                                uint32_t max_replicas,
+                                                                                double reference_neighbors,
+                                                                                const ns3::Time & reference_lifetime)
+: m_reference_replicas (reference_replicas), m_min_replicas (min_replicas),
+m_max_replicas (max_replicas), m_reference_neighbors (reference_neighbors),
+m_reference_lifetime (reference_lifetime)
+{
+  if (min_replicas == 0u || min_replicas > max_replicas)
+    throw std::invalid_argument ("Invalid replicas: the minimum must be greater than 0 and "
+                                 "not greater than the maximum.");
+
+  if (reference_neighbors <= 0.0 || !reference_lifetime.IsStrictlyPositive ())
+    throw std::invalid_argument ("Invalid reference: the neighbors and the lifetime must be "
+                                 "greater than 0.");
+}
+
+uint32_t
+DensityAdaptiveReplicaAllocationPolicy::GetInitialReplicas (double neighbors_average,
+                                                            const ns3::Time & remaining_lifetime) const
+{
+  if (neighbors_average <= 0.0)
+    return m_max_replicas;
+
+  double replicas = m_reference_replicas * (m_reference_neighbors / neighbors_average);
+
+  // A packet about to expire has fewer chances to meet carriers, and one with
+  // a long lifetime has more.
+  if (remaining_lifetime.IsStrictlyPositive ())
+    replicas *= m_reference_lifetime.GetSeconds () / remaining_lifetime.GetSeconds ();
+  else
+    replicas = m_min_replicas;
+
+  if (replicas >= m_max_replicas)
+    return m_max_replicas;
+
+  return std::max (m_min_replicas, (uint32_t) (replicas + 0.5));
+}
+
 }
 }
 
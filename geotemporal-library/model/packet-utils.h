@@ -2,10 +2,24 @@
 #ifndef UTILS_PACKET_UTILS_H
 #define UTILS_PACKET_UTILS_H
 
+#include "math-utils.h"
+
+#include <ns3/buffer.h>
 #include <ns3/ipv4-address.h>
+#include <ns3/ipv4-header.h>
+#include <ns3/nstime.h>
+#include <ns3/packet.h>
+#include <ns3/ptr.h>
+#include <ns3/simple-ref-count.h>
 
+#include <algorithm>
+#include <deque>
 #include <ostream>
+#include <set>
+#include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace GeoTemporalLibrary
 {
@@ -220,6 +234,52 @@ DecodeFloatFromInteger (uint32_t encoded, uint8_t negative_sign_bit_flag,
                         uint8_t negative_sign_bit_flag_position);
 
 
+// -----------------------------------
+// Variable-length integers encoding & decoding
+// -----------------------------------
+
+/**
+ * Maps a signed integer to an unsigned integer so that numbers with a small 
+ * absolute value are mapped to small numbers: 0, -1, 1, -2, 2, ... are mapped
+ * to 0, 1, 2, 3, 4, ...
+ */
+uint64_t
+ZigZagEncode (int64_t value);
+
+/**
+ * Inverse of <code>ZigZagEncode</code>.
+ */
+int64_t
+ZigZagDecode (uint64_t encoded);
+
+/**
+ * Returns the number of bytes (from 1 to 10) used by <code>WriteVarInt</code>
+ * to write the given value.
+ */
+uint32_t
+GetVarIntSerializedSize (uint64_t value);
+
+/**
+ * Writes the value in the buffer using 7 bits per byte, starting with the least
+ * significant bits. The most significant bit of each byte indicates if more 
+ * bytes follow.
+ * 
+ * @param it [IN/OUT] Buffer iterator, it is advanced past the written bytes.
+ * @param value [IN] Value to write.
+ */
+void
+WriteVarInt (ns3::Buffer::Iterator & it, uint64_t value);
+
+/**
+ * Reads a value written with <code>WriteVarInt</code>.
+ * 
+ * @param it [IN/OUT] Buffer iterator, it is advanced past the read bytes.
+ * @return The read value.
+ */
+uint64_t
+ReadVarInt (ns3::Buffer::Iterator & it);
+
+
 
 
 // =============================================================================
@@ -281,6 +341,19 @@ public:
     return m_source_id;
   }
 
+  /**
+   * Returns the identifier packed in a 64-bit integer: the source IP address in
+   * bits 16 to 47 and the source sequence number in bits 0 to 15.
+   * 
+   * Keys preserve the order of the identifiers: <code>a &lt; b</code> if and 
+   * only if <code>a.GetKey () &lt; b.GetKey ()</code>.
+   */
+  inline uint64_t
+  GetKey () const
+  {
+    return ((uint64_t) m_source_ip.Get () << 16) | m_source_id;
+  }
+
   /**
    * Returns a <code>string</code> object containing the representation of this
    * instance as a sequence of characters.
@@ -288,9 +361,6 @@ public:
   std::string ToString () const;
 
   void Print (std::ostream & os) const;
-
-  friend bool operator== (const DataIdentifier & lhs, const DataIdentifier & rhs);
-  friend bool operator< (const DataIdentifier & lhs, const DataIdentifier & rhs);
 };
 
 // DataIdentifier relational operators
@@ -298,7 +368,7 @@ public:
 inline bool
 operator== (const DataIdentifier & lhs, const DataIdentifier & rhs)
 {
-  return lhs.m_source_ip == rhs.m_source_ip && lhs.m_source_id == rhs.m_source_id;
+  return lhs.GetKey () == rhs.GetKey ();
 }
 
 inline bool
@@ -310,10 +380,7 @@ operator!= (const DataIdentifier & lhs, const DataIdentifier & rhs)
 inline bool
 operator< (const DataIdentifier & lhs, const DataIdentifier & rhs)
 {
-  if (lhs.m_source_ip != rhs.m_source_ip)
-    return lhs.m_source_ip < rhs.m_source_ip;
-
-  return lhs.m_source_id < rhs.m_source_id;
+  return lhs.GetKey () < rhs.GetKey ();
 }
 
 inline bool
@@ -343,6 +410,1104 @@ operator<< (std::ostream & os, const DataIdentifier & obj)
   return os;
 }
 
+/**
+ * Returns a 64-bit hash of the given 64-bit key (SplitMix64 finalizer). Keys 
+ * of the same source usually differ only in their low bits, so every bit of 
+ * the key must affect every bit of the hash.
+ */
+inline uint64_t
+HashKey (uint64_t key)
+{
+  uint64_t hash = key + 0x9E3779B97F4A7C15ull;
+  hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+  hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+  return hash ^ (hash >> 31);
+}
+
+/** Returns a 64-bit hash of the key of the data identifier. */
+inline uint64_t
+HashDataIdentifier (const DataIdentifier & data_id)
+{
+  return HashKey (data_id.GetKey ());
+}
+
+
+
+// =============================================================================
+//                              DataIdentifierMap
+// =============================================================================
+
+/**
+ * Hash table that maps data identifiers to values of type <code>T</code>, with
+ * a subset of the interface of <code>std::map&lt;DataIdentifier, T&gt;</code>.
+ * 
+ * The entries are stored contiguously in a vector, and an open addressing index
+ * (linear probing, power of two capacity, backward shift deletion) maps each 
+ * identifier to the position of its entry. So lookups take constant time and 
+ * iterating the entries doesn't chase pointers.
+ * 
+ * Unlike <code>std::map</code>:
+ * 
+ * - The entries are NOT sorted by identifier. They are iterated in insertion
+ *   order, except that erasing an entry moves the last entry to its position.
+ *   Code that breaks ties by iteration order must compare the identifiers.
+ * 
+ * - Inserting or erasing an entry invalidates all iterators. 
+ *   <code>erase (it)</code> returns a valid iterator to the next entry to
+ *   visit, so entries can be erased while iterating.
+ * 
+ * The identifiers sorted in increasing order are available through 
+ * <code>GetSortedKeys</code>. They are kept sorted on every insertion and 
+ * removal (a binary search and a shift of the following identifiers), so the
+ * map never sorts all of them again.
+ */
+template <typename T>
+class DataIdentifierMap
+{
+public:
+
+  typedef DataIdentifier key_type;
+  typedef T mapped_type;
+  typedef std::pair<DataIdentifier, T> value_type;
+  typedef typename std::vector<value_type>::iterator iterator;
+  typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+private:
+
+  /** Value of the index slots that don't point to any entry. */
+  static const uint32_t EMPTY_SLOT = 0xFFFFFFFFu;
+
+  /** Minimum number of slots of the index once an entry is inserted. */
+  static const uint32_t MIN_SLOTS_COUNT = 16u;
+
+  /** Entries of the map. */
+  std::vector<value_type> m_entries;
+
+  /** Open addressing index. Each slot has the position of an entry in 
+   * <code>m_entries</code> or <code>EMPTY_SLOT</code>. */
+  std::vector<uint32_t> m_slots;
+
+  /** Identifiers of the entries sorted in increasing order. */
+  std::vector<DataIdentifier> m_sorted_keys;
+
+public:
+
+  DataIdentifierMap () : m_entries (), m_slots (), m_sorted_keys () { }
+
+  DataIdentifierMap (const DataIdentifierMap & copy)
+  : m_entries (copy.m_entries), m_slots (copy.m_slots), m_sorted_keys (copy.m_sorted_keys) { }
+
+  inline std::size_t
+  size () const
+  {
+    return m_entries.size ();
+  }
+
+  inline bool
+  empty () const
+  {
+    return m_entries.empty ();
+  }
+
+  inline iterator
+  begin ()
+  {
+    return m_entries.begin ();
+  }
+
+  inline const_iterator
+  begin () const
+  {
+    return m_entries.begin ();
+  }
+
+  inline iterator
+  end ()
+  {
+    return m_entries.end ();
+  }
+
+  inline const_iterator
+  end () const
+  {
+    return m_entries.end ();
+  }
+
+  iterator
+  find (const DataIdentifier & data_id)
+  {
+    if (m_slots.empty ()) return m_entries.end ();
+
+    const uint32_t slot = FindSlot (data_id);
+    return m_slots[slot] == EMPTY_SLOT ? m_entries.end () : m_entries.begin () + m_slots[slot];
+  }
+
+  const_iterator
+  find (const DataIdentifier & data_id) const
+  {
+    if (m_slots.empty ()) return m_entries.end ();
+
+    const uint32_t slot = FindSlot (data_id);
+    return m_slots[slot] == EMPTY_SLOT ? m_entries.end () : m_entries.begin () + m_slots[slot];
+  }
+
+  inline std::size_t
+  count (const DataIdentifier & data_id) const
+  {
+    return find (data_id) == end () ? 0u : 1u;
+  }
+
+  /**
+   * Returns the value mapped to the given identifier. If the identifier is not
+   * in the map then it throws an <code>out_of_range</code> exception.
+   */
+  T &
+  at (const DataIdentifier & data_id)
+  {
+    const iterator it = find (data_id);
+
+    if (it == end ())
+      throw std::out_of_range ("The data identifier " + data_id.ToString () + " is not in the map.");
+
+    return it->second;
+  }
+
+  const T &
+  at (const DataIdentifier & data_id) const
+  {
+    const const_iterator it = find (data_id);
+
+    if (it == end ())
+      throw std::out_of_range ("The data identifier " + data_id.ToString () + " is not in the map.");
+
+    return it->second;
+  }
+
+  /**
+   * Inserts the entry if its identifier is not in the map. Returns an iterator
+   * to the entry with the identifier, and <code>true</code> if the entry was
+   * inserted.
+   */
+  std::pair<iterator, bool>
+  insert (const value_type & entry)
+  {
+    const iterator found_it = find (entry.first);
+
+    if (found_it != end ())
+      return std::make_pair (found_it, false);
+
+    // Keep the load factor of the index at 3/4 at most.
+    if ((m_entries.size () + 1u) * 4u > m_slots.size () * 3u)
+      Rehash (std::max<std::size_t> (MIN_SLOTS_COUNT, m_slots.size () * 2u));
+
+    m_slots[FindSlot (entry.first)] = m_entries.size ();
+    m_entries.push_back (entry);
+    m_sorted_keys.insert (std::lower_bound (m_sorted_keys.begin (), m_sorted_keys.end (), entry.first),
+                          entry.first);
+
+    return std::make_pair (m_entries.end () - 1, true);
+  }
+
+  /**
+   * Erases the given entry. Returns an iterator to the next entry to visit 
+   * (the last entry is moved to the position of the erased one).
+   */
+  iterator
+  erase (const_iterator position)
+  {
+    const uint32_t index = position - m_entries.begin ();
+
+    m_sorted_keys.erase (std::lower_bound (m_sorted_keys.begin (), m_sorted_keys.end (), position->first));
+    EraseSlot (FindSlot (position->first));
+
+    if (index + 1u != m_entries.size ())
+      {
+        m_slots[FindSlot (m_entries.back ().first)] = index;
+        m_entries[index] = m_entries.back ();
+      }
+
+    m_entries.pop_back ();
+    return m_entries.begin () + index;
+  }
+
+  /** Erases the entry with the given identifier. Returns the number of 
+   * erased entries (0 or 1). */
+  std::size_t
+  erase (const DataIdentifier & data_id)
+  {
+    const const_iterator it = find (data_id);
+
+    if (it == end ()) return 0u;
+
+    erase (it);
+    return 1u;
+  }
+
+  void
+  clear ()
+  {
+    m_entries.clear ();
+    std::fill (m_slots.begin (), m_slots.end (), EMPTY_SLOT);
+    m_sorted_keys.clear ();
+  }
+
+  /** Returns the identifiers of all the entries sorted in increasing order. */
+  inline const std::vector<DataIdentifier> &
+  GetSortedKeys () const
+  {
+    return m_sorted_keys;
+  }
+
+  DataIdentifierMap &
+  operator= (const DataIdentifierMap & other)
+  {
+    m_entries = other.m_entries;
+    m_slots = other.m_slots;
+    m_sorted_keys = other.m_sorted_keys;
+    return *this;
+  }
+
+  /** Two maps are equal if they have the same entries, in any order. */
+  friend bool
+  operator== (const DataIdentifierMap & lhs, const DataIdentifierMap & rhs)
+  {
+    if (lhs.size () != rhs.size ()) return false;
+
+    for (const_iterator it = lhs.begin (); it != lhs.end (); ++it)
+      {
+        const const_iterator rhs_it = rhs.find (it->first);
+
+        if (rhs_it == rhs.end () || !(rhs_it->second == it->second))
+          return false;
+      }
+
+    return true;
+  }
+
+  friend bool
+  operator!= (const DataIdentifierMap & lhs, const DataIdentifierMap & rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+
+  inline uint32_t
+  HomeSlot (const DataIdentifier & data_id) const
+  {
+    return HashDataIdentifier (data_id) & (m_slots.size () - 1u);
+  }
+
+  /** Returns the slot that points to the entry with the given identifier, or
+   * the empty slot where it would be inserted. The index must not be empty. */
+  uint32_t
+  FindSlot (const DataIdentifier & data_id) const
+  {
+    const uint32_t mask = m_slots.size () - 1u;
+    uint32_t slot = HomeSlot (data_id);
+
+    while (m_slots[slot] != EMPTY_SLOT && m_entries[m_slots[slot]].first != data_id)
+      slot = (slot + 1u) & mask;
+
+    return slot;
+  }
+
+  /** Empties the slot and shifts back the following slots of the probe 
+   * sequence, so that no lookup stops early at the new empty slot. */
+  void
+  EraseSlot (uint32_t slot)
+  {
+    const uint32_t mask = m_slots.size () - 1u;
+    uint32_t next = (slot + 1u) & mask;
+
+    while (m_slots[next] != EMPTY_SLOT)
+      {
+        const uint32_t home = HomeSlot (m_entries[m_slots[next]].first);
+
+        // The entry can be moved back if its home slot is not between the 
+        // empty slot (exclusive) and its current slot.
+        if (((next - home) & mask) >= ((next - slot) & mask))
+          {
+            m_slots[slot] = m_slots[next];
+            slot = next;
+          }
+
+        next = (next + 1u) & mask;
+      }
+
+    m_slots[slot] = EMPTY_SLOT;
+  }
+
+  void
+  Rehash (std::size_t slots_count)
+  {
+    m_slots.assign (slots_count, EMPTY_SLOT);
+
+    for (uint32_t index = 0u; index < m_entries.size (); ++index)
+      m_slots[FindSlot (m_entries[index].first)] = index;
+  }
+};
+
+template <typename T>
+const uint32_t DataIdentifierMap<T>::EMPTY_SLOT;
+
+template <typename T>
+const uint32_t DataIdentifierMap<T>::MIN_SLOTS_COUNT;
+
+// Sets of DataIdentifier encoding & decoding
+
+/**
+ * Returns the number of bytes used by <code>WriteDeltaCoded</code> to write
+ * the given set of data identifiers.
+ */
+uint32_t
+GetDeltaCodedSerializedSize (const std::set<DataIdentifier> & data_ids);
+
+/**
+ * Writes the set of data identifiers grouped by source IP address. Each source
+ * IP address is written once, followed by the number of identifiers of that
+ * source and their sequence numbers, each one as the variable-length gap from
+ * the previous one. Packets of the same source usually have consecutive 
+ * sequence numbers, so each identifier uses about 1 byte instead of 6.
+ */
+void
+WriteDeltaCoded (ns3::Buffer::Iterator & it, const std::set<DataIdentifier> & data_ids);
+
+/**
+ * Reads a set of data identifiers written by <code>WriteDeltaCoded</code>.
+ * The given set is emptied before reading.
+ */
+void
+ReadDeltaCoded (ns3::Buffer::Iterator & it, std::set<DataIdentifier> & data_ids);
+
+/**
+ * Computes both disjoint vectors of two sorted sequences of data identifiers 
+ * in a single linear merge pass.
+ * 
+ * The identifiers that are only in <code>sorted_ids</code> are appended to 
+ * <code>only_in_sorted_ids</code>, and the identifiers that are only in 
+ * <code>ids_set</code> are appended to <code>only_in_ids_set</code>, both in
+ * increasing order. Any of the output vectors can be null if it's not needed.
+ */
+void
+MergeDisjointVectors (const std::vector<DataIdentifier> & sorted_ids,
+                      const std::set<DataIdentifier> & ids_set,
+                      std::vector<DataIdentifier> * only_in_sorted_ids,
+                      std::vector<DataIdentifier> * only_in_ids_set);
+
+
+
+
+// =============================================================================
+//                          CompactCoordinatesEncoding
+// =============================================================================
+
+/**
+ * Compact encoding of positions, velocities and areas for packet headers.
+ * 
+ * Each coordinate is converted to a fixed-point integer with a fixed 
+ * resolution (see the constants of this class), then written as a zig-zag 
+ * variable-length integer (see <code>WriteVarInt</code>), instead of the 8 
+ * bytes (4 for velocities) of <code>EncodeDoubleToIntegers</code>.
+ * 
+ * Positions and area coordinates share the 1 millimeter resolution and are
+ * relative to the origin of the scenario, so each one uses 3 bytes up to 
+ * 1048 meters from the origin and 4 bytes up to 134 kilometers (an area uses
+ * 12 or 16 bytes instead of 32). A velocity component uses 3 bytes up to 
+ * 104 meters per second.
+ * 
+ * The coordinates are rounded to the nearest multiple of the resolution. The
+ * resolutions are constants (they are not transmitted), so any node, as well
+ * as the packet metadata, can decode a compact header by itself.
+ */
+class CompactCoordinatesEncoding
+{
+public:
+
+  /** Resolution of the encoded positions (1 millimeter). */
+  static const double POSITION_RESOLUTION;
+
+  /** Resolution of the encoded velocities (0.0001 meters per second). */
+  static const double VELOCITY_RESOLUTION;
+
+  /** Resolution of the encoded area coordinates (1 millimeter). */
+  static const double AREA_RESOLUTION;
+
+  /** Returns the number of bytes used to write the given position. */
+  static uint32_t
+  GetPositionSerializedSize (const Vector2D & position);
+
+  static void
+  WritePosition (ns3::Buffer::Iterator & it, const Vector2D & position);
+
+  static Vector2D
+  ReadPosition (ns3::Buffer::Iterator & it);
+
+  /** Returns the number of bytes used to write the given velocity. */
+  static uint32_t
+  GetVelocitySerializedSize (const Vector2D & velocity);
+
+  static void
+  WriteVelocity (ns3::Buffer::Iterator & it, const Vector2D & velocity);
+
+  static Vector2D
+  ReadVelocity (ns3::Buffer::Iterator & it);
+
+  /** Returns the number of bytes used to write the given area. */
+  static uint32_t
+  GetAreaSerializedSize (const Area & area);
+
+  static void
+  WriteArea (ns3::Buffer::Iterator & it, const Area & area);
+
+  static Area
+  ReadArea (ns3::Buffer::Iterator & it);
+
+private:
+
+  /** Converts the value to a zig-zag encoded fixed-point integer. */
+  static uint64_t
+  ToFixedPoint (double value, double resolution);
+
+  /** Inverse of <code>ToFixedPoint</code>. */
+  static double
+  FromFixedPoint (uint64_t encoded, double resolution);
+};
+
+
+// =============================================================================
+//                           DataIdentifierBloomFilter
+// =============================================================================
+
+/**
+ * Bloom filter of data identifiers.
+ * 
+ * It is a compact (lossy) representation of a set of data identifiers. 
+ * <code>MayContain</code> never fails for an inserted identifier, but it may 
+ * return <code>true</code> for an identifier that was never inserted (false
+ * positive) with the probability given at construction.
+ */
+class DataIdentifierBloomFilter
+{
+private:
+
+  /** Bit array of the filter. */
+  std::vector<uint8_t> m_bits;
+
+  /** Number of bits of the filter. */
+  uint32_t m_bits_count;
+
+  /** Number of hash functions (bits set per identifier). */
+  uint8_t m_hash_functions_count;
+
+public:
+
+  /** Creates an empty filter of 0 bits that contains nothing. */
+  DataIdentifierBloomFilter ();
+
+  /**
+   * Creates an empty filter sized to hold <code>expected_entries</code> 
+   * identifiers with the given false positive probability.
+   * 
+   * If the false positive probability is not between 0 and 1 (exclusive) then
+   * it throws an <code>invalid_argument</code> exception.
+   */
+  DataIdentifierBloomFilter (uint32_t expected_entries, double false_positive_rate);
+
+  /**
+   * Creates a filter sized to the given set of identifiers and inserts all of
+   * them.
+   * 
+   * If the false positive probability is not between 0 and 1 (exclusive) then
+   * it throws an <code>invalid_argument</code> exception.
+   */
+  DataIdentifierBloomFilter (const std::set<DataIdentifier> & data_ids,
+                             double false_positive_rate);
+
+  DataIdentifierBloomFilter (const DataIdentifierBloomFilter & copy);
+
+  inline uint32_t
+  GetBitsCount () const
+  {
+    return m_bits_count;
+  }
+
+  inline uint8_t
+  GetHashFunctionsCount () const
+  {
+    return m_hash_functions_count;
+  }
+
+  void
+  Insert (const DataIdentifier & data_id);
+
+  /**
+   * Returns <code>false</code> if the identifier is certainly not in the filter,
+   * and <code>true</code> if it probably is.
+   */
+  bool
+  MayContain (const DataIdentifier & data_id) const;
+
+  uint32_t
+  GetSerializedSize () const;
+
+  void
+  Serialize (ns3::Buffer::Iterator & it) const;
+
+  void
+  Deserialize (ns3::Buffer::Iterator & it);
+
+  friend bool operator== (const DataIdentifierBloomFilter & lhs,
+                          const DataIdentifierBloomFilter & rhs);
+
+private:
+
+  /** Returns a 64-bit hash of the data identifier. */
+  static uint64_t
+  Hash (const DataIdentifier & data_id);
+};
+
+// DataIdentifierBloomFilter relational operators
+
+inline bool
+operator== (const DataIdentifierBloomFilter & lhs, const DataIdentifierBloomFilter & rhs)
+{
+  return lhs.m_bits_count == rhs.m_bits_count
+          && lhs.m_hash_functions_count == rhs.m_hash_functions_count
+          && lhs.m_bits == rhs.m_bits;
+}
+
+inline bool
+operator!= (const DataIdentifierBloomFilter & lhs, const DataIdentifierBloomFilter & rhs)
+{
+  return !operator== (lhs, rhs);
+}
+
+
+
+
+// =============================================================================
+//                             SummaryVectorEncoding
+// =============================================================================
+
+/**
+ * Encodings of the summary vectors in REPLY and REPLY_BACK packets of the
+ * routing protocols.
+ * 
+ * 1. Explicit: each data identifier is written with 6 bytes.
+ * 
+ * 2. DeltaCoded: the data identifiers are grouped by source node and their 
+ *    sequence numbers are written as variable-length gaps (see 
+ *    <code>WriteDeltaCoded</code>). It is exact, like the explicit encoding.
+ * 
+ * 3. BloomFilter: a Bloom filter of the data identifiers, sized to the number 
+ *    of identifiers. It is lossy: the receiver can test if it (probably) 
+ *    contains a packet, but it can't list the packets. So a REPLY_BACK sent 
+ *    after a REPLY with a Bloom filter carries the Bloom filter of the whole
+ *    summary vector of its sender (instead of the requested packets), and the 
+ *    REPLY receiver computes the packets that it has to send.
+ * 
+ * 4. Incremental: the changes (inserted and removed data identifiers, both 
+ *    delta-coded) of the summary vector since the version that the receiver
+ *    already has. A base version 0 means that the whole summary vector is sent.
+ *    It is only used in REPLY packets. If the receiver can't apply the changes
+ *    it asks the REPLY sender for its whole summary vector with a dedicated
+ *    RESYNC_REQUEST packet. Only the Geo-Temporal protocol supports it, 
+ *    because it needs the versions of the summary vectors kept per neighbor.
+ */
+enum class SummaryVectorEncoding : uint8_t
+{
+  Explicit = 0, //< 6 bytes per data identifier.
+  DeltaCoded = 1, //< Data identifiers grouped by source and delta-coded.
+  BloomFilter = 2, //< Bloom filter of the data identifiers.
+  Incremental = 3 //< Delta-coded changes since a version of the summary vector.
+};
+
+/**
+ * Returns a <code>string</code> object containing the representation of the
+ * specified <code>SummaryVectorEncoding</code> value.
+ */
+std::string
+ToString (const SummaryVectorEncoding & obj);
+
+inline std::ostream &
+operator<< (std::ostream & os, const SummaryVectorEncoding & obj)
+{
+  os << ToString (obj);
+  return os;
+}
+
+
+// =============================================================================
+//                              CachedPacketIdSet
+// =============================================================================
+
+/**
+ * Set of (source IP address, packet ID) pairs that expire, used by the 
+ * detectors of duplicated packets of the protocols.
+ * 
+ * The pairs are stored in an open addressing hash set (linear probing, power of
+ * two capacity, backward shift deletion) and in a FIFO queue ordered by 
+ * expiration time. Pairs are usually inserted with increasing expiration times,
+ * so inserting, finding and purging pairs take constant amortized time.
+ */
+class CachedPacketIdSet
+{
+private:
+
+  /** Minimum number of slots of the hash set once a pair is inserted. */
+  static const uint32_t MIN_SLOTS_COUNT = 16u;
+
+  /** Keys of the slots of the hash set. */
+  std::vector<uint64_t> m_slots;
+
+  /** Flags that indicate which slots of the hash set are used. */
+  std::vector<bool> m_used_slots;
+
+  /** Expiration time and key of each pair, ordered by expiration time. */
+  std::deque<std::pair<ns3::Time, uint64_t> > m_expiration_queue;
+
+public:
+
+  CachedPacketIdSet ();
+
+  CachedPacketIdSet (const CachedPacketIdSet & copy);
+
+  /** Returns the number of pairs in the set. */
+  inline uint32_t
+  Size () const
+  {
+    return m_expiration_queue.size ();
+  }
+
+  /**
+   * Returns <code>true</code> if the pair of source IP address and packet ID is
+   * in the set.
+   */
+  bool
+  Find (const ns3::Ipv4Address & source_ip, uint32_t packet_id) const;
+
+  /**
+   * Inserts the pair of source IP address and packet ID, that expires at the
+   * given (absolute) time.
+   * 
+   * Returns <code>false</code> if the pair was already in the set, in which 
+   * case its expiration time is not changed.
+   */
+  bool
+  Insert (const ns3::Ipv4Address & source_ip, uint32_t packet_id,
+          const ns3::Time & expiration_time);
+
+  /**
+   * Removes the pairs whose expiration time is less than the given time 
+   * instant.
+   */
+  void
+  Purge (const ns3::Time & time_instant);
+
+  void
+  Clear ();
+
+private:
+
+  /** Returns the key of the pair of source IP address and packet ID. */
+  static inline uint64_t
+  GetKey (const ns3::Ipv4Address & source_ip, uint32_t packet_id)
+  {
+    return ((uint64_t) source_ip.Get () << 32) | packet_id;
+  }
+
+  inline uint32_t
+  HomeSlot (uint64_t key) const
+  {
+    return HashKey (key) & (m_slots.size () - 1u);
+  }
+
+  /** Returns the slot that has the given key, or the empty slot where it would
+   * be inserted. The hash set must not be empty. */
+  uint32_t
+  FindSlot (uint64_t key) const;
+
+  /** Empties the slot and shifts back the following slots of the probe 
+   * sequence, so that no lookup stops early at the new empty slot. */
+  void
+  EraseSlot (uint32_t slot);
+
+  void
+  Rehash (std::size_t slots_count);
+};
+
+
+// =============================================================================
+//                           DuplicatedPacketDetector
+// =============================================================================
+
+/**
+ * Helper class used to remember already seen packets and detect duplicates.
+ * It is shared by the routing protocols of all the Geo-Temporal modules.
+ * 
+ * The identifiers of the received packets are kept in a hash set with a FIFO
+ * queue ordered by expiration time, so checking a packet and purging the 
+ * expired identifiers take constant amortized time.
+ * 
+ * Currently, duplicate detection is based on unique packet ID given by
+ * Packet::GetUid (). This approach is known to be weak (ns3::Packet UID is an 
+ * internal identifier and not intended for logical uniqueness in models) and
+ * should be changed.
+ */
+class DuplicatedPacketDetector
+{
+private:
+
+  /** Cache to hold the packet identifiers and expiration time. */
+  CachedPacketIdSet m_cache;
+
+  /** Default expiration time of each individual entry in the cache. */
+  ns3::Time m_expiration_time;
+
+public:
+
+  DuplicatedPacketDetector ();
+
+  DuplicatedPacketDetector (const ns3::Time & expiration_time);
+
+  DuplicatedPacketDetector (const DuplicatedPacketDetector & copy);
+
+  inline void
+  SetExpirationTime (const ns3::Time & expiration_time)
+  {
+    m_expiration_time = expiration_time;
+  }
+
+  inline const ns3::Time &
+  GetExpirationTime () const
+  {
+    return m_expiration_time;
+  }
+
+  /**
+   * Returns the number of entries in the cache.
+   */
+  uint32_t
+  Size ();
+
+  /**
+   * Removes all expired entries.
+   */
+  void
+  Purge ();
+
+  /**
+   * Checks if a packet with the given pair of source IP address and ID exists.
+   * If it does exist then the packet is a duplicate and should be ignored, if 
+   * it doesn't exist then adds the data to the cache of received packets.
+   * 
+   * @param source_ip Source IP address of the received packet.
+   * @param packet_id ID of the received packet.
+   * 
+   * @return <code>true</code> if the packet is duplicated, otherwise 
+   * <code>false</code>.
+   */
+  bool
+  IsDuplicate (const ns3::Ipv4Address & source_ip, const uint32_t packet_id);
+
+  /**
+   * Checks if a packet with ID equal to the ID of the packet pointed by 
+   * <code>packet_ptr</code> and source IP address equal to the source IP in 
+   * <code>ipv4_header</code> exists.
+   * If it does exist then the packet is a duplicate and should be ignored, if 
+   * it doesn't exist then adds the data to the cache of received packets.
+   * 
+   * @param packet_ptr Constant pointer of the packet to check.
+   * @param ipv4_header The IP header to check.
+   * 
+   * @return <code>true</code> if the packet is duplicated, otherwise 
+   * <code>false</code>.
+   */
+  bool
+  IsDuplicate (ns3::Ptr<const ns3::Packet> packet_ptr, const ns3::Ipv4Header & ipv4_header);
+};
+
+
+// =============================================================================
+//                                Ipv4AddressSet
+// =============================================================================
+
+/**
+ * Compact set of IPv4 addresses, used to keep the known carrier nodes of the
+ * queued data packets.
+ * 
+ * Few addresses are kept as a sorted vector. When the set grows and its 
+ * addresses are dense (as the addresses of the nodes of a simulation usually
+ * are) it switches to a bitmap of the addresses starting at a base address, 
+ * which takes one bit per address of its range. If an insertion makes the 
+ * bitmap sparse, it switches back to the sorted vector.
+ */
+class Ipv4AddressSet
+{
+private:
+
+  /** Maximum number of addresses that are always kept as a sorted vector. */
+  static const uint32_t MAX_SORTED_ADDRESSES = 8u;
+
+  /** Sorted addresses, or words of the bitmap when in bitmap form. */
+  std::vector<uint32_t> m_values;
+
+  /** Address of the first bit of the bitmap (multiple of 32). */
+  uint32_t m_bitmap_base;
+
+  /** Number of addresses in the set. */
+  uint32_t m_size;
+
+  /** Indicates if the addresses are kept in the bitmap. */
+  bool m_bitmap_form;
+
+public:
+
+  Ipv4AddressSet ();
+
+  Ipv4AddressSet (const Ipv4AddressSet & copy);
+
+  inline uint32_t
+  Size () const
+  {
+    return m_size;
+  }
+
+  inline bool
+  Empty () const
+  {
+    return m_size == 0u;
+  }
+
+  /** Returns <code>true</code> if the set is in bitmap form. */
+  inline bool
+  IsBitmapForm () const
+  {
+    return m_bitmap_form;
+  }
+
+  bool
+  Contains (const ns3::Ipv4Address & ip) const;
+
+  /**
+   * Inserts the IP address in the set.
+   * 
+   * Returns <code>false</code> if the IP address was already in the set.
+   */
+  bool
+  Insert (const ns3::Ipv4Address & ip);
+
+  /** Removes all the addresses and releases the memory of the set. */
+  void
+  Clear ();
+
+  /** Stores all the addresses of the set in the output parameter. */
+  void
+  GetAddresses (std::set<ns3::Ipv4Address> & addresses) const;
+
+  friend bool operator== (const Ipv4AddressSet & lhs, const Ipv4AddressSet & rhs);
+
+private:
+
+  /** Returns the number of bitmap words needed for the given address range. */
+  static inline uint32_t
+  GetBitmapWordsCount (uint32_t first_address, uint32_t last_address)
+  {
+    return (last_address / 32u) - (first_address / 32u) + 1u;
+  }
+
+  void
+  ToBitmapForm ();
+
+  void
+  ToSortedForm ();
+};
+
+// Ipv4AddressSet relational operators
+
+bool
+operator== (const Ipv4AddressSet & lhs, const Ipv4AddressSet & rhs);
+
+inline bool
+operator!= (const Ipv4AddressSet & lhs, const Ipv4AddressSet & rhs)
+{
+  return !operator== (lhs, rhs);
+}
+
+
+// =============================================================================
+//                                SharedMessage
+// =============================================================================
+
+/**
+ * Immutable message of a data packet, shared by all the copies of the packet.
+ * 
+ * The characters of the message are kept in a reference-counted buffer, so 
+ * copying a packet header (into the packets queue, the created packets or an
+ * ACK) doesn't copy the message. It's serialized straight from the buffer, 
+ * followed by a null terminator character.
+ */
+class SharedMessage
+{
+private:
+
+  /** Reference-counted buffer of the characters of a message. */
+  struct MessageBuffer : public ns3::SimpleRefCount<MessageBuffer>
+  {
+    MessageBuffer (const std::string & message) : m_message (message) { }
+
+    const std::string m_message;
+  };
+
+  /** Buffer of the message, or null if the message is empty. */
+  ns3::Ptr<const MessageBuffer> m_buffer;
+
+public:
+
+  SharedMessage ();
+
+  SharedMessage (const std::string & message);
+
+  SharedMessage (const SharedMessage & copy);
+
+  /** Returns the characters of the message. */
+  const std::string &
+  Get () const;
+
+  /** Returns the number of characters of the message (without the null 
+   * terminator). */
+  inline uint32_t
+  Size () const
+  {
+    return m_buffer == 0 ? 0u : m_buffer->m_message.size ();
+  }
+
+  /** Returns <code>true</code> if both messages share the same buffer. */
+  inline bool
+  IsSharedWith (const SharedMessage & other) const
+  {
+    return m_buffer == other.m_buffer;
+  }
+
+  /** Writes the characters of the message followed by a null terminator. */
+  void
+  Write (ns3::Buffer::Iterator & it) const;
+
+  /** Reads a null-terminated message into a new buffer. */
+  void
+  Read (ns3::Buffer::Iterator & it);
+
+  friend bool operator== (const SharedMessage & lhs, const SharedMessage & rhs);
+};
+
+// SharedMessage relational operators
+
+inline bool
+operator== (const SharedMessage & lhs, const SharedMessage & rhs)
+{
+  return lhs.m_buffer == rhs.m_buffer || lhs.Get () == rhs.Get ();
+}
+
+inline bool
+operator!= (const SharedMessage & lhs, const SharedMessage & rhs)
+{
+  return !operator== (lhs, rhs);
+}
+
+
+// =============================================================================
+//                            ReplicaAllocationPolicy
+// =============================================================================
+
+/** Built-in policies to allocate the replicas of the new data packets. */
+enum class ReplicaAllocation : uint8_t
+{
+  /** Every new data packet gets the same number of replicas. */
+  Fixed = 0,
+  /** The replicas depend on the density of neighbor nodes and the remaining
+   * lifetime of the packet (see <code>DensityAdaptiveReplicaAllocationPolicy</code>). */
+  DensityAdaptive = 1
+};
+
+/**
+ * Policy that decides the number of replicas (the initial replica budget) of
+ * each data packet created by a node.
+ */
+class ReplicaAllocationPolicy : public ns3::SimpleRefCount<ReplicaAllocationPolicy>
+{
+public:
+
+  virtual ~ReplicaAllocationPolicy ();
+
+  /**
+   * Returns the number of replicas of a new data packet.
+   * 
+   * @param neighbors_average [IN] Estimated number of distinct neighbor nodes
+   * that the node meets, as measured by the routing protocol.
+   * @param remaining_lifetime [IN] Time left before the end of the time period
+   * of the destination geo-temporal area of the packet.
+   */
+  virtual uint32_t
+  GetInitialReplicas (double neighbors_average, const ns3::Time & remaining_lifetime) const = 0;
+};
+
+/** Allocates the same number of replicas to every new data packet. */
+class FixedReplicaAllocationPolicy : public ReplicaAllocationPolicy
+{
+private:
+
+  uint32_t m_replicas;
+
+public:
+
+  FixedReplicaAllocationPolicy (uint32_t replicas);
+
+  uint32_t
+  GetInitialReplicas (double neighbors_average, const ns3::Time & remaining_lifetime) const override;
+};
+
+/**
+ * Allocates fewer replicas where the node meets many neighbors, and more where
+ * it meets few of them or the packet has little time left.
+ * 
+ * The reference number of replicas is scaled by the ratio between the 
+ * reference number of neighbors and the estimated number of neighbors, and by
+ * the ratio between the reference lifetime and the remaining lifetime of the 
+ * packet. The result is rounded and bounded by the minimum and maximum number
+ * of replicas. Without neighbors (or without an estimate yet) the node is 
+ * treated as isolated and the maximum is allocated.
+ */
+class DensityAdaptiveReplicaAllocationPolicy : public ReplicaAllocationPolicy
+{
+private:
+
+  /** Replicas of a packet with the reference neighbors and lifetime. */
+  uint32_t m_reference_replicas;
+
+  uint32_t m_min_replicas;
+
+  uint32_t m_max_replicas;
+
+  double m_reference_neighbors;
+
+  ns3::Time m_reference_lifetime;
+
+public:
+
+  /**
+   * If <code>min_replicas</code> is 0 or greater than <code>max_replicas</code>,
+   * or the reference neighbors or lifetime are not greater than 0, then it 
+   * throws an <code>invalid_argument</code> exception.
+   */
+  DensityAdaptiveReplicaAllocationPolicy (uint32_t reference_replicas, uint32_t min_replicas,
+                                          uint32_t max_replicas, double reference_neighbors,
+                                          const ns3::Time & reference_lifetime);
+
+  uint32_t
+  GetInitialReplicas (double neighbors_average, const ns3::Time & remaining_lifetime) const override;
+};
+
 }
 }
 
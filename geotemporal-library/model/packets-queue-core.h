@@ -0,0 +1,476 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+#ifndef UTILS_PACKETS_QUEUE_CORE_H
+#define UTILS_PACKETS_QUEUE_CORE_H
+
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "geotemporal-utils.h"
+#include "packet-utils.h"
+
+#include <ns3/nstime.h>
+
+namespace GeoTemporalLibrary
+{
+namespace LibraryUtils
+{
+
+// =============================================================================
+//                                 Drop policies
+// =============================================================================
+
+/**
+ * \ingroup geotemporal-library
+ *
+ * Drop policy of the packets queues that drop the packet that expires first
+ * when they are full. Packets that expire at the same time are ordered by data
+ * identifier, so the dropped packet doesn't depend on the iteration order of
+ * the packets table.
+ *
+ * The entries must have the <code>GetExpirationInstant</code> function.
+ */
+struct DropEarliestExpiration
+{
+  template <typename EntryT>
+  static typename DataIdentifierMap<EntryT>::const_iterator
+  SelectPacketToDrop (const DataIdentifierMap<EntryT> & packets_table)
+  {
+    typename DataIdentifierMap<EntryT>::const_iterator selected_it = packets_table.begin ();
+
+    for (typename DataIdentifierMap<EntryT>::const_iterator entry_it = packets_table.begin ();
+            entry_it != packets_table.end (); ++entry_it)
+      {
+        const ns3::Time & expiration_instant = entry_it->second.GetExpirationInstant ();
+        const ns3::Time & selected_expiration_instant = selected_it->second.GetExpirationInstant ();
+
+        if (expiration_instant < selected_expiration_instant
+            || (expiration_instant == selected_expiration_instant && entry_it->first < selected_it->first))
+          selected_it = entry_it;
+      }
+
+    return selected_it;
+  }
+};
+
+/**
+ * \ingroup geotemporal-library
+ *
+ * Drop policy of the packets queues that select the packets to drop
+ * themselves (for example, with an index of drop priorities that depends on the
+ * position of the node). They drop the selected packet with
+ * <code>PacketsQueueCore::DropPacket</code>.
+ */
+struct ExternalDropPolicy
+{
+};
+
+
+// =============================================================================
+//                                Replica policies
+// =============================================================================
+
+/**
+ * \ingroup geotemporal-library
+ *
+ * Replica policy of the normal Spray and Wait mode: one replica is forwarded
+ * to each contacted node.
+ */
+struct NormalSprayReplicas
+{
+  /**
+   * Splits the replicas of a packet between the local node and the contacted
+   * node. Returns <code>false</code> (and doesn't split them) if there's one or
+   * less replicas left, because the packet can only be transmitted to its
+   * destination.
+   */
+  static inline bool
+  SplitReplicas (uint32_t current_replicas, uint32_t & replicas_to_forward, uint32_t & replicas_to_keep)
+  {
+    if (current_replicas <= 1u) return false;
+
+    replicas_to_forward = 1u;
+    replicas_to_keep = current_replicas - 1u;
+    return true;
+  }
+};
+
+/**
+ * \ingroup geotemporal-library
+ *
+ * Replica policy of the binary Spray and Wait mode: the contacted node gets
+ * floor(replicas / 2) replicas and the local node keeps ceil(replicas / 2).
+ */
+struct BinarySprayReplicas
+{
+  /** See <code>NormalSprayReplicas::SplitReplicas</code>. */
+  static inline bool
+  SplitReplicas (uint32_t current_replicas, uint32_t & replicas_to_forward, uint32_t & replicas_to_keep)
+  {
+    if (current_replicas <= 1u) return false;
+
+    replicas_to_forward = current_replicas / 2u;
+    replicas_to_keep = current_replicas - replicas_to_forward;
+    return true;
+  }
+};
+
+
+// =============================================================================
+//                               PacketsQueueCore
+// =============================================================================
+
+/**
+ * \ingroup geotemporal-library
+ *
+ * Storage shared by the packets queues of the routing protocols: a table of
+ * packet entries of type <code>EntryT</code> indexed by data identifier, the
+ * index of their expiration instants, the maximum length of the queue and the
+ * counter of packets dropped due to a full queue.
+ *
+ * The behavior that differs between protocols is given at compile time, so
+ * the hot paths are specialized and inlined for each protocol:
+ *
+ * - <code>DropPolicyT</code> selects the packet to drop when the queue is full
+ *   (<code>DropEarliestExpiration</code> or <code>ExternalDropPolicy</code>).
+ *
+ * - The forwarding filter of the disjoint vector is a function object passed to
+ *   <code>FilterPackets</code>, which is called with each candidate entry.
+ *
+ * The entries must have the <code>GetExpirationInstant</code> function, which
+ * returns the (absolute) simulation time at which they expire.
+ *
+ * It has the same interface as <code>DataIdentifierMap</code> (inserting an
+ * entry also indexes its expiration instant), so the queues use it as their
+ * packets table. It doesn't log the statistics of the packets, the queues do.
+ */
+template <typename EntryT, typename DropPolicyT>
+class PacketsQueueCore
+{
+public:
+
+  typedef typename DataIdentifierMap<EntryT>::value_type value_type;
+  typedef typename DataIdentifierMap<EntryT>::iterator iterator;
+  typedef typename DataIdentifierMap<EntryT>::const_iterator const_iterator;
+
+private:
+
+  /** Maximum number of packet entries that the queue can store at once. */
+  uint32_t m_max_queue_length;
+
+  /** The counter of all packets dropped due to a full queue. */
+  uint32_t m_packets_dropped_counter;
+
+  /** Data packets table. */
+  DataIdentifierMap<EntryT> m_packets_table;
+
+  /** Expiration instants of the data packet entries, used to purge only the
+   * expired entries. */
+  ExpirationIndex<DataIdentifier> m_expiration_index;
+
+public:
+
+  PacketsQueueCore (uint32_t maximum_queue_length)
+  : m_max_queue_length (maximum_queue_length), m_packets_dropped_counter (0u), m_packets_table (),
+  m_expiration_index () { }
+
+  PacketsQueueCore (const PacketsQueueCore & copy)
+  : m_max_queue_length (copy.m_max_queue_length), m_packets_dropped_counter (copy.m_packets_dropped_counter),
+  m_packets_table (copy.m_packets_table), m_expiration_index (copy.m_expiration_index) { }
+
+
+  // --------------------------
+  // Packets table
+  // --------------------------
+
+  inline std::size_t
+  size () const
+  {
+    return m_packets_table.size ();
+  }
+
+  inline bool
+  empty () const
+  {
+    return m_packets_table.empty ();
+  }
+
+  inline iterator
+  begin ()
+  {
+    return m_packets_table.begin ();
+  }
+
+  inline const_iterator
+  begin () const
+  {
+    return m_packets_table.begin ();
+  }
+
+  inline iterator
+  end ()
+  {
+    return m_packets_table.end ();
+  }
+
+  inline const_iterator
+  end () const
+  {
+    return m_packets_table.end ();
+  }
+
+  inline iterator
+  find (const DataIdentifier & data_id)
+  {
+    return m_packets_table.find (data_id);
+  }
+
+  inline const_iterator
+  find (const DataIdentifier & data_id) const
+  {
+    return m_packets_table.find (data_id);
+  }
+
+  inline std::size_t
+  count (const DataIdentifier & data_id) const
+  {
+    return m_packets_table.count (data_id);
+  }
+
+  inline EntryT &
+  at (const DataIdentifier & data_id)
+  {
+    return m_packets_table.at (data_id);
+  }
+
+  inline const EntryT &
+  at (const DataIdentifier & data_id) const
+  {
+    return m_packets_table.at (data_id);
+  }
+
+  /**
+   * Inserts the entry if its identifier is not in the table, and indexes its
+   * expiration instant. It doesn't check the maximum length of the queue.
+   */
+  std::pair<iterator, bool>
+  insert (const value_type & entry)
+  {
+    const std::pair<iterator, bool> inserted_result = m_packets_table.insert (entry);
+
+    if (inserted_result.second)
+      m_expiration_index.Push (entry.first, entry.second.GetExpirationInstant ());
+
+    return inserted_result;
+  }
+
+  /** Erases the given entry. The instant in the expiration index is ignored
+   * when it expires. */
+  inline iterator
+  erase (const_iterator position)
+  {
+    return m_packets_table.erase (position);
+  }
+
+  inline std::size_t
+  erase (const DataIdentifier & data_id)
+  {
+    return m_packets_table.erase (data_id);
+  }
+
+  inline void
+  clear ()
+  {
+    m_packets_table.clear ();
+    m_expiration_index.clear ();
+  }
+
+  /** Returns the identifiers of all the entries sorted in increasing order. */
+  inline const std::vector<DataIdentifier> &
+  GetSortedKeys () const
+  {
+    return m_packets_table.GetSortedKeys ();
+  }
+
+
+  // --------------------------
+  // Queue
+  // --------------------------
+
+  inline uint32_t
+  GetMaxLength () const
+  {
+    return m_max_queue_length;
+  }
+
+  inline void
+  SetMaxLength (uint32_t maximum_queue_length)
+  {
+    m_max_queue_length = maximum_queue_length;
+  }
+
+  inline uint32_t
+  GetDroppedPacketsCounter () const
+  {
+    return m_packets_dropped_counter;
+  }
+
+  /** Returns <code>true</code> if a new packet doesn't fit in the queue. */
+  inline bool
+  IsFull () const
+  {
+    return m_packets_table.size () >= m_max_queue_length;
+  }
+
+  /**
+   * Returns the packet that <code>DropPolicyT</code> selects to be dropped. The
+   * queue must not be empty.
+   */
+  inline const_iterator
+  SelectPacketToDrop () const
+  {
+    return DropPolicyT::SelectPacketToDrop (m_packets_table);
+  }
+
+  /**
+   * Erases the given packet due to a full queue, and counts it as dropped.
+   * Returns <code>true</code> if the packet was in the queue.
+   */
+  inline bool
+  DropPacket (const DataIdentifier & data_id)
+  {
+    ++m_packets_dropped_counter;
+    return m_packets_table.erase (data_id) > 0u;
+  }
+
+  /**
+   * Removes the entries that expired at or before the given time instant. It
+   * only visits the entries whose expiration instant has passed.
+   *
+   * @param time_instant [IN] Current simulation time.
+   * @param purged_packets [OUT] If not null, the identifiers of the removed
+   * entries are appended to it.
+   */
+  void
+  Purge (const ns3::Time & time_instant, std::vector<DataIdentifier> * purged_packets)
+  {
+    while (m_expiration_index.HasExpired (time_instant))
+      {
+        const iterator entry_it = m_packets_table.find (m_expiration_index.Pop ());
+
+        // Ignore the stale instants of removed entries
+        if (entry_it == m_packets_table.end () || entry_it->second.GetExpirationInstant () > time_instant)
+          continue;
+
+        if (purged_packets != 0)
+          purged_packets->push_back (entry_it->first);
+
+        m_packets_table.erase (entry_it);
+      }
+
+    if (m_expiration_index.NeedsRebuild (m_packets_table.size ()))
+      {
+        m_expiration_index.clear ();
+
+        for (const_iterator entry_it = m_packets_table.begin (); entry_it != m_packets_table.end (); ++entry_it)
+          m_expiration_index.Push (entry_it->first, entry_it->second.GetExpirationInstant ());
+      }
+  }
+
+
+  // --------------------------
+  // Disjoint vectors
+  // --------------------------
+
+  /**
+   * Appends (in increasing order) the packets in queue that are not contained
+   * in the given summary vector, found in a single merge pass over the sorted
+   * identifiers of both.
+   */
+  inline void
+  GetUnknownPackets (const std::set<DataIdentifier> & summary_vector,
+                     std::vector<DataIdentifier> & unknown_packets) const
+  {
+    MergeDisjointVectors (m_packets_table.GetSortedKeys (), summary_vector, &unknown_packets, 0);
+  }
+
+  /**
+   * Appends (in increasing order) the packets of the given summary vector that
+   * are not in queue, found in a single merge pass over the sorted identifiers
+   * of both.
+   */
+  inline void
+  GetMissingPackets (const std::set<DataIdentifier> & summary_vector,
+                     std::vector<DataIdentifier> & missing_packets) const
+  {
+    MergeDisjointVectors (m_packets_table.GetSortedKeys (), summary_vector, 0, &missing_packets);
+  }
+
+  /**
+   * Appends (in increasing order) the packets in queue that the given Bloom
+   * filter doesn't contain. A false positive of the filter leaves a packet out.
+   */
+  void
+  GetUnknownPackets (const DataIdentifierBloomFilter & bloom_filter,
+                     std::vector<DataIdentifier> & unknown_packets) const
+  {
+    const std::vector<DataIdentifier> & queue_packets = m_packets_table.GetSortedKeys ();
+
+    for (std::vector<DataIdentifier>::const_iterator data_id_it = queue_packets.begin ();
+            data_id_it != queue_packets.end (); ++data_id_it)
+      {
+        if (!bloom_filter.MayContain (*data_id_it))
+          unknown_packets.push_back (*data_id_it);
+      }
+  }
+
+  /**
+   * Inserts in <code>selected_packets</code> the given packets in queue (in
+   * increasing order) for which <code>filter (entry)</code> returns
+   * <code>true</code>. Returns the number of inserted packets.
+   */
+  template <typename FilterT>
+  uint32_t
+  FilterPackets (const std::vector<DataIdentifier> & data_ids, const FilterT & filter,
+                 std::set<DataIdentifier> & selected_packets) const
+  {
+    uint32_t selected_packets_count = 0u;
+
+    for (std::vector<DataIdentifier>::const_iterator data_id_it = data_ids.begin ();
+            data_id_it != data_ids.end (); ++data_id_it)
+      {
+        const const_iterator entry_it = m_packets_table.find (*data_id_it);
+
+        if (entry_it == m_packets_table.end () || !filter (entry_it->second))
+          continue;
+
+        // The identifiers are sorted, so they are inserted at the end.
+        selected_packets.insert (selected_packets.end (), entry_it->first);
+        ++selected_packets_count;
+      }
+
+    return selected_packets_count;
+  }
+
+  /** Two cores are equal if they have the same maximum length, dropped
+   * packets counter and entries. */
+  friend bool
+  operator== (const PacketsQueueCore & lhs, const PacketsQueueCore & rhs)
+  {
+    return lhs.m_max_queue_length == rhs.m_max_queue_length
+            && lhs.m_packets_dropped_counter == rhs.m_packets_dropped_counter
+            && lhs.m_packets_table == rhs.m_packets_table;
+  }
+
+  friend bool
+  operator!= (const PacketsQueueCore & lhs, const PacketsQueueCore & rhs)
+  {
+    return !(lhs == rhs);
+  }
+};
+
+}
+}
+
+#endif //UTILS_PACKETS_QUEUE_CORE_H
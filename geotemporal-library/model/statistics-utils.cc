@@ -552,7 +552,10 @@ SimulationStatistics::AddDataPacket (const DataPacketStatistics & packet_statist
   const LibraryUtils::GeoTemporalArea & destination_geo_temporal_area
           = packet_statistics.GetPacketDestinationGeoTemporalArea ();
 
-  if (!m_gta_visitor_nodes.ContainsGeoTemporalArea (destination_geo_temporal_area))
+  const std::set<NavigationSystem::VisitorNode> * gta_visitor_nodes_set = nullptr;
+
+  if (!m_gta_visitor_nodes.TryGetGeoTemporalAreaVisitorNodes (destination_geo_temporal_area,
+                                                              gta_visitor_nodes_set))
     throw std::runtime_error ("The given data packet has a destination geo-temporal area that "
                               "is unknown to the GeoTemporalAreasVisitorNodes object.");
 
@@ -568,13 +571,10 @@ SimulationStatistics::AddDataPacket (const DataPacketStatistics & packet_statist
                                                                        packet_statistics));
 
   // Construct the set of expected receiver nodes
-  const std::set<NavigationSystem::VisitorNode> & gta_visitor_nodes_set
-          = m_gta_visitor_nodes.GetGeoTemporalAreaVisitorNodes (destination_geo_temporal_area);
-
   std::map<ns3::Ipv4Address, ns3::Time> expected_receiver_nodes_map;
 
-  for (std::set<NavigationSystem::VisitorNode>::const_iterator visitor_node_it = gta_visitor_nodes_set.begin ();
-          visitor_node_it != gta_visitor_nodes_set.end (); ++visitor_node_it)
+  for (std::set<NavigationSystem::VisitorNode>::const_iterator visitor_node_it = gta_visitor_nodes_set->begin ();
+          visitor_node_it != gta_visitor_nodes_set->end (); ++visitor_node_it)
     {
       expected_receiver_nodes_map.insert (std::make_pair (GetNodeIpAddressFromId (visitor_node_it->GetNodeId ()),
                                                           ns3::Seconds (visitor_node_it->GetArrivalTime ())));
@@ -1218,7 +1218,10 @@ PrioritySimulationStatistics::AddDataPacket (const PriorityDataPacketStatistics&
   const LibraryUtils::GeoTemporalArea & destination_geo_temporal_area
           = priority_packet_statistics.GetPacketDestinationGeoTemporalArea ();
 
-  if (!m_gta_visitor_nodes.ContainsGeoTemporalArea (destination_geo_temporal_area))
+  const std::set<NavigationSystem::VisitorNode> * gta_visitor_nodes_set = nullptr;
+
+  if (!m_gta_visitor_nodes.TryGetGeoTemporalAreaVisitorNodes (destination_geo_temporal_area,
+                                                              gta_visitor_nodes_set))
     throw std::runtime_error ("The given data packet has a destination geo-temporal area that "
                               "is unknown to the GeoTemporalAreasVisitorNodes object.");
 
@@ -1234,13 +1237,10 @@ PrioritySimulationStatistics::AddDataPacket (const PriorityDataPacketStatistics&
                                                                                priority_packet_statistics));
 
   // Construct the set of expected receiver nodes
-  const std::set<NavigationSystem::VisitorNode> & gta_visitor_nodes_set
-          = m_gta_visitor_nodes.GetGeoTemporalAreaVisitorNodes (destination_geo_temporal_area);
-
   std::map<ns3::Ipv4Address, ns3::Time> expected_receiver_nodes_map;
 
-  for (std::set<NavigationSystem::VisitorNode>::const_iterator visitor_node_it = gta_visitor_nodes_set.begin ();
-          visitor_node_it != gta_visitor_nodes_set.end (); ++visitor_node_it)
+  for (std::set<NavigationSystem::VisitorNode>::const_iterator visitor_node_it = gta_visitor_nodes_set->begin ();
+          visitor_node_it != gta_visitor_nodes_set->end (); ++visitor_node_it)
     {
       expected_receiver_nodes_map.insert (std::make_pair (GetNodeIpAddressFromId (visitor_node_it->GetNodeId ()),
                                                           ns3::Seconds (visitor_node_it->GetArrivalTime ())));
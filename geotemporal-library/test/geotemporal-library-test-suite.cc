@@ -24,6 +24,7 @@
 
 #include <ns3/geotemporal-library-module.h>
 
+#include <ns3/buffer.h>
 #include <ns3/ipv4-address.h>
 #include <ns3/nstime.h>
 
@@ -244,6 +245,114 @@ public:
 };
 
 
+/******************************************************************************/
+/*                              math-utils.h/cc                               */
+/******************************************************************************/
+
+// =============================================================================
+//                                  AreaSetTest
+// =============================================================================
+
+/**
+ * AreaSet test suite.
+ * 
+ * \ingroup tests
+ * \ingroup geotemporal-library-test
+ */
+class AreaSetTest : public LibraryUtilsTestCase
+{
+public:
+
+  AreaSetTest () : LibraryUtilsTestCase ("AreaSet") { }
+
+  void
+  TestAddGet ()
+  {
+    AreaSet set;
+    NS_TEST_EXPECT_MSG_EQ (set.Size (), 0u, "Must be empty");
+
+    NS_TEST_EXPECT_MSG_EQ (set.Add (Area (10, 10, 0, 0)), 0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (set.Add (Area (-5, 5, 5, -5)), 1u, "Must be 1");
+    NS_TEST_EXPECT_MSG_EQ (set.Size (), 2u, "Must be 2");
+
+    NS_TEST_EXPECT_MSG_EQ (set.Get (0u), Area (0, 0, 10, 10), "Must be equal");
+    NS_TEST_EXPECT_MSG_EQ (set.Get (1u), Area (-5, -5, 5, 5), "Must be equal");
+
+    // Removal moves the last area to the removed index.
+    NS_TEST_EXPECT_MSG_EQ (set.Add (Area (20, 20, 30, 30)), 2u, "Must be 2");
+    set.Remove (0u);
+    NS_TEST_EXPECT_MSG_EQ (set.Size (), 2u, "Must be 2");
+    NS_TEST_EXPECT_MSG_EQ (set.Get (0u), Area (20, 20, 30, 30), "Must be equal");
+    NS_TEST_EXPECT_MSG_EQ (set.Get (1u), Area (-5, -5, 5, 5), "Must be equal");
+
+    set.Clear ();
+    NS_TEST_EXPECT_MSG_EQ (set.Size (), 0u, "Must be empty");
+  }
+
+  void
+  TestContainsPoint ()
+  {
+    // More than 64 areas to use more than one word of the bitmask.
+    std::vector<Area> areas;
+
+    for (uint32_t i = 0u; i < 150u; ++i)
+      areas.push_back (Area (i * 10.0, 0.0, i * 10.0 + 10.0, (i % 3u) * 10.0 + 5.0));
+
+    const AreaSet set (areas);
+    const GeoTemporalLibrary::LibraryUtils::Vector2D point_1 (15.0, 2.0), point_2 (1005.0, 17.0), outside (-1.0, -1.0);
+    AreaSet::Bitmask_t mask;
+
+    set.ContainsPoint (point_1, mask);
+    NS_TEST_ASSERT_MSG_EQ (mask.size (), 3u, "Must be 3 words");
+
+    for (uint32_t i = 0u; i < areas.size (); ++i)
+      NS_TEST_EXPECT_MSG_EQ (AreaSet::IsSet (mask, i), areas.at (i).IsInside (point_1),
+                             "Area " << i << " must match Area::IsInside");
+
+    set.ContainsAnyPoint (point_1, point_2, mask);
+
+    for (uint32_t i = 0u; i < areas.size (); ++i)
+      NS_TEST_EXPECT_MSG_EQ (AreaSet::IsSet (mask, i),
+                             areas.at (i).IsInside (point_1) || areas.at (i).IsInside (point_2),
+                             "Area " << i << " must match Area::IsInside");
+
+    set.ContainsPoint (outside, mask);
+
+    for (uint32_t i = 0u; i < areas.size (); ++i)
+      NS_TEST_EXPECT_MSG_EQ (AreaSet::IsSet (mask, i), false, "Must be outside");
+
+    // Only the areas with the given indexes, in the order of the indexes
+    std::vector<uint32_t> indexes;
+
+    for (uint32_t i = areas.size (); i > 0u; i -= 2u)
+      indexes.push_back (i - 1u);
+
+    set.ContainsAnyPoint (point_1, point_2, indexes, mask);
+    NS_TEST_ASSERT_MSG_EQ (mask.size (), 2u, "Must be 2 words");
+
+    for (uint32_t j = 0u; j < indexes.size (); ++j)
+      NS_TEST_EXPECT_MSG_EQ (AreaSet::IsSet (mask, j),
+                             areas.at (indexes.at (j)).IsInside (point_1) || areas.at (indexes.at (j)).IsInside (point_2),
+                             "Area " << indexes.at (j) << " must match Area::IsInside");
+
+    set.ContainsAnyPoint (point_1, point_2, std::vector<uint32_t> (), mask);
+    NS_TEST_EXPECT_MSG_EQ (mask.empty (), true, "Must be empty");
+
+    // Empty set
+    AreaSet empty;
+    empty.ContainsPoint (point_1, mask);
+    NS_TEST_EXPECT_MSG_EQ (mask.empty (), true, "Must be empty");
+  }
+
+  void
+  DoRun () override
+  {
+    TestAddGet ();
+    TestContainsPoint ();
+  }
+};
+
+
 /******************************************************************************/
 /*                           geotemporal-utils.h/cc                           */
 /******************************************************************************/
@@ -486,6 +595,1334 @@ public:
 };
 
 
+// =============================================================================
+//                   RandomDestinationGeoTemporalAreasListsTest
+// =============================================================================
+
+/**
+ * RandomDestinationGeoTemporalAreasLists test suite.
+ *
+ * \ingroup tests
+ * \ingroup geotemporal-library-test
+ */
+class RandomDestinationGeoTemporalAreasListsTest : public LibraryUtilsTestCase
+{
+private:
+
+  std::string m_output_filename;
+  std::vector<Area> m_areas;
+  std::vector<std::map<uint32_t, std::vector<DestinationGeoTemporalArea> > > m_lists_sets;
+
+public:
+
+  RandomDestinationGeoTemporalAreasListsTest ()
+  : LibraryUtilsTestCase ("RandomDestinationGeoTemporalAreasLists"),
+  m_output_filename ("test_RandomDestinationGeoTemporalAreasLists.txt"),
+  m_areas ({Area (0, 0, 10, 10), Area (20, 20, 30, 30)}), m_lists_sets (3u)
+  {
+    const TimePeriod period (Seconds (5), Seconds (50));
+
+    m_lists_sets.at (0u)[1u] = {DestinationGeoTemporalArea (4u, period, m_areas.at (0u))};
+    m_lists_sets.at (0u)[2u] = {DestinationGeoTemporalArea (4u, period, m_areas.at (0u)),
+                                DestinationGeoTemporalArea (7u, period, m_areas.at (1u))};
+    m_lists_sets.at (1u)[1u] = {DestinationGeoTemporalArea (2u, period, m_areas.at (1u))};
+    m_lists_sets.at (1u)[2u] = {DestinationGeoTemporalArea (2u, period, m_areas.at (1u)),
+                                DestinationGeoTemporalArea (9u, period, m_areas.at (0u))};
+    m_lists_sets.at (2u)[1u] = {DestinationGeoTemporalArea (11u, period, m_areas.at (0u))};
+    m_lists_sets.at (2u)[2u] = {DestinationGeoTemporalArea (11u, period, m_areas.at (0u)),
+                                DestinationGeoTemporalArea (3u, period, m_areas.at (1u))};
+  }
+
+private:
+
+  static bool
+  FileExists (const std::string & filename)
+  {
+    std::ifstream input_file (filename, std::ios::in);
+    return input_file.is_open ();
+  }
+
+  /**
+   * Writes the given text as the index file of the output file.
+   */
+  void
+  WriteIndexFile (const std::string & index_file_text) const
+  {
+    std::ofstream index_file (RandomDestinationGeoTemporalAreasLists::GetIndexFilename (m_output_filename),
+                              std::ios::out);
+    index_file << index_file_text;
+    index_file.close ();
+  }
+
+  /**
+   * Checks that every list of every set is correctly imported alone from the
+   * output file.
+   */
+  void
+  CheckPartialImports ()
+  {
+    for (uint32_t set_index = 0u; set_index < m_lists_sets.size (); ++set_index)
+      {
+        for (std::map<uint32_t, std::vector<DestinationGeoTemporalArea> >::const_iterator list_it
+                = m_lists_sets.at (set_index).begin (); list_it != m_lists_sets.at (set_index).end (); ++list_it)
+          {
+            RandomDestinationGeoTemporalAreasLists imported_list (m_output_filename, set_index + 1u, list_it->first);
+
+            NS_TEST_EXPECT_MSG_EQ ((imported_list.GetDestinationAreasList () == m_areas), true, "Must be equal");
+            NS_TEST_EXPECT_MSG_EQ ((imported_list.GetDestinationGeoTemporalAreasList (set_index + 1u, list_it->first)
+                                    == list_it->second), true, "Must be equal");
+          }
+      }
+  }
+
+public:
+
+  void
+  TestInMemoryConstructor ()
+  {
+    const std::vector<Area> & areas = m_areas;
+    const std::vector<std::map<uint32_t, std::vector<DestinationGeoTemporalArea> > > & lists_sets = m_lists_sets;
+
+    RandomDestinationGeoTemporalAreasLists lists (100u, areas, lists_sets);
+
+    NS_TEST_EXPECT_MSG_EQ ((lists.GetDestinationAreasList () == areas), true, "Must be equal");
+    NS_TEST_EXPECT_MSG_EQ ((lists.GetDestinationGeoTemporalAreasList (1u, 2u) == lists_sets.at (0u).at (2u)), true,
+                           "Must be equal");
+    NS_TEST_EXPECT_MSG_EQ ((lists.GetDestinationGeoTemporalAreasList (2u, 1u) == lists_sets.at (1u).at (1u)), true,
+                           "Must be equal");
+
+    // The exported file must contain the same lists.
+    lists.ExportToFile (m_output_filename);
+
+    RandomDestinationGeoTemporalAreasLists imported_lists (m_output_filename);
+    NS_TEST_EXPECT_MSG_EQ ((imported_lists == lists), true, "Must be equal");
+
+    TestUtils::DeleteFile (m_output_filename);
+
+    // Invalid lists must be rejected.
+    std::vector<std::map<uint32_t, std::vector<DestinationGeoTemporalArea> > > invalid_lists_sets;
+    bool throwed_exception;
+
+    // List with a different number of areas than its length
+    invalid_lists_sets = lists_sets;
+    invalid_lists_sets.at (1u).at (2u).pop_back ();
+    throwed_exception = false;
+
+    try
+      {
+        RandomDestinationGeoTemporalAreasLists will_fail (100u, areas, invalid_lists_sets);
+      }
+    catch (std::invalid_argument & ex)
+      {
+        throwed_exception = true;
+      }
+
+    NS_TEST_EXPECT_MSG_EQ (throwed_exception, true, "Right exception must have been thrown.");
+
+    // Sets with lists of different lengths
+    invalid_lists_sets = lists_sets;
+    invalid_lists_sets.at (1u).erase (1u);
+    throwed_exception = false;
+
+    try
+      {
+        RandomDestinationGeoTemporalAreasLists will_fail (100u, areas, invalid_lists_sets);
+      }
+    catch (std::invalid_argument & ex)
+      {
+        throwed_exception = true;
+      }
+
+    NS_TEST_EXPECT_MSG_EQ (throwed_exception, true, "Right exception must have been thrown.");
+
+    // Destination area not in the list of areas
+    throwed_exception = false;
+
+    try
+      {
+        RandomDestinationGeoTemporalAreasLists will_fail (100u, {areas.at (0u)}, lists_sets);
+      }
+    catch (std::invalid_argument & ex)
+      {
+        throwed_exception = true;
+      }
+
+    NS_TEST_EXPECT_MSG_EQ (throwed_exception, true, "Right exception must have been thrown.");
+  }
+
+  void
+  TestPartialImport ()
+  {
+    const RandomDestinationGeoTemporalAreasLists lists (100u, m_areas, m_lists_sets);
+
+    // The index file is only exported on request.
+    lists.ExportToFile (m_output_filename);
+    NS_TEST_EXPECT_MSG_EQ (FileExists (RandomDestinationGeoTemporalAreasLists::GetIndexFilename (m_output_filename)),
+                           false, "Index file must not exist");
+
+    // Without index file the previous sets are skipped line by line.
+    CheckPartialImports ();
+
+    NS_TEST_EXPECT_MSG_EQ ((RandomDestinationGeoTemporalAreasLists::ImportDestinationAreasList (m_output_filename)
+                            == m_areas), true, "Must be equal");
+
+    // Only the requested list is imported.
+    RandomDestinationGeoTemporalAreasLists imported_list (m_output_filename, 2u, 1u);
+    bool throwed_exception = false;
+
+    try
+      {
+        imported_list.GetDestinationGeoTemporalAreasList (2u, 2u);
+      }
+    catch (std::invalid_argument & ex)
+      {
+        throwed_exception = true;
+      }
+
+    NS_TEST_EXPECT_MSG_EQ (throwed_exception, true, "Right exception must have been thrown.");
+
+    // Unknown set number
+    throwed_exception = false;
+
+    try
+      {
+        RandomDestinationGeoTemporalAreasLists will_fail (m_output_filename, 4u, 1u);
+      }
+    catch (std::invalid_argument & ex)
+      {
+        throwed_exception = true;
+      }
+
+    NS_TEST_EXPECT_MSG_EQ (throwed_exception, true, "Right exception must have been thrown.");
+
+    // Unknown list length
+    throwed_exception = false;
+
+    try
+      {
+        RandomDestinationGeoTemporalAreasLists will_fail (m_output_filename, 1u, 3u);
+      }
+    catch (std::invalid_argument & ex)
+      {
+        throwed_exception = true;
+      }
+
+    NS_TEST_EXPECT_MSG_EQ (throwed_exception, true, "Right exception must have been thrown.");
+
+    TestUtils::DeleteFile (m_output_filename);
+  }
+
+  void
+  TestIndexFile ()
+  {
+    const RandomDestinationGeoTemporalAreasLists lists (100u, m_areas, m_lists_sets);
+    const std::string index_filename = RandomDestinationGeoTemporalAreasLists::GetIndexFilename (m_output_filename);
+
+    lists.ExportToFile (m_output_filename, /*Export index file*/ true);
+    NS_TEST_EXPECT_MSG_EQ (FileExists (index_filename), true, "Index file must exist");
+
+    // Valid index file
+    CheckPartialImports ();
+
+    // Stale index file: the lists file was regenerated without it. The offsets
+    // of the old file don't point to the sets of the new one, so the loader
+    // must fall back to skipping lines.
+    std::vector<Area> other_areas = m_areas;
+    other_areas.emplace_back (100, 100, 110, 110);
+
+    RandomDestinationGeoTemporalAreasLists (100u, other_areas, m_lists_sets)
+            .ExportToFile (m_output_filename, /*Export index file*/ true);
+    lists.ExportToFile (m_output_filename);
+    CheckPartialImports ();
+
+    // Offsets that point to other sets or to the middle of a set
+    WriteIndexFile ("# Set number, Byte offset\n1, 0\n2, 3\n3, 120\n");
+    CheckPartialImports ();
+
+    // Offsets beyond the end of the lists file
+    WriteIndexFile ("# Set number, Byte offset\n1, 100000\n2, 200000\n3, 300000\n");
+    CheckPartialImports ();
+
+    // Malformed index files
+    WriteIndexFile ("# Set number, Byte offset\n1, abc\n2\n3, -7\n");
+    CheckPartialImports ();
+
+    WriteIndexFile ("# Set number, Byte offset\n99999999999999999999, 0\n");
+    CheckPartialImports ();
+
+    // Exporting without index file doesn't modify an existing one.
+    lists.ExportToFile (m_output_filename);
+
+    std::string unmodified_index_file_text;
+    TestUtils::ReadFile (index_filename, unmodified_index_file_text);
+    NS_TEST_EXPECT_MSG_EQ (unmodified_index_file_text, "# Set number, Byte offset\n99999999999999999999, 0\n",
+                           "Must be equal");
+
+    TestUtils::DeleteFile (m_output_filename);
+    TestUtils::DeleteFile (index_filename);
+  }
+
+  void
+  TestPartialExport ()
+  {
+    const std::string index_filename = RandomDestinationGeoTemporalAreasLists::GetIndexFilename (m_output_filename);
+
+    RandomDestinationGeoTemporalAreasLists (100u, m_areas, m_lists_sets)
+            .ExportToFile (m_output_filename, /*Export index file*/ true);
+
+    std::string lists_file_text, index_file_text;
+    TestUtils::ReadFile (m_output_filename, lists_file_text);
+    TestUtils::ReadFile (index_filename, index_file_text);
+
+    // An object with a single imported list can't be exported, and the files 
+    // must not be modified.
+    const RandomDestinationGeoTemporalAreasLists imported_list (m_output_filename, 2u, 1u);
+    bool throwed_exception = false;
+
+    try
+      {
+        imported_list.ExportToFile (m_output_filename, /*Export index file*/ true);
+      }
+    catch (std::runtime_error & ex)
+      {
+        throwed_exception = true;
+      }
+
+    NS_TEST_EXPECT_MSG_EQ (throwed_exception, true, "Right exception must have been thrown.");
+
+    std::string unmodified_text;
+    TestUtils::ReadFile (m_output_filename, unmodified_text);
+    NS_TEST_EXPECT_MSG_EQ (unmodified_text, lists_file_text, "Must be equal");
+
+    TestUtils::ReadFile (index_filename, unmodified_text);
+    NS_TEST_EXPECT_MSG_EQ (unmodified_text, index_file_text, "Must be equal");
+
+    // The copies keep the restriction.
+    const RandomDestinationGeoTemporalAreasLists copied_list (imported_list);
+    throwed_exception = false;
+
+    try
+      {
+        copied_list.ExportToFile (m_output_filename);
+      }
+    catch (std::runtime_error & ex)
+      {
+        throwed_exception = true;
+      }
+
+    NS_TEST_EXPECT_MSG_EQ (throwed_exception, true, "Right exception must have been thrown.");
+
+    TestUtils::DeleteFile (m_output_filename);
+    TestUtils::DeleteFile (index_filename);
+  }
+
+  void
+  DoRun () override
+  {
+    TestInMemoryConstructor ();
+    TestPartialImport ();
+    TestIndexFile ();
+    TestPartialExport ();
+  }
+};
+
+
+// =============================================================================
+//                      GeoTemporalAreasVisitorNodesTest
+// =============================================================================
+
+/**
+ * GeoTemporalAreasVisitorNodes test suite.
+ *
+ * Tests the lookup of visitor nodes through the index of visitor nodes and the
+ * non-throwing <code>TryGet*</code> functions.
+ *
+ * \ingroup tests
+ * \ingroup geotemporal-library-test
+ */
+class GeoTemporalAreasVisitorNodesTest : public LibraryUtilsTestCase
+{
+private:
+
+  GeoTemporalArea m_known_gta;
+  GeoTemporalArea m_unknown_gta;
+  GeoTemporalAreasVisitorNodes m_gta_visitor_nodes;
+
+public:
+
+  GeoTemporalAreasVisitorNodesTest () : LibraryUtilsTestCase ("GeoTemporalAreasVisitorNodes"),
+  m_known_gta (TimePeriod (Seconds (10), Seconds (60)), Area (0, 0, 10, 10)),
+  m_unknown_gta (TimePeriod (Seconds (70), Seconds (90)), Area (20, 20, 30, 30)),
+  m_gta_visitor_nodes ()
+  {
+    m_gta_visitor_nodes.AddVisitorNode (m_known_gta, VisitorNode (1, 15));
+    m_gta_visitor_nodes.AddVisitorNode (m_known_gta, VisitorNode (2, 40));
+    m_gta_visitor_nodes.AddVisitorNode (m_known_gta, VisitorNode (2, 20)); // Second (earlier) visit of node 2
+    m_gta_visitor_nodes.AddVisitorNode (m_known_gta, VisitorNode (3, 55));
+  }
+
+  void
+  TestSuccessfulLookups ()
+  {
+    NS_TEST_EXPECT_MSG_EQ (m_gta_visitor_nodes.ContainsGeoTemporalArea (m_known_gta), true, "Must be known");
+    NS_TEST_EXPECT_MSG_EQ (m_gta_visitor_nodes.NodeVisitedGeoTemporalArea (1, m_known_gta), true, "Must be visitor");
+    NS_TEST_EXPECT_MSG_EQ (m_gta_visitor_nodes.NodeVisitedGeoTemporalArea (3, m_known_gta), true, "Must be visitor");
+
+    NS_TEST_EXPECT_MSG_EQ (m_gta_visitor_nodes.GetVisitorNode (1, m_known_gta), VisitorNode (1, 15), "Must be equal");
+    NS_TEST_EXPECT_MSG_EQ (m_gta_visitor_nodes.GetVisitorNode (3, m_known_gta), VisitorNode (3, 55), "Must be equal");
+
+    // Only the earliest arrival of a node that visited the area twice is returned
+    NS_TEST_EXPECT_MSG_EQ (m_gta_visitor_nodes.GetVisitorNode (2, m_known_gta), VisitorNode (2, 20), "Must be equal");
+
+    VisitorNode visitor_node;
+    bool found = m_gta_visitor_nodes.TryGetVisitorNode (2, m_known_gta, visitor_node);
+    NS_TEST_EXPECT_MSG_EQ (found, true, "Must be found");
+    NS_TEST_EXPECT_MSG_EQ (visitor_node, VisitorNode (2, 20), "Must be equal");
+
+    const std::set<VisitorNode> * visitor_nodes = nullptr;
+    found = m_gta_visitor_nodes.TryGetGeoTemporalAreaVisitorNodes (m_known_gta, visitor_nodes);
+    NS_TEST_EXPECT_MSG_EQ (found, true, "Must be found");
+    NS_TEST_ASSERT_MSG_EQ ((visitor_nodes != nullptr), true, "Must not be null");
+    NS_TEST_EXPECT_MSG_EQ (visitor_nodes->size (), 4u, "Must be 4");
+    NS_TEST_EXPECT_MSG_EQ ((visitor_nodes == &m_gta_visitor_nodes.GetGeoTemporalAreaVisitorNodes (m_known_gta)),
+                           true, "Must be the same set");
+  }
+
+  void
+  TestMissingLookups ()
+  {
+    // Node that didn't visit a known geo-temporal area
+    NS_TEST_EXPECT_MSG_EQ (m_gta_visitor_nodes.NodeVisitedGeoTemporalArea (4, m_known_gta), false, "Must not be visitor");
+
+    VisitorNode visitor_node (100, 200);
+    bool found = m_gta_visitor_nodes.TryGetVisitorNode (4, m_known_gta, visitor_node);
+    NS_TEST_EXPECT_MSG_EQ (found, false, "Must not be found");
+    NS_TEST_EXPECT_MSG_EQ (visitor_node, VisitorNode (100, 200), "Must not have been modified");
+
+    // Unknown geo-temporal area
+    NS_TEST_EXPECT_MSG_EQ (m_gta_visitor_nodes.ContainsGeoTemporalArea (m_unknown_gta), false, "Must be unknown");
+    NS_TEST_EXPECT_MSG_EQ (m_gta_visitor_nodes.NodeVisitedGeoTemporalArea (1, m_unknown_gta), false, "Must not be visitor");
+
+    found = m_gta_visitor_nodes.TryGetVisitorNode (1, m_unknown_gta, visitor_node);
+    NS_TEST_EXPECT_MSG_EQ (found, false, "Must not be found");
+    NS_TEST_EXPECT_MSG_EQ (visitor_node, VisitorNode (100, 200), "Must not have been modified");
+
+    const std::set<VisitorNode> * visitor_nodes = &m_gta_visitor_nodes.GetGeoTemporalAreaVisitorNodes (m_known_gta);
+    found = m_gta_visitor_nodes.TryGetGeoTemporalAreaVisitorNodes (m_unknown_gta, visitor_nodes);
+    NS_TEST_EXPECT_MSG_EQ (found, false, "Must not be found");
+    NS_TEST_EXPECT_MSG_EQ ((visitor_nodes == nullptr), true, "Must be null");
+  }
+
+  void
+  TestOutOfRangeLookups ()
+  {
+    // Node that didn't visit a known geo-temporal area
+    bool throwed_exception = false;
+    try
+      {
+        m_gta_visitor_nodes.GetVisitorNode (4, m_known_gta);
+      }
+    catch (std::out_of_range & e)
+      {
+        throwed_exception = true;
+        NS_TEST_EXPECT_MSG_EQ (1, 1, "Must happen.");
+      }
+    catch (...)
+      {
+        throwed_exception = false;
+        NS_TEST_EXPECT_MSG_EQ (1, 0, "Must never happen.");
+      }
+    NS_TEST_EXPECT_MSG_EQ (throwed_exception, true, "Right exception must have been thrown.");
+
+    // Unknown geo-temporal area
+    throwed_exception = false;
+    try
+      {
+        m_gta_visitor_nodes.GetVisitorNode (1, m_unknown_gta);
+      }
+    catch (std::out_of_range & e)
+      {
+        throwed_exception = true;
+        NS_TEST_EXPECT_MSG_EQ (1, 1, "Must happen.");
+      }
+    catch (...)
+      {
+        throwed_exception = false;
+        NS_TEST_EXPECT_MSG_EQ (1, 0, "Must never happen.");
+      }
+    NS_TEST_EXPECT_MSG_EQ (throwed_exception, true, "Right exception must have been thrown.");
+
+    throwed_exception = false;
+    try
+      {
+        m_gta_visitor_nodes.GetGeoTemporalAreaVisitorNodes (m_unknown_gta);
+      }
+    catch (std::out_of_range & e)
+      {
+        throwed_exception = true;
+        NS_TEST_EXPECT_MSG_EQ (1, 1, "Must happen.");
+      }
+    catch (...)
+      {
+        throwed_exception = false;
+        NS_TEST_EXPECT_MSG_EQ (1, 0, "Must never happen.");
+      }
+    NS_TEST_EXPECT_MSG_EQ (throwed_exception, true, "Right exception must have been thrown.");
+  }
+
+  void
+  TestStatisticsUnknownArea ()
+  {
+    // Data packets destined to a geo-temporal area without visitor nodes
+    // information can't be added to the statistics.
+    const std::map<uint32_t, Ipv4Address> node_id_to_ip = {
+      {1u, Ipv4Address ("10.0.0.1")}, {2u, Ipv4Address ("10.0.0.2")}, {3u, Ipv4Address ("10.0.0.3")}
+    };
+
+    SimulationStatistics simulation_statistics (m_gta_visitor_nodes, node_id_to_ip);
+    simulation_statistics.AddDataPacket (DataPacketStatistics (DataIdentifier ("10.0.0.1:1"), 1, Seconds (5),
+                                                               512, 585, m_known_gta));
+
+    bool throwed_exception = false;
+    try
+      {
+        simulation_statistics.AddDataPacket (DataPacketStatistics (DataIdentifier ("10.0.0.1:2"), 1, Seconds (5),
+                                                                   512, 585, m_unknown_gta));
+      }
+    catch (std::runtime_error & e)
+      {
+        throwed_exception = true;
+        NS_TEST_EXPECT_MSG_EQ (1, 1, "Must happen.");
+      }
+    catch (...)
+      {
+        throwed_exception = false;
+        NS_TEST_EXPECT_MSG_EQ (1, 0, "Must never happen.");
+      }
+    NS_TEST_EXPECT_MSG_EQ (throwed_exception, true, "Right exception must have been thrown.");
+
+    PrioritySimulationStatistics priority_statistics (m_gta_visitor_nodes, node_id_to_ip);
+
+    throwed_exception = false;
+    try
+      {
+        priority_statistics.AddDataPacket (PriorityDataPacketStatistics (DataIdentifier ("10.0.0.1:2"), false, 1,
+                                                                         Seconds (5), 512, 585, m_unknown_gta));
+      }
+    catch (std::runtime_error & e)
+      {
+        throwed_exception = true;
+        NS_TEST_EXPECT_MSG_EQ (1, 1, "Must happen.");
+      }
+    catch (...)
+      {
+        throwed_exception = false;
+        NS_TEST_EXPECT_MSG_EQ (1, 0, "Must never happen.");
+      }
+    NS_TEST_EXPECT_MSG_EQ (throwed_exception, true, "Right exception must have been thrown.");
+  }
+
+  void
+  DoRun () override
+  {
+    TestSuccessfulLookups ();
+    TestMissingLookups ();
+    TestOutOfRangeLookups ();
+    TestStatisticsUnknownArea ();
+  }
+};
+
+
+// =============================================================================
+//                             ExpirationIndexTest
+// =============================================================================
+
+/**
+ * ExpirationIndex test suite.
+ * 
+ * \ingroup tests
+ * \ingroup geotemporal-library-test
+ */
+class ExpirationIndexTest : public LibraryUtilsTestCase
+{
+public:
+
+  ExpirationIndexTest () : LibraryUtilsTestCase ("ExpirationIndex") { }
+
+  void
+  TestPushPop ()
+  {
+    ExpirationIndex<uint32_t> index;
+
+    NS_TEST_EXPECT_MSG_EQ (index.empty (), true, "Must be empty");
+    NS_TEST_EXPECT_MSG_EQ (index.HasExpired (Seconds (1000)), false, "Nothing must be expired");
+
+    index.Push (1u, Seconds (10));
+    index.Push (2u, Seconds (5));
+    index.Push (3u, Seconds (7.5));
+    index.Push (4u, Seconds (5));
+    index.Push (5u, Seconds (20));
+
+    NS_TEST_EXPECT_MSG_EQ (index.size (), 5u, "Must be 5");
+    NS_TEST_EXPECT_MSG_EQ (index.HasExpired (Seconds (4.99)), false, "Nothing must be expired");
+    NS_TEST_ASSERT_MSG_EQ (index.HasExpired (Seconds (5)), true, "Must be expired at its instant");
+
+    // Pairs with the same instant are popped by key.
+    NS_TEST_EXPECT_MSG_EQ (index.Pop (), 2u, "Must be 2");
+    NS_TEST_ASSERT_MSG_EQ (index.HasExpired (Seconds (5)), true, "Must be expired");
+    NS_TEST_EXPECT_MSG_EQ (index.Pop (), 4u, "Must be 4");
+    NS_TEST_EXPECT_MSG_EQ (index.HasExpired (Seconds (5)), false, "Nothing must be expired");
+
+    // A restarted key is pushed again, and its old pair remains in the index.
+    index.Push (3u, Seconds (15));
+
+    std::vector<uint32_t> popped_keys, expected_keys = {3u, 1u};
+
+    while (index.HasExpired (Seconds (12)))
+      popped_keys.push_back (index.Pop ());
+
+    NS_TEST_EXPECT_MSG_EQ ((popped_keys == expected_keys), true, "Must be the expected");
+    NS_TEST_EXPECT_MSG_EQ (index.size (), 2u, "Must be 2");
+
+    index.clear ();
+    NS_TEST_EXPECT_MSG_EQ (index.empty (), true, "Must be empty");
+  }
+
+  void
+  TestNeedsRebuild ()
+  {
+    ExpirationIndex<uint32_t> index;
+
+    for (uint32_t i = 0u; i < 64u; ++i)
+      index.Push (i % 4u, Seconds (i));
+
+    // Small indexes are never rebuilt.
+    NS_TEST_EXPECT_MSG_EQ (index.NeedsRebuild (0u), false, "Must be false");
+
+    for (uint32_t i = 0u; i < 64u; ++i)
+      index.Push (i % 4u, Seconds (i));
+
+    NS_TEST_EXPECT_MSG_EQ (index.NeedsRebuild (4u), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (index.NeedsRebuild (63u), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (index.NeedsRebuild (64u), false, "Must be false");
+  }
+
+  void
+  DoRun () override
+  {
+    TestPushPop ();
+    TestNeedsRebuild ();
+  }
+};
+
+
+/******************************************************************************/
+/*                              packet-utils.h/cc                             */
+/******************************************************************************/
+
+// =============================================================================
+//                             DataIdentifierMapTest
+// =============================================================================
+
+/**
+ * DataIdentifierMap test suite.
+ * 
+ * \ingroup tests
+ * \ingroup geotemporal-library-test
+ */
+class DataIdentifierMapTest : public LibraryUtilsTestCase
+{
+public:
+
+  DataIdentifierMapTest () : LibraryUtilsTestCase ("DataIdentifierMap") { }
+
+  void
+  TestGetKey ()
+  {
+    const DataIdentifier data_id ("1.2.3.4:5");
+
+    NS_TEST_EXPECT_MSG_EQ (data_id.GetKey (), 0x010203040005ull, "Must be 0x010203040005");
+
+    NS_TEST_EXPECT_MSG_EQ (DataIdentifier ("1.2.3.4:65535") < DataIdentifier ("1.2.3.5:0"), true,
+                           "Must be less");
+    NS_TEST_EXPECT_MSG_EQ (DataIdentifier ("1.2.3.4:6") < DataIdentifier ("1.2.3.4:5"), false,
+                           "Must not be less");
+    NS_TEST_EXPECT_MSG_EQ (HashDataIdentifier (DataIdentifier ("1.2.3.4:5"))
+                           != HashDataIdentifier (DataIdentifier ("1.2.3.4:6")), true,
+                           "Hashes must be different");
+  }
+
+  void
+  TestInsertFindErase ()
+  {
+    DataIdentifierMap<uint32_t> map;
+    std::map<DataIdentifier, uint32_t> expected_map;
+
+    NS_TEST_EXPECT_MSG_EQ (map.empty (), true, "Must be empty");
+    NS_TEST_EXPECT_MSG_EQ ((map.find (DataIdentifier ("1.1.1.1:1")) == map.end ()), true, "Must not be found");
+    NS_TEST_EXPECT_MSG_EQ (map.erase (DataIdentifier ("1.1.1.1:1")), 0u, "Nothing must be erased");
+
+    // Enough entries to grow the index several times.
+    for (uint32_t i = 0u; i < 300u; ++i)
+      {
+        const DataIdentifier data_id (Ipv4Address (10u + (i % 7u)), i);
+
+        NS_TEST_EXPECT_MSG_EQ (map.insert (std::make_pair (data_id, i)).second, true, "Must be inserted");
+        expected_map.insert (std::make_pair (data_id, i));
+      }
+
+    NS_TEST_EXPECT_MSG_EQ (map.size (), 300u, "Must be 300");
+    NS_TEST_EXPECT_MSG_EQ (map.insert (std::make_pair (DataIdentifier (Ipv4Address (10u), 0u), 999u)).second,
+                           false, "Must not be inserted twice");
+    NS_TEST_EXPECT_MSG_EQ (map.at (DataIdentifier (Ipv4Address (10u), 0u)), 0u, "Must keep the first value");
+
+    // Erase every third entry while iterating, and some by identifier.
+    for (DataIdentifierMap<uint32_t>::const_iterator it = map.begin (); it != map.end ();)
+      {
+        if (it->second % 3u == 0u)
+          {
+            expected_map.erase (it->first);
+            it = map.erase (it);
+          }
+        else
+          ++it;
+      }
+
+    for (uint32_t i = 1u; i < 300u; i += 30u)
+      {
+        const DataIdentifier data_id (Ipv4Address (10u + (i % 7u)), i);
+
+        NS_TEST_EXPECT_MSG_EQ (map.erase (data_id), expected_map.erase (data_id), "Must erase the same");
+      }
+
+    NS_TEST_ASSERT_MSG_EQ (map.size (), expected_map.size (), "Must have the same size");
+
+    for (std::map<DataIdentifier, uint32_t>::const_iterator it = expected_map.begin ();
+            it != expected_map.end (); ++it)
+      {
+        DataIdentifierMap<uint32_t>::const_iterator found_it = map.find (it->first);
+
+        NS_TEST_ASSERT_MSG_EQ ((found_it != map.end ()), true, "Must be found: " << it->first);
+        NS_TEST_EXPECT_MSG_EQ (found_it->second, it->second, "Must be the same value");
+      }
+
+    // Equality doesn't depend on the insertion order.
+    DataIdentifierMap<uint32_t> reversed_map;
+
+    for (std::map<DataIdentifier, uint32_t>::const_reverse_iterator it = expected_map.rbegin ();
+            it != expected_map.rend (); ++it)
+      reversed_map.insert (*it);
+
+    NS_TEST_EXPECT_MSG_EQ ((map == reversed_map), true, "Must be equal");
+
+    reversed_map.at (expected_map.begin ()->first) = 999u;
+    NS_TEST_EXPECT_MSG_EQ ((map != reversed_map), true, "Must be different");
+
+    map.clear ();
+    NS_TEST_EXPECT_MSG_EQ (map.empty (), true, "Must be empty");
+    NS_TEST_EXPECT_MSG_EQ ((map.find (expected_map.begin ()->first) == map.end ()), true, "Must not be found");
+  }
+
+  void
+  TestSortedKeysAndMerge ()
+  {
+    DataIdentifierMap<uint32_t> map;
+
+    map.insert (std::make_pair (DataIdentifier ("1.1.1.3:1"), 0u));
+    map.insert (std::make_pair (DataIdentifier ("1.1.1.1:2"), 0u));
+    map.insert (std::make_pair (DataIdentifier ("1.1.1.2:1"), 0u));
+
+    std::vector<DataIdentifier> expected_keys = {DataIdentifier ("1.1.1.1:2"), DataIdentifier ("1.1.1.2:1"),
+                                                 DataIdentifier ("1.1.1.3:1")};
+    NS_TEST_EXPECT_MSG_EQ ((map.GetSortedKeys () == expected_keys), true, "Must be sorted");
+
+    // The cached keys must follow the changes of the map.
+    map.erase (DataIdentifier ("1.1.1.2:1"));
+    map.insert (std::make_pair (DataIdentifier ("1.1.1.1:1"), 0u));
+
+    expected_keys = {DataIdentifier ("1.1.1.1:1"), DataIdentifier ("1.1.1.1:2"), DataIdentifier ("1.1.1.3:1")};
+    NS_TEST_EXPECT_MSG_EQ ((map.GetSortedKeys () == expected_keys), true, "Must be updated");
+
+    const std::set<DataIdentifier> ids_set = {DataIdentifier ("1.1.1.1:2"), DataIdentifier ("1.1.1.2:1"),
+                                              DataIdentifier ("1.1.1.4:1")};
+    std::vector<DataIdentifier> only_in_sorted_ids, only_in_ids_set;
+
+    MergeDisjointVectors (map.GetSortedKeys (), ids_set, &only_in_sorted_ids, &only_in_ids_set);
+
+    std::vector<DataIdentifier> expected = {DataIdentifier ("1.1.1.1:1"), DataIdentifier ("1.1.1.3:1")};
+    NS_TEST_EXPECT_MSG_EQ ((only_in_sorted_ids == expected), true, "Must be only the map identifiers");
+
+    expected = {DataIdentifier ("1.1.1.2:1"), DataIdentifier ("1.1.1.4:1")};
+    NS_TEST_EXPECT_MSG_EQ ((only_in_ids_set == expected), true, "Must be only the set identifiers");
+
+    // Any of the outputs may be omitted.
+    only_in_ids_set.clear ();
+    MergeDisjointVectors (map.GetSortedKeys (), ids_set, 0, &only_in_ids_set);
+    NS_TEST_EXPECT_MSG_EQ ((only_in_ids_set == expected), true, "Must be only the set identifiers");
+
+    map.clear ();
+    NS_TEST_EXPECT_MSG_EQ (map.GetSortedKeys ().empty (), true, "Must be empty");
+  }
+
+  void
+  DoRun () override
+  {
+    TestGetKey ();
+    TestInsertFindErase ();
+    TestSortedKeysAndMerge ();
+  }
+};
+
+
+// =============================================================================
+//                             CachedPacketIdSetTest
+// =============================================================================
+
+/**
+ * CachedPacketIdSet test suite.
+ * 
+ * \ingroup tests
+ * \ingroup geotemporal-library-test
+ */
+class CachedPacketIdSetTest : public LibraryUtilsTestCase
+{
+public:
+
+  CachedPacketIdSetTest () : LibraryUtilsTestCase ("CachedPacketIdSet") { }
+
+  void
+  TestInsertFind ()
+  {
+    CachedPacketIdSet cache;
+
+    NS_TEST_EXPECT_MSG_EQ (cache.Size (), 0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (cache.Find (Ipv4Address ("1.1.1.1"), 1u), false, "Must not be found");
+
+    // Enough pairs to grow the hash set several times.
+    for (uint32_t i = 0u; i < 300u; ++i)
+      NS_TEST_EXPECT_MSG_EQ (cache.Insert (Ipv4Address (10u + (i % 7u)), i, Seconds (i)), true,
+                             "Must be inserted");
+
+    NS_TEST_EXPECT_MSG_EQ (cache.Size (), 300u, "Must be 300");
+    NS_TEST_EXPECT_MSG_EQ (cache.Insert (Ipv4Address (10u), 0u, Seconds (1000)), false,
+                           "Must not be inserted twice");
+    NS_TEST_EXPECT_MSG_EQ (cache.Find (Ipv4Address (10u), 0u), true, "Must be found");
+    NS_TEST_EXPECT_MSG_EQ (cache.Find (Ipv4Address (11u), 0u), false, "Must not be found");
+
+    cache.Clear ();
+    NS_TEST_EXPECT_MSG_EQ (cache.Size (), 0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (cache.Find (Ipv4Address (10u), 0u), false, "Must not be found");
+  }
+
+  void
+  TestPurge ()
+  {
+    CachedPacketIdSet cache;
+
+    cache.Insert (Ipv4Address ("1.1.1.1"), 1u, Seconds (10));
+    cache.Insert (Ipv4Address ("1.1.1.1"), 2u, Seconds (10));
+    cache.Insert (Ipv4Address ("2.2.2.2"), 1u, Seconds (15));
+    // Inserted with an earlier expiration time than the previous pair.
+    cache.Insert (Ipv4Address ("3.3.3.3"), 3u, Seconds (13));
+
+    // Only the pairs whose expiration time is less than the instant expire.
+    cache.Purge (Seconds (10));
+    NS_TEST_EXPECT_MSG_EQ (cache.Size (), 4u, "Must be 4");
+
+    cache.Purge (Seconds (12));
+    NS_TEST_EXPECT_MSG_EQ (cache.Size (), 2u, "Must be 2");
+    NS_TEST_EXPECT_MSG_EQ (cache.Find (Ipv4Address ("1.1.1.1"), 1u), false, "Must not be found");
+    NS_TEST_EXPECT_MSG_EQ (cache.Find (Ipv4Address ("1.1.1.1"), 2u), false, "Must not be found");
+    NS_TEST_EXPECT_MSG_EQ (cache.Find (Ipv4Address ("2.2.2.2"), 1u), true, "Must be found");
+    NS_TEST_EXPECT_MSG_EQ (cache.Find (Ipv4Address ("3.3.3.3"), 3u), true, "Must be found");
+
+    cache.Purge (Seconds (14));
+    NS_TEST_EXPECT_MSG_EQ (cache.Size (), 1u, "Must be 1");
+    NS_TEST_EXPECT_MSG_EQ (cache.Find (Ipv4Address ("3.3.3.3"), 3u), false, "Must not be found");
+    NS_TEST_EXPECT_MSG_EQ (cache.Find (Ipv4Address ("2.2.2.2"), 1u), true, "Must be found");
+
+    // An expired pair can be inserted again.
+    NS_TEST_EXPECT_MSG_EQ (cache.Insert (Ipv4Address ("1.1.1.1"), 1u, Seconds (20)), true, "Must be inserted");
+
+    cache.Purge (Seconds (100));
+    NS_TEST_EXPECT_MSG_EQ (cache.Size (), 0u, "Must be 0");
+  }
+
+  void
+  DoRun () override
+  {
+    TestInsertFind ();
+    TestPurge ();
+  }
+};
+
+
+// =============================================================================
+//                               Ipv4AddressSetTest
+// =============================================================================
+
+/**
+ * Ipv4AddressSet test suite.
+ * 
+ * \ingroup tests
+ * \ingroup geotemporal-library-test
+ */
+class Ipv4AddressSetTest : public LibraryUtilsTestCase
+{
+public:
+
+  Ipv4AddressSetTest () : LibraryUtilsTestCase ("Ipv4AddressSet") { }
+
+  void
+  DoRun () override
+  {
+    Ipv4AddressSet set;
+    std::set<Ipv4Address> expected_addresses, addresses;
+
+    NS_TEST_EXPECT_MSG_EQ (set.Empty (), true, "Must be empty");
+    NS_TEST_EXPECT_MSG_EQ (set.Contains (Ipv4Address ("10.0.0.1")), false, "Must not be found");
+
+    // Few addresses are kept sorted.
+    NS_TEST_EXPECT_MSG_EQ (set.Insert (Ipv4Address ("10.0.0.5")), true, "Must be inserted");
+    NS_TEST_EXPECT_MSG_EQ (set.Insert (Ipv4Address ("10.0.0.1")), true, "Must be inserted");
+    NS_TEST_EXPECT_MSG_EQ (set.Insert (Ipv4Address ("10.0.0.5")), false, "Must not be inserted twice");
+    NS_TEST_EXPECT_MSG_EQ (set.Size (), 2u, "Must be 2");
+    NS_TEST_EXPECT_MSG_EQ (set.IsBitmapForm (), false, "Must be sorted");
+
+    expected_addresses = {Ipv4Address ("10.0.0.1"), Ipv4Address ("10.0.0.5")};
+    set.GetAddresses (addresses);
+    NS_TEST_EXPECT_MSG_EQ ((addresses == expected_addresses), true, "Must be equal");
+
+    // Many dense addresses are kept in the bitmap.
+    for (uint32_t i = 1u; i <= 100u; ++i)
+      {
+        set.Insert (Ipv4Address (Ipv4Address ("10.0.0.0").Get () + i));
+        expected_addresses.insert (Ipv4Address (Ipv4Address ("10.0.0.0").Get () + i));
+      }
+
+    NS_TEST_EXPECT_MSG_EQ (set.Size (), 100u, "Must be 100");
+    NS_TEST_EXPECT_MSG_EQ (set.IsBitmapForm (), true, "Must be bitmap");
+    NS_TEST_EXPECT_MSG_EQ (set.Contains (Ipv4Address ("10.0.0.64")), true, "Must be found");
+    NS_TEST_EXPECT_MSG_EQ (set.Contains (Ipv4Address ("10.0.0.101")), false, "Must not be found");
+    NS_TEST_EXPECT_MSG_EQ (set.Contains (Ipv4Address ("9.0.0.1")), false, "Must not be found");
+    NS_TEST_EXPECT_MSG_EQ (set.Insert (Ipv4Address ("10.0.0.64")), false, "Must not be inserted twice");
+
+    set.GetAddresses (addresses);
+    NS_TEST_EXPECT_MSG_EQ ((addresses == expected_addresses), true, "Must be equal");
+
+    // A distant address makes the bitmap sparse.
+    NS_TEST_EXPECT_MSG_EQ (set.Insert (Ipv4Address ("10.200.0.1")), true, "Must be inserted");
+    expected_addresses.insert (Ipv4Address ("10.200.0.1"));
+
+    NS_TEST_EXPECT_MSG_EQ (set.Size (), 101u, "Must be 101");
+    NS_TEST_EXPECT_MSG_EQ (set.IsBitmapForm (), false, "Must be sorted");
+    NS_TEST_EXPECT_MSG_EQ (set.Contains (Ipv4Address ("10.0.0.64")), true, "Must be found");
+
+    set.GetAddresses (addresses);
+    NS_TEST_EXPECT_MSG_EQ ((addresses == expected_addresses), true, "Must be equal");
+
+    // Sets with the same addresses are equal regardless of their form.
+    Ipv4AddressSet bitmap_set, sorted_set;
+
+    for (uint32_t i = 1u; i <= 9u; ++i)
+      bitmap_set.Insert (Ipv4Address (Ipv4Address ("10.0.0.0").Get () + i));
+    bitmap_set.Insert (Ipv4Address ("10.0.2.0"));
+
+    sorted_set.Insert (Ipv4Address ("10.0.2.0"));
+    for (uint32_t i = 1u; i <= 9u; ++i)
+      sorted_set.Insert (Ipv4Address (Ipv4Address ("10.0.0.0").Get () + i));
+
+    NS_TEST_EXPECT_MSG_EQ (bitmap_set.IsBitmapForm (), true, "Must be bitmap");
+    NS_TEST_EXPECT_MSG_EQ (sorted_set.IsBitmapForm (), false, "Must be sorted");
+    NS_TEST_EXPECT_MSG_EQ ((bitmap_set == sorted_set), true, "Must be equal");
+
+    sorted_set.Insert (Ipv4Address ("10.0.0.10"));
+    NS_TEST_EXPECT_MSG_EQ ((bitmap_set == sorted_set), false, "Must not be equal");
+
+    set.Clear ();
+    NS_TEST_EXPECT_MSG_EQ (set.Size (), 0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (set.Contains (Ipv4Address ("10.0.0.1")), false, "Must not be found");
+  }
+};
+
+
+// =============================================================================
+//                               SharedMessageTest
+// =============================================================================
+
+/**
+ * SharedMessage test suite.
+ * 
+ * \ingroup tests
+ * \ingroup geotemporal-library-test
+ */
+class SharedMessageTest : public LibraryUtilsTestCase
+{
+public:
+
+  SharedMessageTest () : LibraryUtilsTestCase ("SharedMessage") { }
+
+  void
+  DoRun () override
+  {
+    SharedMessage empty, message ("packet's message"), copy (message);
+
+    NS_TEST_EXPECT_MSG_EQ (empty.Size (), 0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (empty.Get (), "", "Must be empty");
+    NS_TEST_EXPECT_MSG_EQ (message.Size (), 16u, "Must be 16");
+    NS_TEST_EXPECT_MSG_EQ (message.Get (), "packet's message", "Must be equal");
+
+    // Copies share the buffer of the message.
+    NS_TEST_EXPECT_MSG_EQ (copy.IsSharedWith (message), true, "Must be shared");
+    NS_TEST_EXPECT_MSG_EQ ((copy == message), true, "Must be equal");
+    NS_TEST_EXPECT_MSG_EQ ((SharedMessage ("packet's message") == message), true, "Must be equal");
+    NS_TEST_EXPECT_MSG_EQ ((empty == message), false, "Must not be equal");
+
+    // Serialization writes the characters and the null terminator.
+    Buffer buffer;
+    buffer.AddAtStart (message.Size () + empty.Size () + 2u);
+
+    Buffer::Iterator it = buffer.Begin ();
+    message.Write (it);
+    empty.Write (it);
+
+    SharedMessage read_message ("previous message"), read_empty ("previous message");
+    it = buffer.Begin ();
+    read_message.Read (it);
+    read_empty.Read (it);
+
+    NS_TEST_EXPECT_MSG_EQ (it.GetDistanceFrom (buffer.Begin ()), 18u, "Must be 18");
+    NS_TEST_EXPECT_MSG_EQ ((read_message == message), true, "Must be equal");
+    NS_TEST_EXPECT_MSG_EQ (read_message.IsSharedWith (message), false, "Must not be shared");
+    NS_TEST_EXPECT_MSG_EQ ((read_empty == empty), true, "Must be equal");
+  }
+};
+
+
+// =============================================================================
+//                         CompactCoordinatesEncodingTest
+// =============================================================================
+
+/**
+ * CompactCoordinatesEncoding test suite.
+ * 
+ * \ingroup tests
+ * \ingroup geotemporal-library-test
+ */
+class CompactCoordinatesEncodingTest : public LibraryUtilsTestCase
+{
+public:
+
+  CompactCoordinatesEncodingTest () : LibraryUtilsTestCase ("CompactCoordinatesEncoding") { }
+
+  void
+  TestSerializedSize ()
+  {
+    // Each coordinate uses 3 bytes up to 1048 meters from the origin, and 4
+    // bytes up to 134 kilometers.
+    NS_TEST_EXPECT_MSG_EQ (CompactCoordinatesEncoding::GetAreaSerializedSize (Area (0, 0, 0, 0)),
+                           4u, "Must be 4u");
+    NS_TEST_EXPECT_MSG_EQ (CompactCoordinatesEncoding::GetAreaSerializedSize (Area (30, 40, 50, 60)),
+                           12u, "Must be 12u");
+    NS_TEST_EXPECT_MSG_EQ (CompactCoordinatesEncoding::GetAreaSerializedSize (Area (-1048, -1048, 1048, 1048)),
+                           12u, "Must be 12u");
+    NS_TEST_EXPECT_MSG_EQ (CompactCoordinatesEncoding::GetAreaSerializedSize (Area (0, 0, 1049, 134000)),
+                           10u, "Must be 10u");
+
+    const GeoTemporalLibrary::LibraryUtils::Vector2D position (1048, -1048), velocity (104, -104);
+    NS_TEST_EXPECT_MSG_EQ (CompactCoordinatesEncoding::GetPositionSerializedSize (position), 6u, "Must be 6u");
+    NS_TEST_EXPECT_MSG_EQ (CompactCoordinatesEncoding::GetVelocitySerializedSize (velocity), 6u, "Must be 6u");
+  }
+
+  void
+  TestSerializationDeserialization ()
+  {
+    const Area area (-100.25, 40.5, 1000.125, 2000.75), rounded_area (12.0004, 7.0006, 20, 30);
+    const GeoTemporalLibrary::LibraryUtils::Vector2D position (-50.63, 159), velocity (5.5559, -1.1111);
+
+    const uint32_t size = CompactCoordinatesEncoding::GetAreaSerializedSize (area)
+            + CompactCoordinatesEncoding::GetAreaSerializedSize (rounded_area)
+            + CompactCoordinatesEncoding::GetPositionSerializedSize (position)
+            + CompactCoordinatesEncoding::GetVelocitySerializedSize (velocity);
+
+    Buffer buffer;
+    buffer.AddAtStart (size);
+
+    Buffer::Iterator it = buffer.Begin ();
+    CompactCoordinatesEncoding::WriteArea (it, area);
+    CompactCoordinatesEncoding::WriteArea (it, rounded_area);
+    CompactCoordinatesEncoding::WritePosition (it, position);
+    CompactCoordinatesEncoding::WriteVelocity (it, velocity);
+
+    it = buffer.Begin ();
+    NS_TEST_EXPECT_MSG_EQ (CompactCoordinatesEncoding::ReadArea (it), area, "Must be " << area);
+
+    // The area coordinates are rounded to millimeters.
+    const Area expected_area (12, 7.001, 20, 30);
+    NS_TEST_EXPECT_MSG_EQ (CompactCoordinatesEncoding::ReadArea (it), expected_area,
+                           "Must be " << expected_area);
+
+    NS_TEST_EXPECT_MSG_EQ (CompactCoordinatesEncoding::ReadPosition (it), position, "Must be " << position);
+    NS_TEST_EXPECT_MSG_EQ (CompactCoordinatesEncoding::ReadVelocity (it), velocity, "Must be " << velocity);
+
+    NS_TEST_EXPECT_MSG_EQ (it.GetDistanceFrom (buffer.Begin ()), size, "Must be " << size);
+  }
+
+  void
+  DoRun () override
+  {
+    TestSerializedSize ();
+    TestSerializationDeserialization ();
+  }
+};
+
+class ReplicaAllocationPolicyTest : public LibraryUtilsTestCase
+{
+public:
+
+  ReplicaAllocationPolicyTest () : LibraryUtilsTestCase ("ReplicaAllocationPolicy") { }
+
+  void
+  TestInvalidArguments (uint32_t min_replicas, uint32_t max_replicas,
+                        double reference_neighbors, const Time & reference_lifetime)
+  {
+    bool throwed_exception = false;
+
+    try
+      {
+        DensityAdaptiveReplicaAllocationPolicy will_fail (3u, min_replicas, max_replicas,
+                                                          reference_neighbors,
+                                                          reference_lifetime);
+      }
+    catch (std::invalid_argument & ex)
+      {
+        throwed_exception = true;
+        NS_TEST_EXPECT_MSG_EQ (1, 1, "Must happen.");
+      }
+    catch (...)
+      {
+        throwed_exception = false;
+        NS_TEST_EXPECT_MSG_EQ (1, 0, "Must never happen.");
+      }
+
+    NS_TEST_EXPECT_MSG_EQ (throwed_exception, true, "Right exception must have been thrown.");
+  }
+
+  void
+  DoRun () override
+  {
+    // Fixed allocation ignores the density and the remaining lifetime.
+    FixedReplicaAllocationPolicy fixed (5u);
+
+    NS_TEST_EXPECT_MSG_EQ (fixed.GetInitialReplicas (0.0, Seconds (10)), 5u, "Must be 5");
+    NS_TEST_EXPECT_MSG_EQ (fixed.GetInitialReplicas (50.0, Seconds (600)), 5u, "Must be 5");
+
+    // Density-adaptive allocation: 3 replicas with 10 neighbors and 300 
+    // seconds of remaining lifetime, between 1 and 8 replicas.
+    DensityAdaptiveReplicaAllocationPolicy adaptive (3u, 1u, 8u, 10.0, Seconds (300));
+
+    NS_TEST_EXPECT_MSG_EQ (adaptive.GetInitialReplicas (10.0, Seconds (300)), 3u, "Must be 3");
+    NS_TEST_EXPECT_MSG_EQ (adaptive.GetInitialReplicas (20.0, Seconds (300)), 2u, "Must be 2");
+    NS_TEST_EXPECT_MSG_EQ (adaptive.GetInitialReplicas (5.0, Seconds (300)), 6u, "Must be 6");
+    NS_TEST_EXPECT_MSG_EQ (adaptive.GetInitialReplicas (10.0, Seconds (150)), 6u, "Must be 6");
+    NS_TEST_EXPECT_MSG_EQ (adaptive.GetInitialReplicas (10.0, Seconds (600)), 2u, "Must be 2");
+
+    // Clamped to the limits.
+    NS_TEST_EXPECT_MSG_EQ (adaptive.GetInitialReplicas (2.0, Seconds (300)), 8u, "Must be 8");
+    NS_TEST_EXPECT_MSG_EQ (adaptive.GetInitialReplicas (100.0, Seconds (300)), 1u, "Must be 1");
+    NS_TEST_EXPECT_MSG_EQ (adaptive.GetInitialReplicas (0.0, Seconds (300)), 8u, "Must be 8");
+    NS_TEST_EXPECT_MSG_EQ (adaptive.GetInitialReplicas (10.0, Seconds (0)), 1u, "Must be 1");
+
+    TestInvalidArguments (0u, 8u, 10.0, Seconds (300));
+    TestInvalidArguments (9u, 8u, 10.0, Seconds (300));
+    TestInvalidArguments (1u, 8u, 0.0, Seconds (300));
+    TestInvalidArguments (1u, 8u, 10.0, Seconds (0));
+  }
+};
+
+
+/******************************************************************************/
+/*                            packets-queue-core.h                            */
+/******************************************************************************/
+
+// =============================================================================
+//                             PacketsQueueCoreTest
+// =============================================================================
+
+/**
+ * PacketsQueueCore test suite.
+ * 
+ * \ingroup tests
+ * \ingroup geotemporal-library-test
+ */
+class PacketsQueueCoreTest : public LibraryUtilsTestCase
+{
+private:
+
+  /** Packet entry that only has an expiration instant. */
+  class Entry
+  {
+  private:
+
+    Time m_expiration_instant;
+
+  public:
+
+    Entry () : m_expiration_instant () { }
+
+    Entry (const Time & expiration_instant) : m_expiration_instant (expiration_instant) { }
+
+    inline const Time &
+    GetExpirationInstant () const
+    {
+      return m_expiration_instant;
+    }
+
+    friend bool
+    operator== (const Entry & lhs, const Entry & rhs)
+    {
+      return lhs.m_expiration_instant == rhs.m_expiration_instant;
+    }
+  };
+
+  /** Selects the entries that expire after the given time instant. */
+  class ExpiresAfter
+  {
+  private:
+
+    Time m_time_instant;
+
+  public:
+
+    ExpiresAfter (const Time & time_instant) : m_time_instant (time_instant) { }
+
+    bool
+    operator() (const Entry & entry) const
+    {
+      return entry.GetExpirationInstant () > m_time_instant;
+    }
+  };
+
+  typedef PacketsQueueCore<Entry, DropEarliestExpiration> Queue_t;
+
+public:
+
+  PacketsQueueCoreTest () : LibraryUtilsTestCase ("PacketsQueueCore") { }
+
+  void
+  TestDropEarliestExpiration ()
+  {
+    const Ipv4Address source_ip ("1.1.1.1");
+    Queue_t queue (3u);
+
+    queue.insert (std::make_pair (DataIdentifier (source_ip, 1u), Entry (Seconds (30))));
+    queue.insert (std::make_pair (DataIdentifier (source_ip, 2u), Entry (Seconds (10))));
+
+    NS_TEST_EXPECT_MSG_EQ (queue.IsFull (), false, "Must not be full");
+
+    queue.insert (std::make_pair (DataIdentifier (source_ip, 3u), Entry (Seconds (10))));
+
+    NS_TEST_EXPECT_MSG_EQ (queue.IsFull (), true, "Must be full");
+
+    // Packets that expire at the same time are ordered by data identifier.
+    NS_TEST_EXPECT_MSG_EQ (queue.SelectPacketToDrop ()->first, DataIdentifier (source_ip, 2u),
+                           "Must be 1.1.1.1:2");
+
+    NS_TEST_EXPECT_MSG_EQ (queue.DropPacket (DataIdentifier (source_ip, 2u)), true, "Must be dropped");
+    NS_TEST_EXPECT_MSG_EQ (queue.DropPacket (DataIdentifier (source_ip, 9u)), false, "Must not exist");
+    NS_TEST_EXPECT_MSG_EQ (queue.GetDroppedPacketsCounter (), 2u, "Must be 2");
+    NS_TEST_EXPECT_MSG_EQ (queue.size (), 2u, "Must be 2");
+    NS_TEST_EXPECT_MSG_EQ (queue.SelectPacketToDrop ()->first, DataIdentifier (source_ip, 3u),
+                           "Must be 1.1.1.1:3");
+  }
+
+  void
+  TestPurge ()
+  {
+    const Ipv4Address source_ip ("1.1.1.1");
+    Queue_t queue (10u);
+
+    queue.insert (std::make_pair (DataIdentifier (source_ip, 1u), Entry (Seconds (5))));
+    queue.insert (std::make_pair (DataIdentifier (source_ip, 2u), Entry (Seconds (20))));
+    queue.insert (std::make_pair (DataIdentifier (source_ip, 3u), Entry (Seconds (10))));
+    queue.erase (DataIdentifier (source_ip, 3u));
+
+    std::vector<DataIdentifier> purged_packets;
+    queue.Purge (Seconds (10), &purged_packets);
+
+    // The instant of the erased entry is ignored.
+    NS_TEST_EXPECT_MSG_EQ (purged_packets.size (), 1u, "Must be 1");
+    NS_TEST_EXPECT_MSG_EQ (purged_packets.front (), DataIdentifier (source_ip, 1u), "Must be 1.1.1.1:1");
+    NS_TEST_EXPECT_MSG_EQ (queue.size (), 1u, "Must be 1");
+
+    queue.Purge (Seconds (20), 0);
+    NS_TEST_EXPECT_MSG_EQ (queue.empty (), true, "Must be empty");
+  }
+
+  void
+  TestDisjointVectors ()
+  {
+    const Ipv4Address source_ip ("1.1.1.1");
+    Queue_t queue (10u);
+
+    for (uint32_t i = 1u; i <= 4u; ++i)
+      queue.insert (std::make_pair (DataIdentifier (source_ip, i), Entry (Seconds (10 * i))));
+
+    std::set<DataIdentifier> summary_vector;
+    summary_vector.insert (DataIdentifier (source_ip, 2u));
+    summary_vector.insert (DataIdentifier (source_ip, 7u));
+
+    std::vector<DataIdentifier> unknown_packets, missing_packets, expected_packets;
+
+    queue.GetUnknownPackets (summary_vector, unknown_packets);
+    expected_packets = {DataIdentifier (source_ip, 1u), DataIdentifier (source_ip, 3u),
+      DataIdentifier (source_ip, 4u)};
+    NS_TEST_EXPECT_MSG_EQ ((unknown_packets == expected_packets), true, "Must be the expected");
+
+    queue.GetMissingPackets (summary_vector, missing_packets);
+    expected_packets = {DataIdentifier (source_ip, 7u)};
+    NS_TEST_EXPECT_MSG_EQ ((missing_packets == expected_packets), true, "Must be the expected");
+
+    std::set<DataIdentifier> selected_packets;
+    const uint32_t selected_count = queue.FilterPackets (unknown_packets, ExpiresAfter (Seconds (15)),
+                                                         selected_packets);
+
+    NS_TEST_EXPECT_MSG_EQ (selected_count, 2u, "Must be 2");
+    NS_TEST_EXPECT_MSG_EQ (selected_packets.count (DataIdentifier (source_ip, 3u)), 1u, "Must be selected");
+    NS_TEST_EXPECT_MSG_EQ (selected_packets.count (DataIdentifier (source_ip, 4u)), 1u, "Must be selected");
+  }
+
+  void
+  TestSplitReplicas ()
+  {
+    uint32_t replicas_to_forward = 0u, replicas_to_keep = 0u;
+
+    NS_TEST_EXPECT_MSG_EQ (NormalSprayReplicas::SplitReplicas (1u, replicas_to_forward, replicas_to_keep),
+                           false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ (NormalSprayReplicas::SplitReplicas (5u, replicas_to_forward, replicas_to_keep),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (replicas_to_forward, 1u, "Must be 1");
+    NS_TEST_EXPECT_MSG_EQ (replicas_to_keep, 4u, "Must be 4");
+
+    NS_TEST_EXPECT_MSG_EQ (BinarySprayReplicas::SplitReplicas (0u, replicas_to_forward, replicas_to_keep),
+                           false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ (BinarySprayReplicas::SplitReplicas (5u, replicas_to_forward, replicas_to_keep),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (replicas_to_forward, 2u, "Must be 2");
+    NS_TEST_EXPECT_MSG_EQ (replicas_to_keep, 3u, "Must be 3");
+  }
+
+  void
+  DoRun () override
+  {
+    TestDropEarliestExpiration ();
+    TestPurge ();
+    TestDisjointVectors ();
+    TestSplitReplicas ();
+  }
+};
+
+
 /******************************************************************************/
 /*                            statistics-utils.h/cc                           */
 /******************************************************************************/
@@ -6352,7 +7789,18 @@ public:
 
   GeoTemporalLibraryTestSuite () : TestSuite ("geotemporal-library", UNIT)
   {
+    AddTestCase (new AreaSetTest, TestCase::QUICK);
+    AddTestCase (new DataIdentifierMapTest, TestCase::QUICK);
+    AddTestCase (new CachedPacketIdSetTest, TestCase::QUICK);
+    AddTestCase (new Ipv4AddressSetTest, TestCase::QUICK);
+    AddTestCase (new SharedMessageTest, TestCase::QUICK);
+    AddTestCase (new CompactCoordinatesEncodingTest, TestCase::QUICK);
+    AddTestCase (new ReplicaAllocationPolicyTest, TestCase::QUICK);
+    AddTestCase (new PacketsQueueCoreTest, TestCase::QUICK);
     AddTestCase (new TimePeriodTest, TestCase::QUICK);
+    AddTestCase (new RandomDestinationGeoTemporalAreasListsTest, TestCase::QUICK);
+    AddTestCase (new GeoTemporalAreasVisitorNodesTest, TestCase::QUICK);
+    AddTestCase (new ExpirationIndexTest, TestCase::QUICK);
     AddTestCase (new PacketClassTest, TestCase::QUICK);
     AddTestCase (new PacketsCounterTest, TestCase::QUICK);
     AddTestCase (new TransmissionTypeTest, TestCase::QUICK);
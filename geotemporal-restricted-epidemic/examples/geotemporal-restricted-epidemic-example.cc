@@ -23,7 +23,7 @@
  * Author: Luis Ricardo Gallego Tercero <luiss_121314@hotmail.com>
  */
 
-#include "geotemporal-restricted-epidemic-installer.h"
+#include <ns3/geotemporal-restricted-epidemic-installer.h>
 
 #include <ns3/log.h>
 
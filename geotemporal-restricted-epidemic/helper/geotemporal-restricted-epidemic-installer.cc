@@ -71,14 +71,18 @@ m_simulation_number (1u), m_simulation_duration (600u),
 m_data_packet_source_vehicles_count (8u), m_data_packets_per_source (2u),
 m_data_packet_message_size (128u), m_data_packets_data_rate (5u),
 m_mobility_scenario_id ("60"),
+m_mobility_scenario_files_prefix (""),
 m_vehicles_count (2u), m_fixed_nodes_distance (200u),
 m_use_80211p_mac_protocol (false), m_progress_report_time_interval (25u),
 m_hello_packets_interval (1000u), m_packets_queue_capacity (128u),
 m_neighbor_expiration_time (10u), m_data_packet_hops_count (8u),
+m_compact_header_encoding (false),
+m_summary_vector_encoding ("Explicit"), m_summary_vector_false_positive_rate (0.01),
 m_streets_graph_input_filename (""), m_street_junctions_input_filename (""),
 m_vehicles_routes_input_filename (""), m_vehicles_mobility_trace_filename (""),
 m_random_destination_gta_input_filename (""), m_gta_visitor_vehicles_input_filename (""),
-m_statistics_output_filename ("/simulations-output/simulation_statistics.xml")
+m_statistics_output_filename ("/simulations-output/simulation_statistics.xml"),
+m_simulator_events_count (0u), m_statistics_values ()
 {
   NS_LOG_FUNCTION (this);
 }
@@ -97,6 +101,7 @@ m_data_packets_per_source (copy.m_data_packets_per_source),
 m_data_packet_message_size (copy.m_data_packet_message_size),
 m_data_packets_data_rate (copy.m_data_packets_data_rate),
 m_mobility_scenario_id (copy.m_mobility_scenario_id),
+m_mobility_scenario_files_prefix (copy.m_mobility_scenario_files_prefix),
 m_vehicles_count (copy.m_vehicles_count),
 m_fixed_nodes_distance (copy.m_fixed_nodes_distance),
 m_use_80211p_mac_protocol (copy.m_use_80211p_mac_protocol),
@@ -105,13 +110,18 @@ m_hello_packets_interval (copy.m_hello_packets_interval),
 m_packets_queue_capacity (copy.m_packets_queue_capacity),
 m_neighbor_expiration_time (copy.m_neighbor_expiration_time),
 m_data_packet_hops_count (copy.m_data_packet_hops_count),
+m_compact_header_encoding (copy.m_compact_header_encoding),
+m_summary_vector_encoding (copy.m_summary_vector_encoding),
+m_summary_vector_false_positive_rate (copy.m_summary_vector_false_positive_rate),
 m_streets_graph_input_filename (copy.m_streets_graph_input_filename),
 m_street_junctions_input_filename (copy.m_street_junctions_input_filename),
 m_vehicles_routes_input_filename (copy.m_vehicles_routes_input_filename),
 m_vehicles_mobility_trace_filename (copy.m_vehicles_mobility_trace_filename),
 m_random_destination_gta_input_filename (copy.m_random_destination_gta_input_filename),
 m_gta_visitor_vehicles_input_filename (copy.m_gta_visitor_vehicles_input_filename),
-m_statistics_output_filename (copy.m_statistics_output_filename)
+m_statistics_output_filename (copy.m_statistics_output_filename),
+m_simulator_events_count (copy.m_simulator_events_count),
+m_statistics_values (copy.m_statistics_values)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -157,10 +167,16 @@ GeoTemporalRestrictedEpidemicInstaller::Configure (int argc, char** argv)
   cmd.AddValue ("mobilityScenarioId",
                 "The identifier of the mobility scenario used in the simulation."
                 "Valid values are: fixed, 20, 30, 60, 90, 120, 30-60, 30-90, "
-                "30-120, 60-90, 60-120, 90-120, low, medium, high. "
+                "30-120, 60-90, 60-120, 90-120, low, medium, high, custom. "
                 "[Default value: 60]",
                 m_mobility_scenario_id);
 
+  cmd.AddValue ("mobilityScenarioFiles",
+                "Prefix of the names of the input files of the custom mobility "
+                "scenario (e.g. simulations-input/Luxembourg/Custom). Only used "
+                "when the custom mobility scenario is selected. [Default value: ]",
+                m_mobility_scenario_files_prefix);
+
   cmd.AddValue ("vehiclesCount",
                 "The number of vehicle nodes to create. Only actively used when "
                 "the fixed mobility scenario is selected."
@@ -210,6 +226,23 @@ GeoTemporalRestrictedEpidemicInstaller::Configure (int argc, char** argv)
                 "[Default value: 8]",
                 m_data_packet_hops_count);
 
+  cmd.AddValue ("compactHeaderEncoding",
+                "Indicates if the positions and areas in the packet headers use "
+                "the compact (fixed-point, variable-length) encoding. "
+                "[Default value: false]",
+                m_compact_header_encoding);
+
+  cmd.AddValue ("summaryVectorEncoding",
+                "Encoding of the summary vectors of the REPLY and REPLY_BACK packets: "
+                "Explicit, DeltaCoded or BloomFilter. "
+                "[Default value: Explicit]",
+                m_summary_vector_encoding);
+
+  cmd.AddValue ("summaryVectorFalsePositiveRate",
+                "False positive rate of the Bloom filters of the summary vectors. "
+                "[Default value: 0.01]",
+                m_summary_vector_false_positive_rate);
+
   // Output files
 
   cmd.AddValue ("outputStatisticsFile",
@@ -447,6 +480,26 @@ GeoTemporalRestrictedEpidemicInstaller::Configure (int argc, char** argv)
       // Geo-temporal areas visitor vehicles
       m_gta_visitor_vehicles_input_filename = "simulations-input/Luxembourg/High.geo_temporal_areas_visitor_nodes.txt";
     }
+  else if (m_mobility_scenario_id == "custom")
+    {
+      if (m_mobility_scenario_files_prefix.empty ())
+        NS_ABORT_MSG ("The prefix of the input files is required by the custom "
+                      "mobility scenario.");
+
+      // GPS initialization files
+      m_streets_graph_input_filename = m_mobility_scenario_files_prefix + ".graph.txt";
+      m_street_junctions_input_filename = m_mobility_scenario_files_prefix + ".junctions.txt";
+      m_vehicles_routes_input_filename = m_mobility_scenario_files_prefix + ".routes.txt";
+
+      // Vehicles' mobility trace file
+      m_vehicles_mobility_trace_filename = m_mobility_scenario_files_prefix + ".ns2.mob.tcl";
+
+      // Random destination areas.
+      m_random_destination_gta_input_filename = m_mobility_scenario_files_prefix + ".random_geo_temporal_areas.txt";
+
+      // Geo-temporal areas visitor vehicles
+      m_gta_visitor_vehicles_input_filename = m_mobility_scenario_files_prefix + ".geo_temporal_areas_visitor_nodes.txt";
+    }
   else if (m_mobility_scenario_id == "fixed")
     {
       // Do something when fixed mobility.
@@ -455,7 +508,7 @@ GeoTemporalRestrictedEpidemicInstaller::Configure (int argc, char** argv)
     {
       NS_ABORT_MSG ("Invalid mobility scenario identifier. Valid values are: "
                     "fixed, 20, 30, 60, 90, 120, 30-60, 30-90, 30-120, 60-90, "
-                    "60-120, 90-120, low, medium, high.");
+                    "60-120, 90-120, low, medium, high, custom.");
     }
 
   // When the nodes have mobility create GPS and configurate GPS system and 
@@ -471,10 +524,13 @@ GeoTemporalRestrictedEpidemicInstaller::Configure (int argc, char** argv)
       // Set number of vehicles in the simulation
       m_vehicles_count = m_gps_system->GetVehiclesRoutesData ().GetNodesCount ();
 
-      // Random destination geo-temporal areas object
+      // Random destination geo-temporal areas object (only the list used in
+      // this simulation is imported)
       NS_ASSERT (m_random_destination_gtas == 0);
       m_random_destination_gtas =
-              Create<RandomDestinationGeoTemporalAreasLists> (m_random_destination_gta_input_filename);
+              Create<RandomDestinationGeoTemporalAreasLists> (m_random_destination_gta_input_filename,
+                                                              m_simulation_number,
+                                                              m_data_packet_source_vehicles_count);
     }
 
   return true;
@@ -496,6 +552,8 @@ GeoTemporalRestrictedEpidemicInstaller::Run ()
   std::cout << " - Data packet message size        :  " << m_data_packet_message_size << " bytes\n";
   std::cout << " - Data packets data rate          :  " << m_data_packets_data_rate << " milliseconds\n";
   std::cout << " - Mobility scenario ID            :  " << m_mobility_scenario_id << "\n";
+  if (m_mobility_scenario_id == "custom")
+    std::cout << " - Mobility scenario files prefix  :  " << m_mobility_scenario_files_prefix << "\n";
   std::cout << " - Vehicles count                  :  " << m_vehicles_count << "\n";
   std::cout << " - Distance between fixed nodes    :  " << m_fixed_nodes_distance << " meters";
   if (m_mobility_scenario_id != "fixed")
@@ -514,6 +572,11 @@ GeoTemporalRestrictedEpidemicInstaller::Run ()
   std::cout << " - Packets queue capacity          :  " << m_packets_queue_capacity << " packets\n";
   std::cout << " - Neighbor expiration time        :  " << m_neighbor_expiration_time << " seconds\n";
   std::cout << " - Data packet hops count          :  " << m_data_packet_hops_count << " hops\n";
+  std::cout << " - Compact header encoding         :  " << (m_compact_header_encoding ? "Enabled" : "Disabled") << "\n";
+  std::cout << " - Summary vector encoding         :  " << m_summary_vector_encoding;
+  if (m_summary_vector_encoding == "BloomFilter")
+    std::cout << " (" << m_summary_vector_false_positive_rate << " false positive rate)";
+  std::cout << "\n";
   std::cout << "\n";
 
   if (m_mobility_scenario_id != "fixed")
@@ -539,6 +602,7 @@ GeoTemporalRestrictedEpidemicInstaller::Run ()
   ScheduleNextProgressReport ();
   Simulator::Stop (Seconds (m_simulation_duration));
   Simulator::Run ();
+  m_simulator_events_count = Simulator::GetEventCount ();
   Simulator::Destroy ();
 
   std::cout << "Simulation finished.\n";
@@ -650,6 +714,9 @@ GeoTemporalRestrictedEpidemicInstaller::InstallInternetStack ()
   restricted_epidemic_helper.Set ("PacketsQueueCapacity", UintegerValue (m_packets_queue_capacity));
   restricted_epidemic_helper.Set ("NeighborsExpirationTime", TimeValue (Seconds (m_neighbor_expiration_time)));
   restricted_epidemic_helper.Set ("DataPacketHopsCount", UintegerValue (m_data_packet_hops_count));
+  restricted_epidemic_helper.Set ("CompactHeaderEncoding", BooleanValue (m_compact_header_encoding));
+  restricted_epidemic_helper.Set ("SummaryVectorEncoding", StringValue (m_summary_vector_encoding));
+  restricted_epidemic_helper.Set ("SummaryVectorFalsePositiveRate", DoubleValue (m_summary_vector_false_positive_rate));
 
   InternetStackHelper internet_stack;
   internet_stack.SetRoutingHelper (restricted_epidemic_helper); // has effect on the next Install ()
@@ -985,6 +1052,8 @@ GeoTemporalRestrictedEpidemicInstaller::Report (const std::string& output_xml_fi
         }
     }
 
+  simulation_stats.CalculateStatistics (m_statistics_values);
+
   std::cout << "Done.\n";
 
   simulation_stats.SaveToXmlFile (output_xml_filename);
@@ -87,14 +87,16 @@ NeighborsTable::NeighborsTable ()
 }
 
 NeighborsTable::NeighborsTable (const Time& entries_expiration_time)
-: m_table (), m_entries_expiration_time (entries_expiration_time)
+: m_table (), m_entries_expiration_time (entries_expiration_time),
+m_expiration_index ()
 {
   NS_LOG_FUNCTION (this);
 }
 
 NeighborsTable::NeighborsTable (const NeighborsTable& copy)
 : m_table (copy.m_table),
-m_entries_expiration_time (copy.m_entries_expiration_time)
+m_entries_expiration_time (copy.m_entries_expiration_time),
+m_expiration_index (copy.m_expiration_index)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -173,6 +175,7 @@ NeighborsTable::Insert (const Ipv4Address& new_neighbor_ip)
 
   const NeighborEntry new_neighbor_entry (new_neighbor_ip, m_entries_expiration_time);
   m_table.insert (std::make_pair (new_neighbor_ip, new_neighbor_entry));
+  m_expiration_index.Push (new_neighbor_ip, new_neighbor_entry.GetExpirationTime ());
 
   NS_LOG_DEBUG (m_table.size () << " neighbors after insertion of new neighbor: "
                 << new_neighbor_entry);
@@ -214,6 +217,7 @@ NeighborsTable::RestartNeighborEntryExpirationTime (const Ipv4Address& neighbor_
                 << " restarted.");
 
   entry_it->second.SetExpirationTime (m_entries_expiration_time);
+  m_expiration_index.Push (neighbor_ip, entry_it->second.GetExpirationTime ());
   return true;
 }
 
@@ -224,20 +228,24 @@ NeighborsTable::Purge ()
 
   const Time now = Simulator::Now ();
 
-  for (ConstIterator_t entry_it = m_table.begin (); entry_it != m_table.end ();)
+  while (m_expiration_index.HasExpired (now))
     {
-      // If the expiration time of the neighbor node is less or equal than NOW 
-      // then the neighbor entry is expired.
-      if (entry_it->second.GetExpirationTime () <= now)
-        {
-          NS_LOG_LOGIC ("Drops expired neighbor entry : " << entry_it->second);
-          // m_table.erase (entry_it++); // For C++03
-          entry_it = m_table.erase (entry_it); // For C++11
-        }
-      else
-        {
-          ++entry_it;
-        }
+      Iterator_t entry_it = m_table.find (m_expiration_index.Pop ());
+
+      // Ignore the stale instants of removed or restarted entries
+      if (entry_it == m_table.end () || entry_it->second.GetExpirationTime () > now)
+        continue;
+
+      NS_LOG_LOGIC ("Drops expired neighbor entry : " << entry_it->second);
+      m_table.erase (entry_it);
+    }
+
+  if (m_expiration_index.NeedsRebuild (m_table.size ()))
+    {
+      m_expiration_index.clear ();
+
+      for (ConstIterator_t entry_it = m_table.begin (); entry_it != m_table.end (); ++entry_it)
+        m_expiration_index.Push (entry_it->first, entry_it->second.GetExpirationTime ());
     }
 }
 
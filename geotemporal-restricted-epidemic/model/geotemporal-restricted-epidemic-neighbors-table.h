@@ -32,6 +32,8 @@
 #include <ns3/nstime.h>
 #include <ns3/simulator.h>
 
+#include <ns3/geotemporal-utils.h>
+
 
 namespace ns3
 {
@@ -171,6 +173,10 @@ private:
   /** Expiration time of the neighbor entries. */
   Time m_entries_expiration_time;
 
+  /** Expiration instants of the neighbor entries, used to purge only the 
+   * expired entries. */
+  GeoTemporalLibrary::LibraryUtils::ExpirationIndex<Ipv4Address> m_expiration_index;
+
   /** Neighbors table iterator. */
   typedef std::map<Ipv4Address, NeighborEntry>::iterator Iterator_t;
 
@@ -270,6 +276,7 @@ public:
   Clear ()
   {
     m_table.clear ();
+    m_expiration_index.clear ();
   }
 
   /**
@@ -327,6 +334,8 @@ public:
 
   /**
    * Removes all expired neighbor entries from the neighbors table.
+   * 
+   * It only visits the entries whose expiration instant has passed.
    */
   void
   Purge ();
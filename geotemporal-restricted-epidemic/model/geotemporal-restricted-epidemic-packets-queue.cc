@@ -83,16 +83,16 @@ PacketQueueEntry::ToString () const
 PacketsQueue::PacketsQueue () : PacketsQueue (128u) { }
 
 PacketsQueue::PacketsQueue (uint32_t maximum_queue_length)
-: m_max_queue_length (maximum_queue_length),
-m_packets_dropped_counter (0u),
-m_packets_table (),
-m_data_packet_reception_stats () { }
+: m_packets_table (maximum_queue_length),
+m_data_packet_reception_stats (),
+m_allowed_area_groups (),
+m_destination_gta_groups () { }
 
 PacketsQueue::PacketsQueue (const PacketsQueue& copy)
-: m_max_queue_length (copy.m_max_queue_length),
-m_packets_dropped_counter (copy.m_packets_dropped_counter),
-m_packets_table (copy.m_packets_table),
-m_data_packet_reception_stats (copy.m_data_packet_reception_stats) { }
+: m_packets_table (copy.m_packets_table),
+m_data_packet_reception_stats (copy.m_data_packet_reception_stats),
+m_allowed_area_groups (copy.m_allowed_area_groups),
+m_destination_gta_groups (copy.m_destination_gta_groups) { }
 
 
 // --------------------------
@@ -160,6 +160,80 @@ PacketsQueue::Find (const PacketQueueEntry& packet_entry) const
 // Modifiers
 // --------------------------
 
+/**
+ * Forwarding filter of the disjoint vector of the Geo-Temporal Restricted
+ * Epidemic protocol. A packet is forwarded if:
+ * 1. the other node is NOT the source node of the packet,
+ * 2. the receiver node is inside of the allowed area for transmission, and
+ * 3. the packet has a hop count greater than 1 or equal to 1 and the other
+ *    node is inside the packet's destination geo-temporal area.
+ */
+class PacketsQueue::DisjointVectorFilter
+{
+private:
+
+  const PacketsQueue & m_packets_queue;
+  const Ipv4Address & m_destination_node_ip;
+  const Time m_current_time;
+
+  /** Areas of the allowed area groups that contain the receiver node. */
+  AreaSet::Bitmask_t m_inside_allowed_area_mask;
+
+  /** Areas of the destination area groups that contain the receiver node. */
+  AreaSet::Bitmask_t m_inside_destination_area_mask;
+
+public:
+
+  DisjointVectorFilter (const PacketsQueue & packets_queue, const Ipv4Address & destination_node_ip,
+                        const GeoTemporalLibrary::LibraryUtils::Vector2D & receiver_node_position)
+  : m_packets_queue (packets_queue), m_destination_node_ip (destination_node_ip),
+  m_current_time (Simulator::Now ()), m_inside_allowed_area_mask (), m_inside_destination_area_mask ()
+  {
+    // Test the distinct allowed areas and destination areas of the packets in 
+    // queue against the receiver node position, once per group of packets.
+    m_packets_queue.m_allowed_area_groups.m_areas.ContainsPoint (receiver_node_position,
+                                                                 m_inside_allowed_area_mask);
+    m_packets_queue.m_destination_gta_groups.m_areas.ContainsPoint (receiver_node_position,
+                                                                    m_inside_destination_area_mask);
+  }
+
+  bool
+  operator() (const PacketQueueEntry & entry) const
+  {
+    // 1. If destination node is the source node, don't insert it into disjoint vector.
+    if (entry.GetSourceNodeIp () == m_destination_node_ip)
+      return false;
+
+    const uint32_t hops_count = entry.GetHopsCount ();
+    NS_ABORT_MSG_IF (hops_count == 0u,
+                     "The hops count of the packets shouldn't be equal to 0.");
+
+    // 2. If the receiver node is not inside the allowed area then the packet 
+    // can not be forwarded.
+    if (!AreaSet::IsSet (m_inside_allowed_area_mask,
+                         m_packets_queue.m_allowed_area_groups.m_entry_slots.at (entry.GetDataPacketId ())))
+      {
+        NS_LOG_DEBUG ("Receiver node " << m_destination_node_ip << " is outside of the"
+                      << " allowed area for transmission.");
+        return false;
+      }
+
+    // 3. If packet's hops count is 1 AND the destination node is not inside the
+    // destination geo-temporal area, then don't insert it into disjoint vector.
+    if (hops_count == 1u)
+      {
+        const AreaGroups<GeoTemporalArea> & destination_gta_groups = m_packets_queue.m_destination_gta_groups;
+        const uint32_t slot = destination_gta_groups.m_entry_slots.at (entry.GetDataPacketId ());
+
+        if (!AreaSet::IsSet (m_inside_destination_area_mask, slot)
+            || !destination_gta_groups.m_keys[slot].GetTimePeriod ().IsDuringTimePeriod (m_current_time))
+          return false;
+      }
+
+    return true;
+  }
+};
+
 void
 PacketsQueue::ProcessDisjointVector (const SummaryVectorHeader& summary_vector_header,
                                      const Ipv4Address& destination_node_ip,
@@ -171,83 +245,96 @@ PacketsQueue::ProcessDisjointVector (const SummaryVectorHeader& summary_vector_h
   // Clean the disjoint vector.
   disjoint_vector.clear ();
 
-  uint32_t hops_count = 0u, added_packets_counter = 0u;
+  // The packets in queue that are not contained in the summary vector are 
+  // found in a single merge pass over the sorted identifiers of both. A Bloom
+  // filter can't be listed, so the packets in queue are tested against it.
+  std::vector<DataIdentifier> unknown_packets;
 
-  const Time current_time = Simulator::Now ();
-  const std::set<DataIdentifier> & summary_vector = summary_vector_header.GetSummaryVector ();
-  const GeoTemporalLibrary::LibraryUtils::Vector2D & receiver_node_position
-          = summary_vector_header.GetPosition ();
+  if (summary_vector_header.GetSummaryVectorEncoding () == SummaryVectorEncoding::BloomFilter)
+    m_packets_table.GetUnknownPackets (summary_vector_header.GetBloomFilter (), unknown_packets);
+  else
+    m_packets_table.GetUnknownPackets (summary_vector_header.GetSummaryVector (), unknown_packets);
 
-  Area allowed_area;
+  // Add to the disjoint vector the unknown packets that the other node can
+  // receive.
+  const uint32_t added_packets_counter
+          = m_packets_table.FilterPackets (unknown_packets,
+                                           DisjointVectorFilter (*this, destination_node_ip,
+                                                                 summary_vector_header.GetPosition ()),
+                                           disjoint_vector);
 
-  // Iterate through all the packets in queue
-  for (ConstIterator_t entry_it = m_packets_table.begin ();
-          entry_it != m_packets_table.end (); ++entry_it)
+  NS_LOG_DEBUG (added_packets_counter << " / " << m_packets_table.size ()
+                << " packets added to the disjoint vector.");
+}
+
+void
+PacketsQueue::InsertAreaGroupsEntry (const DataIdentifier& data_id, const DataHeader& data_packet)
+{
+  const Area allowed_area = data_packet.GetAllowedArea ();
+  const GeoTemporalArea & destination_gta = data_packet.GetDestinationGeoTemporalArea ();
+
+  InsertAreaGroupEntry (m_allowed_area_groups, data_id, allowed_area, allowed_area);
+  InsertAreaGroupEntry (m_destination_gta_groups, data_id, destination_gta, destination_gta.GetArea ());
+}
+
+void
+PacketsQueue::RemoveAreaGroupsEntry (const DataIdentifier& data_id)
+{
+  RemoveAreaGroupEntry (m_allowed_area_groups, data_id);
+  RemoveAreaGroupEntry (m_destination_gta_groups, data_id);
+}
+
+template <typename AreaKey>
+void
+PacketsQueue::InsertAreaGroupEntry (AreaGroups<AreaKey>& groups, const DataIdentifier& data_id,
+                                    const AreaKey& key, const Area& area)
+{
+  typename std::map<AreaKey, uint32_t>::iterator group_it = groups.m_group_slots.find (key);
+
+  if (group_it == groups.m_group_slots.end ())
     {
-      /* Check if the data identifier of the current packet exists in the 
-       * received summary vector. If it doesn't exist then insert it into the 
-       * disjoint vector.
-       * 
-       * Also check that:
-       * 1. the other node is NOT the source node of the packet,
-       * 2. the receiver node is inside of the allowed area for transmission, and
-       * 3. the packet has a hop count greater than 1 or equal to 1 and the
-       *    other node is inside the packet's destination geo-temporal area.
-       */
-
-      // If packet is contained in the summary vector, don't insert it into disjoint vector.
-      if (summary_vector.find (entry_it->first) != summary_vector.end ())
-        continue;
-
-      // 1. If destination node is the source node, don't insert it into disjoint vector.
-      if (entry_it->second.GetSourceNodeIp () == destination_node_ip)
-        continue;
-
-      hops_count = entry_it->second.GetHopsCount ();
-      NS_ABORT_MSG_IF (hops_count == 0u,
-                       "The hops count of the packets shouldn't be equal to 0.");
-
-      const DataHeader & data_packet = entry_it->second.GetDataPacket ();
-
-      allowed_area = data_packet.GetAllowedArea ();
-
-      // 2. If the receiver node is not inside the allowed area then the packet 
-      // can not be forwarded.
-      if (!allowed_area.IsInside (receiver_node_position))
-        {
-          NS_LOG_DEBUG ("Receiver node " << destination_node_ip << " is outside of the"
-                        << " allowed area for transmission.");
-          continue;
-        }
-
-      // 3. If packet's hops count is 1 AND the destination node is not inside the
-      // destination geo-temporal area, then don't insert it into disjoint vector.
-      if (hops_count == 1u
-          && !data_packet.GetDestinationGeoTemporalArea ()
-          .IsInsideGeoTemporalArea (receiver_node_position, current_time))
-        continue;
-
-      /* At this point the packet fulfills all of the following:
-       * - Is not contained in the summary vector.
-       * - Destination node is not the source node.
-       * - It is inside of the allowed area for transmission.
-       * - It has at least 1 hop left.
-       * 
-       * Add it to the disjoint vector.
-       */
-      disjoint_vector.insert (entry_it->first);
-      ++added_packets_counter;
+      group_it = groups.m_group_slots.insert (std::make_pair (key, groups.m_areas.Add (area))).first;
+      groups.m_keys.push_back (key);
+      groups.m_members.push_back (std::set<DataIdentifier> ());
     }
 
-  NS_LOG_DEBUG (added_packets_counter << " / " << m_packets_table.size ()
-                << " packets added to the disjoint vector.");
+  groups.m_members[group_it->second].insert (data_id);
+  groups.m_entry_slots.insert (std::make_pair (data_id, group_it->second));
 }
 
-bool
-PacketsQueue::ComparePacketEntriesExpirationTime (const std::map<DataIdentifier, PacketQueueEntry>::value_type& entry_1,
-                                                  const std::map<DataIdentifier, PacketQueueEntry>::value_type& entry_2)
+template <typename AreaKey>
+void
+PacketsQueue::RemoveAreaGroupEntry (AreaGroups<AreaKey>& groups, const DataIdentifier& data_id)
 {
-  return entry_1.second.GetExpirationTime () < entry_2.second.GetExpirationTime ();
+  DataIdentifierMap<uint32_t>::iterator entry_it = groups.m_entry_slots.find (data_id);
+
+  if (entry_it == groups.m_entry_slots.end ()) return;
+
+  const uint32_t slot = entry_it->second;
+  const uint32_t last_slot = groups.m_keys.size () - 1u;
+
+  groups.m_entry_slots.erase (entry_it);
+  groups.m_members[slot].erase (data_id);
+
+  if (!groups.m_members[slot].empty ()) return;
+
+  groups.m_group_slots.erase (groups.m_keys[slot]);
+
+  // Move the group of the last slot to the slot of the removed group.
+  if (slot != last_slot)
+    {
+      groups.m_keys[slot] = groups.m_keys[last_slot];
+      groups.m_members[slot].swap (groups.m_members[last_slot]);
+      groups.m_group_slots.at (groups.m_keys[slot]) = slot;
+
+      for (std::set<DataIdentifier>::const_iterator member_it = groups.m_members[slot].begin ();
+              member_it != groups.m_members[slot].end (); ++member_it)
+        groups.m_entry_slots.at (*member_it) = slot;
+    }
+
+  groups.m_areas.Remove (slot);
+  groups.m_keys.pop_back ();
+  groups.m_members.pop_back ();
 }
 
 bool
@@ -267,26 +354,23 @@ PacketsQueue::Enqueue (const DataHeader& data_header, const Ipv4Address& transmi
       return false;
     }
 
-  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_max_queue_length
+  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_packets_table.GetMaxLength ()
                 << " packets before insertion.");
 
   // Check if the queue is full.
-  if (m_packets_table.size () == m_max_queue_length)
+  if (m_packets_table.IsFull ())
     {
-      ++m_packets_dropped_counter;
-
       // Find oldest entry
-      Iterator_t entry_to_delete_it = std::min_element (m_packets_table.begin (),
-                                                        m_packets_table.end (),
-                                                        ComparePacketEntriesExpirationTime);
+      const DataIdentifier packet_to_drop = m_packets_table.SelectPacketToDrop ()->first;
 
       NS_LOG_DEBUG ("Drops the oldest packet due to full queue : "
-                    << entry_to_delete_it->second);
+                    << m_packets_table.at (packet_to_drop));
 
       // Log statistics about the packet drop
-      LogPacketDropped (entry_to_delete_it->first);
+      LogPacketDropped (packet_to_drop);
 
-      m_packets_table.erase (entry_to_delete_it);
+      RemoveAreaGroupsEntry (packet_to_drop);
+      m_packets_table.DropPacket (packet_to_drop);
     }
 
   std::pair<Iterator_t, bool> inserted_result;
@@ -294,7 +378,9 @@ PacketsQueue::Enqueue (const DataHeader& data_header, const Ipv4Address& transmi
                                                             PacketQueueEntry (data_header)));
 
   NS_LOG_DEBUG ("Packet successfully inserted : " << inserted_result.first->second);
-  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_max_queue_length
+
+  InsertAreaGroupsEntry (data_header.GetDataIdentifier (), data_header);
+  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_packets_table.GetMaxLength ()
                 << " packets after insertion.");
 
   // Save statistics about the packet reception.
@@ -309,22 +395,14 @@ PacketsQueue::Purge ()
 {
   NS_LOG_FUNCTION (this);
 
-  const Time now = Simulator::Now ();
+  std::vector<DataIdentifier> purged_packets;
+  m_packets_table.Purge (Simulator::Now (), &purged_packets);
 
-  for (ConstIterator_t entry_it = m_packets_table.begin (); entry_it != m_packets_table.end ();)
+  for (std::vector<DataIdentifier>::const_iterator data_id_it = purged_packets.begin ();
+          data_id_it != purged_packets.end (); ++data_id_it)
     {
-      // If the end time of the packet is less or equal than NOW then the packet
-      // is expired.
-      if (entry_it->second.GetExpirationTime () <= now)
-        {
-          NS_LOG_LOGIC ("Drops expired data packet entry : " << entry_it->second);
-          // m_packets_table.erase (entry_it++); // For C++03
-          entry_it = m_packets_table.erase (entry_it); // For C++11
-        }
-      else
-        {
-          ++entry_it;
-        }
+      NS_LOG_LOGIC ("Drops expired data packet entry : " << *data_id_it);
+      RemoveAreaGroupsEntry (*data_id_it);
     }
 }
 
@@ -400,7 +478,7 @@ PacketsQueue::ToString () const
   std::sprintf (buffer, "%u", (uint32_t) m_packets_table.size ());
   std::string str = "Packets queue has " + std::string (buffer) + " / ";
 
-  std::sprintf (buffer, "%u", m_max_queue_length);
+  std::sprintf (buffer, "%u", m_packets_table.GetMaxLength ());
   str += std::string (buffer) + " packet entries";
 
   return str;
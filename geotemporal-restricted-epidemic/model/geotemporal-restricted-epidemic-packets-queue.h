@@ -30,12 +30,15 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <ns3/nstime.h>
 #include <ns3/simulator.h>
 
 #include <ns3/geotemporal-utils.h>
+#include <ns3/math-utils.h>
 #include <ns3/packet-utils.h>
+#include <ns3/packets-queue-core.h>
 #include <ns3/statistics-utils.h>
 
 using namespace GeoTemporalLibrary::LibraryUtils;
@@ -133,6 +136,13 @@ public:
     return m_expiration_time;
   }
 
+  /** Returns the simulation time at which the entry expires. */
+  inline const Time &
+  GetExpirationInstant () const
+  {
+    return m_expiration_time;
+  }
+
 
   void
   Print (std::ostream &os) const;
@@ -185,35 +195,67 @@ class PacketsQueue
 {
 private:
 
+  /** Data packets table. When the queue is full, the packet that expires first
+   * is dropped. */
+  typedef PacketsQueueCore<PacketQueueEntry, DropEarliestExpiration> PacketsTable_t;
+
   /** 
-   * Maximum number of packet entries that the queue can store at once.
+   * Data packets table, with the maximum number of packet entries that the
+   * queue can store at once and the counter of packets dropped due to a full
+   * queue.
    * 
    * If the queue reaches this maximum number of packet entries and a new packet
    * is stored, then the oldest packet will be dropped from the queue before 
    * inserting the new one.
    */
-  uint32_t m_max_queue_length;
-
-  /**
-   * The counter of all packets dropped due to a full queue.
-   */
-  uint32_t m_packets_dropped_counter;
-
-  /** Data packets table. */
-  std::map<DataIdentifier, PacketQueueEntry> m_packets_table;
+  PacketsTable_t m_packets_table;
 
   /** Data packets stats. */
   std::map<DataIdentifier, DataPacketReceptionStats> m_data_packet_reception_stats;
 
   /** Packets table iterator. */
-  typedef std::map<DataIdentifier, PacketQueueEntry>::iterator Iterator_t;
+  typedef PacketsTable_t::iterator Iterator_t;
 
   /** Packets table constant iterator. */
-  typedef std::map<DataIdentifier, PacketQueueEntry>::const_iterator ConstIterator_t;
+  typedef PacketsTable_t::const_iterator ConstIterator_t;
 
   /** Packet statistics iterator. */
   typedef std::map<DataIdentifier, DataPacketReceptionStats>::iterator StatsIterator_t;
 
+  /**
+   * Packet entries grouped by a shared area, so that the area of a group is 
+   * tested once for all of its entries.
+   * 
+   * Each distinct area has a slot. The areas of all slots are stored in an 
+   * <code>AreaSet</code> to be tested against a position at once. When the 
+   * last entry of a group is removed, the group of the last slot is moved to 
+   * the freed slot.
+   */
+  template <typename AreaKey>
+  struct AreaGroups
+  {
+    /** Slot of the group of each packet entry, by data identifier. */
+    DataIdentifierMap<uint32_t> m_entry_slots;
+
+    /** Slot of the group of each distinct area. */
+    std::map<AreaKey, uint32_t> m_group_slots;
+
+    /** Area of the group in each slot. */
+    std::vector<AreaKey> m_keys;
+
+    /** Geographic area of the group in each slot. */
+    AreaSet m_areas;
+
+    /** Data identifiers of the entries of the group in each slot. */
+    std::vector<std::set<DataIdentifier> > m_members;
+  };
+
+  /** Packet entries grouped by allowed area. */
+  AreaGroups<Area> m_allowed_area_groups;
+
+  /** Packet entries grouped by destination geo-temporal area. */
+  AreaGroups<GeoTemporalArea> m_destination_gta_groups;
+
 
 public:
 
@@ -249,7 +291,7 @@ public:
   inline uint32_t
   GetMaxLength () const
   {
-    return m_max_queue_length;
+    return m_packets_table.GetMaxLength ();
   }
 
   /**
@@ -265,7 +307,7 @@ public:
   inline void
   SetMaxLength (uint32_t maximum_queue_length)
   {
-    m_max_queue_length = maximum_queue_length;
+    m_packets_table.SetMaxLength (maximum_queue_length);
   }
 
   /**
@@ -274,7 +316,7 @@ public:
   inline uint32_t
   GetDroppedPacketsCounter () const
   {
-    return m_packets_dropped_counter;
+    return m_packets_table.GetDroppedPacketsCounter ();
   }
 
   /**
@@ -359,6 +401,8 @@ public:
   Clear ()
   {
     m_packets_table.clear ();
+    m_allowed_area_groups = AreaGroups<Area> ();
+    m_destination_gta_groups = AreaGroups<GeoTemporalArea> ();
   }
 
   /**
@@ -367,6 +411,10 @@ public:
    * processes the disjoint vector, that is, the set of data packet identifiers 
    * that aren't contained in the summary vector.
    * 
+   * If the summary vector is encoded as a Bloom filter, the packets that the
+   * filter may contain are considered known by the other node, so a false
+   * positive of the filter leaves a packet out of the disjoint vector.
+   * 
    * The <code>disjoint_vector</code> parameter is always emptied. And then the
    * processed data is stored into it. The <code>disjoint_vector</code> may 
    * remain empty if there's no data to insert into it.
@@ -386,18 +434,53 @@ public:
 private:
 
   /**
-   * Compares the expiration time of 2 packet queue entries and returns 
-   * <code>true</code> if <code>entry_1</code> is <i>less</i> than
-   * <code>entry_2</code>.
+   * Forwarding filter of the disjoint vector, that tests the packets in queue
+   * against the areas that contain the receiver node.
+   */
+  class DisjointVectorFilter;
+
+  /**
+   * Adds the packet entry to the group of its allowed area and to the group of
+   * its destination geo-temporal area.
    * 
-   * This comparison function object satisfies the requirements of Compare.
+   * @param data_id [IN] Data identifier of the packet entry.
+   * @param data_packet [IN] Data packet of the packet entry.
+   */
+  void
+  InsertAreaGroupsEntry (const DataIdentifier & data_id, const DataHeader & data_packet);
+
+  /**
+   * Removes the packet entry from its area groups.
    * 
-   * @return <code>true</code> if <code>entry_1</code> is <i>less</i> than
-   * <code>entry_2</code>
+   * @param data_id [IN] Data identifier of the packet entry.
    */
-  static bool
-  ComparePacketEntriesExpirationTime (const std::map<DataIdentifier, PacketQueueEntry>::value_type & entry_1,
-                                      const std::map<DataIdentifier, PacketQueueEntry>::value_type & entry_2);
+  void
+  RemoveAreaGroupsEntry (const DataIdentifier & data_id);
+
+  /**
+   * Adds the packet entry to the group of <code>key</code> in
+   * <code>groups</code>, creating the group if it doesn't exist.
+   * 
+   * @param groups [IN/OUT] Area groups to update.
+   * @param data_id [IN] Data identifier of the packet entry.
+   * @param key [IN] Area of the group.
+   * @param area [IN] Geographic area of the group.
+   */
+  template <typename AreaKey>
+  static void
+  InsertAreaGroupEntry (AreaGroups<AreaKey> & groups, const DataIdentifier & data_id,
+                        const AreaKey & key, const Area & area);
+
+  /**
+   * Removes the packet entry from its group in <code>groups</code>, removing 
+   * the group if it becomes empty.
+   * 
+   * @param groups [IN/OUT] Area groups to update.
+   * @param data_id [IN] Data identifier of the packet entry.
+   */
+  template <typename AreaKey>
+  static void
+  RemoveAreaGroupEntry (AreaGroups<AreaKey> & groups, const DataIdentifier & data_id);
 
 
 public:
@@ -422,6 +505,8 @@ public:
 
   /**
    * Removes all expired data packet entries from the data packets queue.
+   * 
+   * It only visits the entries whose expiration instant has passed.
    */
   void
   Purge ();
@@ -487,9 +572,7 @@ public:
 inline bool
 operator== (const PacketsQueue & lhs, const PacketsQueue & rhs)
 {
-  return lhs.m_max_queue_length == rhs.m_max_queue_length
-          && lhs.m_packets_dropped_counter == rhs.m_packets_dropped_counter
-          && lhs.m_packets_table == rhs.m_packets_table
+  return lhs.m_packets_table == rhs.m_packets_table
           && lhs.m_data_packet_reception_stats == rhs.m_data_packet_reception_stats;
 }
 
@@ -39,6 +39,10 @@
 #define AREA_X2 1
 #define AREA_Y2 0
 
+#define COMPACT_ENCODING 7
+#define SUMMARY_VECTOR_ENCODING_SHIFT 5
+#define SUMMARY_VECTOR_ENCODING_MASK 0x60
+
 
 namespace ns3
 {
@@ -79,13 +83,25 @@ ToString (const PacketType& obj)
 NS_OBJECT_ENSURE_REGISTERED (TypeHeader);
 
 TypeHeader::TypeHeader ()
-: m_packet_type (PacketType::Hello), m_valid (true) { }
+: m_packet_type (PacketType::Hello), m_compact_encoding (false),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit), m_valid (true) { }
 
 TypeHeader::TypeHeader (PacketType packet_type)
-: m_packet_type (packet_type), m_valid (true) { }
+: m_packet_type (packet_type), m_compact_encoding (false),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit), m_valid (true) { }
+
+TypeHeader::TypeHeader (PacketType packet_type, bool compact_encoding)
+: m_packet_type (packet_type), m_compact_encoding (compact_encoding),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit), m_valid (true) { }
+
+TypeHeader::TypeHeader (PacketType packet_type, bool compact_encoding,
+                        SummaryVectorEncoding summary_vector_encoding)
+: m_packet_type (packet_type), m_compact_encoding (compact_encoding),
+m_summary_vector_encoding (summary_vector_encoding), m_valid (true) { }
 
 TypeHeader::TypeHeader (const TypeHeader& copy)
-: m_packet_type (copy.m_packet_type), m_valid (copy.m_valid) { }
+: m_packet_type (copy.m_packet_type), m_compact_encoding (copy.m_compact_encoding),
+m_summary_vector_encoding (copy.m_summary_vector_encoding), m_valid (copy.m_valid) { }
 
 
 // --------------------------
@@ -122,7 +138,12 @@ TypeHeader::GetSerializedSize () const
 void
 TypeHeader::Serialize (Buffer::Iterator start) const
 {
-  start.WriteU8 ((uint8_t) m_packet_type);
+  uint8_t packet_type = (uint8_t) m_packet_type;
+  if (m_compact_encoding) SetBitFlag (packet_type, COMPACT_ENCODING);
+  packet_type |= ((uint8_t) m_summary_vector_encoding << SUMMARY_VECTOR_ENCODING_SHIFT)
+          & SUMMARY_VECTOR_ENCODING_MASK;
+
+  start.WriteU8 (packet_type);
 }
 
 uint32_t
@@ -132,8 +153,28 @@ TypeHeader::Deserialize (Buffer::Iterator start)
 
   uint8_t packet_type = it.ReadU8 ();
 
+  m_compact_encoding = CheckBitFlag (packet_type, COMPACT_ENCODING);
+  ClearBitFlag (packet_type, COMPACT_ENCODING);
+
+  const uint8_t summary_vector_encoding = (packet_type & SUMMARY_VECTOR_ENCODING_MASK)
+          >> SUMMARY_VECTOR_ENCODING_SHIFT;
+  packet_type &= ~SUMMARY_VECTOR_ENCODING_MASK;
+
   m_valid = true;
 
+  // The incremental encoding needs the versions of the summary vectors kept
+  // per neighbor, which this protocol doesn't keep.
+  switch (static_cast<SummaryVectorEncoding> (summary_vector_encoding))
+    {
+    case SummaryVectorEncoding::Explicit:
+    case SummaryVectorEncoding::DeltaCoded:
+    case SummaryVectorEncoding::BloomFilter:
+      m_summary_vector_encoding = static_cast<SummaryVectorEncoding> (summary_vector_encoding);
+      break;
+    default:
+      m_valid = false;
+    }
+
   switch (static_cast<PacketType> (packet_type))
     {
     case PacketType::Hello:
@@ -263,14 +304,22 @@ HelloHeader::ToString () const
 NS_OBJECT_ENSURE_REGISTERED (SummaryVectorHeader);
 
 SummaryVectorHeader::SummaryVectorHeader ()
-: m_summary_vector (), m_position () { }
+: m_summary_vector (), m_position (), m_compact_encoding (false),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit), m_bloom_filter (),
+m_bloom_filter_entries_count (0u) { }
 
 SummaryVectorHeader::SummaryVectorHeader (const std::set<DataIdentifier>& summary_vector,
                                           const GeoTemporalLibrary::LibraryUtils::Vector2D& position)
-: m_summary_vector (summary_vector), m_position (position) { }
+: m_summary_vector (summary_vector), m_position (position),
+m_compact_encoding (false), m_summary_vector_encoding (SummaryVectorEncoding::Explicit),
+m_bloom_filter (), m_bloom_filter_entries_count (0u) { }
 
 SummaryVectorHeader::SummaryVectorHeader (const SummaryVectorHeader& copy)
-: m_summary_vector (copy.m_summary_vector), m_position (copy.m_position) { }
+: m_summary_vector (copy.m_summary_vector), m_position (copy.m_position),
+m_compact_encoding (copy.m_compact_encoding),
+m_summary_vector_encoding (copy.m_summary_vector_encoding),
+m_bloom_filter (copy.m_bloom_filter),
+m_bloom_filter_entries_count (copy.m_bloom_filter_entries_count) { }
 
 
 // --------------------------
@@ -290,6 +339,9 @@ SummaryVectorHeader::GetTypeId ()
 TypeId
 SummaryVectorHeader::GetInstanceTypeId () const
 {
+  if (IsCompactEncoding ())
+    return CompactSummaryVectorHeader::GetTypeId ();
+
   return GetTypeId ();
 }
 
@@ -301,29 +353,107 @@ SummaryVectorHeader::GetInstanceTypeId () const
 uint32_t
 SummaryVectorHeader::GetSerializedSize () const
 {
-  return 19u + (m_summary_vector.size () * 6u);
+  if (m_compact_encoding)
+    return 2u + CompactCoordinatesEncoding::GetPositionSerializedSize (m_position)
+            + GetSummaryVectorSerializedSize ();
+
+  return 19u + GetSummaryVectorSerializedSize ();
 }
 
 void
 SummaryVectorHeader::Serialize (Buffer::Iterator start) const
 {
-  uint8_t sign_flags = 0u;
+  if (m_compact_encoding)
+    {
+      start.WriteHtonU16 (GetSummaryVectorSize ());
+      CompactCoordinatesEncoding::WritePosition (start, m_position);
+    }
+  else
+    {
+      uint8_t sign_flags = 0u;
 
-  uint32_t x_int, x_float;
-  EncodeDoubleToIntegers (m_position.m_x, x_int, x_float,
-                          sign_flags, COORDINATE_X);
+      uint32_t x_int, x_float;
+      EncodeDoubleToIntegers (m_position.m_x, x_int, x_float,
+                              sign_flags, COORDINATE_X);
 
-  uint32_t y_int, y_float;
-  EncodeDoubleToIntegers (m_position.m_y, y_int, y_float,
-                          sign_flags, COORDINATE_Y);
+      uint32_t y_int, y_float;
+      EncodeDoubleToIntegers (m_position.m_y, y_int, y_float,
+                              sign_flags, COORDINATE_Y);
 
-  start.WriteU8 (sign_flags);
-  start.WriteHtonU16 (m_summary_vector.size ());
+      start.WriteU8 (sign_flags);
+      start.WriteHtonU16 (GetSummaryVectorSize ());
 
-  start.WriteHtonU32 (x_int);
-  start.WriteHtonU32 (x_float);
-  start.WriteHtonU32 (y_int);
-  start.WriteHtonU32 (y_float);
+      start.WriteHtonU32 (x_int);
+      start.WriteHtonU32 (x_float);
+      start.WriteHtonU32 (y_int);
+      start.WriteHtonU32 (y_float);
+    }
+
+  SerializeSummaryVector (start);
+}
+
+uint32_t
+SummaryVectorHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator it = start;
+
+  uint16_t summary_vector_size;
+
+  if (m_compact_encoding)
+    {
+      summary_vector_size = it.ReadNtohU16 ();
+      m_position = CompactCoordinatesEncoding::ReadPosition (it);
+    }
+  else
+    {
+      const uint8_t sign_flags = it.ReadU8 ();
+      summary_vector_size = it.ReadNtohU16 ();
+
+      uint32_t int_part = it.ReadNtohU32 ();
+      uint32_t float_part = it.ReadNtohU32 ();
+      m_position.m_x = DecodeDoubleFromIntegers (int_part, float_part,
+                                                 sign_flags, COORDINATE_X);
+
+      int_part = it.ReadNtohU32 ();
+      float_part = it.ReadNtohU32 ();
+      m_position.m_y = DecodeDoubleFromIntegers (int_part, float_part,
+                                                 sign_flags, COORDINATE_Y);
+    }
+
+  DeserializeSummaryVector (it, summary_vector_size);
+
+  uint32_t distance = it.GetDistanceFrom (start);
+  NS_ASSERT (distance == GetSerializedSize ());
+  return distance;
+}
+
+uint32_t
+SummaryVectorHeader::GetSummaryVectorSerializedSize () const
+{
+  switch (m_summary_vector_encoding)
+    {
+    case SummaryVectorEncoding::DeltaCoded:
+      return GetDeltaCodedSerializedSize (m_summary_vector);
+    case SummaryVectorEncoding::BloomFilter:
+      return m_bloom_filter.GetSerializedSize ();
+    default:
+      return m_summary_vector.size () * 6u;
+    }
+}
+
+void
+SummaryVectorHeader::SerializeSummaryVector (Buffer::Iterator& start) const
+{
+  if (m_summary_vector_encoding == SummaryVectorEncoding::DeltaCoded)
+    {
+      WriteDeltaCoded (start, m_summary_vector);
+      return;
+    }
+  else if (m_summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+    {
+      m_bloom_filter.Serialize (start);
+      return;
+    }
 
   bool odd = true;
   for (std::set<DataIdentifier>::const_iterator it = m_summary_vector.begin ();
@@ -343,23 +473,22 @@ SummaryVectorHeader::Serialize (Buffer::Iterator start) const
     }
 }
 
-uint32_t
-SummaryVectorHeader::Deserialize (Buffer::Iterator start)
+void
+SummaryVectorHeader::DeserializeSummaryVector (Buffer::Iterator& it,
+                                               uint16_t summary_vector_size)
 {
-  Buffer::Iterator it = start;
-
-  const uint8_t sign_flags = it.ReadU8 ();
-  const uint16_t summary_vector_size = it.ReadNtohU16 ();
-
-  uint32_t int_part = it.ReadNtohU32 ();
-  uint32_t float_part = it.ReadNtohU32 ();
-  m_position.m_x = DecodeDoubleFromIntegers (int_part, float_part,
-                                             sign_flags, COORDINATE_X);
-
-  int_part = it.ReadNtohU32 ();
-  float_part = it.ReadNtohU32 ();
-  m_position.m_y = DecodeDoubleFromIntegers (int_part, float_part,
-                                             sign_flags, COORDINATE_Y);
+  if (m_summary_vector_encoding == SummaryVectorEncoding::DeltaCoded)
+    {
+      ReadDeltaCoded (it, m_summary_vector);
+      return;
+    }
+  else if (m_summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+    {
+      m_summary_vector = std::set<DataIdentifier> ();
+      m_bloom_filter.Deserialize (it);
+      m_bloom_filter_entries_count = summary_vector_size;
+      return;
+    }
 
   m_summary_vector = std::set<DataIdentifier> ();
   Ipv4Address ip;
@@ -382,10 +511,6 @@ SummaryVectorHeader::Deserialize (Buffer::Iterator start)
       odd = !odd;
       m_summary_vector.insert (DataIdentifier (ip, id));
     }
-
-  uint32_t distance = it.GetDistanceFrom (start);
-  NS_ASSERT (distance == GetSerializedSize ());
-  return distance;
 }
 
 void
@@ -413,6 +538,34 @@ SummaryVectorHeader::ToString () const
 }
 
 
+// =============================================================================
+//                         CompactSummaryVectorHeader
+// =============================================================================
+
+NS_OBJECT_ENSURE_REGISTERED (CompactSummaryVectorHeader);
+
+CompactSummaryVectorHeader::CompactSummaryVectorHeader ()
+: SummaryVectorHeader ()
+{
+  SetCompactEncoding (true);
+}
+
+
+// --------------------------
+// Type ID
+// --------------------------
+
+TypeId
+CompactSummaryVectorHeader::GetTypeId ()
+{
+  static TypeId type_id = TypeId ("ns3::geotemporal_restricted_epidemic::CompactSummaryVectorHeader")
+          .SetParent<SummaryVectorHeader> ()
+          .SetGroupName ("Geotemporal-restricted-epidemic")
+          .AddConstructor<CompactSummaryVectorHeader> ();
+  return type_id;
+}
+
+
 // =============================================================================
 //                                  DataHeader
 // =============================================================================
@@ -421,7 +574,7 @@ NS_OBJECT_ENSURE_REGISTERED (DataHeader);
 
 DataHeader::DataHeader ()
 : m_data_id (), m_creation_coordinates (), m_dest_geo_temporal_area (), m_message (),
-m_hops_counter (0u) { }
+m_hops_counter (0u), m_compact_encoding (false) { }
 
 DataHeader::DataHeader (const DataIdentifier& data_id,
                         const GeoTemporalLibrary::LibraryUtils::Vector2D& creation_coordinates,
@@ -430,12 +583,13 @@ DataHeader::DataHeader (const DataIdentifier& data_id,
                         const uint32_t& hops_count)
 : m_data_id (data_id), m_creation_coordinates (creation_coordinates),
 m_dest_geo_temporal_area (destination_geo_temporal_area),
-m_message (message), m_hops_counter (hops_count) { }
+m_message (message), m_hops_counter (hops_count), m_compact_encoding (false) { }
 
 DataHeader::DataHeader (const DataHeader& copy)
 : m_data_id (copy.m_data_id), m_creation_coordinates (copy.m_creation_coordinates),
 m_dest_geo_temporal_area (copy.m_dest_geo_temporal_area),
-m_message (copy.m_message), m_hops_counter (copy.m_hops_counter) { }
+m_message (copy.m_message), m_hops_counter (copy.m_hops_counter),
+m_compact_encoding (copy.m_compact_encoding) { }
 
 
 // --------------------------
@@ -471,6 +625,9 @@ DataHeader::GetTypeId ()
 TypeId
 DataHeader::GetInstanceTypeId () const
 {
+  if (IsCompactEncoding ())
+    return CompactDataHeader::GetTypeId ();
+
   return GetTypeId ();
 }
 
@@ -482,12 +639,38 @@ DataHeader::GetInstanceTypeId () const
 uint32_t
 DataHeader::GetSerializedSize () const
 {
-  return 64u + m_message.length (); // 1 byte is because of the null terminator of the message.
+  if (m_compact_encoding)
+    {
+      // 6 bytes of DATA ID, 4 bytes of temporal scope and 1 byte of the null
+      // terminator of the message.
+      return 11u + GetVarIntSerializedSize (m_hops_counter)
+              + CompactCoordinatesEncoding::GetPositionSerializedSize (m_creation_coordinates)
+              + CompactCoordinatesEncoding::GetAreaSerializedSize (m_dest_geo_temporal_area.GetArea ())
+              + m_message.Size ();
+    }
+
+  return 64u + m_message.Size (); // 1 byte is because of the null terminator of the message.
 }
 
 void
 DataHeader::Serialize (Buffer::Iterator start) const
 {
+  if (m_compact_encoding)
+    {
+      start.WriteHtonU16 (m_data_id.GetSourceId ());
+      WriteTo (start, m_data_id.GetSourceIp ());
+
+      WriteVarInt (start, m_hops_counter);
+      CompactCoordinatesEncoding::WritePosition (start, m_creation_coordinates);
+      CompactCoordinatesEncoding::WriteArea (start, m_dest_geo_temporal_area.GetArea ());
+
+      start.WriteHtonU16 ((uint32_t) m_dest_geo_temporal_area.GetTimePeriod ().GetStartTime ().GetSeconds ());
+      start.WriteHtonU16 ((uint32_t) m_dest_geo_temporal_area.GetDuration ().GetSeconds ());
+
+      m_message.Write (start);
+      return;
+    }
+
   uint8_t sign_flags = 0u;
 
   uint32_t x_int, x_float;
@@ -542,9 +725,7 @@ DataHeader::Serialize (Buffer::Iterator start) const
   start.WriteHtonU16 ((uint32_t) m_dest_geo_temporal_area.GetTimePeriod ().GetStartTime ().GetSeconds ());
   start.WriteHtonU16 ((uint32_t) m_dest_geo_temporal_area.GetDuration ().GetSeconds ());
 
-  char chars_buffer [m_message.length () + 1u];
-  std::strcpy (chars_buffer, m_message.c_str ());
-  start.Write ((uint8_t *) chars_buffer, std::strlen (chars_buffer) + 1u);
+  m_message.Write (start);
 }
 
 uint32_t
@@ -552,6 +733,34 @@ DataHeader::Deserialize (Buffer::Iterator start)
 {
   Buffer::Iterator it = start;
 
+  if (m_compact_encoding)
+    {
+      // Read DATA packet ID
+      const uint16_t data_source_id = it.ReadNtohU16 ();
+      Ipv4Address data_source_ip;
+      ReadFrom (it, data_source_ip);
+
+      m_data_id = DataIdentifier (data_source_ip, data_source_id);
+
+      m_hops_counter = (uint32_t) ReadVarInt (it);
+      m_creation_coordinates = CompactCoordinatesEncoding::ReadPosition (it);
+      const Area area = CompactCoordinatesEncoding::ReadArea (it);
+
+      // Read temporal scope's start time and duration. Then calculate end time.
+      Time start_time = Seconds (it.ReadNtohU16 ());
+      Time duration = Seconds (it.ReadNtohU16 ());
+      Time end_time = TimePeriod::CalculateEndTime (start_time, duration);
+
+      m_dest_geo_temporal_area = GeoTemporalArea (TimePeriod (start_time, end_time), area);
+
+      // Read the string message (including its null terminator character).
+      m_message.Read (it);
+
+      uint32_t distance = it.GetDistanceFrom (start);
+      NS_ASSERT (distance == GetSerializedSize ());
+      return distance;
+    }
+
   const uint8_t sign_flags = it.ReadU8 ();
 
   // Read DATA packet ID
@@ -599,27 +808,8 @@ DataHeader::Deserialize (Buffer::Iterator start)
   m_dest_geo_temporal_area = GeoTemporalArea (TimePeriod (start_time, end_time),
                                               Area (area_x1, area_y1, area_x2, area_y2));
 
-  // Read the string message.
-  uint8_t character_read = 0u;
-  uint32_t message_size = 0u;
-  Buffer::Iterator temporal_it = it;
-
-  // Find the size/length of the message by counting the number of characters 
-  // before the null terminator character is found. The null terminator character
-  // is also counted.
-  do
-    {
-      character_read = temporal_it.ReadU8 ();
-      ++message_size;
-    }
-  while (character_read != 0u);
-
-  // Read the message-size characters from the iterator-buffer.
-  char message_buffer [message_size];
-  it.Read ((uint8_t *) message_buffer, message_size);
-
-  // Store the message in a C++ std::string.
-  m_message = std::string (message_buffer);
+  // Read the string message (including its null terminator character).
+  m_message.Read (it);
 
   uint32_t distance = it.GetDistanceFrom (start);
   NS_ASSERT (distance == GetSerializedSize ());
@@ -648,12 +838,40 @@ DataHeader::ToString () const
   std::sprintf (buffer, "%04.2f", m_dest_geo_temporal_area.GetDuration ().GetSeconds ());
   str += " with a duration of " + std::string (buffer) + " seconds";
 
-  std::sprintf (buffer, "%u", (uint32_t) m_message.size ());
+  std::sprintf (buffer, "%u", m_message.Size ());
   str += " has a message of " + std::string (buffer) + " byte(s)";
   return str;
 }
 
 
+// =============================================================================
+//                              CompactDataHeader
+// =============================================================================
+
+NS_OBJECT_ENSURE_REGISTERED (CompactDataHeader);
+
+CompactDataHeader::CompactDataHeader ()
+: DataHeader ()
+{
+  SetCompactEncoding (true);
+}
+
+
+// --------------------------
+// Type ID
+// --------------------------
+
+TypeId
+CompactDataHeader::GetTypeId ()
+{
+  static TypeId type_id = TypeId ("ns3::geotemporal_restricted_epidemic::CompactDataHeader")
+          .SetParent<DataHeader> ()
+          .SetGroupName ("Geotemporal-restricted-epidemic")
+          .AddConstructor<CompactDataHeader> ();
+  return type_id;
+}
+
+
 } // namespace geotemporal_restricted_epidemic
 } // namespace ns3
 
@@ -104,6 +104,12 @@ operator<< (std::ostream & os, const PacketType & obj)
  * 
  * Header that contains the type of the Geo-Temporal Restricted Epidemic 
  * protocol packets.
+ * 
+ * The most significant bit of the type byte indicates that the headers that
+ * follow carry their coordinates with the compact encoding (see
+ * <code>CompactCoordinatesEncoding</code>) instead of the fixed-size one. The
+ * next 2 bits contain the <code>SummaryVectorEncoding</code> of REPLY and 
+ * REPLY_BACK packets.
  */
 class TypeHeader : public Header
 {
@@ -111,6 +117,12 @@ private:
 
   PacketType m_packet_type;
 
+  /** Indicates if the packet headers use the compact coordinates encoding. */
+  bool m_compact_encoding;
+
+  /** Encoding of the summary vector (only in REPLY and REPLY_BACK packets). */
+  SummaryVectorEncoding m_summary_vector_encoding;
+
   bool m_valid;
 
 public:
@@ -119,6 +131,11 @@ public:
 
   TypeHeader (PacketType packet_type);
 
+  TypeHeader (PacketType packet_type, bool compact_encoding);
+
+  TypeHeader (PacketType packet_type, bool compact_encoding,
+              SummaryVectorEncoding summary_vector_encoding);
+
   TypeHeader (const TypeHeader & copy);
 
 
@@ -138,6 +155,30 @@ public:
     m_packet_type = type;
   }
 
+  inline bool
+  IsCompactEncoding () const
+  {
+    return m_compact_encoding;
+  }
+
+  inline void
+  SetCompactEncoding (bool compact_encoding)
+  {
+    m_compact_encoding = compact_encoding;
+  }
+
+  inline SummaryVectorEncoding
+  GetSummaryVectorEncoding () const
+  {
+    return m_summary_vector_encoding;
+  }
+
+  inline void
+  SetSummaryVectorEncoding (SummaryVectorEncoding summary_vector_encoding)
+  {
+    m_summary_vector_encoding = summary_vector_encoding;
+  }
+
   inline bool
   IsValid () const
   {
@@ -187,7 +228,10 @@ public:
 inline bool
 operator== (const TypeHeader & lhs, const TypeHeader & rhs)
 {
-  return lhs.m_packet_type == rhs.m_packet_type && lhs.m_valid == rhs.m_valid;
+  return lhs.m_packet_type == rhs.m_packet_type
+          && lhs.m_compact_encoding == rhs.m_compact_encoding
+          && lhs.m_summary_vector_encoding == rhs.m_summary_vector_encoding
+          && lhs.m_valid == rhs.m_valid;
 }
 
 inline bool
@@ -377,6 +421,16 @@ operator<< (std::ostream & os, const HelloHeader & obj)
   [1] = If the DATA ID index is odd.
   [2] = If the DATA ID index is even.
   \endverbatim
+ * 
+ * With the compact coordinates encoding, the flags are omitted and the position
+ * is written as variable-length fixed-point integers (see 
+ * <code>CompactCoordinatesEncoding</code>) right after the size of the summary
+ * vector.
+ * 
+ * The list of data identifiers is replaced by the delta-coded list or the Bloom
+ * filter according to the <code>SummaryVectorEncoding</code> of the header.
+ * With a Bloom filter, the size field contains the number of identifiers 
+ * inserted in the filter.
  */
 class SummaryVectorHeader : public Header
 {
@@ -388,6 +442,30 @@ private:
   /** Geographic position of the packet sender node. */
   GeoTemporalLibrary::LibraryUtils::Vector2D m_position;
 
+  /** Indicates if the header uses the compact coordinates encoding. */
+  bool m_compact_encoding;
+
+  /** Encoding of the summary vector. */
+  SummaryVectorEncoding m_summary_vector_encoding;
+
+  /** Bloom filter of the summary vector (only with the Bloom filter encoding). */
+  DataIdentifierBloomFilter m_bloom_filter;
+
+  /** Number of identifiers inserted in the Bloom filter. */
+  uint16_t m_bloom_filter_entries_count;
+
+  /** Returns the size (in bytes) of the encoded identifiers of the summary vector. */
+  uint32_t
+  GetSummaryVectorSerializedSize () const;
+
+  /** Writes the identifiers of the summary vector. */
+  void
+  SerializeSummaryVector (Buffer::Iterator & start) const;
+
+  /** Reads <code>summary_vector_size</code> identifiers of the summary vector. */
+  void
+  DeserializeSummaryVector (Buffer::Iterator & it, uint16_t summary_vector_size);
+
 
 public:
 
@@ -403,9 +481,16 @@ public:
   // Getters & Setters
   // --------------------------
 
+  /**
+   * Returns the number of data identifiers of the summary vector. With the 
+   * Bloom filter encoding it is the number of identifiers in the filter.
+   */
   inline uint32_t
   GetSummaryVectorSize () const
   {
+    if (m_summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+      return m_bloom_filter_entries_count;
+
     return m_summary_vector.size ();
   }
 
@@ -433,6 +518,55 @@ public:
     m_position = position;
   }
 
+  /**
+   * Sets if this header is serialized and deserialized with the compact
+   * coordinates encoding. The default is the fixed-size encoding.
+   */
+  inline void
+  SetCompactEncoding (bool compact_encoding)
+  {
+    m_compact_encoding = compact_encoding;
+  }
+
+  inline bool
+  IsCompactEncoding () const
+  {
+    return m_compact_encoding;
+  }
+
+  inline SummaryVectorEncoding
+  GetSummaryVectorEncoding () const
+  {
+    return m_summary_vector_encoding;
+  }
+
+  /**
+   * Sets the encoding used to serialize and deserialize the summary vector. 
+   * The default is <code>SummaryVectorEncoding::Explicit</code>.
+   */
+  inline void
+  SetSummaryVectorEncoding (SummaryVectorEncoding summary_vector_encoding)
+  {
+    m_summary_vector_encoding = summary_vector_encoding;
+  }
+
+  inline const DataIdentifierBloomFilter &
+  GetBloomFilter () const
+  {
+    return m_bloom_filter;
+  }
+
+  /**
+   * Sets the Bloom filter of the summary vector that is transmitted with the
+   * Bloom filter encoding, and the number of identifiers inserted in it.
+   */
+  inline void
+  SetBloomFilter (const DataIdentifierBloomFilter & bloom_filter, uint16_t entries_count)
+  {
+    m_bloom_filter = bloom_filter;
+    m_bloom_filter_entries_count = entries_count;
+  }
+
 
   // --------------------------
   // Type ID
@@ -477,7 +611,10 @@ inline bool
 operator== (const SummaryVectorHeader & lhs, const SummaryVectorHeader & rhs)
 {
   return lhs.m_summary_vector == rhs.m_summary_vector
-          && lhs.m_position == rhs.m_position;
+          && lhs.m_position == rhs.m_position
+          && lhs.m_summary_vector_encoding == rhs.m_summary_vector_encoding
+          && lhs.m_bloom_filter == rhs.m_bloom_filter
+          && lhs.m_bloom_filter_entries_count == rhs.m_bloom_filter_entries_count;
 }
 
 inline bool
@@ -496,6 +633,36 @@ operator<< (std::ostream & os, const SummaryVectorHeader & obj)
 }
 
 
+// =============================================================================
+//                         CompactSummaryVectorHeader
+// =============================================================================
+
+/**
+ * \ingroup geotemporal-restricted-epidemic
+ * 
+ * SUMMARY VECTOR packet header with the compact coordinates encoding.
+ * 
+ * <code>SummaryVectorHeader::GetInstanceTypeId</code> returns the type ID of
+ * this class when the compact encoding is set, so the packet metadata (that
+ * recreates the headers with their default constructor) deserializes and
+ * prints compact headers correctly.
+ */
+class CompactSummaryVectorHeader : public SummaryVectorHeader
+{
+public:
+
+  CompactSummaryVectorHeader ();
+
+
+  // --------------------------
+  // Type ID
+  // --------------------------
+
+  static TypeId
+  GetTypeId ();
+};
+
+
 // =============================================================================
 //                                  DataHeader
 // =============================================================================
@@ -544,6 +711,11 @@ operator<< (std::ostream & os, const SummaryVectorHeader & obj)
   |                  Message (maximum 1024 bytes)                 |
   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
   \endverbatim
+ * 
+ * With the compact coordinates encoding, the flags are omitted and the hops count, creation
+ * coordinates
+ * and destination area are written as variable-length (fixed-point) integers.
+ * The rest of the fields keep their layout.
  */
 class DataHeader : public Header
 {
@@ -562,7 +734,7 @@ private:
   GeoTemporalArea m_dest_geo_temporal_area;
 
   /** Message to transmit (in bytes). Recommended maximum 1024 bytes. */
-  std::string m_message;
+  SharedMessage m_message;
 
   /**
    * Indicates the maximum number of times the packet is flooded before being
@@ -574,6 +746,9 @@ private:
    */
   uint32_t m_hops_counter;
 
+  /** Indicates if the header uses the compact coordinates encoding. */
+  bool m_compact_encoding;
+
 public:
 
   DataHeader ();
@@ -629,13 +804,29 @@ public:
   inline const std::string &
   GetMessage () const
   {
-    return m_message;
+    return m_message.Get ();
   }
 
   inline void
   SetMessage (const std::string & message)
   {
-    m_message = message;
+    m_message = SharedMessage (message);
+  }
+
+  /**
+   * Sets if this header is serialized and deserialized with the compact
+   * coordinates encoding. The default is the fixed-size encoding.
+   */
+  inline void
+  SetCompactEncoding (bool compact_encoding)
+  {
+    m_compact_encoding = compact_encoding;
+  }
+
+  inline bool
+  IsCompactEncoding () const
+  {
+    return m_compact_encoding;
   }
 
   inline uint32_t
@@ -725,6 +916,36 @@ operator<< (std::ostream & os, const DataHeader & obj)
 }
 
 
+// =============================================================================
+//                              CompactDataHeader
+// =============================================================================
+
+/**
+ * \ingroup geotemporal-restricted-epidemic
+ * 
+ * DATA packet header with the compact coordinates encoding.
+ * 
+ * <code>DataHeader::GetInstanceTypeId</code> returns the type ID of
+ * this class when the compact encoding is set, so the packet metadata (that
+ * recreates the headers with their default constructor) deserializes and
+ * prints compact headers correctly.
+ */
+class CompactDataHeader : public DataHeader
+{
+public:
+
+  CompactDataHeader ();
+
+
+  // --------------------------
+  // Type ID
+  // --------------------------
+
+  static TypeId
+  GetTypeId ();
+};
+
+
 } // namespace geotemporal_restricted_epidemic
 } // namespace ns3
 
@@ -28,6 +28,8 @@
 
 #include <ns3/address.h>
 #include <ns3/boolean.h>
+#include <ns3/double.h>
+#include <ns3/enum.h>
 #include <ns3/ipv4-l3-protocol.h>
 #include <ns3/log.h>
 #include <ns3/mobility-model.h>
@@ -58,6 +60,9 @@ m_hello_timer (Timer::CANCEL_ON_DESTROY),
 m_packets_queue_capacity (128u),
 m_neighbor_expiration_time (Seconds (10)),
 m_default_packets_hops_count (8u),
+m_compact_header_encoding (false),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit),
+m_summary_vector_false_positive_rate (0.01),
 m_node_id (-1),
 m_ipv4 (0),
 m_selected_interface_index (-1),
@@ -103,6 +108,20 @@ RoutingProtocol::GetTypeId ()
                          UintegerValue (8),
                          MakeUintegerAccessor (&RoutingProtocol::m_default_packets_hops_count),
                          MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("CompactHeaderEncoding", "Transmit positions and areas with the compact (fixed-point, variable-length) encoding.",
+                         BooleanValue (false),
+                         MakeBooleanAccessor (&RoutingProtocol::m_compact_header_encoding),
+                         MakeBooleanChecker ())
+          .AddAttribute ("SummaryVectorEncoding", "Encoding of the summary vectors of the transmitted REPLY and REPLY_BACK packets.",
+                         EnumValue ((int) SummaryVectorEncoding::Explicit),
+                         MakeEnumAccessor (&RoutingProtocol::SetSummaryVectorEncoding),
+                         MakeEnumChecker ((int) SummaryVectorEncoding::Explicit, "Explicit",
+                                          (int) SummaryVectorEncoding::DeltaCoded, "DeltaCoded",
+                                          (int) SummaryVectorEncoding::BloomFilter, "BloomFilter"))
+          .AddAttribute ("SummaryVectorFalsePositiveRate", "False positive rate of the Bloom filters of the transmitted summary vectors.",
+                         DoubleValue (0.01),
+                         MakeDoubleAccessor (&RoutingProtocol::m_summary_vector_false_positive_rate),
+                         MakeDoubleChecker<double> (0.0001, 0.5))
           .AddAttribute ("UniformRv", "Access to the underlying UniformRandomVariable",
                          StringValue ("ns3::UniformRandomVariable"),
                          MakePointerAccessor (&RoutingProtocol::m_uniform_random_variable),
@@ -653,6 +672,8 @@ RoutingProtocol::RecvRestrictedEpidemicPacket (Ptr<Socket> socket)
 
   NS_ASSERT (type_header.IsValid ());
 
+  const bool compact_encoding = type_header.IsCompactEncoding ();
+
   NS_LOG_DEBUG ("Restricted Epidemic " << type_header << " packet received from node "
                 << sender_node_ip);
 
@@ -665,13 +686,15 @@ RoutingProtocol::RecvRestrictedEpidemicPacket (Ptr<Socket> socket)
       RecvHelloPacket (received_packet, sender_node_ip);
       return;
     case PacketType::Reply:
-      RecvSummaryVectorPacket (received_packet, sender_node_ip, PacketType::Reply);
+      RecvSummaryVectorPacket (received_packet, sender_node_ip, PacketType::Reply,
+                               compact_encoding, type_header.GetSummaryVectorEncoding ());
       return;
     case PacketType::ReplyBack:
-      RecvSummaryVectorPacket (received_packet, sender_node_ip, PacketType::ReplyBack);
+      RecvSummaryVectorPacket (received_packet, sender_node_ip, PacketType::ReplyBack,
+                               compact_encoding, type_header.GetSummaryVectorEncoding ());
       return;
     case PacketType::Data:
-      RecvDataPacket (received_packet, sender_node_ip);
+      RecvDataPacket (received_packet, sender_node_ip, compact_encoding);
       return;
     default:
       NS_ABORT_MSG ("ERROR: Unknown packet type.");
@@ -722,9 +745,12 @@ RoutingProtocol::RecvHelloPacket (Ptr<Packet> received_packet, const Ipv4Address
 void
 RoutingProtocol::RecvSummaryVectorPacket (Ptr<Packet> received_packet,
                                           const Ipv4Address& sender_node_ip,
-                                          const PacketType& reply_type)
+                                          const PacketType& reply_type,
+                                          bool compact_encoding,
+                                          SummaryVectorEncoding summary_vector_encoding)
 {
-  NS_LOG_FUNCTION (this << received_packet << sender_node_ip << reply_type);
+  NS_LOG_FUNCTION (this << received_packet << sender_node_ip << reply_type << compact_encoding
+                   << summary_vector_encoding);
 
   if (reply_type != PacketType::Reply && reply_type != PacketType::ReplyBack)
     NS_ABORT_MSG ("Packet type must be Reply or ReplyBack.");
@@ -732,6 +758,8 @@ RoutingProtocol::RecvSummaryVectorPacket (Ptr<Packet> received_packet,
   NS_LOG_DEBUG ("Processing " << reply_type << " packet received from " << sender_node_ip);
 
   SummaryVectorHeader summary_vector_header;
+  summary_vector_header.SetCompactEncoding (compact_encoding);
+  summary_vector_header.SetSummaryVectorEncoding (summary_vector_encoding);
   received_packet->RemoveHeader (summary_vector_header);
 
   NS_LOG_DEBUG ("Process summary vector with " << summary_vector_header.GetSummaryVectorSize ()
@@ -748,11 +776,13 @@ RoutingProtocol::RecvSummaryVectorPacket (Ptr<Packet> received_packet,
 }
 
 void
-RoutingProtocol::RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip)
+RoutingProtocol::RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip,
+                                 bool compact_encoding)
 {
-  NS_LOG_FUNCTION (this << received_packet << sender_node_ip);
+  NS_LOG_FUNCTION (this << received_packet << sender_node_ip << compact_encoding);
 
   DataHeader data_header;
+  data_header.SetCompactEncoding (compact_encoding);
   received_packet->RemoveHeader (data_header);
   NS_LOG_DEBUG ("Received DATA packet <" << data_header << "> from node " << sender_node_ip);
 
@@ -925,12 +955,24 @@ RoutingProtocol::SendSummaryVectorPacket (const Ipv4Address& destination_node,
 
   SummaryVectorHeader summary_vector_header (/*Summary vector*/ known_packets_vector,
                                              /*Position*/ my_position);
+  summary_vector_header.SetSummaryVectorEncoding (m_summary_vector_encoding);
+
+  if (m_summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+    {
+      summary_vector_header.SetBloomFilter (DataIdentifierBloomFilter (known_packets_vector,
+                                                                       m_summary_vector_false_positive_rate),
+                                            known_packets_vector.size ());
+    }
+
   NS_LOG_DEBUG ("Constructed SUMMARY VECTOR (" << reply_type << ") packet: "
                 << summary_vector_header);
 
+  summary_vector_header.SetCompactEncoding (m_compact_header_encoding);
+
   Ptr<Packet> packet_to_send = Create<Packet> ();
   packet_to_send->AddHeader (summary_vector_header);
-  packet_to_send->AddHeader (TypeHeader (reply_type));
+  packet_to_send->AddHeader (TypeHeader (reply_type, m_compact_header_encoding,
+                                         m_summary_vector_encoding));
 
   // Transmit the packet
   if (SendUnicastPacket (packet_to_send, destination_node))
@@ -1010,9 +1052,12 @@ RoutingProtocol::SendDataPacket (const Ipv4Address destination_ip,
 {
   NS_LOG_FUNCTION (this << destination_ip << data_to_send);
 
+  DataHeader data_header (data_to_send);
+  data_header.SetCompactEncoding (m_compact_header_encoding);
+
   Ptr<Packet> packet_to_send = Create<Packet> ();
-  packet_to_send->AddHeader (data_to_send);
-  packet_to_send->AddHeader (TypeHeader (PacketType::Data));
+  packet_to_send->AddHeader (data_header);
+  packet_to_send->AddHeader (TypeHeader (PacketType::Data, m_compact_header_encoding));
 
   // Transmit the packet
   if (SendUnicastPacket (packet_to_send, destination_ip))
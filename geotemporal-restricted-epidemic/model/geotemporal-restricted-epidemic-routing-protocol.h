@@ -92,6 +92,19 @@ private:
   /** Maximum number of hops that the data packets are flooded before being discarded. */
   uint32_t m_default_packets_hops_count;
 
+  /**
+   * Indicates if the transmitted packets use the compact coordinates encoding
+   * for positions and areas. Received packets are decoded according to the
+   * flag in their type header regardless of this value.
+   */
+  bool m_compact_header_encoding;
+
+  /** Encoding of the summary vectors of the transmitted REPLY and REPLY_BACK packets. */
+  SummaryVectorEncoding m_summary_vector_encoding;
+
+  /** False positive rate of the Bloom filters of the transmitted summary vectors. */
+  double m_summary_vector_false_positive_rate;
+
 
   // ---------------------
   // Internal variables
@@ -214,6 +227,22 @@ public:
     m_node_id = node_id;
   }
 
+  inline SummaryVectorEncoding
+  GetSummaryVectorEncoding () const
+  {
+    return m_summary_vector_encoding;
+  }
+
+  /**
+   * Sets the encoding of the summary vectors of the transmitted REPLY and REPLY_BACK packets.
+   * It takes an integer to be used as the setter of the enum attribute.
+   */
+  inline void
+  SetSummaryVectorEncoding (int summary_vector_encoding)
+  {
+    m_summary_vector_encoding = static_cast<SummaryVectorEncoding> (summary_vector_encoding);
+  }
+
   /** Returns the statistics of all received data packets by the node. */
   inline const std::map<DataIdentifier, DataPacketReceptionStats> &
   GetNodePacketReceptionStats () const
@@ -327,11 +356,16 @@ private:
    * @param sender_node_ip [IN] IP address of the node that sent the packet.
    * @param packet_type [IN] To indicate if the received packet is a REPLY packet
    * or a REPLY_BACK packet. With other packet types it throws a fatal error.
+   * @param compact_encoding [IN] Indicates if the received header uses the
+   * compact coordinates encoding.
+   * @param summary_vector_encoding [IN] Encoding of the received summary vector.
    */
   void
   RecvSummaryVectorPacket (Ptr<Packet> received_packet,
                            const Ipv4Address & sender_node_ip,
-                           const PacketType & reply_type);
+                           const PacketType & reply_type,
+                           bool compact_encoding,
+                           SummaryVectorEncoding summary_vector_encoding);
 
   /**
    * Processes the received DATA packets.
@@ -340,9 +374,12 @@ private:
    * top. The packet is modified, so if you want to conserve the original make
    * sure to use a copy of the received packet.
    * @param sender_node_ip [IN] IP address of the node that sent the packet.
+   * @param compact_encoding [IN] Indicates if the received header uses the
+   * compact coordinates encoding.
    */
   void
-  RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip);
+  RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip,
+                  bool compact_encoding);
 
 
 
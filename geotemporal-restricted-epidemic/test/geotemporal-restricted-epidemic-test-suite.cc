@@ -233,6 +233,79 @@ public:
     NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
   }
 
+  void
+  TestCompactEncodingFlag ()
+  {
+    TypeHeader h1 (PacketType::Data, true);
+    NS_TEST_EXPECT_MSG_EQ (h1.IsCompactEncoding (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 1u, "Must be 1u");
+
+    TypeHeader h2 (PacketType::Data);
+    NS_TEST_EXPECT_MSG_EQ (h2.IsCompactEncoding (), false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ ((h1 == h2), false, "Must be different");
+
+    h2.SetCompactEncoding (true);
+    NS_TEST_EXPECT_MSG_EQ (h1, h2, "Must be equal");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (TypeHeader (PacketType::Hello));
+    packet->AddHeader (h1);
+
+    TypeHeader deserialized;
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetPacketType (), PacketType::Data, "Must be Data");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsCompactEncoding (), true, "Must be true");
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetPacketType (), PacketType::Hello, "Must be Hello");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsCompactEncoding (), false, "Must be false");
+  }
+
+  void
+  TestSummaryVectorEncoding ()
+  {
+    TypeHeader h1 (PacketType::Reply, true, SummaryVectorEncoding::BloomFilter);
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSummaryVectorEncoding (), SummaryVectorEncoding::BloomFilter,
+                           "Must be BloomFilter");
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 1u, "Must be 1u");
+
+    TypeHeader h2 (PacketType::ReplyBack, false, SummaryVectorEncoding::DeltaCoded);
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSummaryVectorEncoding (), SummaryVectorEncoding::DeltaCoded,
+                           "Must be DeltaCoded");
+
+    TypeHeader h3 (PacketType::ReplyBack);
+    NS_TEST_EXPECT_MSG_EQ (h3.GetSummaryVectorEncoding (), SummaryVectorEncoding::Explicit,
+                           "Must be Explicit");
+    NS_TEST_EXPECT_MSG_EQ ((h2 == h3), false, "Must be different");
+
+    h3.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+    NS_TEST_EXPECT_MSG_EQ (h2, h3, "Must be equal");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h2);
+    packet->AddHeader (h1);
+
+    TypeHeader deserialized;
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized, h1, "Serialization and deserialization works");
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized, h2, "Serialization and deserialization works");
+
+    // The incremental summary vector encoding (bits 5-6 set) isn't supported.
+    uint8_t incremental_encoding = 0x60 | (uint8_t) PacketType::Reply;
+    packet = Create<Packet> (&incremental_encoding, 1u);
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), false, "Must be false");
+  }
+
   void
   DoRun () override
   {
@@ -240,6 +313,8 @@ public:
     TestGettersSetters ();
     TestOverloadedOperators ();
     TestSerializationDeserialization ();
+    TestCompactEncodingFlag ();
+    TestSummaryVectorEncoding ();
   }
 };
 
@@ -528,6 +603,142 @@ public:
     NS_TEST_EXPECT_MSG_EQ (h.ToString (), expected_str, "Expected string: " + expected_str);
   }
 
+  void
+  TestCompactSerializationDeserialization ()
+  {
+    std::set<DataIdentifier> summary_vector = {DataIdentifier (Ipv4Address ("1.1.1.1"), 1),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 2),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 3)};
+
+    SummaryVectorHeader h1;
+    SummaryVectorHeader h2 (std::set<DataIdentifier>({DataIdentifier (Ipv4Address ("1.1.1.1"), 1)}),
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (-54, 23));
+    SummaryVectorHeader h3 (summary_vector, GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4));
+
+    h1.SetCompactEncoding (true);
+    h2.SetCompactEncoding (true);
+    h3.SetCompactEncoding (true);
+
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 4u, "Must be 4u");
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSerializedSize (), 14u, "Must be 14u");
+    NS_TEST_EXPECT_MSG_EQ (h3.GetSerializedSize (), 24u, "Must be 24u");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+    packet->AddHeader (h2);
+    packet->AddHeader (h3);
+
+    SummaryVectorHeader deserialized;
+    deserialized.SetCompactEncoding (true);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 24u, "Compact SummaryVectorHeader is 24 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h3, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 14u, "Compact SummaryVectorHeader is 14 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 4u, "Compact SummaryVectorHeader is 4 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+
+    // The packet metadata recreates the headers from their type ID.
+    NS_TEST_EXPECT_MSG_EQ (h3.GetInstanceTypeId (), CompactSummaryVectorHeader::GetTypeId (),
+                           "Must be the type ID of the compact header");
+    NS_TEST_EXPECT_MSG_EQ (SummaryVectorHeader ().GetInstanceTypeId (), SummaryVectorHeader::GetTypeId (),
+                           "Must be the type ID of the fixed-size header");
+
+    packet->AddHeader (h3);
+
+    Callback<ObjectBase *> constructor = h3.GetInstanceTypeId ().GetConstructor ();
+    SummaryVectorHeader * recreated = dynamic_cast<SummaryVectorHeader *> (constructor ());
+
+    NS_TEST_EXPECT_MSG_EQ (recreated->IsCompactEncoding (), true, "Must use the compact encoding");
+
+    read_bytes = packet->RemoveHeader (*recreated);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 24u, "Compact SummaryVectorHeader is 24 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h3, *recreated, "Serialization and deserialization works");
+
+    delete recreated;
+  }
+
+  void
+  TestDeltaCodedSerializationDeserialization ()
+  {
+    std::set<DataIdentifier> summary_vector = {DataIdentifier (Ipv4Address ("1.1.1.1"), 1),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 2),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 3),
+      DataIdentifier (Ipv4Address ("2.2.2.2"), 300)};
+
+    SummaryVectorHeader h1;
+    SummaryVectorHeader h2 (summary_vector,
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (5, -14));
+
+    h1.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+    h2.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+
+    // 1 byte of groups count, (4 + 1 + 1 + 2) bytes of the first group and
+    // (4 + 1 + 2) bytes of the second group.
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 19u + 1u, "Must be 20u");
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSerializedSize (), 19u + 16u, "Must be 35u");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+    packet->AddHeader (h2);
+
+    SummaryVectorHeader deserialized;
+    deserialized.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 35u, "Delta-coded SummaryVectorHeader is 35 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, deserialized, "Serialization and deserialization works");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVector (), summary_vector, "Must be equal");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 20u, "Delta-coded SummaryVectorHeader is 20 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+  }
+
+  void
+  TestBloomFilterSerializationDeserialization ()
+  {
+    std::set<DataIdentifier> summary_vector = {DataIdentifier (Ipv4Address ("1.1.1.1"), 1),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 2),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 3),
+      DataIdentifier (Ipv4Address ("2.2.2.2"), 300)};
+
+    DataIdentifierBloomFilter bloom_filter (summary_vector, 0.01);
+
+    SummaryVectorHeader h1 (std::set<DataIdentifier> (),
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (5, -14));
+    h1.SetSummaryVectorEncoding (SummaryVectorEncoding::BloomFilter);
+    h1.SetBloomFilter (bloom_filter, summary_vector.size ());
+
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSummaryVectorSize (), 4u, "Must be 4u");
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 19u + bloom_filter.GetSerializedSize (),
+                           "Must be the size of the filter plus 19 bytes");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+
+    SummaryVectorHeader deserialized;
+    deserialized.SetSummaryVectorEncoding (SummaryVectorEncoding::BloomFilter);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, h1.GetSerializedSize (), "Must be the serialized size");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVectorSize (), 4u, "Must be 4u");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVector ().empty (), true, "Must be true");
+
+    for (std::set<DataIdentifier>::const_iterator it = summary_vector.begin ();
+            it != summary_vector.end (); ++it)
+      {
+        NS_TEST_EXPECT_MSG_EQ (deserialized.GetBloomFilter ().MayContain (*it), true,
+                               "Must be true");
+      }
+  }
+
   void
   DoRun () override
   {
@@ -535,6 +746,9 @@ public:
     TestGettersSetters ();
     TestOverloadedOperators ();
     TestSerializationDeserialization ();
+    TestCompactSerializationDeserialization ();
+    TestDeltaCodedSerializationDeserialization ();
+    TestBloomFilterSerializationDeserialization ();
     TestToString ();
   }
 };
@@ -786,6 +1000,65 @@ public:
     NS_TEST_EXPECT_MSG_EQ (h.ToString (), expected_str, "Expected string: " + expected_str);
   }
 
+  void
+  TestCompactSerializationDeserialization ()
+  {
+    DataIdentifier data_id (Ipv4Address ("1.2.3.4"), 5u);
+    GeoTemporalLibrary::LibraryUtils::Vector2D creation_coordinates (-75.62, 85.62);
+    GeoTemporalArea gta (TimePeriod (Seconds (10), Seconds (20)), Area (30, 40, 50, 60));
+
+    DataHeader h1;
+    DataHeader h2 (data_id, creation_coordinates, gta, "Different message", 2u); // Message length = 17
+    DataHeader h3 (data_id, creation_coordinates, gta, "packet's message", 5u); // Message length = 16
+
+    h1.SetCompactEncoding (true);
+    h2.SetCompactEncoding (true);
+    h3.SetCompactEncoding (true);
+
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 18u, "Must be 18u");
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSerializedSize (), 47u, "Must be 47u");
+    NS_TEST_EXPECT_MSG_EQ (h3.GetSerializedSize (), 46u, "Must be 46u");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+    packet->AddHeader (h2);
+    packet->AddHeader (h3);
+
+    DataHeader deserialized;
+    deserialized.SetCompactEncoding (true);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 46u, "Compact DataHeader is 46 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h3, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 47u, "Compact DataHeader is 47 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 18u, "Compact DataHeader is 18 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+
+    // The packet metadata recreates the headers from their type ID.
+    NS_TEST_EXPECT_MSG_EQ (h3.GetInstanceTypeId (), CompactDataHeader::GetTypeId (),
+                           "Must be the type ID of the compact header");
+    NS_TEST_EXPECT_MSG_EQ (DataHeader ().GetInstanceTypeId (), DataHeader::GetTypeId (),
+                           "Must be the type ID of the fixed-size header");
+
+    packet->AddHeader (h3);
+
+    Callback<ObjectBase *> constructor = h3.GetInstanceTypeId ().GetConstructor ();
+    DataHeader * recreated = dynamic_cast<DataHeader *> (constructor ());
+
+    NS_TEST_EXPECT_MSG_EQ (recreated->IsCompactEncoding (), true, "Must use the compact encoding");
+
+    read_bytes = packet->RemoveHeader (*recreated);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 46u, "Compact DataHeader is 46 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h3, *recreated, "Serialization and deserialization works");
+
+    delete recreated;
+  }
+
   void
   DoRun () override
   {
@@ -794,6 +1067,7 @@ public:
     TestGetAllowedArea ();
     TestOverloadedOperators ();
     TestSerializationDeserialization ();
+    TestCompactSerializationDeserialization ();
     TestToString ();
   }
 };
@@ -2117,6 +2391,28 @@ public:
       DataIdentifier ("2.2.2.2:3"), DataIdentifier ("2.2.2.2:4"),
       DataIdentifier ("2.2.2.2:5")};
     NS_TEST_EXPECT_MSG_EQ (disjoint_vector, expected_disjoint_vector, "Disjoint vector must be the expected.");
+
+    // The same summary vector as a Bloom filter: the packets that it contains
+    // are skipped (the filter of these packets has no false positives).
+    received_sv_header.SetSummaryVectorEncoding (SummaryVectorEncoding::BloomFilter);
+    received_sv_header.SetBloomFilter (DataIdentifierBloomFilter (received_sv_header.GetSummaryVector (), 0.01),
+                                       received_sv_header.GetSummaryVector ().size ());
+
+    // Destination node 9.9.9.9
+    m_packets_queue.ProcessDisjointVector (received_sv_header, Ipv4Address ("9.9.9.9"),
+                                           disjoint_vector);
+
+    expected_disjoint_vector = {DataIdentifier ("2.2.2.2:1"), DataIdentifier ("2.2.2.2:2"),
+      DataIdentifier ("2.2.2.2:3"), DataIdentifier ("2.2.2.2:4"),
+      DataIdentifier ("2.2.2.2:5")};
+    NS_TEST_EXPECT_MSG_EQ (disjoint_vector, expected_disjoint_vector, "Disjoint vector must be the expected.");
+
+    // Destination node 2.2.2.2
+    m_packets_queue.ProcessDisjointVector (received_sv_header, Ipv4Address ("2.2.2.2"),
+                                           disjoint_vector);
+
+    expected_disjoint_vector = std::set<DataIdentifier> ();
+    NS_TEST_EXPECT_MSG_EQ (disjoint_vector, expected_disjoint_vector, "Disjoint vector must be the expected.");
   }
 
   void
@@ -2532,6 +2828,99 @@ public:
     Simulator::Destroy ();
   }
 
+  void
+  TestProcessDisjointVectorAreaGroups ()
+  {
+    std::set<DataIdentifier> disjoint_vector, expected_disjoint_vector;
+    SummaryVectorHeader received_sv_header;
+    m_packets_queue = PacketsQueue (3);
+
+    // Packets 1.1.1.1:1 and 1.1.1.1:2 share the same allowed and destination
+    // areas, each of the others has its own.
+    DataHeader data_packet (/* Data ID */ DataIdentifier ("1.1.1.1:1"),
+                            /* Creation coordinates */ GeoTemporalLibrary::LibraryUtils::Vector2D (0.0, 0.0),
+                            /* Geo-temporal area */ GeoTemporalArea (TimePeriod (Seconds (0), Seconds (10)),
+                                                                     Area (0, 0, 100, 100)),
+                            /* Message */ "Message",
+                            /* Hops count */ 1);
+    m_packets_queue.Enqueue (data_packet, Ipv4Address ("1.1.1.1"));
+
+    data_packet.SetDataIdentifier (DataIdentifier ("1.1.1.1:2"));
+    m_packets_queue.Enqueue (data_packet, Ipv4Address ("1.1.1.1"));
+
+    data_packet = DataHeader (/* Data ID */ DataIdentifier ("1.1.1.1:3"),
+                              /* Creation coordinates */ GeoTemporalLibrary::LibraryUtils::Vector2D (200.0, 200.0),
+                              /* Geo-temporal area */ GeoTemporalArea (TimePeriod (Seconds (0), Seconds (20)),
+                                                                       Area (200, 200, 300, 300)),
+                              /* Message */ "Message",
+                              /* Hops count */ 1);
+    m_packets_queue.Enqueue (data_packet, Ipv4Address ("1.1.1.1"));
+
+    // The packets queue now looks like this:
+    //     Data ID   -  Expiration time  -  Temporal scope  -  Destination area    -  Hops count
+    //    1.1.1.1:1  -     second 10     -      0 to 10     -   0,   0, 100, 100   -      1
+    //    1.1.1.1:2  -     second 10     -      0 to 10     -   0,   0, 100, 100   -      1
+    //    1.1.1.1:3  -     second 20     -      0 to 20     - 200, 200, 300, 300   -      1
+
+    received_sv_header.SetPosition (GeoTemporalLibrary::LibraryUtils::Vector2D (50, 50));
+    m_packets_queue.ProcessDisjointVector (received_sv_header, Ipv4Address ("9.9.9.9"),
+                                           disjoint_vector);
+
+    expected_disjoint_vector = {DataIdentifier ("1.1.1.1:1"), DataIdentifier ("1.1.1.1:2")};
+    NS_TEST_EXPECT_MSG_EQ (disjoint_vector, expected_disjoint_vector, "Disjoint vector must be the expected.");
+
+    // Inserting a new packet in the full queue drops 1.1.1.1:1, the group of
+    // 1.1.1.1:2 must remain.
+    data_packet = DataHeader (/* Data ID */ DataIdentifier ("1.1.1.1:4"),
+                              /* Creation coordinates */ GeoTemporalLibrary::LibraryUtils::Vector2D (400.0, 400.0),
+                              /* Geo-temporal area */ GeoTemporalArea (TimePeriod (Seconds (0), Seconds (30)),
+                                                                       Area (400, 400, 500, 500)),
+                              /* Message */ "Message",
+                              /* Hops count */ 1);
+    m_packets_queue.Enqueue (data_packet, Ipv4Address ("1.1.1.1"));
+
+    m_packets_queue.ProcessDisjointVector (received_sv_header, Ipv4Address ("9.9.9.9"),
+                                           disjoint_vector);
+
+    expected_disjoint_vector = {DataIdentifier ("1.1.1.1:2")};
+    NS_TEST_EXPECT_MSG_EQ (disjoint_vector, expected_disjoint_vector, "Disjoint vector must be the expected.");
+
+    // Inserting another one drops 1.1.1.1:2 and its groups, which are replaced
+    // by the groups of the last inserted packet.
+    data_packet.SetDataIdentifier (DataIdentifier ("1.1.1.1:5"));
+    data_packet.SetCreationCoordinates (GeoTemporalLibrary::LibraryUtils::Vector2D (600.0, 600.0));
+    data_packet.SetDestinationGeoTemporalArea (GeoTemporalArea (TimePeriod (Seconds (0), Seconds (40)),
+                                                                Area (600, 600, 700, 700)));
+    m_packets_queue.Enqueue (data_packet, Ipv4Address ("1.1.1.1"));
+
+    m_packets_queue.ProcessDisjointVector (received_sv_header, Ipv4Address ("9.9.9.9"),
+                                           disjoint_vector);
+
+    expected_disjoint_vector = std::set<DataIdentifier> ();
+    NS_TEST_EXPECT_MSG_EQ (disjoint_vector, expected_disjoint_vector, "Disjoint vector must be the expected.");
+
+    received_sv_header.SetPosition (GeoTemporalLibrary::LibraryUtils::Vector2D (250, 250));
+    m_packets_queue.ProcessDisjointVector (received_sv_header, Ipv4Address ("9.9.9.9"),
+                                           disjoint_vector);
+
+    expected_disjoint_vector = {DataIdentifier ("1.1.1.1:3")};
+    NS_TEST_EXPECT_MSG_EQ (disjoint_vector, expected_disjoint_vector, "Disjoint vector must be the expected.");
+
+    received_sv_header.SetPosition (GeoTemporalLibrary::LibraryUtils::Vector2D (450, 450));
+    m_packets_queue.ProcessDisjointVector (received_sv_header, Ipv4Address ("9.9.9.9"),
+                                           disjoint_vector);
+
+    expected_disjoint_vector = {DataIdentifier ("1.1.1.1:4")};
+    NS_TEST_EXPECT_MSG_EQ (disjoint_vector, expected_disjoint_vector, "Disjoint vector must be the expected.");
+
+    received_sv_header.SetPosition (GeoTemporalLibrary::LibraryUtils::Vector2D (650, 650));
+    m_packets_queue.ProcessDisjointVector (received_sv_header, Ipv4Address ("9.9.9.9"),
+                                           disjoint_vector);
+
+    expected_disjoint_vector = {DataIdentifier ("1.1.1.1:5")};
+    NS_TEST_EXPECT_MSG_EQ (disjoint_vector, expected_disjoint_vector, "Disjoint vector must be the expected.");
+  }
+
   void
   TestFindFunctions ()
   {
@@ -3397,6 +3786,7 @@ public:
     TestClear ();
     TestGetSummaryVector ();
     TestProcessDisjointVector ();
+    TestProcessDisjointVectorAreaGroups ();
     TestFindFunctions ();
     TestEnqueueFunction ();
     TestPurge ();
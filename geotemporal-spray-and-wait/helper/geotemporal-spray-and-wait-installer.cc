@@ -70,14 +70,20 @@ m_simulation_number (1u), m_simulation_duration (600u),
 m_data_packet_source_vehicles_count (8u), m_data_packets_per_source (2u),
 m_data_packet_message_size (128u), m_data_packets_data_rate (5u),
 m_mobility_scenario_id ("60"),
+m_mobility_scenario_files_prefix (""),
 m_vehicles_count (2u), m_fixed_nodes_distance (200u),
 m_use_80211p_mac_protocol (false), m_progress_report_time_interval (25u),
 m_hello_packets_interval (1000u), m_packets_queue_capacity (128u),
-m_neighbor_expiration_time (10u), m_data_packet_replicas (32u), m_binary_mode (false),
+m_neighbor_expiration_time (10u), m_data_packet_replicas (32u), m_replica_allocation ("Fixed"),
+m_min_data_packet_replicas (2u), m_max_data_packet_replicas (128u),
+m_replica_reference_neighbors (5.0), m_replica_reference_lifetime (300u),
+m_binary_mode (false), m_compact_header_encoding (false),
+m_summary_vector_encoding ("Explicit"), m_summary_vector_false_positive_rate (0.01),
 m_streets_graph_input_filename (""), m_street_junctions_input_filename (""),
 m_vehicles_routes_input_filename (""), m_vehicles_mobility_trace_filename (""),
 m_random_destination_gta_input_filename (""), m_gta_visitor_vehicles_input_filename (""),
-m_statistics_output_filename ("/simulations-output/simulation_statistics.xml")
+m_statistics_output_filename ("/simulations-output/simulation_statistics.xml"),
+m_simulator_events_count (0u), m_statistics_values ()
 {
   NS_LOG_FUNCTION (this);
 }
@@ -96,6 +102,7 @@ m_data_packets_per_source (copy.m_data_packets_per_source),
 m_data_packet_message_size (copy.m_data_packet_message_size),
 m_data_packets_data_rate (copy.m_data_packets_data_rate),
 m_mobility_scenario_id (copy.m_mobility_scenario_id),
+m_mobility_scenario_files_prefix (copy.m_mobility_scenario_files_prefix),
 m_vehicles_count (copy.m_vehicles_count),
 m_fixed_nodes_distance (copy.m_fixed_nodes_distance),
 m_use_80211p_mac_protocol (copy.m_use_80211p_mac_protocol),
@@ -104,14 +111,24 @@ m_hello_packets_interval (copy.m_hello_packets_interval),
 m_packets_queue_capacity (copy.m_packets_queue_capacity),
 m_neighbor_expiration_time (copy.m_neighbor_expiration_time),
 m_data_packet_replicas (copy.m_data_packet_replicas),
+m_replica_allocation (copy.m_replica_allocation),
+m_min_data_packet_replicas (copy.m_min_data_packet_replicas),
+m_max_data_packet_replicas (copy.m_max_data_packet_replicas),
+m_replica_reference_neighbors (copy.m_replica_reference_neighbors),
+m_replica_reference_lifetime (copy.m_replica_reference_lifetime),
 m_binary_mode (copy.m_binary_mode),
+m_compact_header_encoding (copy.m_compact_header_encoding),
+m_summary_vector_encoding (copy.m_summary_vector_encoding),
+m_summary_vector_false_positive_rate (copy.m_summary_vector_false_positive_rate),
 m_streets_graph_input_filename (copy.m_streets_graph_input_filename),
 m_street_junctions_input_filename (copy.m_street_junctions_input_filename),
 m_vehicles_routes_input_filename (copy.m_vehicles_routes_input_filename),
 m_vehicles_mobility_trace_filename (copy.m_vehicles_mobility_trace_filename),
 m_random_destination_gta_input_filename (copy.m_random_destination_gta_input_filename),
 m_gta_visitor_vehicles_input_filename (copy.m_gta_visitor_vehicles_input_filename),
-m_statistics_output_filename (copy.m_statistics_output_filename)
+m_statistics_output_filename (copy.m_statistics_output_filename),
+m_simulator_events_count (copy.m_simulator_events_count),
+m_statistics_values (copy.m_statistics_values)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -157,10 +174,16 @@ GeoTemporalSprayAndWaitInstaller::Configure (int argc, char** argv)
   cmd.AddValue ("mobilityScenarioId",
                 "The identifier of the mobility scenario used in the simulation."
                 "Valid values are: fixed, 20, 30, 60, 90, 120, 30-60, 30-90, "
-                "30-120, 60-90, 60-120, 90-120, low, medium, high. "
+                "30-120, 60-90, 60-120, 90-120, low, medium, high, custom. "
                 "[Default value: 60]",
                 m_mobility_scenario_id);
 
+  cmd.AddValue ("mobilityScenarioFiles",
+                "Prefix of the names of the input files of the custom mobility "
+                "scenario (e.g. simulations-input/Luxembourg/Custom). Only used "
+                "when the custom mobility scenario is selected. [Default value: ]",
+                m_mobility_scenario_files_prefix);
+
   cmd.AddValue ("vehiclesCount",
                 "The number of vehicle nodes to create. Only actively used when "
                 "the fixed mobility scenario is selected."
@@ -210,12 +233,62 @@ GeoTemporalSprayAndWaitInstaller::Configure (int argc, char** argv)
                 "[Default value: 32]",
                 m_data_packet_replicas);
 
+  cmd.AddValue ("replicaAllocation",
+                "Policy to allocate the replicas of the created DATA packets: "
+                "Fixed (always dataPacketReplicas) or DensityAdaptive (fewer "
+                "replicas with more neighbor nodes or a longer remaining "
+                "lifetime). "
+                "[Default value: Fixed]",
+                m_replica_allocation);
+
+  cmd.AddValue ("minDataPacketReplicas",
+                "Minimum number of replicas of the density-adaptive replica "
+                "allocation. "
+                "[Default value: 2]",
+                m_min_data_packet_replicas);
+
+  cmd.AddValue ("maxDataPacketReplicas",
+                "Maximum number of replicas of the density-adaptive replica "
+                "allocation. "
+                "[Default value: 128]",
+                m_max_data_packet_replicas);
+
+  cmd.AddValue ("replicaReferenceNeighbors",
+                "Number of recently contacted neighbor nodes with which the density-adaptive replica allocation gives "
+                "dataPacketReplicas replicas. "
+                "[Default value: 5]",
+                m_replica_reference_neighbors);
+
+  cmd.AddValue ("replicaReferenceLifetime",
+                "Remaining lifetime (in seconds) of a DATA packet with which "
+                "the density-adaptive replica allocation gives "
+                "dataPacketReplicas replicas. "
+                "[Default value: 300]",
+                m_replica_reference_lifetime);
+
   cmd.AddValue ("binaryMode",
                 "Flag that indicates if the Spray And Wait protocol works in "
                 "Binary mode (with true) or Normal mode (with false). "
                 "[Default value: false]",
                 m_binary_mode);
 
+  cmd.AddValue ("compactHeaderEncoding",
+                "Indicates if the positions and areas in the packet headers use "
+                "the compact (fixed-point, variable-length) encoding. "
+                "[Default value: false]",
+                m_compact_header_encoding);
+
+  cmd.AddValue ("summaryVectorEncoding",
+                "Encoding of the summary vectors of the REPLY packets: "
+                "Explicit, DeltaCoded or BloomFilter. "
+                "[Default value: Explicit]",
+                m_summary_vector_encoding);
+
+  cmd.AddValue ("summaryVectorFalsePositiveRate",
+                "False positive rate of the Bloom filters of the summary vectors. "
+                "[Default value: 0.01]",
+                m_summary_vector_false_positive_rate);
+
   // Output files
 
   cmd.AddValue ("outputStatisticsFile",
@@ -228,6 +301,16 @@ GeoTemporalSprayAndWaitInstaller::Configure (int argc, char** argv)
   if (m_simulation_number == 0u)
     NS_ABORT_MSG ("Invalid simulation number. The minimum valid value is 1.");
 
+  if (m_replica_allocation != "Fixed" && m_replica_allocation != "DensityAdaptive")
+    NS_ABORT_MSG ("Invalid replica allocation. Valid values are: Fixed and "
+                  "DensityAdaptive.");
+
+  if (m_replica_allocation == "DensityAdaptive"
+      && (m_min_data_packet_replicas == 0u
+          || m_min_data_packet_replicas > m_max_data_packet_replicas))
+    NS_ABORT_MSG ("The minimum number of DATA packet replicas must be greater "
+                  "than 0 and not greater than the maximum number of replicas.");
+
   // Configure the name of the mobility related files.
   if (m_mobility_scenario_id == "20")
     {
@@ -453,6 +536,26 @@ GeoTemporalSprayAndWaitInstaller::Configure (int argc, char** argv)
       // Geo-temporal areas visitor vehicles
       m_gta_visitor_vehicles_input_filename = "simulations-input/Luxembourg/High.geo_temporal_areas_visitor_nodes.txt";
     }
+  else if (m_mobility_scenario_id == "custom")
+    {
+      if (m_mobility_scenario_files_prefix.empty ())
+        NS_ABORT_MSG ("The prefix of the input files is required by the custom "
+                      "mobility scenario.");
+
+      // GPS initialization files
+      m_streets_graph_input_filename = m_mobility_scenario_files_prefix + ".graph.txt";
+      m_street_junctions_input_filename = m_mobility_scenario_files_prefix + ".junctions.txt";
+      m_vehicles_routes_input_filename = m_mobility_scenario_files_prefix + ".routes.txt";
+
+      // Vehicles' mobility trace file
+      m_vehicles_mobility_trace_filename = m_mobility_scenario_files_prefix + ".ns2.mob.tcl";
+
+      // Random destination areas.
+      m_random_destination_gta_input_filename = m_mobility_scenario_files_prefix + ".random_geo_temporal_areas.txt";
+
+      // Geo-temporal areas visitor vehicles
+      m_gta_visitor_vehicles_input_filename = m_mobility_scenario_files_prefix + ".geo_temporal_areas_visitor_nodes.txt";
+    }
   else if (m_mobility_scenario_id == "fixed")
     {
       // Do something when fixed mobility.
@@ -461,7 +564,7 @@ GeoTemporalSprayAndWaitInstaller::Configure (int argc, char** argv)
     {
       NS_ABORT_MSG ("Invalid mobility scenario identifier. Valid values are: "
                     "fixed, 20, 30, 60, 90, 120, 30-60, 30-90, 30-120, 60-90, "
-                    "60-120, 90-120, low, medium, high.");
+                    "60-120, 90-120, low, medium, high, custom.");
     }
 
   // When the nodes have mobility create GPS and configurate GPS system and 
@@ -477,10 +580,13 @@ GeoTemporalSprayAndWaitInstaller::Configure (int argc, char** argv)
       // Set number of vehicles in the simulation
       m_vehicles_count = m_gps_system->GetVehiclesRoutesData ().GetNodesCount ();
 
-      // Random destination geo-temporal areas object
+      // Random destination geo-temporal areas object (only the list used in
+      // this simulation is imported)
       NS_ASSERT (m_random_destination_gtas == 0);
       m_random_destination_gtas =
-              Create<RandomDestinationGeoTemporalAreasLists> (m_random_destination_gta_input_filename);
+              Create<RandomDestinationGeoTemporalAreasLists> (m_random_destination_gta_input_filename,
+                                                              m_simulation_number,
+                                                              m_data_packet_source_vehicles_count);
     }
 
   return true;
@@ -502,6 +608,8 @@ GeoTemporalSprayAndWaitInstaller::Run ()
   std::cout << " - Data packet message size        :  " << m_data_packet_message_size << " bytes\n";
   std::cout << " - Data packets data rate          :  " << m_data_packets_data_rate << " milliseconds\n";
   std::cout << " - Mobility scenario ID            :  " << m_mobility_scenario_id << "\n";
+  if (m_mobility_scenario_id == "custom")
+    std::cout << " - Mobility scenario files prefix  :  " << m_mobility_scenario_files_prefix << "\n";
   std::cout << " - Vehicles count                  :  " << m_vehicles_count << "\n";
   std::cout << " - Distance between fixed nodes    :  " << m_fixed_nodes_distance << " meters";
   if (m_mobility_scenario_id != "fixed")
@@ -520,7 +628,18 @@ GeoTemporalSprayAndWaitInstaller::Run ()
   std::cout << " - Packets queue capacity          :  " << m_packets_queue_capacity << " packets\n";
   std::cout << " - Neighbor expiration time        :  " << m_neighbor_expiration_time << " seconds\n";
   std::cout << " - Data packet replicas            :  " << m_data_packet_replicas << " packet replicas\n";
+  std::cout << " - Replica allocation              :  " << m_replica_allocation;
+  if (m_replica_allocation == "DensityAdaptive")
+    std::cout << " (" << m_min_data_packet_replicas << " to " << m_max_data_packet_replicas
+          << " replicas, " << m_replica_reference_neighbors << " reference neighbors, "
+          << m_replica_reference_lifetime << " seconds reference lifetime)";
+  std::cout << "\n";
   std::cout << " - Binary mode                     :  " << (m_binary_mode ? "Enabled" : "Disabled") << "\n";
+  std::cout << " - Compact header encoding         :  " << (m_compact_header_encoding ? "Enabled" : "Disabled") << "\n";
+  std::cout << " - Summary vector encoding         :  " << m_summary_vector_encoding;
+  if (m_summary_vector_encoding == "BloomFilter")
+    std::cout << " (" << m_summary_vector_false_positive_rate << " false positive rate)";
+  std::cout << "\n";
   std::cout << "\n";
 
   if (m_mobility_scenario_id != "fixed")
@@ -546,6 +665,7 @@ GeoTemporalSprayAndWaitInstaller::Run ()
   ScheduleNextProgressReport ();
   Simulator::Stop (Seconds (m_simulation_duration));
   Simulator::Run ();
+  m_simulator_events_count = Simulator::GetEventCount ();
   Simulator::Destroy ();
 
   std::cout << "Simulation finished.\n";
@@ -657,7 +777,15 @@ GeoTemporalSprayAndWaitInstaller::InstallInternetStack ()
   saw_helper.Set ("PacketsQueueCapacity", UintegerValue (m_packets_queue_capacity));
   saw_helper.Set ("NeighborsExpirationTime", TimeValue (Seconds (m_neighbor_expiration_time)));
   saw_helper.Set ("DataPacketReplicas", UintegerValue (m_data_packet_replicas));
+  saw_helper.Set ("ReplicaAllocation", StringValue (m_replica_allocation));
+  saw_helper.Set ("MinDataPacketReplicas", UintegerValue (m_min_data_packet_replicas));
+  saw_helper.Set ("MaxDataPacketReplicas", UintegerValue (m_max_data_packet_replicas));
+  saw_helper.Set ("ReplicaReferenceNeighbors", DoubleValue (m_replica_reference_neighbors));
+  saw_helper.Set ("ReplicaReferenceLifetime", TimeValue (Seconds (m_replica_reference_lifetime)));
   saw_helper.Set ("BinaryMode", BooleanValue (m_binary_mode));
+  saw_helper.Set ("CompactHeaderEncoding", BooleanValue (m_compact_header_encoding));
+  saw_helper.Set ("SummaryVectorEncoding", StringValue (m_summary_vector_encoding));
+  saw_helper.Set ("SummaryVectorFalsePositiveRate", DoubleValue (m_summary_vector_false_positive_rate));
 
   InternetStackHelper internet_stack;
   internet_stack.SetRoutingHelper (saw_helper); // has effect on the next Install ()
@@ -993,6 +1121,8 @@ GeoTemporalSprayAndWaitInstaller::Report (const std::string& output_xml_filename
         }
     }
 
+  simulation_stats.CalculateStatistics (m_statistics_values);
+
   std::cout << "Done.\n";
 
   simulation_stats.SaveToXmlFile (output_xml_filename);
@@ -32,6 +32,8 @@
 #include <ns3/nstime.h>
 #include <ns3/simulator.h>
 
+#include <ns3/geotemporal-utils.h>
+
 
 namespace ns3
 {
@@ -89,6 +91,13 @@ public:
     m_expiration_time = expiration_time + Simulator::Now ();
   }
 
+  /** Returns the simulation time at which the entry expires. */
+  inline const Time &
+  GetExpirationInstant () const
+  {
+    return m_expiration_time;
+  }
+
   void
   Print (std::ostream &os) const;
 
@@ -145,6 +154,10 @@ private:
   /** Expiration time of the neighbor entries. */
   Time m_entries_expiration_time;
 
+  /** Expiration instants of the neighbor entries, used to purge only the 
+   * expired entries. */
+  GeoTemporalLibrary::LibraryUtils::ExpirationIndex<Ipv4Address> m_expiration_index;
+
   /** Neighbors table iterator. */
   typedef std::map<Ipv4Address, NeighborEntry>::iterator Iterator_t;
 
@@ -261,6 +274,7 @@ public:
   Clear ()
   {
     m_table.clear ();
+    m_expiration_index.clear ();
   }
 
   /**
@@ -346,6 +360,8 @@ private:
 
   /**
    * Removes all expired neighbor entries from the neighbors table.
+   * 
+   * It only visits the entries whose expiration instant has passed.
    */
   void
   Purge ();
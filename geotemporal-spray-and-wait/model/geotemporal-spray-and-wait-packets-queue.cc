@@ -86,15 +86,11 @@ PacketsQueue::PacketsQueue () : PacketsQueue (false, 128u) { }
 
 PacketsQueue::PacketsQueue (bool binary_mode_flag, uint32_t maximum_queue_length)
 : m_binary_spray_and_wait_mode_flag (binary_mode_flag),
-m_max_queue_length (maximum_queue_length),
-m_packets_dropped_counter (0u),
-m_packets_table (),
+m_packets_table (maximum_queue_length),
 m_data_packet_reception_stats () { }
 
 PacketsQueue::PacketsQueue (const PacketsQueue& copy)
 : m_binary_spray_and_wait_mode_flag (copy.m_binary_spray_and_wait_mode_flag),
-m_max_queue_length (copy.m_max_queue_length),
-m_packets_dropped_counter (copy.m_packets_dropped_counter),
 m_packets_table (copy.m_packets_table),
 m_data_packet_reception_stats (copy.m_data_packet_reception_stats) { }
 
@@ -178,26 +174,29 @@ PacketsQueue::ProcessDisjointVector (const std::set<DataIdentifier>& summary_vec
   // Clean the disjoint vector.
   disjoint_vector.clear ();
 
-  // Iterate through all data identifiers in the summary vector
-  for (std::set<DataIdentifier>::const_iterator it = summary_vector.begin ();
-          it != summary_vector.end (); ++it)
-    {
-      // Check if the packet exists in this packets queue: if it doesn't exist
-      // in this packets queue then insert it into the disjoint vector.
-      if (m_packets_table.find (*it) == m_packets_table.end ())
-        {
-          // The current packet doesn't exist in this packets queue, insert it
-          // into the disjoint vector.
-          disjoint_vector.insert (*it);
-        }
-    }
+  // The packets of the summary vector that don't exist in this packets queue
+  // are found in a single merge pass over the sorted identifiers of both.
+  std::vector<DataIdentifier> unknown_packets;
+  m_packets_table.GetMissingPackets (summary_vector, unknown_packets);
+
+  // The identifiers are sorted, so they are inserted at the end.
+  disjoint_vector.insert (unknown_packets.begin (), unknown_packets.end ());
 }
 
-bool
-PacketsQueue::ComparePacketEntriesExpirationTime (const std::map<DataIdentifier, PacketQueueEntry>::value_type& entry_1,
-                                                  const std::map<DataIdentifier, PacketQueueEntry>::value_type& entry_2)
+void
+PacketsQueue::ProcessDisjointVector (const DataIdentifierBloomFilter& bloom_filter,
+                                     std::set<DataIdentifier>& disjoint_vector) const
 {
-  return entry_1.second.GetExpirationTime () < entry_2.second.GetExpirationTime ();
+  NS_LOG_FUNCTION (this);
+
+  // Clean the disjoint vector.
+  disjoint_vector.clear ();
+
+  std::vector<DataIdentifier> unknown_packets;
+  m_packets_table.GetUnknownPackets (bloom_filter, unknown_packets);
+
+  // The identifiers are sorted, so they are inserted at the end.
+  disjoint_vector.insert (unknown_packets.begin (), unknown_packets.end ());
 }
 
 bool
@@ -218,26 +217,22 @@ PacketsQueue::Enqueue (const DataHeader& data_header, const Ipv4Address& transmi
       return false;
     }
 
-  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_max_queue_length
+  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_packets_table.GetMaxLength ()
                 << " packets before insertion.");
 
   // Check if the queue is full.
-  if (m_packets_table.size () == m_max_queue_length)
+  if (m_packets_table.IsFull ())
     {
-      ++m_packets_dropped_counter;
-
       // Find oldest entry
-      Iterator_t entry_to_delete_it = std::min_element (m_packets_table.begin (),
-                                                        m_packets_table.end (),
-                                                        ComparePacketEntriesExpirationTime);
+      const DataIdentifier packet_to_drop = m_packets_table.SelectPacketToDrop ()->first;
 
       NS_LOG_DEBUG ("Drops the oldest packet due to full queue : "
-                    << entry_to_delete_it->second);
+                    << m_packets_table.at (packet_to_drop));
 
       // Log statistics about the packet drop
-      LogPacketDropped (entry_to_delete_it->first);
+      LogPacketDropped (packet_to_drop);
 
-      m_packets_table.erase (entry_to_delete_it);
+      m_packets_table.DropPacket (packet_to_drop);
     }
 
   std::pair<Iterator_t, bool> inserted_result;
@@ -245,7 +240,7 @@ PacketsQueue::Enqueue (const DataHeader& data_header, const Ipv4Address& transmi
                                                             PacketQueueEntry (data_header)));
 
   NS_LOG_DEBUG ("Packet successfully inserted : " << inserted_result.first->second);
-  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_max_queue_length
+  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_packets_table.GetMaxLength ()
                 << " packets after insertion.");
 
   // Save statistics about the packet reception.
@@ -267,30 +262,23 @@ PacketsQueue::DiscountPacketReplicasToForward (const DataIdentifier& data_packet
   if (packet_entry_it == m_packets_table.end ())
     return false; // The data packet it doesn't exists, cancel.
 
+  uint32_t replicas_to_keep, discounted_replicas;
+  const uint32_t current_replicas = packet_entry_it->second.GetReplicasCounter ();
+
   // If there's one or less packet replicas left, it must NOT discount any replicas
   // because the packet is in direct-transmission-only mode, that is, transmit 
   // only to destination.
-  if (packet_entry_it->second.GetReplicasCounter () <= 1u)
+  // Normal mode: discount 1 replica.
+  // Binary mode: transmit floor(current replicas / 2) replicas and keep 
+  //              ceil(current replicas / 2) replicas.
+  const bool discounted = m_binary_spray_and_wait_mode_flag
+          ? BinarySprayReplicas::SplitReplicas (current_replicas, discounted_replicas, replicas_to_keep)
+          : NormalSprayReplicas::SplitReplicas (current_replicas, discounted_replicas, replicas_to_keep);
+
+  if (!discounted)
     return false;
 
-  uint32_t replicas_to_keep;
-  const uint32_t current_replicas = packet_entry_it->second.GetReplicasCounter ();
-
-  if (!m_binary_spray_and_wait_mode_flag)
-    {
-      // Normal mode: discount 1 replica
-      replicas_to_forward = 1u;
-      replicas_to_keep = current_replicas - 1u;
-    }
-  else
-    {
-      // Binary mode: transmit floor(current replicas / 2) replicas and 
-      //              keep ceil(current replicas / 2) replicas
-      const double modified_replicas = ((double) current_replicas) / 2.0;
-
-      replicas_to_forward = std::floor (modified_replicas);
-      replicas_to_keep = std::ceil (modified_replicas);
-    }
+  replicas_to_forward = discounted_replicas;
 
   NS_ASSERT (current_replicas == replicas_to_forward + replicas_to_keep);
 
@@ -309,19 +297,11 @@ PacketsQueue::Purge ()
 {
   NS_LOG_FUNCTION (this);
 
-  for (ConstIterator_t entry_it = m_packets_table.begin (); entry_it != m_packets_table.end ();)
-    {
-      if (entry_it->second.GetExpirationTime () <= Seconds (0))
-        {
-          NS_LOG_LOGIC ("Drops expired data packet entry : " << entry_it->second);
-          // m_packets_table.erase (entry_it++); // For C++03
-          entry_it = m_packets_table.erase (entry_it); // For C++11
-        }
-      else
-        {
-          ++entry_it;
-        }
-    }
+  std::vector<DataIdentifier> purged_packets;
+  m_packets_table.Purge (Simulator::Now (), &purged_packets);
+
+  if (!purged_packets.empty ())
+    NS_LOG_LOGIC ("Drops " << purged_packets.size () << " expired data packet entries.");
 }
 
 
@@ -396,7 +376,7 @@ PacketsQueue::ToString () const
   std::sprintf (buffer, "%u", (uint32_t) m_packets_table.size ());
   std::string str = "Packets queue has " + std::string (buffer) + " / ";
 
-  std::sprintf (buffer, "%u", m_max_queue_length);
+  std::sprintf (buffer, "%u", m_packets_table.GetMaxLength ());
   str += std::string (buffer) + " packet entries";
 
   return str;
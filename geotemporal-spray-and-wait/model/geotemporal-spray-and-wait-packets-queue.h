@@ -36,6 +36,7 @@
 
 #include <ns3/geotemporal-utils.h>
 #include <ns3/packet-utils.h>
+#include <ns3/packets-queue-core.h>
 #include <ns3/statistics-utils.h>
 
 using namespace GeoTemporalLibrary::LibraryUtils;
@@ -122,6 +123,13 @@ public:
     m_expiration_time = packet_time_period.GetEndTime ();
   }
 
+  /** Returns the simulation time at which the entry expires. */
+  inline const Time &
+  GetExpirationInstant () const
+  {
+    return m_expiration_time;
+  }
+
   inline uint32_t
   GetReplicasCounter () const
   {
@@ -193,31 +201,29 @@ private:
    */
   bool m_binary_spray_and_wait_mode_flag;
 
+  /** Data packets table. When the queue is full, the packet that expires first
+   * is dropped. */
+  typedef PacketsQueueCore<PacketQueueEntry, DropEarliestExpiration> PacketsTable_t;
+
   /** 
-   * Maximum number of packet entries that the queue can store at once.
+   * Data packets table, with the maximum number of packet entries that the
+   * queue can store at once and the counter of packets dropped due to a full
+   * queue.
    * 
    * If the queue reaches this maximum number of packet entries and a new packet
    * is stored, then the oldest packet will be dropped from the queue before 
    * inserting the new one.
    */
-  uint32_t m_max_queue_length;
-
-  /**
-   * The counter of all packets dropped due to a full queue.
-   */
-  uint32_t m_packets_dropped_counter;
-
-  /** Data packets table. */
-  std::map<DataIdentifier, PacketQueueEntry> m_packets_table;
+  PacketsTable_t m_packets_table;
 
   /** Data packets stats. */
   std::map<DataIdentifier, DataPacketReceptionStats> m_data_packet_reception_stats;
 
   /** Packets table iterator. */
-  typedef std::map<DataIdentifier, PacketQueueEntry>::iterator Iterator_t;
+  typedef PacketsTable_t::iterator Iterator_t;
 
   /** Packets table constant iterator. */
-  typedef std::map<DataIdentifier, PacketQueueEntry>::const_iterator ConstIterator_t;
+  typedef PacketsTable_t::const_iterator ConstIterator_t;
 
   /** Packet statistics iterator. */
   typedef std::map<DataIdentifier, DataPacketReceptionStats>::iterator StatsIterator_t;
@@ -283,7 +289,7 @@ public:
   inline uint32_t
   GetMaxLength () const
   {
-    return m_max_queue_length;
+    return m_packets_table.GetMaxLength ();
   }
 
   /**
@@ -299,7 +305,7 @@ public:
   inline void
   SetMaxLength (uint32_t maximum_queue_length)
   {
-    m_max_queue_length = maximum_queue_length;
+    m_packets_table.SetMaxLength (maximum_queue_length);
   }
 
   /**
@@ -308,7 +314,7 @@ public:
   inline uint32_t
   GetDroppedPacketsCounter () const
   {
-    return m_packets_dropped_counter;
+    return m_packets_table.GetDroppedPacketsCounter ();
   }
 
   /**
@@ -435,25 +441,25 @@ public:
   ProcessDisjointVector (const std::set<DataIdentifier> & summary_vector,
                          std::set<DataIdentifier> & disjoint_vector) const;
 
-
-private:
-
   /**
-   * Compares the expiration time of 2 packet queue entries and returns 
-   * <code>true</code> if <code>entry_1</code> is <i>less</i> than
-   * <code>entry_2</code>.
+   * Given the Bloom filter of the summary vector of other node processes the 
+   * set of data packet identifiers of the packets of this packets queue that
+   * the filter doesn't contain, that is, the packets that the other node 
+   * doesn't know. A false positive of the filter leaves a packet out of the 
+   * disjoint vector.
+   * 
+   * The <code>disjoint_vector</code> parameter is always emptied.
    * 
-   * This comparison function object satisfies the requirements of Compare.
+   * This function doesn't purge expired packet entries.
    * 
-   * @return <code>true</code> if <code>entry_1</code> is <i>less</i> than
-   * <code>entry_2</code>
+   * @param bloom_filter [IN] Bloom filter of the summary vector of the other 
+   * node.
+   * @param disjoint_vector [OUT] The disjoint vector is stored in this parameter.
    */
-  static bool
-  ComparePacketEntriesExpirationTime (const std::map<DataIdentifier, PacketQueueEntry>::value_type & entry_1,
-                                      const std::map<DataIdentifier, PacketQueueEntry>::value_type & entry_2);
-
+  void
+  ProcessDisjointVector (const DataIdentifierBloomFilter & bloom_filter,
+                         std::set<DataIdentifier> & disjoint_vector) const;
 
-public:
 
   /**
    * Inserts a new packet queue entry to the packets queue.
@@ -519,6 +525,8 @@ private:
 
   /**
    * Removes all expired data packet entries from the data packets queue.
+   * 
+   * It only visits the entries whose expiration instant has passed.
    */
   void
   Purge ();
@@ -586,9 +594,7 @@ public:
 inline bool
 operator== (const PacketsQueue & lhs, const PacketsQueue & rhs)
 {
-  return lhs.m_max_queue_length == rhs.m_max_queue_length
-          && lhs.m_packets_dropped_counter == rhs.m_packets_dropped_counter
-          && lhs.m_packets_table == rhs.m_packets_table
+  return lhs.m_packets_table == rhs.m_packets_table
           && lhs.m_data_packet_reception_stats == rhs.m_data_packet_reception_stats;
 }
 
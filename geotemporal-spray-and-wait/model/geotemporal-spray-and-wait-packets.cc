@@ -38,6 +38,10 @@
 #define AREA_X2 1
 #define AREA_Y2 0
 
+#define COMPACT_ENCODING 7
+#define SUMMARY_VECTOR_ENCODING_SHIFT 5
+#define SUMMARY_VECTOR_ENCODING_MASK 0x60
+
 
 namespace ns3
 {
@@ -76,13 +80,25 @@ ToString (const PacketType& obj)
 NS_OBJECT_ENSURE_REGISTERED (TypeHeader);
 
 TypeHeader::TypeHeader ()
-: m_packet_type (PacketType::Hello), m_valid (true) { }
+: m_packet_type (PacketType::Hello), m_compact_encoding (false),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit), m_valid (true) { }
 
 TypeHeader::TypeHeader (PacketType packet_type)
-: m_packet_type (packet_type), m_valid (true) { }
+: m_packet_type (packet_type), m_compact_encoding (false),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit), m_valid (true) { }
+
+TypeHeader::TypeHeader (PacketType packet_type, bool compact_encoding)
+: m_packet_type (packet_type), m_compact_encoding (compact_encoding),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit), m_valid (true) { }
+
+TypeHeader::TypeHeader (PacketType packet_type, bool compact_encoding,
+                        SummaryVectorEncoding summary_vector_encoding)
+: m_packet_type (packet_type), m_compact_encoding (compact_encoding),
+m_summary_vector_encoding (summary_vector_encoding), m_valid (true) { }
 
 TypeHeader::TypeHeader (const TypeHeader& copy)
-: m_packet_type (copy.m_packet_type), m_valid (copy.m_valid) { }
+: m_packet_type (copy.m_packet_type), m_compact_encoding (copy.m_compact_encoding),
+m_summary_vector_encoding (copy.m_summary_vector_encoding), m_valid (copy.m_valid) { }
 
 
 // --------------------------
@@ -119,7 +135,12 @@ TypeHeader::GetSerializedSize () const
 void
 TypeHeader::Serialize (Buffer::Iterator start) const
 {
-  start.WriteU8 ((uint8_t) m_packet_type);
+  uint8_t packet_type = (uint8_t) m_packet_type;
+  if (m_compact_encoding) SetBitFlag (packet_type, COMPACT_ENCODING);
+  packet_type |= ((uint8_t) m_summary_vector_encoding << SUMMARY_VECTOR_ENCODING_SHIFT)
+          & SUMMARY_VECTOR_ENCODING_MASK;
+
+  start.WriteU8 (packet_type);
 }
 
 uint32_t
@@ -129,8 +150,28 @@ TypeHeader::Deserialize (Buffer::Iterator start)
 
   uint8_t packet_type = it.ReadU8 ();
 
+  m_compact_encoding = CheckBitFlag (packet_type, COMPACT_ENCODING);
+  ClearBitFlag (packet_type, COMPACT_ENCODING);
+
+  const uint8_t summary_vector_encoding = (packet_type & SUMMARY_VECTOR_ENCODING_MASK)
+          >> SUMMARY_VECTOR_ENCODING_SHIFT;
+  packet_type &= ~SUMMARY_VECTOR_ENCODING_MASK;
+
   m_valid = true;
 
+  // The incremental encoding needs the versions of the summary vectors kept
+  // per neighbor, which this protocol doesn't keep.
+  switch (static_cast<SummaryVectorEncoding> (summary_vector_encoding))
+    {
+    case SummaryVectorEncoding::Explicit:
+    case SummaryVectorEncoding::DeltaCoded:
+    case SummaryVectorEncoding::BloomFilter:
+      m_summary_vector_encoding = static_cast<SummaryVectorEncoding> (summary_vector_encoding);
+      break;
+    default:
+      m_valid = false;
+    }
+
   switch (static_cast<PacketType> (packet_type))
     {
     case PacketType::Hello:
@@ -260,13 +301,20 @@ HelloHeader::ToString () const
 NS_OBJECT_ENSURE_REGISTERED (ReplyHeader);
 
 ReplyHeader::ReplyHeader ()
-: m_summary_vector (), m_reserved (0u) { }
+: m_summary_vector (), m_reserved (0u),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit), m_bloom_filter (),
+m_bloom_filter_entries_count (0u) { }
 
 ReplyHeader::ReplyHeader (const std::set<DataIdentifier>& summary_vector)
-: m_summary_vector (summary_vector), m_reserved (0u) { }
+: m_summary_vector (summary_vector), m_reserved (0u),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit), m_bloom_filter (),
+m_bloom_filter_entries_count (0u) { }
 
 ReplyHeader::ReplyHeader (const ReplyHeader& copy)
-: m_summary_vector (copy.m_summary_vector), m_reserved (copy.m_reserved) { }
+: m_summary_vector (copy.m_summary_vector), m_reserved (copy.m_reserved),
+m_summary_vector_encoding (copy.m_summary_vector_encoding),
+m_bloom_filter (copy.m_bloom_filter),
+m_bloom_filter_entries_count (copy.m_bloom_filter_entries_count) { }
 
 
 // --------------------------
@@ -297,14 +345,60 @@ ReplyHeader::GetInstanceTypeId () const
 uint32_t
 ReplyHeader::GetSerializedSize () const
 {
-  return 3u + (m_summary_vector.size () * 6u);
+  return 3u + GetSummaryVectorSerializedSize ();
 }
 
 void
 ReplyHeader::Serialize (Buffer::Iterator start) const
 {
   start.WriteU8 (m_reserved);
-  start.WriteHtonU16 (m_summary_vector.size ());
+  start.WriteHtonU16 (GetSummaryVectorSize ());
+
+  SerializeSummaryVector (start);
+}
+
+uint32_t
+ReplyHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator it = start;
+
+  m_reserved = it.ReadU8 ();
+
+  const uint16_t summary_vector_size = it.ReadNtohU16 ();
+  DeserializeSummaryVector (it, summary_vector_size);
+
+  uint32_t distance = it.GetDistanceFrom (start);
+  NS_ASSERT (distance == GetSerializedSize ());
+  return distance;
+}
+
+uint32_t
+ReplyHeader::GetSummaryVectorSerializedSize () const
+{
+  switch (m_summary_vector_encoding)
+    {
+    case SummaryVectorEncoding::DeltaCoded:
+      return GetDeltaCodedSerializedSize (m_summary_vector);
+    case SummaryVectorEncoding::BloomFilter:
+      return m_bloom_filter.GetSerializedSize ();
+    default:
+      return m_summary_vector.size () * 6u;
+    }
+}
+
+void
+ReplyHeader::SerializeSummaryVector (Buffer::Iterator& start) const
+{
+  if (m_summary_vector_encoding == SummaryVectorEncoding::DeltaCoded)
+    {
+      WriteDeltaCoded (start, m_summary_vector);
+      return;
+    }
+  else if (m_summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+    {
+      m_bloom_filter.Serialize (start);
+      return;
+    }
 
   bool odd = true;
   for (std::set<DataIdentifier>::const_iterator it = m_summary_vector.begin ();
@@ -324,20 +418,29 @@ ReplyHeader::Serialize (Buffer::Iterator start) const
     }
 }
 
-uint32_t
-ReplyHeader::Deserialize (Buffer::Iterator start)
+void
+ReplyHeader::DeserializeSummaryVector (Buffer::Iterator& it,
+                                       uint16_t summary_vector_size)
 {
-  Buffer::Iterator it = start;
+  if (m_summary_vector_encoding == SummaryVectorEncoding::DeltaCoded)
+    {
+      ReadDeltaCoded (it, m_summary_vector);
+      return;
+    }
+  else if (m_summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+    {
+      m_summary_vector = std::set<DataIdentifier> ();
+      m_bloom_filter.Deserialize (it);
+      m_bloom_filter_entries_count = summary_vector_size;
+      return;
+    }
 
-  m_reserved = it.ReadU8 ();
   m_summary_vector = std::set<DataIdentifier> ();
-
-  const uint16_t data_ids_count = it.ReadNtohU16 ();
   Ipv4Address ip;
   uint16_t id;
   bool odd = true;
 
-  for (uint32_t k = 0; k < data_ids_count; ++k)
+  for (uint32_t k = 0; k < summary_vector_size; ++k)
     {
       if (odd)
         {
@@ -353,10 +456,6 @@ ReplyHeader::Deserialize (Buffer::Iterator start)
       odd = !odd;
       m_summary_vector.insert (DataIdentifier (ip, id));
     }
-
-  uint32_t distance = it.GetDistanceFrom (start);
-  NS_ASSERT (distance == GetSerializedSize ());
-  return distance;
 }
 
 void
@@ -390,14 +489,16 @@ ReplyHeader::ToString () const
 NS_OBJECT_ENSURE_REGISTERED (ReplyBackHeader);
 
 ReplyBackHeader::ReplyBackHeader ()
-: ReplyHeader (), m_position () { }
+: ReplyHeader (), m_position (), m_compact_encoding (false) { }
 
 ReplyBackHeader::ReplyBackHeader (const std::set<DataIdentifier>& summary_vector,
                                   const GeoTemporalLibrary::LibraryUtils::Vector2D& position)
-: ReplyHeader (summary_vector), m_position (position) { }
+: ReplyHeader (summary_vector), m_position (position),
+m_compact_encoding (false) { }
 
 ReplyBackHeader::ReplyBackHeader (const ReplyBackHeader& copy)
-: ReplyHeader (copy), m_position (copy.m_position) { }
+: ReplyHeader (copy), m_position (copy.m_position),
+m_compact_encoding (copy.m_compact_encoding) { }
 
 
 // --------------------------
@@ -417,6 +518,9 @@ ReplyBackHeader::GetTypeId ()
 TypeId
 ReplyBackHeader::GetInstanceTypeId () const
 {
+  if (IsCompactEncoding ())
+    return CompactReplyBackHeader::GetTypeId ();
+
   return GetTypeId ();
 }
 
@@ -428,46 +532,43 @@ ReplyBackHeader::GetInstanceTypeId () const
 uint32_t
 ReplyBackHeader::GetSerializedSize () const
 {
-  return 19u + (m_summary_vector.size () * 6u);
+  if (m_compact_encoding)
+    return 2u + CompactCoordinatesEncoding::GetPositionSerializedSize (m_position)
+            + GetSummaryVectorSerializedSize ();
+
+  return 19u + GetSummaryVectorSerializedSize ();
 }
 
 void
 ReplyBackHeader::Serialize (Buffer::Iterator start) const
 {
-  uint8_t sign_flags = 0u;
-
-  uint32_t x_int, x_float;
-  EncodeDoubleToIntegers (m_position.m_x, x_int, x_float,
-                          sign_flags, COORDINATE_X);
+  if (m_compact_encoding)
+    {
+      start.WriteHtonU16 (GetSummaryVectorSize ());
+      CompactCoordinatesEncoding::WritePosition (start, m_position);
+    }
+  else
+    {
+      uint8_t sign_flags = 0u;
 
-  uint32_t y_int, y_float;
-  EncodeDoubleToIntegers (m_position.m_y, y_int, y_float,
-                          sign_flags, COORDINATE_Y);
+      uint32_t x_int, x_float;
+      EncodeDoubleToIntegers (m_position.m_x, x_int, x_float,
+                              sign_flags, COORDINATE_X);
 
-  start.WriteU8 (sign_flags);
-  start.WriteHtonU16 (m_summary_vector.size ());
+      uint32_t y_int, y_float;
+      EncodeDoubleToIntegers (m_position.m_y, y_int, y_float,
+                              sign_flags, COORDINATE_Y);
 
-  start.WriteHtonU32 (x_int);
-  start.WriteHtonU32 (x_float);
-  start.WriteHtonU32 (y_int);
-  start.WriteHtonU32 (y_float);
+      start.WriteU8 (sign_flags);
+      start.WriteHtonU16 (GetSummaryVectorSize ());
 
-  bool odd = true;
-  for (std::set<DataIdentifier>::const_iterator it = m_summary_vector.begin ();
-          it != m_summary_vector.end (); ++it)
-    {
-      if (odd)
-        {
-          WriteTo (start, it->GetSourceIp ());
-          start.WriteHtonU16 (it->GetSourceId ());
-        }
-      else
-        {
-          start.WriteHtonU16 (it->GetSourceId ());
-          WriteTo (start, it->GetSourceIp ());
-        }
-      odd = !odd;
+      start.WriteHtonU32 (x_int);
+      start.WriteHtonU32 (x_float);
+      start.WriteHtonU32 (y_int);
+      start.WriteHtonU32 (y_float);
     }
+
+  SerializeSummaryVector (start);
 }
 
 uint32_t
@@ -475,40 +576,30 @@ ReplyBackHeader::Deserialize (Buffer::Iterator start)
 {
   Buffer::Iterator it = start;
 
-  const uint8_t sign_flags = it.ReadU8 ();
-  const uint16_t summary_vector_size = it.ReadNtohU16 ();
-
-  uint32_t int_part = it.ReadNtohU32 ();
-  uint32_t float_part = it.ReadNtohU32 ();
-  m_position.m_x = DecodeDoubleFromIntegers (int_part, float_part,
-                                             sign_flags, COORDINATE_X);
+  uint16_t summary_vector_size;
 
-  int_part = it.ReadNtohU32 ();
-  float_part = it.ReadNtohU32 ();
-  m_position.m_y = DecodeDoubleFromIntegers (int_part, float_part,
-                                             sign_flags, COORDINATE_Y);
-
-  m_summary_vector = std::set<DataIdentifier> ();
-  Ipv4Address ip;
-  uint16_t id;
-  bool odd = true;
-
-  for (uint32_t k = 0; k < summary_vector_size; ++k)
+  if (m_compact_encoding)
     {
-      if (odd)
-        {
-          ReadFrom (it, ip);
-          id = it.ReadNtohU16 ();
-        }
-      else
-        {
-          id = it.ReadNtohU16 ();
-          ReadFrom (it, ip);
-        }
-
-      odd = !odd;
-      m_summary_vector.insert (DataIdentifier (ip, id));
+      summary_vector_size = it.ReadNtohU16 ();
+      m_position = CompactCoordinatesEncoding::ReadPosition (it);
     }
+  else
+    {
+      const uint8_t sign_flags = it.ReadU8 ();
+      summary_vector_size = it.ReadNtohU16 ();
+
+      uint32_t int_part = it.ReadNtohU32 ();
+      uint32_t float_part = it.ReadNtohU32 ();
+      m_position.m_x = DecodeDoubleFromIntegers (int_part, float_part,
+                                                 sign_flags, COORDINATE_X);
+
+      int_part = it.ReadNtohU32 ();
+      float_part = it.ReadNtohU32 ();
+      m_position.m_y = DecodeDoubleFromIntegers (int_part, float_part,
+                                                 sign_flags, COORDINATE_Y);
+    }
+
+  DeserializeSummaryVector (it, summary_vector_size);
 
   uint32_t distance = it.GetDistanceFrom (start);
   NS_ASSERT (distance == GetSerializedSize ());
@@ -540,6 +631,34 @@ ReplyBackHeader::ToString () const
 }
 
 
+// =============================================================================
+//                           CompactReplyBackHeader
+// =============================================================================
+
+NS_OBJECT_ENSURE_REGISTERED (CompactReplyBackHeader);
+
+CompactReplyBackHeader::CompactReplyBackHeader ()
+: ReplyBackHeader ()
+{
+  SetCompactEncoding (true);
+}
+
+
+// --------------------------
+// Type ID
+// --------------------------
+
+TypeId
+CompactReplyBackHeader::GetTypeId ()
+{
+  static TypeId type_id = TypeId ("ns3::geotemporal_spray_and_wait::CompactReplyBackHeader")
+          .SetParent<ReplyBackHeader> ()
+          .SetGroupName ("Geotemporal-spray-and-wait")
+          .AddConstructor<CompactReplyBackHeader> ();
+  return type_id;
+}
+
+
 // =============================================================================
 //                                  DataHeader
 // =============================================================================
@@ -548,18 +667,20 @@ NS_OBJECT_ENSURE_REGISTERED (DataHeader);
 
 DataHeader::DataHeader ()
 : m_data_id (), m_dest_geo_temporal_area (), m_message (),
-m_replicas_to_forward (0u) { }
+m_replicas_to_forward (0u), m_compact_encoding (false) { }
 
 DataHeader::DataHeader (const DataIdentifier& data_id,
                         const GeoTemporalArea& destination_geo_temporal_area,
                         const std::string message,
                         const uint32_t& replicas_to_forward)
 : m_data_id (data_id), m_dest_geo_temporal_area (destination_geo_temporal_area),
-m_message (message), m_replicas_to_forward (replicas_to_forward) { }
+m_message (message), m_replicas_to_forward (replicas_to_forward),
+m_compact_encoding (false) { }
 
 DataHeader::DataHeader (const DataHeader& copy)
 : m_data_id (copy.m_data_id), m_dest_geo_temporal_area (copy.m_dest_geo_temporal_area),
-m_message (copy.m_message), m_replicas_to_forward (copy.m_replicas_to_forward) { }
+m_message (copy.m_message), m_replicas_to_forward (copy.m_replicas_to_forward),
+m_compact_encoding (copy.m_compact_encoding) { }
 
 
 // --------------------------
@@ -579,6 +700,9 @@ DataHeader::GetTypeId ()
 TypeId
 DataHeader::GetInstanceTypeId () const
 {
+  if (IsCompactEncoding ())
+    return CompactDataHeader::GetTypeId ();
+
   return GetTypeId ();
 }
 
@@ -590,12 +714,36 @@ DataHeader::GetInstanceTypeId () const
 uint32_t
 DataHeader::GetSerializedSize () const
 {
-  return 47u + m_message.length () + 1u;
+  if (m_compact_encoding)
+    {
+      // 6 bytes of DATA ID, 4 bytes of temporal scope and 1 byte of the null
+      // terminator of the message.
+      return 11u + GetVarIntSerializedSize (m_replicas_to_forward)
+              + CompactCoordinatesEncoding::GetAreaSerializedSize (m_dest_geo_temporal_area.GetArea ())
+              + m_message.Size ();
+    }
+
+  return 47u + m_message.Size () + 1u;
 }
 
 void
 DataHeader::Serialize (Buffer::Iterator start) const
 {
+  if (m_compact_encoding)
+    {
+      start.WriteHtonU16 (m_data_id.GetSourceId ());
+      WriteTo (start, m_data_id.GetSourceIp ());
+
+      WriteVarInt (start, m_replicas_to_forward);
+      CompactCoordinatesEncoding::WriteArea (start, m_dest_geo_temporal_area.GetArea ());
+
+      start.WriteHtonU16 ((uint32_t) m_dest_geo_temporal_area.GetTimePeriod ().GetStartTime ().GetSeconds ());
+      start.WriteHtonU16 ((uint32_t) m_dest_geo_temporal_area.GetDuration ().GetSeconds ());
+
+      m_message.Write (start);
+      return;
+    }
+
   uint8_t sign_flags = 0u;
 
   uint32_t x1_int, x1_float;
@@ -636,9 +784,7 @@ DataHeader::Serialize (Buffer::Iterator start) const
   start.WriteHtonU16 ((uint32_t) m_dest_geo_temporal_area.GetTimePeriod ().GetStartTime ().GetSeconds ());
   start.WriteHtonU16 ((uint32_t) m_dest_geo_temporal_area.GetDuration ().GetSeconds ());
 
-  char chars_buffer [m_message.length () + 1u];
-  std::strcpy (chars_buffer, m_message.c_str ());
-  start.Write ((uint8_t *) chars_buffer, std::strlen (chars_buffer) + 1u);
+  m_message.Write (start);
 }
 
 uint32_t
@@ -646,6 +792,33 @@ DataHeader::Deserialize (Buffer::Iterator start)
 {
   Buffer::Iterator it = start;
 
+  if (m_compact_encoding)
+    {
+      // Read DATA packet ID
+      const uint16_t data_source_id = it.ReadNtohU16 ();
+      Ipv4Address data_source_ip;
+      ReadFrom (it, data_source_ip);
+
+      m_data_id = DataIdentifier (data_source_ip, data_source_id);
+
+      m_replicas_to_forward = (uint32_t) ReadVarInt (it);
+      const Area area = CompactCoordinatesEncoding::ReadArea (it);
+
+      // Read temporal scope's start time and duration. Then calculate end time.
+      Time start_time = Seconds (it.ReadNtohU16 ());
+      Time duration = Seconds (it.ReadNtohU16 ());
+      Time end_time = TimePeriod::CalculateEndTime (start_time, duration);
+
+      m_dest_geo_temporal_area = GeoTemporalArea (TimePeriod (start_time, end_time), area);
+
+      // Read the string message (including its null terminator character).
+      m_message.Read (it);
+
+      uint32_t distance = it.GetDistanceFrom (start);
+      NS_ASSERT (distance == GetSerializedSize ());
+      return distance;
+    }
+
   const uint8_t sign_flags = it.ReadU8 ();
 
   // Read DATA packet ID
@@ -682,27 +855,8 @@ DataHeader::Deserialize (Buffer::Iterator start)
   m_dest_geo_temporal_area = GeoTemporalArea (TimePeriod (start_time, end_time),
                                               Area (area_x1, area_y1, area_x2, area_y2));
 
-  // Read the string message.
-  uint8_t character_read = 0u;
-  uint32_t message_size = 0u;
-  Buffer::Iterator temporal_it = it;
-
-  // Find the size/length of the message by counting the number of characters 
-  // before the null terminator character is found. The null terminator character
-  // is also counted.
-  do
-    {
-      character_read = temporal_it.ReadU8 ();
-      ++message_size;
-    }
-  while (character_read != 0u);
-
-  // Read the message-size characters from the iterator-buffer.
-  char message_buffer [message_size];
-  it.Read ((uint8_t *) message_buffer, message_size);
-
-  // Store the message in a C++ std::string.
-  m_message = std::string (message_buffer);
+  // Read the string message (including its null terminator character).
+  m_message.Read (it);
 
   uint32_t distance = it.GetDistanceFrom (start);
   NS_ASSERT (distance == GetSerializedSize ());
@@ -730,12 +884,40 @@ DataHeader::ToString () const
   std::sprintf (buffer, "%04.2f", m_dest_geo_temporal_area.GetDuration ().GetSeconds ());
   str += " with a duration of " + std::string (buffer) + " seconds";
 
-  std::sprintf (buffer, "%u", (uint32_t) m_message.size ());
+  std::sprintf (buffer, "%u", m_message.Size ());
   str += " has a message of " + std::string (buffer) + " byte(s)";
   return str;
 }
 
 
+// =============================================================================
+//                              CompactDataHeader
+// =============================================================================
+
+NS_OBJECT_ENSURE_REGISTERED (CompactDataHeader);
+
+CompactDataHeader::CompactDataHeader ()
+: DataHeader ()
+{
+  SetCompactEncoding (true);
+}
+
+
+// --------------------------
+// Type ID
+// --------------------------
+
+TypeId
+CompactDataHeader::GetTypeId ()
+{
+  static TypeId type_id = TypeId ("ns3::geotemporal_spray_and_wait::CompactDataHeader")
+          .SetParent<DataHeader> ()
+          .SetGroupName ("Geotemporal-spray-and-wait")
+          .AddConstructor<CompactDataHeader> ();
+  return type_id;
+}
+
+
 } // namespace geotemporal_spray_and_wait
 } // namespace ns3
 
@@ -28,6 +28,8 @@
 
 #include <ns3/address.h>
 #include <ns3/boolean.h>
+#include <ns3/double.h>
+#include <ns3/enum.h>
 #include <ns3/ipv4-l3-protocol.h>
 #include <ns3/log.h>
 #include <ns3/mobility-model.h>
@@ -58,7 +60,15 @@ m_hello_timer (Timer::CANCEL_ON_DESTROY),
 m_packets_queue_capacity (128u),
 m_neighbor_expiration_time (Seconds (10)),
 m_default_data_packet_replicas (32u),
+m_replica_allocation (ReplicaAllocation::Fixed),
+m_min_data_packet_replicas (2u),
+m_max_data_packet_replicas (128u),
+m_replica_reference_neighbors (5.0),
+m_replica_reference_lifetime (Seconds (300)),
 m_binary_mode (false),
+m_compact_header_encoding (false),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit),
+m_summary_vector_false_positive_rate (0.01),
 m_node_id (-1),
 m_ipv4 (0),
 m_selected_interface_index (-1),
@@ -66,6 +76,7 @@ m_last_known_selected_interface_index (-1),
 m_selected_interface_address (),
 m_unicast_socket (0),
 m_broadcast_socket (0),
+m_replica_allocation_policy (0),
 m_data_sequential_id (0u),
 m_packets_queue (m_binary_mode, m_packets_queue_capacity),
 m_neighbors_table (m_neighbor_expiration_time),
@@ -104,10 +115,45 @@ RoutingProtocol::GetTypeId ()
                          UintegerValue (32),
                          MakeUintegerAccessor (&RoutingProtocol::m_default_data_packet_replicas),
                          MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("ReplicaAllocation", "Policy to allocate the replicas of the data packets created by the node.",
+                         EnumValue ((int) ReplicaAllocation::Fixed),
+                         MakeEnumAccessor (&RoutingProtocol::SetReplicaAllocation),
+                         MakeEnumChecker ((int) ReplicaAllocation::Fixed, "Fixed",
+                                          (int) ReplicaAllocation::DensityAdaptive, "DensityAdaptive"))
+          .AddAttribute ("MinDataPacketReplicas", "Minimum number of replicas of each created data packet of the density-adaptive replica allocation.",
+                         UintegerValue (2),
+                         MakeUintegerAccessor (&RoutingProtocol::m_min_data_packet_replicas),
+                         MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("MaxDataPacketReplicas", "Maximum number of replicas of each created data packet of the density-adaptive replica allocation.",
+                         UintegerValue (128),
+                         MakeUintegerAccessor (&RoutingProtocol::m_max_data_packet_replicas),
+                         MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("ReplicaReferenceNeighbors", "Number of recently contacted neighbor nodes with which the density-adaptive replica allocation gives DataPacketReplicas replicas.",
+                         DoubleValue (5.0),
+                         MakeDoubleAccessor (&RoutingProtocol::m_replica_reference_neighbors),
+                         MakeDoubleChecker<double> (1.0))
+          .AddAttribute ("ReplicaReferenceLifetime", "Remaining lifetime of a created data packet with which the density-adaptive replica allocation gives DataPacketReplicas replicas.",
+                         TimeValue (Seconds (300)),
+                         MakeTimeAccessor (&RoutingProtocol::m_replica_reference_lifetime),
+                         MakeTimeChecker (Seconds (1)))
           .AddAttribute ("BinaryMode", "Indicates if the Spray And Wait protocol works in Binary mode (true) or normal mode (false).",
                          BooleanValue (false),
                          MakeBooleanAccessor (&RoutingProtocol::m_binary_mode),
                          MakeBooleanChecker ())
+          .AddAttribute ("CompactHeaderEncoding", "Transmit positions and areas with the compact (fixed-point, variable-length) encoding.",
+                         BooleanValue (false),
+                         MakeBooleanAccessor (&RoutingProtocol::m_compact_header_encoding),
+                         MakeBooleanChecker ())
+          .AddAttribute ("SummaryVectorEncoding", "Encoding of the summary vectors of the transmitted REPLY packets.",
+                         EnumValue ((int) SummaryVectorEncoding::Explicit),
+                         MakeEnumAccessor (&RoutingProtocol::SetSummaryVectorEncoding),
+                         MakeEnumChecker ((int) SummaryVectorEncoding::Explicit, "Explicit",
+                                          (int) SummaryVectorEncoding::DeltaCoded, "DeltaCoded",
+                                          (int) SummaryVectorEncoding::BloomFilter, "BloomFilter"))
+          .AddAttribute ("SummaryVectorFalsePositiveRate", "False positive rate of the Bloom filters of the transmitted summary vectors.",
+                         DoubleValue (0.01),
+                         MakeDoubleAccessor (&RoutingProtocol::m_summary_vector_false_positive_rate),
+                         MakeDoubleChecker<double> (0.0001, 0.5))
           .AddAttribute ("UniformRv", "Access to the underlying UniformRandomVariable",
                          StringValue ("ns3::UniformRandomVariable"),
                          MakePointerAccessor (&RoutingProtocol::m_uniform_random_variable),
@@ -658,6 +704,8 @@ RoutingProtocol::RecvSprayAndWaitPacket (Ptr<Socket> socket)
 
   NS_ASSERT (type_header.IsValid ());
 
+  const bool compact_encoding = type_header.IsCompactEncoding ();
+
   NS_LOG_DEBUG ("Spray & Wait " << type_header << " packet received from node "
                 << sender_node_ip);
 
@@ -667,13 +715,14 @@ RoutingProtocol::RecvSprayAndWaitPacket (Ptr<Socket> socket)
       RecvHelloPacket (received_packet, sender_node_ip);
       return;
     case PacketType::Reply:
-      RecvReplyPacket (received_packet, sender_node_ip);
+      RecvReplyPacket (received_packet, sender_node_ip, type_header.GetSummaryVectorEncoding ());
       return;
     case PacketType::ReplyBack:
-      RecvReplyBackPacket (received_packet, sender_node_ip);
+      RecvReplyBackPacket (received_packet, sender_node_ip, compact_encoding,
+                           type_header.GetSummaryVectorEncoding ());
       return;
     case PacketType::Data:
-      RecvDataPacket (received_packet, sender_node_ip);
+      RecvDataPacket (received_packet, sender_node_ip, compact_encoding);
       return;
     default:
       NS_ABORT_MSG ("ERROR: Unknown packet type.");
@@ -712,30 +761,69 @@ RoutingProtocol::RecvHelloPacket (Ptr<Packet> received_packet, const Ipv4Address
 }
 
 void
-RoutingProtocol::RecvReplyPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip)
+RoutingProtocol::RecvReplyPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip,
+                                  SummaryVectorEncoding summary_vector_encoding)
 {
-  NS_LOG_FUNCTION (this << received_packet << sender_node_ip);
+  NS_LOG_FUNCTION (this << received_packet << sender_node_ip << summary_vector_encoding);
 
   NS_LOG_DEBUG ("Processing REPLY packet received from " << sender_node_ip);
 
   ReplyHeader reply_header;
+  reply_header.SetSummaryVectorEncoding (summary_vector_encoding);
   received_packet->RemoveHeader (reply_header);
 
+  if (summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+    {
+      // The packets of the neighbor node that I don't know can't be listed
+      // from a Bloom filter, so I send the Bloom filter of my summary vector to
+      // let it compute the packets that it has to send.
+      NS_LOG_DEBUG ("Answer with a REPLY BACK packet (Bloom filter) to node " << sender_node_ip);
+      SendReplyBackFilterPacket (sender_node_ip);
+      return;
+    }
+
   // Answer with a REPLY BACK packet
   NS_LOG_DEBUG ("Answer with a REPLY BACK packet to node " << sender_node_ip);
   SendReplyBackPacket (sender_node_ip, reply_header.GetSummaryVector ());
 }
 
 void
-RoutingProtocol::RecvReplyBackPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip)
+RoutingProtocol::RecvReplyBackPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip,
+                                      bool compact_encoding,
+                                      SummaryVectorEncoding summary_vector_encoding)
 {
-  NS_LOG_FUNCTION (this << received_packet << sender_node_ip);
+  NS_LOG_FUNCTION (this << received_packet << sender_node_ip << compact_encoding
+                   << summary_vector_encoding);
 
   NS_LOG_DEBUG ("Processing REPLY_BACK packet received from " << sender_node_ip);
 
   ReplyBackHeader reply_back_header;
+  reply_back_header.SetCompactEncoding (compact_encoding);
+  reply_back_header.SetSummaryVectorEncoding (summary_vector_encoding);
   received_packet->RemoveHeader (reply_back_header);
 
+  if (summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+    {
+      // The neighbor node sent the Bloom filter of its whole summary vector,
+      // compute the packets that it doesn't know.
+      std::set<DataIdentifier> requested_packets;
+      m_packets_queue.ProcessDisjointVector (reply_back_header.GetBloomFilter (), requested_packets);
+
+      // The requested packets may be empty due to false positives of the filter.
+      if (requested_packets.empty ())
+        {
+          NS_LOG_DEBUG ("No DATA packets unknown by the neighbor node " << sender_node_ip);
+          return;
+        }
+
+      NS_LOG_DEBUG ("Send all " << requested_packets.size ()
+                    << " packets unknown by node " << sender_node_ip);
+      SendRequestedDataPackets (/*Requested packets*/ requested_packets,
+                                /*Destination node IP*/ sender_node_ip,
+                                /*Destination node position*/ reply_back_header.GetPosition ());
+      return;
+    }
+
   if (reply_back_header.GetSummaryVectorSize () == 0)
     {
       NS_LOG_DEBUG ("REPLY_BACK (REQUEST) packet with empty disjoint vector.");
@@ -750,11 +838,13 @@ RoutingProtocol::RecvReplyBackPacket (Ptr<Packet> received_packet, const Ipv4Add
 }
 
 void
-RoutingProtocol::RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip)
+RoutingProtocol::RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip,
+                                 bool compact_encoding)
 {
-  NS_LOG_FUNCTION (this << received_packet << sender_node_ip);
+  NS_LOG_FUNCTION (this << received_packet << sender_node_ip << compact_encoding);
 
   DataHeader data_header;
+  data_header.SetCompactEncoding (compact_encoding);
   received_packet->RemoveHeader (data_header);
   NS_LOG_DEBUG ("Received DATA packet " << data_header.GetDataIdentifier ()
                 << " from " << sender_node_ip);
@@ -779,10 +869,16 @@ RoutingProtocol::NewMessage (const std::string& message,
 
   const DataIdentifier data_id (local_ip, m_data_sequential_id++);
 
+  // The recently contacted neighbor nodes estimate the density of nodes.
+  const uint32_t replicas
+          = m_replica_allocation_policy->GetInitialReplicas (m_neighbors_table.Size (),
+                                                             destination_gta.GetTimePeriod ().GetEndTime ()
+                                                             - Simulator::Now ());
+
   const DataHeader data_packet (/*Data ID*/ data_id,
                                 /*Dest. geo-temporal area*/ destination_gta,
                                 /*Message*/ message,
-                                /*Replicas to forward*/ m_default_data_packet_replicas);
+                                /*Replicas to forward*/ replicas);
 
   const bool enqueued = m_packets_queue.Enqueue (data_packet, local_ip);
   NS_ABORT_MSG_UNLESS (enqueued, "Message must be enqueued successfully.");
@@ -883,11 +979,21 @@ RoutingProtocol::SendReplyPacket (const Ipv4Address& destination_node)
   m_packets_queue.GetSummaryVector (known_packets_vector);
 
   ReplyHeader reply_header (known_packets_vector);
+  reply_header.SetSummaryVectorEncoding (m_summary_vector_encoding);
+
+  if (m_summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+    {
+      reply_header.SetBloomFilter (DataIdentifierBloomFilter (known_packets_vector,
+                                                              m_summary_vector_false_positive_rate),
+                                   known_packets_vector.size ());
+    }
+
   NS_LOG_DEBUG ("Constructed REPLY packet: " << reply_header);
 
   Ptr<Packet> packet_to_send = Create<Packet> ();
+  // The REPLY header has no coordinates, so the compact encoding is not set.
   packet_to_send->AddHeader (reply_header);
-  packet_to_send->AddHeader (TypeHeader (PacketType::Reply));
+  packet_to_send->AddHeader (TypeHeader (PacketType::Reply, false, m_summary_vector_encoding));
 
   // Transmit the packet
   if (SendUnicastPacket (packet_to_send, destination_node))
@@ -924,13 +1030,67 @@ RoutingProtocol::SendReplyBackPacket (const Ipv4Address& destination_node,
   NS_LOG_DEBUG ("Processed disjoint vector has " << requested_packets.size ()
                 << " packets.");
 
+  // The disjoint vector is exact, so it's never sent as a Bloom filter.
+  const SummaryVectorEncoding summary_vector_encoding
+          = m_summary_vector_encoding == SummaryVectorEncoding::Explicit
+          ? SummaryVectorEncoding::Explicit : SummaryVectorEncoding::DeltaCoded;
+
   ReplyBackHeader reply_back_header (/*Disjoint vector*/ requested_packets,
                                      /*Node position*/ my_position);
+  reply_back_header.SetSummaryVectorEncoding (summary_vector_encoding);
+  NS_LOG_DEBUG ("Constructed REPLY_BACK packet: " << reply_back_header);
+
+  reply_back_header.SetCompactEncoding (m_compact_header_encoding);
+
+  Ptr<Packet> packet_to_send = Create<Packet> ();
+  packet_to_send->AddHeader (reply_back_header);
+  packet_to_send->AddHeader (TypeHeader (PacketType::ReplyBack, m_compact_header_encoding,
+                                         summary_vector_encoding));
+
+  // Transmit the packet
+  if (SendUnicastPacket (packet_to_send, destination_node))
+    {
+      // Count the transmitted packet
+      uint32_t packet_size = RoutingProtocol::CalculateCompletePacketSize (packet_to_send);
+      m_tx_packets_counter.CountPacket (PacketClass::Control, packet_size);
+
+      NS_LOG_DEBUG ("REPLY_BACK packet sent from " << m_selected_interface_address.GetLocal ()
+                    << " to " << destination_node);
+    }
+  else
+    {
+      NS_LOG_DEBUG ("REPLY_BACK packet could not be sent to " << destination_node
+                    << " (maybe node is disabled).");
+    }
+}
+
+void
+RoutingProtocol::SendReplyBackFilterPacket (const Ipv4Address& destination_node)
+{
+  NS_LOG_FUNCTION (this << destination_node);
+
+  // I received a REPLY with a Bloom filter, construct a REPLY BACK with the
+  // Bloom filter of my summary vector.
+  std::set<DataIdentifier> known_packets_vector;
+  m_packets_queue.GetSummaryVector (known_packets_vector);
+
+  Vector2D my_position, my_velocity;
+  GetNodeMobility (my_position, my_velocity);
+
+  ReplyBackHeader reply_back_header (/*Summary vector*/ std::set<DataIdentifier> (),
+                                     /*Node position*/ my_position);
+  reply_back_header.SetSummaryVectorEncoding (SummaryVectorEncoding::BloomFilter);
+  reply_back_header.SetBloomFilter (DataIdentifierBloomFilter (known_packets_vector,
+                                                               m_summary_vector_false_positive_rate),
+                                    known_packets_vector.size ());
   NS_LOG_DEBUG ("Constructed REPLY_BACK packet: " << reply_back_header);
 
+  reply_back_header.SetCompactEncoding (m_compact_header_encoding);
+
   Ptr<Packet> packet_to_send = Create<Packet> ();
   packet_to_send->AddHeader (reply_back_header);
-  packet_to_send->AddHeader (TypeHeader (PacketType::ReplyBack));
+  packet_to_send->AddHeader (TypeHeader (PacketType::ReplyBack, m_compact_header_encoding,
+                                         SummaryVectorEncoding::BloomFilter));
 
   // Transmit the packet
   if (SendUnicastPacket (packet_to_send, destination_node))
@@ -1038,9 +1198,12 @@ RoutingProtocol::SendDataPacket (const Ipv4Address destination_ip,
 {
   NS_LOG_FUNCTION (this << destination_ip << data_to_send);
 
+  DataHeader data_header (data_to_send);
+  data_header.SetCompactEncoding (m_compact_header_encoding);
+
   Ptr<Packet> packet_to_send = Create<Packet> ();
-  packet_to_send->AddHeader (data_to_send);
-  packet_to_send->AddHeader (TypeHeader (PacketType::Data));
+  packet_to_send->AddHeader (data_header);
+  packet_to_send->AddHeader (TypeHeader (PacketType::Data, m_compact_header_encoding));
 
   // Transmit the packet
   if (SendUnicastPacket (packet_to_send, destination_ip))
@@ -1072,6 +1235,22 @@ RoutingProtocol::Start ()
                 << "a capacity of " << m_packets_queue_capacity << " packets.");
   m_packets_queue = PacketsQueue (m_binary_mode, m_packets_queue_capacity);
 
+  // A policy set with SetReplicaAllocationPolicy is kept.
+  if (m_replica_allocation_policy == 0)
+    {
+      NS_LOG_DEBUG ("Initialize " << (m_replica_allocation == ReplicaAllocation::Fixed ? "fixed" : "density-adaptive")
+                    << " replica allocation policy.");
+
+      if (m_replica_allocation == ReplicaAllocation::Fixed)
+        m_replica_allocation_policy = Create<FixedReplicaAllocationPolicy> (m_default_data_packet_replicas);
+      else
+        m_replica_allocation_policy = Create<DensityAdaptiveReplicaAllocationPolicy> (m_default_data_packet_replicas,
+                                                                                      m_min_data_packet_replicas,
+                                                                                      m_max_data_packet_replicas,
+                                                                                      m_replica_reference_neighbors,
+                                                                                      m_replica_reference_lifetime);
+    }
+
   NS_LOG_DEBUG ("Initialize neighbors table with an expiration time of "
                 << m_neighbor_expiration_time.GetSeconds () << " seconds.");
   m_neighbors_table = NeighborsTable (m_neighbor_expiration_time);
@@ -92,12 +92,46 @@ private:
   /** Number of replicas of each data packet allowed to be transmitted. */
   uint32_t m_default_data_packet_replicas;
 
+  /** Built-in policy to allocate the replicas of the data packets created by the node. */
+  ReplicaAllocation m_replica_allocation;
+
+  /** Minimum number of replicas of the density-adaptive replica allocation. */
+  uint32_t m_min_data_packet_replicas;
+
+  /** Maximum number of replicas of the density-adaptive replica allocation. */
+  uint32_t m_max_data_packet_replicas;
+
+  /**
+   * Number of recently contacted neighbor nodes with which the density-adaptive
+   * replica allocation gives the default number of replicas.
+   */
+  double m_replica_reference_neighbors;
+
+  /**
+   * Remaining lifetime of a packet with which the density-adaptive replica 
+   * allocation gives the default number of replicas.
+   */
+  Time m_replica_reference_lifetime;
+
   /** Flag that indicates if the Spray And Wait protocol works in Binary or normal mode. 
    * \c true for Binary mode,
    * \c false for Normal mode.
    */
   bool m_binary_mode;
 
+  /**
+   * Indicates if the transmitted packets use the compact coordinates encoding
+   * for positions and areas. Received packets are decoded according to the
+   * flag in their type header regardless of this value.
+   */
+  bool m_compact_header_encoding;
+
+  /** Encoding of the summary vectors of the transmitted REPLY packets. */
+  SummaryVectorEncoding m_summary_vector_encoding;
+
+  /** False positive rate of the Bloom filters of the transmitted summary vectors. */
+  double m_summary_vector_false_positive_rate;
+
 
   // ---------------------
   // Internal variables
@@ -155,6 +189,9 @@ private:
   /** Provides uniform random variables. */
   Ptr<UniformRandomVariable> m_uniform_random_variable;
 
+  /** Policy that allocates the replicas of the data packets created by the node. */
+  Ptr<const ReplicaAllocationPolicy> m_replica_allocation_policy;
+
   /** Data packets sequential number. Each time it's used it must be incremented. */
   uint16_t m_data_sequential_id;
 
@@ -219,6 +256,50 @@ public:
     m_node_id = node_id;
   }
 
+  inline SummaryVectorEncoding
+  GetSummaryVectorEncoding () const
+  {
+    return m_summary_vector_encoding;
+  }
+
+  /**
+   * Sets the encoding of the summary vectors of the transmitted REPLY packets.
+   * It takes an integer to be used as the setter of the enum attribute.
+   */
+  inline void
+  SetSummaryVectorEncoding (int summary_vector_encoding)
+  {
+    m_summary_vector_encoding = static_cast<SummaryVectorEncoding> (summary_vector_encoding);
+  }
+
+  inline ReplicaAllocation
+  GetReplicaAllocation () const
+  {
+    return m_replica_allocation;
+  }
+
+  /**
+   * Sets the built-in policy to allocate the replicas of the data packets
+   * created by the node. It takes an integer to be used as the setter of the
+   * enum attribute.
+   */
+  inline void
+  SetReplicaAllocation (int replica_allocation)
+  {
+    m_replica_allocation = static_cast<ReplicaAllocation> (replica_allocation);
+  }
+
+  /**
+   * Sets the policy that allocates the replicas of the data packets created by
+   * the node, in place of the built-in policy selected by the 
+   * <code>ReplicaAllocation</code> attribute.
+   */
+  inline void
+  SetReplicaAllocationPolicy (Ptr<const ReplicaAllocationPolicy> replica_allocation_policy)
+  {
+    m_replica_allocation_policy = replica_allocation_policy;
+  }
+
   /** Returns the statistics of all received data packets by the node. */
   inline const std::map<DataIdentifier, DataPacketReceptionStats> &
   GetNodePacketReceptionStats () const
@@ -330,9 +411,11 @@ private:
    * top. The packet is modified, so if you want to conserve the original make
    * sure to use a copy of the received packet.
    * @param sender_node_ip [IN] IP address of the node that sent the packet.
+   * @param summary_vector_encoding [IN] Encoding of the received summary vector.
    */
   void
-  RecvReplyPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip);
+  RecvReplyPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip,
+                   SummaryVectorEncoding summary_vector_encoding);
 
   /**
    * Processes the received REPLY_BACK packets.
@@ -341,9 +424,14 @@ private:
    * top. The packet is modified, so if you want to conserve the original make
    * sure to use a copy of the received packet.
    * @param sender_node_ip [IN] IP address of the node that sent the packet.
+   * @param compact_encoding [IN] Indicates if the received header uses the
+   * compact coordinates encoding.
+   * @param summary_vector_encoding [IN] Encoding of the received summary vector.
    */
   void
-  RecvReplyBackPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip);
+  RecvReplyBackPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip,
+                       bool compact_encoding,
+                       SummaryVectorEncoding summary_vector_encoding);
 
   /**
    * Processes the received DATA packets.
@@ -352,9 +440,12 @@ private:
    * top. The packet is modified, so if you want to conserve the original make
    * sure to use a copy of the received packet.
    * @param sender_node_ip [IN] IP address of the node that sent the packet.
+   * @param compact_encoding [IN] Indicates if the received header uses the
+   * compact coordinates encoding.
    */
   void
-  RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip);
+  RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip,
+                  bool compact_encoding);
 
 
 
@@ -412,6 +503,15 @@ private:
   SendReplyBackPacket (const Ipv4Address & destination_node,
                        const std::set<DataIdentifier> & received_summary_vector);
 
+  /**
+   * Sends a REPLY_BACK packet with the Bloom filter of the whole summary vector
+   * of the local node to the specified destination node. It is the answer to a
+   * REPLY with a Bloom filter, whose locally unknown packets can't be listed, so
+   * the REPLY sender computes the packets to send from it.
+   */
+  void
+  SendReplyBackFilterPacket (const Ipv4Address & destination_node);
+
   /**
    * Schedules the transmission of all the available DATA packets in the received 
    * request to the specified destination IP address of the requesting node.
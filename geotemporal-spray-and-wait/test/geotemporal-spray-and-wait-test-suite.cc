@@ -233,6 +233,79 @@ public:
     NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
   }
 
+  void
+  TestCompactEncodingFlag ()
+  {
+    TypeHeader h1 (PacketType::Data, true);
+    NS_TEST_EXPECT_MSG_EQ (h1.IsCompactEncoding (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 1u, "Must be 1u");
+
+    TypeHeader h2 (PacketType::Data);
+    NS_TEST_EXPECT_MSG_EQ (h2.IsCompactEncoding (), false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ ((h1 == h2), false, "Must be different");
+
+    h2.SetCompactEncoding (true);
+    NS_TEST_EXPECT_MSG_EQ (h1, h2, "Must be equal");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (TypeHeader (PacketType::Hello));
+    packet->AddHeader (h1);
+
+    TypeHeader deserialized;
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetPacketType (), PacketType::Data, "Must be Data");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsCompactEncoding (), true, "Must be true");
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetPacketType (), PacketType::Hello, "Must be Hello");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsCompactEncoding (), false, "Must be false");
+  }
+
+  void
+  TestSummaryVectorEncoding ()
+  {
+    TypeHeader h1 (PacketType::Reply, true, SummaryVectorEncoding::BloomFilter);
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSummaryVectorEncoding (), SummaryVectorEncoding::BloomFilter,
+                           "Must be BloomFilter");
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 1u, "Must be 1u");
+
+    TypeHeader h2 (PacketType::ReplyBack, false, SummaryVectorEncoding::DeltaCoded);
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSummaryVectorEncoding (), SummaryVectorEncoding::DeltaCoded,
+                           "Must be DeltaCoded");
+
+    TypeHeader h3 (PacketType::ReplyBack);
+    NS_TEST_EXPECT_MSG_EQ (h3.GetSummaryVectorEncoding (), SummaryVectorEncoding::Explicit,
+                           "Must be Explicit");
+    NS_TEST_EXPECT_MSG_EQ ((h2 == h3), false, "Must be different");
+
+    h3.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+    NS_TEST_EXPECT_MSG_EQ (h2, h3, "Must be equal");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h2);
+    packet->AddHeader (h1);
+
+    TypeHeader deserialized;
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized, h1, "Serialization and deserialization works");
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized, h2, "Serialization and deserialization works");
+
+    // The incremental summary vector encoding (bits 5-6 set) isn't supported.
+    uint8_t incremental_encoding = 0x60 | (uint8_t) PacketType::Reply;
+    packet = Create<Packet> (&incremental_encoding, 1u);
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), false, "Must be false");
+  }
+
   void
   DoRun () override
   {
@@ -240,6 +313,8 @@ public:
     TestGettersSetters ();
     TestOverloadedOperators ();
     TestSerializationDeserialization ();
+    TestCompactEncodingFlag ();
+    TestSummaryVectorEncoding ();
   }
 };
 
@@ -666,6 +741,142 @@ public:
     NS_TEST_EXPECT_MSG_EQ (h.ToString (), expected_str, "Expected string: " + expected_str);
   }
 
+  void
+  TestCompactSerializationDeserialization ()
+  {
+    std::set<DataIdentifier> summary_vector = {DataIdentifier (Ipv4Address ("1.1.1.1"), 1),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 2),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 3)};
+
+    ReplyBackHeader h1;
+    ReplyBackHeader h2 (std::set<DataIdentifier>({DataIdentifier (Ipv4Address ("1.1.1.1"), 1)}),
+                        GeoTemporalLibrary::LibraryUtils::Vector2D (-54, 23));
+    ReplyBackHeader h3 (summary_vector, GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4));
+
+    h1.SetCompactEncoding (true);
+    h2.SetCompactEncoding (true);
+    h3.SetCompactEncoding (true);
+
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 4u, "Must be 4u");
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSerializedSize (), 14u, "Must be 14u");
+    NS_TEST_EXPECT_MSG_EQ (h3.GetSerializedSize (), 24u, "Must be 24u");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+    packet->AddHeader (h2);
+    packet->AddHeader (h3);
+
+    ReplyBackHeader deserialized;
+    deserialized.SetCompactEncoding (true);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 24u, "Compact ReplyBackHeader is 24 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h3, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 14u, "Compact ReplyBackHeader is 14 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 4u, "Compact ReplyBackHeader is 4 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+
+    // The packet metadata recreates the headers from their type ID.
+    NS_TEST_EXPECT_MSG_EQ (h3.GetInstanceTypeId (), CompactReplyBackHeader::GetTypeId (),
+                           "Must be the type ID of the compact header");
+    NS_TEST_EXPECT_MSG_EQ (ReplyBackHeader ().GetInstanceTypeId (), ReplyBackHeader::GetTypeId (),
+                           "Must be the type ID of the fixed-size header");
+
+    packet->AddHeader (h3);
+
+    Callback<ObjectBase *> constructor = h3.GetInstanceTypeId ().GetConstructor ();
+    ReplyBackHeader * recreated = dynamic_cast<ReplyBackHeader *> (constructor ());
+
+    NS_TEST_EXPECT_MSG_EQ (recreated->IsCompactEncoding (), true, "Must use the compact encoding");
+
+    read_bytes = packet->RemoveHeader (*recreated);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 24u, "Compact ReplyBackHeader is 24 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h3, *recreated, "Serialization and deserialization works");
+
+    delete recreated;
+  }
+
+  void
+  TestDeltaCodedSerializationDeserialization ()
+  {
+    std::set<DataIdentifier> summary_vector = {DataIdentifier (Ipv4Address ("1.1.1.1"), 1),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 2),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 3),
+      DataIdentifier (Ipv4Address ("2.2.2.2"), 300)};
+
+    ReplyBackHeader h1;
+    ReplyBackHeader h2 (summary_vector,
+                        GeoTemporalLibrary::LibraryUtils::Vector2D (5, -14));
+
+    h1.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+    h2.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+
+    // 1 byte of groups count, (4 + 1 + 1 + 2) bytes of the first group and
+    // (4 + 1 + 2) bytes of the second group.
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 19u + 1u, "Must be 20u");
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSerializedSize (), 19u + 16u, "Must be 35u");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+    packet->AddHeader (h2);
+
+    ReplyBackHeader deserialized;
+    deserialized.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 35u, "Delta-coded ReplyBackHeader is 35 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, deserialized, "Serialization and deserialization works");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVector (), summary_vector, "Must be equal");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 20u, "Delta-coded ReplyBackHeader is 20 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+  }
+
+  void
+  TestBloomFilterSerializationDeserialization ()
+  {
+    std::set<DataIdentifier> summary_vector = {DataIdentifier (Ipv4Address ("1.1.1.1"), 1),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 2),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 3),
+      DataIdentifier (Ipv4Address ("2.2.2.2"), 300)};
+
+    DataIdentifierBloomFilter bloom_filter (summary_vector, 0.01);
+
+    ReplyBackHeader h1 (std::set<DataIdentifier> (),
+                        GeoTemporalLibrary::LibraryUtils::Vector2D (5, -14));
+    h1.SetSummaryVectorEncoding (SummaryVectorEncoding::BloomFilter);
+    h1.SetBloomFilter (bloom_filter, summary_vector.size ());
+
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSummaryVectorSize (), 4u, "Must be 4u");
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 19u + bloom_filter.GetSerializedSize (),
+                           "Must be the size of the filter plus 19 bytes");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+
+    ReplyBackHeader deserialized;
+    deserialized.SetSummaryVectorEncoding (SummaryVectorEncoding::BloomFilter);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, h1.GetSerializedSize (), "Must be the serialized size");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVectorSize (), 4u, "Must be 4u");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVector ().empty (), true, "Must be true");
+
+    for (std::set<DataIdentifier>::const_iterator it = summary_vector.begin ();
+            it != summary_vector.end (); ++it)
+      {
+        NS_TEST_EXPECT_MSG_EQ (deserialized.GetBloomFilter ().MayContain (*it), true,
+                               "Must be true");
+      }
+  }
+
   void
   DoRun () override
   {
@@ -673,6 +884,9 @@ public:
     TestGettersSetters ();
     TestOverloadedOperators ();
     TestSerializationDeserialization ();
+    TestCompactSerializationDeserialization ();
+    TestDeltaCodedSerializationDeserialization ();
+    TestBloomFilterSerializationDeserialization ();
     TestToString ();
   }
 };
@@ -852,6 +1066,64 @@ public:
     NS_TEST_EXPECT_MSG_EQ (h.ToString (), expected_str, "Expected string: " + expected_str);
   }
 
+  void
+  TestCompactSerializationDeserialization ()
+  {
+    DataIdentifier data_id (Ipv4Address ("1.2.3.4"), 5u);
+    GeoTemporalArea gta (TimePeriod (Seconds (10), Seconds (20)), Area (30, 40, 50, 60));
+
+    DataHeader h1;
+    DataHeader h2 (data_id, gta, "Different message", 2u); // Message length = 17
+    DataHeader h3 (data_id, gta, "packet's message", 5u); // Message length = 16
+
+    h1.SetCompactEncoding (true);
+    h2.SetCompactEncoding (true);
+    h3.SetCompactEncoding (true);
+
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 16u, "Must be 16u");
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSerializedSize (), 41u, "Must be 41u");
+    NS_TEST_EXPECT_MSG_EQ (h3.GetSerializedSize (), 40u, "Must be 40u");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+    packet->AddHeader (h2);
+    packet->AddHeader (h3);
+
+    DataHeader deserialized;
+    deserialized.SetCompactEncoding (true);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 40u, "Compact DataHeader is 40 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h3, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 41u, "Compact DataHeader is 41 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 16u, "Compact DataHeader is 16 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+
+    // The packet metadata recreates the headers from their type ID.
+    NS_TEST_EXPECT_MSG_EQ (h3.GetInstanceTypeId (), CompactDataHeader::GetTypeId (),
+                           "Must be the type ID of the compact header");
+    NS_TEST_EXPECT_MSG_EQ (DataHeader ().GetInstanceTypeId (), DataHeader::GetTypeId (),
+                           "Must be the type ID of the fixed-size header");
+
+    packet->AddHeader (h3);
+
+    Callback<ObjectBase *> constructor = h3.GetInstanceTypeId ().GetConstructor ();
+    DataHeader * recreated = dynamic_cast<DataHeader *> (constructor ());
+
+    NS_TEST_EXPECT_MSG_EQ (recreated->IsCompactEncoding (), true, "Must use the compact encoding");
+
+    read_bytes = packet->RemoveHeader (*recreated);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 40u, "Compact DataHeader is 40 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h3, *recreated, "Serialization and deserialization works");
+
+    delete recreated;
+  }
+
   void
   DoRun () override
   {
@@ -859,6 +1131,7 @@ public:
     TestGettersSetters ();
     TestOverloadedOperators ();
     TestSerializationDeserialization ();
+    TestCompactSerializationDeserialization ();
     TestToString ();
   }
 };
@@ -2147,6 +2420,15 @@ public:
     expected_disjoint_vector.clear ();
     NS_TEST_EXPECT_MSG_EQ (disjoint_vector, expected_disjoint_vector, "Disjoint vector must be the expected.");
 
+    // Test the packets of the queue not contained in the Bloom filter of the 
+    // summary vector (the filter of these packets has no false positives).
+    m_packets_queue.ProcessDisjointVector (DataIdentifierBloomFilter (received_summary_vector, 0.01),
+                                           disjoint_vector);
+
+    expected_disjoint_vector = {DataIdentifier ("9.9.9.9:9"), DataIdentifier ("10.10.10.10:10"),
+      DataIdentifier ("11.11.11.11:11")};
+    NS_TEST_EXPECT_MSG_EQ (disjoint_vector, expected_disjoint_vector, "Disjoint vector must be the expected.");
+
     // The following scheduled calls test:
     //  - That ProcessDisjointVector does not call Purge()
     Simulator::Schedule (Seconds (20), &PacketsQueueTest::TestProcessDisjointVector_Scheduled_1, this);
@@ -0,0 +1,973 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2019 Luis Ricardo Gallego Tercero <luiss_121314@hotmail.com>,
+ *                    Networks and Data Science Laboratory (NDS-Lab) at the
+ *                    Computing Research Center (CIC-IPN) <www.prime.cic.ipn.mx>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * This is a benchmark script that compares the Geo-Temporal, epidemic,
+ * restricted epidemic and spray and wait routing protocols.
+ *
+ * Each protocol is simulated with the same mobility scenario, seeds and
+ * workload, and the performance (wall time, simulator events per second and
+ * peak memory) and the quality (delivery ratio, delivery delay and overhead)
+ * of every simulation are saved to a single XML report.
+ *
+ * Each protocol can be simulated with several encodings of the summary vectors
+ * (see <code>summaryVectorEncodings</code>). The average control overhead
+ * (control bytes transmitted per delivered data byte) of each protocol and
+ * encoding is printed at the end, and saved to the report.
+ *
+ * Each simulation runs in its own child process, so the peak memory of each
+ * simulation is measured independently and the global state of ns-3 (e.g. the
+ * node list or the names of the nodes) starts clean in every simulation.
+ *
+ * The mobility scenario is either one of the scenarios of the installers
+ * (which need the "simulations-input" files) or one of the small Luxembourg and
+ * Murcia fixtures bundled with the tests of the module. The input files that
+ * the fixtures lack (the mobility trace, the random destination geo-temporal
+ * areas and the visitor nodes of each area) are generated from the routes of
+ * the vehicles, so the benchmark runs without any external input.
+ *
+ * Author: Luis Ricardo Gallego Tercero <luiss_121314@hotmail.com>
+ */
+
+#include <ns3/geotemporal-installer.h>
+#include <ns3/geotemporal-epidemic-installer.h>
+#include <ns3/geotemporal-restricted-epidemic-installer.h>
+#include <ns3/geotemporal-spray-and-wait-installer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <ns3/abort.h>
+#include <ns3/command-line.h>
+#include <ns3/log.h>
+#include <ns3/nstime.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("GeoTemporalBenchmark");
+
+
+// =============================================================================
+//                              BenchmarkRunResult
+// =============================================================================
+
+/**
+ * Results of the simulation of one protocol with one seed. It is sent as is
+ * from the child process that runs the simulation to the parent process, so it
+ * must only contain plain values.
+ */
+struct BenchmarkRunResult
+{
+  /** Wall time (in seconds) used to configure the simulation (load the input files). */
+  double m_setup_wall_time;
+
+  /** Wall time (in seconds) used to run the simulation and compute its statistics. */
+  double m_run_wall_time;
+
+  /** Number of events executed by the simulator. */
+  uint64_t m_simulator_events_count;
+
+  double m_average_delivery_ratio;
+  double m_average_delivery_delay;
+  double m_total_overhead;
+  double m_data_overhead;
+  double m_control_overhead;
+  uint64_t m_total_transmitted_bytes;
+  uint64_t m_total_delivered_data_bytes;
+  uint32_t m_expected_receivers;
+  uint32_t m_confirmed_receivers;
+};
+
+
+// =============================================================================
+//                                Fixture files
+// =============================================================================
+
+/** Size (in meters) of the side of the generated destination areas. */
+static const double FIXTURE_DESTINATION_AREA_SIZE = 300.0;
+
+/**
+ * Time (in seconds) that the generated destination geo-temporal areas remain
+ * active after the arrival of their target vehicle.
+ */
+static const uint32_t FIXTURE_DESTINATION_AREA_EXTRA_TIME = 30u;
+
+/**
+ * Copies the content of the input file to the output file.
+ */
+static void
+CopyFile (const std::string & input_filename, const std::string & output_filename)
+{
+  std::ifstream input_file (input_filename, std::ios::in | std::ios::binary);
+
+  if (!input_file.is_open ())
+    NS_ABORT_MSG ("Unable to open file \"" << input_filename << "\".");
+
+  std::ofstream output_file (output_filename, std::ios::out | std::ios::binary);
+
+  if (!output_file.is_open ())
+    NS_ABORT_MSG ("Unable to open file \"" << output_filename << "\".");
+
+  output_file << input_file.rdbuf ();
+}
+
+/**
+ * Returns a copy of the routes of the vehicles in which the IDs of the vehicles
+ * are consecutive and start at 0 (the installers create the nodes with those
+ * IDs).
+ */
+static NodesRoutesData
+RenumberVehicles (const NodesRoutesData & vehicles_routes)
+{
+  NodesRoutesData renumbered_routes;
+  uint32_t new_node_id = 0u;
+
+  for (uint32_t node_id = 0u; new_node_id < vehicles_routes.GetNodesCount (); ++node_id)
+    {
+      if (!vehicles_routes.ContainsNode (node_id))
+        continue;
+
+      const std::vector<RouteStep> & route = vehicles_routes.GetNodeRouteData (node_id).GetCompleteRoute ();
+
+      renumbered_routes.AddNode (new_node_id);
+
+      for (std::vector<RouteStep>::const_iterator step_it = route.begin (); step_it != route.end (); ++step_it)
+        renumbered_routes.AddNodeRouteStep (new_node_id, *step_it);
+
+      ++new_node_id;
+    }
+
+  return renumbered_routes;
+}
+
+/**
+ * Saves the routes of the vehicles as a mobility trace in the ns-2 format read
+ * by <code>Ns2MobilityHelper</code>.
+ */
+static void
+ExportMobilityTrace (const NodesRoutesData & vehicles_routes, const std::string & output_filename)
+{
+  std::ofstream output_file (output_filename, std::ios::out);
+  char buffer[150];
+
+  if (!output_file.is_open ())
+    NS_ABORT_MSG ("Unable to open file \"" << output_filename << "\".");
+
+  for (uint32_t node_id = 0u; node_id < vehicles_routes.GetNodesCount (); ++node_id)
+    {
+      const std::vector<RouteStep> & route = vehicles_routes.GetNodeRouteData (node_id).GetCompleteRoute ();
+
+      if (route.empty ())
+        continue;
+
+      const GeoTemporalLibrary::LibraryUtils::Vector2D & initial_position = route.front ().GetPositionCoordinate ();
+
+      std::sprintf (buffer, "$node_(%u) set X_ %.6f\n", node_id, initial_position.m_x);
+      output_file << buffer;
+      std::sprintf (buffer, "$node_(%u) set Y_ %.6f\n", node_id, initial_position.m_y);
+      output_file << buffer;
+      std::sprintf (buffer, "$node_(%u) set Z_ 0.0\n", node_id);
+      output_file << buffer;
+
+      for (std::vector<RouteStep>::const_iterator step_it = route.begin () + 1u; step_it != route.end (); ++step_it)
+        {
+          const RouteStep & previous_step = *(step_it - 1u);
+          const uint32_t travel_time = step_it->GetTime () - previous_step.GetTime ();
+
+          if (travel_time == 0u)
+            continue;
+
+          const double speed = CalculateDistance (previous_step.GetPositionCoordinate (),
+                                                  step_it->GetPositionCoordinate ()) / (double) travel_time;
+
+          std::sprintf (buffer, "$ns_ at %u.0 \"$node_(%u) setdest %.6f %.6f %.6f\"\n",
+                        previous_step.GetTime (), node_id, step_it->GetPositionCoordinate ().m_x,
+                        step_it->GetPositionCoordinate ().m_y, speed);
+          output_file << buffer;
+        }
+    }
+}
+
+/**
+ * Generates the destination geo-temporal areas of the data packets, one list
+ * per seed (the set number of each list is the seed, i.e. the simulation ID).
+ *
+ * The generator of each list is seeded with the seed of the list. Each source
+ * vehicle creates its data packets at one of the steps of its route, and their
+ * destination area is centered at the street junction closer to other vehicle
+ * after that time (destination areas must contain at least one junction).
+ */
+static RandomDestinationGeoTemporalAreasLists
+GenerateDestinationGeoTemporalAreas (const GpsSystem & gps_system, uint32_t seeds_count,
+                                     uint32_t source_vehicles_count, uint32_t simulation_duration)
+{
+  const NodesRoutesData & vehicles_routes = gps_system.GetVehiclesRoutesData ();
+  const uint32_t vehicles_count = vehicles_routes.GetNodesCount ();
+
+  if (source_vehicles_count < 1u || source_vehicles_count > vehicles_count)
+    NS_ABORT_MSG ("The number of source vehicles must be between 1 and the number of vehicles "
+                  "of the fixture (" << vehicles_count << "), including both limits.");
+
+  const double half_area_size = FIXTURE_DESTINATION_AREA_SIZE / 2.0;
+
+  std::set<Area> destination_areas;
+  std::vector<std::map<uint32_t, std::vector<DestinationGeoTemporalArea> > > lists_sets (seeds_count);
+
+  for (uint32_t seed = 1u; seed <= seeds_count; ++seed)
+    {
+      std::mt19937 generator (seed);
+
+      std::vector<uint32_t> vehicles;
+
+      for (uint32_t node_id = 0u; node_id < vehicles_count; ++node_id)
+        vehicles.push_back (node_id);
+
+      std::shuffle (vehicles.begin (), vehicles.end (), generator);
+
+      std::vector<DestinationGeoTemporalArea> & destination_gtas = lists_sets.at (seed - 1u)[source_vehicles_count];
+
+      for (uint32_t source_index = 0u; source_index < source_vehicles_count; ++source_index)
+        {
+          const uint32_t source_node_id = vehicles.at (source_index);
+          const std::vector<RouteStep> & source_route =
+                  vehicles_routes.GetNodeRouteData (source_node_id).GetCompleteRoute ();
+
+          std::uniform_int_distribution<uint32_t> source_step_distribution (0u, source_route.size () - 1u);
+          const uint32_t creation_time = source_route.at (source_step_distribution (generator)).GetTime ();
+
+          // Candidate target steps: the steps of the other vehicles after the
+          // creation of the packets, or any step if there aren't such steps.
+          std::vector<const RouteStep *> later_steps, all_steps;
+
+          for (uint32_t node_id = 0u; node_id < vehicles_count; ++node_id)
+            {
+              if (node_id == source_node_id && vehicles_count > 1u)
+                continue;
+
+              const std::vector<RouteStep> & route = vehicles_routes.GetNodeRouteData (node_id).GetCompleteRoute ();
+
+              for (std::vector<RouteStep>::const_iterator step_it = route.begin (); step_it != route.end (); ++step_it)
+                {
+                  all_steps.push_back (&*step_it);
+
+                  if (step_it->GetTime () >= creation_time)
+                    later_steps.push_back (&*step_it);
+                }
+            }
+
+          const std::vector<const RouteStep *> & candidate_steps = later_steps.empty () ? all_steps : later_steps;
+          std::uniform_int_distribution<uint32_t> target_step_distribution (0u, candidate_steps.size () - 1u);
+          const RouteStep & target_step = *candidate_steps.at (target_step_distribution (generator));
+
+          const GeoTemporalLibrary::LibraryUtils::Vector2D & center =
+                  gps_system.GetStreetJunctionData (gps_system.GetCloserJunctionName (target_step)).GetLocation ();
+          const Area destination_area (std::floor (center.m_x - half_area_size), std::floor (center.m_y - half_area_size),
+                                       std::ceil (center.m_x + half_area_size), std::ceil (center.m_y + half_area_size));
+
+          const uint32_t end_time = std::min (std::max (creation_time, target_step.GetTime ())
+                                              + FIXTURE_DESTINATION_AREA_EXTRA_TIME, simulation_duration);
+
+          destination_areas.insert (destination_area);
+          destination_gtas.push_back (DestinationGeoTemporalArea (source_node_id,
+                                                                  TimePeriod (Seconds (creation_time), Seconds (end_time)),
+                                                                  destination_area));
+        }
+    }
+
+  return RandomDestinationGeoTemporalAreasLists (simulation_duration,
+                                                 std::vector<Area> (destination_areas.begin (), destination_areas.end ()),
+                                                 lists_sets);
+}
+
+/**
+ * Computes the vehicles that visited each one of the destination geo-temporal
+ * areas from the routes of the vehicles.
+ */
+static GeoTemporalAreasVisitorNodes
+ComputeVisitorNodes (const NodesRoutesData & vehicles_routes,
+                     const RandomDestinationGeoTemporalAreasLists & destination_gtas_lists,
+                     uint32_t seeds_count, uint32_t source_vehicles_count)
+{
+  GeoTemporalAreasVisitorNodes visitor_nodes;
+
+  for (uint32_t seed = 1u; seed <= seeds_count; ++seed)
+    {
+      const std::vector<DestinationGeoTemporalArea> & destination_gtas =
+              destination_gtas_lists.GetDestinationGeoTemporalAreasList (seed, source_vehicles_count);
+
+      for (std::vector<DestinationGeoTemporalArea>::const_iterator gta_it = destination_gtas.begin ();
+              gta_it != destination_gtas.end (); ++gta_it)
+        {
+          const GeoTemporalArea & geo_temporal_area = *gta_it;
+
+          visitor_nodes.AddGeoTemporalArea (geo_temporal_area);
+
+          for (uint32_t node_id = 0u; node_id < vehicles_routes.GetNodesCount (); ++node_id)
+            {
+              const std::vector<RouteStep> & route = vehicles_routes.GetNodeRouteData (node_id).GetCompleteRoute ();
+
+              // Only the earliest arrival of each vehicle is recorded.
+              for (std::vector<RouteStep>::const_iterator step_it = route.begin (); step_it != route.end (); ++step_it)
+                {
+                  if (geo_temporal_area.IsInsideGeoTemporalArea (step_it->GetPositionCoordinate (),
+                                                                 Seconds (step_it->GetTime ())))
+                    {
+                      visitor_nodes.AddVisitorNode (geo_temporal_area, VisitorNode (node_id, step_it->GetTime ()));
+                      break;
+                    }
+                }
+            }
+        }
+    }
+
+  return visitor_nodes;
+}
+
+/**
+ * Writes in the working directory the input files of the custom mobility
+ * scenario of the installers from the given fixture, and returns the prefix
+ * of their names.
+ *
+ * @param fixtures_directory Directory that contains the fixture files.
+ * @param fixture_name Name of the fixture (i.e. the prefix of its files).
+ * @param working_directory Directory where the generated files are saved.
+ * @param seeds_count Number of seeds (one list of destination geo-temporal
+ * areas is generated for each seed).
+ * @param source_vehicles_count Number of vehicles that generate DATA packets.
+ * @param simulation_duration [IN/OUT] Duration of the simulation (in seconds).
+ * If it is 0 then it is set to the duration of the routes of the fixture plus
+ * the time that the destination geo-temporal areas remain active.
+ */
+static std::string
+PrepareFixtureFiles (const std::string & fixtures_directory, const std::string & fixture_name,
+                     const std::string & working_directory, uint32_t seeds_count,
+                     uint32_t source_vehicles_count, uint32_t & simulation_duration)
+{
+  const std::string input_prefix = fixtures_directory + "/" + fixture_name;
+  const std::string output_prefix = working_directory + "/" + fixture_name;
+
+  std::cout << "Preparing the input files of the fixture \"" << input_prefix << "\"...\n";
+
+  CopyFile (input_prefix + ".graph.txt", output_prefix + ".graph.txt");
+  CopyFile (input_prefix + ".junctions.txt", output_prefix + ".junctions.txt");
+
+  RenumberVehicles (NodesRoutesData (input_prefix + ".routes.txt")).ExportToFile (output_prefix + ".routes.txt");
+
+  const GpsSystem gps_system (output_prefix + ".graph.txt", output_prefix + ".routes.txt",
+                              output_prefix + ".junctions.txt");
+  const NodesRoutesData & vehicles_routes = gps_system.GetVehiclesRoutesData ();
+
+  if (simulation_duration == 0u)
+    {
+      for (uint32_t node_id = 0u; node_id < vehicles_routes.GetNodesCount (); ++node_id)
+        simulation_duration = std::max (simulation_duration, vehicles_routes.GetNodeRouteLastTime (node_id));
+
+      simulation_duration += FIXTURE_DESTINATION_AREA_EXTRA_TIME;
+    }
+
+  ExportMobilityTrace (vehicles_routes, output_prefix + ".ns2.mob.tcl");
+
+  const RandomDestinationGeoTemporalAreasLists destination_gtas_lists =
+          GenerateDestinationGeoTemporalAreas (gps_system, seeds_count, source_vehicles_count,
+                                               simulation_duration);
+  destination_gtas_lists.ExportToFile (output_prefix + ".random_geo_temporal_areas.txt");
+
+  ComputeVisitorNodes (vehicles_routes, destination_gtas_lists, seeds_count, source_vehicles_count)
+          .ExportToFile (output_prefix + ".geo_temporal_areas_visitor_nodes.txt");
+
+  std::cout << "Done.\n\n";
+
+  return output_prefix;
+}
+
+
+// =============================================================================
+//                               Simulation runs
+// =============================================================================
+
+/**
+ * Configures and runs the simulation with the given installer and command line
+ * arguments, and stores its results.
+ */
+template <typename Installer>
+static void
+RunInstaller (const std::vector<std::string> & arguments, BenchmarkRunResult & result)
+{
+  std::vector<char *> argv;
+
+  for (std::vector<std::string>::const_iterator argument_it = arguments.begin ();
+          argument_it != arguments.end (); ++argument_it)
+    argv.push_back (const_cast<char *> (argument_it->c_str ()));
+
+  argv.push_back (nullptr);
+
+  Installer installer;
+
+  const std::chrono::steady_clock::time_point setup_start = std::chrono::steady_clock::now ();
+
+  if (!installer.Configure (arguments.size (), argv.data ()))
+    NS_FATAL_ERROR ("Configuration failed. Aborted!");
+
+  const std::chrono::steady_clock::time_point run_start = std::chrono::steady_clock::now ();
+
+  installer.Run ();
+
+  const std::chrono::steady_clock::time_point run_end = std::chrono::steady_clock::now ();
+
+  result.m_setup_wall_time = std::chrono::duration<double> (run_start - setup_start).count ();
+  result.m_run_wall_time = std::chrono::duration<double> (run_end - run_start).count ();
+  result.m_simulator_events_count = installer.GetSimulatorEventsCount ();
+
+  const SimulationStatisticsValues & values = installer.GetStatisticsValues ();
+
+  result.m_average_delivery_ratio = values.m_average_delivery_ratio;
+  result.m_average_delivery_delay = values.m_average_delivery_delay;
+  result.m_total_overhead = values.m_total_overhead;
+  result.m_data_overhead = values.m_data_overhead;
+  result.m_control_overhead = values.m_control_overhead;
+  result.m_total_transmitted_bytes = values.m_total_transmitted_bytes;
+  result.m_total_delivered_data_bytes = values.m_total_delivered_data_bytes;
+  result.m_expected_receivers = values.m_expected_receivers;
+  result.m_confirmed_receivers = values.m_confirmed_receivers;
+}
+
+/**
+ * Runs the simulation of the protocol in a child process and waits for it.
+ *
+ * The output of the simulation is redirected to the given log file.
+ *
+ * @param protocol Name of the protocol.
+ * @param arguments Command line arguments of the installer.
+ * @param log_filename File where the output of the simulation is saved.
+ * @param result [OUT] Results of the simulation.
+ * @param peak_memory [OUT] Peak resident set size (in kilobytes) of the child
+ * process.
+ *
+ * @return <code>true</code> if the simulation finished successfully, otherwise
+ * returns <code>false</code>.
+ */
+static bool
+RunProtocol (const std::string & protocol, const std::vector<std::string> & arguments,
+             const std::string & log_filename, BenchmarkRunResult & result, long & peak_memory)
+{
+  int result_pipe[2];
+
+  if (pipe (result_pipe) != 0)
+    NS_ABORT_MSG ("Unable to create the pipe of the simulation results.");
+
+  std::cout.flush ();
+  const pid_t child_pid = fork ();
+
+  if (child_pid < 0)
+    NS_ABORT_MSG ("Unable to create the process of the simulation.");
+
+  if (child_pid == 0)
+    {
+      close (result_pipe[0]);
+
+      if (std::freopen (log_filename.c_str (), "w", stdout) == nullptr)
+        _exit (EXIT_FAILURE);
+
+      BenchmarkRunResult child_result = BenchmarkRunResult ();
+
+      if (protocol == "geotemporal")
+        RunInstaller<GeoTemporalInstaller> (arguments, child_result);
+      else if (protocol == "epidemic")
+        RunInstaller<GeoTemporalEpidemicInstaller> (arguments, child_result);
+      else if (protocol == "restricted-epidemic")
+        RunInstaller<GeoTemporalRestrictedEpidemicInstaller> (arguments, child_result);
+      else
+        RunInstaller<GeoTemporalSprayAndWaitInstaller> (arguments, child_result);
+
+      std::cout.flush ();
+
+      const bool sent = write (result_pipe[1], &child_result, sizeof (child_result))
+              == (ssize_t) sizeof (child_result);
+
+      close (result_pipe[1]);
+      _exit (sent ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+  close (result_pipe[1]);
+
+  const ssize_t read_bytes = read (result_pipe[0], &result, sizeof (result));
+  close (result_pipe[0]);
+
+  int status = 0;
+  struct rusage usage;
+
+  if (wait4 (child_pid, &status, 0, &usage) != child_pid)
+    NS_ABORT_MSG ("Unable to wait for the process of the simulation.");
+
+  peak_memory = usage.ru_maxrss;
+
+  return read_bytes == (ssize_t) sizeof (result) && WIFEXITED (status) && WEXITSTATUS (status) == EXIT_SUCCESS;
+}
+
+
+// =============================================================================
+//                                    Report
+// =============================================================================
+
+/**
+ * Results of one simulation of the benchmark, along with its identification.
+ */
+struct BenchmarkReportEntry
+{
+  std::string m_protocol;
+  std::string m_summary_vector_encoding;
+  uint32_t m_seed;
+  bool m_succeeded;
+  long m_peak_memory;
+  BenchmarkRunResult m_result;
+};
+
+/**
+ * Average control overhead (control bytes transmitted per delivered data byte)
+ * of the successful simulations of one protocol with one encoding of the
+ * summary vectors.
+ */
+struct ControlOverheadSummary
+{
+  std::string m_protocol;
+  std::string m_summary_vector_encoding;
+  uint32_t m_simulations_count;
+  double m_average_control_overhead;
+};
+
+/**
+ * Computes the average control overhead of each protocol and encoding of the
+ * summary vectors, in the order they were simulated.
+ */
+static std::vector<ControlOverheadSummary>
+SummarizeControlOverhead (const std::vector<BenchmarkReportEntry> & entries)
+{
+  std::vector<ControlOverheadSummary> summaries;
+
+  for (std::vector<BenchmarkReportEntry>::const_iterator entry_it = entries.begin ();
+          entry_it != entries.end (); ++entry_it)
+    {
+      if (summaries.empty () || summaries.back ().m_protocol != entry_it->m_protocol
+          || summaries.back ().m_summary_vector_encoding != entry_it->m_summary_vector_encoding)
+        {
+          ControlOverheadSummary summary;
+          summary.m_protocol = entry_it->m_protocol;
+          summary.m_summary_vector_encoding = entry_it->m_summary_vector_encoding;
+          summary.m_simulations_count = 0u;
+          summary.m_average_control_overhead = 0.0;
+
+          summaries.push_back (summary);
+        }
+
+      // Simulations without delivered data have no control overhead (-1).
+      if (!entry_it->m_succeeded || entry_it->m_result.m_control_overhead < 0.0)
+        continue;
+
+      ControlOverheadSummary & summary = summaries.back ();
+
+      summary.m_average_control_overhead += (entry_it->m_result.m_control_overhead
+                                             - summary.m_average_control_overhead)
+              / (double) ++summary.m_simulations_count;
+    }
+
+  return summaries;
+}
+
+/**
+ * Saves the parameters and the results of the benchmark to a XML file.
+ */
+static void
+SaveReport (const std::string & output_filename, const std::string & scenario, uint32_t simulation_duration,
+            uint32_t source_vehicles_count, uint32_t packets_per_source, uint32_t message_size,
+            uint32_t data_rate, const std::vector<BenchmarkReportEntry> & entries)
+{
+  const std::string end_line = "\n";
+  const std::string indentation = "  ";
+  char buffer[30];
+
+  std::ofstream output_file (output_filename, std::ios::out);
+
+  if (!output_file.is_open ())
+    NS_ABORT_MSG ("Unable to open file \"" << output_filename << "\".");
+
+  output_file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << end_line << end_line;
+
+  output_file << "<document>" << end_line << end_line;
+
+  output_file << "<benchmark-parameters "
+          << "scenario=\"" << scenario << "\" "
+          << "simulation-duration=\"" << simulation_duration << "\" "
+          << "source-vehicles=\"" << source_vehicles_count << "\" "
+          << "packets-per-source=\"" << packets_per_source << "\" "
+          << "message-size=\"" << message_size << "\" "
+          << "data-rate=\"" << data_rate << "\" />" << end_line << end_line;
+
+  output_file << "<benchmark-results>" << end_line;
+
+  for (std::vector<BenchmarkReportEntry>::const_iterator entry_it = entries.begin ();
+          entry_it != entries.end (); ++entry_it)
+    {
+      const BenchmarkRunResult & result = entry_it->m_result;
+
+      output_file << indentation << "<result protocol=\"" << entry_it->m_protocol << "\" "
+              << "summary-vector-encoding=\"" << entry_it->m_summary_vector_encoding << "\" "
+              << "seed=\"" << entry_it->m_seed << "\" "
+              << "status=\"" << (entry_it->m_succeeded ? "succeeded" : "failed") << "\"";
+
+      if (!entry_it->m_succeeded)
+        {
+          output_file << " />" << end_line;
+          continue;
+        }
+
+      std::sprintf (buffer, "%f", result.m_setup_wall_time + result.m_run_wall_time);
+      output_file << " wall-time=\"" << buffer << "\" ";
+
+      std::sprintf (buffer, "%f", result.m_setup_wall_time);
+      output_file << "setup-wall-time=\"" << buffer << "\" ";
+
+      std::sprintf (buffer, "%f", result.m_run_wall_time);
+      output_file << "run-wall-time=\"" << buffer << "\" ";
+
+      std::sprintf (buffer, "%lu", (unsigned long) result.m_simulator_events_count);
+      output_file << "simulator-events=\"" << buffer << "\" ";
+
+      std::sprintf (buffer, "%f", result.m_run_wall_time > 0.0
+                    ? (double) result.m_simulator_events_count / result.m_run_wall_time : 0.0);
+      output_file << "simulator-events-per-second=\"" << buffer << "\" ";
+
+      std::sprintf (buffer, "%ld", entry_it->m_peak_memory);
+      output_file << "peak-memory-kb=\"" << buffer << "\" ";
+
+      std::sprintf (buffer, "%f", result.m_average_delivery_ratio);
+      output_file << "average-delivery-ratio=\"" << buffer << "\" ";
+
+      std::sprintf (buffer, "%f", result.m_average_delivery_delay);
+      output_file << "average-delivery-delay=\"" << buffer << "\" ";
+
+      std::sprintf (buffer, "%f", result.m_total_overhead);
+      output_file << "total-overhead=\"" << buffer << "\" ";
+
+      std::sprintf (buffer, "%f", result.m_data_overhead);
+      output_file << "data-overhead=\"" << buffer << "\" ";
+
+      std::sprintf (buffer, "%f", result.m_control_overhead);
+      output_file << "control-overhead=\"" << buffer << "\" ";
+
+      std::sprintf (buffer, "%lu", (unsigned long) result.m_total_transmitted_bytes);
+      output_file << "total-transmitted-bytes=\"" << buffer << "\" ";
+
+      std::sprintf (buffer, "%lu", (unsigned long) result.m_total_delivered_data_bytes);
+      output_file << "total-delivered-data-bytes=\"" << buffer << "\" ";
+
+      std::sprintf (buffer, "%u", result.m_expected_receivers);
+      output_file << "expected-receiver-nodes=\"" << buffer << "\" ";
+
+      std::sprintf (buffer, "%u", result.m_confirmed_receivers);
+      output_file << "confirmed-receiver-nodes=\"" << buffer << "\" />" << end_line;
+    }
+
+  output_file << "</benchmark-results>" << end_line << end_line;
+
+  output_file << "<control-overhead-results>" << end_line;
+
+  const std::vector<ControlOverheadSummary> summaries = SummarizeControlOverhead (entries);
+
+  for (std::vector<ControlOverheadSummary>::const_iterator summary_it = summaries.begin ();
+          summary_it != summaries.end (); ++summary_it)
+    {
+      std::sprintf (buffer, "%f", summary_it->m_average_control_overhead);
+
+      output_file << indentation << "<control-overhead protocol=\"" << summary_it->m_protocol << "\" "
+              << "summary-vector-encoding=\"" << summary_it->m_summary_vector_encoding << "\" "
+              << "simulations=\"" << summary_it->m_simulations_count << "\" "
+              << "average-control-overhead=\"" << buffer << "\" />" << end_line;
+    }
+
+  output_file << "</control-overhead-results>" << end_line << end_line;
+
+  output_file << "</document>" << end_line;
+}
+
+
+// =============================================================================
+//                                     Main
+// =============================================================================
+
+int
+main (int argc, char **argv)
+{
+  std::string protocols = "geotemporal,epidemic,restricted-epidemic,spray-and-wait";
+  std::string summary_vector_encodings = "Explicit";
+  uint32_t seeds_count = 3u;
+  std::string fixture = "murcia";
+  std::string fixtures_directory = "src/geotemporal/test";
+  std::string mobility_scenario_id = "";
+  uint32_t simulation_duration = 0u;
+  uint32_t source_vehicles_count = 2u;
+  uint32_t packets_per_source = 2u;
+  uint32_t message_size = 128u;
+  uint32_t data_rate = 5u;
+  bool use_80211p_mac_protocol = true;
+  std::string working_directory = "simulations-output/benchmark";
+  std::string report_filename = "simulations-output/benchmark/benchmark_report.xml";
+
+  CommandLine cmd;
+
+  cmd.AddValue ("protocols",
+                "Comma-separated list of the protocols to simulate. Valid values "
+                "are: geotemporal, epidemic, restricted-epidemic, spray-and-wait. "
+                "[Default value: geotemporal,epidemic,restricted-epidemic,spray-and-wait]",
+                protocols);
+
+  cmd.AddValue ("summaryVectorEncodings",
+                "Comma-separated list of the encodings of the summary vectors "
+                "simulated with each protocol. Valid values are: Explicit, "
+                "DeltaCoded, BloomFilter, Incremental (only simulated with the "
+                "geotemporal protocol). [Default value: Explicit]",
+                summary_vector_encodings);
+
+  cmd.AddValue ("seedsCount",
+                "Number of seeds simulated with each protocol. The seeds are the "
+                "simulation IDs from 1 to this number. [Default value: 3]",
+                seeds_count);
+
+  cmd.AddValue ("fixture",
+                "Bundled fixture used as mobility scenario. Valid values are: "
+                "murcia, luxembourg, or empty to use the scenario specified in "
+                "mobilityScenarioId. [Default value: murcia]",
+                fixture);
+
+  cmd.AddValue ("fixturesDirectory",
+                "Directory that contains the files of the fixtures. "
+                "[Default value: src/geotemporal/test]",
+                fixtures_directory);
+
+  cmd.AddValue ("mobilityScenarioId",
+                "The identifier of the mobility scenario of the installers used "
+                "when no fixture is selected. [Default value: ]",
+                mobility_scenario_id);
+
+  cmd.AddValue ("simulationDuration",
+                "The total duration of each simulation (in seconds). If set to "
+                "zero it is derived from the routes of the fixture (or 600 "
+                "seconds when no fixture is selected). [Default value: 0]",
+                simulation_duration);
+
+  cmd.AddValue ("dataPacketSourceVehiclesCount",
+                "The number of vehicles that will generate DATA packets. "
+                "[Default value: 2]",
+                source_vehicles_count);
+
+  cmd.AddValue ("dataPacketsPerSource",
+                "The number of DATA packets generated at each source node. "
+                "[Default value: 2]",
+                packets_per_source);
+
+  cmd.AddValue ("dataPacketMessageSize",
+                "The size (in bytes) of the message to disseminate. "
+                "[Default value: 128]",
+                message_size);
+
+  cmd.AddValue ("dataPacketsDataRate",
+                "Interval (in milliseconds) between DATA packets transmissions. "
+                "[Default value: 5]",
+                data_rate);
+
+  cmd.AddValue ("use80211pMacProtocol",
+                "Use the IEEE 802.11p MAC protocol instead of the IEEE 802.11. "
+                "[Default value: true]",
+                use_80211p_mac_protocol);
+
+  cmd.AddValue ("workingDirectory",
+                "Directory where the generated input files, the statistics and "
+                "the output of each simulation are saved. "
+                "[Default value: simulations-output/benchmark]",
+                working_directory);
+
+  cmd.AddValue ("outputReportFile",
+                "The name of the file where the benchmark report will be saved "
+                "in a XML format. "
+                "[Default value: simulations-output/benchmark/benchmark_report.xml]",
+                report_filename);
+
+  cmd.Parse (argc, argv);
+
+  // Validations
+  const std::vector<std::string> protocols_list = Split (protocols, ',');
+
+  for (std::vector<std::string>::const_iterator protocol_it = protocols_list.begin ();
+          protocol_it != protocols_list.end (); ++protocol_it)
+    {
+      if (*protocol_it != "geotemporal" && *protocol_it != "epidemic"
+          && *protocol_it != "restricted-epidemic" && *protocol_it != "spray-and-wait")
+        NS_ABORT_MSG ("Invalid protocol \"" << *protocol_it << "\". Valid values are: "
+                      "geotemporal, epidemic, restricted-epidemic, spray-and-wait.");
+    }
+
+  const std::vector<std::string> encodings_list = Split (summary_vector_encodings, ',');
+
+  for (std::vector<std::string>::const_iterator encoding_it = encodings_list.begin ();
+          encoding_it != encodings_list.end (); ++encoding_it)
+    {
+      if (*encoding_it != "Explicit" && *encoding_it != "DeltaCoded"
+          && *encoding_it != "BloomFilter" && *encoding_it != "Incremental")
+        NS_ABORT_MSG ("Invalid summary vector encoding \"" << *encoding_it << "\". Valid values are: "
+                      "Explicit, DeltaCoded, BloomFilter, Incremental.");
+    }
+
+  if (seeds_count == 0u)
+    NS_ABORT_MSG ("Invalid number of seeds. The minimum valid value is 1.");
+
+  if (fixture.empty () && mobility_scenario_id.empty ())
+    NS_ABORT_MSG ("Either a fixture or a mobility scenario identifier is required.");
+
+  // Create the working directory along with its missing parent directories.
+  for (std::string::size_type separator_index = working_directory.find ('/', 1u);
+          separator_index != std::string::npos;
+          separator_index = working_directory.find ('/', separator_index + 1u))
+    mkdir (working_directory.substr (0u, separator_index).c_str (), 0755);
+
+  mkdir (working_directory.c_str (), 0755);
+
+  // Mobility scenario
+  std::string scenario_arguments;
+
+  if (fixture == "murcia" || fixture == "luxembourg")
+    {
+      const std::string fixture_name = fixture == "murcia" ? "Murcia" : "Luxembourg";
+      const std::string files_prefix = PrepareFixtureFiles (fixtures_directory, fixture_name, working_directory,
+                                                            seeds_count, source_vehicles_count, simulation_duration);
+
+      scenario_arguments = "--mobilityScenarioFiles=" + files_prefix;
+      mobility_scenario_id = "custom";
+    }
+  else if (!fixture.empty ())
+    {
+      NS_ABORT_MSG ("Invalid fixture. Valid values are: murcia, luxembourg.");
+    }
+  else if (simulation_duration == 0u)
+    {
+      simulation_duration = 600u;
+    }
+
+  // Simulations
+  std::vector<BenchmarkReportEntry> entries;
+  char buffer[30];
+
+  for (std::vector<std::string>::const_iterator protocol_it = protocols_list.begin ();
+          protocol_it != protocols_list.end (); ++protocol_it)
+    {
+      for (std::vector<std::string>::const_iterator encoding_it = encodings_list.begin ();
+              encoding_it != encodings_list.end (); ++encoding_it)
+        {
+          // Only the Geo-Temporal protocol keeps the versions of the summary
+          // vectors that the incremental encoding needs.
+          if (*encoding_it == "Incremental" && *protocol_it != "geotemporal")
+            continue;
+
+          for (uint32_t seed = 1u; seed <= seeds_count; ++seed)
+            {
+              std::sprintf (buffer, "%u", seed);
+              const std::string run_name = working_directory + "/" + *protocol_it + "-" + *encoding_it
+                      + "-" + std::string (buffer);
+
+              std::vector<std::string> arguments;
+              arguments.push_back (argv[0]);
+              arguments.push_back ("--simulationId=" + std::string (buffer));
+              std::sprintf (buffer, "%u", simulation_duration);
+              arguments.push_back ("--simulationDuration=" + std::string (buffer));
+              std::sprintf (buffer, "%u", source_vehicles_count);
+              arguments.push_back ("--dataPacketSourceVehiclesCount=" + std::string (buffer));
+              std::sprintf (buffer, "%u", packets_per_source);
+              arguments.push_back ("--dataPacketsPerSource=" + std::string (buffer));
+              std::sprintf (buffer, "%u", message_size);
+              arguments.push_back ("--dataPacketMessageSize=" + std::string (buffer));
+              std::sprintf (buffer, "%u", data_rate);
+              arguments.push_back ("--dataPacketsDataRate=" + std::string (buffer));
+              arguments.push_back (std::string ("--use80211pMacProtocol=") + (use_80211p_mac_protocol ? "true" : "false"));
+              arguments.push_back ("--mobilityScenarioId=" + mobility_scenario_id);
+
+              if (!scenario_arguments.empty ())
+                arguments.push_back (scenario_arguments);
+
+              arguments.push_back ("--summaryVectorEncoding=" + *encoding_it);
+              arguments.push_back ("--progressReportInterval=0");
+              arguments.push_back ("--outputStatisticsFile=" + run_name + ".statistics.xml");
+
+              std::cout << "Simulating protocol " << *protocol_it << " with " << *encoding_it
+                      << " summary vectors and seed " << seed << "... ";
+
+              BenchmarkReportEntry entry;
+              entry.m_protocol = *protocol_it;
+              entry.m_summary_vector_encoding = *encoding_it;
+              entry.m_seed = seed;
+              entry.m_result = BenchmarkRunResult ();
+              entry.m_peak_memory = 0;
+              entry.m_succeeded = RunProtocol (*protocol_it, arguments, run_name + ".log",
+                                               entry.m_result, entry.m_peak_memory);
+
+              if (entry.m_succeeded)
+                std::cout << "Done (" << (entry.m_result.m_setup_wall_time + entry.m_result.m_run_wall_time)
+                        << " seconds, " << entry.m_result.m_simulator_events_count << " events, "
+                        << entry.m_peak_memory << " KB).\n";
+              else
+                std::cout << "Failed! (see \"" << run_name << ".log\")\n";
+
+              entries.push_back (entry);
+            }
+        }
+    }
+
+  const std::vector<ControlOverheadSummary> summaries = SummarizeControlOverhead (entries);
+
+  std::cout << "\nAverage control overhead (control bytes per delivered data byte):\n";
+
+  for (std::vector<ControlOverheadSummary>::const_iterator summary_it = summaries.begin ();
+          summary_it != summaries.end (); ++summary_it)
+    {
+      std::cout << "  " << summary_it->m_protocol << " (" << summary_it->m_summary_vector_encoding << "): ";
+
+      if (summary_it->m_simulations_count == 0u)
+        std::cout << "no data delivered\n";
+      else
+        std::cout << summary_it->m_average_control_overhead << " (" << summary_it->m_simulations_count
+                << " simulations)\n";
+    }
+
+  SaveReport (report_filename, fixture.empty () ? mobility_scenario_id : fixture, simulation_duration,
+              source_vehicles_count, packets_per_source, message_size, data_rate, entries);
+
+  std::cout << "\nBenchmark report saved to file \"" << report_filename << "\".\n";
+}
@@ -22,7 +22,7 @@
  * Author: Luis Ricardo Gallego Tercero <luiss_121314@hotmail.com>
  */
 
-#include "geotemporal-installer.h"
+#include <ns3/geotemporal-installer.h>
 
 #include <ns3/log.h>
 
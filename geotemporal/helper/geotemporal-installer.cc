@@ -71,15 +71,28 @@ m_data_packet_source_vehicles_count (8u), m_data_packets_per_source (2u),
 m_emergency_data_packets_ratio (0.0), m_emergency_data_packets_per_source (0u),
 m_normal_data_packets_per_source (0u), m_data_packet_message_size (128u),
 m_data_packets_data_rate (5u), m_mobility_scenario_id ("60"),
+m_mobility_scenario_files_prefix (""),
 m_vehicles_count (2u), m_fixed_nodes_distance (200u),
 m_use_80211p_mac_protocol (false), m_progress_report_time_interval (25u),
-m_hello_packets_interval (1000u), m_packets_queue_capacity (128u),
-m_neighbor_expiration_time (10u), m_data_packet_replicas (3u),
+m_hello_packets_interval (1000u), m_adaptive_hello_interval (false),
+m_min_hello_packets_interval (0u), m_max_hello_packets_interval (5000u),
+m_hello_interval_reference_neighbors (10.0), m_hello_summary_vector (false),
+m_max_hello_summary_vector_size (1400u), m_hello_summary_vector_digest (false),
+m_synchronized_digests_lifetime (30u), m_packets_queue_capacity (128u),
+m_neighbor_expiration_time (10u), m_data_packet_replicas (3u), m_replica_allocation ("Fixed"),
+m_min_data_packet_replicas (1u), m_max_data_packet_replicas (8u),
+m_replica_reference_neighbors (10.0), m_replica_reference_lifetime (300u),
 m_neighbor_min_valid_distance_diff (20.0), m_exponential_average_time_slot_size (30u),
+m_compact_header_encoding (false), m_summary_vector_encoding ("Explicit"),
+m_summary_vector_false_positive_rate (0.01), m_data_send_window (1u),
+m_data_retransmission_timeout (100u), m_max_data_retransmissions (0u),
+m_max_aggregated_data_size (0u), m_in_area_broadcast (false),
+m_in_area_broadcast_jitter (100u), m_in_area_broadcast_suppression_threshold (1u),
 m_streets_graph_input_filename (""), m_street_junctions_input_filename (""),
 m_vehicles_routes_input_filename (""), m_vehicles_mobility_trace_filename (""),
 m_random_destination_gta_input_filename (""), m_gta_visitor_vehicles_input_filename (""),
-m_statistics_output_filename ("/simulations-output/simulation_statistics.xml")
+m_statistics_output_filename ("/simulations-output/simulation_statistics.xml"),
+m_simulator_events_count (0u), m_statistics_values ()
 {
   NS_LOG_FUNCTION (this);
 }
@@ -101,23 +114,49 @@ m_normal_data_packets_per_source (copy.m_normal_data_packets_per_source),
 m_data_packet_message_size (copy.m_data_packet_message_size),
 m_data_packets_data_rate (copy.m_data_packets_data_rate),
 m_mobility_scenario_id (copy.m_mobility_scenario_id),
+m_mobility_scenario_files_prefix (copy.m_mobility_scenario_files_prefix),
 m_vehicles_count (copy.m_vehicles_count),
 m_fixed_nodes_distance (copy.m_fixed_nodes_distance),
 m_use_80211p_mac_protocol (copy.m_use_80211p_mac_protocol),
 m_progress_report_time_interval (copy.m_progress_report_time_interval),
 m_hello_packets_interval (copy.m_hello_packets_interval),
+m_adaptive_hello_interval (copy.m_adaptive_hello_interval),
+m_min_hello_packets_interval (copy.m_min_hello_packets_interval),
+m_max_hello_packets_interval (copy.m_max_hello_packets_interval),
+m_hello_interval_reference_neighbors (copy.m_hello_interval_reference_neighbors),
+m_hello_summary_vector (copy.m_hello_summary_vector),
+m_max_hello_summary_vector_size (copy.m_max_hello_summary_vector_size),
+m_hello_summary_vector_digest (copy.m_hello_summary_vector_digest),
+m_synchronized_digests_lifetime (copy.m_synchronized_digests_lifetime),
 m_packets_queue_capacity (copy.m_packets_queue_capacity),
 m_neighbor_expiration_time (copy.m_neighbor_expiration_time),
 m_data_packet_replicas (copy.m_data_packet_replicas),
+m_replica_allocation (copy.m_replica_allocation),
+m_min_data_packet_replicas (copy.m_min_data_packet_replicas),
+m_max_data_packet_replicas (copy.m_max_data_packet_replicas),
+m_replica_reference_neighbors (copy.m_replica_reference_neighbors),
+m_replica_reference_lifetime (copy.m_replica_reference_lifetime),
 m_neighbor_min_valid_distance_diff (copy.m_neighbor_min_valid_distance_diff),
 m_exponential_average_time_slot_size (copy.m_exponential_average_time_slot_size),
+m_compact_header_encoding (copy.m_compact_header_encoding),
+m_summary_vector_encoding (copy.m_summary_vector_encoding),
+m_summary_vector_false_positive_rate (copy.m_summary_vector_false_positive_rate),
+m_data_send_window (copy.m_data_send_window),
+m_data_retransmission_timeout (copy.m_data_retransmission_timeout),
+m_max_data_retransmissions (copy.m_max_data_retransmissions),
+m_max_aggregated_data_size (copy.m_max_aggregated_data_size),
+m_in_area_broadcast (copy.m_in_area_broadcast),
+m_in_area_broadcast_jitter (copy.m_in_area_broadcast_jitter),
+m_in_area_broadcast_suppression_threshold (copy.m_in_area_broadcast_suppression_threshold),
 m_streets_graph_input_filename (copy.m_streets_graph_input_filename),
 m_street_junctions_input_filename (copy.m_street_junctions_input_filename),
 m_vehicles_routes_input_filename (copy.m_vehicles_routes_input_filename),
 m_vehicles_mobility_trace_filename (copy.m_vehicles_mobility_trace_filename),
 m_random_destination_gta_input_filename (copy.m_random_destination_gta_input_filename),
 m_gta_visitor_vehicles_input_filename (copy.m_gta_visitor_vehicles_input_filename),
-m_statistics_output_filename (copy.m_statistics_output_filename)
+m_statistics_output_filename (copy.m_statistics_output_filename),
+m_simulator_events_count (copy.m_simulator_events_count),
+m_statistics_values (copy.m_statistics_values)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -168,10 +207,16 @@ GeoTemporalInstaller::Configure (int argc, char** argv)
   cmd.AddValue ("mobilityScenarioId",
                 "The identifier of the mobility scenario used in the simulation."
                 "Valid values are: fixed, 20, 30, 60, 90, 120, 30-60, 30-90, "
-                "30-120, 60-90, 60-120, 90-120, low, medium, high. "
+                "30-120, 60-90, 60-120, 90-120, low, medium, high, custom. "
                 "[Default value: 60]",
                 m_mobility_scenario_id);
 
+  cmd.AddValue ("mobilityScenarioFiles",
+                "Prefix of the names of the input files of the custom mobility "
+                "scenario (e.g. simulations-input/Luxembourg/Custom). Only used "
+                "when the custom mobility scenario is selected. [Default value: ]",
+                m_mobility_scenario_files_prefix);
+
   cmd.AddValue ("vehiclesCount",
                 "The number of vehicle nodes to create. Only actively used when "
                 "the fixed mobility scenario is selected."
@@ -203,6 +248,57 @@ GeoTemporalInstaller::Configure (int argc, char** argv)
                 "[Default value: 1,000]",
                 m_hello_packets_interval);
 
+  cmd.AddValue ("adaptiveHelloInterval",
+                "Indicates if the HELLO packets interval is scaled with the "
+                "average number of neighbor nodes and the occupancy of the "
+                "packets queue. "
+                "[Default value: false]",
+                m_adaptive_hello_interval);
+
+  cmd.AddValue ("minHelloPacketsInterval",
+                "Minimum time interval (in milliseconds) between HELLO packets "
+                "transmissions of the adaptive HELLO interval. Zero means the "
+                "HELLO packets interval. [Default value: 0]",
+                m_min_hello_packets_interval);
+
+  cmd.AddValue ("maxHelloPacketsInterval",
+                "Maximum time interval (in milliseconds) between HELLO packets "
+                "transmissions of the adaptive HELLO interval. "
+                "[Default value: 5,000]",
+                m_max_hello_packets_interval);
+
+  cmd.AddValue ("helloIntervalReferenceNeighbors",
+                "Average number of neighbor nodes per exponential average "
+                "time-slot above which the adaptive HELLO interval grows. "
+                "[Default value: 10]",
+                m_hello_interval_reference_neighbors);
+
+  cmd.AddValue ("helloSummaryVector",
+                "Indicates if the HELLO packets carry the summary vector of the "
+                "node when it fits, so the receiver answers directly with a "
+                "REPLY_BACK or DATA packets (two-way handshake). "
+                "[Default value: false]",
+                m_hello_summary_vector);
+
+  cmd.AddValue ("maxHelloSummaryVectorSize",
+                "Maximum size (in bytes) of the summary vector carried in a "
+                "HELLO packet. Bigger summary vectors are sent in REPLY packets. "
+                "[Default value: 1,400]",
+                m_max_hello_summary_vector_size);
+
+  cmd.AddValue ("helloSummaryVectorDigest",
+                "Indicates if the HELLO packets carry the digest of the summary "
+                "vector of the node, so the receiver skips the anti-entropy "
+                "sessions that would repeat the last one with the same node. "
+                "[Default value: false]",
+                m_hello_summary_vector_digest);
+
+  cmd.AddValue ("synchronizedDigestsLifetime",
+                "Time (in seconds) during which the summary vector digests of an "
+                "anti-entropy session are used to skip the following sessions "
+                "with the same node. [Default value: 30]",
+                m_synchronized_digests_lifetime);
+
   cmd.AddValue ("packetQueueCapacity",
                 "The maximum number of packets that we allow the routing "
                 "protocol to buffer. "
@@ -221,6 +317,39 @@ GeoTemporalInstaller::Configure (int argc, char** argv)
                 "[Default value: 3]",
                 m_data_packet_replicas);
 
+  cmd.AddValue ("replicaAllocation",
+                "Policy to allocate the replicas of the created DATA packets: "
+                "Fixed (always dataPacketReplicas) or DensityAdaptive (fewer "
+                "replicas with more neighbor nodes or a longer remaining "
+                "lifetime). "
+                "[Default value: Fixed]",
+                m_replica_allocation);
+
+  cmd.AddValue ("minDataPacketReplicas",
+                "Minimum number of replicas of the density-adaptive replica "
+                "allocation. "
+                "[Default value: 1]",
+                m_min_data_packet_replicas);
+
+  cmd.AddValue ("maxDataPacketReplicas",
+                "Maximum number of replicas of the density-adaptive replica "
+                "allocation. "
+                "[Default value: 8]",
+                m_max_data_packet_replicas);
+
+  cmd.AddValue ("replicaReferenceNeighbors",
+                "Exponential adaptative average of neighbor nodes with which the density-adaptive replica allocation gives "
+                "dataPacketReplicas replicas. "
+                "[Default value: 10]",
+                m_replica_reference_neighbors);
+
+  cmd.AddValue ("replicaReferenceLifetime",
+                "Remaining lifetime (in seconds) of a DATA packet with which "
+                "the density-adaptive replica allocation gives "
+                "dataPacketReplicas replicas. "
+                "[Default value: 300]",
+                m_replica_reference_lifetime);
+
   cmd.AddValue ("neighborMinimumValidDistanceDifference",
                 "Minimum distance (in meters) difference between nodes to be "
                 "valid packet carriers. "
@@ -233,6 +362,69 @@ GeoTemporalInstaller::Configure (int argc, char** argv)
                 "[Default value: 30]",
                 m_exponential_average_time_slot_size);
 
+  cmd.AddValue ("compactHeaderEncoding",
+                "Indicates if the positions, velocities and areas in the packet "
+                "headers use the compact (fixed-point, variable-length) encoding. "
+                "[Default value: false]",
+                m_compact_header_encoding);
+
+  cmd.AddValue ("summaryVectorEncoding",
+                "Encoding of the summary vectors of the REPLY packets: Explicit, "
+                "DeltaCoded, BloomFilter or Incremental. "
+                "[Default value: Explicit]",
+                m_summary_vector_encoding);
+
+  cmd.AddValue ("summaryVectorFalsePositiveRate",
+                "False positive rate of the Bloom filters of the summary vectors. "
+                "[Default value: 0.01]",
+                m_summary_vector_false_positive_rate);
+
+  cmd.AddValue ("dataSendWindow",
+                "Maximum number of DATA packets sent to a neighbor node whose "
+                "ACK hasn't been received yet (1 is stop-and-wait). "
+                "[Default value: 1]",
+                m_data_send_window);
+
+  cmd.AddValue ("dataRetransmissionTimeout",
+                "Time (in milliseconds) to wait for the ACK of a DATA packet "
+                "before retransmitting it. "
+                "[Default value: 100]",
+                m_data_retransmission_timeout);
+
+  cmd.AddValue ("maxDataRetransmissions",
+                "Maximum number of retransmissions of a DATA packet whose ACK "
+                "isn't received. "
+                "[Default value: 0]",
+                m_max_data_retransmissions);
+
+  cmd.AddValue ("maxAggregatedDataSize",
+                "Maximum size (in bytes) of the IP datagrams (including the "
+                "IP and UDP headers) of the frames that aggregate several "
+                "DATA packets to the same neighbor node (0 disables the "
+                "aggregation). Each aggregated packet uses a slot of the DATA "
+                "send window, so it needs a DATA send window bigger than 1. "
+                "[Default value: 0]",
+                m_max_aggregated_data_size);
+
+  cmd.AddValue ("inAreaBroadcast",
+                "Indicates if the DATA packets inside their destination "
+                "geo-temporal area are broadcasted once per node instead of "
+                "sent to each neighbor node in a unicast session. "
+                "[Default value: false]",
+                m_in_area_broadcast);
+
+  cmd.AddValue ("inAreaBroadcastJitter",
+                "Maximum random delay (in milliseconds) before the in-area "
+                "broadcast of a DATA packet. "
+                "[Default value: 100]",
+                m_in_area_broadcast_jitter);
+
+  cmd.AddValue ("inAreaBroadcastSuppressionThreshold",
+                "Number of overheard broadcasts of a DATA packet that suppress "
+                "its pending in-area broadcast. "
+                "[Default value: 1]",
+                m_in_area_broadcast_suppression_threshold);
+
   // Output files
 
   cmd.AddValue ("outputStatisticsFile",
@@ -250,6 +442,31 @@ GeoTemporalInstaller::Configure (int argc, char** argv)
     NS_ABORT_MSG ("The ratio of emergency DATA packets must be between 0.0 and "
                   "1.0, including both limits.");
 
+  if (m_min_hello_packets_interval == 0u)
+    m_min_hello_packets_interval = m_hello_packets_interval;
+
+  if (m_adaptive_hello_interval && m_min_hello_packets_interval > m_max_hello_packets_interval)
+    NS_ABORT_MSG ("The minimum HELLO packets interval must not be greater than "
+                  "the maximum HELLO packets interval.");
+
+  if (m_max_aggregated_data_size > 0u && m_data_send_window < 2u)
+    NS_ABORT_MSG ("The aggregation of DATA packets needs a DATA send window "
+                  "bigger than 1 packet.");
+
+  if (m_in_area_broadcast && m_in_area_broadcast_suppression_threshold == 0u)
+    NS_ABORT_MSG ("The in-area broadcast suppression threshold must be greater "
+                  "than 0.");
+
+  if (m_replica_allocation != "Fixed" && m_replica_allocation != "DensityAdaptive")
+    NS_ABORT_MSG ("Invalid replica allocation. Valid values are: Fixed and "
+                  "DensityAdaptive.");
+
+  if (m_replica_allocation == "DensityAdaptive"
+      && (m_min_data_packet_replicas == 0u
+          || m_min_data_packet_replicas > m_max_data_packet_replicas))
+    NS_ABORT_MSG ("The minimum number of DATA packet replicas must be greater "
+                  "than 0 and not greater than the maximum number of replicas.");
+
   // Configure the name of the mobility related files.
   if (m_mobility_scenario_id == "20")
     {
@@ -475,6 +692,26 @@ GeoTemporalInstaller::Configure (int argc, char** argv)
       // Geo-temporal areas visitor vehicles
       m_gta_visitor_vehicles_input_filename = "simulations-input/Luxembourg/High.geo_temporal_areas_visitor_nodes.txt";
     }
+  else if (m_mobility_scenario_id == "custom")
+    {
+      if (m_mobility_scenario_files_prefix.empty ())
+        NS_ABORT_MSG ("The prefix of the input files is required by the custom "
+                      "mobility scenario.");
+
+      // GPS initialization files
+      m_streets_graph_input_filename = m_mobility_scenario_files_prefix + ".graph.txt";
+      m_street_junctions_input_filename = m_mobility_scenario_files_prefix + ".junctions.txt";
+      m_vehicles_routes_input_filename = m_mobility_scenario_files_prefix + ".routes.txt";
+
+      // Vehicles' mobility trace file
+      m_vehicles_mobility_trace_filename = m_mobility_scenario_files_prefix + ".ns2.mob.tcl";
+
+      // Random destination areas.
+      m_random_destination_gta_input_filename = m_mobility_scenario_files_prefix + ".random_geo_temporal_areas.txt";
+
+      // Geo-temporal areas visitor vehicles
+      m_gta_visitor_vehicles_input_filename = m_mobility_scenario_files_prefix + ".geo_temporal_areas_visitor_nodes.txt";
+    }
   else if (m_mobility_scenario_id == "fixed")
     {
       // Do something when fixed mobility.
@@ -483,7 +720,7 @@ GeoTemporalInstaller::Configure (int argc, char** argv)
     {
       NS_ABORT_MSG ("Invalid mobility scenario identifier. Valid values are: "
                     "fixed, 20, 30, 60, 90, 120, 30-60, 30-90, 30-120, 60-90, "
-                    "60-120, 90-120, low, medium, high.");
+                    "60-120, 90-120, low, medium, high, custom.");
     }
 
   // When the nodes have mobility create GPS and configurate GPS system and 
@@ -499,10 +736,13 @@ GeoTemporalInstaller::Configure (int argc, char** argv)
       // Set number of vehicles in the simulation
       m_vehicles_count = m_gps_system->GetVehiclesRoutesData ().GetNodesCount ();
 
-      // Random destination geo-temporal areas object
+      // Random destination geo-temporal areas object (only the list used in
+      // this simulation is imported)
       NS_ASSERT (m_random_destination_gtas == 0);
       m_random_destination_gtas =
-              Create<RandomDestinationGeoTemporalAreasLists> (m_random_destination_gta_input_filename);
+              Create<RandomDestinationGeoTemporalAreasLists> (m_random_destination_gta_input_filename,
+                                                              m_simulation_number,
+                                                              m_data_packet_source_vehicles_count);
     }
 
   // Compute the number of emergency packets
@@ -546,6 +786,8 @@ GeoTemporalInstaller::Run ()
   std::cout << " - Data packet message size        :  " << m_data_packet_message_size << " bytes\n";
   std::cout << " - Data packets data rate          :  " << m_data_packets_data_rate << " milliseconds\n";
   std::cout << " - Mobility scenario ID            :  " << m_mobility_scenario_id << "\n";
+  if (m_mobility_scenario_id == "custom")
+    std::cout << " - Mobility scenario files prefix  :  " << m_mobility_scenario_files_prefix << "\n";
   std::cout << " - Vehicles count                  :  " << m_vehicles_count << "\n";
   std::cout << " - Distance between fixed nodes    :  " << m_fixed_nodes_distance << " meters";
   if (m_mobility_scenario_id != "fixed")
@@ -561,11 +803,52 @@ GeoTemporalInstaller::Run ()
   std::cout << "\n";
 
   std::cout << " - Hello packets time interval     :  " << m_hello_packets_interval << " milliseconds\n";
+  std::cout << " - Adaptive hello interval         :  ";
+  if (m_adaptive_hello_interval)
+    std::cout << m_min_hello_packets_interval << " to " << m_max_hello_packets_interval
+          << " milliseconds (" << m_hello_interval_reference_neighbors << " reference neighbors)\n";
+  else
+    std::cout << "Disabled\n";
+  std::cout << " - Summary vector in HELLO         :  ";
+  if (m_hello_summary_vector)
+    std::cout << "Up to " << m_max_hello_summary_vector_size << " bytes\n";
+  else
+    std::cout << "Disabled\n";
+  std::cout << " - Summary vector digest in HELLO  :  ";
+  if (m_hello_summary_vector_digest)
+    std::cout << "Enabled (" << m_synchronized_digests_lifetime << " seconds lifetime)\n";
+  else
+    std::cout << "Disabled\n";
   std::cout << " - Packets queue capacity          :  " << m_packets_queue_capacity << " packets\n";
   std::cout << " - Neighbor expiration time        :  " << m_neighbor_expiration_time << " seconds\n";
   std::cout << " - Data packet replicas            :  " << m_data_packet_replicas << " packet replicas\n";
+  std::cout << " - Replica allocation              :  " << m_replica_allocation;
+  if (m_replica_allocation == "DensityAdaptive")
+    std::cout << " (" << m_min_data_packet_replicas << " to " << m_max_data_packet_replicas
+          << " replicas, " << m_replica_reference_neighbors << " reference neighbors, "
+          << m_replica_reference_lifetime << " seconds reference lifetime)";
+  std::cout << "\n";
   std::cout << " - Min valid distance between nodes:  " << m_neighbor_min_valid_distance_diff << " meters\n";
   std::cout << " - Exp adap avg time-slot size     :  " << m_exponential_average_time_slot_size << " seconds\n";
+  std::cout << " - Compact header encoding         :  " << (m_compact_header_encoding ? "Enabled" : "Disabled") << "\n";
+  std::cout << " - Summary vector encoding         :  " << m_summary_vector_encoding;
+  if (m_summary_vector_encoding == "BloomFilter")
+    std::cout << " (" << m_summary_vector_false_positive_rate << " false positive rate)";
+  std::cout << "\n";
+  std::cout << " - DATA send window                :  " << m_data_send_window << " packets\n";
+  std::cout << " - DATA retransmissions            :  " << m_max_data_retransmissions
+          << " (" << m_data_retransmission_timeout << " milliseconds timeout)\n";
+  std::cout << " - DATA aggregation                :  ";
+  if (m_max_aggregated_data_size > 0u)
+    std::cout << "Up to " << m_max_aggregated_data_size << " bytes per frame\n";
+  else
+    std::cout << "Disabled\n";
+  std::cout << " - In-area broadcast               :  ";
+  if (m_in_area_broadcast)
+    std::cout << "Enabled (" << m_in_area_broadcast_jitter << " milliseconds jitter, suppressed after "
+          << m_in_area_broadcast_suppression_threshold << " overheard broadcasts)\n";
+  else
+    std::cout << "Disabled\n";
   std::cout << "\n";
 
   if (m_mobility_scenario_id != "fixed")
@@ -591,6 +874,7 @@ GeoTemporalInstaller::Run ()
   ScheduleNextProgressReport ();
   Simulator::Stop (Seconds (m_simulation_duration));
   Simulator::Run ();
+  m_simulator_events_count = Simulator::GetEventCount ();
   Simulator::Destroy ();
 
   std::cout << "Simulation finished.\n";
@@ -699,11 +983,34 @@ GeoTemporalInstaller::InstallInternetStack ()
   GeoTemporalHelper gt_helper;
 
   gt_helper.Set ("HelloInterval", TimeValue (MilliSeconds (m_hello_packets_interval)));
+  gt_helper.Set ("AdaptiveHelloInterval", BooleanValue (m_adaptive_hello_interval));
+  gt_helper.Set ("MinHelloInterval", TimeValue (MilliSeconds (m_min_hello_packets_interval)));
+  gt_helper.Set ("MaxHelloInterval", TimeValue (MilliSeconds (m_max_hello_packets_interval)));
+  gt_helper.Set ("HelloIntervalReferenceNeighbors", DoubleValue (m_hello_interval_reference_neighbors));
+  gt_helper.Set ("HelloSummaryVector", BooleanValue (m_hello_summary_vector));
+  gt_helper.Set ("MaxHelloSummaryVectorSize", UintegerValue (m_max_hello_summary_vector_size));
+  gt_helper.Set ("HelloSummaryVectorDigest", BooleanValue (m_hello_summary_vector_digest));
+  gt_helper.Set ("SynchronizedDigestsLifetime", TimeValue (Seconds (m_synchronized_digests_lifetime)));
   gt_helper.Set ("PacketsQueueCapacity", UintegerValue (m_packets_queue_capacity));
   gt_helper.Set ("NeighborsExpirationTime", TimeValue (Seconds (m_neighbor_expiration_time)));
   gt_helper.Set ("DataPacketReplicas", UintegerValue (m_data_packet_replicas));
+  gt_helper.Set ("ReplicaAllocation", StringValue (m_replica_allocation));
+  gt_helper.Set ("MinDataPacketReplicas", UintegerValue (m_min_data_packet_replicas));
+  gt_helper.Set ("MaxDataPacketReplicas", UintegerValue (m_max_data_packet_replicas));
+  gt_helper.Set ("ReplicaReferenceNeighbors", DoubleValue (m_replica_reference_neighbors));
+  gt_helper.Set ("ReplicaReferenceLifetime", TimeValue (Seconds (m_replica_reference_lifetime)));
   gt_helper.Set ("NeighborMinimumValidDistanceDifference", DoubleValue (m_neighbor_min_valid_distance_diff));
   gt_helper.Set ("ExponentialAverageTimeSlotSize", TimeValue (Seconds (m_exponential_average_time_slot_size)));
+  gt_helper.Set ("CompactHeaderEncoding", BooleanValue (m_compact_header_encoding));
+  gt_helper.Set ("SummaryVectorEncoding", StringValue (m_summary_vector_encoding));
+  gt_helper.Set ("SummaryVectorFalsePositiveRate", DoubleValue (m_summary_vector_false_positive_rate));
+  gt_helper.Set ("DataSendWindow", UintegerValue (m_data_send_window));
+  gt_helper.Set ("DataRetransmissionTimeout", TimeValue (MilliSeconds (m_data_retransmission_timeout)));
+  gt_helper.Set ("MaxDataRetransmissions", UintegerValue (m_max_data_retransmissions));
+  gt_helper.Set ("MaxAggregatedDataSize", UintegerValue (m_max_aggregated_data_size));
+  gt_helper.Set ("InAreaBroadcast", BooleanValue (m_in_area_broadcast));
+  gt_helper.Set ("InAreaBroadcastJitter", TimeValue (MilliSeconds (m_in_area_broadcast_jitter)));
+  gt_helper.Set ("InAreaBroadcastSuppressionThreshold", UintegerValue (m_in_area_broadcast_suppression_threshold));
 
   InternetStackHelper internet_stack;
   internet_stack.SetRoutingHelper (gt_helper); // has effect on the next Install ()
@@ -1072,6 +1379,8 @@ GeoTemporalInstaller::Report (const std::string& output_xml_filename)
         }
     }
 
+  simulation_stats.CalculateStatistics (m_statistics_values);
+
   std::cout << "Done.\n";
 
   simulation_stats.SaveToXmlFile (output_xml_filename);
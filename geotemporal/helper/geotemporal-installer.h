@@ -129,9 +129,22 @@ private:
    *   vehicles during the entire 'low' density simulation, 6,370 vehicles
    *   for the 'medium' density simulation, and 9,080 vehicles for the
    *   'high' density simulation.
+   * 
+   * - custom: Uses the input files whose names start with the prefix in
+   *   <code>m_mobility_scenario_files_prefix</code>.
    */
   std::string m_mobility_scenario_id;
 
+  /**
+   * Prefix of the names of the input files of the custom mobility scenario.
+   * Only used when the custom mobility scenario is selected.
+   * 
+   * The names of the input files are made of the prefix followed by 
+   * ".graph.txt", ".junctions.txt", ".routes.txt", ".ns2.mob.tcl", 
+   * ".random_geo_temporal_areas.txt" and ".geo_temporal_areas_visitor_nodes.txt".
+   */
+  std::string m_mobility_scenario_files_prefix;
+
   /** 
    * The number of vehicle nodes to create. Only actively used when the fixed 
    * mobility scenario is selected.
@@ -173,6 +186,40 @@ private:
   /** Time interval (in milliseconds) between HELLO packets transmissions. */
   uint32_t m_hello_packets_interval;
 
+  /** 
+   * Indicates if the HELLO interval is scaled with the average number of 
+   * neighbor nodes and the occupancy of the packets queue.
+   */
+  bool m_adaptive_hello_interval;
+
+  /** Minimum time interval (in milliseconds) of the adaptive HELLO interval.
+   * Zero means the HELLO packets interval. */
+  uint32_t m_min_hello_packets_interval;
+
+  /** Maximum time interval (in milliseconds) of the adaptive HELLO interval. */
+  uint32_t m_max_hello_packets_interval;
+
+  /** 
+   * Average number of neighbor nodes above which the adaptive HELLO interval
+   * grows.
+   */
+  double m_hello_interval_reference_neighbors;
+
+  /** Indicates if the HELLO packets carry the summary vector when it fits. */
+  bool m_hello_summary_vector;
+
+  /** Maximum size (in bytes) of the summary vector carried in a HELLO packet. */
+  uint32_t m_max_hello_summary_vector_size;
+
+  /** Indicates if the HELLO packets carry the digest of the summary vector. */
+  bool m_hello_summary_vector_digest;
+
+  /**
+   * Time (in seconds) during which the digests of an anti-entropy session are
+   * used to skip the following sessions with the same node.
+   */
+  uint32_t m_synchronized_digests_lifetime;
+
   /** 
    * The maximum number of packets that we allow the routing protocol to buffer.
    */
@@ -190,12 +237,66 @@ private:
    */
   uint32_t m_data_packet_replicas;
 
+  /** 
+   * Policy to allocate the replicas of the created DATA packets: Fixed or 
+   * DensityAdaptive.
+   */
+  std::string m_replica_allocation;
+
+  /** Minimum number of replicas of the density-adaptive replica allocation. */
+  uint32_t m_min_data_packet_replicas;
+
+  /** Maximum number of replicas of the density-adaptive replica allocation. */
+  uint32_t m_max_data_packet_replicas;
+
+  /** 
+   * Exponential adaptative average of neighbor nodes with which the density-adaptive replica allocation gives the default
+   * number of replicas.
+   */
+  double m_replica_reference_neighbors;
+
+  /** 
+   * Remaining lifetime (in seconds) of a DATA packet with which the 
+   * density-adaptive replica allocation gives the default number of replicas.
+   */
+  uint32_t m_replica_reference_lifetime;
+
   /** Minimum distance (in meters) difference between nodes to be valid packet carriers. */
   double m_neighbor_min_valid_distance_diff;
 
   /** Size (in seconds) of the time-slot to calculate exponential average. */
   uint32_t m_exponential_average_time_slot_size;
 
+  /** Indicates if the packet headers use the compact coordinates encoding. */
+  bool m_compact_header_encoding;
+
+  /** Encoding of the summary vectors (Explicit, DeltaCoded, BloomFilter or Incremental). */
+  std::string m_summary_vector_encoding;
+
+  /** False positive rate of the Bloom filters of the summary vectors. */
+  double m_summary_vector_false_positive_rate;
+
+  /** Maximum number of DATA packets sent to a neighbor whose ACK hasn't been received. */
+  uint32_t m_data_send_window;
+
+  /** Time (in milliseconds) to wait for the ACK of a DATA packet before retransmitting it. */
+  uint32_t m_data_retransmission_timeout;
+
+  /** Maximum number of retransmissions of a DATA packet whose ACK isn't received. */
+  uint32_t m_max_data_retransmissions;
+
+  /** Maximum size (in bytes) of the frames that aggregate DATA packets (0 disables it). */
+  uint32_t m_max_aggregated_data_size;
+
+  /** Indicates if the DATA packets are broadcasted inside their destination area. */
+  bool m_in_area_broadcast;
+
+  /** Maximum random delay (in milliseconds) before the in-area broadcast of a DATA packet. */
+  uint32_t m_in_area_broadcast_jitter;
+
+  /** Number of overheard broadcasts of a DATA packet that suppress its in-area broadcast. */
+  uint32_t m_in_area_broadcast_suppression_threshold;
+
 
   // --------------------------
   // Input files
@@ -232,6 +333,17 @@ private:
   std::string m_statistics_output_filename;
 
 
+  // --------------------------
+  // Results
+  // --------------------------
+
+  /** Number of events executed by the simulator during the simulation. */
+  uint64_t m_simulator_events_count;
+
+  /** The statistics computed in the last call to <code>Report</code>. */
+  PrioritySimulationStatisticsValues m_statistics_values;
+
+
 public:
 
   GeoTemporalInstaller ();
@@ -245,6 +357,24 @@ public:
     return m_node_id_to_ip;
   }
 
+  /** Returns the number of events executed by the simulator during the simulation. */
+  inline uint64_t
+  GetSimulatorEventsCount () const
+  {
+    return m_simulator_events_count;
+  }
+
+  /**
+   * Returns the statistics computed in the last call to <code>Report</code>.
+   * Their values are not initialized if the statistics weren't computed (e.g. 
+   * in the fixed mobility scenario).
+   */
+  inline const PrioritySimulationStatisticsValues &
+  GetStatisticsValues () const
+  {
+    return m_statistics_values;
+  }
+
 
   /**
    * Receives user input and configures the simulation, mobility and routing 
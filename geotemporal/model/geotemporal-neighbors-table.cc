@@ -116,14 +116,20 @@ NeighborsTable::NeighborsTable ()
 }
 
 NeighborsTable::NeighborsTable (const Time& entries_expiration_time)
-: m_table (), m_entries_expiration_time (entries_expiration_time)
+: m_table (), m_entries_expiration_time (entries_expiration_time),
+m_expiration_index (), m_sent_summary_vector_versions (), m_received_summary_vectors (),
+m_outstanding_data_packets ()
 {
   NS_LOG_FUNCTION (this);
 }
 
 NeighborsTable::NeighborsTable (const NeighborsTable& copy)
 : m_table (copy.m_table),
-m_entries_expiration_time (copy.m_entries_expiration_time)
+m_entries_expiration_time (copy.m_entries_expiration_time),
+m_expiration_index (copy.m_expiration_index),
+m_sent_summary_vector_versions (copy.m_sent_summary_vector_versions),
+m_received_summary_vectors (copy.m_received_summary_vectors),
+m_outstanding_data_packets (copy.m_outstanding_data_packets)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -226,6 +232,7 @@ NeighborsTable::Insert (NeighborEntry& new_neighbor_entry)
   new_neighbor_entry.SetExpirationTime (m_entries_expiration_time);
 
   m_table.insert (std::make_pair (new_neighbor_ip, new_neighbor_entry));
+  m_expiration_index.Push (new_neighbor_ip, new_neighbor_entry.GetExpirationInstant ());
 
   NS_LOG_DEBUG (m_table.size () << " neighbors after insertion of new neighbor: "
                 << new_neighbor_entry);
@@ -316,26 +323,196 @@ NeighborsTable::RestartNeighborEntryExpirationTime (const Ipv4Address& neighbor_
                 << " restarted.");
 
   entry_it->second.SetExpirationTime (m_entries_expiration_time);
+  m_expiration_index.Push (neighbor_ip, entry_it->second.GetExpirationInstant ());
+  return true;
+}
+
+
+// --------------------------
+// Summary vector versions
+// --------------------------
+
+bool
+NeighborsTable::FindSentSummaryVectorVersion (const Ipv4Address& neighbor_ip,
+                                              uint32_t& version) const
+{
+  std::map<Ipv4Address, uint32_t>::const_iterator version_it
+          = m_sent_summary_vector_versions.find (neighbor_ip);
+
+  if (version_it == m_sent_summary_vector_versions.end ())
+    return false;
+
+  version = version_it->second;
+  return true;
+}
+
+void
+NeighborsTable::SetSentSummaryVectorVersion (const Ipv4Address& neighbor_ip, uint32_t version)
+{
+  NS_LOG_FUNCTION (this << neighbor_ip << version);
+
+  m_sent_summary_vector_versions[neighbor_ip] = version;
+}
+
+bool
+NeighborsTable::RemoveSentSummaryVectorVersion (const Ipv4Address& neighbor_ip)
+{
+  NS_LOG_FUNCTION (this << neighbor_ip);
+
+  return m_sent_summary_vector_versions.erase (neighbor_ip) > 0u;
+}
+
+bool
+NeighborsTable::UpdateReceivedSummaryVector (const Ipv4Address& neighbor_ip,
+                                             uint32_t base_version, uint32_t version,
+                                             const std::set<DataIdentifier>& inserted_packets,
+                                             const std::set<DataIdentifier>& removed_packets,
+                                             std::set<DataIdentifier>& summary_vector)
+{
+  NS_LOG_FUNCTION (this << neighbor_ip << base_version << version);
+
+  if (base_version == 0u)
+    {
+      // Whole summary vector.
+      m_received_summary_vectors[neighbor_ip] = std::make_pair (version, inserted_packets);
+      summary_vector = inserted_packets;
+      return true;
+    }
+
+  std::map<Ipv4Address, std::pair<uint32_t, std::set<DataIdentifier> > >::iterator received_it
+          = m_received_summary_vectors.find (neighbor_ip);
+
+  if (received_it == m_received_summary_vectors.end ()
+      || received_it->second.first != base_version)
+    {
+      NS_LOG_DEBUG ("No summary vector of version " << base_version << " stored "
+                    "for neighbor " << neighbor_ip << ". Changes ignored.");
+
+      if (received_it != m_received_summary_vectors.end ())
+        m_received_summary_vectors.erase (received_it);
+
+      return false;
+    }
+
+  std::set<DataIdentifier> & received_summary_vector = received_it->second.second;
+
+  for (std::set<DataIdentifier>::const_iterator it = removed_packets.begin ();
+          it != removed_packets.end (); ++it)
+    {
+      received_summary_vector.erase (*it);
+    }
+
+  received_summary_vector.insert (inserted_packets.begin (), inserted_packets.end ());
+  received_it->second.first = version;
+
+  summary_vector = received_summary_vector;
+  return true;
+}
+
+
+// --------------------------
+// Outstanding DATA packets
+// --------------------------
+
+uint32_t
+NeighborsTable::GetOutstandingDataPacketsCount (const Ipv4Address& neighbor_ip) const
+{
+  std::map<Ipv4Address, std::map<DataIdentifier, uint32_t> >::const_iterator neighbor_it
+          = m_outstanding_data_packets.find (neighbor_ip);
+
+  if (neighbor_it == m_outstanding_data_packets.end ())
+    return 0u;
+
+  return neighbor_it->second.size ();
+}
+
+bool
+NeighborsTable::FindOutstandingDataPacket (const Ipv4Address& neighbor_ip,
+                                           const DataIdentifier& data_id,
+                                           uint32_t& transmissions_count) const
+{
+  std::map<Ipv4Address, std::map<DataIdentifier, uint32_t> >::const_iterator neighbor_it
+          = m_outstanding_data_packets.find (neighbor_ip);
+
+  if (neighbor_it == m_outstanding_data_packets.end ())
+    return false;
+
+  std::map<DataIdentifier, uint32_t>::const_iterator packet_it = neighbor_it->second.find (data_id);
+
+  if (packet_it == neighbor_it->second.end ())
+    return false;
+
+  transmissions_count = packet_it->second;
   return true;
 }
 
+void
+NeighborsTable::SetOutstandingDataPacket (const Ipv4Address& neighbor_ip,
+                                          const DataIdentifier& data_id,
+                                          uint32_t transmissions_count)
+{
+  NS_LOG_FUNCTION (this << neighbor_ip << data_id << transmissions_count);
+
+  m_outstanding_data_packets[neighbor_ip][data_id] = transmissions_count;
+}
+
+bool
+NeighborsTable::RemoveOutstandingDataPacket (const Ipv4Address& neighbor_ip,
+                                             const DataIdentifier& data_id)
+{
+  NS_LOG_FUNCTION (this << neighbor_ip << data_id);
+
+  std::map<Ipv4Address, std::map<DataIdentifier, uint32_t> >::iterator neighbor_it
+          = m_outstanding_data_packets.find (neighbor_ip);
+
+  if (neighbor_it == m_outstanding_data_packets.end ()
+      || neighbor_it->second.erase (data_id) == 0u)
+    return false;
+
+  if (neighbor_it->second.empty ())
+    m_outstanding_data_packets.erase (neighbor_it);
+
+  return true;
+}
+
+void
+NeighborsTable::ClearOutstandingDataPackets (const Ipv4Address& neighbor_ip)
+{
+  NS_LOG_FUNCTION (this << neighbor_ip);
+
+  m_outstanding_data_packets.erase (neighbor_ip);
+}
+
 void
 NeighborsTable::Purge ()
 {
   NS_LOG_FUNCTION (this);
 
-  for (ConstIterator_t entry_it = m_table.begin (); entry_it != m_table.end ();)
+  const Time now = Simulator::Now ();
+
+  while (m_expiration_index.HasExpired (now))
     {
-      if (entry_it->second.GetExpirationTime () <= Seconds (0))
-        {
-          NS_LOG_LOGIC ("Drops expired neighbor entry : " << entry_it->second);
-          // m_table.erase (entry_it++); // For C++03
-          entry_it = m_table.erase (entry_it); // For C++11
-        }
-      else
-        {
-          ++entry_it;
-        }
+      Iterator_t entry_it = m_table.find (m_expiration_index.Pop ());
+
+      // Ignore the stale instants of removed or restarted entries
+      if (entry_it == m_table.end () || entry_it->second.GetExpirationInstant () > now)
+        continue;
+
+      NS_LOG_LOGIC ("Drops expired neighbor entry : " << entry_it->second);
+
+      // The next contact with the neighbor starts with whole summary vectors.
+      m_sent_summary_vector_versions.erase (entry_it->first);
+      m_received_summary_vectors.erase (entry_it->first);
+      m_outstanding_data_packets.erase (entry_it->first);
+      m_table.erase (entry_it);
+    }
+
+  if (m_expiration_index.NeedsRebuild (m_table.size ()))
+    {
+      m_expiration_index.clear ();
+
+      for (ConstIterator_t entry_it = m_table.begin (); entry_it != m_table.end (); ++entry_it)
+        m_expiration_index.Push (entry_it->first, entry_it->second.GetExpirationInstant ());
     }
 }
 
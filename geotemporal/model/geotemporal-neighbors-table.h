@@ -28,11 +28,13 @@
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 
 #include <ns3/ipv4-address.h>
 #include <ns3/nstime.h>
 #include <ns3/simulator.h>
 
+#include <ns3/geotemporal-utils.h>
 #include <ns3/packet-utils.h>
 
 using namespace GeoTemporalLibrary::LibraryUtils;
@@ -108,6 +110,13 @@ public:
     m_expiration_time = expiration_time + Simulator::Now ();
   }
 
+  /** Returns the simulation time at which the entry expires. */
+  inline const Time &
+  GetExpirationInstant () const
+  {
+    return m_expiration_time;
+  }
+
   /** Returns the entire current set of requested packets. */
   inline const std::set<DataIdentifier> &
   GetRequestedPacketsSet () const
@@ -195,12 +204,34 @@ private:
   /** Expiration time of the neighbor entries. */
   Time m_entries_expiration_time;
 
+  /** Expiration instants of the neighbor entries, used to purge only the 
+   * expired entries. */
+  ExpirationIndex<Ipv4Address> m_expiration_index;
+
   /** Neighbors table iterator. */
   typedef std::map<Ipv4Address, NeighborEntry>::iterator Iterator_t;
 
   /** Neighbors table constant iterator. */
   typedef std::map<Ipv4Address, NeighborEntry>::const_iterator ConstIterator_t;
 
+  /**
+   * Version of the local summary vector last sent to each neighbor. It is
+   * forgotten when the entry of the neighbor expires.
+   */
+  std::map<Ipv4Address, uint32_t> m_sent_summary_vector_versions;
+
+  /**
+   * Last summary vector received from each neighbor and its version. It is
+   * forgotten when the entry of the neighbor expires.
+   */
+  std::map<Ipv4Address, std::pair<uint32_t, std::set<DataIdentifier> > > m_received_summary_vectors;
+
+  /**
+   * DATA packets sent to each neighbor whose ACK hasn't been received yet, and
+   * the number of times that each one has been transmitted.
+   */
+  std::map<Ipv4Address, std::map<DataIdentifier, uint32_t> > m_outstanding_data_packets;
+
 
 public:
 
@@ -294,6 +325,10 @@ public:
   Clear ()
   {
     m_table.clear ();
+    m_expiration_index.clear ();
+    m_sent_summary_vector_versions.clear ();
+    m_received_summary_vectors.clear ();
+    m_outstanding_data_packets.clear ();
   }
 
   /**
@@ -415,10 +450,136 @@ public:
   RestartNeighborEntryExpirationTime (const Ipv4Address & neighbor_ip);
 
 
+  // --------------------------
+  // Summary vector versions
+  // --------------------------
+
+  /**
+   * Finds the version of the local summary vector last sent to the neighbor
+   * node with the specified IP address.
+   * 
+   * @param neighbor_ip [IN] IP address of the neighbor node.
+   * @param version [OUT] The version last sent to the neighbor node, if any. 
+   * Otherwise this out parameter is not modified.
+   * 
+   * @return <code>true</code> if a summary vector was sent to the neighbor 
+   * node. Otherwise returns <code>false</code>.
+   */
+  bool
+  FindSentSummaryVectorVersion (const Ipv4Address & neighbor_ip, uint32_t & version) const;
+
+  /**
+   * Sets the version of the local summary vector last sent to the neighbor 
+   * node with the specified IP address.
+   */
+  void
+  SetSentSummaryVectorVersion (const Ipv4Address & neighbor_ip, uint32_t version);
+
+  /**
+   * Forgets the version of the local summary vector last sent to the neighbor
+   * node with the specified IP address, so the next summary vector sent to it
+   * is the whole one.
+   * 
+   * @return <code>true</code> if the removal took place. If there was no 
+   * removal then <code>false</code>.
+   */
+  bool
+  RemoveSentSummaryVectorVersion (const Ipv4Address & neighbor_ip);
+
+  /**
+   * Updates the last summary vector received from the neighbor node with the
+   * specified IP address with the received changes, and returns the resulting
+   * summary vector.
+   * 
+   * If the base version is 0 the inserted packets are the whole summary vector
+   * of the neighbor node. Otherwise, the stored summary vector of the neighbor
+   * node must have the base version. If it doesn't (or there's no stored 
+   * summary vector) the changes can't be applied: the stored summary vector is
+   * forgotten and it returns <code>false</code>.
+   * 
+   * @param neighbor_ip [IN] IP address of the neighbor node.
+   * @param base_version [IN] Version that the changes are based on.
+   * @param version [IN] Version of the summary vector after the changes.
+   * @param inserted_packets [IN] Packets inserted since the base version.
+   * @param removed_packets [IN] Packets removed since the base version.
+   * @param summary_vector [OUT] The updated summary vector of the neighbor 
+   * node. It is only modified if the changes are applied.
+   * 
+   * @return <code>true</code> if the changes were applied, otherwise 
+   * <code>false</code>.
+   */
+  bool
+  UpdateReceivedSummaryVector (const Ipv4Address & neighbor_ip, uint32_t base_version,
+                               uint32_t version,
+                               const std::set<DataIdentifier> & inserted_packets,
+                               const std::set<DataIdentifier> & removed_packets,
+                               std::set<DataIdentifier> & summary_vector);
+
+
+  // --------------------------
+  // Outstanding DATA packets
+  // --------------------------
+
+  /**
+   * Returns the number of DATA packets sent to the neighbor node with the 
+   * specified IP address whose ACK hasn't been received yet.
+   */
+  uint32_t
+  GetOutstandingDataPacketsCount (const Ipv4Address & neighbor_ip) const;
+
+  /**
+   * Finds a DATA packet sent to the neighbor node with the specified IP 
+   * address whose ACK hasn't been received yet.
+   * 
+   * @param neighbor_ip [IN] IP address of the neighbor node.
+   * @param data_id [IN] Data identifier of the packet.
+   * @param transmissions_count [OUT] Number of times that the packet has been
+   * transmitted to the neighbor node. If the packet is not outstanding this
+   * out parameter is not modified.
+   * 
+   * @return <code>true</code> if the packet is outstanding. Otherwise returns
+   * <code>false</code>.
+   */
+  bool
+  FindOutstandingDataPacket (const Ipv4Address & neighbor_ip, const DataIdentifier & data_id,
+                             uint32_t & transmissions_count) const;
+
+  /**
+   * Sets the DATA packet as sent to the neighbor node with the specified IP 
+   * address and waiting for its ACK, with the given number of transmissions.
+   */
+  void
+  SetOutstandingDataPacket (const Ipv4Address & neighbor_ip, const DataIdentifier & data_id,
+                            uint32_t transmissions_count);
+
+  /**
+   * Removes the outstanding DATA packet of the neighbor node with the 
+   * specified IP address (when its ACK is received or its retransmissions are
+   * exhausted).
+   * 
+   * @return <code>true</code> if the removal took place. If there was no 
+   * removal then <code>false</code>.
+   */
+  bool
+  RemoveOutstandingDataPacket (const Ipv4Address & neighbor_ip, const DataIdentifier & data_id);
+
+  /**
+   * Removes all the outstanding DATA packets of the neighbor node with the 
+   * specified IP address (when a new session with the neighbor starts).
+   */
+  void
+  ClearOutstandingDataPackets (const Ipv4Address & neighbor_ip);
+
+
 public:
 
   /**
-   * Removes all expired neighbor entries from the neighbors table.
+   * Removes all expired neighbor entries from the neighbors table, along with
+   * the summary vectors sent to and received from the expired neighbors and 
+   * the DATA packets outstanding to them.
+   * 
+   * It only visits the entries whose expiration instant has passed, so it can
+   * be called on every received packet.
    */
   void
   Purge ();
@@ -444,7 +605,10 @@ inline bool
 operator== (const NeighborsTable & lhs, const NeighborsTable & rhs)
 {
   return lhs.m_table == rhs.m_table
-          && lhs.m_entries_expiration_time == rhs.m_entries_expiration_time;
+          && lhs.m_entries_expiration_time == rhs.m_entries_expiration_time
+          && lhs.m_sent_summary_vector_versions == rhs.m_sent_summary_vector_versions
+          && lhs.m_received_summary_vectors == rhs.m_received_summary_vectors
+          && lhs.m_outstanding_data_packets == rhs.m_outstanding_data_packets;
 }
 
 inline bool
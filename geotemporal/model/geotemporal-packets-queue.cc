@@ -29,6 +29,7 @@
 #include <cstdio>
 #include <iterator>
 #include <utility>
+#include <vector>
 
 #include <ns3/log.h>
 #include <ns3/simulator.h>
@@ -78,7 +79,7 @@ PacketQueueEntry::ToString () const
   std::string str = "Packet queue entry " + m_data_packet.GetDataIdentifier ().ToString ()
           + " will expire at second " + std::string (buffer) + ", is known by ";
 
-  std::sprintf (buffer, "%d", (uint32_t) m_known_carriers.size ());
+  std::sprintf (buffer, "%d", m_known_carriers.Size ());
   str += std::string (buffer) + " nodes and has ";
 
   std::sprintf (buffer, "%d", (uint32_t) m_replicas_counter);
@@ -95,19 +96,24 @@ PacketsQueue::PacketsQueue () : PacketsQueue (0, 128u, 3u) { }
 
 PacketsQueue::PacketsQueue (Ptr<GpsSystem> gps_system, uint32_t maximum_queue_length,
                             uint32_t default_replicas_counter)
-: m_gps (gps_system), m_max_queue_length (maximum_queue_length),
-m_max_replicas_counter (default_replicas_counter), m_packets_dropped_counter (0u),
-m_min_vehicles_distance_diff (20), m_packets_table (),
-m_data_packet_reception_stats () { }
+: m_gps (gps_system), m_max_replicas_counter (default_replicas_counter),
+m_min_vehicles_distance_diff (20), m_packets_table (maximum_queue_length),
+m_data_packet_reception_stats (), m_summary_vector_version (0u),
+m_summary_vector_log_capacity (256u), m_summary_vector_log (),
+m_summary_vector_digest (0u), m_transmit_sessions (), m_drop_index () { }
 
 PacketsQueue::PacketsQueue (const PacketsQueue& copy)
 : m_gps (copy.m_gps),
-m_max_queue_length (copy.m_max_queue_length),
 m_max_replicas_counter (copy.m_max_replicas_counter),
-m_packets_dropped_counter (copy.m_packets_dropped_counter),
 m_min_vehicles_distance_diff (copy.m_min_vehicles_distance_diff),
 m_packets_table (copy.m_packets_table),
-m_data_packet_reception_stats (copy.m_data_packet_reception_stats) { }
+m_data_packet_reception_stats (copy.m_data_packet_reception_stats),
+m_summary_vector_version (copy.m_summary_vector_version),
+m_summary_vector_log_capacity (copy.m_summary_vector_log_capacity),
+m_summary_vector_log (copy.m_summary_vector_log),
+m_summary_vector_digest (copy.m_summary_vector_digest),
+m_transmit_sessions (copy.m_transmit_sessions),
+m_drop_index (copy.m_drop_index) { }
 
 
 // --------------------------
@@ -132,6 +138,80 @@ PacketsQueue::GetSummaryVector (std::set<DataIdentifier>& summary_vector) const
     }
 }
 
+void
+PacketsQueue::GetInsideAreaPackets (const Vector2D& current_node_position,
+                                    std::vector<DataIdentifier>& inside_area_packets) const
+{
+  inside_area_packets.clear ();
+
+  const Time current_time = Simulator::Now ();
+
+  for (ConstIterator_t entry_it = m_packets_table.begin ();
+          entry_it != m_packets_table.end (); ++entry_it)
+    {
+      if (entry_it->second.GetDataPacket ().GetDestinationGeoTemporalArea ()
+          .IsInsideGeoTemporalArea (current_node_position, current_time))
+        inside_area_packets.push_back (entry_it->first);
+    }
+}
+
+uint32_t
+PacketsQueue::ComputeSummaryVectorDigest (const std::set<DataIdentifier>& summary_vector)
+{
+  uint32_t digest = 0u;
+
+  for (std::set<DataIdentifier>::const_iterator data_id_it = summary_vector.begin ();
+          data_id_it != summary_vector.end (); ++data_id_it)
+    {
+      const uint64_t hash = HashDataIdentifier (*data_id_it);
+      digest ^= (uint32_t) (hash ^ (hash >> 32));
+    }
+
+  return digest;
+}
+
+void
+PacketsQueue::SetSummaryVectorLogCapacity (uint32_t log_capacity)
+{
+  m_summary_vector_log_capacity = log_capacity;
+
+  while (m_summary_vector_log.size () > m_summary_vector_log_capacity)
+    m_summary_vector_log.pop_front ();
+}
+
+bool
+PacketsQueue::GetSummaryVectorChanges (uint32_t since_version,
+                                       std::set<DataIdentifier>& inserted_packets,
+                                       std::set<DataIdentifier>& removed_packets) const
+{
+  NS_LOG_FUNCTION (this << since_version);
+
+  inserted_packets.clear ();
+  removed_packets.clear ();
+
+  // The log contains the changes from the version (current - log size) to the
+  // current version.
+  const uint32_t oldest_version = m_summary_vector_version - m_summary_vector_log.size ();
+
+  if (since_version > m_summary_vector_version || since_version < oldest_version)
+    return false;
+
+  std::deque<std::pair<DataIdentifier, bool> >::const_iterator change_it
+          = m_summary_vector_log.begin () + (since_version - oldest_version);
+
+  for (; change_it != m_summary_vector_log.end (); ++change_it)
+    {
+      std::set<DataIdentifier> & same_change = change_it->second ? inserted_packets : removed_packets;
+      std::set<DataIdentifier> & opposite_change = change_it->second ? removed_packets : inserted_packets;
+
+      // A change that reverts a previous one cancels it.
+      if (opposite_change.erase (change_it->first) == 0u)
+        same_change.insert (change_it->first);
+    }
+
+  return true;
+}
+
 
 
 // --------------------------
@@ -187,47 +267,71 @@ PacketsQueue::ProcessDisjointVectors (const std::set<DataIdentifier>& summary_ve
   local_unknown_packets.clear ();
   neighbor_unknown_packets.clear ();
 
-  /* For each packet in the received summary vector check if it is contained in 
-   * this packets queue. If it doesn't it means that the local node does NOT
-   * know the packet, so it's added to the local_unknown_packets set (the set of
-   * packets that the local node doesn't know).
+  /* Both disjoint vectors are computed in a single merge pass over the sorted
+   * identifiers of this packets queue and the received summary vector.
    * 
-   * It also checks that the local node is not the source of the packet. */
+   * The packets of the summary vector that are not in this packets queue are
+   * the packets that the local node does NOT know, and the packets of this
+   * packets queue that are not in the summary vector are the packets that the
+   * neighbor node does NOT know. */
+  std::vector<DataIdentifier> local_unknown_candidates, neighbor_unknown_candidates;
+
+  MergeDisjointVectors (m_packets_table.GetSortedKeys (), summary_vector,
+                        &neighbor_unknown_candidates, &local_unknown_candidates);
+
+  // The packets whose source is the local node are not unknown to it.
+  for (std::vector<DataIdentifier>::const_iterator it = local_unknown_candidates.begin ();
+          it != local_unknown_candidates.end (); ++it)
+    {
+      if (it->GetSourceIp () != local_ip)
+        local_unknown_packets.insert (local_unknown_packets.end (), *it);
+    }
 
-  for (std::set<DataIdentifier>::const_iterator it = summary_vector.begin ();
-          it != summary_vector.end (); ++it)
+  // The packets whose source is the neighbor node are not unknown to it.
+  for (std::vector<DataIdentifier>::const_iterator it = neighbor_unknown_candidates.begin ();
+          it != neighbor_unknown_candidates.end (); ++it)
     {
-      // If the local node doesn't know the packet and the local node is not the
-      // source node, then add it to the local_unknown_packets set.
-      if (m_packets_table.find (*it) == m_packets_table.end ()
-          && it->GetSourceIp () != local_ip)
-        {
-          local_unknown_packets.insert (*it);
-        }
+      if (it->GetSourceIp () != neighbor_ip)
+        neighbor_unknown_packets.insert (neighbor_unknown_packets.end (), *it);
     }
+}
+
+uint32_t
+PacketsQueue::ProcessDisjointVectors (const DataIdentifierBloomFilter& bloom_filter,
+                                      uint32_t summary_vector_size,
+                                      const Ipv4Address& neighbor_ip,
+                                      std::set<DataIdentifier>& neighbor_known_packets,
+                                      std::set<DataIdentifier>& neighbor_unknown_packets) const
+{
+  NS_LOG_FUNCTION (this << summary_vector_size << neighbor_ip);
+
+  neighbor_known_packets.clear ();
+  neighbor_unknown_packets.clear ();
 
-  /* For each packet contained in this packets queue check if it exists in the
-   * received summary vector. If it doesn't it means that the neighbor node 
-   * doesn't know it, so it's added to the neighbor_unknown_packets (the set of
-   * packets that the neighbor node doesn't know).
-   * 
-   * Also checks that the neighbor node is not the source of the packet. */
   for (ConstIterator_t it = m_packets_table.begin ();
           it != m_packets_table.end (); ++it)
     {
+      if (bloom_filter.MayContain (it->first))
+        {
+          neighbor_known_packets.insert (it->first);
+        }
       // If the neighbor node doesn't know the packet and the neighbor node is not
       // the source node, then add it to the neighbor_unknown_packets set.
-      if (summary_vector.find (it->first) == summary_vector.end ()
-          && it->first.GetSourceIp () != neighbor_ip)
+      else if (it->first.GetSourceIp () != neighbor_ip)
         {
           neighbor_unknown_packets.insert (it->first);
         }
     }
+
+  if (summary_vector_size <= neighbor_known_packets.size ())
+    return 0u;
+
+  return summary_vector_size - neighbor_known_packets.size ();
 }
 
 bool
-PacketsQueue::ComparePacketTransmissionPriority (const std::map<DataIdentifier, PacketQueueEntry>::value_type& entry_1,
-                                                 const std::map<DataIdentifier, PacketQueueEntry>::value_type& entry_2)
+PacketsQueue::ComparePacketTransmissionPriority (const DataIdentifierMap<PacketQueueEntry>::value_type& entry_1,
+                                                 const DataIdentifierMap<PacketQueueEntry>::value_type& entry_2)
 {
   const DataHeader & packet_1 = entry_1.second.GetDataPacket ();
   const DataHeader & packet_2 = entry_2.second.GetDataPacket ();
@@ -255,9 +359,22 @@ PacketsQueue::ComparePacketTransmissionPriority (const std::map<DataIdentifier,
   return entry_1.second.GetKnownCarrierNodesCount () > entry_2.second.GetKnownCarrierNodesCount ();
 }
 
+bool
+PacketsQueue::ComparePacketDropPriority (const DataIdentifierMap<PacketQueueEntry>::value_type& entry_1,
+                                         const DataIdentifierMap<PacketQueueEntry>::value_type& entry_2)
+{
+  if (ComparePacketTransmissionPriority (entry_1, entry_2))
+    return true;
+
+  if (ComparePacketTransmissionPriority (entry_2, entry_1))
+    return false;
+
+  return entry_1.first < entry_2.first;
+}
+
 bool
 PacketsQueue::FindHighestDropPriorityPacket (const Vector2D& current_node_position,
-                                             DataIdentifier& selected_packet) const
+                                             DataIdentifier& selected_packet)
 {
   NS_LOG_FUNCTION (this << current_node_position);
 
@@ -281,105 +398,187 @@ PacketsQueue::FindHighestDropPriorityPacket (const Vector2D& current_node_positi
   /* We drop the packet with the lowest transmission priority. So the packet
    * with the lowest transmission priority also has the highest drop priority.
    * 
-   * We use ComparePacketTransmissionPriority (A, B) that returns true if A has
-   * lower transmission priority than B. Because another way to look at it is
-   * that A has higher drop priority than B.
+   * The buckets of the drop priority index are sorted by drop priority (see
+   * ComparePacketDropPriority). Ties are broken by data identifier.
    * 
    * If possible, try to find a regular packet that is outside its destination
    * GTA and has the lowest possible transmission priority.
    */
 
+  UpdateDropClasses (current_node_position);
+
+  static const char * const drop_class_names[DROP_CLASSES_COUNT] = {
+    "Regular packet outside its destination geo-temporal area",
+    "Regular packet inside its destination geo-temporal area",
+    "Emergency packet outside its destination geo-temporal area",
+    "Emergency packet inside its destination geo-temporal area"};
+
+  for (uint8_t drop_class = 0u; drop_class < DROP_CLASSES_COUNT; ++drop_class)
+    {
+      const std::set<DropPriorityKey> & bucket = m_drop_index.m_buckets[drop_class];
+
+      if (bucket.empty ()) continue;
+
+      selected_packet = bucket.begin ()->m_data_id;
+      NS_LOG_DEBUG (drop_class_names[drop_class] << " selected: " << selected_packet);
+      return true;
+    }
+
+  NS_ABORT_MSG ("A packet should have been selected.");
+  return false;
+}
+
+Time
+PacketsQueue::GetNextTimePeriodUpdate (const TimePeriod& time_period, const Time& current_time)
+{
+  if (current_time < time_period.GetStartTime ())
+    return time_period.GetStartTime ();
+
+  // The time period includes its end time.
+  if (current_time <= time_period.GetEndTime ())
+    return time_period.GetEndTime () + TimeStep (1);
+
+  return Time::Max ();
+}
+
+void
+PacketsQueue::InsertDropPriorityEntry (const DataIdentifier& data_id, const PacketQueueEntry& entry)
+{
+  NS_LOG_FUNCTION (this << data_id);
+
+  const DataHeader & data_packet = entry.GetDataPacket ();
+  const GeoTemporalArea & destination_gta = data_packet.GetDestinationGeoTemporalArea ();
   const Time current_time = Simulator::Now ();
 
-  ConstIterator_t lowest_priority_emergency_pkt_it = m_packets_table.end ();
-  ConstIterator_t lowest_priority_emergency_pkt_not_in_gta_it = m_packets_table.end ();
+  DropPriorityKey key;
+  key.m_hops_count = data_packet.GetHopsCount ();
+  key.m_known_carriers_count = entry.GetKnownCarrierNodesCount ();
+  key.m_data_id = data_id;
 
-  ConstIterator_t lowest_priority_regular_pkt_it = m_packets_table.end ();
-  ConstIterator_t lowest_priority_regular_pkt_not_in_gta_it = m_packets_table.end ();
+  const uint8_t drop_class = ComputeDropClass (data_packet.IsEmergencyPacket (),
+                                               destination_gta.IsInsideGeoTemporalArea (m_drop_index.m_position,
+                                                                                        current_time));
 
-  for (ConstIterator_t packet_entry_it = m_packets_table.begin ();
-          packet_entry_it != m_packets_table.end (); ++packet_entry_it)
-    {
-      const DataHeader & current_data_packet = packet_entry_it->second.GetDataPacket ();
-      const bool outside_gta = !current_data_packet.GetDestinationGeoTemporalArea ()
-              .IsInsideGeoTemporalArea (current_node_position, current_time);
+  const uint32_t slot = m_drop_index.m_areas.Add (destination_gta.GetArea ());
+  m_drop_index.m_data_ids.push_back (data_id);
+  m_drop_index.m_time_periods.push_back (destination_gta.GetTimePeriod ());
+  m_drop_index.m_emergency_flags.push_back (data_packet.IsEmergencyPacket ());
+  m_drop_index.m_drop_classes.push_back (drop_class);
 
-      if (current_data_packet.IsEmergencyPacket ())
-        {
-          // If the current emergency data packet is the one with the lowest 
-          // transmission priority then select it.
-          if (lowest_priority_emergency_pkt_it == m_packets_table.end ()
-              || ComparePacketTransmissionPriority (*packet_entry_it, *lowest_priority_emergency_pkt_it))
-            {
-              lowest_priority_emergency_pkt_it = packet_entry_it;
-            }
+  m_drop_index.m_entries.insert (std::make_pair (data_id, std::make_pair (slot, key)));
+  m_drop_index.m_buckets[drop_class].insert (key);
 
-          // If the current emergency data packet is outside its destination GTA
-          // and has lower transmission priority than the currently selected
-          // packet then select it.
-          if (outside_gta
-              && (lowest_priority_emergency_pkt_not_in_gta_it == m_packets_table.end ()
-                  || ComparePacketTransmissionPriority (*packet_entry_it, *lowest_priority_emergency_pkt_not_in_gta_it)))
-            {
-              lowest_priority_emergency_pkt_not_in_gta_it = packet_entry_it;
-            }
-        }
-      else
-        {
-          // If the current regular data packet is the one with the lowest 
-          // transmission priority then select it.
-          if (lowest_priority_regular_pkt_it == m_packets_table.end ()
-              || ComparePacketTransmissionPriority (*packet_entry_it, *lowest_priority_regular_pkt_it))
-            {
-              lowest_priority_regular_pkt_it = packet_entry_it;
-            }
+  m_drop_index.m_next_update_time = std::min (m_drop_index.m_next_update_time,
+                                              GetNextTimePeriodUpdate (destination_gta.GetTimePeriod (),
+                                                                       current_time));
+}
 
-          // If the current regular data packet is outside its destination GTA
-          // and has lower transmission priority than the currently selected
-          // packet then select it.
-          if (outside_gta
-              && (lowest_priority_regular_pkt_not_in_gta_it == m_packets_table.end ()
-                  || ComparePacketTransmissionPriority (*packet_entry_it, *lowest_priority_regular_pkt_not_in_gta_it)))
-            {
-              lowest_priority_regular_pkt_not_in_gta_it = packet_entry_it;
-            }
-        }
-    }
+void
+PacketsQueue::RemoveDropPriorityEntry (const DataIdentifier& data_id)
+{
+  NS_LOG_FUNCTION (this << data_id);
 
-  // Select the packet with the lowest priority.
-  if (lowest_priority_regular_pkt_not_in_gta_it != m_packets_table.end ())
-    {
-      selected_packet = lowest_priority_regular_pkt_not_in_gta_it->first;
-      NS_LOG_DEBUG ("Regular packet outside its destination geo-temporal area selected: " << selected_packet);
-    }
-  else if (lowest_priority_regular_pkt_it != m_packets_table.end ())
-    {
-      selected_packet = lowest_priority_regular_pkt_it->first;
-      NS_LOG_DEBUG ("Regular packet inside its destination geo-temporal area selected: " << selected_packet);
-    }
-  else if (lowest_priority_emergency_pkt_not_in_gta_it != m_packets_table.end ())
-    {
-      selected_packet = lowest_priority_emergency_pkt_not_in_gta_it->first;
-      NS_LOG_DEBUG ("Emergency packet outside its destination geo-temporal area selected: " << selected_packet);
-    }
-  else if (lowest_priority_emergency_pkt_it != m_packets_table.end ())
+  DataIdentifierMap<std::pair<uint32_t, DropPriorityKey> >::iterator entry_it
+          = m_drop_index.m_entries.find (data_id);
+
+  if (entry_it == m_drop_index.m_entries.end ()) return;
+
+  const uint32_t slot = entry_it->second.first;
+  const uint32_t last_slot = m_drop_index.m_data_ids.size () - 1u;
+
+  m_drop_index.m_buckets[m_drop_index.m_drop_classes[slot]].erase (entry_it->second.second);
+  m_drop_index.m_entries.erase (entry_it);
+
+  // Move the entry of the last slot to the slot of the removed entry.
+  if (slot != last_slot)
     {
-      selected_packet = lowest_priority_emergency_pkt_it->first;
-      NS_LOG_DEBUG ("Emergency packet inside its destination geo-temporal area selected: " << selected_packet);
+      m_drop_index.m_data_ids[slot] = m_drop_index.m_data_ids[last_slot];
+      m_drop_index.m_time_periods[slot] = m_drop_index.m_time_periods[last_slot];
+      m_drop_index.m_emergency_flags[slot] = m_drop_index.m_emergency_flags[last_slot];
+      m_drop_index.m_drop_classes[slot] = m_drop_index.m_drop_classes[last_slot];
+      m_drop_index.m_entries.at (m_drop_index.m_data_ids[slot]).first = slot;
     }
-  else
+
+  m_drop_index.m_areas.Remove (slot);
+  m_drop_index.m_data_ids.pop_back ();
+  m_drop_index.m_time_periods.pop_back ();
+  m_drop_index.m_emergency_flags.pop_back ();
+  m_drop_index.m_drop_classes.pop_back ();
+}
+
+void
+PacketsQueue::UpdateDropPriorityKey (const DataIdentifier& data_id, const PacketQueueEntry& entry)
+{
+  DataIdentifierMap<std::pair<uint32_t, DropPriorityKey> >::iterator entry_it
+          = m_drop_index.m_entries.find (data_id);
+
+  if (entry_it == m_drop_index.m_entries.end ()) return;
+
+  DropPriorityKey & key = entry_it->second.second;
+
+  if (key.m_known_carriers_count == entry.GetKnownCarrierNodesCount ()) return;
+
+  std::set<DropPriorityKey> & bucket = m_drop_index.m_buckets[m_drop_index.m_drop_classes[entry_it->second.first]];
+
+  bucket.erase (key);
+  key.m_known_carriers_count = entry.GetKnownCarrierNodesCount ();
+  bucket.insert (key);
+}
+
+void
+PacketsQueue::UpdateDropClasses (const Vector2D& current_node_position)
+{
+  NS_LOG_FUNCTION (this << current_node_position);
+
+  const Time current_time = Simulator::Now ();
+
+  if (current_node_position.m_x == m_drop_index.m_position.m_x
+      && current_node_position.m_y == m_drop_index.m_position.m_y
+      && current_time < m_drop_index.m_next_update_time)
+    return; // No drop class may have changed
+
+  // Test the destination areas of all the entries against the current node 
+  // position at once.
+  AreaSet::Bitmask_t inside_area_mask;
+  m_drop_index.m_areas.ContainsPoint (current_node_position, inside_area_mask);
+
+  Time next_update_time = Time::Max ();
+
+  for (uint32_t slot = 0u; slot < m_drop_index.m_data_ids.size (); ++slot)
     {
-      NS_ABORT_MSG ("A packet should have been selected.");
+      const TimePeriod & time_period = m_drop_index.m_time_periods[slot];
+      const bool inside_gta = AreaSet::IsSet (inside_area_mask, slot)
+              && time_period.IsDuringTimePeriod (current_time);
+      const uint8_t drop_class = ComputeDropClass (m_drop_index.m_emergency_flags[slot], inside_gta);
+
+      next_update_time = std::min (next_update_time, GetNextTimePeriodUpdate (time_period, current_time));
+
+      if (drop_class == m_drop_index.m_drop_classes[slot]) continue;
+
+      // Only the entries whose drop class changed are moved to another bucket.
+      const DropPriorityKey & key = m_drop_index.m_entries.at (m_drop_index.m_data_ids[slot]).second;
+
+      m_drop_index.m_buckets[m_drop_index.m_drop_classes[slot]].erase (key);
+      m_drop_index.m_buckets[drop_class].insert (key);
+      m_drop_index.m_drop_classes[slot] = drop_class;
     }
 
-  return true;
+  m_drop_index.m_position = current_node_position;
+  m_drop_index.m_next_update_time = next_update_time;
 }
 
 bool
 PacketsQueue::Enqueue (const DataHeader& data_header, const Vector2D& current_node_position,
                        const Ipv4Address& transmitter_ip)
 {
-  NS_LOG_FUNCTION (this << data_header << current_node_position);
+  return Enqueue (data_header, current_node_position, transmitter_ip, m_max_replicas_counter);
+}
+
+bool
+PacketsQueue::Enqueue (const DataHeader& data_header, const Vector2D& current_node_position,
+                       const Ipv4Address& transmitter_ip, uint32_t replicas_counter)
+{
+  NS_LOG_FUNCTION (this << data_header << current_node_position << replicas_counter);
 
   // Check if the packet entry already exists in the queue.
   if (Find (data_header.GetDataIdentifier ()))
@@ -393,14 +592,12 @@ PacketsQueue::Enqueue (const DataHeader& data_header, const Vector2D& current_no
       return false;
     }
 
-  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_max_queue_length
+  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_packets_table.GetMaxLength ()
                 << " packets before insertion.");
 
   // Check if the queue is full.
-  if (m_packets_table.size () == m_max_queue_length)
+  if (m_packets_table.IsFull ())
     {
-      ++m_packets_dropped_counter;
-
       // Find the packet with highest priority to be dropped (the one with the
       // highest hops count).
       DataIdentifier entry_to_delete;
@@ -415,16 +612,24 @@ PacketsQueue::Enqueue (const DataHeader& data_header, const Vector2D& current_no
       // Log statistics about the packet drop
       LogPacketDropped (entry_to_delete);
 
-      const bool deleted = m_packets_table.erase (entry_to_delete) > 0u;
+      const bool deleted = m_packets_table.DropPacket (entry_to_delete);
       NS_ABORT_MSG_UNLESS (deleted == true, "Packet entry should have been deleted.");
+
+      RemoveDropPriorityEntry (entry_to_delete);
+
+      LogSummaryVectorChange (entry_to_delete, false);
     }
 
   std::pair<Iterator_t, bool> inserted_result;
   inserted_result = m_packets_table.insert (std::make_pair (data_header.GetDataIdentifier (),
-                                                            PacketQueueEntry (data_header, m_max_replicas_counter)));
+                                                            PacketQueueEntry (data_header, replicas_counter)));
 
   NS_LOG_DEBUG ("Packet successfully inserted : " << inserted_result.first->second);
-  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_max_queue_length
+
+  InsertDropPriorityEntry (data_header.GetDataIdentifier (), inserted_result.first->second);
+
+  LogSummaryVectorChange (data_header.GetDataIdentifier (), true);
+  NS_LOG_DEBUG (m_packets_table.size () << " / " << m_packets_table.GetMaxLength ()
                 << " packets after insertion.");
 
   // Save statistics about the packet reception.
@@ -485,35 +690,59 @@ PacketsQueue::FindHighestTransmitPriorityPacket (const Ipv4Address & local_node_
   // Normal packet that is outside its destination geo-temporal area.
   ConstIterator_t normal_low_priority_it = m_packets_table.end ();
 
+  // Requested packets that exist in the queue.
+  std::vector<ConstIterator_t> requested_packets;
+
+  // Slots of the destination areas of the requested packets in the area set of
+  // the drop priority index, in the same order.
+  std::vector<uint32_t> requested_packets_slots;
+  AreaSet::Bitmask_t inside_area_mask;
+
+  requested_packets.reserve (disjoint_vector.size ());
+  requested_packets_slots.reserve (disjoint_vector.size ());
+
+  for (std::set<DataIdentifier>::const_iterator data_id_it = disjoint_vector.begin ();
+          data_id_it != disjoint_vector.end (); ++data_id_it)
+    {
+      requested_packet_it = m_packets_table.find (*data_id_it);
+
+      // If the requested packet doesn't exist in the queue continue to the next one.
+      if (requested_packet_it == m_packets_table.end ())
+        {
+          NS_LOG_DEBUG ("Requested packet " << *data_id_it << " doesn't exist in queue.");
+          continue;
+        }
+
+      requested_packets.push_back (requested_packet_it);
+      requested_packets_slots.push_back (m_drop_index.m_entries.at (*data_id_it).first);
+    }
+
+  /* Determine which packets are inside its destination geo-temporal area, those
+   * have higher priority to be dequeued because they need to be broadcasted 
+   * before other packets that aren't inside its destination geo-temporal area 
+   * are transmitted. A packet is inside if the local node or the neighbor node
+   * is inside its destination area, so all the areas are tested against both 
+   * positions at once. The area set is kept up to date by the drop priority 
+   * index, so it isn't built again for every call: only the slots of the 
+   * requested packets are tested.
+   */
+  m_drop_index.m_areas.ContainsAnyPoint (local_position, neighbor_position, requested_packets_slots,
+                                         inside_area_mask);
+
   try
     {
       // Iterate through all the requested packets.
-      for (std::set<DataIdentifier>::const_iterator data_id_it = disjoint_vector.begin ();
-              data_id_it != disjoint_vector.end (); ++data_id_it)
+      for (uint32_t packet_index = 0u; packet_index < requested_packets.size (); ++packet_index)
         {
-          requested_packet_it = m_packets_table.find (*data_id_it);
-
-          // If the requested packet doesn't exist in the queue continue to the next one.
-          if (requested_packet_it == m_packets_table.end ())
-            {
-              NS_LOG_DEBUG ("Requested packet " << *data_id_it << " doesn't exist in queue.");
-              continue;
-            }
+          requested_packet_it = requested_packets[packet_index];
 
+          const DataIdentifier & data_id = requested_packet_it->first;
           const DataHeader & data_packet = requested_packet_it->second.GetDataPacket ();
           const GeoTemporalArea & destination_gta = data_packet.GetDestinationGeoTemporalArea ();
           const bool emergency_packet = data_packet.IsEmergencyPacket ();
 
-          /* Determine if there's is a packet inside its destination geo-temporal area,
-           * if so, it has higher priority to be dequeued because it needs to be 
-           * broadcasted before other packets that aren't inside its destination 
-           * geo-temporal area are transmitted.
-           */
-          const bool local_node_inside_gta
-                  = destination_gta.IsInsideGeoTemporalArea (local_position, current_time);
-          const bool neighbor_node_inside_gta
-                  = destination_gta.IsInsideGeoTemporalArea (neighbor_position, current_time);
-          const bool inside_gta = local_node_inside_gta || neighbor_node_inside_gta;
+          const bool inside_gta = AreaSet::IsSet (inside_area_mask, packet_index)
+                  && destination_gta.IsDuringTimePeriod (current_time);
 
           // If the current packet:
           // - Is an emergency packet, and
@@ -525,7 +754,7 @@ PacketsQueue::FindHighestTransmitPriorityPacket (const Ipv4Address & local_node_
               && (emergency_high_priority_it == m_packets_table.end ()
                   || ComparePacketTransmissionPriority (*emergency_high_priority_it, *requested_packet_it)))
             {
-              NS_LOG_DEBUG ("Emergency high priority packet " << *data_id_it << " selected.");
+              NS_LOG_DEBUG ("Emergency high priority packet " << data_id << " selected.");
               emergency_high_priority_it = requested_packet_it;
               continue;
             }
@@ -553,7 +782,7 @@ PacketsQueue::FindHighestTransmitPriorityPacket (const Ipv4Address & local_node_
               && (emergency_low_priority_it == m_packets_table.end ()
                   || ComparePacketTransmissionPriority (*emergency_low_priority_it, *requested_packet_it)))
             {
-              NS_LOG_DEBUG ("Emergency low priority packet " << *data_id_it << " selected.");
+              NS_LOG_DEBUG ("Emergency low priority packet " << data_id << " selected.");
               emergency_low_priority_it = requested_packet_it;
               continue;
             }
@@ -572,7 +801,7 @@ PacketsQueue::FindHighestTransmitPriorityPacket (const Ipv4Address & local_node_
               && (normal_high_priority_it == m_packets_table.end ()
                   || ComparePacketTransmissionPriority (*normal_high_priority_it, *requested_packet_it)))
             {
-              NS_LOG_DEBUG ("Normal high priority packet " << *data_id_it << " selected.");
+              NS_LOG_DEBUG ("Normal high priority packet " << data_id << " selected.");
               normal_high_priority_it = requested_packet_it;
               continue;
             }
@@ -593,7 +822,7 @@ PacketsQueue::FindHighestTransmitPriorityPacket (const Ipv4Address & local_node_
               && (normal_low_priority_it == m_packets_table.end ()
                   || ComparePacketTransmissionPriority (*normal_low_priority_it, *requested_packet_it)))
             {
-              NS_LOG_DEBUG ("Normal low priority packet " << *data_id_it << " selected.");
+              NS_LOG_DEBUG ("Normal low priority packet " << data_id << " selected.");
               normal_low_priority_it = requested_packet_it;
               continue;
             }
@@ -648,6 +877,233 @@ PacketsQueue::FindHighestTransmitPriorityPacket (const Ipv4Address & local_node_
   return true;
 }
 
+bool
+PacketsQueue::CompareTransmitCandidates (const TransmitCandidate& candidate_1,
+                                         const TransmitCandidate& candidate_2)
+{
+  if (candidate_1.m_priority_class != candidate_2.m_priority_class)
+    return candidate_1.m_priority_class > candidate_2.m_priority_class;
+
+  // Same criteria of ComparePacketTransmissionPriority.
+  if (candidate_1.m_hops_count != candidate_2.m_hops_count)
+    return candidate_1.m_hops_count > candidate_2.m_hops_count;
+
+  if (candidate_1.m_known_carriers_count != candidate_2.m_known_carriers_count)
+    return candidate_1.m_known_carriers_count > candidate_2.m_known_carriers_count;
+
+  // FindHighestTransmitPriorityPacket keeps the first packet of the disjoint
+  // vector (the lowest data identifier) among the ones with the same priority.
+  return candidate_2.m_data_id < candidate_1.m_data_id;
+}
+
+bool
+PacketsQueue::ComputeTransmitPriorityClass (TransmitCandidate& candidate, bool inside_area,
+                                            uint32_t replicas_counter)
+{
+  if (inside_area)
+    {
+      candidate.m_priority_class = candidate.m_emergency_flag ? 0u : 2u;
+      return true;
+    }
+
+  if (replicas_counter > 0u && candidate.m_valid_carrier)
+    {
+      candidate.m_priority_class = candidate.m_emergency_flag ? 1u : 3u;
+      return true;
+    }
+
+  return false;
+}
+
+bool
+PacketsQueue::IsTransmitSessionValid (TransmitSession& session,
+                                      const Ipv4Address& local_node_ip,
+                                      const Vector2D& local_position,
+                                      const Vector2D& neighbor_position,
+                                      const std::set<DataIdentifier>& disjoint_vector) const
+{
+  const Time current_time = Simulator::Now ();
+
+  if (session.m_local_node_ip != local_node_ip
+      || session.m_requested_packets_count != disjoint_vector.size ()
+      || session.m_current_second != static_cast<uint32_t> (current_time.GetSeconds ())
+      || current_time >= session.m_next_time_period_start
+      || current_time > session.m_next_time_period_end)
+    {
+      return false;
+    }
+
+  if (local_position.m_x == session.m_local_position.m_x
+      && local_position.m_y == session.m_local_position.m_y
+      && neighbor_position.m_x == session.m_neighbor_position.m_x
+      && neighbor_position.m_y == session.m_neighbor_position.m_y)
+    {
+      return true;
+    }
+
+  // The nodes moved, the session is still valid if the same destination areas
+  // contain any of them.
+  AreaSet::Bitmask_t inside_area_mask;
+  session.m_destination_areas.ContainsAnyPoint (local_position, neighbor_position,
+                                                inside_area_mask);
+
+  if (inside_area_mask != session.m_inside_area_mask)
+    return false;
+
+  session.m_local_position = local_position;
+  session.m_neighbor_position = neighbor_position;
+  return true;
+}
+
+void
+PacketsQueue::BuildTransmitSession (TransmitSession& session,
+                                    const Ipv4Address& local_node_ip,
+                                    const Vector2D& local_position,
+                                    const Ipv4Address& neighbor_node_ip,
+                                    const Vector2D& neighbor_position,
+                                    const std::set<DataIdentifier>& disjoint_vector) const
+{
+  NS_LOG_FUNCTION (this << " disjoint vector size " << disjoint_vector.size ()
+                   << " neighbor node IP " << neighbor_node_ip);
+
+  NS_ABORT_MSG_IF (m_gps == 0,
+                   "A pointer to a valid GPS System object must be set in this "
+                   "PacketsQueue object.");
+
+  const Time current_time = Simulator::Now ();
+  const uint32_t current_second = static_cast<uint32_t> (current_time.GetSeconds ());
+
+  session.m_local_node_ip = local_node_ip;
+  session.m_local_position = local_position;
+  session.m_neighbor_position = neighbor_position;
+  session.m_current_second = current_second;
+  session.m_next_time_period_start = Time::Max ();
+  session.m_next_time_period_end = Time::Max ();
+  session.m_requested_packets_count = disjoint_vector.size ();
+  session.m_destination_areas.Clear ();
+  session.m_candidates_heap.clear ();
+
+  // Requested packets that exist in the queue.
+  std::vector<ConstIterator_t> requested_packets;
+  requested_packets.reserve (disjoint_vector.size ());
+  session.m_destination_areas.Reserve (disjoint_vector.size ());
+
+  for (std::set<DataIdentifier>::const_iterator data_id_it = disjoint_vector.begin ();
+          data_id_it != disjoint_vector.end (); ++data_id_it)
+    {
+      ConstIterator_t requested_packet_it = m_packets_table.find (*data_id_it);
+
+      if (requested_packet_it == m_packets_table.end ())
+        continue;
+
+      requested_packets.push_back (requested_packet_it);
+      session.m_destination_areas.Add (requested_packet_it->second.GetDataPacket ().GetDestinationGeoTemporalArea ().GetArea ());
+    }
+
+  session.m_destination_areas.ContainsAnyPoint (local_position, neighbor_position,
+                                                session.m_inside_area_mask);
+  session.m_candidates_heap.reserve (requested_packets.size ());
+
+  for (uint32_t packet_index = 0u; packet_index < requested_packets.size (); ++packet_index)
+    {
+      const PacketQueueEntry & packet_entry = requested_packets[packet_index]->second;
+      const DataHeader & data_packet = packet_entry.GetDataPacket ();
+      const GeoTemporalArea & destination_gta = data_packet.GetDestinationGeoTemporalArea ();
+      const TimePeriod & time_period = destination_gta.GetTimePeriod ();
+
+      if (current_time < time_period.GetStartTime ())
+        session.m_next_time_period_start = std::min (session.m_next_time_period_start,
+                                                     time_period.GetStartTime ());
+      else if (current_time <= time_period.GetEndTime ())
+        session.m_next_time_period_end = std::min (session.m_next_time_period_end,
+                                                   time_period.GetEndTime ());
+
+      TransmitCandidate candidate;
+      candidate.m_data_id = requested_packets[packet_index]->first;
+      candidate.m_area_index = packet_index;
+      candidate.m_during_time_period = destination_gta.IsDuringTimePeriod (current_time);
+      candidate.m_emergency_flag = data_packet.IsEmergencyPacket ();
+      candidate.m_hops_count = data_packet.GetHopsCount ();
+      candidate.m_known_carriers_count = packet_entry.GetKnownCarrierNodesCount ();
+
+      const bool inside_area = AreaSet::IsSet (session.m_inside_area_mask, packet_index)
+              && candidate.m_during_time_period;
+
+      candidate.m_valid_carrier = !inside_area
+              && packet_entry.GetReplicasCounter () > 0u
+              && m_gps->IsVehicleValidPacketCarrier (/*Neighbor node IP*/ neighbor_node_ip,
+                                                     /*Carrier node IP*/ local_node_ip,
+                                                     /*Destination area*/ destination_gta.GetArea (),
+                                                     /*Current time (second)*/ current_second,
+                                                     /*Min. dist. diff.*/ m_min_vehicles_distance_diff);
+
+      if (ComputeTransmitPriorityClass (candidate, inside_area, packet_entry.GetReplicasCounter ()))
+        session.m_candidates_heap.push_back (candidate);
+    }
+
+  std::make_heap (session.m_candidates_heap.begin (), session.m_candidates_heap.end (),
+                  CompareTransmitCandidates);
+
+  NS_LOG_DEBUG (session.m_candidates_heap.size () << " of " << disjoint_vector.size ()
+                << " requested packets ranked for neighbor " << neighbor_node_ip);
+}
+
+bool
+PacketsQueue::PopHighestTransmitPriorityPacket (TransmitSession& session,
+                                                const std::set<DataIdentifier>& disjoint_vector,
+                                                PacketQueueEntry& selected_packet,
+                                                bool & inside_area_flag) const
+{
+  std::vector<TransmitCandidate> & candidates_heap = session.m_candidates_heap;
+
+  while (!candidates_heap.empty ())
+    {
+      std::pop_heap (candidates_heap.begin (), candidates_heap.end (), CompareTransmitCandidates);
+      const TransmitCandidate candidate = candidates_heap.back ();
+      candidates_heap.pop_back ();
+
+      ConstIterator_t packet_entry_it = m_packets_table.find (candidate.m_data_id);
+
+      if (packet_entry_it == m_packets_table.end ()
+          || disjoint_vector.find (candidate.m_data_id) == disjoint_vector.end ())
+        {
+          NS_LOG_LOGIC ("Candidate packet " << candidate.m_data_id << " no longer requested.");
+          continue;
+        }
+
+      const PacketQueueEntry & packet_entry = packet_entry_it->second;
+      const bool inside_area = AreaSet::IsSet (session.m_inside_area_mask, candidate.m_area_index)
+              && candidate.m_during_time_period;
+
+      TransmitCandidate current_candidate = candidate;
+      current_candidate.m_emergency_flag = packet_entry.GetDataPacket ().IsEmergencyPacket ();
+      current_candidate.m_hops_count = packet_entry.GetDataPacket ().GetHopsCount ();
+      current_candidate.m_known_carriers_count = packet_entry.GetKnownCarrierNodesCount ();
+
+      if (!ComputeTransmitPriorityClass (current_candidate, inside_area,
+                                         packet_entry.GetReplicasCounter ()))
+        {
+          NS_LOG_LOGIC ("Candidate packet " << candidate.m_data_id << " can't be transmitted anymore.");
+          continue;
+        }
+
+      // The priority changed since the candidate was ranked, rank it again.
+      if (CompareTransmitCandidates (current_candidate, candidate)
+          || CompareTransmitCandidates (candidate, current_candidate))
+        {
+          candidates_heap.push_back (current_candidate);
+          std::push_heap (candidates_heap.begin (), candidates_heap.end (), CompareTransmitCandidates);
+          continue;
+        }
+
+      selected_packet = packet_entry;
+      inside_area_flag = inside_area;
+      return true;
+    }
+
+  return false;
+}
+
 bool
 PacketsQueue::Dequeue (const Ipv4Address& local_node_ip,
                        const Vector2D& local_position,
@@ -666,29 +1122,54 @@ PacketsQueue::Dequeue (const Ipv4Address& local_node_ip,
   if (Size () == 0u || disjoint_vector.empty ())
     {
       NS_LOG_DEBUG ("No packets to send.");
+      m_transmit_sessions.erase (neighbor_node_ip);
+      return false;
+    }
+
+  std::map<Ipv4Address, TransmitSession>::iterator session_it
+          = m_transmit_sessions.find (neighbor_node_ip);
+
+  try
+    {
+      // Rank the requested packets when the session starts, or when the ranking
+      // of the session is no longer valid.
+      if (session_it == m_transmit_sessions.end ())
+        {
+          session_it = m_transmit_sessions.insert (std::make_pair (neighbor_node_ip,
+                                                                   TransmitSession ())).first;
+          BuildTransmitSession (session_it->second, local_node_ip, local_position,
+                                neighbor_node_ip, neighbor_position, disjoint_vector);
+        }
+      else if (!IsTransmitSessionValid (session_it->second, local_node_ip, local_position,
+                                        neighbor_position, disjoint_vector))
+        {
+          BuildTransmitSession (session_it->second, local_node_ip, local_position,
+                                neighbor_node_ip, neighbor_position, disjoint_vector);
+        }
+    }
+  catch (const std::exception & ex)
+    {
+      NS_LOG_WARN ("No packet was selected: Unexpected exception (" << ex.what () << ").");
+      m_transmit_sessions.erase (session_it);
       return false;
     }
 
   // Flag that indicates if the selected packet is inside its destination area.
   bool inside_area_flag = false;
 
-  // Find the packet with highest priority to transmit it
-  if (!FindHighestTransmitPriorityPacket (local_node_ip,
-                                          local_position,
-                                          local_velocity,
-                                          neighbor_node_ip,
-                                          neighbor_position,
-                                          neighbor_velocity,
-                                          disjoint_vector,
-                                          selected_packet,
-                                          inside_area_flag))
+  // Pop the packet with highest priority to transmit it
+  if (!PopHighestTransmitPriorityPacket (session_it->second, disjoint_vector,
+                                         selected_packet, inside_area_flag))
     {
       // No packet was selected to be transmitted.
       NS_LOG_DEBUG ("No packet selected to be transmitted.");
+      m_transmit_sessions.erase (session_it);
       return false;
     }
 
-  // A packet was selected to be transmitted.
+  // A packet was selected to be transmitted, the next disjoint vector of the
+  // session is expected without it.
+  session_it->second.m_requested_packets_count = disjoint_vector.size () - 1u;
 
   // If the selected packet is OUTSIDE the geo-temporal area then decrement a replica
   if (!inside_area_flag)
@@ -739,6 +1220,7 @@ PacketsQueue::AddKnownPacketCarrier (const DataIdentifier& packet_data_id,
   if (packet_entry_it == m_packets_table.end ()) return false; // Packet not found
 
   packet_entry_it->second.AddKnownCarrierNode (carrier_node_ip);
+  UpdateDropPriorityKey (packet_data_id, packet_entry_it->second);
 
   NS_LOG_DEBUG ("Added confirmed carrier node " << carrier_node_ip
                 << " to packet " << packet_data_id);
@@ -763,6 +1245,7 @@ PacketsQueue::AddKnownPacketCarriers (const std::set<DataIdentifier>& packet_dat
       if (packet_entry_it == m_packets_table.end ()) continue; // Packet not found
 
       packet_entry_it->second.AddKnownCarrierNode (carrier_node_ip);
+      UpdateDropPriorityKey (*packet_data_id_it, packet_entry_it->second);
 
       NS_LOG_DEBUG ("Added confirmed carrier node " << carrier_node_ip
                     << " to packet " << *packet_data_id_it);
@@ -774,22 +1257,35 @@ PacketsQueue::Purge ()
 {
   NS_LOG_FUNCTION (this);
 
-  for (ConstIterator_t entry_it = m_packets_table.begin (); entry_it != m_packets_table.end ();)
+  std::vector<DataIdentifier> purged_packets;
+  m_packets_table.Purge (Simulator::Now (), &purged_packets);
+
+  for (std::vector<DataIdentifier>::const_iterator data_id_it = purged_packets.begin ();
+          data_id_it != purged_packets.end (); ++data_id_it)
     {
-      if (entry_it->second.GetExpirationTime () <= Seconds (0))
-        {
-          NS_LOG_LOGIC ("Drops expired data packet entry : " << entry_it->second);
-          // m_packets_table.erase (entry_it++); // For C++03
-          entry_it = m_packets_table.erase (entry_it); // For C++11
-        }
-      else
-        {
-          ++entry_it;
-        }
+      NS_LOG_LOGIC ("Drops expired data packet entry : " << *data_id_it);
+      LogSummaryVectorChange (*data_id_it, false);
+      RemoveDropPriorityEntry (*data_id_it);
     }
 }
 
 
+void
+PacketsQueue::LogSummaryVectorChange (const DataIdentifier& data_packet_id, bool inserted)
+{
+  ++m_summary_vector_version;
+
+  // Inserting and removing a packet toggles the same bits of the digest.
+  const uint64_t hash = HashDataIdentifier (data_packet_id);
+  m_summary_vector_digest ^= (uint32_t) (hash ^ (hash >> 32));
+
+  m_summary_vector_log.push_back (std::make_pair (data_packet_id, inserted));
+
+  if (m_summary_vector_log.size () > m_summary_vector_log_capacity)
+    m_summary_vector_log.pop_front ();
+}
+
+
 // --------------------------
 // Packet statistics
 // --------------------------
@@ -812,7 +1308,8 @@ PacketsQueue::LogNewPacketReceived (const DataIdentifier & data_packet_id,
 }
 
 void
-PacketsQueue::LogPacketTransmitted (const DataIdentifier& data_packet_id)
+PacketsQueue::LogPacketTransmitted (const DataIdentifier& data_packet_id,
+                                    const TransmissionType& transmission_type)
 {
   StatsIterator_t packet_stats_it = m_data_packet_reception_stats.find (data_packet_id);
 
@@ -820,7 +1317,7 @@ PacketsQueue::LogPacketTransmitted (const DataIdentifier& data_packet_id)
   if (packet_stats_it == m_data_packet_reception_stats.end ())
     return;
 
-  packet_stats_it->second.IncrementTransmittedReplicasCount (TransmissionType::Unicast);
+  packet_stats_it->second.IncrementTransmittedReplicasCount (transmission_type);
 }
 
 void
@@ -861,7 +1358,7 @@ PacketsQueue::ToString () const
   std::sprintf (buffer, "%u", (uint32_t) m_packets_table.size ());
   std::string str = "Packets queue has " + std::string (buffer) + " / ";
 
-  std::sprintf (buffer, "%u", m_max_queue_length);
+  std::sprintf (buffer, "%u", m_packets_table.GetMaxLength ());
   str += std::string (buffer) + " packet entries";
 
   return str;
@@ -27,9 +27,12 @@
 
 #include "geotemporal-packets.h"
 
+#include <deque>
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <ns3/assert.h>
 #include <ns3/nstime.h>
@@ -37,6 +40,7 @@
 
 #include <ns3/geotemporal-utils.h>
 #include <ns3/packet-utils.h>
+#include <ns3/packets-queue-core.h>
 #include <ns3/statistics-utils.h>
 #include <ns3/gps-system.h>
 
@@ -81,8 +85,8 @@ private:
    */
   uint32_t m_replicas_counter;
 
-  /** List of the IP addresses of the nodes that already know this packet. */
-  std::set<Ipv4Address> m_known_carriers;
+  /** Set of the IP addresses of the nodes that already know this packet. */
+  Ipv4AddressSet m_known_carriers;
 
 
 public:
@@ -134,6 +138,13 @@ public:
     m_expiration_time = packet_time_period.GetEndTime ();
   }
 
+  /** Returns the simulation time at which the entry expires. */
+  inline const Time &
+  GetExpirationInstant () const
+  {
+    return m_expiration_time;
+  }
+
   inline uint32_t
   GetReplicasCounter () const
   {
@@ -149,25 +160,33 @@ public:
   inline void
   AddKnownCarrierNode (const Ipv4Address & carrier_node_ip)
   {
-    m_known_carriers.insert (carrier_node_ip);
+    m_known_carriers.Insert (carrier_node_ip);
   }
 
   inline void
   ClearKnownCarriersNodes ()
   {
-    m_known_carriers.clear ();
+    m_known_carriers.Clear ();
   }
 
   inline uint32_t
   GetKnownCarrierNodesCount () const
   {
-    return m_known_carriers.size ();
+    return m_known_carriers.Size ();
   }
 
-  inline const std::set<Ipv4Address> &
+  inline std::set<Ipv4Address>
   GetKnownCarrierNodesSet () const
   {
-    return m_known_carriers;
+    std::set<Ipv4Address> known_carriers;
+    m_known_carriers.GetAddresses (known_carriers);
+    return known_carriers;
+  }
+
+  inline bool
+  IsKnownCarrierNode (const Ipv4Address & carrier_node_ip) const
+  {
+    return m_known_carriers.Contains (carrier_node_ip);
   }
 
 
@@ -235,43 +254,215 @@ private:
    */
   Ptr<GpsSystem> m_gps;
 
-  /** 
-   * Maximum number of packet entries that the queue can store at once.
-   * 
-   * If the queue reaches this maximum number of packet entries and a new packet
-   * is stored, then the oldest packet will be dropped from the queue before 
-   * inserting the new one.
-   */
-  uint32_t m_max_queue_length;
-
   /**
    * Maximum number of packet replicas of each data packet that the routing 
    * protocol can send.
    */
   uint16_t m_max_replicas_counter;
 
-  /**
-   * The counter of all packets dropped due to a full queue.
-   */
-  uint32_t m_packets_dropped_counter;
-
   /**
    * Minimum distance (in meters) difference between vehicles to consider a node
    * as a valid carrier.
    */
   uint32_t m_min_vehicles_distance_diff;
 
-  /** Data packets table. */
-  std::map<DataIdentifier, PacketQueueEntry> m_packets_table;
+  /** Data packets table. The packet to drop when the queue is full is selected
+   * with the drop priority index of the queue. */
+  typedef PacketsQueueCore<PacketQueueEntry, ExternalDropPolicy> PacketsTable_t;
+
+  /** 
+   * Data packets table, with the maximum number of packet entries that the
+   * queue can store at once and the counter of packets dropped due to a full
+   * queue.
+   * 
+   * If the queue reaches this maximum number of packet entries and a new packet
+   * is stored, then the packet with the highest drop priority will be dropped
+   * from the queue before inserting the new one.
+   */
+  PacketsTable_t m_packets_table;
 
   /** Data packets stats. */
   std::map<DataIdentifier, DataPacketReceptionStats> m_data_packet_reception_stats;
 
+  /**
+   * Version of the summary vector. It is increased with each insertion and 
+   * removal of a packet entry.
+   */
+  uint32_t m_summary_vector_version;
+
+  /** Maximum number of changes stored in the summary vector changes log. */
+  uint32_t m_summary_vector_log_capacity;
+
+  /**
+   * Log of the latest changes of the summary vector, from the oldest to the 
+   * newest. Each change is the identifier of the packet and <code>true</code>
+   * if it was inserted or <code>false</code> if it was removed. The last 
+   * change corresponds to the current version.
+   */
+  std::deque<std::pair<DataIdentifier, bool> > m_summary_vector_log;
+
+  /**
+   * Order-independent digest of the summary vector: the XOR of the hashes of
+   * the identifiers of all the packet entries. It is updated with each 
+   * insertion and removal of a packet entry.
+   */
+  uint32_t m_summary_vector_digest;
+
+  /**
+   * Requested packet ranked in the transmit priority heap of a session. The
+   * priority fields are a snapshot of the packet entry taken when the 
+   * candidate was inserted in the heap.
+   */
+  struct TransmitCandidate
+  {
+    DataIdentifier m_data_id;
+
+    /** Index of the destination area of the packet in the session area set. */
+    uint32_t m_area_index;
+
+    /** If the current time is inside the time period of the destination GTA. */
+    bool m_during_time_period;
+
+    /** If the neighbor node is a valid carrier (only computed when outside the area). */
+    bool m_valid_carrier;
+
+    bool m_emergency_flag;
+    uint32_t m_hops_count;
+    uint32_t m_known_carriers_count;
+
+    /**
+     * Priority class, from the highest to the lowest priority: emergency 
+     * packet inside its destination GTA (0), emergency packet outside (1), 
+     * normal packet inside (2) and normal packet outside (3).
+     */
+    uint8_t m_priority_class;
+  };
+
+  /**
+   * Transmission session of the requested packets of a neighbor node. The 
+   * requested packets are ranked once, and then every dequeue pops the 
+   * candidate with the highest priority from the heap.
+   * 
+   * The inside-area flags and the valid-carrier checks of the candidates are
+   * only valid while the positions of both nodes keep the same inside-area 
+   * flags, the current second doesn't change (the carrier checks have a 
+   * granularity of seconds) and no time period of a destination GTA starts or
+   * ends. Otherwise, the session is ranked again.
+   */
+  struct TransmitSession
+  {
+    Ipv4Address m_local_node_ip;
+    Vector2D m_local_position;
+    Vector2D m_neighbor_position;
+    uint32_t m_current_second;
+
+    /** Earliest future start time of the time periods of the destination GTAs. */
+    Time m_next_time_period_start;
+
+    /** Earliest end time (not passed yet) of the time periods of the destination GTAs. */
+    Time m_next_time_period_end;
+
+    /** Size that the next disjoint vector of the session must have. */
+    uint32_t m_requested_packets_count;
+
+    /** Destination areas of the ranked packets. */
+    AreaSet m_destination_areas;
+
+    /** Inside-area flags of the destination areas for the session positions. */
+    AreaSet::Bitmask_t m_inside_area_mask;
+
+    /** Binary max-heap of candidates ordered by <code>CompareTransmitCandidates</code>. */
+    std::vector<TransmitCandidate> m_candidates_heap;
+  };
+
+  /** Transmission sessions of the neighbor nodes, by IP address. */
+  std::map<Ipv4Address, TransmitSession> m_transmit_sessions;
+
+  /** Drop classes of the packet entries, from the highest to the lowest drop
+   * priority. */
+  enum DropClass
+  {
+    REGULAR_OUTSIDE_GTA = 0,
+    REGULAR_INSIDE_GTA = 1,
+    EMERGENCY_OUTSIDE_GTA = 2,
+    EMERGENCY_INSIDE_GTA = 3,
+    DROP_CLASSES_COUNT = 4
+  };
+
+  /**
+   * Key of a packet entry in the bucket of its drop class. Keys are sorted from
+   * the highest to the lowest drop priority, the same order given by 
+   * <code>ComparePacketDropPriority</code>.
+   */
+  struct DropPriorityKey
+  {
+    uint32_t m_hops_count;
+    uint32_t m_known_carriers_count;
+    DataIdentifier m_data_id;
+
+    bool
+    operator< (const DropPriorityKey & rhs) const
+    {
+      if (m_hops_count != rhs.m_hops_count)
+        return m_hops_count > rhs.m_hops_count;
+
+      if (m_known_carriers_count != rhs.m_known_carriers_count)
+        return m_known_carriers_count > rhs.m_known_carriers_count;
+
+      return m_data_id < rhs.m_data_id;
+    }
+  };
+
+  /**
+   * Index of the packet entries in drop order, used to find the packet to drop
+   * when the queue is full without scanning the whole queue.
+   * 
+   * The entries are bucketed by drop class. The drop class of an entry depends
+   * on the position of the local node and the current time, so the classes are
+   * computed for a position and are valid until the first instant at which the
+   * time period status of any entry changes. When they are computed again, 
+   * only the entries whose class changed are moved to another bucket.
+   */
+  struct DropPriorityIndex
+  {
+    /** Slot and key of each indexed packet entry, by data identifier. */
+    DataIdentifierMap<std::pair<uint32_t, DropPriorityKey> > m_entries;
+
+    /** Destination area of the entry in each slot. It is also used by
+     * <code>FindHighestTransmitPriorityPacket</code> to test the destination 
+     * areas of the requested packets. */
+    AreaSet m_areas;
+
+    /** Data identifier of the entry in each slot. */
+    std::vector<DataIdentifier> m_data_ids;
+
+    /** Destination time period of the entry in each slot. */
+    std::vector<TimePeriod> m_time_periods;
+
+    /** Emergency flag of the entry in each slot. */
+    std::vector<bool> m_emergency_flags;
+
+    /** Drop class of the entry in each slot. */
+    std::vector<uint8_t> m_drop_classes;
+
+    /** Keys of the entries of each drop class. */
+    std::set<DropPriorityKey> m_buckets[DROP_CLASSES_COUNT];
+
+    /** Position of the local node used to compute the drop classes. */
+    Vector2D m_position;
+
+    /** Instant from which the drop classes must be computed again. */
+    Time m_next_update_time;
+  };
+
+  /** Drop priority index of the packet entries. */
+  DropPriorityIndex m_drop_index;
+
   /** Packets table iterator. */
-  typedef std::map<DataIdentifier, PacketQueueEntry>::iterator Iterator_t;
+  typedef PacketsTable_t::iterator Iterator_t;
 
   /** Packets table constant iterator. */
-  typedef std::map<DataIdentifier, PacketQueueEntry>::const_iterator ConstIterator_t;
+  typedef PacketsTable_t::const_iterator ConstIterator_t;
 
   /** Packet statistics iterator. */
   typedef std::map<DataIdentifier, DataPacketReceptionStats>::iterator StatsIterator_t;
@@ -341,7 +532,7 @@ public:
   inline uint32_t
   GetMaxLength () const
   {
-    return m_max_queue_length;
+    return m_packets_table.GetMaxLength ();
   }
 
   /**
@@ -357,7 +548,7 @@ public:
   inline void
   SetMaxLength (uint32_t maximum_queue_length)
   {
-    m_max_queue_length = maximum_queue_length;
+    m_packets_table.SetMaxLength (maximum_queue_length);
   }
 
   /**
@@ -388,7 +579,7 @@ public:
   inline uint32_t
   GetDroppedPacketsCounter () const
   {
-    return m_packets_dropped_counter;
+    return m_packets_table.GetDroppedPacketsCounter ();
   }
 
   /**
@@ -429,6 +620,22 @@ public:
   void
   GetSummaryVector (std::set<DataIdentifier> & summary_vector) const;
 
+  /**
+   * Returns (in the reference parameter) the identifiers of the packets whose
+   * destination geo-temporal area contains the given position at the current
+   * time.
+   * 
+   * The <code>inside_area_packets</code> parameter is always emptied.
+   * 
+   * @param current_node_position [IN] The current geographical position of the
+   * local node.
+   * @param inside_area_packets [OUT] The identifiers of the packets inside their
+   * destination geo-temporal area.
+   */
+  void
+  GetInsideAreaPackets (const Vector2D & current_node_position,
+                        std::vector<DataIdentifier> & inside_area_packets) const;
+
   /** Returns the statistics of all received data packets. */
   inline const std::map<DataIdentifier, DataPacketReceptionStats> &
   GetPacketReceptionStats () const
@@ -436,6 +643,72 @@ public:
     return m_data_packet_reception_stats;
   }
 
+  /**
+   * Returns the version of the summary vector. It is increased with each 
+   * insertion and removal of a packet entry.
+   */
+  inline uint32_t
+  GetSummaryVectorVersion () const
+  {
+    return m_summary_vector_version;
+  }
+
+  /**
+   * Returns the order-independent digest of the summary vector. Two queues 
+   * with the same packets have the same digest.
+   */
+  inline uint32_t
+  GetSummaryVectorDigest () const
+  {
+    return m_summary_vector_digest;
+  }
+
+  /**
+   * Computes the digest of the given summary vector, equal to the one that a
+   * packets queue with the same packets has.
+   * 
+   * @param summary_vector [IN] Summary vector.
+   */
+  static uint32_t
+  ComputeSummaryVectorDigest (const std::set<DataIdentifier> & summary_vector);
+
+  /** Returns the maximum number of changes stored in the summary vector log. */
+  inline uint32_t
+  GetSummaryVectorLogCapacity () const
+  {
+    return m_summary_vector_log_capacity;
+  }
+
+  /**
+   * Sets the maximum number of changes stored in the summary vector log. The
+   * oldest changes are discarded if the log exceeds the new capacity.
+   */
+  void
+  SetSummaryVectorLogCapacity (uint32_t log_capacity);
+
+  /**
+   * Returns (in the reference parameters) the changes of the summary vector 
+   * since the specified version: the identifiers of the packets inserted and
+   * the identifiers of the packets removed. A packet inserted and then removed
+   * (or the opposite) since that version is not included in any set.
+   * 
+   * The <code>inserted_packets</code> and <code>removed_packets</code> 
+   * parameters are always emptied.
+   * 
+   * @param since_version [IN] Version of the summary vector.
+   * @param inserted_packets [OUT] Packets inserted since the version.
+   * @param removed_packets [OUT] Packets removed since the version.
+   * 
+   * @return <code>true</code> if the changes are available. If the version is
+   * newer than the current one or older than the oldest change stored in the
+   * log (the log was truncated) it returns <code>false</code>, and the whole
+   * summary vector has to be used instead.
+   */
+  bool
+  GetSummaryVectorChanges (uint32_t since_version,
+                           std::set<DataIdentifier> & inserted_packets,
+                           std::set<DataIdentifier> & removed_packets) const;
+
 
   // --------------------------
   // Lookup
@@ -488,11 +761,32 @@ public:
 
   /**
    * Removes all packet entries from the packets queue.
+   * 
+   * The summary vector version is increased and its changes log is emptied, so
+   * the changes since a previous version are no longer available.
    */
   inline void
   Clear ()
   {
     m_packets_table.clear ();
+
+    ++m_summary_vector_version;
+    m_summary_vector_log.clear ();
+    m_summary_vector_digest = 0u;
+    m_transmit_sessions.clear ();
+    m_drop_index = DropPriorityIndex ();
+  }
+
+  /**
+   * Forgets the transmission session of the neighbor node. It must be called
+   * when the set of packets requested by the neighbor node changes other than
+   * by removing the dequeued packets, so that the next dequeue ranks the new
+   * set of requested packets.
+   */
+  inline void
+  ResetTransmitSession (const Ipv4Address & neighbor_node_ip)
+  {
+    m_transmit_sessions.erase (neighbor_node_ip);
   }
 
   /**
@@ -520,6 +814,44 @@ public:
                           std::set<DataIdentifier> & local_unknown_packets,
                           std::set<DataIdentifier> & neighbor_unknown_packets) const;
 
+  /**
+   * Calculates the set of packets that the neighbor node does not know using
+   * the Bloom filter of its summary vector.
+   * 
+   * A Bloom filter can't list its entries, so the locally unknown packets can't
+   * be computed. Instead, it returns a lower bound of the number of packets 
+   * that the local node does not know: the number of entries of the filter 
+   * minus the number of local packets that (probably) are in the filter.
+   * 
+   * A false positive of the filter makes a packet that the neighbor doesn't
+   * know to be considered known: it is not transmitted to the neighbor in this
+   * contact, and will be offered again in the next one (the filters of the next
+   * contacts are built with other entries, so the same collision is unlikely).
+   * For the same reason the neighbor node must not be recorded as a carrier of
+   * the packets in <code>neighbor_known_packets</code>.
+   * 
+   * The <code>neighbor_known_packets</code> and <code>neighbor_unknown_packets</code>
+   * parameters are always emptied before the processed data is stored into 
+   * them.
+   * 
+   * @param bloom_filter [IN] Bloom filter of the received summary vector.
+   * @param summary_vector_size [IN] Number of entries of the Bloom filter.
+   * @param neighbor_ip [IN] IP address of the neighbor node.
+   * @param neighbor_known_packets [OUT] The set of local packets that the 
+   * neighbor node (probably) knows.
+   * @param neighbor_unknown_packets [OUT] the set of packets that the neighbor
+   * node does not know.
+   * 
+   * @return Lower bound of the number of packets that the local node does not
+   * know.
+   */
+  uint32_t
+  ProcessDisjointVectors (const DataIdentifierBloomFilter & bloom_filter,
+                          uint32_t summary_vector_size,
+                          const Ipv4Address & neighbor_ip,
+                          std::set<DataIdentifier> & neighbor_known_packets,
+                          std::set<DataIdentifier> & neighbor_unknown_packets) const;
+
 
 private:
 
@@ -534,8 +866,21 @@ private:
    * than <code>entry_2</code>.
    */
   static bool
-  ComparePacketTransmissionPriority (const std::map<DataIdentifier, PacketQueueEntry>::value_type & entry_1,
-                                     const std::map<DataIdentifier, PacketQueueEntry>::value_type & entry_2);
+  ComparePacketTransmissionPriority (const DataIdentifierMap<PacketQueueEntry>::value_type & entry_1,
+                                     const DataIdentifierMap<PacketQueueEntry>::value_type & entry_2);
+
+  /**
+   * Returns <code>true</code> if <code>entry_1</code> has <i>higher</i> drop 
+   * priority than <code>entry_2</code>: it has lower transmission priority (see
+   * <code>ComparePacketTransmissionPriority</code>), or equal transmission 
+   * priority and lower data identifier. 
+   * 
+   * The tie-break makes the dropped packet independent of the iteration order
+   * of the packets table.
+   */
+  static bool
+  ComparePacketDropPriority (const DataIdentifierMap<PacketQueueEntry>::value_type & entry_1,
+                             const DataIdentifierMap<PacketQueueEntry>::value_type & entry_2);
 
   /**
    * Finds the packet with highest priority to be dropped from the queue.
@@ -545,6 +890,9 @@ private:
    * consequently, the lowest transmission priority is the highest drop 
    * priority.
    * 
+   * The packet is taken from the drop priority index, after updating the drop
+   * classes of the entries for the given position.
+   * 
    * When a packet entry is found it returns <code>true</code> and the identifier
    * of the packet with the highest priority is stored in the output parameter 
    * <code>selected_packet</code>. On the contrary, if it can't find a packet
@@ -561,7 +909,58 @@ private:
    */
   bool
   FindHighestDropPriorityPacket (const Vector2D & current_node_position,
-                                 DataIdentifier & selected_packet) const;
+                                 DataIdentifier & selected_packet);
+
+  /** Returns the drop class of a packet entry. */
+  static inline uint8_t
+  ComputeDropClass (bool emergency_flag, bool inside_gta)
+  {
+    return (emergency_flag ? EMERGENCY_OUTSIDE_GTA : REGULAR_OUTSIDE_GTA) + (inside_gta ? 1u : 0u);
+  }
+
+  /**
+   * Returns the first instant after the given time at which the status of the
+   * time period (during or not) changes, or <code>Time::Max ()</code> if it 
+   * doesn't change anymore.
+   */
+  static Time
+  GetNextTimePeriodUpdate (const TimePeriod & time_period, const Time & current_time);
+
+  /**
+   * Adds the packet entry to the drop priority index. Its drop class is 
+   * computed with the position of the last update of the index.
+   */
+  void
+  InsertDropPriorityEntry (const DataIdentifier & data_id, const PacketQueueEntry & entry);
+
+  /** Removes the packet entry from the drop priority index. */
+  void
+  RemoveDropPriorityEntry (const DataIdentifier & data_id);
+
+  /** Updates the key of the packet entry in the drop priority index after its
+   * known carrier nodes changed. */
+  void
+  UpdateDropPriorityKey (const DataIdentifier & data_id, const PacketQueueEntry & entry);
+
+  /**
+   * Computes the drop classes of the indexed entries for the given position of
+   * the local node and the current time, unless the position didn't change and
+   * no time period status changed since the last update.
+   */
+  void
+  UpdateDropClasses (const Vector2D & current_node_position);
+
+  /**
+   * Increases the version of the summary vector, updates its digest and stores
+   * the change in the summary vector log (discarding the oldest change if the
+   * log is full).
+   * 
+   * @param data_packet_id [IN] Data packet identifier of the packet.
+   * @param inserted [IN] <code>true</code> if the packet was inserted, or 
+   * <code>false</code> if it was removed.
+   */
+  void
+  LogSummaryVectorChange (const DataIdentifier & data_packet_id, bool inserted);
 
   /**
    * Finds the packet with highest priority to be transmitted.
@@ -642,6 +1041,79 @@ private:
                                      PacketQueueEntry & selected_packet,
                                      bool & inside_area_flag) const;
 
+  /**
+   * Returns <code>true</code> if <code>candidate_1</code> has <i>lower</i> 
+   * transmission priority than <code>candidate_2</code>: higher priority class,
+   * or the same class and lower priority by the criteria of 
+   * <code>ComparePacketTransmissionPriority</code>, or the same priority and
+   * higher data identifier.
+   * 
+   * The highest candidate is the packet that 
+   * <code>FindHighestTransmitPriorityPacket</code> selects.
+   */
+  static bool
+  CompareTransmitCandidates (const TransmitCandidate & candidate_1,
+                             const TransmitCandidate & candidate_2);
+
+  /**
+   * Computes the priority class of the candidate (see 
+   * <code>TransmitCandidate::m_priority_class</code>) from its snapshot fields
+   * and the given replicas counter.
+   * 
+   * @return <code>false</code> if the packet can't be transmitted to the 
+   * neighbor node: it is outside its destination GTA and it has no replicas
+   * left or the neighbor node isn't a valid carrier.
+   */
+  static bool
+  ComputeTransmitPriorityClass (TransmitCandidate & candidate, bool inside_area,
+                                uint32_t replicas_counter);
+
+  /**
+   * Returns <code>true</code> if the transmission session can still be used
+   * with the given dequeue parameters, see <code>TransmitSession</code>. The
+   * positions of the session are updated if they keep the same inside-area
+   * flags.
+   */
+  bool
+  IsTransmitSessionValid (TransmitSession & session,
+                          const Ipv4Address & local_node_ip,
+                          const Vector2D & local_position,
+                          const Vector2D & neighbor_position,
+                          const std::set<DataIdentifier> & disjoint_vector) const;
+
+  /**
+   * Ranks the requested packets of the disjoint vector in the transmit 
+   * priority heap of the session. The packets that can't be transmitted to the
+   * neighbor node aren't inserted in the heap.
+   * 
+   * It throws the exceptions of <code>GpsSystem::IsVehicleValidPacketCarrier</code>.
+   */
+  void
+  BuildTransmitSession (TransmitSession & session,
+                        const Ipv4Address & local_node_ip,
+                        const Vector2D & local_position,
+                        const Ipv4Address & neighbor_node_ip,
+                        const Vector2D & neighbor_position,
+                        const std::set<DataIdentifier> & disjoint_vector) const;
+
+  /**
+   * Pops from the transmit priority heap of the session the requested packet
+   * with the highest priority. 
+   * 
+   * The candidates are invalidated lazily: the popped candidate is checked 
+   * against the current packet entry, it is discarded if the packet is no 
+   * longer in the queue or in the disjoint vector or it can't be transmitted
+   * anymore (no replicas left), and it is ranked again if its priority changed
+   * (e.g. new known carriers).
+   * 
+   * @return <code>true</code> if a packet is found, otherwise <code>false</code>.
+   */
+  bool
+  PopHighestTransmitPriorityPacket (TransmitSession & session,
+                                    const std::set<DataIdentifier> & disjoint_vector,
+                                    PacketQueueEntry & selected_packet,
+                                    bool & inside_area_flag) const;
+
 
 public:
 
@@ -667,10 +1139,36 @@ public:
            const Vector2D & current_node_position,
            const Ipv4Address & transmitter_ip);
 
+  /**
+   * Inserts a new packet queue entry to the packets queue with the given 
+   * number of replicas, instead of the default one.
+   * 
+   * @param data_header [IN] Data header of the data packet to insert.
+   * @param current_node_position [IN] The current geographical position of the
+   * local node.
+   * @param transmitter_ip [IN] IP address of the node that transmitted the 
+   * packet.
+   * @param replicas_counter [IN] Number of replicas of the packet that the 
+   * routing protocol can send.
+   * 
+   * @return <code>true</code> if the data packet was successfully inserted, 
+   * <code>false</code> otherwise.
+   */
+  bool
+  Enqueue (const DataHeader & data_header,
+           const Vector2D & current_node_position,
+           const Ipv4Address & transmitter_ip,
+           uint32_t replicas_counter);
+
   /**
    * Dequeues for transmission the packet with the highest priority from the
    * given set of requested packets.
    * 
+   * The requested packets of each neighbor node are ranked once per 
+   * transmission session (see <code>TransmitSession</code>) with the same 
+   * criteria of <code>FindHighestTransmitPriorityPacket</code>. The caller must remove the dequeued packet from the set of requested packets,
+   * and call <code>ResetTransmitSession</code> if the set changes otherwise.
+   * 
    * @Note
    * One important note is that even though the packets queue may not be empty
    * the function might not select a packet to be transmitted, depending on the
@@ -772,6 +1270,9 @@ public:
 
   /**
    * Removes all expired data packet entries from the data packets queue.
+   * 
+   * It only visits the entries whose expiration instant has passed, so it can
+   * be called on every received packet.
    */
   void
   Purge ();
@@ -798,9 +1299,11 @@ public:
    * Logs that a data packet in the queue was transmitted.
    * 
    * @param data_packet_id Data packet identifier of the transmitted packet.
+   * @param transmission_type Type of transmission of the packet.
    */
   void
-  LogPacketTransmitted (const DataIdentifier & data_packet_id);
+  LogPacketTransmitted (const DataIdentifier & data_packet_id,
+                        const TransmissionType & transmission_type = TransmissionType::Unicast);
 
   /**
    * Logs that a duplicate of an already known data packet is received.
@@ -839,12 +1342,13 @@ inline bool
 operator== (const PacketsQueue & lhs, const PacketsQueue & rhs)
 {
   return lhs.m_gps == rhs.m_gps
-          && lhs.m_max_queue_length == rhs.m_max_queue_length
           && lhs.m_max_replicas_counter == rhs.m_max_replicas_counter
-          && lhs.m_packets_dropped_counter == rhs.m_packets_dropped_counter
           && lhs.m_min_vehicles_distance_diff == rhs.m_min_vehicles_distance_diff
           && lhs.m_packets_table == rhs.m_packets_table
-          && lhs.m_data_packet_reception_stats == rhs.m_data_packet_reception_stats;
+          && lhs.m_data_packet_reception_stats == rhs.m_data_packet_reception_stats
+          && lhs.m_summary_vector_version == rhs.m_summary_vector_version
+          && lhs.m_summary_vector_log_capacity == rhs.m_summary_vector_log_capacity
+          && lhs.m_summary_vector_log == rhs.m_summary_vector_log;
 }
 
 inline bool
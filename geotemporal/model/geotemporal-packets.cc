@@ -25,6 +25,7 @@
 #include "geotemporal-packets.h"
 
 #include <cstdio>
+#include <stdexcept>
 
 #include <ns3/abort.h>
 #include <ns3/address-utils.h>
@@ -42,6 +43,13 @@
 
 #define EMERGENCY 7
 
+#define COMPACT_ENCODING 7
+#define SUMMARY_VECTOR_ENCODING_SHIFT 5
+#define SUMMARY_VECTOR_ENCODING_MASK 0x60
+
+#define HELLO_SUMMARY_VECTOR 0
+#define HELLO_SUMMARY_VECTOR_DIGEST 1
+
 
 namespace ns3
 {
@@ -70,6 +78,12 @@ ToString (const PacketType& obj)
       return "Data";
     case PacketType::DataAck:
       return "DataAck";
+    case PacketType::AggregatedData:
+      return "AggregatedData";
+    case PacketType::AggregatedAck:
+      return "AggregatedAck";
+    case PacketType::ResyncRequest:
+      return "ResyncRequest";
     default:
       return "Unknown";
       // NS_ABORT_MSG ("Unknown packet type.");
@@ -84,13 +98,25 @@ ToString (const PacketType& obj)
 NS_OBJECT_ENSURE_REGISTERED (TypeHeader);
 
 TypeHeader::TypeHeader ()
-: m_packet_type (PacketType::Hello), m_valid (true) { }
+: m_packet_type (PacketType::Hello), m_compact_encoding (false),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit), m_valid (true) { }
 
 TypeHeader::TypeHeader (PacketType packet_type)
-: m_packet_type (packet_type), m_valid (true) { }
+: m_packet_type (packet_type), m_compact_encoding (false),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit), m_valid (true) { }
+
+TypeHeader::TypeHeader (PacketType packet_type, bool compact_encoding)
+: m_packet_type (packet_type), m_compact_encoding (compact_encoding),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit), m_valid (true) { }
+
+TypeHeader::TypeHeader (PacketType packet_type, bool compact_encoding,
+                        SummaryVectorEncoding summary_vector_encoding)
+: m_packet_type (packet_type), m_compact_encoding (compact_encoding),
+m_summary_vector_encoding (summary_vector_encoding), m_valid (true) { }
 
 TypeHeader::TypeHeader (const TypeHeader& copy)
-: m_packet_type (copy.m_packet_type), m_valid (copy.m_valid) { }
+: m_packet_type (copy.m_packet_type), m_compact_encoding (copy.m_compact_encoding),
+m_summary_vector_encoding (copy.m_summary_vector_encoding), m_valid (copy.m_valid) { }
 
 
 // --------------------------
@@ -127,7 +153,12 @@ TypeHeader::GetSerializedSize () const
 void
 TypeHeader::Serialize (Buffer::Iterator start) const
 {
-  start.WriteU8 ((uint8_t) m_packet_type);
+  uint8_t packet_type = (uint8_t) m_packet_type;
+  if (m_compact_encoding) SetBitFlag (packet_type, COMPACT_ENCODING);
+  packet_type |= ((uint8_t) m_summary_vector_encoding << SUMMARY_VECTOR_ENCODING_SHIFT)
+          & SUMMARY_VECTOR_ENCODING_MASK;
+
+  start.WriteU8 (packet_type);
 }
 
 uint32_t
@@ -137,6 +168,16 @@ TypeHeader::Deserialize (Buffer::Iterator start)
 
   uint8_t packet_type = it.ReadU8 ();
 
+  m_compact_encoding = CheckBitFlag (packet_type, COMPACT_ENCODING);
+  ClearBitFlag (packet_type, COMPACT_ENCODING);
+
+  const uint8_t summary_vector_encoding = (packet_type & SUMMARY_VECTOR_ENCODING_MASK)
+          >> SUMMARY_VECTOR_ENCODING_SHIFT;
+  packet_type &= ~SUMMARY_VECTOR_ENCODING_MASK;
+
+  // All the values of the 2 bits are valid encodings.
+  m_summary_vector_encoding = static_cast<SummaryVectorEncoding> (summary_vector_encoding);
+
   m_valid = true;
 
   switch (static_cast<PacketType> (packet_type))
@@ -147,6 +188,9 @@ TypeHeader::Deserialize (Buffer::Iterator start)
     case PacketType::Ack:
     case PacketType::Data:
     case PacketType::DataAck:
+    case PacketType::AggregatedData:
+    case PacketType::AggregatedAck:
+    case PacketType::ResyncRequest:
       m_packet_type = static_cast<PacketType> (packet_type);
       break;
     default:
@@ -181,15 +225,50 @@ TypeHeader::ToString () const
 NS_OBJECT_ENSURE_REGISTERED (HelloHeader);
 
 HelloHeader::HelloHeader ()
-: m_reserved (0u), m_summary_vector_size (0u), m_sender_node_ip () { }
+: m_flags (0u), m_summary_vector_size (0u), m_sender_node_ip (),
+m_summary_vector_digest (0u) { }
 
 HelloHeader::HelloHeader (const Ipv4Address& node_ip, uint16_t summary_vector_size)
-: m_reserved (0u), m_summary_vector_size (summary_vector_size),
-m_sender_node_ip (node_ip) { }
+: m_flags (0u), m_summary_vector_size (summary_vector_size),
+m_sender_node_ip (node_ip), m_summary_vector_digest (0u) { }
 
 HelloHeader::HelloHeader (const HelloHeader& copy)
-: m_reserved (copy.m_reserved), m_summary_vector_size (copy.m_summary_vector_size),
-m_sender_node_ip (copy.m_sender_node_ip) { }
+: m_flags (copy.m_flags), m_summary_vector_size (copy.m_summary_vector_size),
+m_sender_node_ip (copy.m_sender_node_ip),
+m_summary_vector_digest (copy.m_summary_vector_digest) { }
+
+
+// --------------------------
+// Getters & Setters
+// --------------------------
+
+bool
+HelloHeader::HasSummaryVector () const
+{
+  return CheckBitFlag (m_flags, HELLO_SUMMARY_VECTOR);
+}
+
+void
+HelloHeader::SetSummaryVectorFlag (bool summary_vector_flag)
+{
+  if (summary_vector_flag)
+    SetBitFlag (m_flags, HELLO_SUMMARY_VECTOR);
+  else
+    ClearBitFlag (m_flags, HELLO_SUMMARY_VECTOR);
+}
+
+bool
+HelloHeader::HasSummaryVectorDigest () const
+{
+  return CheckBitFlag (m_flags, HELLO_SUMMARY_VECTOR_DIGEST);
+}
+
+void
+HelloHeader::SetSummaryVectorDigest (uint32_t summary_vector_digest)
+{
+  m_summary_vector_digest = summary_vector_digest;
+  SetBitFlag (m_flags, HELLO_SUMMARY_VECTOR_DIGEST);
+}
 
 
 // --------------------------
@@ -220,15 +299,18 @@ HelloHeader::GetInstanceTypeId () const
 uint32_t
 HelloHeader::GetSerializedSize () const
 {
-  return 7u;
+  return HasSummaryVectorDigest () ? 11u : 7u;
 }
 
 void
 HelloHeader::Serialize (Buffer::Iterator start) const
 {
-  start.WriteU8 (m_reserved);
+  start.WriteU8 (m_flags);
   start.WriteHtonU16 (m_summary_vector_size);
   WriteTo (start, m_sender_node_ip);
+
+  if (HasSummaryVectorDigest ())
+    start.WriteHtonU32 (m_summary_vector_digest);
 }
 
 uint32_t
@@ -236,10 +318,12 @@ HelloHeader::Deserialize (Buffer::Iterator start)
 {
   Buffer::Iterator it = start;
 
-  m_reserved = it.ReadU8 ();
+  m_flags = it.ReadU8 ();
   m_summary_vector_size = it.ReadNtohU16 ();
   ReadFrom (it, m_sender_node_ip);
 
+  m_summary_vector_digest = HasSummaryVectorDigest () ? it.ReadNtohU32 () : 0u;
+
   uint32_t distance = it.GetDistanceFrom (start);
   NS_ASSERT (distance == GetSerializedSize ());
   return distance;
@@ -259,6 +343,10 @@ HelloHeader::ToString () const
   std::string str = "HELLO from "
           + GeoTemporalLibrary::LibraryUtils::ToString (m_sender_node_ip)
           + " who knows " + std::string (buffer) + " packets";
+
+  if (HasSummaryVector ())
+    str += " (summary vector attached)";
+
   return str;
 }
 
@@ -270,16 +358,27 @@ HelloHeader::ToString () const
 NS_OBJECT_ENSURE_REGISTERED (SummaryVectorHeader);
 
 SummaryVectorHeader::SummaryVectorHeader ()
-: m_summary_vector (), m_position (), m_velocity () { }
+: m_summary_vector (), m_position (), m_velocity (), m_compact_encoding (false),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit), m_bloom_filter (),
+m_bloom_filter_entries_count (0u), m_base_version (0u), m_version (0u),
+m_removed_packets () { }
 
 SummaryVectorHeader::SummaryVectorHeader (const std::set<DataIdentifier>& summary_vector,
                                           const GeoTemporalLibrary::LibraryUtils::Vector2D& position,
                                           const GeoTemporalLibrary::LibraryUtils::Vector2D& velocity)
-: m_summary_vector (summary_vector), m_position (position), m_velocity (velocity) { }
+: m_summary_vector (summary_vector), m_position (position), m_velocity (velocity),
+m_compact_encoding (false), m_summary_vector_encoding (SummaryVectorEncoding::Explicit),
+m_bloom_filter (), m_bloom_filter_entries_count (0u), m_base_version (0u),
+m_version (0u), m_removed_packets () { }
 
 SummaryVectorHeader::SummaryVectorHeader (const SummaryVectorHeader& copy)
 : m_summary_vector (copy.m_summary_vector), m_position (copy.m_position),
-m_velocity (copy.m_velocity) { }
+m_velocity (copy.m_velocity), m_compact_encoding (copy.m_compact_encoding),
+m_summary_vector_encoding (copy.m_summary_vector_encoding),
+m_bloom_filter (copy.m_bloom_filter),
+m_bloom_filter_entries_count (copy.m_bloom_filter_entries_count),
+m_base_version (copy.m_base_version), m_version (copy.m_version),
+m_removed_packets (copy.m_removed_packets) { }
 
 
 // --------------------------
@@ -299,6 +398,9 @@ SummaryVectorHeader::GetTypeId ()
 TypeId
 SummaryVectorHeader::GetInstanceTypeId () const
 {
+  if (IsCompactEncoding ())
+    return CompactSummaryVectorHeader::GetTypeId ();
+
   return GetTypeId ();
 }
 
@@ -310,12 +412,29 @@ SummaryVectorHeader::GetInstanceTypeId () const
 uint32_t
 SummaryVectorHeader::GetSerializedSize () const
 {
-  return 27u + (m_summary_vector.size () * 6u);
+  if (m_compact_encoding)
+    {
+      return 2u + CompactCoordinatesEncoding::GetPositionSerializedSize (m_position)
+              + CompactCoordinatesEncoding::GetVelocitySerializedSize (m_velocity)
+              + GetSummaryVectorSerializedSize ();
+    }
+
+  return 27u + GetSummaryVectorSerializedSize ();
 }
 
 void
 SummaryVectorHeader::Serialize (Buffer::Iterator start) const
 {
+  if (m_compact_encoding)
+    {
+      start.WriteHtonU16 (GetSummaryVectorSize ());
+      CompactCoordinatesEncoding::WritePosition (start, m_position);
+      CompactCoordinatesEncoding::WriteVelocity (start, m_velocity);
+
+      SerializeSummaryVector (start);
+      return;
+    }
+
   uint8_t sign_flags = 0u;
 
   uint32_t position_x_int, position_x_float;
@@ -333,7 +452,7 @@ SummaryVectorHeader::Serialize (Buffer::Iterator start) const
   EncodeFloatToInteger (m_velocity.m_y, velocity_y_int, sign_flags, VELOCITY_Y);
 
   start.WriteU8 (sign_flags);
-  start.WriteHtonU16 (m_summary_vector.size ());
+  start.WriteHtonU16 (GetSummaryVectorSize ());
 
   start.WriteHtonU32 (position_x_int);
   start.WriteHtonU32 (position_x_float);
@@ -343,22 +462,7 @@ SummaryVectorHeader::Serialize (Buffer::Iterator start) const
   start.WriteHtonU32 (velocity_x_int);
   start.WriteHtonU32 (velocity_y_int);
 
-  bool odd = true;
-  for (std::set<DataIdentifier>::const_iterator it = m_summary_vector.begin ();
-          it != m_summary_vector.end (); ++it)
-    {
-      if (odd)
-        {
-          WriteTo (start, it->GetSourceIp ());
-          start.WriteHtonU16 (it->GetSourceId ());
-        }
-      else
-        {
-          start.WriteHtonU16 (it->GetSourceId ());
-          WriteTo (start, it->GetSourceIp ());
-        }
-      odd = !odd;
-    }
+  SerializeSummaryVector (start);
 }
 
 uint32_t
@@ -366,6 +470,19 @@ SummaryVectorHeader::Deserialize (Buffer::Iterator start)
 {
   Buffer::Iterator it = start;
 
+  if (m_compact_encoding)
+    {
+      const uint16_t summary_vector_size = it.ReadNtohU16 ();
+      m_position = CompactCoordinatesEncoding::ReadPosition (it);
+      m_velocity = CompactCoordinatesEncoding::ReadVelocity (it);
+
+      DeserializeSummaryVector (it, summary_vector_size);
+
+      uint32_t distance = it.GetDistanceFrom (start);
+      NS_ASSERT (distance == GetSerializedSize ());
+      return distance;
+    }
+
   const uint8_t sign_flags = it.ReadU8 ();
   const uint16_t summary_vector_size = it.ReadNtohU16 ();
 
@@ -385,6 +502,96 @@ SummaryVectorHeader::Deserialize (Buffer::Iterator start)
   int_part = it.ReadNtohU32 ();
   m_velocity.m_y = DecodeFloatFromInteger (int_part, sign_flags, VELOCITY_Y);
 
+  DeserializeSummaryVector (it, summary_vector_size);
+
+  uint32_t distance = it.GetDistanceFrom (start);
+  NS_ASSERT (distance == GetSerializedSize ());
+  return distance;
+}
+
+uint32_t
+SummaryVectorHeader::GetSummaryVectorSerializedSize () const
+{
+  switch (m_summary_vector_encoding)
+    {
+    case SummaryVectorEncoding::DeltaCoded:
+      return GetDeltaCodedSerializedSize (m_summary_vector);
+    case SummaryVectorEncoding::BloomFilter:
+      return m_bloom_filter.GetSerializedSize ();
+    case SummaryVectorEncoding::Incremental:
+      return GetVarIntSerializedSize (m_base_version) + GetVarIntSerializedSize (m_version)
+              + GetDeltaCodedSerializedSize (m_summary_vector)
+              + GetDeltaCodedSerializedSize (m_removed_packets);
+    default:
+      return m_summary_vector.size () * 6u;
+    }
+}
+
+void
+SummaryVectorHeader::SerializeSummaryVector (Buffer::Iterator& start) const
+{
+  if (m_summary_vector_encoding == SummaryVectorEncoding::DeltaCoded)
+    {
+      WriteDeltaCoded (start, m_summary_vector);
+      return;
+    }
+  else if (m_summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+    {
+      m_bloom_filter.Serialize (start);
+      return;
+    }
+  else if (m_summary_vector_encoding == SummaryVectorEncoding::Incremental)
+    {
+      WriteVarInt (start, m_base_version);
+      WriteVarInt (start, m_version);
+      WriteDeltaCoded (start, m_summary_vector);
+      WriteDeltaCoded (start, m_removed_packets);
+      return;
+    }
+
+  bool odd = true;
+  for (std::set<DataIdentifier>::const_iterator it = m_summary_vector.begin ();
+          it != m_summary_vector.end (); ++it)
+    {
+      if (odd)
+        {
+          WriteTo (start, it->GetSourceIp ());
+          start.WriteHtonU16 (it->GetSourceId ());
+        }
+      else
+        {
+          start.WriteHtonU16 (it->GetSourceId ());
+          WriteTo (start, it->GetSourceIp ());
+        }
+      odd = !odd;
+    }
+}
+
+void
+SummaryVectorHeader::DeserializeSummaryVector (Buffer::Iterator& it,
+                                               uint16_t summary_vector_size)
+{
+  if (m_summary_vector_encoding == SummaryVectorEncoding::DeltaCoded)
+    {
+      ReadDeltaCoded (it, m_summary_vector);
+      return;
+    }
+  else if (m_summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+    {
+      m_summary_vector = std::set<DataIdentifier> ();
+      m_bloom_filter.Deserialize (it);
+      m_bloom_filter_entries_count = summary_vector_size;
+      return;
+    }
+  else if (m_summary_vector_encoding == SummaryVectorEncoding::Incremental)
+    {
+      m_base_version = (uint32_t) ReadVarInt (it);
+      m_version = (uint32_t) ReadVarInt (it);
+      ReadDeltaCoded (it, m_summary_vector);
+      ReadDeltaCoded (it, m_removed_packets);
+      return;
+    }
+
   m_summary_vector = std::set<DataIdentifier> ();
   Ipv4Address ip;
   uint16_t id;
@@ -406,10 +613,6 @@ SummaryVectorHeader::Deserialize (Buffer::Iterator start)
       odd = !odd;
       m_summary_vector.insert (DataIdentifier (ip, id));
     }
-
-  uint32_t distance = it.GetDistanceFrom (start);
-  NS_ASSERT (distance == GetSerializedSize ());
-  return distance;
 }
 
 void
@@ -438,6 +641,34 @@ SummaryVectorHeader::ToString () const
 }
 
 
+// =============================================================================
+//                         CompactSummaryVectorHeader
+// =============================================================================
+
+NS_OBJECT_ENSURE_REGISTERED (CompactSummaryVectorHeader);
+
+CompactSummaryVectorHeader::CompactSummaryVectorHeader ()
+: SummaryVectorHeader ()
+{
+  SetCompactEncoding (true);
+}
+
+
+// --------------------------
+// Type ID
+// --------------------------
+
+TypeId
+CompactSummaryVectorHeader::GetTypeId ()
+{
+  static TypeId type_id = TypeId ("ns3::geotemporal::CompactSummaryVectorHeader")
+          .SetParent<SummaryVectorHeader> ()
+          .SetGroupName ("Geotemporal")
+          .AddConstructor<CompactSummaryVectorHeader> ();
+  return type_id;
+}
+
+
 // =============================================================================
 //                                   AckHeader
 // =============================================================================
@@ -445,16 +676,17 @@ SummaryVectorHeader::ToString () const
 NS_OBJECT_ENSURE_REGISTERED (AckHeader);
 
 AckHeader::AckHeader ()
-: m_data_id (), m_position (), m_velocity () { }
+: m_data_id (), m_position (), m_velocity (), m_compact_encoding (false) { }
 
 AckHeader::AckHeader (const DataIdentifier& data_identifier,
                       const GeoTemporalLibrary::LibraryUtils::Vector2D& position,
                       const GeoTemporalLibrary::LibraryUtils::Vector2D& velocity)
-: m_data_id (data_identifier), m_position (position), m_velocity (velocity) { }
+: m_data_id (data_identifier), m_position (position), m_velocity (velocity),
+m_compact_encoding (false) { }
 
 AckHeader::AckHeader (const AckHeader& copy)
 : m_data_id (copy.m_data_id), m_position (copy.m_position),
-m_velocity (copy.m_velocity) { }
+m_velocity (copy.m_velocity), m_compact_encoding (copy.m_compact_encoding) { }
 
 
 // --------------------------
@@ -474,6 +706,9 @@ AckHeader::GetTypeId ()
 TypeId
 AckHeader::GetInstanceTypeId () const
 {
+  if (IsCompactEncoding ())
+    return CompactAckHeader::GetTypeId ();
+
   return GetTypeId ();
 }
 
@@ -485,12 +720,28 @@ AckHeader::GetInstanceTypeId () const
 uint32_t
 AckHeader::GetSerializedSize () const
 {
+  if (m_compact_encoding)
+    {
+      return 6u + CompactCoordinatesEncoding::GetPositionSerializedSize (m_position)
+              + CompactCoordinatesEncoding::GetVelocitySerializedSize (m_velocity);
+    }
+
   return 31u;
 }
 
 void
 AckHeader::Serialize (Buffer::Iterator start) const
 {
+  if (m_compact_encoding)
+    {
+      start.WriteHtonU16 (m_data_id.GetSourceId ());
+      WriteTo (start, m_data_id.GetSourceIp ());
+
+      CompactCoordinatesEncoding::WritePosition (start, m_position);
+      CompactCoordinatesEncoding::WriteVelocity (start, m_velocity);
+      return;
+    }
+
   uint8_t sign_flags = 0u;
 
   uint32_t position_x_int, position_x_float;
@@ -526,6 +777,21 @@ AckHeader::Deserialize (Buffer::Iterator start)
 {
   Buffer::Iterator it = start;
 
+  if (m_compact_encoding)
+    {
+      const uint16_t data_source_id = it.ReadNtohU16 ();
+      Ipv4Address data_source_ip;
+      ReadFrom (it, data_source_ip);
+
+      m_data_id = DataIdentifier (data_source_ip, data_source_id);
+      m_position = CompactCoordinatesEncoding::ReadPosition (it);
+      m_velocity = CompactCoordinatesEncoding::ReadVelocity (it);
+
+      uint32_t distance = it.GetDistanceFrom (start);
+      NS_ASSERT (distance == AckHeader::GetSerializedSize ());
+      return distance;
+    }
+
   const uint8_t sign_flags = it.ReadU8 ();
 
   // Read DATA packet ID
@@ -552,7 +818,7 @@ AckHeader::Deserialize (Buffer::Iterator start)
   m_velocity.m_y = DecodeFloatFromInteger (int_part, sign_flags, VELOCITY_Y);
 
   uint32_t distance = it.GetDistanceFrom (start);
-  NS_ASSERT (distance == GetSerializedSize ());
+  NS_ASSERT (distance == AckHeader::GetSerializedSize ());
   return distance;
 }
 
@@ -570,6 +836,34 @@ AckHeader::ToString () const
 }
 
 
+// =============================================================================
+//                              CompactAckHeader
+// =============================================================================
+
+NS_OBJECT_ENSURE_REGISTERED (CompactAckHeader);
+
+CompactAckHeader::CompactAckHeader ()
+: AckHeader ()
+{
+  SetCompactEncoding (true);
+}
+
+
+// --------------------------
+// Type ID
+// --------------------------
+
+TypeId
+CompactAckHeader::GetTypeId ()
+{
+  static TypeId type_id = TypeId ("ns3::geotemporal::CompactAckHeader")
+          .SetParent<AckHeader> ()
+          .SetGroupName ("Geotemporal")
+          .AddConstructor<CompactAckHeader> ();
+  return type_id;
+}
+
+
 // =============================================================================
 //                                  DataHeader
 // =============================================================================
@@ -578,7 +872,7 @@ NS_OBJECT_ENSURE_REGISTERED (DataHeader);
 
 DataHeader::DataHeader ()
 : m_data_id (), m_emergency_flag (false), m_hops_count (0u), m_position (),
-m_velocity (), m_dest_geo_temporal_area (), m_message () { }
+m_velocity (), m_dest_geo_temporal_area (), m_message (), m_compact_encoding (false) { }
 
 DataHeader::DataHeader (const DataIdentifier& data_id,
                         const uint32_t hops_count,
@@ -588,7 +882,8 @@ DataHeader::DataHeader (const DataIdentifier& data_id,
                         const std::string message)
 : m_data_id (data_id), m_emergency_flag (false), m_hops_count (hops_count),
 m_position (position), m_velocity (velocity),
-m_dest_geo_temporal_area (destination_geo_temporal_area), m_message (message) { }
+m_dest_geo_temporal_area (destination_geo_temporal_area), m_message (message),
+m_compact_encoding (false) { }
 
 DataHeader::DataHeader (const DataIdentifier& data_id,
                         const bool emergency_flag,
@@ -599,7 +894,8 @@ DataHeader::DataHeader (const DataIdentifier& data_id,
                         const std::string message)
 : m_data_id (data_id), m_emergency_flag (emergency_flag), m_hops_count (hops_count),
 m_position (position), m_velocity (velocity),
-m_dest_geo_temporal_area (destination_geo_temporal_area), m_message (message) { }
+m_dest_geo_temporal_area (destination_geo_temporal_area), m_message (message),
+m_compact_encoding (false) { }
 
 DataHeader::DataHeader (const DataHeader& copy)
 : m_data_id (copy.m_data_id),
@@ -608,7 +904,8 @@ m_hops_count (copy.m_hops_count),
 m_position (copy.m_position),
 m_velocity (copy.m_velocity),
 m_dest_geo_temporal_area (copy.m_dest_geo_temporal_area),
-m_message (copy.m_message) { }
+m_message (copy.m_message),
+m_compact_encoding (copy.m_compact_encoding) { }
 
 
 // --------------------------
@@ -628,6 +925,9 @@ DataHeader::GetTypeId ()
 TypeId
 DataHeader::GetInstanceTypeId () const
 {
+  if (IsCompactEncoding ())
+    return CompactDataHeader::GetTypeId ();
+
   return GetTypeId ();
 }
 
@@ -639,12 +939,21 @@ DataHeader::GetInstanceTypeId () const
 uint32_t
 DataHeader::GetSerializedSize () const
 {
-  return 73u + m_message.size (); // 1 byte is because of the null terminator of the message.
+  if (m_compact_encoding)
+    return GetCompactDataSerializedSize ();
+
+  return 73u + m_message.Size (); // 1 byte is because of the null terminator of the message.
 }
 
 void
 DataHeader::Serialize (Buffer::Iterator start) const
 {
+  if (m_compact_encoding)
+    {
+      SerializeCompactData (start);
+      return;
+    }
+
   uint8_t sign_flags = 0u;
 
   uint32_t position_x_int, position_x_float;
@@ -712,10 +1021,7 @@ DataHeader::Serialize (Buffer::Iterator start) const
 
   start.WriteU8 (other_flags);
 
-  const uint32_t message_length = m_message.length () + 1u;
-  char chars_buffer [message_length];
-  std::strcpy (chars_buffer, m_message.c_str ());
-  start.Write ((uint8_t *) chars_buffer, message_length);
+  m_message.Write (start);
 }
 
 uint32_t
@@ -723,6 +1029,15 @@ DataHeader::Deserialize (Buffer::Iterator start)
 {
   Buffer::Iterator it = start;
 
+  if (m_compact_encoding)
+    {
+      DeserializeCompactData (it);
+
+      uint32_t distance = it.GetDistanceFrom (start);
+      NS_ASSERT (distance == GetSerializedSize ());
+      return distance;
+    }
+
   const uint8_t sign_flags = it.ReadU8 ();
 
   // Read DATA packet ID
@@ -781,33 +1096,85 @@ DataHeader::Deserialize (Buffer::Iterator start)
   const uint8_t other_flags = it.ReadU8 ();
   m_emergency_flag = CheckBitFlag (other_flags, EMERGENCY);
 
-  // Read the string message.
-  uint8_t character_read = 0u;
-  uint32_t message_size = 0u;
-  Buffer::Iterator temporal_it = it;
-
-  // Find the size/length of the message by counting the number of characters 
-  // before the null terminator character is found. The null terminator character
-  // is also counted.
-  do
-    {
-      character_read = temporal_it.ReadU8 ();
-      ++message_size;
-    }
-  while (character_read != 0u);
-
-  // Read the message-size characters from the iterator-buffer.
-  char message_buffer [message_size];
-  it.Read ((uint8_t *) message_buffer, message_size);
-
-  // Store the message in a C++ std::string.
-  m_message = std::string (message_buffer);
+  // Read the string message (including its null terminator character).
+  m_message.Read (it);
 
   uint32_t distance = it.GetDistanceFrom (start);
   NS_ASSERT (distance == GetSerializedSize ());
   return distance;
 }
 
+
+
+// --------------------------
+// Compact encoding
+// --------------------------
+
+uint32_t
+DataHeader::GetCompactDataSerializedSize () const
+{
+  // 1 byte of flags, 6 bytes of DATA ID, 4 bytes of temporal scope and 1 byte
+  // of the null terminator of the message.
+  return 12u + GetVarIntSerializedSize (m_hops_count)
+          + CompactCoordinatesEncoding::GetPositionSerializedSize (m_position)
+          + CompactCoordinatesEncoding::GetVelocitySerializedSize (m_velocity)
+          + CompactCoordinatesEncoding::GetAreaSerializedSize (m_dest_geo_temporal_area.GetArea ())
+          + m_message.Size ();
+}
+
+void
+DataHeader::SerializeCompactData (Buffer::Iterator& it) const
+{
+  uint8_t other_flags = 0u;
+  if (m_emergency_flag) SetBitFlag (other_flags, EMERGENCY);
+
+  it.WriteU8 (other_flags);
+  it.WriteHtonU16 (m_data_id.GetSourceId ());
+
+  WriteTo (it, m_data_id.GetSourceIp ());
+
+  WriteVarInt (it, m_hops_count);
+
+  CompactCoordinatesEncoding::WritePosition (it, m_position);
+  CompactCoordinatesEncoding::WriteVelocity (it, m_velocity);
+  CompactCoordinatesEncoding::WriteArea (it, m_dest_geo_temporal_area.GetArea ());
+
+  it.WriteHtonU16 ((uint32_t) m_dest_geo_temporal_area.GetTimePeriod ().GetStartTime ().GetSeconds ());
+  it.WriteHtonU16 ((uint32_t) m_dest_geo_temporal_area.GetDuration ().GetSeconds ());
+
+  m_message.Write (it);
+}
+
+void
+DataHeader::DeserializeCompactData (Buffer::Iterator& it)
+{
+  const uint8_t other_flags = it.ReadU8 ();
+  m_emergency_flag = CheckBitFlag (other_flags, EMERGENCY);
+
+  // Read DATA packet ID
+  const uint16_t data_source_id = it.ReadNtohU16 ();
+  Ipv4Address data_source_ip;
+  ReadFrom (it, data_source_ip);
+
+  m_data_id = DataIdentifier (data_source_ip, data_source_id);
+
+  m_hops_count = (uint32_t) ReadVarInt (it);
+
+  m_position = CompactCoordinatesEncoding::ReadPosition (it);
+  m_velocity = CompactCoordinatesEncoding::ReadVelocity (it);
+  const Area area = CompactCoordinatesEncoding::ReadArea (it);
+
+  // Read temporal scope's start time and duration. Then calculate end time.
+  Time start_time = Seconds (it.ReadNtohU16 ());
+  Time duration = Seconds (it.ReadNtohU16 ());
+  Time end_time = TimePeriod::CalculateEndTime (start_time, duration);
+
+  m_dest_geo_temporal_area = GeoTemporalArea (TimePeriod (start_time, end_time), area);
+
+  // Read the string message (including its null terminator character).
+  m_message.Read (it);
+}
+
 void
 DataHeader::Print (std::ostream& os) const
 {
@@ -835,12 +1202,40 @@ DataHeader::ToString () const
   std::sprintf (buffer, "%04.2f", m_dest_geo_temporal_area.GetDuration ().GetSeconds ());
   str += " with a duration of " + std::string (buffer) + " seconds";
 
-  std::sprintf (buffer, "%u", (uint32_t) m_message.size ());
+  std::sprintf (buffer, "%u", m_message.Size ());
   str += " has a message of " + std::string (buffer) + " byte(s)";
   return str;
 }
 
 
+// =============================================================================
+//                              CompactDataHeader
+// =============================================================================
+
+NS_OBJECT_ENSURE_REGISTERED (CompactDataHeader);
+
+CompactDataHeader::CompactDataHeader ()
+: DataHeader ()
+{
+  SetCompactEncoding (true);
+}
+
+
+// --------------------------
+// Type ID
+// --------------------------
+
+TypeId
+CompactDataHeader::GetTypeId ()
+{
+  static TypeId type_id = TypeId ("ns3::geotemporal::CompactDataHeader")
+          .SetParent<DataHeader> ()
+          .SetGroupName ("Geotemporal")
+          .AddConstructor<CompactDataHeader> ();
+  return type_id;
+}
+
+
 // =============================================================================
 //                                 DataAckHeader
 // =============================================================================
@@ -899,6 +1294,9 @@ DataAckHeader::GetTypeId ()
 TypeId
 DataAckHeader::GetInstanceTypeId () const
 {
+  if (IsCompactEncoding ())
+    return CompactDataAckHeader::GetTypeId ();
+
   return GetTypeId ();
 }
 
@@ -910,12 +1308,24 @@ DataAckHeader::GetInstanceTypeId () const
 uint32_t
 DataAckHeader::GetSerializedSize () const
 {
-  return 80u + m_message.size (); // 1 byte is because of the null terminator of the message.
+  if (m_compact_encoding)
+    return 6u + GetCompactDataSerializedSize ();
+
+  return 80u + m_message.Size (); // 1 byte is because of the null terminator of the message.
 }
 
 void
 DataAckHeader::Serialize (Buffer::Iterator start) const
 {
+  if (m_compact_encoding)
+    {
+      start.WriteHtonU16 (m_data_id_to_ack.GetSourceId ());
+      WriteTo (start, m_data_id_to_ack.GetSourceIp ());
+
+      SerializeCompactData (start);
+      return;
+    }
+
   uint8_t sign_flags = 0u;
 
   uint32_t position_x_int, position_x_float;
@@ -987,10 +1397,7 @@ DataAckHeader::Serialize (Buffer::Iterator start) const
   start.WriteHtonU16 ((uint32_t) m_dest_geo_temporal_area.GetTimePeriod ().GetStartTime ().GetSeconds ());
   start.WriteHtonU16 ((uint32_t) m_dest_geo_temporal_area.GetDuration ().GetSeconds ());
 
-  const uint32_t message_length = m_message.length () + 1u;
-  char chars_buffer [message_length];
-  std::strcpy (chars_buffer, m_message.c_str ());
-  start.Write ((uint8_t *) chars_buffer, message_length);
+  m_message.Write (start);
 }
 
 uint32_t
@@ -998,6 +1405,22 @@ DataAckHeader::Deserialize (Buffer::Iterator start)
 {
   Buffer::Iterator it = start;
 
+  if (m_compact_encoding)
+    {
+      // Read acknowledged DATA packet ID
+      const uint16_t data_source_id = it.ReadNtohU16 ();
+      Ipv4Address data_source_ip;
+      ReadFrom (it, data_source_ip);
+
+      m_data_id_to_ack = DataIdentifier (data_source_ip, data_source_id);
+
+      DeserializeCompactData (it);
+
+      uint32_t distance = it.GetDistanceFrom (start);
+      NS_ASSERT (distance == GetSerializedSize ());
+      return distance;
+    }
+
   const uint8_t sign_flags = it.ReadU8 ();
 
   // Read acknowledged DATA packet ID
@@ -1062,27 +1485,8 @@ DataAckHeader::Deserialize (Buffer::Iterator start)
   m_dest_geo_temporal_area = GeoTemporalArea (TimePeriod (start_time, end_time),
                                               Area (area_x1, area_y1, area_x2, area_y2));
 
-  // Read the string message.
-  uint8_t character_read = 0u;
-  uint32_t message_size = 0u;
-  Buffer::Iterator temporal_it = it;
-
-  // Find the size/length of the message by counting the number of characters 
-  // before the null terminator character is found. The null terminator character
-  // is also counted.
-  do
-    {
-      character_read = temporal_it.ReadU8 ();
-      ++message_size;
-    }
-  while (character_read != 0u);
-
-  // Read the message-size characters from the iterator-buffer.
-  char message_buffer [message_size];
-  it.Read ((uint8_t *) message_buffer, message_size);
-
-  // Store the message in a C++ std::string.
-  m_message = std::string (message_buffer);
+  // Read the string message (including its null terminator character).
+  m_message.Read (it);
 
   uint32_t distance = it.GetDistanceFrom (start);
   NS_ASSERT (distance == GetSerializedSize ());
@@ -1116,12 +1520,386 @@ DataAckHeader::ToString () const
   std::sprintf (buffer, "%04.2f", m_dest_geo_temporal_area.GetDuration ().GetSeconds ());
   str += " with a duration of " + std::string (buffer) + " seconds";
 
-  std::sprintf (buffer, "%u", (uint32_t) m_message.size ());
+  std::sprintf (buffer, "%u", m_message.Size ());
   str += " has a message of " + std::string (buffer) + " byte(s)";
   return str;
 }
 
 
+// =============================================================================
+//                            CompactDataAckHeader
+// =============================================================================
+
+NS_OBJECT_ENSURE_REGISTERED (CompactDataAckHeader);
+
+CompactDataAckHeader::CompactDataAckHeader ()
+: DataAckHeader ()
+{
+  SetCompactEncoding (true);
+}
+
+
+// --------------------------
+// Type ID
+// --------------------------
+
+TypeId
+CompactDataAckHeader::GetTypeId ()
+{
+  static TypeId type_id = TypeId ("ns3::geotemporal::CompactDataAckHeader")
+          .SetParent<DataAckHeader> ()
+          .SetGroupName ("Geotemporal")
+          .AddConstructor<CompactDataAckHeader> ();
+  return type_id;
+}
+
+
+// =============================================================================
+//                             AggregatedDataHeader
+// =============================================================================
+
+NS_OBJECT_ENSURE_REGISTERED (AggregatedDataHeader);
+
+const uint32_t AggregatedDataHeader::MAX_DATA_PACKETS = 255u;
+
+AggregatedDataHeader::AggregatedDataHeader ()
+: m_data_packets (), m_compact_encoding (false) { }
+
+AggregatedDataHeader::AggregatedDataHeader (const AggregatedDataHeader& copy)
+: m_data_packets (copy.m_data_packets),
+m_compact_encoding (copy.m_compact_encoding) { }
+
+
+// --------------------------
+// Getters & Setters
+// --------------------------
+
+void
+AggregatedDataHeader::AddDataPacket (const DataHeader& data_packet)
+{
+  if (m_data_packets.size () >= MAX_DATA_PACKETS)
+    throw std::out_of_range ("The AGGREGATED_DATA frame is full.");
+
+  m_data_packets.push_back (data_packet);
+  m_data_packets.back ().SetCompactEncoding (m_compact_encoding);
+}
+
+void
+AggregatedDataHeader::SetCompactEncoding (bool compact_encoding)
+{
+  m_compact_encoding = compact_encoding;
+
+  for (std::vector<DataHeader>::iterator it = m_data_packets.begin ();
+          it != m_data_packets.end (); ++it)
+    {
+      it->SetCompactEncoding (compact_encoding);
+    }
+}
+
+
+// --------------------------
+// Type ID
+// --------------------------
+
+TypeId
+AggregatedDataHeader::GetTypeId ()
+{
+  static TypeId type_id = TypeId ("ns3::geotemporal::AggregatedDataHeader")
+          .SetParent<Header> ()
+          .SetGroupName ("Geotemporal")
+          .AddConstructor<AggregatedDataHeader> ();
+  return type_id;
+}
+
+TypeId
+AggregatedDataHeader::GetInstanceTypeId () const
+{
+  if (IsCompactEncoding ())
+    return CompactAggregatedDataHeader::GetTypeId ();
+
+  return GetTypeId ();
+}
+
+
+// --------------------------
+// Header serialization/deserialization
+// --------------------------
+
+uint32_t
+AggregatedDataHeader::GetSerializedSize () const
+{
+  uint32_t size = 1u;
+
+  for (std::vector<DataHeader>::const_iterator it = m_data_packets.begin ();
+          it != m_data_packets.end (); ++it)
+    {
+      size += it->GetSerializedSize ();
+    }
+
+  return size;
+}
+
+void
+AggregatedDataHeader::Serialize (Buffer::Iterator start) const
+{
+  start.WriteU8 ((uint8_t) m_data_packets.size ());
+
+  for (std::vector<DataHeader>::const_iterator it = m_data_packets.begin ();
+          it != m_data_packets.end (); ++it)
+    {
+      it->Serialize (start);
+      start.Next (it->GetSerializedSize ());
+    }
+}
+
+uint32_t
+AggregatedDataHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator it = start;
+
+  const uint8_t data_packets_count = it.ReadU8 ();
+
+  m_data_packets.clear ();
+  m_data_packets.reserve (data_packets_count);
+
+  for (uint32_t i = 0u; i < data_packets_count; ++i)
+    {
+      DataHeader data_packet;
+      data_packet.SetCompactEncoding (m_compact_encoding);
+
+      it.Next (data_packet.Deserialize (it));
+      m_data_packets.push_back (data_packet);
+    }
+
+  uint32_t distance = it.GetDistanceFrom (start);
+  NS_ASSERT (distance == GetSerializedSize ());
+  return distance;
+}
+
+void
+AggregatedDataHeader::Print (std::ostream& os) const
+{
+  os << ToString ();
+}
+
+std::string
+AggregatedDataHeader::ToString () const
+{
+  char buffer[10];
+  std::sprintf (buffer, "%u", (uint32_t) m_data_packets.size ());
+
+  std::string str = "AGGREGATED_DATA frame of " + std::string (buffer)
+          + " DATA packet(s)";
+
+  for (std::vector<DataHeader>::const_iterator it = m_data_packets.begin ();
+          it != m_data_packets.end (); ++it)
+    {
+      str += (it == m_data_packets.begin () ? ": " : ", ")
+              + it->GetDataIdentifier ().ToString ();
+    }
+
+  return str;
+}
+
+
+// =============================================================================
+//                         CompactAggregatedDataHeader
+// =============================================================================
+
+NS_OBJECT_ENSURE_REGISTERED (CompactAggregatedDataHeader);
+
+CompactAggregatedDataHeader::CompactAggregatedDataHeader ()
+: AggregatedDataHeader ()
+{
+  SetCompactEncoding (true);
+}
+
+
+// --------------------------
+// Type ID
+// --------------------------
+
+TypeId
+CompactAggregatedDataHeader::GetTypeId ()
+{
+  static TypeId type_id = TypeId ("ns3::geotemporal::CompactAggregatedDataHeader")
+          .SetParent<AggregatedDataHeader> ()
+          .SetGroupName ("Geotemporal")
+          .AddConstructor<CompactAggregatedDataHeader> ();
+  return type_id;
+}
+
+
+// =============================================================================
+//                              AggregatedAckHeader
+// =============================================================================
+
+NS_OBJECT_ENSURE_REGISTERED (AggregatedAckHeader);
+
+AggregatedAckHeader::AggregatedAckHeader ()
+: AckHeader (), m_received_packets () { }
+
+AggregatedAckHeader::AggregatedAckHeader (const DataIdentifier& first_data_identifier,
+                                          const std::vector<bool>& received_packets,
+                                          const GeoTemporalLibrary::LibraryUtils::Vector2D& position,
+                                          const GeoTemporalLibrary::LibraryUtils::Vector2D& velocity)
+: AckHeader (first_data_identifier, position, velocity), m_received_packets ()
+{
+  SetReceivedPackets (received_packets);
+}
+
+AggregatedAckHeader::AggregatedAckHeader (const AggregatedAckHeader& copy)
+: AckHeader (copy), m_received_packets (copy.m_received_packets) { }
+
+
+// --------------------------
+// Getters & Setters
+// --------------------------
+
+void
+AggregatedAckHeader::SetReceivedPackets (const std::vector<bool>& received_packets)
+{
+  if (received_packets.size () > AggregatedDataHeader::MAX_DATA_PACKETS)
+    throw std::out_of_range ("Too many DATA packets to acknowledge.");
+
+  m_received_packets = received_packets;
+}
+
+
+// --------------------------
+// Type ID
+// --------------------------
+
+TypeId
+AggregatedAckHeader::GetTypeId ()
+{
+  static TypeId type_id = TypeId ("ns3::geotemporal::AggregatedAckHeader")
+          .SetParent<AckHeader> ()
+          .SetGroupName ("Geotemporal")
+          .AddConstructor<AggregatedAckHeader> ();
+  return type_id;
+}
+
+TypeId
+AggregatedAckHeader::GetInstanceTypeId () const
+{
+  if (IsCompactEncoding ())
+    return CompactAggregatedAckHeader::GetTypeId ();
+
+  return GetTypeId ();
+}
+
+
+// --------------------------
+// Header serialization/deserialization
+// --------------------------
+
+uint32_t
+AggregatedAckHeader::GetSerializedSize () const
+{
+  return AckHeader::GetSerializedSize () + 1u
+          + (m_received_packets.size () + 7u) / 8u;
+}
+
+void
+AggregatedAckHeader::Serialize (Buffer::Iterator start) const
+{
+  AckHeader::Serialize (start);
+  start.Next (AckHeader::GetSerializedSize ());
+
+  start.WriteU8 ((uint8_t) m_received_packets.size ());
+
+  uint8_t bitmap_byte = 0u;
+
+  for (uint32_t i = 0u; i < m_received_packets.size (); ++i)
+    {
+      if (m_received_packets[i])
+        bitmap_byte |= (uint8_t) (0x80u >> (i % 8u));
+
+      if (i % 8u == 7u || i + 1u == m_received_packets.size ())
+        {
+          start.WriteU8 (bitmap_byte);
+          bitmap_byte = 0u;
+        }
+    }
+}
+
+uint32_t
+AggregatedAckHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator it = start;
+
+  it.Next (AckHeader::Deserialize (it));
+
+  const uint8_t data_packets_count = it.ReadU8 ();
+  m_received_packets.assign (data_packets_count, false);
+
+  uint8_t bitmap_byte = 0u;
+
+  for (uint32_t i = 0u; i < data_packets_count; ++i)
+    {
+      if (i % 8u == 0u)
+        bitmap_byte = it.ReadU8 ();
+
+      m_received_packets[i] = (bitmap_byte & (0x80u >> (i % 8u))) != 0u;
+    }
+
+  uint32_t distance = it.GetDistanceFrom (start);
+  NS_ASSERT (distance == GetSerializedSize ());
+  return distance;
+}
+
+void
+AggregatedAckHeader::Print (std::ostream& os) const
+{
+  os << ToString ();
+}
+
+std::string
+AggregatedAckHeader::ToString () const
+{
+  std::string bitmap = "";
+
+  for (std::vector<bool>::const_iterator it = m_received_packets.begin ();
+          it != m_received_packets.end (); ++it)
+    {
+      bitmap += *it ? '1' : '0';
+    }
+
+  return "AGGREGATED_ACK of frame starting at " + GetDataIdentifier ().ToString ()
+          + " with bitmap [" + bitmap + "] from position " + GetPosition ().ToString ()
+          + " at velocity " + GetVelocity ().ToString ();
+}
+
+
+// =============================================================================
+//                         CompactAggregatedAckHeader
+// =============================================================================
+
+NS_OBJECT_ENSURE_REGISTERED (CompactAggregatedAckHeader);
+
+CompactAggregatedAckHeader::CompactAggregatedAckHeader ()
+: AggregatedAckHeader ()
+{
+  SetCompactEncoding (true);
+}
+
+
+// --------------------------
+// Type ID
+// --------------------------
+
+TypeId
+CompactAggregatedAckHeader::GetTypeId ()
+{
+  static TypeId type_id = TypeId ("ns3::geotemporal::CompactAggregatedAckHeader")
+          .SetParent<AggregatedAckHeader> ()
+          .SetGroupName ("Geotemporal")
+          .AddConstructor<CompactAggregatedAckHeader> ();
+  return type_id;
+}
+
+
 } // namespace geotemporal
 } // namespace ns3
 
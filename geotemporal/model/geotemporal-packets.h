@@ -27,6 +27,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include <ns3/geotemporal-utils.h>
 #include <ns3/math-utils.h>
@@ -34,6 +35,7 @@
 
 #include <ns3/header.h>
 #include <ns3/ipv4-address.h>
+#include <ns3/ptr.h>
 #include <ns3/type-id.h>
 
 using namespace GeoTemporalLibrary::LibraryUtils;
@@ -89,6 +91,17 @@ using GeoTemporalLibrary::LibraryUtils::Vector2D;
  * 6. DATA_ACK packet: the combination of a DATA packet and an ACK packet. It
  *    carries data while acknowledging that another DATA packet as successfully
  *    received.
+ * 
+ * 7. AGGREGATED_DATA packet: several DATA packets transmitted in one frame to
+ *    the same neighbor, to amortize the per-frame overhead.
+ * 
+ * 8. AGGREGATED_ACK packet: acknowledges an AGGREGATED_DATA frame with a bitmap
+ *    of the DATA packets of the frame that were successfully received.
+ * 
+ * 9. RESYNC_REQUEST packet: answer to a REPLY with the incremental summary
+ *    vector encoding whose changes couldn't be applied by the receiver. It asks
+ *    the REPLY sender to send its whole summary vector again. It only contains
+ *    the Type header.
  */
 enum class PacketType : uint8_t
 {
@@ -97,7 +110,10 @@ enum class PacketType : uint8_t
   ReplyBack = 2, //< Response to a REPLY packet. Also called REQUEST.
   Ack = 3, //< Acknowledges that a DATA packet was successfully received.
   Data = 4, //< Actual data packet.
-  DataAck = 5 //< Contains DATA and indicates that a DATA packet was successfully received.
+  DataAck = 5, //< Contains DATA and indicates that a DATA packet was successfully received.
+  AggregatedData = 6, //< Contains several DATA packets sent in one frame.
+  AggregatedAck = 7, //< Acknowledges with a bitmap the DATA packets of an AGGREGATED_DATA frame.
+  ResyncRequest = 8 //< Requests the whole summary vector after an incremental REPLY that couldn't be applied.
 };
 
 /**
@@ -123,6 +139,13 @@ operator<< (std::ostream & os, const PacketType & obj)
  * \ingroup geotemporal
  * 
  * Header that contains the type of the Geo-Temporal protocol packets.
+ * 
+ * The most significant bit of the type byte indicates that the headers that
+ * follow carry their coordinates with the compact encoding (see
+ * <code>CompactCoordinatesEncoding</code>) instead of the fixed-size one. The
+ * next 2 bits contain the <code>SummaryVectorEncoding</code> of REPLY and 
+ * REPLY_BACK packets. A REPLY_BACK never uses the incremental encoding: the 
+ * whole summary vector is requested with a RESYNC_REQUEST packet instead.
  */
 class TypeHeader : public Header
 {
@@ -130,6 +153,12 @@ private:
 
   PacketType m_packet_type;
 
+  /** Indicates if the packet headers use the compact coordinates encoding. */
+  bool m_compact_encoding;
+
+  /** Encoding of the summary vector (only in REPLY and REPLY_BACK packets). */
+  SummaryVectorEncoding m_summary_vector_encoding;
+
   bool m_valid;
 
 
@@ -139,6 +168,11 @@ public:
 
   TypeHeader (PacketType packet_type);
 
+  TypeHeader (PacketType packet_type, bool compact_encoding);
+
+  TypeHeader (PacketType packet_type, bool compact_encoding,
+              SummaryVectorEncoding summary_vector_encoding);
+
   TypeHeader (const TypeHeader & copy);
 
 
@@ -158,6 +192,30 @@ public:
     m_packet_type = type;
   }
 
+  inline bool
+  IsCompactEncoding () const
+  {
+    return m_compact_encoding;
+  }
+
+  inline void
+  SetCompactEncoding (bool compact_encoding)
+  {
+    m_compact_encoding = compact_encoding;
+  }
+
+  inline SummaryVectorEncoding
+  GetSummaryVectorEncoding () const
+  {
+    return m_summary_vector_encoding;
+  }
+
+  inline void
+  SetSummaryVectorEncoding (SummaryVectorEncoding summary_vector_encoding)
+  {
+    m_summary_vector_encoding = summary_vector_encoding;
+  }
+
   inline bool
   IsValid () const
   {
@@ -207,7 +265,10 @@ public:
 inline bool
 operator== (const TypeHeader & lhs, const TypeHeader & rhs)
 {
-  return lhs.m_packet_type == rhs.m_packet_type && lhs.m_valid == rhs.m_valid;
+  return lhs.m_packet_type == rhs.m_packet_type
+          && lhs.m_compact_encoding == rhs.m_compact_encoding
+          && lhs.m_summary_vector_encoding == rhs.m_summary_vector_encoding
+          && lhs.m_valid == rhs.m_valid;
 }
 
 inline bool
@@ -239,17 +300,33 @@ operator<< (std::ostream & os, const TypeHeader & obj)
   0                   1                   2                   3
   0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-  |   TypeHeader  |    Reserved   | Number of cached DATA packets |
+  |   TypeHeader  |     Flags     | Number of cached DATA packets |
   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
   |               HELLO sender's Local IPv4 address               |
   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |              Summary vector digest (only if flag)             |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
   \endverbatim
+ * 
+ * When the digest flag is set, the HELLO header carries the order-independent
+ * digest of the summary vector of the sender node, so the receiver can skip 
+ * the anti-entropy session if none of the queues changed since the last one.
+ * 
+ * When the summary vector flag is set, the HELLO header is followed by a 
+ * <code>SummaryVectorHeader</code> with the summary vector of the sender node
+ * (two-way handshake), encoded with the <code>SummaryVectorEncoding</code> of
+ * the type header. The receiver can then answer directly with a REPLY_BACK or
+ * DATA packets, without a REPLY.
  */
 class HelloHeader : public Header
 {
 private:
 
-  uint8_t m_reserved; // Not used
+  /**
+   * Flags. Bit 0 indicates that a summary vector header follows the HELLO 
+   * header. Bit 1 indicates that the summary vector digest is present.
+   */
+  uint8_t m_flags;
 
   /** Size of the summary vector. */
   uint16_t m_summary_vector_size;
@@ -257,6 +334,9 @@ private:
   /** IPv4 address of the node that sent the HELLO packet. */
   Ipv4Address m_sender_node_ip;
 
+  /** Digest of the summary vector of the sender node. */
+  uint32_t m_summary_vector_digest;
+
 
 public:
 
@@ -283,6 +363,36 @@ public:
     m_summary_vector_size = summary_vector_size;
   }
 
+  /**
+   * Returns <code>true</code> if a <code>SummaryVectorHeader</code> with the
+   * summary vector of the sender node follows the HELLO header.
+   */
+  bool
+  HasSummaryVector () const;
+
+  void
+  SetSummaryVectorFlag (bool summary_vector_flag);
+
+  /**
+   * Returns <code>true</code> if the HELLO header carries the digest of the
+   * summary vector of the sender node.
+   */
+  bool
+  HasSummaryVectorDigest () const;
+
+  inline uint32_t
+  GetSummaryVectorDigest () const
+  {
+    return m_summary_vector_digest;
+  }
+
+  /**
+   * Sets the digest of the summary vector of the sender node, and the flag
+   * that indicates that the HELLO header carries it.
+   */
+  void
+  SetSummaryVectorDigest (uint32_t summary_vector_digest);
+
   inline const Ipv4Address &
   GetSenderNodeIp () const
   {
@@ -340,7 +450,8 @@ operator== (const HelloHeader & lhs, const HelloHeader & rhs)
 {
   return lhs.m_sender_node_ip == rhs.m_sender_node_ip
           && lhs.m_summary_vector_size == rhs.m_summary_vector_size
-          && lhs.m_reserved == rhs.m_reserved;
+          && lhs.m_flags == rhs.m_flags
+          && lhs.m_summary_vector_digest == rhs.m_summary_vector_digest;
 }
 
 inline bool
@@ -402,6 +513,18 @@ operator<< (std::ostream & os, const HelloHeader & obj)
   [1] = If the DATA ID index is odd.
   [2] = If the DATA ID index is even.
   \endverbatim
+ * 
+ * With the compact coordinates encoding, the sign flags are omitted and
+ * the position and velocity are written as variable-length fixed-point
+ * integers (see <code>CompactCoordinatesEncoding</code>) right after the size
+ * of the summary vector.
+ * 
+ * The list of data identifiers is replaced by the delta-coded list or the Bloom
+ * filter according to the <code>SummaryVectorEncoding</code> of the header.
+ * With a Bloom filter, the size field contains the number of identifiers 
+ * inserted in the filter. With the incremental encoding, the list is replaced
+ * by the base version and the version (variable-length integers), and the 
+ * delta-coded lists of inserted and removed identifiers.
  */
 class SummaryVectorHeader : public Header
 {
@@ -416,6 +539,42 @@ private:
   /** Velocity vector of the packet sender node. */
   GeoTemporalLibrary::LibraryUtils::Vector2D m_velocity;
 
+  /** Indicates if the header uses the compact coordinates encoding. */
+  bool m_compact_encoding;
+
+  /** Encoding of the summary vector. */
+  SummaryVectorEncoding m_summary_vector_encoding;
+
+  /** Bloom filter of the summary vector (only with the Bloom filter encoding). */
+  DataIdentifierBloomFilter m_bloom_filter;
+
+  /** Number of identifiers inserted in the Bloom filter. */
+  uint16_t m_bloom_filter_entries_count;
+
+  /**
+   * Version of the summary vector that the changes are based on (only with the
+   * incremental encoding). 0 means that the whole summary vector is sent.
+   */
+  uint32_t m_base_version;
+
+  /** Version of the summary vector (only with the incremental encoding). */
+  uint32_t m_version;
+
+  /** Identifiers removed since the base version (only with the incremental encoding). */
+  std::set<DataIdentifier> m_removed_packets;
+
+  /** Returns the size (in bytes) of the encoded identifiers of the summary vector. */
+  uint32_t
+  GetSummaryVectorSerializedSize () const;
+
+  /** Writes the identifiers of the summary vector. */
+  void
+  SerializeSummaryVector (Buffer::Iterator & start) const;
+
+  /** Reads <code>summary_vector_size</code> identifiers of the summary vector. */
+  void
+  DeserializeSummaryVector (Buffer::Iterator & it, uint16_t summary_vector_size);
+
 
 public:
 
@@ -432,9 +591,16 @@ public:
   // Getters & Setters
   // --------------------------
 
+  /**
+   * Returns the number of data identifiers of the summary vector. With the 
+   * Bloom filter encoding it is the number of identifiers in the filter.
+   */
   inline uint32_t
   GetSummaryVectorSize () const
   {
+    if (m_summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+      return m_bloom_filter_entries_count;
+
     return m_summary_vector.size ();
   }
 
@@ -474,6 +640,95 @@ public:
     m_velocity = velocity;
   }
 
+  /**
+   * Sets if this header is serialized and deserialized with the compact
+   * coordinates encoding. The default is the fixed-size encoding.
+   */
+  inline void
+  SetCompactEncoding (bool compact_encoding)
+  {
+    m_compact_encoding = compact_encoding;
+  }
+
+  inline bool
+  IsCompactEncoding () const
+  {
+    return m_compact_encoding;
+  }
+
+  inline SummaryVectorEncoding
+  GetSummaryVectorEncoding () const
+  {
+    return m_summary_vector_encoding;
+  }
+
+  /**
+   * Sets the encoding used to serialize and deserialize the summary vector. 
+   * The default is <code>SummaryVectorEncoding::Explicit</code>.
+   */
+  inline void
+  SetSummaryVectorEncoding (SummaryVectorEncoding summary_vector_encoding)
+  {
+    m_summary_vector_encoding = summary_vector_encoding;
+  }
+
+  inline const DataIdentifierBloomFilter &
+  GetBloomFilter () const
+  {
+    return m_bloom_filter;
+  }
+
+  /**
+   * Sets the Bloom filter of the summary vector that is transmitted with the
+   * Bloom filter encoding, and the number of identifiers inserted in it.
+   */
+  inline void
+  SetBloomFilter (const DataIdentifierBloomFilter & bloom_filter, uint16_t entries_count)
+  {
+    m_bloom_filter = bloom_filter;
+    m_bloom_filter_entries_count = entries_count;
+  }
+
+  inline uint32_t
+  GetBaseVersion () const
+  {
+    return m_base_version;
+  }
+
+  inline uint32_t
+  GetVersion () const
+  {
+    return m_version;
+  }
+
+  /**
+   * Sets the versions transmitted with the incremental encoding: the version of
+   * the summary vector that the changes are based on (0 if the summary vector 
+   * holds the whole summary vector), and the version after the changes.
+   */
+  inline void
+  SetVersions (uint32_t base_version, uint32_t version)
+  {
+    m_base_version = base_version;
+    m_version = version;
+  }
+
+  /**
+   * Returns the identifiers removed since the base version. With the 
+   * incremental encoding the summary vector holds the inserted identifiers.
+   */
+  inline const std::set<DataIdentifier> &
+  GetRemovedPackets () const
+  {
+    return m_removed_packets;
+  }
+
+  inline void
+  SetRemovedPackets (const std::set<DataIdentifier> & removed_packets)
+  {
+    m_removed_packets = removed_packets;
+  }
+
 
   // --------------------------
   // Type ID
@@ -519,7 +774,13 @@ operator== (const SummaryVectorHeader & lhs, const SummaryVectorHeader & rhs)
 {
   return lhs.m_summary_vector == rhs.m_summary_vector
           && lhs.m_position == rhs.m_position
-          && lhs.m_velocity == rhs.m_velocity;
+          && lhs.m_velocity == rhs.m_velocity
+          && lhs.m_summary_vector_encoding == rhs.m_summary_vector_encoding
+          && lhs.m_bloom_filter == rhs.m_bloom_filter
+          && lhs.m_bloom_filter_entries_count == rhs.m_bloom_filter_entries_count
+          && lhs.m_base_version == rhs.m_base_version
+          && lhs.m_version == rhs.m_version
+          && lhs.m_removed_packets == rhs.m_removed_packets;
 }
 
 inline bool
@@ -538,6 +799,36 @@ operator<< (std::ostream & os, const SummaryVectorHeader & obj)
 }
 
 
+// =============================================================================
+//                         CompactSummaryVectorHeader
+// =============================================================================
+
+/**
+ * \ingroup geotemporal
+ * 
+ * SUMMARY VECTOR packet header with the compact coordinates encoding.
+ * 
+ * <code>SummaryVectorHeader::GetInstanceTypeId</code> returns the type ID of
+ * this class when the compact encoding is set, so the packet metadata (that
+ * recreates the headers with their default constructor) deserializes and
+ * prints compact headers correctly.
+ */
+class CompactSummaryVectorHeader : public SummaryVectorHeader
+{
+public:
+
+  CompactSummaryVectorHeader ();
+
+
+  // --------------------------
+  // Type ID
+  // --------------------------
+
+  static TypeId
+  GetTypeId ();
+};
+
+
 // =============================================================================
 //                                   AckHeader
 // =============================================================================
@@ -568,6 +859,9 @@ operator<< (std::ostream & os, const SummaryVectorHeader & obj)
   |           ACK sender's y-coordinate velocity vector           |
   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
   \endverbatim
+ * 
+ * With the compact coordinates encoding, the flags byte is omitted and the
+ * position and velocity are written as variable-length fixed-point integers.
  */
 class AckHeader : public Header
 {
@@ -582,6 +876,9 @@ private:
   /** Velocity vector of the packet sender node. */
   GeoTemporalLibrary::LibraryUtils::Vector2D m_velocity;
 
+  /** Indicates if the header uses the compact coordinates encoding. */
+  bool m_compact_encoding;
+
 
 public:
 
@@ -634,6 +931,22 @@ public:
     m_velocity = velocity;
   }
 
+  /**
+   * Sets if this header is serialized and deserialized with the compact
+   * coordinates encoding. The default is the fixed-size encoding.
+   */
+  inline void
+  SetCompactEncoding (bool compact_encoding)
+  {
+    m_compact_encoding = compact_encoding;
+  }
+
+  inline bool
+  IsCompactEncoding () const
+  {
+    return m_compact_encoding;
+  }
+
 
   // --------------------------
   // Type ID
@@ -698,6 +1011,36 @@ operator<< (std::ostream & os, const AckHeader & obj)
 }
 
 
+// =============================================================================
+//                              CompactAckHeader
+// =============================================================================
+
+/**
+ * \ingroup geotemporal
+ * 
+ * ACK packet header with the compact coordinates encoding.
+ * 
+ * <code>AckHeader::GetInstanceTypeId</code> returns the type ID of
+ * this class when the compact encoding is set, so the packet metadata (that
+ * recreates the headers with their default constructor) deserializes and
+ * prints compact headers correctly.
+ */
+class CompactAckHeader : public AckHeader
+{
+public:
+
+  CompactAckHeader ();
+
+
+  // --------------------------
+  // Type ID
+  // --------------------------
+
+  static TypeId
+  GetTypeId ();
+};
+
+
 // =============================================================================
 //                                  DataHeader
 // =============================================================================
@@ -752,6 +1095,11 @@ operator<< (std::ostream & os, const AckHeader & obj)
    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
    0                   1                   2                   3
   \endverbatim
+ * 
+ * With the compact coordinates encoding, the sign flags are omitted, the
+ * flags byte is written right after the TypeHeader, and the hops count,
+ * position, velocity and destination area are written as variable-length
+ * (fixed-point) integers. The rest of the fields keep their layout.
  */
 class DataHeader : public Header
 {
@@ -786,7 +1134,36 @@ protected:
   GeoTemporalArea m_dest_geo_temporal_area;
 
   /** Message to transmit (in bytes). Recommended maximum 1024 bytes. */
-  std::string m_message;
+  SharedMessage m_message;
+
+  /** Indicates if the header uses the compact coordinates encoding. */
+  bool m_compact_encoding;
+
+
+  // --------------------------
+  // Compact encoding
+  // --------------------------
+
+  /**
+   * Returns the size (in bytes) of the DATA fields when they are serialized
+   * with the compact coordinates encoding.
+   */
+  uint32_t
+  GetCompactDataSerializedSize () const;
+
+  /**
+   * Writes the DATA fields using the compact coordinates encoding. The
+   * iterator is advanced past the written bytes.
+   */
+  void
+  SerializeCompactData (Buffer::Iterator & it) const;
+
+  /**
+   * Reads the DATA fields using the compact coordinates encoding. The
+   * iterator is advanced past the read bytes.
+   */
+  void
+  DeserializeCompactData (Buffer::Iterator & it);
 
 
 public:
@@ -890,13 +1267,29 @@ public:
   inline const std::string &
   GetMessage () const
   {
-    return m_message;
+    return m_message.Get ();
   }
 
   inline void
   SetMessage (const std::string & message)
   {
-    m_message = message;
+    m_message = SharedMessage (message);
+  }
+
+  /**
+   * Sets if this header is serialized and deserialized with the compact
+   * coordinates encoding. The default is the fixed-size encoding.
+   */
+  inline void
+  SetCompactEncoding (bool compact_encoding)
+  {
+    m_compact_encoding = compact_encoding;
+  }
+
+  inline bool
+  IsCompactEncoding () const
+  {
+    return m_compact_encoding;
   }
 
 
@@ -967,6 +1360,36 @@ operator<< (std::ostream & os, const DataHeader & obj)
 }
 
 
+// =============================================================================
+//                              CompactDataHeader
+// =============================================================================
+
+/**
+ * \ingroup geotemporal
+ * 
+ * DATA packet header with the compact coordinates encoding.
+ * 
+ * <code>DataHeader::GetInstanceTypeId</code> returns the type ID of
+ * this class when the compact encoding is set, so the packet metadata (that
+ * recreates the headers with their default constructor) deserializes and
+ * prints compact headers correctly.
+ */
+class CompactDataHeader : public DataHeader
+{
+public:
+
+  CompactDataHeader ();
+
+
+  // --------------------------
+  // Type ID
+  // --------------------------
+
+  static TypeId
+  GetTypeId ();
+};
+
+
 // =============================================================================
 //                                 DataAckHeader
 // =============================================================================
@@ -1025,6 +1448,9 @@ operator<< (std::ostream & os, const DataHeader & obj)
    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
    0                   1                   2                   3
   \endverbatim
+ * 
+ * With the compact coordinates encoding, the ID of the packet to acknowledge
+ * is followed by the compact DATA fields (see <code>DataHeader</code>).
  */
 class DataAckHeader : public DataHeader
 {
@@ -1143,6 +1569,379 @@ operator<< (std::ostream & os, const DataAckHeader & obj)
 }
 
 
+// =============================================================================
+//                            CompactDataAckHeader
+// =============================================================================
+
+/**
+ * \ingroup geotemporal
+ * 
+ * DATA_ACK packet header with the compact coordinates encoding.
+ * 
+ * <code>DataAckHeader::GetInstanceTypeId</code> returns the type ID of
+ * this class when the compact encoding is set, so the packet metadata (that
+ * recreates the headers with their default constructor) deserializes and
+ * prints compact headers correctly.
+ */
+class CompactDataAckHeader : public DataAckHeader
+{
+public:
+
+  CompactDataAckHeader ();
+
+
+  // --------------------------
+  // Type ID
+  // --------------------------
+
+  static TypeId
+  GetTypeId ();
+};
+
+
+
+// =============================================================================
+//                             AggregatedDataHeader
+// =============================================================================
+
+/**
+ * \ingroup geotemporal
+ * 
+ * AGGREGATED_DATA packet header
+ * 
+  \verbatim
+   0                   1                   2                   3
+   0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |   TypeHeader  | DATA pkts (N) |          DATA packet 1        |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+                               +
+  |                              ...                              |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |                          DATA packet N                        |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+   0                   1                   2                   3
+  \endverbatim
+ * 
+ * Each DATA packet is serialized as a <code>DataHeader</code> (without its
+ * <code>TypeHeader</code>), using the compact coordinates encoding of the
+ * frame if it is set.
+ */
+class AggregatedDataHeader : public Header
+{
+public:
+
+  /** Maximum number of DATA packets that fit in one frame. */
+  static const uint32_t MAX_DATA_PACKETS;
+
+
+private:
+
+  /** DATA packets carried in the frame, in transmission order. */
+  std::vector<DataHeader> m_data_packets;
+
+  /** Indicates if the header uses the compact coordinates encoding. */
+  bool m_compact_encoding;
+
+
+public:
+
+  AggregatedDataHeader ();
+
+  AggregatedDataHeader (const AggregatedDataHeader & copy);
+
+
+  // --------------------------
+  // Getters & Setters
+  // --------------------------
+
+  inline const std::vector<DataHeader> &
+  GetDataPackets () const
+  {
+    return m_data_packets;
+  }
+
+  inline uint32_t
+  GetDataPacketsCount () const
+  {
+    return m_data_packets.size ();
+  }
+
+  /**
+   * Appends the given DATA packet to the frame.
+   * 
+   * Throws an <code>std::out_of_range</code> exception if the frame already
+   * contains <code>MAX_DATA_PACKETS</code> packets.
+   */
+  void
+  AddDataPacket (const DataHeader & data_packet);
+
+  /**
+   * Sets if this header and all the DATA packets that it contains are 
+   * serialized and deserialized with the compact coordinates encoding. The 
+   * default is the fixed-size encoding.
+   */
+  void
+  SetCompactEncoding (bool compact_encoding);
+
+  inline bool
+  IsCompactEncoding () const
+  {
+    return m_compact_encoding;
+  }
+
+
+  // --------------------------
+  // Type ID
+  // --------------------------
+
+  static TypeId
+  GetTypeId ();
+
+  TypeId
+  GetInstanceTypeId () const;
+
+
+  // --------------------------
+  // Header serialization/deserialization
+  // --------------------------
+
+  uint32_t
+  GetSerializedSize () const override;
+
+  void
+  Serialize (Buffer::Iterator start) const override;
+
+  uint32_t
+  Deserialize (Buffer::Iterator start) override;
+
+  void
+  Print (std::ostream &os) const override;
+
+
+  /**
+   * Returns a <code>string</code> object containing the representation of this
+   * instance as a sequence of characters.
+   */
+  std::string ToString () const;
+
+  friend bool operator== (const AggregatedDataHeader & lhs,
+                          const AggregatedDataHeader & rhs);
+};
+
+// AggregatedDataHeader relational operators
+
+inline bool
+operator== (const AggregatedDataHeader & lhs, const AggregatedDataHeader & rhs)
+{
+  return lhs.m_data_packets == rhs.m_data_packets;
+}
+
+inline bool
+operator!= (const AggregatedDataHeader & lhs, const AggregatedDataHeader & rhs)
+{
+  return !operator== (lhs, rhs);
+}
+
+// AggregatedDataHeader stream operators
+
+inline std::ostream &
+operator<< (std::ostream & os, const AggregatedDataHeader & obj)
+{
+  obj.Print (os);
+  return os;
+}
+
+
+// =============================================================================
+//                         CompactAggregatedDataHeader
+// =============================================================================
+
+/**
+ * \ingroup geotemporal
+ * 
+ * AGGREGATED_DATA packet header with the compact coordinates encoding.
+ * 
+ * <code>AggregatedDataHeader::GetInstanceTypeId</code> returns the type ID of
+ * this class when the compact encoding is set, so the packet metadata (that
+ * recreates the headers with their default constructor) deserializes and
+ * prints compact headers correctly.
+ */
+class CompactAggregatedDataHeader : public AggregatedDataHeader
+{
+public:
+
+  CompactAggregatedDataHeader ();
+
+
+  // --------------------------
+  // Type ID
+  // --------------------------
+
+  static TypeId
+  GetTypeId ();
+};
+
+
+// =============================================================================
+//                              AggregatedAckHeader
+// =============================================================================
+
+/**
+ * \ingroup geotemporal
+ * 
+ * AGGREGATED_ACK packet header
+ * 
+  \verbatim
+   0                   1                   2                   3
+   0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |                     ACK packet header ...                     |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  | DATA pkts (N) |          Received bitmap (ceil (N / 8) bytes) |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+   0                   1                   2                   3
+  \endverbatim
+ * 
+ * The data identifier of the ACK fields is the identifier of the first DATA
+ * packet of the acknowledged AGGREGATED_DATA frame. Bit i of the bitmap (in
+ * most significant bit first order) is set if the i-th DATA packet of the
+ * frame was successfully received.
+ */
+class AggregatedAckHeader : public AckHeader
+{
+private:
+
+  /** Reception flags of the DATA packets of the acknowledged frame. */
+  std::vector<bool> m_received_packets;
+
+
+public:
+
+  AggregatedAckHeader ();
+
+  AggregatedAckHeader (const DataIdentifier & first_data_identifier,
+                       const std::vector<bool> & received_packets,
+                       const GeoTemporalLibrary::LibraryUtils::Vector2D & position,
+                       const GeoTemporalLibrary::LibraryUtils::Vector2D & velocity);
+
+  AggregatedAckHeader (const AggregatedAckHeader & copy);
+
+
+  // --------------------------
+  // Getters & Setters
+  // --------------------------
+
+  inline const std::vector<bool> &
+  GetReceivedPackets () const
+  {
+    return m_received_packets;
+  }
+
+  /**
+   * Sets the reception flags of the DATA packets of the acknowledged frame.
+   * 
+   * Throws an <code>std::out_of_range</code> exception if there are more flags
+   * than <code>AggregatedDataHeader::MAX_DATA_PACKETS</code>.
+   */
+  void
+  SetReceivedPackets (const std::vector<bool> & received_packets);
+
+
+  // --------------------------
+  // Type ID
+  // --------------------------
+
+  static TypeId
+  GetTypeId ();
+
+  TypeId
+  GetInstanceTypeId () const;
+
+
+  // --------------------------
+  // Header serialization/deserialization
+  // --------------------------
+
+  uint32_t
+  GetSerializedSize () const override;
+
+  void
+  Serialize (Buffer::Iterator start) const override;
+
+  uint32_t
+  Deserialize (Buffer::Iterator start) override;
+
+  void
+  Print (std::ostream &os) const override;
+
+
+  /**
+   * Returns a <code>string</code> object containing the representation of this
+   * instance as a sequence of characters.
+   */
+  std::string ToString () const;
+
+  friend bool operator== (const AggregatedAckHeader & lhs,
+                          const AggregatedAckHeader & rhs);
+};
+
+// AggregatedAckHeader relational operators
+
+inline bool
+operator== (const AggregatedAckHeader & lhs, const AggregatedAckHeader & rhs)
+{
+  return ((AckHeader) lhs) == ((AckHeader) rhs)
+          && lhs.m_received_packets == rhs.m_received_packets;
+}
+
+inline bool
+operator!= (const AggregatedAckHeader & lhs, const AggregatedAckHeader & rhs)
+{
+  return !operator== (lhs, rhs);
+}
+
+// AggregatedAckHeader stream operators
+
+inline std::ostream &
+operator<< (std::ostream & os, const AggregatedAckHeader & obj)
+{
+  obj.Print (os);
+  return os;
+}
+
+
+// =============================================================================
+//                         CompactAggregatedAckHeader
+// =============================================================================
+
+/**
+ * \ingroup geotemporal
+ * 
+ * AGGREGATED_ACK packet header with the compact coordinates encoding.
+ * 
+ * <code>AggregatedAckHeader::GetInstanceTypeId</code> returns the type ID of
+ * this class when the compact encoding is set, so the packet metadata (that
+ * recreates the headers with their default constructor) deserializes and
+ * prints compact headers correctly.
+ */
+class CompactAggregatedAckHeader : public AggregatedAckHeader
+{
+public:
+
+  CompactAggregatedAckHeader ();
+
+
+  // --------------------------
+  // Type ID
+  // --------------------------
+
+  static TypeId
+  GetTypeId ();
+};
+
+
 } // namespace geotemporal
 } // namespace ns3
 
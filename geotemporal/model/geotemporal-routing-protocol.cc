@@ -24,11 +24,14 @@
 
 #include "geotemporal-routing-protocol.h"
 
+#include <algorithm>
+
 #include <ns3/math-utils.h>
 
 #include <ns3/address.h>
 #include <ns3/boolean.h>
 #include <ns3/double.h>
+#include <ns3/enum.h>
 #include <ns3/ipv4-l3-protocol.h>
 #include <ns3/log.h>
 #include <ns3/mobility-model.h>
@@ -56,15 +59,40 @@ NS_OBJECT_ENSURE_REGISTERED (RoutingProtocol);
 RoutingProtocol::RoutingProtocol () :
 m_hello_timeout (MilliSeconds (1000)),
 m_hello_timer (Timer::CANCEL_ON_DESTROY),
+m_hello_summary_vector (false),
+m_max_hello_summary_vector_size (1400u),
+m_hello_summary_vector_digest (false),
+m_synchronized_digests_lifetime (Seconds (30)),
+m_adaptive_hello_interval (false),
+m_min_hello_interval (Seconds (0)),
+m_max_hello_interval (Seconds (5)),
+m_hello_interval_reference_neighbors (10.0),
 m_packets_queue_capacity (128u),
 m_neighbor_expiration_time (Seconds (10)),
 m_default_data_packet_replicas (3u),
+m_replica_allocation (ReplicaAllocation::Fixed),
+m_min_data_packet_replicas (1u),
+m_max_data_packet_replicas (8u),
+m_replica_reference_neighbors (10.0),
+m_replica_reference_lifetime (Seconds (300)),
 m_neighbor_min_valid_distance_diff (20),
 m_exponential_average_time_slot_size (Seconds (30)),
 m_exponential_average_timer (Timer::CANCEL_ON_DESTROY),
+m_compact_header_encoding (false),
+m_summary_vector_encoding (SummaryVectorEncoding::Explicit),
+m_summary_vector_false_positive_rate (0.01),
+m_summary_vector_log_capacity (256u),
+m_data_send_window (1u),
+m_data_retransmission_timeout (MilliSeconds (100)),
+m_max_data_retransmissions (0u),
+m_max_aggregated_data_size (0u),
+m_in_area_broadcast (false),
+m_in_area_broadcast_jitter (MilliSeconds (100)),
+m_in_area_broadcast_suppression_threshold (1u),
 m_node_id (-1),
 m_ipv4 (0),
 m_gps (0),
+m_replica_allocation_policy (0),
 m_selected_interface_index (-1),
 m_last_known_selected_interface_index (-1),
 m_selected_interface_address (),
@@ -74,10 +102,17 @@ m_data_sequential_id (0u),
 m_packets_queue (0u, m_packets_queue_capacity, m_default_data_packet_replicas),
 m_neighbors_table (m_neighbor_expiration_time),
 m_duplicate_detector (MilliSeconds (5600)),
+m_data_ack_timeouts (),
+m_sent_aggregated_frames (),
+m_in_area_broadcasts (),
+m_in_area_broadcasted_packets (),
+m_synchronized_digests (),
 m_tx_packets_counter (),
 m_created_data_packets (),
 m_exponential_average (0.0),
-m_exp_avg_time_slot_neighbors ()
+m_exp_avg_time_slot_neighbors (),
+m_current_hello_interval (),
+m_hello_interval_trace ()
 {
   NS_LOG_FUNCTION (this);
 }
@@ -98,6 +133,38 @@ RoutingProtocol::GetTypeId ()
                          TimeValue (Seconds (1)),
                          MakeTimeAccessor (&RoutingProtocol::m_hello_timeout),
                          MakeTimeChecker (Seconds (0)))
+          .AddAttribute ("HelloSummaryVector", "Carry the summary vector of the node in the HELLO packets when it fits, so the receiver answers directly with a REPLY_BACK or DATA packets (two-way handshake).",
+                         BooleanValue (false),
+                         MakeBooleanAccessor (&RoutingProtocol::m_hello_summary_vector),
+                         MakeBooleanChecker ())
+          .AddAttribute ("MaxHelloSummaryVectorSize", "Maximum size (in bytes) of the summary vector carried in a HELLO packet. Bigger summary vectors are sent in REPLY packets.",
+                         UintegerValue (1400),
+                         MakeUintegerAccessor (&RoutingProtocol::m_max_hello_summary_vector_size),
+                         MakeUintegerChecker<uint32_t> ())
+          .AddAttribute ("HelloSummaryVectorDigest", "Carry the digest of the summary vector of the node in the HELLO packets, so the receiver skips the anti-entropy sessions that would repeat the last one with the same node.",
+                         BooleanValue (false),
+                         MakeBooleanAccessor (&RoutingProtocol::m_hello_summary_vector_digest),
+                         MakeBooleanChecker ())
+          .AddAttribute ("SynchronizedDigestsLifetime", "Time during which the summary vector digests of an anti-entropy session are used to skip the following sessions with the same node.",
+                         TimeValue (Seconds (30)),
+                         MakeTimeAccessor (&RoutingProtocol::m_synchronized_digests_lifetime),
+                         MakeTimeChecker (Seconds (0)))
+          .AddAttribute ("AdaptiveHelloInterval", "Scale the time interval between HELLO transmissions with the average number of neighbor nodes and the occupancy of the packets queue.",
+                         BooleanValue (false),
+                         MakeBooleanAccessor (&RoutingProtocol::m_adaptive_hello_interval),
+                         MakeBooleanChecker ())
+          .AddAttribute ("MinHelloInterval", "Minimum time interval between HELLO transmissions of the adaptive HELLO interval. Zero means the HelloInterval.",
+                         TimeValue (Seconds (0)),
+                         MakeTimeAccessor (&RoutingProtocol::m_min_hello_interval),
+                         MakeTimeChecker (Seconds (0)))
+          .AddAttribute ("MaxHelloInterval", "Maximum time interval between HELLO transmissions of the adaptive HELLO interval.",
+                         TimeValue (Seconds (5)),
+                         MakeTimeAccessor (&RoutingProtocol::m_max_hello_interval),
+                         MakeTimeChecker (Seconds (0)))
+          .AddAttribute ("HelloIntervalReferenceNeighbors", "Average number of neighbor nodes per exponential average time-slot above which the adaptive HELLO interval grows.",
+                         DoubleValue (10.0),
+                         MakeDoubleAccessor (&RoutingProtocol::m_hello_interval_reference_neighbors),
+                         MakeDoubleChecker<double> (1.0))
           .AddAttribute ("PacketsQueueCapacity", "The maximum number of packets that we allow the routing protocol to buffer.",
                          UintegerValue (128),
                          MakeUintegerAccessor (&RoutingProtocol::m_packets_queue_capacity),
@@ -110,6 +177,27 @@ RoutingProtocol::GetTypeId ()
                          UintegerValue (3),
                          MakeUintegerAccessor (&RoutingProtocol::m_default_data_packet_replicas),
                          MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("ReplicaAllocation", "Policy to allocate the replicas of the data packets created by the node.",
+                         EnumValue ((int) ReplicaAllocation::Fixed),
+                         MakeEnumAccessor (&RoutingProtocol::SetReplicaAllocation),
+                         MakeEnumChecker ((int) ReplicaAllocation::Fixed, "Fixed",
+                                          (int) ReplicaAllocation::DensityAdaptive, "DensityAdaptive"))
+          .AddAttribute ("MinDataPacketReplicas", "Minimum number of replicas of each created data packet of the density-adaptive replica allocation.",
+                         UintegerValue (1),
+                         MakeUintegerAccessor (&RoutingProtocol::m_min_data_packet_replicas),
+                         MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("MaxDataPacketReplicas", "Maximum number of replicas of each created data packet of the density-adaptive replica allocation.",
+                         UintegerValue (8),
+                         MakeUintegerAccessor (&RoutingProtocol::m_max_data_packet_replicas),
+                         MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("ReplicaReferenceNeighbors", "Average number of neighbor nodes per exponential average time-slot with which the density-adaptive replica allocation gives DataPacketReplicas replicas.",
+                         DoubleValue (10.0),
+                         MakeDoubleAccessor (&RoutingProtocol::m_replica_reference_neighbors),
+                         MakeDoubleChecker<double> (1.0))
+          .AddAttribute ("ReplicaReferenceLifetime", "Remaining lifetime of a created data packet with which the density-adaptive replica allocation gives DataPacketReplicas replicas.",
+                         TimeValue (Seconds (300)),
+                         MakeTimeAccessor (&RoutingProtocol::m_replica_reference_lifetime),
+                         MakeTimeChecker (Seconds (1)))
           .AddAttribute ("NeighborMinimumValidDistanceDifference", "Minimum distance difference between nodes to be valid packet carriers.",
                          DoubleValue (20),
                          MakeDoubleAccessor (&RoutingProtocol::m_neighbor_min_valid_distance_diff),
@@ -118,10 +206,60 @@ RoutingProtocol::GetTypeId ()
                          TimeValue (Seconds (30)),
                          MakeTimeAccessor (&RoutingProtocol::m_exponential_average_time_slot_size),
                          MakeTimeChecker (Seconds (5)))
+          .AddAttribute ("CompactHeaderEncoding", "Transmit positions, velocities and areas with the compact (fixed-point, variable-length) encoding.",
+                         BooleanValue (false),
+                         MakeBooleanAccessor (&RoutingProtocol::m_compact_header_encoding),
+                         MakeBooleanChecker ())
+          .AddAttribute ("SummaryVectorEncoding", "Encoding of the summary vectors of the transmitted REPLY packets.",
+                         EnumValue ((int) SummaryVectorEncoding::Explicit),
+                         MakeEnumAccessor (&RoutingProtocol::SetSummaryVectorEncoding),
+                         MakeEnumChecker ((int) SummaryVectorEncoding::Explicit, "Explicit",
+                                          (int) SummaryVectorEncoding::DeltaCoded, "DeltaCoded",
+                                          (int) SummaryVectorEncoding::BloomFilter, "BloomFilter",
+                                          (int) SummaryVectorEncoding::Incremental, "Incremental"))
+          .AddAttribute ("SummaryVectorFalsePositiveRate", "False positive rate of the Bloom filters of the transmitted summary vectors.",
+                         DoubleValue (0.01),
+                         MakeDoubleAccessor (&RoutingProtocol::m_summary_vector_false_positive_rate),
+                         MakeDoubleChecker<double> (0.0001, 0.5))
+          .AddAttribute ("SummaryVectorLogCapacity", "Maximum number of changes of the summary vector stored to transmit incremental summary vectors.",
+                         UintegerValue (256),
+                         MakeUintegerAccessor (&RoutingProtocol::m_summary_vector_log_capacity),
+                         MakeUintegerChecker<uint32_t> ())
+          .AddAttribute ("DataSendWindow", "Maximum number of DATA packets sent to a neighbor node whose ACK hasn't been received yet.",
+                         UintegerValue (1),
+                         MakeUintegerAccessor (&RoutingProtocol::m_data_send_window),
+                         MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("DataRetransmissionTimeout", "Time to wait for the ACK of a DATA packet before retransmitting it.",
+                         TimeValue (MilliSeconds (100)),
+                         MakeTimeAccessor (&RoutingProtocol::m_data_retransmission_timeout),
+                         MakeTimeChecker (MilliSeconds (1)))
+          .AddAttribute ("MaxDataRetransmissions", "Maximum number of retransmissions of a DATA packet whose ACK isn't received.",
+                         UintegerValue (0),
+                         MakeUintegerAccessor (&RoutingProtocol::m_max_data_retransmissions),
+                         MakeUintegerChecker<uint32_t> ())
+          .AddAttribute ("MaxAggregatedDataSize", "Maximum size (in bytes) of the IP datagrams (including the IP and UDP headers) of the frames that aggregate several DATA packets. With 0 the DATA packets aren't aggregated. It needs a DataSendWindow bigger than 1 packet.",
+                         UintegerValue (0),
+                         MakeUintegerAccessor (&RoutingProtocol::m_max_aggregated_data_size),
+                         MakeUintegerChecker<uint32_t> ())
+          .AddAttribute ("InAreaBroadcast", "Disseminate the DATA packets inside their destination geo-temporal area with one broadcast per node instead of one unicast session per neighbor node.",
+                         BooleanValue (false),
+                         MakeBooleanAccessor (&RoutingProtocol::m_in_area_broadcast),
+                         MakeBooleanChecker ())
+          .AddAttribute ("InAreaBroadcastJitter", "Maximum random delay before the in-area broadcast of a DATA packet.",
+                         TimeValue (MilliSeconds (100)),
+                         MakeTimeAccessor (&RoutingProtocol::m_in_area_broadcast_jitter),
+                         MakeTimeChecker (MilliSeconds (1)))
+          .AddAttribute ("InAreaBroadcastSuppressionThreshold", "Number of overheard broadcasts of a DATA packet that suppress its pending in-area broadcast.",
+                         UintegerValue (1),
+                         MakeUintegerAccessor (&RoutingProtocol::m_in_area_broadcast_suppression_threshold),
+                         MakeUintegerChecker<uint32_t> (1))
           .AddAttribute ("UniformRv", "Access to the underlying UniformRandomVariable",
                          StringValue ("ns3::UniformRandomVariable"),
                          MakePointerAccessor (&RoutingProtocol::m_uniform_random_variable),
-                         MakePointerChecker<UniformRandomVariable> ());
+                         MakePointerChecker<UniformRandomVariable> ())
+          .AddTraceSource ("HelloInterval", "The time interval between HELLO transmissions changed.",
+                           MakeTraceSourceAccessor (&RoutingProtocol::m_hello_interval_trace),
+                           "ns3::geotemporal::RoutingProtocol::HelloIntervalTracedCallback");
   return tid;
 }
 
@@ -138,7 +276,7 @@ RoutingProtocol::CalculateCompletePacketSize (const Ptr<const Packet> packet)
 {
   return packet->GetSize () // Entire Geo-Temporal header size (including Type header)
           + 24 + 8 // IEEE 802.11 header + LCC header
-          + 20 + 8 + 4; // + IP header + UDP header + Frame end.
+          + IP_UDP_HEADERS_SIZE + 4; // + IP header + UDP header + Frame end.
 }
 
 void
@@ -684,31 +822,49 @@ RoutingProtocol::RecvGeoTemporalPacket (Ptr<Socket> socket)
 
   NS_ASSERT (type_header.IsValid ());
 
+  const bool compact_encoding = type_header.IsCompactEncoding ();
+
   NS_LOG_DEBUG ("Geo-Temporal " << type_header << " packet received from node "
                 << sender_node_ip);
 
   m_packets_queue.Purge ();
   m_neighbors_table.Purge ();
+  PurgeSynchronizedDigests ();
 
   switch (type_header.GetPacketType ())
     {
     case PacketType::Hello:
-      RecvHelloPacket (received_packet, sender_node_ip);
+      RecvHelloPacket (received_packet, sender_node_ip, compact_encoding,
+                       type_header.GetSummaryVectorEncoding ());
       return;
     case PacketType::Reply:
-      RecvReplyPacket (received_packet, sender_node_ip);
+      RecvReplyPacket (received_packet, sender_node_ip, compact_encoding,
+                       type_header.GetSummaryVectorEncoding ());
       return;
     case PacketType::ReplyBack:
-      RecvReplyBackPacket (received_packet, sender_node_ip);
+      RecvReplyBackPacket (received_packet, sender_node_ip, compact_encoding,
+                           type_header.GetSummaryVectorEncoding ());
       return;
     case PacketType::Data:
-      RecvDataPacket (received_packet, sender_node_ip, false);
+      if (socket == m_broadcast_socket)
+        RecvBroadcastDataPacket (received_packet, sender_node_ip, compact_encoding);
+      else
+        RecvDataPacket (received_packet, sender_node_ip, false, compact_encoding);
       return;
     case PacketType::DataAck:
-      RecvDataPacket (received_packet, sender_node_ip, true);
+      RecvDataPacket (received_packet, sender_node_ip, true, compact_encoding);
       return;
     case PacketType::Ack:
-      RecvAckPacket (received_packet, sender_node_ip);
+      RecvAckPacket (received_packet, sender_node_ip, compact_encoding);
+      return;
+    case PacketType::AggregatedData:
+      RecvAggregatedDataPacket (received_packet, sender_node_ip, compact_encoding);
+      return;
+    case PacketType::AggregatedAck:
+      RecvAggregatedAckPacket (received_packet, sender_node_ip, compact_encoding);
+      return;
+    case PacketType::ResyncRequest:
+      RecvResyncRequestPacket (sender_node_ip);
       return;
     default:
       NS_ABORT_MSG ("ERROR: Unknown packet type.");
@@ -716,7 +872,9 @@ RoutingProtocol::RecvGeoTemporalPacket (Ptr<Socket> socket)
 }
 
 void
-RoutingProtocol::RecvHelloPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip)
+RoutingProtocol::RecvHelloPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip,
+                                  bool compact_encoding,
+                                  SummaryVectorEncoding summary_vector_encoding)
 {
   NS_LOG_FUNCTION (this << received_packet << sender_node_ip);
 
@@ -726,6 +884,15 @@ RoutingProtocol::RecvHelloPacket (Ptr<Packet> received_packet, const Ipv4Address
 
   NS_LOG_DEBUG ("Processing HELLO packet received from node " << sender_node_ip);
 
+  SummaryVectorHeader summary_vector_header;
+
+  if (hello_header.HasSummaryVector ())
+    {
+      summary_vector_header.SetCompactEncoding (compact_encoding);
+      summary_vector_header.SetSummaryVectorEncoding (summary_vector_encoding);
+      received_packet->RemoveHeader (summary_vector_header);
+    }
+
   // Count the encountered neighbor node for the exponential adapatative average
   // calculation.
   m_exp_avg_time_slot_neighbors.insert (sender_node_ip);
@@ -737,6 +904,12 @@ RoutingProtocol::RecvHelloPacket (Ptr<Packet> received_packet, const Ipv4Address
       // Current node has a greater identifier, don't initiate session.
       NS_LOG_DEBUG ("HELLO ignored due to being from a node with smaller identifier ("
                     << sender_node_ip << ").");
+
+      // The overheard summary vector still tells the packets that the neighbor
+      // node carries.
+      if (hello_header.HasSummaryVector ())
+        m_packets_queue.AddKnownPacketCarriers (summary_vector_header.GetSummaryVector (),
+                                                sender_node_ip);
       return;
     }
 
@@ -747,6 +920,43 @@ RoutingProtocol::RecvHelloPacket (Ptr<Packet> received_packet, const Ipv4Address
       // Recently contacted neighbor, ignore HELLO.
       NS_LOG_DEBUG ("HELLO ignored due to being from recently contacted node ("
                     << sender_node_ip << ").");
+
+      if (hello_header.HasSummaryVector ())
+        m_packets_queue.AddKnownPacketCarriers (summary_vector_header.GetSummaryVector (),
+                                                sender_node_ip);
+      return;
+    }
+
+  if (hello_header.HasSummaryVectorDigest ()
+      && IsRedundantSession (sender_node_ip, hello_header.GetSummaryVectorDigest ()))
+    {
+      NS_LOG_DEBUG ("HELLO ignored due to being from an already synchronized node ("
+                    << sender_node_ip << ").");
+
+      if (hello_header.HasSummaryVector ())
+        m_packets_queue.AddKnownPacketCarriers (summary_vector_header.GetSummaryVector (),
+                                                sender_node_ip);
+      return;
+    }
+
+  if (hello_header.HasSummaryVectorDigest ())
+    {
+      // Store the digests of both nodes at the start of the session. They are
+      // used once the neighbor node answers.
+      SynchronizedDigests & synchronized_digests = m_synchronized_digests[sender_node_ip];
+      synchronized_digests.m_neighbor_digest = hello_header.GetSummaryVectorDigest ();
+      synchronized_digests.m_local_digest = m_packets_queue.GetSummaryVectorDigest ();
+      synchronized_digests.m_expiration_time = Simulator::Now () + m_synchronized_digests_lifetime;
+      synchronized_digests.m_session_completed = false;
+    }
+
+  if (hello_header.HasSummaryVector ())
+    {
+      // Two-way handshake: the HELLO already carries the summary vector of the
+      // neighbor node, so process it as a received REPLY.
+      NS_LOG_DEBUG ("Process the summary vector carried in the HELLO packet of node "
+                    << sender_node_ip);
+      ProcessNeighborSummaryVector (sender_node_ip, summary_vector_header);
       return;
     }
 
@@ -759,23 +969,167 @@ RoutingProtocol::RecvHelloPacket (Ptr<Packet> received_packet, const Ipv4Address
   SendReplyPacket (sender_node_ip);
 }
 
+bool
+RoutingProtocol::IsRedundantSession (const Ipv4Address& neighbor_node_ip, uint32_t neighbor_digest)
+{
+  NS_LOG_FUNCTION (this << neighbor_node_ip << neighbor_digest);
+
+  const uint32_t local_digest = m_packets_queue.GetSummaryVectorDigest ();
+
+  // Both nodes (probably) have the same packets, so none of them would 
+  // request a packet. Equal digests may also be a collision, so the neighbor 
+  // node isn't recorded as a carrier of the packets of the local node.
+  if (neighbor_digest == local_digest)
+    return true;
+
+  std::map<Ipv4Address, SynchronizedDigests>::iterator digests_it
+          = m_synchronized_digests.find (neighbor_node_ip);
+
+  if (digests_it == m_synchronized_digests.end () || !digests_it->second.m_session_completed)
+    return false;
+
+  if (digests_it->second.m_expiration_time < Simulator::Now ())
+    {
+      m_synchronized_digests.erase (digests_it);
+      return false;
+    }
+
+  // If none of the queues changed since the last session, it would exchange
+  // the same summary vectors again.
+  return digests_it->second.m_neighbor_digest == neighbor_digest
+          && digests_it->second.m_local_digest == local_digest;
+}
+
 void
-RoutingProtocol::RecvReplyPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip)
+RoutingProtocol::CompleteSynchronizedSession (const Ipv4Address& neighbor_node_ip)
 {
-  NS_LOG_FUNCTION (this << received_packet << sender_node_ip);
+  NS_LOG_FUNCTION (this << neighbor_node_ip);
+
+  std::map<Ipv4Address, SynchronizedDigests>::iterator digests_it
+          = m_synchronized_digests.find (neighbor_node_ip);
+
+  if (digests_it != m_synchronized_digests.end ())
+    digests_it->second.m_session_completed = true;
+}
+
+void
+RoutingProtocol::PurgeSynchronizedDigests ()
+{
+  NS_LOG_FUNCTION (this);
+
+  std::map<Ipv4Address, SynchronizedDigests>::iterator digests_it = m_synchronized_digests.begin ();
+
+  while (digests_it != m_synchronized_digests.end ())
+    {
+      // A session that wasn't completed is over once the neighbor node expires
+      // from the neighbors table.
+      if (digests_it->second.m_expiration_time < Simulator::Now ()
+          || (!digests_it->second.m_session_completed && !m_neighbors_table.Find (digests_it->first)))
+        {
+          NS_LOG_DEBUG ("Synchronized digests of node " << digests_it->first << " removed.");
+          digests_it = m_synchronized_digests.erase (digests_it);
+        }
+      else
+        {
+          ++digests_it;
+        }
+    }
+}
+
+void
+RoutingProtocol::RecvReplyPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip,
+                                  bool compact_encoding,
+                                  SummaryVectorEncoding summary_vector_encoding)
+{
+  NS_LOG_FUNCTION (this << received_packet << sender_node_ip << summary_vector_encoding);
 
   NS_LOG_DEBUG ("Processing REPLY packet received from " << sender_node_ip);
 
   SummaryVectorHeader reply_header;
+  reply_header.SetCompactEncoding (compact_encoding);
+  reply_header.SetSummaryVectorEncoding (summary_vector_encoding);
   received_packet->RemoveHeader (reply_header);
 
+  if (summary_vector_encoding == SummaryVectorEncoding::Incremental)
+    {
+      // Rebuild the whole summary vector of the neighbor node from the last one
+      // received from it and the received changes.
+      std::set<DataIdentifier> neighbor_summary_vector;
+
+      if (!m_neighbors_table.UpdateReceivedSummaryVector (/*Neighbor node*/ sender_node_ip,
+                                                          /*Base version*/ reply_header.GetBaseVersion (),
+                                                          /*Version*/ reply_header.GetVersion (),
+                                                          /*Inserted packets*/ reply_header.GetSummaryVector (),
+                                                          /*Removed packets*/ reply_header.GetRemovedPackets (),
+                                                          /*Summary vector*/ neighbor_summary_vector))
+        {
+          NS_LOG_DEBUG ("Summary vector changes of node " << sender_node_ip
+                        << " can't be applied. Request its whole summary vector.");
+          SendResyncRequestPacket (sender_node_ip);
+          return;
+        }
+
+      reply_header.SetSummaryVector (neighbor_summary_vector);
+    }
+
+  if (summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+    {
+      // The locally unknown packets can't be listed from a Bloom filter, only
+      // counted (a lower bound of them).
+      std::set<DataIdentifier> neighbor_known_packets, neighbor_unknown_packets;
+
+      const uint32_t locally_unknown_packets_count
+              = m_packets_queue.ProcessDisjointVectors (/*Received Bloom filter*/ reply_header.GetBloomFilter (),
+                                                        /*Bloom filter entries*/ reply_header.GetSummaryVectorSize (),
+                                                        /*Neighbor IP*/ sender_node_ip,
+                                                        /*Neighbor known packets*/ neighbor_known_packets,
+                                                        /*Neighbor unknown packets*/ neighbor_unknown_packets);
+
+      // The packets that the filter (probably) contains aren't requested in
+      // this session, but they may be false positives, so the neighbor node
+      // isn't recorded as their carrier.
+      m_neighbors_table.Insert (sender_node_ip, neighbor_unknown_packets);
+      ResetDataSendSession (sender_node_ip);
+
+      // If the neighbor node has at least 1 packet that I don't know then I send
+      // the Bloom filter of my summary vector to let it compute them.
+      if (locally_unknown_packets_count > 0u)
+        {
+          NS_LOG_DEBUG ("Answer with a REPLY BACK packet (Bloom filter) to node " << sender_node_ip);
+          SendReplyBackFilterPacket (sender_node_ip);
+        }
+      else if (!neighbor_unknown_packets.empty ())
+        {
+          NS_LOG_DEBUG ("Proceed to send DATA packets unknown by the neighbor node.");
+          FillDataSendWindow (sender_node_ip,
+                              reply_header.GetPosition (),
+                              reply_header.GetVelocity ());
+        }
+      else
+        {
+          NS_LOG_DEBUG ("Both nodes have the same packets in memory. Do nothing.");
+        }
+      return;
+    }
+
+  ProcessNeighborSummaryVector (sender_node_ip, reply_header);
+}
+
+void
+RoutingProtocol::ProcessNeighborSummaryVector (const Ipv4Address& sender_node_ip,
+                                               const SummaryVectorHeader& summary_vector_header)
+{
+  NS_LOG_FUNCTION (this << sender_node_ip);
+
+  CompleteSynchronizedSession (sender_node_ip);
+
   // The disjoint vector of the local node. P_A - P_B
   std::set<DataIdentifier> locally_unknown_packets;
 
   // The disjoint vector of the neighbor node. P_B - P_A
   std::set<DataIdentifier> neighbor_unknown_packets;
 
-  m_packets_queue.ProcessDisjointVectors (/*Received summary vector*/ reply_header.GetSummaryVector (),
+  m_packets_queue.ProcessDisjointVectors (/*Received summary vector*/ summary_vector_header.GetSummaryVector (),
                                           /*Local IP*/ m_selected_interface_address.GetLocal (),
                                           /*Neighbor IP*/ sender_node_ip,
                                           /*Local unknown packets*/ locally_unknown_packets,
@@ -784,10 +1138,11 @@ RoutingProtocol::RecvReplyPacket (Ptr<Packet> received_packet, const Ipv4Address
   // Store the set of packets requested by the neighbor node
   m_neighbors_table.Insert (/*Neighbor node*/ sender_node_ip,
                             /*Neighbor unknown packets*/ neighbor_unknown_packets);
+  ResetDataSendSession (sender_node_ip);
 
   // Store the neighbor node as a known packet carrier of each packet contained
   // in the summary vector
-  m_packets_queue.AddKnownPacketCarriers (reply_header.GetSummaryVector (),
+  m_packets_queue.AddKnownPacketCarriers (summary_vector_header.GetSummaryVector (),
                                           sender_node_ip);
 
   // If the neighbor node has at least 1 packet that I don't know then I send a
@@ -807,9 +1162,9 @@ RoutingProtocol::RecvReplyPacket (Ptr<Packet> received_packet, const Ipv4Address
       if (!neighbor_unknown_packets.empty ())
         {
           NS_LOG_DEBUG ("Proceed to send DATA packets unknown by the neighbor node.");
-          SendDataPacket (sender_node_ip,
-                          reply_header.GetPosition (),
-                          reply_header.GetVelocity ());
+          FillDataSendWindow (sender_node_ip,
+                              summary_vector_header.GetPosition (),
+                              summary_vector_header.GetVelocity ());
         }
       else
         {
@@ -820,35 +1175,101 @@ RoutingProtocol::RecvReplyPacket (Ptr<Packet> received_packet, const Ipv4Address
 }
 
 void
-RoutingProtocol::RecvReplyBackPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip)
+RoutingProtocol::RecvReplyBackPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip,
+                                      bool compact_encoding,
+                                      SummaryVectorEncoding summary_vector_encoding)
 {
-  NS_LOG_FUNCTION (this << received_packet << sender_node_ip);
+  NS_LOG_FUNCTION (this << received_packet << sender_node_ip << summary_vector_encoding);
 
   NS_LOG_DEBUG ("Processing REPLY_BACK packet received from " << sender_node_ip);
 
   SummaryVectorHeader reply_back_header;
+  reply_back_header.SetCompactEncoding (compact_encoding);
+  reply_back_header.SetSummaryVectorEncoding (summary_vector_encoding);
   received_packet->RemoveHeader (reply_back_header);
 
+  // The whole summary vector is requested with a RESYNC_REQUEST packet instead.
+  NS_ASSERT_MSG (summary_vector_encoding != SummaryVectorEncoding::Incremental,
+                 "The REPLY BACK packet can't use the incremental encoding.");
+
+  // The neighbor node answered the summary vector of the local node.
+  CompleteSynchronizedSession (sender_node_ip);
+
+  if (summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+    {
+      // The neighbor node sent the Bloom filter of its whole summary vector,
+      // compute the packets that it doesn't know.
+      std::set<DataIdentifier> neighbor_known_packets, neighbor_unknown_packets;
+
+      m_packets_queue.ProcessDisjointVectors (/*Received Bloom filter*/ reply_back_header.GetBloomFilter (),
+                                              /*Bloom filter entries*/ reply_back_header.GetSummaryVectorSize (),
+                                              /*Neighbor IP*/ sender_node_ip,
+                                              /*Neighbor known packets*/ neighbor_known_packets,
+                                              /*Neighbor unknown packets*/ neighbor_unknown_packets);
+
+      // The packets that the filter (probably) contains are only left out of
+      // this session. They may be false positives, so the neighbor node isn't
+      // recorded as their carrier.
+
+      // The unknown packets may be empty due to false positives of the filter.
+      if (neighbor_unknown_packets.empty ())
+        {
+          NS_LOG_DEBUG ("No DATA packets unknown by the neighbor node " << sender_node_ip);
+          return;
+        }
+
+      m_neighbors_table.UpdateNeighborRequestedPackets (sender_node_ip,
+                                                        neighbor_unknown_packets);
+      ResetDataSendSession (sender_node_ip);
+
+      NS_LOG_DEBUG ("Proceed to send requested DATA packets to neighbor node " << sender_node_ip);
+      FillDataSendWindow (sender_node_ip,
+                          reply_back_header.GetPosition (),
+                          reply_back_header.GetVelocity ());
+      return;
+    }
+
   NS_ASSERT_MSG (!reply_back_header.GetSummaryVector ().empty (),
                  "The REPLY BACK packet's disjoint vector shouldn't be empty.");
 
-  // Store the set of data packets requested by the neighbor node.
-  m_neighbors_table.UpdateNeighborRequestedPackets (sender_node_ip,
-                                                    reply_back_header.GetSummaryVector ());
+  // Store the set of data packets requested by the neighbor node. After a
+  // two-way handshake the neighbor node answered my HELLO directly, so it 
+  // isn't in the table yet.
+  if (!m_neighbors_table.UpdateNeighborRequestedPackets (sender_node_ip,
+                                                         reply_back_header.GetSummaryVector ()))
+    m_neighbors_table.Insert (sender_node_ip, reply_back_header.GetSummaryVector ());
+
+  ResetDataSendSession (sender_node_ip);
 
   NS_LOG_DEBUG ("Proceed to send requested DATA packets to neighbor node " << sender_node_ip);
-  SendDataPacket (sender_node_ip,
-                  reply_back_header.GetPosition (),
-                  reply_back_header.GetVelocity ());
+  FillDataSendWindow (sender_node_ip,
+                      reply_back_header.GetPosition (),
+                      reply_back_header.GetVelocity ());
+}
+
+void
+RoutingProtocol::RecvResyncRequestPacket (const Ipv4Address& sender_node_ip)
+{
+  NS_LOG_FUNCTION (this << sender_node_ip);
+
+  // The neighbor node couldn't apply the changes of my summary vector, answer
+  // with the whole summary vector.
+  NS_LOG_DEBUG ("Node " << sender_node_ip << " requested the whole summary vector.");
+  m_neighbors_table.RemoveSentSummaryVectorVersion (sender_node_ip);
+  SendReplyPacket (sender_node_ip);
 }
 
 void
 RoutingProtocol::RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip,
-                                 const bool ack_flag)
+                                 const bool ack_flag,
+                                 bool compact_encoding)
 {
   NS_LOG_FUNCTION (this << received_packet << sender_node_ip);
 
+  CompleteSynchronizedSession (sender_node_ip);
+
   DataHeader data_header;
+  data_header.SetCompactEncoding (compact_encoding);
 
   if (!ack_flag)
     {
@@ -861,6 +1282,7 @@ RoutingProtocol::RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address&
     {
       // Received a DATA_ACK packet
       DataAckHeader data_ack_header;
+      data_ack_header.SetCompactEncoding (compact_encoding);
       received_packet->RemoveHeader (data_ack_header);
 
       data_header = (DataHeader) data_ack_header;
@@ -872,6 +1294,11 @@ RoutingProtocol::RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address&
       // Store neighbor as known packet carrier
       m_packets_queue.AddKnownPacketCarrier (data_ack_header.GetDataIdentifierToAck (),
                                              sender_node_ip);
+
+      // The acknowledged packet is no longer outstanding
+      m_neighbors_table.RemoveOutstandingDataPacket (sender_node_ip,
+                                                     data_ack_header.GetDataIdentifierToAck ());
+      CancelDataAckTimeout (sender_node_ip, data_ack_header.GetDataIdentifierToAck ());
     }
 
   // Increment hops count
@@ -884,6 +1311,7 @@ RoutingProtocol::RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address&
   if (m_packets_queue.Enqueue (data_header, my_position, sender_node_ip))
     {
       NS_LOG_DEBUG ("Packet successfully stored in packets queue.");
+      ScheduleInAreaBroadcast (data_header.GetDataIdentifier ());
     }
   else
     {
@@ -893,10 +1321,11 @@ RoutingProtocol::RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address&
   // Reply to the neighbor node with an ACK or DATA_ACK packet.
   NeighborEntry neighbor;
 
-  // - If I have at least one packet that the neighbor node doesn't, use a 
-  //   DATA_ACK packet. Otherwise use an ACK packet.
+  // - If I have at least one packet that the neighbor node doesn't (and room
+  //   in the send window), use a DATA_ACK packet. Otherwise use an ACK packet.
   if (m_neighbors_table.Find (sender_node_ip, neighbor)
-      && !neighbor.GetRequestedPacketsSet ().empty ())
+      && !neighbor.GetRequestedPacketsSet ().empty ()
+      && m_neighbors_table.GetOutstandingDataPacketsCount (sender_node_ip) < m_data_send_window)
     {
       // Reply with a DATA_ACK packet
       NS_LOG_DEBUG ("Answer with a DATA_ACK packet to node " << sender_node_ip);
@@ -905,6 +1334,13 @@ RoutingProtocol::RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address&
                       data_header.GetVelocity (),
                       true,
                       data_header.GetDataIdentifier ());
+
+      // Use the rest of the send window, if any. In stop-and-wait mode the
+      // DATA_ACK packet is the only packet in flight.
+      if (IsDataAckTimeoutEnabled ())
+        FillDataSendWindow (sender_node_ip,
+                            data_header.GetPosition (),
+                            data_header.GetVelocity ());
     }
   else
     {
@@ -915,13 +1351,67 @@ RoutingProtocol::RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address&
 }
 
 void
-RoutingProtocol::RecvAckPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip)
+RoutingProtocol::RecvBroadcastDataPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip,
+                                          bool compact_encoding)
+{
+  NS_LOG_FUNCTION (this << received_packet << sender_node_ip);
+
+  DataHeader data_header;
+  data_header.SetCompactEncoding (compact_encoding);
+  received_packet->RemoveHeader (data_header);
+
+  const DataIdentifier data_id = data_header.GetDataIdentifier ();
+  NS_LOG_DEBUG ("Received broadcasted DATA packet " << data_id << " from node " << sender_node_ip);
+
+  // Increment hops count
+  data_header.SetHopsCount (data_header.GetHopsCount () + 1u);
+
+  Vector2D my_position, my_velocity;
+  GetNodeMobility (my_position, my_velocity);
+
+  const bool stored_packet = m_packets_queue.Enqueue (data_header, my_position, sender_node_ip);
+
+  // The sender node carries the packet, so it no longer requests it.
+  m_packets_queue.AddKnownPacketCarrier (data_id, sender_node_ip);
+
+  if (m_neighbors_table.RemoveNeighborRequestedPacket (sender_node_ip, data_id))
+    m_packets_queue.ResetTransmitSession (sender_node_ip);
+
+  std::map<DataIdentifier, std::pair<EventId, uint32_t> >::iterator broadcast_it
+          = m_in_area_broadcasts.find (data_id);
+
+  if (broadcast_it != m_in_area_broadcasts.end ())
+    {
+      // The neighborhood already received the packet from other nodes.
+      if (++broadcast_it->second.second >= m_in_area_broadcast_suppression_threshold)
+        {
+          NS_LOG_DEBUG ("In-area broadcast of DATA packet " << data_id << " suppressed after "
+                        << broadcast_it->second.second << " overheard broadcasts.");
+
+          broadcast_it->second.first.Cancel ();
+          m_in_area_broadcasts.erase (broadcast_it);
+          m_in_area_broadcasted_packets.insert (data_id);
+        }
+      return;
+    }
+
+  if (stored_packet)
+    {
+      NS_LOG_DEBUG ("Packet successfully stored in packets queue.");
+      ScheduleInAreaBroadcast (data_id);
+    }
+}
+
+void
+RoutingProtocol::RecvAckPacket (Ptr<Packet> received_packet, const Ipv4Address& sender_node_ip,
+                                bool compact_encoding)
 {
   NS_LOG_FUNCTION (this << received_packet << sender_node_ip);
 
   NS_LOG_DEBUG ("Processing ACK packet received from " << sender_node_ip);
 
   AckHeader ack_header;
+  ack_header.SetCompactEncoding (compact_encoding);
   received_packet->RemoveHeader (ack_header);
   NS_LOG_DEBUG ("Received ACK for packet " << ack_header.GetDataIdentifier ()
                 << " from " << sender_node_ip);
@@ -930,10 +1420,115 @@ RoutingProtocol::RecvAckPacket (Ptr<Packet> received_packet, const Ipv4Address&
   m_packets_queue.AddKnownPacketCarrier (ack_header.GetDataIdentifier (),
                                          sender_node_ip);
 
+  // The acknowledged packet is no longer outstanding
+  m_neighbors_table.RemoveOutstandingDataPacket (sender_node_ip, ack_header.GetDataIdentifier ());
+  CancelDataAckTimeout (sender_node_ip, ack_header.GetDataIdentifier ());
+
+  NS_LOG_DEBUG ("Proceed to send requested DATA packets to neighbor node " << sender_node_ip);
+  FillDataSendWindow (sender_node_ip,
+                      ack_header.GetPosition (),
+                      ack_header.GetVelocity ());
+}
+
+void
+RoutingProtocol::RecvAggregatedDataPacket (Ptr<Packet> received_packet,
+                                           const Ipv4Address& sender_node_ip,
+                                           bool compact_encoding)
+{
+  NS_LOG_FUNCTION (this << received_packet << sender_node_ip);
+
+  AggregatedDataHeader aggregated_data_header;
+  aggregated_data_header.SetCompactEncoding (compact_encoding);
+  received_packet->RemoveHeader (aggregated_data_header);
+  NS_LOG_DEBUG ("Received " << aggregated_data_header << " from node " << sender_node_ip);
+
+  const std::vector<DataHeader> & data_packets = aggregated_data_header.GetDataPackets ();
+
+  if (data_packets.empty ())
+    return;
+
+  CompleteSynchronizedSession (sender_node_ip);
+
+  Vector2D my_position, my_velocity;
+  GetNodeMobility (my_position, my_velocity);
+
+  // A DATA packet is acknowledged as received if it is stored in the packets
+  // queue (or it was already stored).
+  std::vector<bool> received_packets (data_packets.size (), false);
+
+  for (uint32_t i = 0u; i < data_packets.size (); ++i)
+    {
+      // Increment hops count
+      DataHeader data_header = data_packets[i];
+      data_header.SetHopsCount (data_header.GetHopsCount () + 1u);
+
+      if (m_packets_queue.Enqueue (data_header, my_position, sender_node_ip))
+        {
+          NS_LOG_DEBUG ("Packet " << data_header.GetDataIdentifier ()
+                        << " successfully stored in packets queue.");
+        }
+      else
+        {
+          NS_LOG_DEBUG ("Packet " << data_header.GetDataIdentifier ()
+                        << " not stored in packets queue.");
+        }
+
+      received_packets[i] = m_packets_queue.Find (data_header.GetDataIdentifier ());
+    }
+
+  SendAggregatedAckPacket (sender_node_ip, data_packets.front ().GetDataIdentifier (),
+                           received_packets);
+
+  NS_LOG_DEBUG ("Proceed to send requested DATA packets to neighbor node " << sender_node_ip);
+  FillDataSendWindow (sender_node_ip,
+                      data_packets.back ().GetPosition (),
+                      data_packets.back ().GetVelocity ());
+}
+
+void
+RoutingProtocol::RecvAggregatedAckPacket (Ptr<Packet> received_packet,
+                                          const Ipv4Address& sender_node_ip,
+                                          bool compact_encoding)
+{
+  NS_LOG_FUNCTION (this << received_packet << sender_node_ip);
+
+  AggregatedAckHeader aggregated_ack_header;
+  aggregated_ack_header.SetCompactEncoding (compact_encoding);
+  received_packet->RemoveHeader (aggregated_ack_header);
+  NS_LOG_DEBUG ("Received " << aggregated_ack_header << " from node " << sender_node_ip);
+
+  std::map<std::pair<Ipv4Address, DataIdentifier>, std::vector<DataIdentifier> >::iterator frame_it
+          = m_sent_aggregated_frames.find (std::make_pair (sender_node_ip,
+                                                           aggregated_ack_header.GetDataIdentifier ()));
+
+  if (frame_it != m_sent_aggregated_frames.end ())
+    {
+      const std::vector<DataIdentifier> & frame_packets = frame_it->second;
+      const std::vector<bool> & received_packets = aggregated_ack_header.GetReceivedPackets ();
+
+      for (uint32_t i = 0u; i < frame_packets.size (); ++i)
+        {
+          // Store neighbor as known packet carrier of the received packets
+          if (i < received_packets.size () && received_packets[i])
+            m_packets_queue.AddKnownPacketCarrier (frame_packets[i], sender_node_ip);
+
+          // The packets of the frame are no longer outstanding
+          m_neighbors_table.RemoveOutstandingDataPacket (sender_node_ip, frame_packets[i]);
+          CancelDataAckTimeout (sender_node_ip, frame_packets[i]);
+        }
+
+      m_sent_aggregated_frames.erase (frame_it);
+    }
+  else
+    {
+      NS_LOG_DEBUG ("The acknowledged frame is unknown (the session was reset or "
+                    "the frame was given up).");
+    }
+
   NS_LOG_DEBUG ("Proceed to send requested DATA packets to neighbor node " << sender_node_ip);
-  SendDataPacket (sender_node_ip,
-                  ack_header.GetPosition (),
-                  ack_header.GetVelocity ());
+  FillDataSendWindow (sender_node_ip,
+                      aggregated_ack_header.GetPosition (),
+                      aggregated_ack_header.GetVelocity ());
 }
 
 void
@@ -968,10 +1563,17 @@ RoutingProtocol::NewMessage (const std::string& message,
                                 /*Dest. geo-temporal area*/ destination_gta,
                                 /*Message*/ message);
 
-  const bool enqueued = m_packets_queue.Enqueue (data_packet, my_position, local_ip);
+  const uint32_t replicas
+          = m_replica_allocation_policy->GetInitialReplicas (m_exponential_average,
+                                                             destination_gta.GetTimePeriod ().GetEndTime ()
+                                                             - Simulator::Now ());
+
+  const bool enqueued = m_packets_queue.Enqueue (data_packet, my_position, local_ip, replicas);
   NS_ABORT_MSG_UNLESS (enqueued, "Message must be enqueued successfully.");
-  NS_LOG_DEBUG ("DATA packet " << data_id << " constructed and stored in packets "
-                "queue successfully: " << data_packet);
+  NS_LOG_DEBUG ("DATA packet " << data_id << " constructed with " << replicas << " replicas and"
+                " stored in packets queue successfully: " << data_packet);
+
+  ScheduleInAreaBroadcast (data_id);
 
   // Store the data packet in a list to keep a log of all created data packets
   // in the node and its creation time.
@@ -1034,11 +1636,47 @@ RoutingProtocol::SendHelloPacket ()
 
   HelloHeader hello_header (/*Node IP*/ m_selected_interface_address.GetLocal (),
                             /*Known packets count*/ m_packets_queue.Size ());
-  NS_LOG_DEBUG ("Constructed HELLO packet: " << hello_header);
+
+  if (m_hello_summary_vector_digest)
+    hello_header.SetSummaryVectorDigest (m_packets_queue.GetSummaryVectorDigest ());
 
   Ptr<Packet> packet_to_send = Create<Packet> ();
+
+  if (m_hello_summary_vector)
+    {
+      // Two-way handshake: carry the delta-coded summary vector if it fits.
+      std::set<DataIdentifier> summary_vector;
+      m_packets_queue.GetSummaryVector (summary_vector);
+
+      Vector2D my_position, my_velocity;
+      GetNodeMobility (my_position, my_velocity);
+
+      SummaryVectorHeader summary_vector_header (summary_vector, my_position, my_velocity);
+      summary_vector_header.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+
+      summary_vector_header.SetCompactEncoding (m_compact_header_encoding);
+
+      if (summary_vector_header.GetSerializedSize () <= m_max_hello_summary_vector_size)
+        {
+          packet_to_send->AddHeader (summary_vector_header);
+          hello_header.SetSummaryVectorFlag (true);
+        }
+      else
+        {
+          NS_LOG_DEBUG ("Summary vector of " << summary_vector_header.GetSerializedSize ()
+                        << " bytes doesn't fit in the HELLO packet.");
+        }
+    }
+
+  NS_LOG_DEBUG ("Constructed HELLO packet: " << hello_header);
+
   packet_to_send->AddHeader (hello_header);
-  packet_to_send->AddHeader (TypeHeader (PacketType::Hello));
+
+  if (hello_header.HasSummaryVector ())
+    packet_to_send->AddHeader (TypeHeader (PacketType::Hello, m_compact_header_encoding,
+                                           SummaryVectorEncoding::DeltaCoded));
+  else
+    packet_to_send->AddHeader (TypeHeader (PacketType::Hello));
 
   // Broadcast the hello
   if (SendBroadcastPacket (packet_to_send))
@@ -1070,11 +1708,46 @@ RoutingProtocol::SendReplyPacket (const Ipv4Address& destination_node)
   GetNodeMobility (my_position, my_velocity);
 
   SummaryVectorHeader reply_header (summary_vector, my_position, my_velocity);
+  reply_header.SetSummaryVectorEncoding (m_summary_vector_encoding);
+
+  if (m_summary_vector_encoding == SummaryVectorEncoding::BloomFilter)
+    {
+      reply_header.SetBloomFilter (DataIdentifierBloomFilter (summary_vector, m_summary_vector_false_positive_rate),
+                                   summary_vector.size ());
+    }
+  else if (m_summary_vector_encoding == SummaryVectorEncoding::Incremental)
+    {
+      // Send only the changes since the version last sent to the neighbor node.
+      // If it is unknown, or the changes log was truncated, send the whole
+      // summary vector (base version 0).
+      const uint32_t version = m_packets_queue.GetSummaryVectorVersion ();
+      uint32_t sent_version = 0u;
+      std::set<DataIdentifier> inserted_packets, removed_packets;
+
+      if (m_neighbors_table.FindSentSummaryVectorVersion (destination_node, sent_version)
+          && sent_version != 0u
+          && m_packets_queue.GetSummaryVectorChanges (sent_version, inserted_packets, removed_packets))
+        {
+          reply_header.SetSummaryVector (inserted_packets);
+          reply_header.SetRemovedPackets (removed_packets);
+          reply_header.SetVersions (sent_version, version);
+        }
+      else
+        {
+          reply_header.SetVersions (0u, version);
+        }
+
+      m_neighbors_table.SetSentSummaryVectorVersion (destination_node, version);
+    }
+
   NS_LOG_DEBUG ("Constructed REPLY packet: " << reply_header);
 
+  reply_header.SetCompactEncoding (m_compact_header_encoding);
+
   Ptr<Packet> packet_to_send = Create<Packet> ();
   packet_to_send->AddHeader (reply_header);
-  packet_to_send->AddHeader (TypeHeader (PacketType::Reply));
+  packet_to_send->AddHeader (TypeHeader (PacketType::Reply, m_compact_header_encoding,
+                                         m_summary_vector_encoding));
 
   // Transmit the packet
   if (SendUnicastPacket (packet_to_send, destination_node))
@@ -1104,12 +1777,21 @@ RoutingProtocol::SendReplyBackPacket (const Ipv4Address& destination_node,
   Vector2D my_position, my_velocity;
   GetNodeMobility (my_position, my_velocity);
 
+  // The disjoint vector is exact, so it's never sent as a Bloom filter.
+  const SummaryVectorEncoding summary_vector_encoding
+          = m_summary_vector_encoding == SummaryVectorEncoding::Explicit
+          ? SummaryVectorEncoding::Explicit : SummaryVectorEncoding::DeltaCoded;
+
   SummaryVectorHeader reply_back_header (disjoint_vector, my_position, my_velocity);
+  reply_back_header.SetSummaryVectorEncoding (summary_vector_encoding);
   NS_LOG_DEBUG ("Constructed REPLY_BACK packet: " << reply_back_header);
 
+  reply_back_header.SetCompactEncoding (m_compact_header_encoding);
+
   Ptr<Packet> packet_to_send = Create<Packet> ();
   packet_to_send->AddHeader (reply_back_header);
-  packet_to_send->AddHeader (TypeHeader (PacketType::ReplyBack));
+  packet_to_send->AddHeader (TypeHeader (PacketType::ReplyBack, m_compact_header_encoding,
+                                         summary_vector_encoding));
 
   // Transmit the packet
   if (SendUnicastPacket (packet_to_send, destination_node))
@@ -1129,27 +1811,97 @@ RoutingProtocol::SendReplyBackPacket (const Ipv4Address& destination_node,
 }
 
 void
-RoutingProtocol::SendDataPacket (const Ipv4Address& destination_node_ip,
-                                 const Vector2D& destination_node_position,
-                                 const Vector2D& destination_node_velocity,
-                                 const bool ack_flag,
-                                 const DataIdentifier& data_id_to_ack)
+RoutingProtocol::SendReplyBackFilterPacket (const Ipv4Address& destination_node)
 {
-  NS_LOG_FUNCTION (this << " Neighbor IP " << destination_node_ip
-                   << " ack flag " << ack_flag);
+  NS_LOG_FUNCTION (this << destination_node);
 
-  NS_LOG_DEBUG ("Sending DATA" << (ack_flag ? "_ACK" : "") << " packet to node "
-                << destination_node_ip);
+  // I received a REPLY with a Bloom filter, construct a REPLY BACK with the
+  // Bloom filter of my summary vector.
+  std::set<DataIdentifier> summary_vector;
+  m_packets_queue.GetSummaryVector (summary_vector);
 
-  // Get the set of requested packets by the neighbor
-  NeighborEntry neighbor;
+  Vector2D my_position, my_velocity;
+  GetNodeMobility (my_position, my_velocity);
 
-  if (!m_neighbors_table.Find (destination_node_ip, neighbor))
-    {
-      // The neighbor entry wasn't found, so there is no set of requested packets.
-      NS_LOG_DEBUG ("Neighbor " << destination_node_ip << " not found in the "
-                    "neighbors table (no set of requested packets). "
-                    "Finish sending DATA packet.");
+  SummaryVectorHeader reply_back_header (std::set<DataIdentifier> (), my_position, my_velocity);
+  reply_back_header.SetSummaryVectorEncoding (SummaryVectorEncoding::BloomFilter);
+  reply_back_header.SetBloomFilter (DataIdentifierBloomFilter (summary_vector, m_summary_vector_false_positive_rate),
+                                    summary_vector.size ());
+  NS_LOG_DEBUG ("Constructed REPLY_BACK packet: " << reply_back_header);
+
+  reply_back_header.SetCompactEncoding (m_compact_header_encoding);
+
+  Ptr<Packet> packet_to_send = Create<Packet> ();
+  packet_to_send->AddHeader (reply_back_header);
+  packet_to_send->AddHeader (TypeHeader (PacketType::ReplyBack, m_compact_header_encoding,
+                                         SummaryVectorEncoding::BloomFilter));
+
+  // Transmit the packet
+  if (SendUnicastPacket (packet_to_send, destination_node))
+    {
+      // Count the transmitted packet
+      uint32_t packet_size = RoutingProtocol::CalculateCompletePacketSize (packet_to_send);
+      m_tx_packets_counter.CountPacket (PacketClass::Control, packet_size);
+
+      NS_LOG_DEBUG ("REPLY_BACK packet sent from " << m_selected_interface_address.GetLocal ()
+                    << " to " << destination_node);
+    }
+  else
+    {
+      NS_LOG_DEBUG ("REPLY_BACK packet could not be sent to " << destination_node
+                    << " (maybe node is disabled).");
+    }
+}
+
+void
+RoutingProtocol::SendResyncRequestPacket (const Ipv4Address& destination_node)
+{
+  NS_LOG_FUNCTION (this << destination_node);
+
+  // I received a REPLY with changes that I can't apply, construct a 
+  // RESYNC_REQUEST to request the whole summary vector.
+  Ptr<Packet> packet_to_send = Create<Packet> ();
+  packet_to_send->AddHeader (TypeHeader (PacketType::ResyncRequest));
+
+  // Transmit the packet
+  if (SendUnicastPacket (packet_to_send, destination_node))
+    {
+      // Count the transmitted packet
+      uint32_t packet_size = RoutingProtocol::CalculateCompletePacketSize (packet_to_send);
+      m_tx_packets_counter.CountPacket (PacketClass::Control, packet_size);
+
+      NS_LOG_DEBUG ("RESYNC_REQUEST packet sent from " << m_selected_interface_address.GetLocal ()
+                    << " to " << destination_node);
+    }
+  else
+    {
+      NS_LOG_DEBUG ("RESYNC_REQUEST packet could not be sent to " << destination_node
+                    << " (maybe node is disabled).");
+    }
+}
+
+bool
+RoutingProtocol::SendDataPacket (const Ipv4Address& destination_node_ip,
+                                 const Vector2D& destination_node_position,
+                                 const Vector2D& destination_node_velocity,
+                                 const bool ack_flag,
+                                 const DataIdentifier& data_id_to_ack)
+{
+  NS_LOG_FUNCTION (this << " Neighbor IP " << destination_node_ip
+                   << " ack flag " << ack_flag);
+
+  NS_LOG_DEBUG ("Sending DATA" << (ack_flag ? "_ACK" : "") << " packet to node "
+                << destination_node_ip);
+
+  // Get the set of requested packets by the neighbor
+  NeighborEntry neighbor;
+
+  if (!m_neighbors_table.Find (destination_node_ip, neighbor))
+    {
+      // The neighbor entry wasn't found, so there is no set of requested packets.
+      NS_LOG_DEBUG ("Neighbor " << destination_node_ip << " not found in the "
+                    "neighbors table (no set of requested packets). "
+                    "Finish sending DATA packet.");
 
       if (ack_flag)
         {
@@ -1158,7 +1910,7 @@ RoutingProtocol::SendDataPacket (const Ipv4Address& destination_node_ip,
           SendAckPacket (destination_node_ip, data_id_to_ack);
         }
 
-      return;
+      return false;
     }
 
   // The neighbor was found in the neighbors table, from its set of requested packets
@@ -1189,7 +1941,7 @@ RoutingProtocol::SendDataPacket (const Ipv4Address& destination_node_ip,
           SendAckPacket (destination_node_ip, data_id_to_ack);
         }
 
-      return;
+      return false;
     }
 
   // A packet was selected to be transmitted.
@@ -1204,6 +1956,7 @@ RoutingProtocol::SendDataPacket (const Ipv4Address& destination_node_ip,
   DataHeader data_packet = selected_packet.GetDataPacket ();
   data_packet.SetPosition (my_position);
   data_packet.SetVelocity (my_velocity);
+  data_packet.SetCompactEncoding (m_compact_header_encoding);
 
   if (!ack_flag)
     {
@@ -1211,7 +1964,7 @@ RoutingProtocol::SendDataPacket (const Ipv4Address& destination_node_ip,
       NS_LOG_DEBUG ("Constructed DATA packet: " << data_packet);
 
       packet_to_send->AddHeader (data_packet);
-      packet_to_send->AddHeader (TypeHeader (PacketType::Data));
+      packet_to_send->AddHeader (TypeHeader (PacketType::Data, m_compact_header_encoding));
     }
   else
     {
@@ -1220,7 +1973,7 @@ RoutingProtocol::SendDataPacket (const Ipv4Address& destination_node_ip,
       NS_LOG_DEBUG ("Constructed DATA_ACK packet: " << data_ack_packet);
 
       packet_to_send->AddHeader (data_ack_packet);
-      packet_to_send->AddHeader (TypeHeader (PacketType::DataAck));
+      packet_to_send->AddHeader (TypeHeader (PacketType::DataAck, m_compact_header_encoding));
     }
 
   // Transmit the packet
@@ -1236,12 +1989,16 @@ RoutingProtocol::SendDataPacket (const Ipv4Address& destination_node_ip,
       NS_LOG_DEBUG ("DATA" << (ack_flag ? "_ACK" : "") << " packet sent from "
                     << m_selected_interface_address.GetLocal ()
                     << " to " << destination_node_ip);
+
+      // The packet is outstanding until its ACK is received
+      TrackOutstandingDataPacket (destination_node_ip, data_packet.GetDataIdentifier (), 1u,
+                                  destination_node_position, destination_node_velocity);
+      return true;
     }
-  else
-    {
-      NS_LOG_DEBUG ("DATA" << (ack_flag ? "_ACK" : "") << " packet could not be sent to "
-                    << destination_node_ip << " (maybe node is disabled).");
-    }
+
+  NS_LOG_DEBUG ("DATA" << (ack_flag ? "_ACK" : "") << " packet could not be sent to "
+                << destination_node_ip << " (maybe node is disabled).");
+  return false;
 }
 
 void
@@ -1257,9 +2014,11 @@ RoutingProtocol::SendAckPacket (const Ipv4Address& destination_node,
   AckHeader ack_header (data_id_to_ack, my_position, my_velocity);
   NS_LOG_DEBUG ("Constructed ACK packet: " << ack_header);
 
+  ack_header.SetCompactEncoding (m_compact_header_encoding);
+
   Ptr<Packet> packet_to_send = Create<Packet> ();
   packet_to_send->AddHeader (ack_header);
-  packet_to_send->AddHeader (TypeHeader (PacketType::Ack));
+  packet_to_send->AddHeader (TypeHeader (PacketType::Ack, m_compact_header_encoding));
 
   // Transmit the packet
   if (SendUnicastPacket (packet_to_send, destination_node))
@@ -1278,6 +2037,306 @@ RoutingProtocol::SendAckPacket (const Ipv4Address& destination_node,
     }
 }
 
+void
+RoutingProtocol::SendAggregatedAckPacket (const Ipv4Address& destination_node,
+                                          const DataIdentifier& first_data_id,
+                                          const std::vector<bool>& received_packets)
+{
+  NS_LOG_FUNCTION (this << destination_node << first_data_id);
+
+  Vector2D my_position, my_velocity;
+  GetNodeMobility (my_position, my_velocity);
+
+  AggregatedAckHeader aggregated_ack_header (first_data_id, received_packets,
+                                             my_position, my_velocity);
+  NS_LOG_DEBUG ("Constructed AGGREGATED_ACK packet: " << aggregated_ack_header);
+
+  aggregated_ack_header.SetCompactEncoding (m_compact_header_encoding);
+
+  Ptr<Packet> packet_to_send = Create<Packet> ();
+  packet_to_send->AddHeader (aggregated_ack_header);
+  packet_to_send->AddHeader (TypeHeader (PacketType::AggregatedAck, m_compact_header_encoding));
+
+  // Transmit the packet
+  if (SendUnicastPacket (packet_to_send, destination_node))
+    {
+      // Count the transmitted packet
+      uint32_t packet_size = RoutingProtocol::CalculateCompletePacketSize (packet_to_send);
+      m_tx_packets_counter.CountPacket (PacketClass::Control, packet_size);
+
+      NS_LOG_DEBUG ("AGGREGATED_ACK packet sent from " << m_selected_interface_address.GetLocal ()
+                    << " to " << destination_node);
+    }
+  else
+    {
+      NS_LOG_DEBUG ("AGGREGATED_ACK packet could not be sent to " << destination_node
+                    << " (maybe node is disabled).");
+    }
+}
+
+void
+RoutingProtocol::FillDataSendWindow (const Ipv4Address& destination_node_ip,
+                                     const Vector2D& destination_node_position,
+                                     const Vector2D& destination_node_velocity)
+{
+  NS_LOG_FUNCTION (this << destination_node_ip);
+
+  // In stop-and-wait mode the sent packets aren't outstanding, so the window
+  // always has a single free slot.
+  uint32_t free_slots_count = 1u;
+
+  if (IsDataAckTimeoutEnabled ())
+    {
+      const uint32_t outstanding_packets_count
+              = m_neighbors_table.GetOutstandingDataPacketsCount (destination_node_ip);
+
+      free_slots_count = outstanding_packets_count < m_data_send_window
+              ? m_data_send_window - outstanding_packets_count : 0u;
+    }
+
+  if (free_slots_count == 0u)
+    {
+      NS_LOG_DEBUG ("Send window to node " << destination_node_ip << " is full.");
+      return;
+    }
+
+  if (m_max_aggregated_data_size > 0u)
+    {
+      SendAggregatedDataPackets (destination_node_ip, destination_node_position,
+                                 destination_node_velocity, free_slots_count);
+    }
+  else
+    {
+      for (uint32_t i = 0u; i < free_slots_count; ++i)
+        {
+          if (!SendDataPacket (destination_node_ip, destination_node_position,
+                               destination_node_velocity))
+            break;
+        }
+    }
+
+  NS_LOG_DEBUG (m_neighbors_table.GetOutstandingDataPacketsCount (destination_node_ip)
+                << " / " << m_data_send_window << " DATA packets outstanding to node "
+                << destination_node_ip);
+}
+
+uint32_t
+RoutingProtocol::SendAggregatedDataPackets (const Ipv4Address& destination_node_ip,
+                                            const Vector2D& destination_node_position,
+                                            const Vector2D& destination_node_velocity,
+                                            const uint32_t max_packets_count)
+{
+  NS_LOG_FUNCTION (this << destination_node_ip << max_packets_count);
+
+  NeighborEntry neighbor;
+
+  if (!m_neighbors_table.Find (destination_node_ip, neighbor))
+    {
+      NS_LOG_DEBUG ("Neighbor " << destination_node_ip << " not found in the "
+                    "neighbors table (no set of requested packets).");
+      return 0u;
+    }
+
+  Vector2D my_position, my_velocity;
+  GetNodeMobility (my_position, my_velocity);
+
+  // Select the packets to transmit in order of transmission priority. Every
+  // selected packet must be transmitted, because its replicas were discounted.
+  std::set<DataIdentifier> requested_packets = neighbor.GetRequestedPacketsSet ();
+  std::vector<DataHeader> selected_packets;
+  PacketQueueEntry selected_packet;
+
+  while (selected_packets.size () < max_packets_count
+         && m_packets_queue.Dequeue (m_selected_interface_address.GetLocal (),
+                                     my_position, my_velocity, destination_node_ip,
+                                     destination_node_position, destination_node_velocity,
+                                     requested_packets, selected_packet))
+    {
+      requested_packets.erase (selected_packet.GetDataPacketId ());
+      m_neighbors_table.RemoveNeighborRequestedPacket (destination_node_ip,
+                                                       selected_packet.GetDataPacketId ());
+
+      DataHeader data_packet = selected_packet.GetDataPacket ();
+      data_packet.SetPosition (my_position);
+      data_packet.SetVelocity (my_velocity);
+      data_packet.SetCompactEncoding (m_compact_header_encoding);
+      selected_packets.push_back (data_packet);
+    }
+
+  NS_LOG_DEBUG (selected_packets.size () << " DATA packets selected to be transmitted "
+                "to node " << destination_node_ip);
+
+  // Pack the selected packets in frames, with at least one packet per frame.
+  // The maximum size of the frames includes the IP and UDP headers.
+  const uint32_t max_frame_size = m_max_aggregated_data_size > IP_UDP_HEADERS_SIZE
+          ? m_max_aggregated_data_size - IP_UDP_HEADERS_SIZE : 0u;
+  uint32_t sent_packets_count = 0u;
+  std::vector<DataHeader>::const_iterator packet_it = selected_packets.begin ();
+
+  while (packet_it != selected_packets.end ())
+    {
+      AggregatedDataHeader aggregated_data_header;
+      aggregated_data_header.SetCompactEncoding (m_compact_header_encoding);
+      aggregated_data_header.AddDataPacket (*packet_it);
+
+      // The frame size includes the TypeHeader (1 byte).
+      uint32_t frame_size = 1u + aggregated_data_header.GetSerializedSize ();
+
+      for (++packet_it; packet_it != selected_packets.end ()
+              && aggregated_data_header.GetDataPacketsCount () < AggregatedDataHeader::MAX_DATA_PACKETS;
+              ++packet_it)
+        {
+          const uint32_t data_packet_size = packet_it->GetSerializedSize ();
+
+          if (frame_size + data_packet_size > max_frame_size)
+            break;
+
+          aggregated_data_header.AddDataPacket (*packet_it);
+          frame_size += data_packet_size;
+        }
+
+      const std::vector<DataHeader> & frame_packets = aggregated_data_header.GetDataPackets ();
+      Ptr<Packet> packet_to_send = Create<Packet> ();
+
+      if (frame_packets.size () == 1u)
+        {
+          NS_LOG_DEBUG ("Constructed DATA packet: " << frame_packets.front ());
+          packet_to_send->AddHeader (frame_packets.front ());
+          packet_to_send->AddHeader (TypeHeader (PacketType::Data, m_compact_header_encoding));
+        }
+      else
+        {
+          NS_LOG_DEBUG ("Constructed AGGREGATED_DATA packet: " << aggregated_data_header);
+          packet_to_send->AddHeader (aggregated_data_header);
+          packet_to_send->AddHeader (TypeHeader (PacketType::AggregatedData, m_compact_header_encoding));
+        }
+
+      if (!SendUnicastPacket (packet_to_send, destination_node_ip))
+        {
+          NS_LOG_DEBUG ("DATA frame could not be sent to " << destination_node_ip
+                        << " (maybe node is disabled).");
+          continue;
+        }
+
+      // Count the transmitted frame
+      uint32_t packet_size = RoutingProtocol::CalculateCompletePacketSize (packet_to_send);
+      m_tx_packets_counter.CountPacket (PacketClass::Data, packet_size);
+
+      std::vector<DataIdentifier> frame_packets_ids;
+      frame_packets_ids.reserve (frame_packets.size ());
+
+      for (std::vector<DataHeader>::const_iterator frame_it = frame_packets.begin ();
+              frame_it != frame_packets.end (); ++frame_it)
+        {
+          const DataIdentifier & data_id = frame_it->GetDataIdentifier ();
+          frame_packets_ids.push_back (data_id);
+
+          // Log the transmission
+          m_packets_queue.LogPacketTransmitted (data_id);
+
+          // The packet is outstanding until its ACK is received
+          TrackOutstandingDataPacket (destination_node_ip, data_id, 1u,
+                                      destination_node_position, destination_node_velocity);
+        }
+
+      if (frame_packets_ids.size () > 1u)
+        m_sent_aggregated_frames[std::make_pair (destination_node_ip, frame_packets_ids.front ())]
+              = frame_packets_ids;
+
+      NS_LOG_DEBUG ("DATA frame with " << frame_packets_ids.size () << " packet(s) sent from "
+                    << m_selected_interface_address.GetLocal () << " to " << destination_node_ip);
+
+      sent_packets_count += frame_packets_ids.size ();
+    }
+
+  return sent_packets_count;
+}
+
+bool
+RoutingProtocol::SendInAreaBroadcastDataPacket (const PacketQueueEntry& packet_entry,
+                                                const Vector2D& my_position,
+                                                const Vector2D& my_velocity)
+{
+  NS_LOG_FUNCTION (this << packet_entry.GetDataPacketId ());
+
+  DataHeader data_packet = packet_entry.GetDataPacket ();
+  data_packet.SetPosition (my_position);
+  data_packet.SetVelocity (my_velocity);
+  data_packet.SetCompactEncoding (m_compact_header_encoding);
+  NS_LOG_DEBUG ("Constructed in-area broadcast DATA packet: " << data_packet);
+
+  Ptr<Packet> packet_to_send = Create<Packet> ();
+  packet_to_send->AddHeader (data_packet);
+  packet_to_send->AddHeader (TypeHeader (PacketType::Data, m_compact_header_encoding));
+
+  if (SendBroadcastPacket (packet_to_send))
+    {
+      // Count the transmitted packet
+      uint32_t packet_size = RoutingProtocol::CalculateCompletePacketSize (packet_to_send);
+      m_tx_packets_counter.CountPacket (PacketClass::Data, packet_size);
+
+      // Log the transmission
+      m_packets_queue.LogPacketTransmitted (data_packet.GetDataIdentifier (),
+                                            TransmissionType::Broadcast);
+
+      NS_LOG_DEBUG ("DATA packet " << data_packet.GetDataIdentifier () << " broadcasted from "
+                    << m_selected_interface_address.GetLocal () << " inside its destination area.");
+      return true;
+    }
+
+  NS_LOG_DEBUG ("DATA packet could not be broadcasted (maybe node is disabled).");
+  return false;
+}
+
+bool
+RoutingProtocol::RetransmitDataPacket (const Ipv4Address& destination_node_ip,
+                                       const DataIdentifier& data_id,
+                                       const Vector2D& destination_node_position,
+                                       const Vector2D& destination_node_velocity)
+{
+  NS_LOG_FUNCTION (this << destination_node_ip << data_id);
+
+  uint32_t transmissions_count = 0u;
+  PacketQueueEntry packet_entry;
+
+  if (!m_neighbors_table.FindOutstandingDataPacket (destination_node_ip, data_id, transmissions_count)
+      || !m_packets_queue.Find (data_id, packet_entry))
+    {
+      NS_LOG_DEBUG ("DATA packet " << data_id << " is no longer in the packets queue.");
+      return false;
+    }
+
+  Vector2D my_position, my_velocity;
+  GetNodeMobility (my_position, my_velocity);
+
+  DataHeader data_packet = packet_entry.GetDataPacket ();
+  data_packet.SetPosition (my_position);
+  data_packet.SetVelocity (my_velocity);
+  data_packet.SetCompactEncoding (m_compact_header_encoding);
+
+  Ptr<Packet> packet_to_send = Create<Packet> ();
+  packet_to_send->AddHeader (data_packet);
+  packet_to_send->AddHeader (TypeHeader (PacketType::Data, m_compact_header_encoding));
+
+  if (!SendUnicastPacket (packet_to_send, destination_node_ip))
+    {
+      NS_LOG_DEBUG ("DATA packet could not be retransmitted to "
+                    << destination_node_ip << " (maybe node is disabled).");
+      return false;
+    }
+
+  uint32_t packet_size = RoutingProtocol::CalculateCompletePacketSize (packet_to_send);
+  m_tx_packets_counter.CountPacket (PacketClass::Data, packet_size);
+  m_packets_queue.LogPacketTransmitted (data_id);
+
+  NS_LOG_DEBUG ("DATA packet " << data_id << " retransmitted to " << destination_node_ip
+                << " (transmission #" << (transmissions_count + 1u) << ").");
+
+  TrackOutstandingDataPacket (destination_node_ip, data_id, transmissions_count + 1u,
+                              destination_node_position, destination_node_velocity);
+  return true;
+}
+
 void
 RoutingProtocol::Start ()
 {
@@ -1290,6 +2349,23 @@ RoutingProtocol::Start ()
                 << m_neighbor_min_valid_distance_diff << " meters.");
   m_packets_queue = PacketsQueue (m_gps, m_packets_queue_capacity, m_default_data_packet_replicas);
   m_packets_queue.SetMinVehiclesDistanceDifference (m_neighbor_min_valid_distance_diff);
+  m_packets_queue.SetSummaryVectorLogCapacity (m_summary_vector_log_capacity);
+
+  // A policy set with SetReplicaAllocationPolicy is kept.
+  if (m_replica_allocation_policy == 0)
+    {
+      NS_LOG_DEBUG ("Initialize " << (m_replica_allocation == ReplicaAllocation::Fixed ? "fixed" : "density-adaptive")
+                    << " replica allocation policy.");
+
+      if (m_replica_allocation == ReplicaAllocation::Fixed)
+        m_replica_allocation_policy = Create<FixedReplicaAllocationPolicy> (m_default_data_packet_replicas);
+      else
+        m_replica_allocation_policy = Create<DensityAdaptiveReplicaAllocationPolicy> (m_default_data_packet_replicas,
+                                                                                      m_min_data_packet_replicas,
+                                                                                      m_max_data_packet_replicas,
+                                                                                      m_replica_reference_neighbors,
+                                                                                      m_replica_reference_lifetime);
+    }
 
   NS_LOG_DEBUG ("Initialize neighbors table with an expiration time of "
                 << m_neighbor_expiration_time.GetSeconds () << " seconds.");
@@ -1297,6 +2373,15 @@ RoutingProtocol::Start ()
 
   m_exp_avg_time_slot_neighbors.clear ();
 
+  NS_ABORT_MSG_IF (m_adaptive_hello_interval && GetMinHelloInterval () > m_max_hello_interval,
+                   "The minimum HELLO interval must not be greater than the maximum HELLO interval.");
+
+  // Every aggregated DATA packet takes a slot of the send window, so with a
+  // single slot no packet would ever be aggregated.
+  NS_ABORT_MSG_IF (m_max_aggregated_data_size > 0u && m_data_send_window < 2u,
+                   "The aggregation of DATA packets needs a DATA send window bigger than 1 packet.");
+  m_current_hello_interval = m_hello_timeout;
+
   // If the node is enabled (AKA there's an interface up), set the hello timer.
   NS_LOG_DEBUG ("Set up hello timer if node is enabled.");
 
@@ -1324,6 +2409,19 @@ RoutingProtocol::Stop ()
   CancelHelloPacketTransmission ();
   CancelExponentialAverageCalculation ();
 
+  for (std::map<std::pair<Ipv4Address, DataIdentifier>, EventId>::iterator timeout_it
+          = m_data_ack_timeouts.begin (); timeout_it != m_data_ack_timeouts.end (); ++timeout_it)
+    {
+      timeout_it->second.Cancel ();
+    }
+
+  m_data_ack_timeouts.clear ();
+  m_sent_aggregated_frames.clear ();
+
+  CancelInAreaBroadcasts ();
+  m_in_area_broadcasted_packets.clear ();
+  m_synchronized_digests.clear ();
+
   // Clear memory that won't be used
   m_neighbors_table.Clear ();
   m_packets_queue.Clear ();
@@ -1341,7 +2439,44 @@ void
 RoutingProtocol::ScheduleHelloPacketTransmission ()
 {
   NS_LOG_FUNCTION (this);
-  ScheduleHelloPacketTransmission (m_hello_timeout);
+
+  const Time hello_interval = CalculateHelloInterval ();
+
+  if (hello_interval != m_current_hello_interval)
+    {
+      NS_LOG_DEBUG ("HELLO interval changed from " << m_current_hello_interval.GetMilliSeconds ()
+                    << " to " << hello_interval.GetMilliSeconds () << " milliseconds.");
+
+      m_current_hello_interval = hello_interval;
+      m_hello_interval_trace (hello_interval, m_exponential_average);
+    }
+
+  ScheduleHelloPacketTransmission (hello_interval);
+}
+
+Time
+RoutingProtocol::CalculateHelloInterval () const
+{
+  if (!m_adaptive_hello_interval)
+    return m_hello_timeout;
+
+  // Growth of the interval due to the density of neighbor nodes.
+  const double density_scale = std::max (1.0, m_exponential_average / m_hello_interval_reference_neighbors);
+
+  const uint32_t queue_capacity = m_packets_queue.GetMaxLength ();
+  const double queue_occupancy = queue_capacity == 0u ? 0.0
+          : std::min (1.0, (double) m_packets_queue.Size () / queue_capacity);
+
+  const double scale = 1.0 + (density_scale - 1.0) * (1.0 - queue_occupancy);
+  const Time hello_interval = Seconds (m_hello_timeout.GetSeconds () * scale);
+
+  return std::min (std::max (hello_interval, GetMinHelloInterval ()), m_max_hello_interval);
+}
+
+Time
+RoutingProtocol::GetMinHelloInterval () const
+{
+  return m_min_hello_interval.IsZero () ? m_hello_timeout : m_min_hello_interval;
 }
 
 void
@@ -1388,6 +2523,120 @@ RoutingProtocol::HelloTimerExpire ()
 
   SendHelloPacket ();
   ScheduleHelloPacketTransmission ();
+  ScheduleInAreaBroadcasts ();
+}
+
+bool
+RoutingProtocol::IsDataAckTimeoutEnabled () const
+{
+  return m_data_send_window > 1u || m_max_data_retransmissions > 0u;
+}
+
+void
+RoutingProtocol::TrackOutstandingDataPacket (const Ipv4Address& neighbor_ip,
+                                             const DataIdentifier& data_id,
+                                             uint32_t transmissions_count,
+                                             const Vector2D& neighbor_position,
+                                             const Vector2D& neighbor_velocity)
+{
+  NS_LOG_FUNCTION (this << neighbor_ip << data_id << transmissions_count);
+
+  if (!IsDataAckTimeoutEnabled ())
+    return;
+
+  m_neighbors_table.SetOutstandingDataPacket (neighbor_ip, data_id, transmissions_count);
+  ScheduleDataAckTimeout (neighbor_ip, data_id, neighbor_position, neighbor_velocity);
+}
+
+void
+RoutingProtocol::ScheduleDataAckTimeout (const Ipv4Address& neighbor_ip,
+                                         const DataIdentifier& data_id,
+                                         const Vector2D& neighbor_position,
+                                         const Vector2D& neighbor_velocity)
+{
+  NS_LOG_FUNCTION (this << neighbor_ip << data_id);
+
+  EventId & timeout_event = m_data_ack_timeouts[std::make_pair (neighbor_ip, data_id)];
+  timeout_event.Cancel ();
+  timeout_event = Simulator::Schedule (m_data_retransmission_timeout,
+                                       &RoutingProtocol::DataAckTimeoutExpire, this,
+                                       neighbor_ip, data_id, neighbor_position, neighbor_velocity);
+}
+
+void
+RoutingProtocol::CancelDataAckTimeout (const Ipv4Address& neighbor_ip, const DataIdentifier& data_id)
+{
+  NS_LOG_FUNCTION (this << neighbor_ip << data_id);
+
+  std::map<std::pair<Ipv4Address, DataIdentifier>, EventId>::iterator timeout_it
+          = m_data_ack_timeouts.find (std::make_pair (neighbor_ip, data_id));
+
+  if (timeout_it == m_data_ack_timeouts.end ())
+    return;
+
+  timeout_it->second.Cancel ();
+  m_data_ack_timeouts.erase (timeout_it);
+}
+
+void
+RoutingProtocol::ResetDataSendSession (const Ipv4Address& neighbor_ip)
+{
+  NS_LOG_FUNCTION (this << neighbor_ip);
+
+  m_neighbors_table.ClearOutstandingDataPackets (neighbor_ip);
+  m_packets_queue.ResetTransmitSession (neighbor_ip);
+
+  // The timeouts of the neighbor are contiguous in the map, starting from the
+  // lowest data identifier.
+  std::map<std::pair<Ipv4Address, DataIdentifier>, EventId>::iterator timeout_it
+          = m_data_ack_timeouts.lower_bound (std::make_pair (neighbor_ip, DataIdentifier ()));
+
+  while (timeout_it != m_data_ack_timeouts.end () && timeout_it->first.first == neighbor_ip)
+    {
+      timeout_it->second.Cancel ();
+      timeout_it = m_data_ack_timeouts.erase (timeout_it);
+    }
+
+  std::map<std::pair<Ipv4Address, DataIdentifier>, std::vector<DataIdentifier> >::iterator frame_it
+          = m_sent_aggregated_frames.lower_bound (std::make_pair (neighbor_ip, DataIdentifier ()));
+
+  while (frame_it != m_sent_aggregated_frames.end () && frame_it->first.first == neighbor_ip)
+    {
+      frame_it = m_sent_aggregated_frames.erase (frame_it);
+    }
+}
+
+void
+RoutingProtocol::DataAckTimeoutExpire (const Ipv4Address& neighbor_ip,
+                                       const DataIdentifier& data_id,
+                                       const Vector2D& neighbor_position,
+                                       const Vector2D& neighbor_velocity)
+{
+  NS_LOG_FUNCTION (this << neighbor_ip << data_id);
+
+  m_data_ack_timeouts.erase (std::make_pair (neighbor_ip, data_id));
+
+  // If the packet was the first of an AGGREGATED_DATA frame, the AGGREGATED_ACK
+  // of the frame is no longer expected. The rest of its packets are handled by
+  // their own timeouts.
+  m_sent_aggregated_frames.erase (std::make_pair (neighbor_ip, data_id));
+
+  uint32_t transmissions_count = 0u;
+
+  if (!m_neighbors_table.FindOutstandingDataPacket (neighbor_ip, data_id, transmissions_count))
+    return;
+
+  NS_LOG_DEBUG ("ACK of DATA packet " << data_id << " not received from node "
+                << neighbor_ip << " after " << transmissions_count << " transmissions.");
+
+  if (transmissions_count <= m_max_data_retransmissions
+      && RetransmitDataPacket (neighbor_ip, data_id, neighbor_position, neighbor_velocity))
+    return;
+
+  // Give up the packet, and use its slot of the send window.
+  NS_LOG_DEBUG ("DATA packet " << data_id << " given up.");
+  m_neighbors_table.RemoveOutstandingDataPacket (neighbor_ip, data_id);
+  FillDataSendWindow (neighbor_ip, neighbor_position, neighbor_velocity);
 }
 
 void
@@ -1474,6 +2723,138 @@ RoutingProtocol::CalculateExponentialAverage ()
                 << ", " << time_slot_end.GetSeconds () << "].");
 }
 
+void
+RoutingProtocol::ScheduleInAreaBroadcast (const DataIdentifier& data_id)
+{
+  NS_LOG_FUNCTION (this << data_id);
+
+  if (!m_in_area_broadcast
+      || m_in_area_broadcasts.find (data_id) != m_in_area_broadcasts.end ()
+      || m_in_area_broadcasted_packets.find (data_id) != m_in_area_broadcasted_packets.end ())
+    return;
+
+  PacketQueueEntry packet_entry;
+
+  if (!m_packets_queue.Find (data_id, packet_entry))
+    return;
+
+  Vector2D my_position, my_velocity;
+  GetNodeMobility (my_position, my_velocity);
+
+  if (!packet_entry.GetDataPacket ().GetDestinationGeoTemporalArea ()
+      .IsInsideGeoTemporalArea (my_position, Simulator::Now ()))
+    return;
+
+  // Random delay, so the broadcasts of the other nodes of the area can be
+  // overheard before.
+  const Time random_delay
+          = MilliSeconds (m_uniform_random_variable->GetInteger (0, m_in_area_broadcast_jitter.GetMilliSeconds ()));
+
+  const EventId broadcast_event = Simulator::Schedule (random_delay,
+                                                       &RoutingProtocol::InAreaBroadcastExpire,
+                                                       this, data_id);
+  m_in_area_broadcasts[data_id] = std::make_pair (broadcast_event, 0u);
+
+  NS_LOG_DEBUG ("In-area broadcast of DATA packet " << data_id << " scheduled in "
+                << random_delay.GetMilliSeconds () << " milliseconds.");
+}
+
+void
+RoutingProtocol::ScheduleInAreaBroadcasts ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (!m_in_area_broadcast)
+    return;
+
+  m_packets_queue.Purge ();
+
+  // Forget the broadcasted packets that are no longer stored.
+  std::set<DataIdentifier>::iterator broadcasted_it = m_in_area_broadcasted_packets.begin ();
+
+  while (broadcasted_it != m_in_area_broadcasted_packets.end ())
+    {
+      if (m_packets_queue.Find (*broadcasted_it))
+        ++broadcasted_it;
+      else
+        broadcasted_it = m_in_area_broadcasted_packets.erase (broadcasted_it);
+    }
+
+  Vector2D my_position, my_velocity;
+  GetNodeMobility (my_position, my_velocity);
+
+  std::vector<DataIdentifier> inside_area_packets;
+  m_packets_queue.GetInsideAreaPackets (my_position, inside_area_packets);
+
+  for (std::vector<DataIdentifier>::const_iterator data_id_it = inside_area_packets.begin ();
+          data_id_it != inside_area_packets.end (); ++data_id_it)
+    {
+      ScheduleInAreaBroadcast (*data_id_it);
+    }
+}
+
+void
+RoutingProtocol::InAreaBroadcastExpire (const DataIdentifier& data_id)
+{
+  NS_LOG_FUNCTION (this << data_id);
+
+  m_in_area_broadcasts.erase (data_id);
+  m_packets_queue.Purge ();
+
+  PacketQueueEntry packet_entry;
+
+  if (!m_packets_queue.Find (data_id, packet_entry))
+    {
+      NS_LOG_DEBUG ("DATA packet " << data_id << " no longer stored, in-area broadcast cancelled.");
+      return;
+    }
+
+  Vector2D my_position, my_velocity;
+  GetNodeMobility (my_position, my_velocity);
+
+  if (!packet_entry.GetDataPacket ().GetDestinationGeoTemporalArea ()
+      .IsInsideGeoTemporalArea (my_position, Simulator::Now ()))
+    {
+      NS_LOG_DEBUG ("Node left the destination area of DATA packet " << data_id
+                    << ", in-area broadcast cancelled.");
+      return;
+    }
+
+  // The summary vectors (and ACKs) of the neighbor nodes met in the current
+  // time-slot tell if any of them doesn't carry the packet yet.
+  bool uncovered_neighbor = false;
+
+  for (std::set<Ipv4Address>::const_iterator neighbor_it = m_exp_avg_time_slot_neighbors.begin ();
+          neighbor_it != m_exp_avg_time_slot_neighbors.end () && !uncovered_neighbor; ++neighbor_it)
+    {
+      uncovered_neighbor = !packet_entry.IsKnownCarrierNode (*neighbor_it);
+    }
+
+  if (!uncovered_neighbor)
+    {
+      NS_LOG_DEBUG ("All the neighbor nodes carry DATA packet " << data_id
+                    << ", in-area broadcast suppressed.");
+      return;
+    }
+
+  if (SendInAreaBroadcastDataPacket (packet_entry, my_position, my_velocity))
+    m_in_area_broadcasted_packets.insert (data_id);
+}
+
+void
+RoutingProtocol::CancelInAreaBroadcasts ()
+{
+  NS_LOG_FUNCTION (this);
+
+  for (std::map<DataIdentifier, std::pair<EventId, uint32_t> >::iterator broadcast_it
+          = m_in_area_broadcasts.begin (); broadcast_it != m_in_area_broadcasts.end (); ++broadcast_it)
+    {
+      broadcast_it->second.first.Cancel ();
+    }
+
+  m_in_area_broadcasts.clear ();
+}
+
 void
 RoutingProtocol::Enable ()
 {
@@ -39,6 +39,7 @@
 #include <ns3/packet-utils.h>
 #include <ns3/statistics-utils.h>
 
+#include <ns3/event-id.h>
 #include <ns3/ipv4-address.h>
 #include <ns3/ipv4-interface-address.h>
 #include <ns3/ipv4-routing-protocol.h>
@@ -48,6 +49,7 @@
 #include <ns3/random-variable-stream.h>
 #include <ns3/socket.h>
 #include <ns3/timer.h>
+#include <ns3/traced-callback.h>
 #include <ns3/type-id.h>
 
 
@@ -59,6 +61,12 @@ namespace ns3
 namespace geotemporal
 {
 
+/* Forward declaration */
+namespace test
+{
+class RoutingProtocolTest;
+}
+
 using GeoTemporalLibrary::LibraryUtils::Vector2D;
 
 // =============================================================================
@@ -74,6 +82,11 @@ private:
    */
   static const uint32_t GEO_TEMPORAL_ROUTING_PROTOCOL_PORT = 49765;
 
+  /**
+   * Size (in bytes) of the IP and UDP headers of the transmitted packets.
+   */
+  static const uint32_t IP_UDP_HEADERS_SIZE = 20u + 8u;
+
 
   // ---------------------
   // Protocol parameters
@@ -85,6 +98,51 @@ private:
   /** Hello timer. Controls when the HELLOs are transmitted. */
   Timer m_hello_timer;
 
+  /**
+   * Indicates if the HELLO packets carry the summary vector of the node when
+   * it fits (two-way handshake), so the receiver answers directly with a 
+   * REPLY_BACK or DATA packets instead of a REPLY.
+   */
+  bool m_hello_summary_vector;
+
+  /** Maximum size (in bytes) of the summary vector carried in a HELLO packet. */
+  uint32_t m_max_hello_summary_vector_size;
+
+  /**
+   * Indicates if the HELLO packets carry the digest of the summary vector of
+   * the node, so the receiver skips the anti-entropy sessions that would 
+   * repeat the last one with the same node.
+   */
+  bool m_hello_summary_vector_digest;
+
+  /**
+   * Time during which the digests of an anti-entropy session are used to skip
+   * the following sessions with the same node.
+   */
+  Time m_synchronized_digests_lifetime;
+
+  /**
+   * Indicates if the time interval between HELLO transmissions is scaled with
+   * the exponential adaptative average of neighbor nodes and the occupancy of
+   * the packets queue.
+   */
+  bool m_adaptive_hello_interval;
+
+  /**
+   * Minimum time interval between HELLO transmissions of the adaptive HELLO
+   * interval. Zero means <code>HelloInterval</code>.
+   */
+  Time m_min_hello_interval;
+
+  /** Maximum time interval between HELLO transmissions of the adaptive HELLO interval. */
+  Time m_max_hello_interval;
+
+  /**
+   * Exponential adaptative average of neighbor nodes above which the adaptive
+   * HELLO interval grows.
+   */
+  double m_hello_interval_reference_neighbors;
+
   /** The maximum number of packets that we allow a routing protocol to buffer. */
   uint32_t m_packets_queue_capacity;
 
@@ -95,6 +153,27 @@ private:
   /** Number of replicas of each data packet allowed to be transmitted. */
   uint32_t m_default_data_packet_replicas;
 
+  /** Built-in policy to allocate the replicas of the data packets created by the node. */
+  ReplicaAllocation m_replica_allocation;
+
+  /** Minimum number of replicas of the density-adaptive replica allocation. */
+  uint32_t m_min_data_packet_replicas;
+
+  /** Maximum number of replicas of the density-adaptive replica allocation. */
+  uint32_t m_max_data_packet_replicas;
+
+  /**
+   * Exponential adaptative average of neighbor nodes with which the 
+   * density-adaptive replica allocation gives the default number of replicas.
+   */
+  double m_replica_reference_neighbors;
+
+  /**
+   * Remaining lifetime of a packet with which the density-adaptive replica 
+   * allocation gives the default number of replicas.
+   */
+  Time m_replica_reference_lifetime;
+
   /** Minimum distance (in meters) difference between nodes to be valid packet carriers. */
   double m_neighbor_min_valid_distance_diff;
 
@@ -104,6 +183,65 @@ private:
   /** Exponential average timer. Controls when the exponential average is calculated. */
   Timer m_exponential_average_timer;
 
+  /**
+   * Indicates if the transmitted packets use the compact coordinates encoding
+   * for positions, velocities and areas. Received packets are decoded according
+   * to the flag in their type header regardless of this value.
+   */
+  bool m_compact_header_encoding;
+
+  /** Encoding of the summary vectors of the transmitted REPLY packets. */
+  SummaryVectorEncoding m_summary_vector_encoding;
+
+  /** False positive rate of the Bloom filters of the transmitted summary vectors. */
+  double m_summary_vector_false_positive_rate;
+
+  /**
+   * Maximum number of changes of the summary vector stored to transmit 
+   * incremental summary vectors.
+   */
+  uint32_t m_summary_vector_log_capacity;
+
+  /**
+   * Maximum number of DATA packets sent to a neighbor node whose ACK hasn't 
+   * been received yet. With 1 (and no retransmissions) the DATA transfer is
+   * stop-and-wait.
+   */
+  uint32_t m_data_send_window;
+
+  /** Time to wait for the ACK of a DATA packet before retransmitting it. */
+  Time m_data_retransmission_timeout;
+
+  /** Maximum number of retransmissions of a DATA packet whose ACK isn't received. */
+  uint32_t m_max_data_retransmissions;
+
+  /**
+   * Maximum size (in bytes) of the IP datagrams, including the IP and UDP
+   * headers, of the AGGREGATED_DATA frames that carry several DATA packets to
+   * a neighbor node. With 0 the DATA packets aren't aggregated.
+   * 
+   * Every DATA packet of a frame takes a slot of the send window, so the send
+   * window limits the number of packets aggregated in a frame. The aggregation
+   * needs a send window bigger than 1 packet.
+   */
+  uint32_t m_max_aggregated_data_size;
+
+  /**
+   * Indicates if the DATA packets inside their destination geo-temporal area
+   * are disseminated with one broadcast per node, instead of one unicast 
+   * session per neighbor node.
+   */
+  bool m_in_area_broadcast;
+
+  /** Maximum random delay before the in-area broadcast of a DATA packet. */
+  Time m_in_area_broadcast_jitter;
+
+  /**
+   * Number of broadcasts of a DATA packet overheard from neighbor nodes that 
+   * suppress its pending in-area broadcast.
+   */
+  uint32_t m_in_area_broadcast_suppression_threshold;
+
 
   // ---------------------
   // Internal variables
@@ -118,6 +256,9 @@ private:
   /** Navigation system and GPS used by the vehicle node. */
   Ptr<GpsSystem> m_gps;
 
+  /** Policy that allocates the replicas of the data packets created by the node. */
+  Ptr<const ReplicaAllocationPolicy> m_replica_allocation_policy;
+
   /**
    * The index of the interface used by the protocol (to receive incoming 
    * and transmit outgoing packets).
@@ -176,6 +317,42 @@ private:
   /** Handles duplicated packets. */
   DuplicatedPacketDetector m_duplicate_detector;
 
+  /** Scheduled ACK timeouts of the outstanding DATA packets of each neighbor. */
+  std::map<std::pair<Ipv4Address, DataIdentifier>, EventId> m_data_ack_timeouts;
+
+  /**
+   * DATA packets of the AGGREGATED_DATA frames sent to each neighbor node whose
+   * AGGREGATED_ACK hasn't been received yet. Each frame is identified by the
+   * data ID of its first DATA packet.
+   */
+  std::map<std::pair<Ipv4Address, DataIdentifier>, std::vector<DataIdentifier> > m_sent_aggregated_frames;
+
+  /**
+   * Scheduled in-area broadcasts of DATA packets, with the number of broadcasts
+   * of each packet overheard from neighbor nodes while it is pending.
+   */
+  std::map<DataIdentifier, std::pair<EventId, uint32_t> > m_in_area_broadcasts;
+
+  /** DATA packets already broadcasted (or suppressed) inside their destination area. */
+  std::set<DataIdentifier> m_in_area_broadcasted_packets;
+
+  /**
+   * Digests of the summary vectors of a neighbor node and of the local node 
+   * when the last anti-entropy session between them started. They are only 
+   * used to skip sessions once the neighbor node answered the session 
+   * (<code>m_session_completed</code>).
+   */
+  struct SynchronizedDigests
+  {
+    uint32_t m_neighbor_digest;
+    uint32_t m_local_digest;
+    Time m_expiration_time;
+    bool m_session_completed;
+  };
+
+  /** Synchronized digests of the last anti-entropy session with each neighbor node. */
+  std::map<Ipv4Address, SynchronizedDigests> m_synchronized_digests;
+
   /** Counts the number and size of transmitted packets. */
   PacketsCounter m_tx_packets_counter;
 
@@ -193,9 +370,27 @@ private:
    */
   std::set<Ipv4Address> m_exp_avg_time_slot_neighbors;
 
+  /** Time interval used to schedule the last HELLO transmission. */
+  Time m_current_hello_interval;
+
+  /**
+   * Trace fired when the time interval between HELLO transmissions changes,
+   * with the new interval and the exponential adaptative average.
+   */
+  TracedCallback<Time, double> m_hello_interval_trace;
+
 
 public:
 
+  /**
+   * TracedCallback signature for the changes of the HELLO interval.
+   * 
+   * @param hello_interval [IN] The new time interval between HELLO transmissions.
+   * @param neighbors_average [IN] The exponential adaptative average of neighbor
+   * nodes used to calculate it.
+   */
+  typedef void (* HelloIntervalTracedCallback) (Time hello_interval, double neighbors_average);
+
   RoutingProtocol ();
 
   virtual ~RoutingProtocol ();
@@ -243,6 +438,50 @@ public:
   void
   SetGpsSystem (Ptr<GpsSystem> gps_system);
 
+  inline SummaryVectorEncoding
+  GetSummaryVectorEncoding () const
+  {
+    return m_summary_vector_encoding;
+  }
+
+  /**
+   * Sets the encoding of the summary vectors of the transmitted REPLY packets.
+   * It takes an integer to be used as the setter of the enum attribute.
+   */
+  inline void
+  SetSummaryVectorEncoding (int summary_vector_encoding)
+  {
+    m_summary_vector_encoding = static_cast<SummaryVectorEncoding> (summary_vector_encoding);
+  }
+
+  inline ReplicaAllocation
+  GetReplicaAllocation () const
+  {
+    return m_replica_allocation;
+  }
+
+  /**
+   * Sets the built-in policy to allocate the replicas of the data packets
+   * created by the node. It takes an integer to be used as the setter of the
+   * enum attribute.
+   */
+  inline void
+  SetReplicaAllocation (int replica_allocation)
+  {
+    m_replica_allocation = static_cast<ReplicaAllocation> (replica_allocation);
+  }
+
+  /**
+   * Sets the policy that allocates the replicas of the data packets created by
+   * the node, in place of the built-in policy selected by the 
+   * <code>ReplicaAllocation</code> attribute.
+   */
+  inline void
+  SetReplicaAllocationPolicy (Ptr<const ReplicaAllocationPolicy> replica_allocation_policy)
+  {
+    m_replica_allocation_policy = replica_allocation_policy;
+  }
+
   /** Returns the statistics of all received data packets by the node. */
   inline const std::map<DataIdentifier, DataPacketReceptionStats> &
   GetNodePacketReceptionStats () const
@@ -339,13 +578,62 @@ private:
   /**
    * Processes the received HELLO packets.
    * 
+   * If the HELLO carries the summary vector of the sender node, the node that
+   * initiates the anti-entropy session processes it as a received REPLY, and
+   * every other receiver stores the sender node as a known carrier of its 
+   * packets.
+   * 
+   * If the HELLO carries the digest of the summary vector of the sender node,
+   * the session is skipped when it would be redundant.
+   * 
    * @param received_packet [IN/OUT] The received packet with the HELLO header on 
    * top. The packet is modified, so if you want to conserve the original make
    * sure to use a copy of the received packet.
    * @param sender_node_ip [IN] IP address of the node that sent the packet.
+   * @param compact_encoding [IN] Indicates if the received header uses the
+   * compact coordinates encoding.
+   * @param summary_vector_encoding [IN] Encoding of the summary vector carried
+   * in the HELLO packet, if any.
    */
   void
-  RecvHelloPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip);
+  RecvHelloPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip,
+                   bool compact_encoding,
+                   SummaryVectorEncoding summary_vector_encoding);
+
+  /**
+   * Returns <code>true</code> if an anti-entropy session with the neighbor node
+   * would be redundant according to the digest of its summary vector: if both
+   * nodes have the same packets, or if none of the queues changed since the 
+   * last session between them.
+   * 
+   * The digests may collide, so a match only skips the session: the neighbor
+   * node isn't recorded as a carrier of any packet.
+   * 
+   * @param neighbor_node_ip [IN] IP address of the neighbor node.
+   * @param neighbor_digest [IN] Digest of the summary vector of the neighbor node.
+   */
+  bool
+  IsRedundantSession (const Ipv4Address & neighbor_node_ip, uint32_t neighbor_digest);
+
+  /**
+   * Marks the anti-entropy session started with the neighbor node as completed,
+   * so its synchronized digests can be used to skip the following sessions.
+   * 
+   * It's called when the summary vector of the neighbor node is processed or 
+   * when the neighbor node answers the summary vector of the local node (with 
+   * a REPLY_BACK or DATA packets).
+   * 
+   * @param neighbor_node_ip [IN] IP address of the neighbor node.
+   */
+  void
+  CompleteSynchronizedSession (const Ipv4Address & neighbor_node_ip);
+
+  /**
+   * Removes the expired synchronized digests, and the ones of the sessions that
+   * weren't completed before the neighbor node expired from the neighbors table.
+   */
+  void
+  PurgeSynchronizedDigests ();
 
   /**
    * Processes the received REPLY packets.
@@ -354,9 +642,28 @@ private:
    * top. The packet is modified, so if you want to conserve the original make
    * sure to use a copy of the received packet.
    * @param sender_node_ip [IN] IP address of the node that sent the packet.
+   * @param compact_encoding [IN] Indicates if the received header uses the
+   * compact coordinates encoding.
+   * @param summary_vector_encoding [IN] Encoding of the received summary vector.
    */
   void
-  RecvReplyPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip);
+  RecvReplyPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip,
+                   bool compact_encoding,
+                   SummaryVectorEncoding summary_vector_encoding);
+
+  /**
+   * Computes the mutual disjoint vectors with the exact summary vector of the
+   * neighbor node (received in a REPLY or HELLO packet), stores the packets 
+   * requested by it and the known carriers, and answers with a REPLY_BACK 
+   * packet or starts sending the DATA packets that it doesn't know.
+   * 
+   * @param sender_node_ip [IN] IP address of the neighbor node.
+   * @param summary_vector_header [IN] Header with the whole summary vector, 
+   * position and velocity of the neighbor node.
+   */
+  void
+  ProcessNeighborSummaryVector (const Ipv4Address & sender_node_ip,
+                                const SummaryVectorHeader & summary_vector_header);
 
   /**
    * Processes the received REPLY_BACK packets.
@@ -365,9 +672,24 @@ private:
    * top. The packet is modified, so if you want to conserve the original make
    * sure to use a copy of the received packet.
    * @param sender_node_ip [IN] IP address of the node that sent the packet.
+   * @param compact_encoding [IN] Indicates if the received header uses the
+   * compact coordinates encoding.
+   * @param summary_vector_encoding [IN] Encoding of the received summary vector.
+   */
+  void
+  RecvReplyBackPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip,
+                       bool compact_encoding,
+                       SummaryVectorEncoding summary_vector_encoding);
+
+  /**
+   * Processes the received RESYNC_REQUEST packets: forgets the version of the
+   * summary vector sent to the neighbor node and answers with a REPLY packet
+   * with the whole summary vector.
+   * 
+   * @param sender_node_ip [IN] IP address of the node that sent the packet.
    */
   void
-  RecvReplyBackPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip);
+  RecvResyncRequestPacket (const Ipv4Address & sender_node_ip);
 
   /**
    * Processes the received DATA and DATA_ACK packets.
@@ -378,10 +700,30 @@ private:
    * @param sender_node_ip [IN] IP address of the node that sent the packet.
    * @param ack_flag [IN] With <code>true</code> indicates that the received
    * packet is a DATA_ACK packet, otherwise the received packet is a DATA packet.
+   * @param compact_encoding [IN] Indicates if the received header uses the
+   * compact coordinates encoding.
    */
   void
   RecvDataPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip,
-                  const bool ack_flag);
+                  const bool ack_flag,
+                  bool compact_encoding);
+
+  /**
+   * Processes the DATA packets broadcasted inside their destination 
+   * geo-temporal area. They aren't acknowledged, and each overheard broadcast
+   * counts towards the suppression of the pending in-area broadcast of the 
+   * same packet.
+   * 
+   * @param received_packet [IN/OUT] The received packet with the DATA header on
+   * top. The packet is modified, so if you want to conserve the original make
+   * sure to use a copy of the received packet.
+   * @param sender_node_ip [IN] IP address of the node that sent the packet.
+   * @param compact_encoding [IN] Indicates if the received header uses the
+   * compact coordinates encoding.
+   */
+  void
+  RecvBroadcastDataPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip,
+                           bool compact_encoding);
 
   /**
    * Processes the received ACK packets.
@@ -390,9 +732,42 @@ private:
    * top. The packet is modified, so if you want to conserve the original make
    * sure to use a copy of the received packet.
    * @param sender_node_ip [IN] IP address of the node that sent the packet.
+   * @param compact_encoding [IN] Indicates if the received header uses the
+   * compact coordinates encoding.
+   */
+  void
+  RecvAckPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip,
+                 bool compact_encoding);
+
+  /**
+   * Processes the received AGGREGATED_DATA packets. Each DATA packet of the
+   * frame is processed as a received DATA packet, and all of them are
+   * acknowledged with one AGGREGATED_ACK packet.
+   * 
+   * @param received_packet [IN/OUT] The received packet with the AGGREGATED_DATA
+   * header on top. The packet is modified, so if you want to conserve the
+   * original make sure to use a copy of the received packet.
+   * @param sender_node_ip [IN] IP address of the node that sent the packet.
+   * @param compact_encoding [IN] Indicates if the received header uses the
+   * compact coordinates encoding.
+   */
+  void
+  RecvAggregatedDataPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip,
+                            bool compact_encoding);
+
+  /**
+   * Processes the received AGGREGATED_ACK packets.
+   * 
+   * @param received_packet [IN/OUT] The received packet with the AGGREGATED_ACK
+   * header on top. The packet is modified, so if you want to conserve the
+   * original make sure to use a copy of the received packet.
+   * @param sender_node_ip [IN] IP address of the node that sent the packet.
+   * @param compact_encoding [IN] Indicates if the received header uses the
+   * compact coordinates encoding.
    */
   void
-  RecvAckPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip);
+  RecvAggregatedAckPacket (Ptr<Packet> received_packet, const Ipv4Address & sender_node_ip,
+                           bool compact_encoding);
 
 
 
@@ -461,6 +836,22 @@ private:
   SendReplyBackPacket (const Ipv4Address & destination_node,
                        const std::set<DataIdentifier> & disjoint_vector);
 
+  /**
+   * Sends a REPLY_BACK packet with the Bloom filter of the whole summary vector
+   * of the local node to the specified destination node. It is the answer to a
+   * REPLY with a Bloom filter, whose locally unknown packets can't be listed.
+   */
+  void
+  SendReplyBackFilterPacket (const Ipv4Address & destination_node);
+
+  /**
+   * Sends a RESYNC_REQUEST packet to the specified destination node. It is the
+   * answer to an incremental REPLY whose changes couldn't be applied, and it
+   * requests the whole summary vector of the destination node.
+   */
+  void
+  SendResyncRequestPacket (const Ipv4Address & destination_node);
+
   /**
    * From the set of packets requested by the neighbor node it selects the packet
    * with the highest transmission priority for which the neighbor node is a 
@@ -482,6 +873,10 @@ private:
    * transmitted to the neighbor node it sends instead an ACK packet. This is
    * because there are no data packets to send, but the ACK must be transmitted.
    * 
+   * The transmitted packet is outstanding until its ACK is received (see
+   * <code>TrackOutstandingDataPacket</code>). This function doesn't check the
+   * send window, see <code>FillDataSendWindow</code>.
+   * 
    * @param destination_node_ip [IN] IP address of the destination node.
    * @param destination_node_position [IN] Last reported position of the neighbor
    * node.
@@ -494,8 +889,10 @@ private:
    * DataIdentifier object) The ID of the data packet to be acknowledged as 
    * successfully received. Only used when <code>ack_flag</code> is set to
    * <code>true</code>.
+   * 
+   * @return <code>true</code> if a DATA or DATA_ACK packet was transmitted.
    */
-  void
+  bool
   SendDataPacket (const Ipv4Address & destination_node_ip,
                   const Vector2D & destination_node_position,
                   const Vector2D & destination_node_velocity,
@@ -510,6 +907,87 @@ private:
   SendAckPacket (const Ipv4Address & destination_node,
                  const DataIdentifier & data_id_to_ack);
 
+  /**
+   * Transmits via unicast an AGGREGATED_ACK packet to acknowledge the reception
+   * of the DATA packets of the AGGREGATED_DATA frame whose first DATA packet has
+   * the given DATA ID to the node with the specified IP address.
+   */
+  void
+  SendAggregatedAckPacket (const Ipv4Address & destination_node,
+                           const DataIdentifier & first_data_id,
+                           const std::vector<bool> & received_packets);
+
+  /**
+   * Transmits DATA packets requested by the neighbor node until there are 
+   * <code>DataSendWindow</code> packets sent to it whose ACK hasn't been 
+   * received, or until no more packets can be selected.
+   * 
+   * In stop-and-wait mode no packet is outstanding, so it transmits a single
+   * packet.
+   * 
+   * If <code>MaxAggregatedDataSize</code> is set the packets are aggregated, 
+   * see <code>SendAggregatedDataPackets</code>.
+   * 
+   * @param destination_node_ip [IN] IP address of the destination node.
+   * @param destination_node_position [IN] Last reported position of the neighbor
+   * node.
+   * @param destination_node_velocity [IN] Last reported velocity vector of the
+   * neighbor node.
+   */
+  void
+  FillDataSendWindow (const Ipv4Address & destination_node_ip,
+                      const Vector2D & destination_node_position,
+                      const Vector2D & destination_node_velocity);
+
+  /**
+   * Selects up to the given number of DATA packets requested by the neighbor
+   * node and transmits them packed in AGGREGATED_DATA frames of at most
+   * <code>MaxAggregatedDataSize</code> bytes (including the IP and UDP
+   * headers). A frame with a single DATA packet is transmitted as a DATA 
+   * packet, even if it is bigger.
+   * 
+   * Each transmitted DATA packet is outstanding until its ACK (or the
+   * AGGREGATED_ACK of its frame) is received.
+   * 
+   * @param destination_node_ip [IN] IP address of the destination node.
+   * @param destination_node_position [IN] Last reported position of the neighbor
+   * node.
+   * @param destination_node_velocity [IN] Last reported velocity vector of the
+   * neighbor node.
+   * @param max_packets_count [IN] Maximum number of DATA packets to transmit.
+   * 
+   * @return The number of transmitted DATA packets.
+   */
+  uint32_t
+  SendAggregatedDataPackets (const Ipv4Address & destination_node_ip,
+                             const Vector2D & destination_node_position,
+                             const Vector2D & destination_node_velocity,
+                             const uint32_t max_packets_count);
+
+  /**
+   * Broadcasts the given DATA packet to all the neighbor nodes, as an in-area
+   * broadcast.
+   * 
+   * @return <code>true</code> if the packet was sent, otherwise <code>false</code>.
+   */
+  bool
+  SendInAreaBroadcastDataPacket (const PacketQueueEntry & packet_entry,
+                                 const Vector2D & my_position,
+                                 const Vector2D & my_velocity);
+
+  /**
+   * Transmits again the outstanding DATA packet with the given data ID to the
+   * neighbor node.
+   * 
+   * @return <code>true</code> if the packet was transmitted. If the packet is
+   * no longer in the packets queue it returns <code>false</code>.
+   */
+  bool
+  RetransmitDataPacket (const Ipv4Address & destination_node_ip,
+                        const DataIdentifier & data_id,
+                        const Vector2D & destination_node_position,
+                        const Vector2D & destination_node_velocity);
+
 
 
   // ---------------------
@@ -542,6 +1020,30 @@ private:
   void
   ScheduleHelloPacketTransmission ();
 
+  /**
+   * Returns the time interval until the next HELLO transmission.
+   * 
+   * If the adaptive HELLO interval is disabled it returns 
+   * <code>HelloInterval</code>. Otherwise <code>HelloInterval</code> is scaled
+   * by the ratio between the exponential adaptative average of neighbor nodes
+   * and <code>HelloIntervalReferenceNeighbors</code> (when it's greater than 
+   * 1), so that nodes in dense areas transmit fewer HELLOs. The growth is 
+   * reduced in proportion to the occupancy of the packets queue, because a 
+   * node with packets to share needs to meet the new neighbors sooner. The 
+   * result is bounded by <code>GetMinHelloInterval</code> and 
+   * <code>MaxHelloInterval</code>.
+   */
+  Time
+  CalculateHelloInterval () const;
+
+  /**
+   * Returns the minimum time interval between HELLO transmissions of the 
+   * adaptive HELLO interval: <code>MinHelloInterval</code>, or 
+   * <code>HelloInterval</code> if it's zero.
+   */
+  Time
+  GetMinHelloInterval () const;
+
   /**
    * Schedules the next transmission of the HELLO packet after the given time
    * delay has passed.
@@ -572,6 +1074,68 @@ private:
   void
   HelloTimerExpire ();
 
+  /**
+   * Returns <code>true</code> if the DATA packets sent to the neighbor nodes
+   * wait for their ACK with a timeout, i.e. the send window is bigger than 1
+   * packet or the retransmissions are enabled.
+   * 
+   * Otherwise the DATA transfer is stop-and-wait: the sent packets aren't 
+   * outstanding, so a lost ACK can't stall the transfer with the neighbor.
+   */
+  bool
+  IsDataAckTimeoutEnabled () const;
+
+  /**
+   * Sets the DATA packet with the given data ID, transmitted the given number
+   * of times, as outstanding until its ACK is received from the neighbor node,
+   * and schedules its ACK timeout.
+   * 
+   * In stop-and-wait mode (see <code>IsDataAckTimeoutEnabled</code>) it does
+   * nothing.
+   */
+  void
+  TrackOutstandingDataPacket (const Ipv4Address & neighbor_ip,
+                              const DataIdentifier & data_id,
+                              uint32_t transmissions_count,
+                              const Vector2D & neighbor_position,
+                              const Vector2D & neighbor_velocity);
+
+  /**
+   * Schedules the ACK timeout of the DATA packet with the given data ID sent 
+   * to the neighbor node. When it expires the packet is retransmitted (up to
+   * <code>MaxDataRetransmissions</code> times) or given up.
+   */
+  void
+  ScheduleDataAckTimeout (const Ipv4Address & neighbor_ip,
+                          const DataIdentifier & data_id,
+                          const Vector2D & neighbor_position,
+                          const Vector2D & neighbor_velocity);
+
+  /**
+   * Cancels the ACK timeout of the DATA packet with the given data ID sent to
+   * the neighbor node, if any.
+   */
+  void
+  CancelDataAckTimeout (const Ipv4Address & neighbor_ip, const DataIdentifier & data_id);
+
+  /**
+   * Starts a new DATA transfer session with the neighbor node: forgets its
+   * outstanding DATA packets and AGGREGATED_DATA frames, and cancels their ACK
+   * timeouts.
+   */
+  void
+  ResetDataSendSession (const Ipv4Address & neighbor_ip);
+
+  /**
+   * Retransmits the outstanding DATA packet if it has retransmissions left. 
+   * Otherwise it gives up the packet and uses its slot of the send window to
+   * transmit another requested packet.
+   */
+  void
+  DataAckTimeoutExpire (const Ipv4Address & neighbor_ip, const DataIdentifier & data_id,
+                        const Vector2D & neighbor_position,
+                        const Vector2D & neighbor_velocity);
+
   /**
    * Schedules the next calculation of the exponential adaptative average after
    * the default time interval has passed.
@@ -613,6 +1177,36 @@ private:
   void
   CalculateExponentialAverage ();
 
+  /**
+   * Schedules, after a random delay of up to <code>InAreaBroadcastJitter</code>,
+   * the in-area broadcast of the given DATA packet if the in-area broadcast is
+   * enabled, the local node is inside the destination geo-temporal area of the
+   * packet, and the packet wasn't broadcasted by the node before.
+   */
+  void
+  ScheduleInAreaBroadcast (const DataIdentifier & data_id);
+
+  /**
+   * Schedules the in-area broadcast of all the stored DATA packets whose 
+   * destination geo-temporal area contains the local node, so the packets that
+   * the node carried into their area are broadcasted too.
+   */
+  void
+  ScheduleInAreaBroadcasts ();
+
+  /**
+   * Broadcasts the DATA packet unless it is suppressed: the local node left its
+   * destination area, or the summary vectors show that all the neighbor nodes
+   * met in the current time-slot already carry it. A packet suppressed by the
+   * summary vectors may be scheduled again later.
+   */
+  void
+  InAreaBroadcastExpire (const DataIdentifier & data_id);
+
+  /** Cancels all the pending in-area broadcasts. */
+  void
+  CancelInAreaBroadcasts ();
+
 
 
 public:
@@ -626,6 +1220,7 @@ public:
   /** Disables the node. When disabled, it can not send nor receive packets. */
   void Disable ();
 
+  friend test::RoutingProtocolTest;
 };
 
 } // namespace geotemporal
@@ -34,6 +34,13 @@
 #include <ns3/packet.h>
 #include <ns3/packet-utils.h>
 
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/internet-stack-helper.h>
+#include <ns3/ipv4.h>
+#include <ns3/node.h>
+#include <ns3/socket.h>
+#include <ns3/udp-socket-factory.h>
+
 using namespace GeoTemporalLibrary::LibraryUtils;
 
 
@@ -166,6 +173,18 @@ public:
     pt = PacketType::DataAck;
     NS_TEST_EXPECT_MSG_EQ (pt, PacketType::DataAck, "Must be DataAck");
     NS_TEST_EXPECT_MSG_EQ (ToString (pt), "DataAck", "Must be DataAck");
+
+    pt = PacketType::AggregatedData;
+    NS_TEST_EXPECT_MSG_EQ (pt, PacketType::AggregatedData, "Must be AggregatedData");
+    NS_TEST_EXPECT_MSG_EQ (ToString (pt), "AggregatedData", "Must be AggregatedData");
+
+    pt = PacketType::AggregatedAck;
+    NS_TEST_EXPECT_MSG_EQ (pt, PacketType::AggregatedAck, "Must be AggregatedAck");
+    NS_TEST_EXPECT_MSG_EQ (ToString (pt), "AggregatedAck", "Must be AggregatedAck");
+
+    pt = PacketType::ResyncRequest;
+    NS_TEST_EXPECT_MSG_EQ (pt, PacketType::ResyncRequest, "Must be ResyncRequest");
+    NS_TEST_EXPECT_MSG_EQ (ToString (pt), "ResyncRequest", "Must be ResyncRequest");
   }
 };
 
@@ -258,6 +277,94 @@ public:
     NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
   }
 
+  void
+  TestCompactEncodingFlag ()
+  {
+    TypeHeader h1 (PacketType::DataAck, true);
+    NS_TEST_EXPECT_MSG_EQ (h1.IsCompactEncoding (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 1u, "Must be 1u");
+
+    TypeHeader h2 (PacketType::DataAck);
+    NS_TEST_EXPECT_MSG_EQ (h2.IsCompactEncoding (), false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ ((h1 == h2), false, "Must be different");
+
+    h2.SetCompactEncoding (true);
+    NS_TEST_EXPECT_MSG_EQ (h1, h2, "Must be equal");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (TypeHeader (PacketType::Hello));
+    packet->AddHeader (h1);
+
+    TypeHeader deserialized;
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetPacketType (), PacketType::DataAck, "Must be DataAck");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsCompactEncoding (), true, "Must be true");
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetPacketType (), PacketType::Hello, "Must be Hello");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsCompactEncoding (), false, "Must be false");
+  }
+
+  void
+  TestSummaryVectorEncoding ()
+  {
+    TypeHeader h1 (PacketType::Reply, true, SummaryVectorEncoding::BloomFilter);
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSummaryVectorEncoding (), SummaryVectorEncoding::BloomFilter,
+                           "Must be BloomFilter");
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 1u, "Must be 1u");
+
+    TypeHeader h2 (PacketType::ReplyBack, false, SummaryVectorEncoding::DeltaCoded);
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSummaryVectorEncoding (), SummaryVectorEncoding::DeltaCoded,
+                           "Must be DeltaCoded");
+
+    TypeHeader h3 (PacketType::ReplyBack);
+    NS_TEST_EXPECT_MSG_EQ (h3.GetSummaryVectorEncoding (), SummaryVectorEncoding::Explicit,
+                           "Must be Explicit");
+    NS_TEST_EXPECT_MSG_EQ ((h2 == h3), false, "Must be different");
+
+    h3.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+    NS_TEST_EXPECT_MSG_EQ (h2, h3, "Must be equal");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h2);
+    packet->AddHeader (h1);
+
+    TypeHeader deserialized;
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized, h1, "Serialization and deserialization works");
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized, h2, "Serialization and deserialization works");
+
+    // Incremental summary vector encoding (bits 5-6 set)
+    uint8_t incremental_encoding = 0x60 | (uint8_t) PacketType::Reply;
+    packet = Create<Packet> (&incremental_encoding, 1u);
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetPacketType (), PacketType::Reply, "Must be Reply");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVectorEncoding (), SummaryVectorEncoding::Incremental,
+                           "Must be Incremental");
+
+    // The RESYNC_REQUEST packet only contains the Type header
+    packet = Create<Packet> ();
+    packet->AddHeader (TypeHeader (PacketType::ResyncRequest));
+    NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), 1u, "Must be 1u");
+
+    packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (deserialized.IsValid (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetPacketType (), PacketType::ResyncRequest,
+                           "Must be ResyncRequest");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVectorEncoding (), SummaryVectorEncoding::Explicit,
+                           "Must be Explicit");
+  }
+
   void
   DoRun () override
   {
@@ -265,6 +372,8 @@ public:
     TestGettersSetters ();
     TestOverloadedOperators ();
     TestSerializationDeserialization ();
+    TestCompactEncodingFlag ();
+    TestSummaryVectorEncoding ();
   }
 };
 
@@ -376,6 +485,83 @@ public:
     NS_TEST_EXPECT_MSG_EQ (h.ToString (), expected_str, "Expected string: " + expected_str);
   }
 
+  void
+  TestSummaryVectorFlag ()
+  {
+    HelloHeader plain (Ipv4Address ("1.2.3.4"), 2u);
+    HelloHeader with_summary_vector (plain);
+
+    NS_TEST_EXPECT_MSG_EQ (plain.HasSummaryVector (), false, "Must be false");
+
+    with_summary_vector.SetSummaryVectorFlag (true);
+
+    NS_TEST_EXPECT_MSG_EQ (with_summary_vector.HasSummaryVector (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (with_summary_vector.GetSerializedSize (), 7u, "Must be 7u");
+    NS_TEST_EXPECT_MSG_EQ ((plain != with_summary_vector), true, "Must be different");
+    NS_TEST_EXPECT_MSG_EQ (with_summary_vector.ToString (),
+                           "HELLO from 1.2.3.4 who knows 2 packets (summary vector attached)",
+                           "Must be equal");
+
+    // The summary vector header follows the HELLO header.
+    SummaryVectorHeader summary_vector_header ({DataIdentifier ("1.2.3.4:1"), DataIdentifier ("1.2.3.4:2")},
+                                               GeoTemporalLibrary::LibraryUtils::Vector2D (10, 20),
+                                               GeoTemporalLibrary::LibraryUtils::Vector2D (1, 2));
+    summary_vector_header.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (summary_vector_header);
+    packet->AddHeader (with_summary_vector);
+    packet->AddHeader (TypeHeader (PacketType::Hello, false, SummaryVectorEncoding::DeltaCoded));
+
+    TypeHeader type_header;
+    HelloHeader hello_header;
+    SummaryVectorHeader deserialized_summary_vector;
+
+    packet->RemoveHeader (type_header);
+    packet->RemoveHeader (hello_header);
+
+    NS_TEST_EXPECT_MSG_EQ (hello_header, with_summary_vector, "Must be equal");
+    NS_TEST_EXPECT_MSG_EQ (hello_header.HasSummaryVector (), true, "Must be true");
+
+    deserialized_summary_vector.SetSummaryVectorEncoding (type_header.GetSummaryVectorEncoding ());
+    packet->RemoveHeader (deserialized_summary_vector);
+
+    NS_TEST_EXPECT_MSG_EQ (deserialized_summary_vector.GetSummaryVector ().size (), 2u, "Must be 2");
+    NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), 0u, "Must be 0");
+
+    with_summary_vector.SetSummaryVectorFlag (false);
+
+    NS_TEST_EXPECT_MSG_EQ ((plain == with_summary_vector), true, "Must be equal");
+  }
+
+  void
+  TestSummaryVectorDigest ()
+  {
+    HelloHeader plain (Ipv4Address ("1.2.3.4"), 2u);
+    HelloHeader with_digest (plain);
+
+    NS_TEST_EXPECT_MSG_EQ (plain.HasSummaryVectorDigest (), false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ (plain.GetSerializedSize (), 7u, "Must be 7u");
+
+    with_digest.SetSummaryVectorDigest (0xA1B2C3D4u);
+
+    NS_TEST_EXPECT_MSG_EQ (with_digest.HasSummaryVectorDigest (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (with_digest.GetSummaryVectorDigest (), 0xA1B2C3D4u, "Must be 0xA1B2C3D4u");
+    NS_TEST_EXPECT_MSG_EQ (with_digest.GetSerializedSize (), 11u, "Must be 11u");
+    NS_TEST_EXPECT_MSG_EQ (with_digest.HasSummaryVector (), false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ ((plain != with_digest), true, "Must be different");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (with_digest);
+
+    HelloHeader deserialized;
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 11u, "HelloHeader with digest is 11 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (deserialized, with_digest, "Serialization of HelloHeader with digest");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVectorDigest (), 0xA1B2C3D4u, "Must be 0xA1B2C3D4u");
+  }
+
   void
   DoRun () override
   {
@@ -384,6 +570,8 @@ public:
     TestOverloadedOperators ();
     TestSerializationDeserialization ();
     TestToString ();
+    TestSummaryVectorFlag ();
+    TestSummaryVectorDigest ();
   }
 };
 
@@ -571,6 +759,182 @@ public:
     NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
   }
 
+  void
+  TestCompactSerializationDeserialization ()
+  {
+    std::set<DataIdentifier> summary_vector = {DataIdentifier (Ipv4Address ("1.1.1.1"), 1),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 2),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 3)};
+
+    SummaryVectorHeader h1;
+    SummaryVectorHeader h2 (summary_vector,
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (5, -14),
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (-8.86, 123.098));
+    SummaryVectorHeader h3 (std::set<DataIdentifier>({DataIdentifier (Ipv4Address ("1.1.1.1"), 1)}),
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (981597.52, 719536.02),
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (5.5559, -1.1111));
+
+    h1.SetCompactEncoding (true);
+    h2.SetCompactEncoding (true);
+    h3.SetCompactEncoding (true);
+
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 6u, "Must be 6u");
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSerializedSize (), 32u, "Must be 32u");
+    NS_TEST_EXPECT_MSG_EQ (h3.GetSerializedSize (), 24u, "Must be 24u");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+    packet->AddHeader (h2);
+    packet->AddHeader (h3);
+
+    SummaryVectorHeader deserialized;
+    deserialized.SetCompactEncoding (true);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 24u, "Compact SummaryVectorHeader is 24 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h3, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 32u, "Compact SummaryVectorHeader is 32 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 6u, "Compact SummaryVectorHeader is 6 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+
+    // The packet metadata recreates the headers from their type ID.
+    NS_TEST_EXPECT_MSG_EQ (h2.GetInstanceTypeId (), CompactSummaryVectorHeader::GetTypeId (),
+                           "Must be the type ID of the compact header");
+    NS_TEST_EXPECT_MSG_EQ (SummaryVectorHeader ().GetInstanceTypeId (), SummaryVectorHeader::GetTypeId (),
+                           "Must be the type ID of the fixed-size header");
+
+    packet->AddHeader (h2);
+
+    Callback<ObjectBase *> constructor = h2.GetInstanceTypeId ().GetConstructor ();
+    SummaryVectorHeader * recreated = dynamic_cast<SummaryVectorHeader *> (constructor ());
+
+    NS_TEST_EXPECT_MSG_EQ (recreated->IsCompactEncoding (), true, "Must use the compact encoding");
+
+    read_bytes = packet->RemoveHeader (*recreated);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 32u, "Compact SummaryVectorHeader is 32 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, *recreated, "Serialization and deserialization works");
+
+    delete recreated;
+  }
+
+  void
+  TestDeltaCodedSerializationDeserialization ()
+  {
+    std::set<DataIdentifier> summary_vector = {DataIdentifier (Ipv4Address ("1.1.1.1"), 1),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 2),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 3),
+      DataIdentifier (Ipv4Address ("2.2.2.2"), 300)};
+
+    SummaryVectorHeader h1;
+    SummaryVectorHeader h2 (summary_vector,
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (5, -14),
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (-8.86, 123.098));
+
+    h1.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+    h2.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+
+    // 1 byte of groups count, (4 + 1 + 1 + 2) bytes of the first group and
+    // (4 + 1 + 2) bytes of the second group.
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 27u + 1u, "Must be 28u");
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSerializedSize (), 27u + 16u, "Must be 43u");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+    packet->AddHeader (h2);
+
+    SummaryVectorHeader deserialized;
+    deserialized.SetSummaryVectorEncoding (SummaryVectorEncoding::DeltaCoded);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 43u, "Delta-coded SummaryVectorHeader is 43 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, deserialized, "Serialization and deserialization works");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVector (), summary_vector, "Must be equal");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 28u, "Delta-coded SummaryVectorHeader is 28 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+  }
+
+  void
+  TestIncrementalSerializationDeserialization ()
+  {
+    std::set<DataIdentifier> inserted_packets = {DataIdentifier (Ipv4Address ("1.1.1.1"), 4),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 5)};
+    std::set<DataIdentifier> removed_packets = {DataIdentifier (Ipv4Address ("2.2.2.2"), 300)};
+
+    SummaryVectorHeader h1 (inserted_packets,
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (5, -14),
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (-8.86, 123.098));
+    h1.SetSummaryVectorEncoding (SummaryVectorEncoding::Incremental);
+    h1.SetRemovedPackets (removed_packets);
+    h1.SetVersions (130u, 135u);
+
+    NS_TEST_EXPECT_MSG_EQ (h1.GetBaseVersion (), 130u, "Must be 130u");
+    NS_TEST_EXPECT_MSG_EQ (h1.GetVersion (), 135u, "Must be 135u");
+    NS_TEST_EXPECT_MSG_EQ (h1.GetRemovedPackets (), removed_packets, "Must be equal");
+
+    // 2 + 2 bytes of versions, (1 + 4 + 1 + 1 + 1) bytes of inserted packets
+    // and (1 + 4 + 1 + 2) bytes of removed packets.
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 27u + 4u + 8u + 8u, "Must be 47u");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+
+    SummaryVectorHeader deserialized;
+    deserialized.SetSummaryVectorEncoding (SummaryVectorEncoding::Incremental);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 47u, "Incremental SummaryVectorHeader is 47 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVector (), inserted_packets, "Must be equal");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetRemovedPackets (), removed_packets, "Must be equal");
+  }
+
+  void
+  TestBloomFilterSerializationDeserialization ()
+  {
+    std::set<DataIdentifier> summary_vector = {DataIdentifier (Ipv4Address ("1.1.1.1"), 1),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 2),
+      DataIdentifier (Ipv4Address ("1.1.1.1"), 3),
+      DataIdentifier (Ipv4Address ("2.2.2.2"), 300)};
+
+    DataIdentifierBloomFilter bloom_filter (summary_vector, 0.01);
+
+    SummaryVectorHeader h1 (std::set<DataIdentifier> (),
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (5, -14),
+                            GeoTemporalLibrary::LibraryUtils::Vector2D (-8.86, 123.098));
+    h1.SetSummaryVectorEncoding (SummaryVectorEncoding::BloomFilter);
+    h1.SetBloomFilter (bloom_filter, summary_vector.size ());
+
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSummaryVectorSize (), 4u, "Must be 4u");
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 27u + bloom_filter.GetSerializedSize (),
+                           "Must be the size of the filter plus 27 bytes");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+
+    SummaryVectorHeader deserialized;
+    deserialized.SetSummaryVectorEncoding (SummaryVectorEncoding::BloomFilter);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, h1.GetSerializedSize (), "Must be the serialized size");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVectorSize (), 4u, "Must be 4u");
+    NS_TEST_EXPECT_MSG_EQ (deserialized.GetSummaryVector ().empty (), true, "Must be true");
+
+    for (std::set<DataIdentifier>::const_iterator it = summary_vector.begin ();
+            it != summary_vector.end (); ++it)
+      {
+        NS_TEST_EXPECT_MSG_EQ (deserialized.GetBloomFilter ().MayContain (*it), true,
+                               "Must be true");
+      }
+  }
+
   void
   TestToString ()
   {
@@ -595,6 +959,10 @@ public:
     TestGettersSetters ();
     TestOverloadedOperators ();
     TestSerializationDeserialization ();
+    TestCompactSerializationDeserialization ();
+    TestDeltaCodedSerializationDeserialization ();
+    TestIncrementalSerializationDeserialization ();
+    TestBloomFilterSerializationDeserialization ();
     TestToString ();
   }
 };
@@ -1085,6 +1453,61 @@ public:
     NS_TEST_EXPECT_MSG_EQ (h2.GetSerializedSize (), 73u + 30u, "Must be 103u");
   }
 
+  void
+  TestCompactSerializationDeserialization ()
+  {
+    DataHeader h1 (DataIdentifier ("1.2.3.4:5"), false, 65u,
+                   GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                   GeoTemporalLibrary::LibraryUtils::Vector2D (-8.86, 123.098),
+                   GeoTemporalArea (TimePeriod (Seconds (10), Seconds (20)), Area (30, 40, 50, 60)),
+                   "packet's message"); // Message length = 16
+    DataHeader h2 (DataIdentifier ("10.9.8.7:64321"), true, 32147u,
+                   GeoTemporalLibrary::LibraryUtils::Vector2D (-50.63, 159),
+                   GeoTemporalLibrary::LibraryUtils::Vector2D (5.5559, -1.1111),
+                   GeoTemporalArea (TimePeriod (Seconds (10), Seconds (20)), Area (-100, 40, 50, -90)),
+                   "012345678901234567890123456789"); // Message length = 30
+
+    h1.SetCompactEncoding (true);
+    h2.SetCompactEncoding (true);
+
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 52u, "Must be 52u");
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSerializedSize (), 69u, "Must be 69u");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+    packet->AddHeader (h2);
+
+    DataHeader deserialized;
+    deserialized.SetCompactEncoding (true);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 69u, "Compact DataHeader is 69 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 52u, "Compact DataHeader is 52 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+
+    // The packet metadata recreates the headers from their type ID.
+    NS_TEST_EXPECT_MSG_EQ (h2.GetInstanceTypeId (), CompactDataHeader::GetTypeId (),
+                           "Must be the type ID of the compact header");
+    NS_TEST_EXPECT_MSG_EQ (DataHeader ().GetInstanceTypeId (), DataHeader::GetTypeId (),
+                           "Must be the type ID of the fixed-size header");
+
+    packet->AddHeader (h2);
+
+    Callback<ObjectBase *> constructor = h2.GetInstanceTypeId ().GetConstructor ();
+    DataHeader * recreated = dynamic_cast<DataHeader *> (constructor ());
+
+    NS_TEST_EXPECT_MSG_EQ (recreated->IsCompactEncoding (), true, "Must use the compact encoding");
+
+    read_bytes = packet->RemoveHeader (*recreated);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 69u, "Compact DataHeader is 69 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, *recreated, "Serialization and deserialization works");
+
+    delete recreated;
+  }
+
   void
   TestToString ()
   {
@@ -1120,6 +1543,7 @@ public:
     TestGettersSetters ();
     TestOverloadedOperators ();
     TestSerializationDeserialization ();
+    TestCompactSerializationDeserialization ();
     TestToString ();
   }
 };
@@ -1548,81 +1972,334 @@ public:
 
 
 // =============================================================================
-//                               NeighborEntryTest
+//                           AggregatedDataHeaderTest
 // =============================================================================
 
 /**
- * NeighborEntry for the neighbors table test suite.
+ * AggregatedDataHeader packet header test suite.
  * 
  * \ingroup tests
  * \ingroup geotemporal-test
  */
-class NeighborEntryTest : public TestCasePlus
+class AggregatedDataHeaderTest : public TestCasePlus
 {
 public:
 
-  NeighborEntry m_neighbor_entry;
+  AggregatedDataHeaderTest () : TestCasePlus ("AggregatedDataHeader") { }
 
-  NeighborEntryTest () : TestCasePlus ("NeighborEntry"), m_neighbor_entry () { }
+  DataHeader
+  CreateDataHeader (const uint32_t index) const
+  {
+    char buffer[20];
+    std::sprintf (buffer, "1.2.3.4:%u", index);
+
+    return DataHeader (DataIdentifier (buffer), index % 2u == 0u, index,
+                       GeoTemporalLibrary::LibraryUtils::Vector2D (-50.63, 159),
+                       GeoTemporalLibrary::LibraryUtils::Vector2D (5.5559, -1.1111),
+                       GeoTemporalArea (TimePeriod (Seconds (10), Seconds (20)), Area (-100, 40, 50, -90)),
+                       "packet's message"); // Message length = 16
+  }
 
   void
-  TestConstructors ()
+  TestAddDataPacket ()
   {
-    // Default constructor
-    NeighborEntry e1;
-    NS_TEST_EXPECT_MSG_EQ (e1.GetNeighborIpAddress (), Ipv4Address (), "Must be default IP");
-    NS_TEST_EXPECT_MSG_EQ (e1.GetExpirationTime (), Time (), "Must be default time (0)");
-    NS_TEST_EXPECT_MSG_EQ (e1.GetRequestedPacketsSet ().empty (), true, "Must be an empty set");
+    AggregatedDataHeader h;
+    NS_TEST_EXPECT_MSG_EQ (h.GetDataPacketsCount (), 0u, "Must be empty");
+    NS_TEST_EXPECT_MSG_EQ (h.GetSerializedSize (), 1u, "Must be 1 byte long");
 
-    // Parameters constructor 1
-    NeighborEntry e2 (Ipv4Address ("1.2.3.4"), Seconds (10));
-    NS_TEST_EXPECT_MSG_EQ (e2.GetNeighborIpAddress (), Ipv4Address ("1.2.3.4"), "Must be 1.2.3.4");
-    NS_TEST_EXPECT_MSG_EQ (e2.GetExpirationTime (), Seconds (10), "Must be 10 seconds");
-    NS_TEST_EXPECT_MSG_EQ (e2.GetRequestedPacketsSet ().empty (), true, "Must be an empty set");
+    h.AddDataPacket (CreateDataHeader (1u));
+    h.AddDataPacket (CreateDataHeader (2u));
+    NS_TEST_EXPECT_MSG_EQ (h.GetDataPacketsCount (), 2u, "Must have 2 packets");
+    NS_TEST_EXPECT_MSG_EQ (h.GetDataPackets ()[0], CreateDataHeader (1u), "Must be the first added packet");
+    NS_TEST_EXPECT_MSG_EQ (h.GetDataPackets ()[1], CreateDataHeader (2u), "Must be the second added packet");
+    NS_TEST_EXPECT_MSG_EQ (h.GetSerializedSize (), 1u + 2u * (73u + 16u), "Must be 179 bytes long");
 
-    // Parameters constructor 2
-    std::set<DataIdentifier> requested_packets = {DataIdentifier ("1.1.1.1:1"),
-      DataIdentifier ("1.1.1.1:2"), DataIdentifier ("1.1.1.1:3")};
+    AggregatedDataHeader copy (h);
+    NS_TEST_EXPECT_MSG_EQ (copy, h, "Copies must be equal");
 
-    NeighborEntry e3 (Ipv4Address ("1.2.3.6"), requested_packets);
-    NS_TEST_EXPECT_MSG_EQ (e3.GetNeighborIpAddress (), Ipv4Address ("1.2.3.6"), "Must be 1.2.3.6");
-    NS_TEST_EXPECT_MSG_EQ (e3.GetExpirationTime (), Time (), "Must be default time (0)");
-    NS_TEST_EXPECT_MSG_EQ (e3.GetRequestedPacketsSet (), requested_packets, "Must be equal");
+    copy.AddDataPacket (CreateDataHeader (3u));
+    NS_TEST_EXPECT_MSG_EQ ((copy != h), true, "Must be different");
 
-    // Parameters constructor 3
-    requested_packets = {DataIdentifier ("2.2.2.2:1"), DataIdentifier ("2.2.2.2:2"),
-      DataIdentifier ("2.2.2.2:3"), DataIdentifier ("2.2.2.2:4")};
+    // The frame is full with MAX_DATA_PACKETS packets.
+    for (uint32_t i = 3u; i <= AggregatedDataHeader::MAX_DATA_PACKETS; ++i)
+      h.AddDataPacket (CreateDataHeader (i));
 
-    NeighborEntry e4 (Ipv4Address ("1.2.3.8"), Seconds (36), requested_packets);
-    NS_TEST_EXPECT_MSG_EQ (e4.GetNeighborIpAddress (), Ipv4Address ("1.2.3.8"), "Must be 1.2.3.8");
-    NS_TEST_EXPECT_MSG_EQ (e4.GetExpirationTime (), Seconds (36), "Must be 36 seconds");
-    NS_TEST_EXPECT_MSG_EQ (e4.GetRequestedPacketsSet (), requested_packets, "Must be equal");
+    NS_TEST_EXPECT_MSG_EQ (h.GetDataPacketsCount (), AggregatedDataHeader::MAX_DATA_PACKETS,
+                           "Frame must be full");
 
-    // Copy constructor
-    NeighborEntry e5 (e4);
-    NS_TEST_EXPECT_MSG_EQ (e5.GetNeighborIpAddress (), Ipv4Address ("1.2.3.8"), "Must be 1.2.3.8");
-    NS_TEST_EXPECT_MSG_EQ (e5.GetExpirationTime (), Seconds (36), "Must be 36 seconds");
-    NS_TEST_EXPECT_MSG_EQ (e5.GetRequestedPacketsSet (), requested_packets, "Must be equal");
+    bool throwed_exception = false;
+
+    try
+      {
+        h.AddDataPacket (CreateDataHeader (0u));
+      }
+    catch (std::out_of_range & ex)
+      {
+        throwed_exception = true;
+        NS_TEST_EXPECT_MSG_EQ (1, 1, "Must happen.");
+      }
+    catch (...)
+      {
+        throwed_exception = false;
+        NS_TEST_EXPECT_MSG_EQ (1, 0, "Must never happen.");
+      }
+
+    NS_TEST_EXPECT_MSG_EQ (throwed_exception, true, "Right exception must have been thrown.");
+    NS_TEST_EXPECT_MSG_EQ (h.GetDataPacketsCount (), AggregatedDataHeader::MAX_DATA_PACKETS,
+                           "Packet must not be added");
   }
 
   void
-  TestOverloadedOperators ()
+  TestSerializationDeserialization ()
   {
-    NeighborEntry equal_1 (Ipv4Address ("1.2.3.4"), Seconds (10));
-    NeighborEntry equal_2 (Ipv4Address ("1.2.3.4"), Seconds (10));
-    NeighborEntry different (Ipv4Address ("10.20.30.40"), Seconds (10));
+    AggregatedDataHeader h1;
+    AggregatedDataHeader h2;
 
-    TestEqualityRelationalOperators (equal_1, equal_2, different);
+    for (uint32_t i = 1u; i <= 10u; ++i)
+      h2.AddDataPacket (CreateDataHeader (i));
 
-    // Note that the equality operator of NeighborEntry object only considers
-    // the IP of the neighbor node.
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+    packet->AddHeader (h2);
 
-    std::set<DataIdentifier> requested_packets = {DataIdentifier ("1.1.1.1:1"),
-      DataIdentifier ("1.1.1.1:2"), DataIdentifier ("1.1.1.1:3")};
+    AggregatedDataHeader deserialized;
 
-    equal_1 = NeighborEntry (Ipv4Address ("1.2.3.4"), Seconds (10), requested_packets);
-    equal_2 = NeighborEntry (Ipv4Address ("1.2.3.4"), Seconds (5), requested_packets);
-    different = NeighborEntry (Ipv4Address ("10.20.30.40"), Seconds (17), requested_packets);
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 1u + 10u * (73u + 16u), "AggregatedDataHeader is 891 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 1u, "AggregatedDataHeader is 1 byte long");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+  }
+
+  void
+  TestCompactSerializationDeserialization ()
+  {
+    AggregatedDataHeader h;
+    h.AddDataPacket (CreateDataHeader (1u));
+
+    // The encoding is set to the already added and to the new packets.
+    h.SetCompactEncoding (true);
+    h.AddDataPacket (CreateDataHeader (2u));
+
+    DataHeader compact_data_header = CreateDataHeader (1u);
+    compact_data_header.SetCompactEncoding (true);
+
+    NS_TEST_EXPECT_MSG_EQ (h.GetDataPackets ()[0].IsCompactEncoding (), true, "Must use the compact encoding");
+    NS_TEST_EXPECT_MSG_EQ (h.GetDataPackets ()[1].IsCompactEncoding (), true, "Must use the compact encoding");
+    NS_TEST_EXPECT_MSG_EQ (h.GetSerializedSize (), 1u + 2u * compact_data_header.GetSerializedSize (),
+                           "Must be the size of the compact packets");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h);
+
+    AggregatedDataHeader deserialized;
+    deserialized.SetCompactEncoding (true);
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, h.GetSerializedSize (), "Must read the whole frame");
+    NS_TEST_EXPECT_MSG_EQ (h, deserialized, "Serialization and deserialization works");
+  }
+
+  void
+  TestToString ()
+  {
+    AggregatedDataHeader h;
+    h.AddDataPacket (CreateDataHeader (5u));
+    h.AddDataPacket (CreateDataHeader (9u));
+
+    std::string expected_str = "AGGREGATED_DATA frame of 2 DATA packet(s): "
+            "1.2.3.4:5, 1.2.3.4:9";
+    NS_TEST_EXPECT_MSG_EQ (h.ToString (), expected_str, "Expected string: " + expected_str);
+  }
+
+  void
+  DoRun () override
+  {
+    TestAddDataPacket ();
+    TestSerializationDeserialization ();
+    TestCompactSerializationDeserialization ();
+    TestToString ();
+  }
+};
+
+
+// =============================================================================
+//                            AggregatedAckHeaderTest
+// =============================================================================
+
+/**
+ * AggregatedAckHeader packet header test suite.
+ * 
+ * \ingroup tests
+ * \ingroup geotemporal-test
+ */
+class AggregatedAckHeaderTest : public TestCasePlus
+{
+public:
+
+  AggregatedAckHeaderTest () : TestCasePlus ("AggregatedAckHeader") { }
+
+  void
+  TestSerializationDeserialization ()
+  {
+    DataIdentifier data_id ("1.1.1.1:3");
+    GeoTemporalLibrary::LibraryUtils::Vector2D position (-50.63, 159);
+    GeoTemporalLibrary::LibraryUtils::Vector2D velocity (5.5559, -1.1111);
+
+    std::vector<bool> received_packets;
+
+    for (uint32_t i = 0u; i < 9u; ++i)
+      received_packets.push_back (i % 3u != 1u);
+
+    AggregatedAckHeader h1;
+    AggregatedAckHeader h2 (data_id, std::vector<bool> (3u, true), position, velocity);
+    AggregatedAckHeader h3 (data_id, received_packets, position, velocity);
+
+    NS_TEST_EXPECT_MSG_EQ (h1.GetSerializedSize (), 31u + 1u, "Must be 32 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2.GetSerializedSize (), 31u + 1u + 1u, "Must be 33 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h3.GetSerializedSize (), 31u + 1u + 2u, "Must be 34 bytes long");
+
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader (h1);
+    packet->AddHeader (h2);
+    packet->AddHeader (h3);
+
+    AggregatedAckHeader deserialized;
+
+    uint32_t read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 34u, "AggregatedAckHeader is 34 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h3, deserialized, "Serialization and deserialization works");
+    NS_TEST_EXPECT_MSG_EQ ((deserialized.GetReceivedPackets () == received_packets), true,
+                           "Bitmap must be preserved");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 33u, "AggregatedAckHeader is 33 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h2, deserialized, "Serialization and deserialization works");
+
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, 32u, "AggregatedAckHeader is 32 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (h1, deserialized, "Serialization and deserialization works");
+
+    // Compact encoding
+    AckHeader ack_header (data_id, position, velocity);
+    ack_header.SetCompactEncoding (true);
+    h3.SetCompactEncoding (true);
+
+    NS_TEST_EXPECT_MSG_EQ (h3.GetSerializedSize (), ack_header.GetSerializedSize () + 3u,
+                           "Must be the compact ACK size plus the bitmap");
+
+    packet->AddHeader (h3);
+
+    deserialized.SetCompactEncoding (true);
+    read_bytes = packet->RemoveHeader (deserialized);
+    NS_TEST_EXPECT_MSG_EQ (read_bytes, h3.GetSerializedSize (), "Must read the whole header");
+    NS_TEST_EXPECT_MSG_EQ (h3, deserialized, "Serialization and deserialization works");
+  }
+
+  void
+  TestToString ()
+  {
+    std::vector<bool> received_packets;
+    received_packets.push_back (true);
+    received_packets.push_back (false);
+    received_packets.push_back (true);
+
+    AggregatedAckHeader h (DataIdentifier ("1.1.1.1:3"), received_packets,
+                           GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                           GeoTemporalLibrary::LibraryUtils::Vector2D (-8.86, 123.098));
+
+    std::string expected_str = "AGGREGATED_ACK of frame starting at 1.1.1.1:3 with "
+            "bitmap [101] from position (3.00, 4.00) at velocity (-8.86, 123.10)";
+    NS_TEST_EXPECT_MSG_EQ (h.ToString (), expected_str, "Expected string: " + expected_str);
+  }
+
+  void
+  DoRun () override
+  {
+    TestSerializationDeserialization ();
+    TestToString ();
+  }
+};
+
+
+// =============================================================================
+//                               NeighborEntryTest
+// =============================================================================
+
+/**
+ * NeighborEntry for the neighbors table test suite.
+ * 
+ * \ingroup tests
+ * \ingroup geotemporal-test
+ */
+class NeighborEntryTest : public TestCasePlus
+{
+public:
+
+  NeighborEntry m_neighbor_entry;
+
+  NeighborEntryTest () : TestCasePlus ("NeighborEntry"), m_neighbor_entry () { }
+
+  void
+  TestConstructors ()
+  {
+    // Default constructor
+    NeighborEntry e1;
+    NS_TEST_EXPECT_MSG_EQ (e1.GetNeighborIpAddress (), Ipv4Address (), "Must be default IP");
+    NS_TEST_EXPECT_MSG_EQ (e1.GetExpirationTime (), Time (), "Must be default time (0)");
+    NS_TEST_EXPECT_MSG_EQ (e1.GetRequestedPacketsSet ().empty (), true, "Must be an empty set");
+
+    // Parameters constructor 1
+    NeighborEntry e2 (Ipv4Address ("1.2.3.4"), Seconds (10));
+    NS_TEST_EXPECT_MSG_EQ (e2.GetNeighborIpAddress (), Ipv4Address ("1.2.3.4"), "Must be 1.2.3.4");
+    NS_TEST_EXPECT_MSG_EQ (e2.GetExpirationTime (), Seconds (10), "Must be 10 seconds");
+    NS_TEST_EXPECT_MSG_EQ (e2.GetRequestedPacketsSet ().empty (), true, "Must be an empty set");
+
+    // Parameters constructor 2
+    std::set<DataIdentifier> requested_packets = {DataIdentifier ("1.1.1.1:1"),
+      DataIdentifier ("1.1.1.1:2"), DataIdentifier ("1.1.1.1:3")};
+
+    NeighborEntry e3 (Ipv4Address ("1.2.3.6"), requested_packets);
+    NS_TEST_EXPECT_MSG_EQ (e3.GetNeighborIpAddress (), Ipv4Address ("1.2.3.6"), "Must be 1.2.3.6");
+    NS_TEST_EXPECT_MSG_EQ (e3.GetExpirationTime (), Time (), "Must be default time (0)");
+    NS_TEST_EXPECT_MSG_EQ (e3.GetRequestedPacketsSet (), requested_packets, "Must be equal");
+
+    // Parameters constructor 3
+    requested_packets = {DataIdentifier ("2.2.2.2:1"), DataIdentifier ("2.2.2.2:2"),
+      DataIdentifier ("2.2.2.2:3"), DataIdentifier ("2.2.2.2:4")};
+
+    NeighborEntry e4 (Ipv4Address ("1.2.3.8"), Seconds (36), requested_packets);
+    NS_TEST_EXPECT_MSG_EQ (e4.GetNeighborIpAddress (), Ipv4Address ("1.2.3.8"), "Must be 1.2.3.8");
+    NS_TEST_EXPECT_MSG_EQ (e4.GetExpirationTime (), Seconds (36), "Must be 36 seconds");
+    NS_TEST_EXPECT_MSG_EQ (e4.GetRequestedPacketsSet (), requested_packets, "Must be equal");
+
+    // Copy constructor
+    NeighborEntry e5 (e4);
+    NS_TEST_EXPECT_MSG_EQ (e5.GetNeighborIpAddress (), Ipv4Address ("1.2.3.8"), "Must be 1.2.3.8");
+    NS_TEST_EXPECT_MSG_EQ (e5.GetExpirationTime (), Seconds (36), "Must be 36 seconds");
+    NS_TEST_EXPECT_MSG_EQ (e5.GetRequestedPacketsSet (), requested_packets, "Must be equal");
+  }
+
+  void
+  TestOverloadedOperators ()
+  {
+    NeighborEntry equal_1 (Ipv4Address ("1.2.3.4"), Seconds (10));
+    NeighborEntry equal_2 (Ipv4Address ("1.2.3.4"), Seconds (10));
+    NeighborEntry different (Ipv4Address ("10.20.30.40"), Seconds (10));
+
+    TestEqualityRelationalOperators (equal_1, equal_2, different);
+
+    // Note that the equality operator of NeighborEntry object only considers
+    // the IP of the neighbor node.
+
+    std::set<DataIdentifier> requested_packets = {DataIdentifier ("1.1.1.1:1"),
+      DataIdentifier ("1.1.1.1:2"), DataIdentifier ("1.1.1.1:3")};
+
+    equal_1 = NeighborEntry (Ipv4Address ("1.2.3.4"), Seconds (10), requested_packets);
+    equal_2 = NeighborEntry (Ipv4Address ("1.2.3.4"), Seconds (5), requested_packets);
+    different = NeighborEntry (Ipv4Address ("10.20.30.40"), Seconds (17), requested_packets);
 
     TestEqualityRelationalOperators (equal_1, equal_2, different);
 
@@ -2392,6 +3069,29 @@ public:
                            false, "Neighbor 1.1.1.2 must NOT be found");
     NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.Find (Ipv4Address ("1.1.1.3")),
                            true, "Neighbor 1.1.1.3 must be found");
+
+    // The summary vectors of the expired neighbor are forgotten.
+    uint32_t version = 0u;
+    std::set<DataIdentifier> summary_vector;
+
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.FindSentSummaryVectorVersion (Ipv4Address ("1.1.1.2"), version),
+                           false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.UpdateReceivedSummaryVector (Ipv4Address ("1.1.1.2"), 4u, 5u,
+                                                                          {}, {}, summary_vector),
+                           false, "Must be false");
+
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.FindSentSummaryVectorVersion (Ipv4Address ("1.1.1.1"), version),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (version, 3u, "Must be 3");
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.UpdateReceivedSummaryVector (Ipv4Address ("1.1.1.1"), 4u, 5u,
+                                                                          {}, {}, summary_vector),
+                           true, "Must be true");
+
+    // So are the DATA packets outstanding to it.
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.GetOutstandingDataPacketsCount (Ipv4Address ("1.1.1.2")),
+                           0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.GetOutstandingDataPacketsCount (Ipv4Address ("1.1.1.1")),
+                           1u, "Must be 1");
   }
 
   void
@@ -2429,6 +3129,123 @@ public:
                            false, "Neighbor 1.1.1.1 must NOT be found");
   }
 
+  void
+  TestSummaryVectorVersionsFunctions ()
+  {
+    m_neighbors_table = NeighborsTable (Seconds (10));
+
+    // Versions of the local summary vector sent to neighbors
+
+    uint32_t version = 99u;
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.FindSentSummaryVectorVersion (Ipv4Address ("1.1.1.1"), version),
+                           false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ (version, 99u, "Must not be modified");
+
+    m_neighbors_table.SetSentSummaryVectorVersion (Ipv4Address ("1.1.1.1"), 7u);
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.FindSentSummaryVectorVersion (Ipv4Address ("1.1.1.1"), version),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (version, 7u, "Must be 7u");
+
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.RemoveSentSummaryVectorVersion (Ipv4Address ("1.1.1.1")),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.RemoveSentSummaryVectorVersion (Ipv4Address ("1.1.1.1")),
+                           false, "Must be false");
+
+    // Summary vectors received from neighbors
+
+    std::set<DataIdentifier> summary_vector, expected_summary_vector;
+
+    // Changes without a stored summary vector can't be applied
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.UpdateReceivedSummaryVector (Ipv4Address ("2.2.2.2"), 3u, 5u,
+                                                                          {DataIdentifier ("9.9.9.9:1")}, {},
+                                                                          summary_vector),
+                           false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ (summary_vector.empty (), true, "Must not be modified");
+
+    // Whole summary vector
+    expected_summary_vector = {DataIdentifier ("9.9.9.9:1"), DataIdentifier ("9.9.9.9:2")};
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.UpdateReceivedSummaryVector (Ipv4Address ("2.2.2.2"), 0u, 5u,
+                                                                          expected_summary_vector, {},
+                                                                          summary_vector),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (summary_vector, expected_summary_vector, "Must be the expected");
+
+    // Changes since the stored version
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.UpdateReceivedSummaryVector (Ipv4Address ("2.2.2.2"), 5u, 8u,
+                                                                          {DataIdentifier ("8.8.8.8:1")},
+                                                                          {DataIdentifier ("9.9.9.9:1")},
+                                                                          summary_vector),
+                           true, "Must be true");
+    expected_summary_vector = {DataIdentifier ("8.8.8.8:1"), DataIdentifier ("9.9.9.9:2")};
+    NS_TEST_EXPECT_MSG_EQ (summary_vector, expected_summary_vector, "Must be the expected");
+
+    // Changes since another version can't be applied, and the stored summary
+    // vector is forgotten.
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.UpdateReceivedSummaryVector (Ipv4Address ("2.2.2.2"), 7u, 9u,
+                                                                          {}, {}, summary_vector),
+                           false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.UpdateReceivedSummaryVector (Ipv4Address ("2.2.2.2"), 8u, 9u,
+                                                                          {}, {}, summary_vector),
+                           false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ (summary_vector, expected_summary_vector, "Must not be modified");
+  }
+
+  void
+  TestOutstandingDataPacketsFunctions ()
+  {
+    m_neighbors_table = NeighborsTable (Seconds (10));
+
+    uint32_t transmissions_count = 99u;
+
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.GetOutstandingDataPacketsCount (Ipv4Address ("1.1.1.1")),
+                           0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.FindOutstandingDataPacket (Ipv4Address ("1.1.1.1"),
+                                                                        DataIdentifier ("9.9.9.9:1"),
+                                                                        transmissions_count),
+                           false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ (transmissions_count, 99u, "Must not be modified");
+
+    m_neighbors_table.SetOutstandingDataPacket (Ipv4Address ("1.1.1.1"), DataIdentifier ("9.9.9.9:1"), 1u);
+    m_neighbors_table.SetOutstandingDataPacket (Ipv4Address ("1.1.1.1"), DataIdentifier ("9.9.9.9:2"), 1u);
+    m_neighbors_table.SetOutstandingDataPacket (Ipv4Address ("2.2.2.2"), DataIdentifier ("9.9.9.9:1"), 1u);
+
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.GetOutstandingDataPacketsCount (Ipv4Address ("1.1.1.1")),
+                           2u, "Must be 2");
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.GetOutstandingDataPacketsCount (Ipv4Address ("2.2.2.2")),
+                           1u, "Must be 1");
+
+    // Retransmission
+    m_neighbors_table.SetOutstandingDataPacket (Ipv4Address ("1.1.1.1"), DataIdentifier ("9.9.9.9:2"), 2u);
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.FindOutstandingDataPacket (Ipv4Address ("1.1.1.1"),
+                                                                        DataIdentifier ("9.9.9.9:2"),
+                                                                        transmissions_count),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (transmissions_count, 2u, "Must be 2");
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.GetOutstandingDataPacketsCount (Ipv4Address ("1.1.1.1")),
+                           2u, "Must be 2");
+
+    // ACK received
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.RemoveOutstandingDataPacket (Ipv4Address ("1.1.1.1"),
+                                                                          DataIdentifier ("9.9.9.9:1")),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.RemoveOutstandingDataPacket (Ipv4Address ("1.1.1.1"),
+                                                                          DataIdentifier ("9.9.9.9:1")),
+                           false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.GetOutstandingDataPacketsCount (Ipv4Address ("1.1.1.1")),
+                           1u, "Must be 1");
+
+    // New session
+    m_neighbors_table.ClearOutstandingDataPackets (Ipv4Address ("1.1.1.1"));
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.GetOutstandingDataPacketsCount (Ipv4Address ("1.1.1.1")),
+                           0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.GetOutstandingDataPacketsCount (Ipv4Address ("2.2.2.2")),
+                           1u, "Must be 1");
+
+    m_neighbors_table.Clear ();
+    NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.GetOutstandingDataPacketsCount (Ipv4Address ("2.2.2.2")),
+                           0u, "Must be 0");
+  }
+
   void
   TestPurgeFunction ()
   {
@@ -2456,6 +3273,19 @@ public:
 
     NS_TEST_EXPECT_MSG_EQ (m_neighbors_table.Size (), 3, "Must be 3");
 
+    // Summary vectors exchanged with the neighbors 1.1.1.1 and 1.1.1.2
+    std::set<DataIdentifier> summary_vector;
+
+    m_neighbors_table.SetSentSummaryVectorVersion (Ipv4Address ("1.1.1.1"), 3u);
+    m_neighbors_table.SetSentSummaryVectorVersion (Ipv4Address ("1.1.1.2"), 3u);
+    m_neighbors_table.UpdateReceivedSummaryVector (Ipv4Address ("1.1.1.1"), 0u, 4u,
+                                                   {DataIdentifier ("9.9.9.9:1")}, {}, summary_vector);
+    m_neighbors_table.UpdateReceivedSummaryVector (Ipv4Address ("1.1.1.2"), 0u, 4u,
+                                                   {DataIdentifier ("9.9.9.9:1")}, {}, summary_vector);
+
+    m_neighbors_table.SetOutstandingDataPacket (Ipv4Address ("1.1.1.1"), DataIdentifier ("9.9.9.9:1"), 1u);
+    m_neighbors_table.SetOutstandingDataPacket (Ipv4Address ("1.1.1.2"), DataIdentifier ("9.9.9.9:1"), 1u);
+
     Simulator::Schedule (Seconds (3.55), &NeighborsTableTest::TestPurgeFunction_Scheduled_1, this);
     Simulator::Schedule (Seconds (6.2), &NeighborsTableTest::TestPurgeFunction_Scheduled_2, this);
     Simulator::Schedule (Seconds (8.1), &NeighborsTableTest::TestPurgeFunction_Scheduled_3, this);
@@ -2502,6 +3332,8 @@ public:
     TestUpdateNeighborRequestedPacketsFunction ();
     TestRemoveNeighborRequestedPacketFunction ();
     TestRestartNeighborEntryExpirationTimeFunction ();
+    TestSummaryVectorVersionsFunctions ();
+    TestOutstandingDataPacketsFunctions ();
     TestPurgeFunction ();
     TestToStringFunction ();
   }
@@ -3407,40 +4239,237 @@ public:
   }
 
   void
-  TestComparePacketTransmissionPriority ()
+  TestSummaryVectorChanges ()
   {
-    std::pair<DataIdentifier, PacketQueueEntry> lower_priority, higher_priority;
+    std::set<DataIdentifier> inserted_packets, expected_inserted_packets,
+            removed_packets, expected_removed_packets;
+    m_packets_queue = PacketsQueue (m_gps, 2u, 3u);
+    m_packets_queue.SetSummaryVectorLogCapacity (3u);
 
-    // Test with different hops count: lower = 23 hops vs higher = 22 hops
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorVersion (), 0u, "Must be 0u");
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorChanges (0u, inserted_packets, removed_packets),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (inserted_packets.empty () && removed_packets.empty (), true, "Must be empty");
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorChanges (1u, inserted_packets, removed_packets),
+                           false, "Must be false (newer version)");
 
-    DataHeader data_packet (/*Data ID*/ DataIdentifier ("1.2.3.4:5"),
-                            /*Hops count*/ 23u,
+    DataHeader data_packet (/*Data ID*/ DataIdentifier ("1.1.1.1:1"),
+                            /*Hops count*/ 65u,
                             /*Position*/ GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
-                            /*Velocity*/ GeoTemporalLibrary::LibraryUtils::Vector2D (-8.86, 12.098),
-                            /*GeoTemporal Area*/ GeoTemporalArea (TimePeriod (Seconds (10), Seconds (20)), Area (30, 40, 50, 60)),
+                            /*Velocity*/ GeoTemporalLibrary::LibraryUtils::Vector2D (-8.86, 123.098),
+                            /*GeoTemporal Area*/ GeoTemporalArea (TimePeriod (Seconds (0), Seconds (10)),
+                                                                  Area (0, 0, 100, 100)),
                             /*Message*/ "packet's message");
-    PacketQueueEntry queue_entry (data_packet, 3u);
-
-    lower_priority = std::make_pair (DataIdentifier ("1.1.1.1:1"), queue_entry);
 
-    data_packet.SetHopsCount (22u);
-    queue_entry = PacketQueueEntry (data_packet, 3u);
+    m_packets_queue.Enqueue (data_packet, GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                             Ipv4Address ("8.8.8.8"));
+    data_packet.SetDataIdentifier (DataIdentifier ("1.1.1.1:2"));
+    m_packets_queue.Enqueue (data_packet, GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                             Ipv4Address ("8.8.8.8"));
 
-    higher_priority = std::make_pair (DataIdentifier ("1.1.1.1:1"), queue_entry);
+    // Duplicated packets don't change the summary vector
+    m_packets_queue.Enqueue (data_packet, GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                             Ipv4Address ("8.8.8.8"));
 
-    NS_TEST_EXPECT_MSG_EQ (lower_priority.second.GetDataPacket ().GetHopsCount (), 23u, "Must be 23");
-    NS_TEST_EXPECT_MSG_EQ (higher_priority.second.GetDataPacket ().GetHopsCount (), 22u, "Must be 22");
-    NS_TEST_EXPECT_MSG_EQ (lower_priority.second.GetKnownCarrierNodesCount (), 0u, "Must be 0");
-    NS_TEST_EXPECT_MSG_EQ (higher_priority.second.GetKnownCarrierNodesCount (), 0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorVersion (), 2u, "Must be 2u");
 
-    NS_TEST_EXPECT_MSG_EQ (PacketsQueue::ComparePacketTransmissionPriority (lower_priority, higher_priority),
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorChanges (0u, inserted_packets, removed_packets),
                            true, "Must be true");
-    NS_TEST_EXPECT_MSG_EQ (PacketsQueue::ComparePacketTransmissionPriority (higher_priority, lower_priority),
-                           false, "Must be false");
+    expected_inserted_packets = {DataIdentifier ("1.1.1.1:1"), DataIdentifier ("1.1.1.1:2")};
+    NS_TEST_EXPECT_MSG_EQ (inserted_packets, expected_inserted_packets, "Must be the expected");
+    NS_TEST_EXPECT_MSG_EQ (removed_packets, expected_removed_packets, "Must be the expected");
 
-    // Test with different known carriers count: lower = 4 carriers vs higher = 3 carriers
+    // The queue is full: one packet is dropped and the new one is inserted
+    data_packet.SetDataIdentifier (DataIdentifier ("1.1.1.1:3"));
+    m_packets_queue.Enqueue (data_packet, GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                             Ipv4Address ("8.8.8.8"));
 
-    data_packet.SetHopsCount (10u);
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorVersion (), 4u, "Must be 4u");
+
+    std::set<DataIdentifier> summary_vector;
+    m_packets_queue.GetSummaryVector (summary_vector);
+
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorChanges (2u, inserted_packets, removed_packets),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (inserted_packets.size (), 1u, "Must be 1u");
+    NS_TEST_EXPECT_MSG_EQ (removed_packets.size (), 1u, "Must be 1u");
+    NS_TEST_EXPECT_MSG_EQ (*inserted_packets.begin (), DataIdentifier ("1.1.1.1:3"), "Must be 1.1.1.1:3");
+    NS_TEST_EXPECT_MSG_EQ (summary_vector.count (*removed_packets.begin ()), 0u, "Must be removed");
+
+    // The change log holds the last 3 changes (versions 2 to 4)
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorChanges (1u, inserted_packets, removed_packets),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorChanges (0u, inserted_packets, removed_packets),
+                           false, "Must be false (truncated log)");
+
+    // Clearing the queue discards the log
+    m_packets_queue.Clear ();
+
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorVersion (), 5u, "Must be 5u");
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorChanges (4u, inserted_packets, removed_packets),
+                           false, "Must be false (truncated log)");
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorChanges (5u, inserted_packets, removed_packets),
+                           true, "Must be true");
+  }
+
+  void
+  TestSummaryVectorDigest ()
+  {
+    m_packets_queue = PacketsQueue (m_gps, 2u, 3u);
+
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorDigest (), 0u, "Must be 0u");
+
+    DataHeader data_packet (/*Data ID*/ DataIdentifier ("1.1.1.1:1"),
+                            /*Hops count*/ 65u,
+                            /*Position*/ GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                            /*Velocity*/ GeoTemporalLibrary::LibraryUtils::Vector2D (-8.86, 123.098),
+                            /*GeoTemporal Area*/ GeoTemporalArea (TimePeriod (Seconds (0), Seconds (10)),
+                                                                  Area (0, 0, 100, 100)),
+                            /*Message*/ "packet's message");
+
+    m_packets_queue.Enqueue (data_packet, GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                             Ipv4Address ("8.8.8.8"));
+    const uint32_t first_packet_digest = m_packets_queue.GetSummaryVectorDigest ();
+
+    NS_TEST_EXPECT_MSG_EQ ((first_packet_digest != 0u), true, "Must not be 0u");
+
+    data_packet.SetDataIdentifier (DataIdentifier ("1.1.1.1:2"));
+    m_packets_queue.Enqueue (data_packet, GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                             Ipv4Address ("8.8.8.8"));
+    const uint32_t two_packets_digest = m_packets_queue.GetSummaryVectorDigest ();
+
+    // Duplicated packets don't change the digest
+    m_packets_queue.Enqueue (data_packet, GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                             Ipv4Address ("8.8.8.8"));
+
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorDigest (), two_packets_digest, "Must be equal");
+
+    // The digest doesn't depend on the insertion order
+    std::set<DataIdentifier> summary_vector;
+    m_packets_queue.GetSummaryVector (summary_vector);
+
+    NS_TEST_EXPECT_MSG_EQ (PacketsQueue::ComputeSummaryVectorDigest (summary_vector),
+                           two_packets_digest, "Must be equal");
+    NS_TEST_EXPECT_MSG_EQ (PacketsQueue::ComputeSummaryVectorDigest ({DataIdentifier ("1.1.1.1:1")}),
+                           first_packet_digest, "Must be equal");
+
+    // The queue is full: one packet is dropped and the new one is inserted
+    data_packet.SetDataIdentifier (DataIdentifier ("1.1.1.1:3"));
+    m_packets_queue.Enqueue (data_packet, GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                             Ipv4Address ("8.8.8.8"));
+    m_packets_queue.GetSummaryVector (summary_vector);
+
+    NS_TEST_EXPECT_MSG_EQ (summary_vector.size (), 2u, "Must be 2u");
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorDigest (),
+                           PacketsQueue::ComputeSummaryVectorDigest (summary_vector), "Must be equal");
+    NS_TEST_EXPECT_MSG_EQ ((m_packets_queue.GetSummaryVectorDigest () != two_packets_digest), true,
+                           "Must be different");
+
+    m_packets_queue.Clear ();
+
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.GetSummaryVectorDigest (), 0u, "Must be 0u");
+  }
+
+  void
+  TestProcessDisjointVectorBloomFilter ()
+  {
+    std::set<DataIdentifier> received_summary_vector, neighbor_known_packets, expected_neighbor_known_packets,
+            neighbor_unknown_packets, expected_neighbor_unknown_packets;
+    m_packets_queue = PacketsQueue (m_gps, 100u, 3u);
+
+    // Test with an empty packets queue and an empty Bloom filter
+
+    uint32_t locally_unknown_count
+            = m_packets_queue.ProcessDisjointVectors (/*Recv Bloom filter*/ DataIdentifierBloomFilter (),
+                                                      /*Bloom filter entries*/ 0u,
+                                                      /*Neighbor IP*/ Ipv4Address ("2.2.2.2"),
+                                                      /*Neighbor known packets*/ neighbor_known_packets,
+                                                      /*Neighbor unknown packets*/ neighbor_unknown_packets);
+
+    NS_TEST_EXPECT_MSG_EQ (locally_unknown_count, 0u, "Must be 0u");
+    NS_TEST_EXPECT_MSG_EQ (neighbor_known_packets, expected_neighbor_known_packets, "Must be the expected.");
+    NS_TEST_EXPECT_MSG_EQ (neighbor_unknown_packets, expected_neighbor_unknown_packets, "Must be the expected.");
+
+    // Test with a non-empty packets queue and a non-empty Bloom filter.
+
+    DataHeader data_packet (/*Data ID*/ DataIdentifier ("1.1.1.1:1"),
+                            /*Hops count*/ 65u,
+                            /*Position*/ GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                            /*Velocity*/ GeoTemporalLibrary::LibraryUtils::Vector2D (-8.86, 123.098),
+                            /*GeoTemporal Area*/ GeoTemporalArea (TimePeriod (Seconds (0), Seconds (10)),
+                                                                  Area (0, 0, 100, 100)),
+                            /*Message*/ "packet's message");
+
+    std::set<DataIdentifier> to_enqueue = {DataIdentifier ("9.9.9.9:1"), DataIdentifier ("9.9.9.9:2"),
+      DataIdentifier ("9.9.9.9:3"), DataIdentifier ("2.2.2.2:1"), DataIdentifier ("2.2.2.2:2"),
+      DataIdentifier ("7.7.7.7:1"), DataIdentifier ("7.7.7.7:2")};
+
+    for (std::set<DataIdentifier>::const_iterator it = to_enqueue.begin ();
+            it != to_enqueue.end (); ++it)
+      {
+        data_packet.SetDataIdentifier (*it);
+
+        m_packets_queue.Enqueue (/*Data packet*/ data_packet,
+                                 /*Current position*/ GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                                 /*Transmitter node*/ Ipv4Address ("8.8.8.8"));
+      }
+
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.Size (), 7u, "Size of the packets queue must be 7.");
+
+    received_summary_vector = {DataIdentifier ("9.9.9.9:1"), DataIdentifier ("9.9.9.9:2"),
+      DataIdentifier ("9.9.9.9:3"), DataIdentifier ("8.8.8.8:1"), DataIdentifier ("8.8.8.8:2")};
+
+    locally_unknown_count
+            = m_packets_queue.ProcessDisjointVectors (/*Recv Bloom filter*/ DataIdentifierBloomFilter (received_summary_vector, 0.0001),
+                                                      /*Bloom filter entries*/ received_summary_vector.size (),
+                                                      /*Neighbor IP*/ Ipv4Address ("2.2.2.2"),
+                                                      /*Neighbor known packets*/ neighbor_known_packets,
+                                                      /*Neighbor unknown packets*/ neighbor_unknown_packets);
+
+    expected_neighbor_known_packets = {DataIdentifier ("9.9.9.9:1"), DataIdentifier ("9.9.9.9:2"),
+      DataIdentifier ("9.9.9.9:3")};
+    expected_neighbor_unknown_packets = {DataIdentifier ("7.7.7.7:1"), DataIdentifier ("7.7.7.7:2")};
+
+    NS_TEST_EXPECT_MSG_EQ (locally_unknown_count, 2u, "Must be 2u");
+    NS_TEST_EXPECT_MSG_EQ (neighbor_known_packets, expected_neighbor_known_packets, "Must be the expected.");
+    NS_TEST_EXPECT_MSG_EQ (neighbor_unknown_packets, expected_neighbor_unknown_packets, "Must be the expected.");
+  }
+
+  void
+  TestComparePacketTransmissionPriority ()
+  {
+    std::pair<DataIdentifier, PacketQueueEntry> lower_priority, higher_priority;
+
+    // Test with different hops count: lower = 23 hops vs higher = 22 hops
+
+    DataHeader data_packet (/*Data ID*/ DataIdentifier ("1.2.3.4:5"),
+                            /*Hops count*/ 23u,
+                            /*Position*/ GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                            /*Velocity*/ GeoTemporalLibrary::LibraryUtils::Vector2D (-8.86, 12.098),
+                            /*GeoTemporal Area*/ GeoTemporalArea (TimePeriod (Seconds (10), Seconds (20)), Area (30, 40, 50, 60)),
+                            /*Message*/ "packet's message");
+    PacketQueueEntry queue_entry (data_packet, 3u);
+
+    lower_priority = std::make_pair (DataIdentifier ("1.1.1.1:1"), queue_entry);
+
+    data_packet.SetHopsCount (22u);
+    queue_entry = PacketQueueEntry (data_packet, 3u);
+
+    higher_priority = std::make_pair (DataIdentifier ("1.1.1.1:1"), queue_entry);
+
+    NS_TEST_EXPECT_MSG_EQ (lower_priority.second.GetDataPacket ().GetHopsCount (), 23u, "Must be 23");
+    NS_TEST_EXPECT_MSG_EQ (higher_priority.second.GetDataPacket ().GetHopsCount (), 22u, "Must be 22");
+    NS_TEST_EXPECT_MSG_EQ (lower_priority.second.GetKnownCarrierNodesCount (), 0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (higher_priority.second.GetKnownCarrierNodesCount (), 0u, "Must be 0");
+
+    NS_TEST_EXPECT_MSG_EQ (PacketsQueue::ComparePacketTransmissionPriority (lower_priority, higher_priority),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (PacketsQueue::ComparePacketTransmissionPriority (higher_priority, lower_priority),
+                           false, "Must be false");
+
+    // Test with different known carriers count: lower = 4 carriers vs higher = 3 carriers
+
+    data_packet.SetHopsCount (10u);
     queue_entry = PacketQueueEntry (data_packet, 3u);
 
     queue_entry.AddKnownCarrierNode (Ipv4Address ("1.1.1.1"));
@@ -7379,6 +8408,205 @@ public:
     m_gps->ClearNodeIpAddressToIdMapping ();
   }
 
+  void
+  TestDequeueTransmitSession ()
+  {
+    m_packets_queue = PacketsQueue (m_gps, 100u, 3u);
+
+    Ipv4Address local_node_ip ("1.1.1.1");
+    Ipv4Address neighbor_node_ip ("2.2.2.2");
+
+    // The neighbor node is inside the destination area of all the packets, so
+    // no valid-carrier check is needed.
+    GeoTemporalLibrary::LibraryUtils::Vector2D local_position, local_velocity,
+            neighbor_position (2170.00, 2040.00), neighbor_velocity, node_position;
+
+    DataHeader data_packet (/*Data ID*/ DataIdentifier ("9.9.9.9:1"),
+                            /*Hops count*/ 3u,
+                            /*Position*/ GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                            /*Velocity*/ GeoTemporalLibrary::LibraryUtils::Vector2D (-8.86, 12.098),
+                            /*GeoTemporal Area*/ GeoTemporalArea (TimePeriod (Seconds (0), Seconds (10)),
+                                                                  Area (2155.00, 2055.00, 2185.00, 2025.00)),
+                            /*Message*/ "packet's message");
+    m_packets_queue.Enqueue (data_packet, node_position, Ipv4Address ("9.9.9.9"));
+
+    data_packet.SetDataIdentifier (DataIdentifier ("9.9.9.9:2"));
+    m_packets_queue.Enqueue (data_packet, node_position, Ipv4Address ("9.9.9.9"));
+
+    data_packet.SetDataIdentifier (DataIdentifier ("9.9.9.9:3"));
+    m_packets_queue.Enqueue (data_packet, node_position, Ipv4Address ("9.9.9.9"));
+
+    data_packet.SetDataIdentifier (DataIdentifier ("9.9.9.9:4"));
+    data_packet.SetHopsCount (7u);
+    m_packets_queue.Enqueue (data_packet, node_position, Ipv4Address ("9.9.9.9"));
+
+    std::set<DataIdentifier> disjoint_vector = {DataIdentifier ("9.9.9.9:1"),
+      DataIdentifier ("9.9.9.9:2"), DataIdentifier ("9.9.9.9:3"), DataIdentifier ("9.9.9.9:4")};
+
+    // Expected order: equal hops and known carriers are dequeued by data ID, and
+    // the known carrier added to packet 2 after the session is ranked lowers
+    // its priority.
+    const std::vector<DataIdentifier> expected_order = {DataIdentifier ("9.9.9.9:1"),
+      DataIdentifier ("9.9.9.9:3"), DataIdentifier ("9.9.9.9:2"), DataIdentifier ("9.9.9.9:4")};
+
+    PacketQueueEntry selected_packet, expected_packet;
+    bool inside_area_flag = false;
+
+    for (uint32_t i = 0u; i < expected_order.size (); ++i)
+      {
+        NS_TEST_EXPECT_MSG_EQ (m_packets_queue.FindHighestTransmitPriorityPacket (local_node_ip, local_position,
+                                                                                  local_velocity, neighbor_node_ip,
+                                                                                  neighbor_position, neighbor_velocity,
+                                                                                  disjoint_vector, expected_packet,
+                                                                                  inside_area_flag),
+                               true, "Must be true");
+        NS_TEST_EXPECT_MSG_EQ (m_packets_queue.Dequeue (local_node_ip, local_position, local_velocity,
+                                                        neighbor_node_ip, neighbor_position, neighbor_velocity,
+                                                        disjoint_vector, selected_packet),
+                               true, "Must be true");
+        NS_TEST_EXPECT_MSG_EQ (selected_packet.GetDataPacketId (), expected_order[i], "Must be the expected");
+        NS_TEST_EXPECT_MSG_EQ (selected_packet.GetDataPacketId (), expected_packet.GetDataPacketId (),
+                               "Must select the same packet as FindHighestTransmitPriorityPacket");
+        NS_TEST_EXPECT_MSG_EQ (m_packets_queue.m_transmit_sessions.size (), 1u, "Session must be kept");
+
+        // Packets inside their destination area don't discount replicas.
+        NS_TEST_EXPECT_MSG_EQ (selected_packet.GetReplicasCounter (), 3u, "Must be 3");
+
+        disjoint_vector.erase (selected_packet.GetDataPacketId ());
+
+        if (i == 0u)
+          m_packets_queue.AddKnownPacketCarrier (DataIdentifier ("9.9.9.9:2"), Ipv4Address ("3.3.3.3"));
+      }
+
+    // The session ends when no packet is selected.
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.Dequeue (local_node_ip, local_position, local_velocity,
+                                                    neighbor_node_ip, neighbor_position, neighbor_velocity,
+                                                    disjoint_vector, selected_packet),
+                           false, "Must be false");
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.m_transmit_sessions.size (), 0u, "Session must be removed");
+
+    // A removed packet is skipped, and a reset session ranks the new disjoint
+    // vector.
+    disjoint_vector = {DataIdentifier ("9.9.9.9:1"), DataIdentifier ("9.9.9.9:4")};
+
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.Dequeue (local_node_ip, local_position, local_velocity,
+                                                    neighbor_node_ip, neighbor_position, neighbor_velocity,
+                                                    disjoint_vector, selected_packet),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (selected_packet.GetDataPacketId (), DataIdentifier ("9.9.9.9:1"), "Must be the expected");
+
+    disjoint_vector.erase (DataIdentifier ("9.9.9.9:1"));
+    m_packets_queue.m_packets_table.erase (DataIdentifier ("9.9.9.9:4"));
+
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.Dequeue (local_node_ip, local_position, local_velocity,
+                                                    neighbor_node_ip, neighbor_position, neighbor_velocity,
+                                                    disjoint_vector, selected_packet),
+                           false, "Must be false");
+
+    disjoint_vector = {DataIdentifier ("9.9.9.9:2"), DataIdentifier ("9.9.9.9:3")};
+    m_packets_queue.ResetTransmitSession (neighbor_node_ip);
+
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.Dequeue (local_node_ip, local_position, local_velocity,
+                                                    neighbor_node_ip, neighbor_position, neighbor_velocity,
+                                                    disjoint_vector, selected_packet),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (selected_packet.GetDataPacketId (), DataIdentifier ("9.9.9.9:3"), "Must be the expected");
+  }
+
+  void
+  TestDropPriorityIndex ()
+  {
+    m_packets_queue = PacketsQueue (m_gps, 4u, 3u);
+
+    GeoTemporalLibrary::LibraryUtils::Vector2D inside_position (2170.00, 2040.00),
+            outside_position (5.00, 5.00);
+
+    DataHeader data_packet (/*Data ID*/ DataIdentifier ("9.9.9.9:1"),
+                            /*Hops count*/ 3u,
+                            /*Position*/ GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                            /*Velocity*/ GeoTemporalLibrary::LibraryUtils::Vector2D (-8.86, 12.098),
+                            /*GeoTemporal Area*/ GeoTemporalArea (TimePeriod (Seconds (0), Seconds (50)),
+                                                                  Area (2155.00, 2055.00, 2185.00, 2025.00)),
+                            /*Message*/ "packet's message");
+    m_packets_queue.Enqueue (data_packet, outside_position, Ipv4Address ("9.9.9.9"));
+
+    data_packet.SetDataIdentifier (DataIdentifier ("9.9.9.9:2"));
+    m_packets_queue.Enqueue (data_packet, outside_position, Ipv4Address ("9.9.9.9"));
+
+    data_packet.SetDataIdentifier (DataIdentifier ("9.9.9.9:3"));
+    data_packet.SetHopsCount (9u);
+    data_packet.SetEmergencyPacket (true);
+    m_packets_queue.Enqueue (data_packet, outside_position, Ipv4Address ("9.9.9.9"));
+
+    // Packet 4 is inside its destination area only after second 5.
+    data_packet.SetDataIdentifier (DataIdentifier ("9.9.9.9:4"));
+    data_packet.SetHopsCount (1u);
+    data_packet.SetEmergencyPacket (false);
+    data_packet.SetDestinationGeoTemporalArea (GeoTemporalArea (TimePeriod (Seconds (5), Seconds (50)),
+                                                                Area (2155.00, 2055.00, 2185.00, 2025.00)));
+    m_packets_queue.Enqueue (data_packet, outside_position, Ipv4Address ("9.9.9.9"));
+
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.m_drop_index.m_entries.size (), 4u, "Must be 4");
+
+    DataIdentifier selected_packet;
+
+    // The only regular packet outside its destination GTA.
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.FindHighestDropPriorityPacket (inside_position, selected_packet),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (selected_packet, DataIdentifier ("9.9.9.9:4"), "Must be the expected");
+
+    // All regular packets are outside, ties are broken by data ID.
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.FindHighestDropPriorityPacket (outside_position, selected_packet),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (selected_packet, DataIdentifier ("9.9.9.9:1"), "Must be the expected");
+
+    // A new known carrier raises the drop priority.
+    m_packets_queue.AddKnownPacketCarrier (DataIdentifier ("9.9.9.9:2"), Ipv4Address ("3.3.3.3"));
+
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.FindHighestDropPriorityPacket (outside_position, selected_packet),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (selected_packet, DataIdentifier ("9.9.9.9:2"), "Must be the expected");
+
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.FindHighestDropPriorityPacket (inside_position, selected_packet),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (selected_packet, DataIdentifier ("9.9.9.9:4"), "Must be the expected");
+
+    Simulator::Schedule (Seconds (6), &PacketsQueueTest::TestDropPriorityIndex_Scheduled, this);
+
+    Simulator::Run ();
+    Simulator::Destroy ();
+  }
+
+  void
+  TestDropPriorityIndex_Scheduled ()
+  {
+    GeoTemporalLibrary::LibraryUtils::Vector2D inside_position (2170.00, 2040.00);
+    DataIdentifier selected_packet;
+
+    // At the same position, packet 4 is now inside its destination GTA.
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.FindHighestDropPriorityPacket (inside_position, selected_packet),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (selected_packet, DataIdentifier ("9.9.9.9:2"), "Must be the expected");
+
+    // The queue is full, so packet 2 is dropped.
+    DataHeader data_packet (/*Data ID*/ DataIdentifier ("9.9.9.9:5"),
+                            /*Hops count*/ 3u,
+                            /*Position*/ GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                            /*Velocity*/ GeoTemporalLibrary::LibraryUtils::Vector2D (-8.86, 12.098),
+                            /*GeoTemporal Area*/ GeoTemporalArea (TimePeriod (Seconds (0), Seconds (50)),
+                                                                  Area (2155.00, 2055.00, 2185.00, 2025.00)),
+                            /*Message*/ "packet's message");
+    m_packets_queue.Enqueue (data_packet, inside_position, Ipv4Address ("9.9.9.9"));
+
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.Find (DataIdentifier ("9.9.9.9:2")), false, "Must be dropped");
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.m_drop_index.m_entries.size (), 4u, "Must be 4");
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.m_drop_index.m_areas.Size (), 4u, "Must be 4");
+
+    NS_TEST_EXPECT_MSG_EQ (m_packets_queue.FindHighestDropPriorityPacket (inside_position, selected_packet),
+                           true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (selected_packet, DataIdentifier ("9.9.9.9:1"), "Must be the expected");
+  }
+
   void
   TestDiscountPacketReplica ()
   {
@@ -7915,6 +9143,74 @@ public:
     Simulator::Destroy ();
   }
 
+  void
+  TestInsideAreaPackets ()
+  {
+    m_packets_queue = PacketsQueue (m_gps, 100u, 3u);
+
+    GeoTemporalLibrary::LibraryUtils::Vector2D node_position,
+            inside_position (2170.00, 2040.00), outside_position (10.00, 10.00),
+            far_position (500.00, 500.00);
+
+    DataHeader data_packet (/*Data ID*/ DataIdentifier ("9.9.9.9:1"),
+                            /*Hops count*/ 3u,
+                            /*Position*/ GeoTemporalLibrary::LibraryUtils::Vector2D (3, 4),
+                            /*Velocity*/ GeoTemporalLibrary::LibraryUtils::Vector2D (-8.86, 12.098),
+                            /*GeoTemporal Area*/ GeoTemporalArea (TimePeriod (Seconds (0), Seconds (10)),
+                                                                  Area (2155.00, 2055.00, 2185.00, 2025.00)),
+                            /*Message*/ "packet's message");
+    m_packets_queue.Enqueue (data_packet, node_position, Ipv4Address ("9.9.9.9"));
+
+    // Same area, but its time period hasn't started.
+    data_packet.SetDataIdentifier (DataIdentifier ("9.9.9.9:2"));
+    data_packet.SetDestinationGeoTemporalArea (GeoTemporalArea (TimePeriod (Seconds (20), Seconds (30)),
+                                                                Area (2155.00, 2055.00, 2185.00, 2025.00)));
+    m_packets_queue.Enqueue (data_packet, node_position, Ipv4Address ("9.9.9.9"));
+
+    // Different area.
+    data_packet.SetDataIdentifier (DataIdentifier ("9.9.9.9:3"));
+    data_packet.SetDestinationGeoTemporalArea (GeoTemporalArea (TimePeriod (Seconds (0), Seconds (10)),
+                                                                Area (0.00, 0.00, 20.00, 20.00)));
+    m_packets_queue.Enqueue (data_packet, node_position, Ipv4Address ("9.9.9.9"));
+
+    std::vector<DataIdentifier> inside_area_packets (1u);
+
+    m_packets_queue.GetInsideAreaPackets (inside_position, inside_area_packets);
+    NS_TEST_EXPECT_MSG_EQ (inside_area_packets.size (), 1u, "Must be 1");
+    NS_TEST_EXPECT_MSG_EQ (inside_area_packets[0], DataIdentifier ("9.9.9.9:1"), "Must be 9.9.9.9:1");
+
+    m_packets_queue.GetInsideAreaPackets (outside_position, inside_area_packets);
+    NS_TEST_EXPECT_MSG_EQ (inside_area_packets.size (), 1u, "Must be 1");
+    NS_TEST_EXPECT_MSG_EQ (inside_area_packets[0], DataIdentifier ("9.9.9.9:3"), "Must be 9.9.9.9:3");
+
+    m_packets_queue.GetInsideAreaPackets (far_position, inside_area_packets);
+    NS_TEST_EXPECT_MSG_EQ (inside_area_packets.size (), 0u, "Must be 0");
+
+    // Known carriers of the in-area broadcast suppression.
+    PacketQueueEntry packet_entry;
+    m_packets_queue.AddKnownPacketCarrier (DataIdentifier ("9.9.9.9:1"), Ipv4Address ("2.2.2.2"));
+    m_packets_queue.Find (DataIdentifier ("9.9.9.9:1"), packet_entry);
+
+    NS_TEST_EXPECT_MSG_EQ (packet_entry.IsKnownCarrierNode (Ipv4Address ("2.2.2.2")), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (packet_entry.IsKnownCarrierNode (Ipv4Address ("3.3.3.3")), false, "Must be false");
+
+    // Broadcasted and unicast replicas are accounted separately.
+    m_packets_queue.LogPacketTransmitted (DataIdentifier ("9.9.9.9:1"), TransmissionType::Broadcast);
+    m_packets_queue.LogPacketTransmitted (DataIdentifier ("9.9.9.9:1"));
+
+    const std::map<DataIdentifier, DataPacketReceptionStats> & queue_stats
+            = m_packets_queue.GetPacketReceptionStats ();
+
+    std::map<DataIdentifier, DataPacketReceptionStats>::const_iterator stats_it
+            = queue_stats.find (DataIdentifier ("9.9.9.9:1"));
+
+    NS_TEST_EXPECT_MSG_EQ ((stats_it != queue_stats.end ()), true,
+                           "Stats of packet 9.9.9.9:1 must be found.");
+    NS_TEST_EXPECT_MSG_EQ (stats_it->second.GetTransmittedReplicasCount (), 2u, "Must be 2");
+    NS_TEST_EXPECT_MSG_EQ (stats_it->second.GetBroadcastTransmittedReplicasCount (), 1u, "Must be 1");
+    NS_TEST_EXPECT_MSG_EQ (stats_it->second.GetUnicastTransmittedReplicasCount (), 1u, "Must be 1");
+  }
+
   void
   TestToStringFunction ()
   {
@@ -7982,11 +9278,17 @@ public:
     //    TestFindFunctions ();
     //    TestClear ();
     //    TestProcessDisjointVector ();
+    TestProcessDisjointVectorBloomFilter ();
+    TestSummaryVectorChanges ();
+    TestSummaryVectorDigest ();
     //    TestComparePacketTransmissionPriority ();
     //    TestFindHighestDropPriorityPacket ();
     //    TestEnqueueFunction ();
     TestFindHighestTransmitPriorityPacket ();
     //    TestDequeue ();
+    TestDequeueTransmitSession ();
+    TestDropPriorityIndex ();
+    TestInsideAreaPackets ();
     //    TestDiscountPacketReplica ();
     //    TestAddKnownPacketCarrier ();
     //    TestAddKnownPacketCarriers ();
@@ -8157,6 +9459,399 @@ public:
 };
 
 
+// =============================================================================
+//                              RoutingProtocolTest
+// =============================================================================
+
+/**
+ * RoutingProtocol test suite. It tests the send window and the retransmissions
+ * of the DATA packets sent to a neighbor node.
+ * 
+ * The routing protocol runs on a node without network devices: the packets 
+ * sent through its unicast socket are dropped, so the ACKs never arrive.
+ * 
+ * \ingroup tests
+ * \ingroup geotemporal-test
+ */
+class RoutingProtocolTest : public TestCasePlus
+{
+public:
+
+  const Ipv4Address m_neighbor_ip;
+  const Vector2D m_neighbor_position;
+  const Vector2D m_neighbor_velocity;
+
+  Ptr<Node> m_node;
+  Ptr<RoutingProtocol> m_routing_protocol;
+
+  RoutingProtocolTest ()
+  : TestCasePlus ("RoutingProtocol"), m_neighbor_ip ("2.2.2.2"),
+  m_neighbor_position (10, 10), m_neighbor_velocity (0, 0), m_node (), m_routing_protocol (),
+  m_hello_interval_changes (0u), m_traced_hello_interval () { }
+
+  /**
+   * Creates the routing protocol of a new node with the given send window and
+   * maximum number of retransmissions of the DATA packets.
+   */
+  void
+  CreateRoutingProtocol (uint32_t data_send_window, uint32_t max_data_retransmissions)
+  {
+    m_node = CreateObject<Node> ();
+    m_node->AggregateObject (CreateObject<ConstantPositionMobilityModel> ());
+
+    InternetStackHelper internet;
+    internet.Install (m_node);
+
+    m_routing_protocol = CreateObject<RoutingProtocol> ();
+    m_routing_protocol->m_ipv4 = m_node->GetObject<Ipv4> ();
+    m_routing_protocol->m_unicast_socket = Socket::CreateSocket (m_node, UdpSocketFactory::GetTypeId ());
+    m_routing_protocol->m_data_send_window = data_send_window;
+    m_routing_protocol->m_max_data_retransmissions = max_data_retransmissions;
+    m_routing_protocol->m_data_retransmission_timeout = MilliSeconds (100);
+  }
+
+  /** Stores in the packets queue a DATA packet with the given data ID. */
+  void
+  EnqueueDataPacket (const DataIdentifier & data_id)
+  {
+    const DataHeader data_header (data_id, 1u, Vector2D (0, 0), Vector2D (0, 0),
+                                  GeoTemporalArea (TimePeriod (Seconds (0), Seconds (100)),
+                                                   Area (0, 0, 100, 100)),
+                                  "0123456789");
+
+    m_routing_protocol->m_packets_queue.Enqueue (data_header, Vector2D (0, 0), Ipv4Address ("3.3.3.3"));
+  }
+
+  /** Sets the DATA packet with the given data ID as sent to the neighbor node. */
+  void
+  TrackSentDataPacket (const DataIdentifier & data_id)
+  {
+    m_routing_protocol->TrackOutstandingDataPacket (m_neighbor_ip, data_id, 1u,
+                                                    m_neighbor_position, m_neighbor_velocity);
+  }
+
+  /** Returns the number of transmissions of the outstanding DATA packet, or 0. */
+  uint32_t
+  GetTransmissionsCount (const DataIdentifier & data_id) const
+  {
+    uint32_t transmissions_count = 0u;
+    m_routing_protocol->m_neighbors_table.FindOutstandingDataPacket (m_neighbor_ip, data_id,
+                                                                     transmissions_count);
+    return transmissions_count;
+  }
+
+  void
+  TestDataAckTimeoutEnabled ()
+  {
+    CreateRoutingProtocol (1u, 0u);
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->IsDataAckTimeoutEnabled (), false, "Must be false");
+
+    CreateRoutingProtocol (4u, 0u);
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->IsDataAckTimeoutEnabled (), true, "Must be true");
+
+    CreateRoutingProtocol (1u, 2u);
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->IsDataAckTimeoutEnabled (), true, "Must be true");
+
+    m_routing_protocol->Dispose ();
+  }
+
+  void
+  TestStopAndWait ()
+  {
+    CreateRoutingProtocol (1u, 0u);
+
+    // The sent packets aren't outstanding, so a lost ACK doesn't fill the
+    // send window.
+    TrackSentDataPacket (DataIdentifier ("1.1.1.1:1"));
+    TrackSentDataPacket (DataIdentifier ("1.1.1.1:2"));
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_neighbors_table.GetOutstandingDataPacketsCount (m_neighbor_ip),
+                           0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_data_ack_timeouts.empty (), true, "Must be true");
+
+    m_routing_protocol->Dispose ();
+  }
+
+  void
+  TestSendWindow ()
+  {
+    CreateRoutingProtocol (2u, 0u);
+
+    TrackSentDataPacket (DataIdentifier ("1.1.1.1:1"));
+    TrackSentDataPacket (DataIdentifier ("1.1.1.1:2"));
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_neighbors_table.GetOutstandingDataPacketsCount (m_neighbor_ip),
+                           2u, "Must be 2 (the send window is full)");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_data_ack_timeouts.size (), 2u, "Must be 2");
+
+    // ACK of the first packet received
+    m_routing_protocol->m_neighbors_table.RemoveOutstandingDataPacket (m_neighbor_ip, DataIdentifier ("1.1.1.1:1"));
+    m_routing_protocol->CancelDataAckTimeout (m_neighbor_ip, DataIdentifier ("1.1.1.1:1"));
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_neighbors_table.GetOutstandingDataPacketsCount (m_neighbor_ip),
+                           1u, "Must be 1");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_data_ack_timeouts.size (), 1u, "Must be 1");
+
+    // A new session forgets the outstanding packets and their timeouts.
+    m_routing_protocol->ResetDataSendSession (m_neighbor_ip);
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_neighbors_table.GetOutstandingDataPacketsCount (m_neighbor_ip),
+                           0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_data_ack_timeouts.empty (), true, "Must be true");
+
+    m_routing_protocol->Dispose ();
+  }
+
+  void
+  TestRetransmissions_Scheduled_1 ()
+  {
+    // This function is launched by the scheduler at second 0.15
+
+    // The packet 1.1.1.1:1 is retransmitted and waits for its ACK again. The
+    // packet 1.1.1.1:2 is no longer in the packets queue, so it is given up.
+    NS_TEST_EXPECT_MSG_EQ (GetTransmissionsCount (DataIdentifier ("1.1.1.1:1")), 2u, "Must be 2");
+    NS_TEST_EXPECT_MSG_EQ (GetTransmissionsCount (DataIdentifier ("1.1.1.1:2")), 0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_neighbors_table.GetOutstandingDataPacketsCount (m_neighbor_ip),
+                           1u, "Must be 1");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_data_ack_timeouts.size (), 1u, "Must be 1");
+  }
+
+  void
+  TestRetransmissions_Scheduled_2 ()
+  {
+    // This function is launched by the scheduler at second 0.25
+
+    // The retransmissions of the packet 1.1.1.1:1 are exhausted, so it is
+    // given up and its slot of the send window is free.
+    NS_TEST_EXPECT_MSG_EQ (GetTransmissionsCount (DataIdentifier ("1.1.1.1:1")), 0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_neighbors_table.GetOutstandingDataPacketsCount (m_neighbor_ip),
+                           0u, "Must be 0");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_data_ack_timeouts.empty (), true, "Must be true");
+  }
+
+  void
+  TestRetransmissions ()
+  {
+    CreateRoutingProtocol (2u, 1u);
+
+    EnqueueDataPacket (DataIdentifier ("1.1.1.1:1"));
+
+    TrackSentDataPacket (DataIdentifier ("1.1.1.1:1"));
+    TrackSentDataPacket (DataIdentifier ("1.1.1.1:2"));
+
+    NS_TEST_EXPECT_MSG_EQ (GetTransmissionsCount (DataIdentifier ("1.1.1.1:1")), 1u, "Must be 1");
+    NS_TEST_EXPECT_MSG_EQ (GetTransmissionsCount (DataIdentifier ("1.1.1.1:2")), 1u, "Must be 1");
+
+    // The ACK timeouts expire at second 0.1 and 0.2
+    Simulator::Schedule (Seconds (0.15), &RoutingProtocolTest::TestRetransmissions_Scheduled_1, this);
+    Simulator::Schedule (Seconds (0.25), &RoutingProtocolTest::TestRetransmissions_Scheduled_2, this);
+
+    Simulator::Run ();
+
+    m_routing_protocol->Dispose ();
+    Simulator::Destroy ();
+  }
+
+  /** Number of times that the HELLO interval trace was fired. */
+  uint32_t m_hello_interval_changes;
+
+  /** Last HELLO interval reported by the HELLO interval trace. */
+  Time m_traced_hello_interval;
+
+  void
+  HelloIntervalChanged (Time hello_interval, double neighbors_average)
+  {
+    ++m_hello_interval_changes;
+    m_traced_hello_interval = hello_interval;
+  }
+
+  /** Enables the adaptive HELLO interval with the given bounds. */
+  void
+  SetAdaptiveHelloInterval (const Time & hello_interval, const Time & min_hello_interval,
+                            const Time & max_hello_interval)
+  {
+    m_routing_protocol->m_adaptive_hello_interval = true;
+    m_routing_protocol->m_hello_timeout = hello_interval;
+    m_routing_protocol->m_min_hello_interval = min_hello_interval;
+    m_routing_protocol->m_max_hello_interval = max_hello_interval;
+    m_routing_protocol->m_hello_interval_reference_neighbors = 10.0;
+    m_routing_protocol->m_exponential_average = 0.0;
+  }
+
+  void
+  TestCalculateHelloInterval ()
+  {
+    CreateRoutingProtocol (1u, 0u);
+
+    // Disabled adaptive HELLO interval
+    m_routing_protocol->m_hello_timeout = MilliSeconds (500);
+    m_routing_protocol->m_exponential_average = 40.0;
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->CalculateHelloInterval (), MilliSeconds (500), "Must be 500 ms");
+
+    // The default minimum is the HELLO interval, so a HELLO interval shorter
+    // than 1 second is kept.
+    SetAdaptiveHelloInterval (MilliSeconds (500), Seconds (0), Seconds (5));
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->GetMinHelloInterval (), MilliSeconds (500), "Must be 500 ms");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->CalculateHelloInterval (), MilliSeconds (500), "Must be 500 ms");
+
+    // Fewer neighbors than the reference ones don't change the interval.
+    m_routing_protocol->m_exponential_average = 5.0;
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->CalculateHelloInterval (), MilliSeconds (500), "Must be 500 ms");
+
+    // The interval grows with the density of neighbors...
+    m_routing_protocol->m_exponential_average = 40.0;
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->CalculateHelloInterval (), Seconds (2), "Must be 2 seconds");
+
+    // ...up to the maximum HELLO interval.
+    m_routing_protocol->m_exponential_average = 200.0;
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->CalculateHelloInterval (), Seconds (5), "Must be 5 seconds");
+
+    // A half-full packets queue halves the growth.
+    m_routing_protocol->m_exponential_average = 40.0;
+
+    for (uint16_t i = 0u; i < m_routing_protocol->m_packets_queue.GetMaxLength () / 2u; ++i)
+      EnqueueDataPacket (DataIdentifier (Ipv4Address ("1.1.1.1"), i));
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->CalculateHelloInterval (), MilliSeconds (1250),
+                           "Must be 1.25 seconds");
+
+    // An explicit minimum bounds the interval.
+    CreateRoutingProtocol (1u, 0u);
+    SetAdaptiveHelloInterval (MilliSeconds (500), Seconds (1), Seconds (5));
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->GetMinHelloInterval (), Seconds (1), "Must be 1 second");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->CalculateHelloInterval (), Seconds (1), "Must be 1 second");
+
+    m_routing_protocol->Dispose ();
+  }
+
+  void
+  TestHelloIntervalTrace ()
+  {
+    CreateRoutingProtocol (1u, 0u);
+    SetAdaptiveHelloInterval (Seconds (1), Seconds (0), Seconds (5));
+
+    m_hello_interval_changes = 0u;
+    m_traced_hello_interval = Seconds (0);
+
+    m_routing_protocol->TraceConnectWithoutContext ("HelloInterval",
+                                                    MakeCallback (&RoutingProtocolTest::HelloIntervalChanged,
+                                                                  this));
+    m_routing_protocol->m_hello_timer.SetFunction (&RoutingProtocol::HelloTimerExpire,
+                                                 PeekPointer (m_routing_protocol));
+    m_routing_protocol->m_current_hello_interval = Seconds (1);
+
+    // The interval doesn't change, so it isn't traced.
+    m_routing_protocol->ScheduleHelloPacketTransmission ();
+
+    NS_TEST_EXPECT_MSG_EQ (m_hello_interval_changes, 0u, "Must be 0");
+
+    // A denser neighborhood changes it.
+    m_routing_protocol->m_exponential_average = 30.0;
+    m_routing_protocol->ScheduleHelloPacketTransmission ();
+
+    NS_TEST_EXPECT_MSG_EQ (m_hello_interval_changes, 1u, "Must be 1");
+    NS_TEST_EXPECT_MSG_EQ (m_traced_hello_interval, Seconds (3), "Must be 3 seconds");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_current_hello_interval, Seconds (3), "Must be 3 seconds");
+
+    // The same interval again isn't traced.
+    m_routing_protocol->ScheduleHelloPacketTransmission ();
+
+    NS_TEST_EXPECT_MSG_EQ (m_hello_interval_changes, 1u, "Must be 1");
+
+    m_routing_protocol->Dispose ();
+    Simulator::Destroy ();
+  }
+
+  void
+  TestSynchronizedDigests_Scheduled_1 ()
+  {
+    // This function is launched by the scheduler at second 31
+
+    // The synchronized digests expired.
+    m_routing_protocol->PurgeSynchronizedDigests ();
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_synchronized_digests.empty (), true, "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->IsRedundantSession (m_neighbor_ip, 0x1234u), false,
+                           "Must be false");
+  }
+
+  void
+  TestSynchronizedDigests ()
+  {
+    CreateRoutingProtocol (1u, 0u);
+    m_routing_protocol->m_neighbors_table = NeighborsTable (Seconds (10));
+
+    const uint32_t local_digest = m_routing_protocol->m_packets_queue.GetSummaryVectorDigest ();
+    const RoutingProtocol::SynchronizedDigests session_digests = {0x1234u, local_digest, Seconds (30), false};
+
+    // Sessions started with two neighbor nodes, only one of them is still in
+    // the neighbors table.
+    m_routing_protocol->m_neighbors_table.Insert (m_neighbor_ip);
+    m_routing_protocol->m_synchronized_digests[m_neighbor_ip] = session_digests;
+    m_routing_protocol->m_synchronized_digests[Ipv4Address ("3.3.3.3")] = session_digests;
+
+    // The digests of a session that wasn't completed aren't used.
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->IsRedundantSession (m_neighbor_ip, 0x1234u), false,
+                           "Must be false");
+
+    // The session that isn't in the neighbors table anymore is over.
+    m_routing_protocol->PurgeSynchronizedDigests ();
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_synchronized_digests.size (), 1u, "Must be 1");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->m_synchronized_digests.count (m_neighbor_ip), 1u, "Must be 1");
+
+    // Once completed, the same digests make the next session redundant.
+    m_routing_protocol->CompleteSynchronizedSession (m_neighbor_ip);
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->IsRedundantSession (m_neighbor_ip, 0x1234u), true,
+                           "Must be true");
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->IsRedundantSession (m_neighbor_ip, 0x5678u), false,
+                           "Must be false");
+
+    // Equal digests skip the session, but they may collide, so the neighbor 
+    // node isn't recorded as a carrier of the local packets.
+    const DataIdentifier data_id ("1.1.1.1:1");
+    EnqueueDataPacket (data_id);
+
+    NS_TEST_EXPECT_MSG_EQ (m_routing_protocol->IsRedundantSession (Ipv4Address ("4.4.4.4"),
+                                                                   m_routing_protocol->m_packets_queue
+                                                                   .GetSummaryVectorDigest ()),
+                           true, "Must be true");
+
+    PacketQueueEntry packet_entry;
+    NS_TEST_ASSERT_MSG_EQ (m_routing_protocol->m_packets_queue.Find (data_id, packet_entry), true,
+                           "Must be found");
+    NS_TEST_EXPECT_MSG_EQ (packet_entry.IsKnownCarrierNode (Ipv4Address ("4.4.4.4")), false,
+                           "Must be false");
+
+    Simulator::Schedule (Seconds (31), &RoutingProtocolTest::TestSynchronizedDigests_Scheduled_1, this);
+
+    Simulator::Run ();
+
+    m_routing_protocol->Dispose ();
+    Simulator::Destroy ();
+  }
+
+  void
+  DoRun () override
+  {
+    TestDataAckTimeoutEnabled ();
+    TestStopAndWait ();
+    TestSendWindow ();
+    TestRetransmissions ();
+    TestCalculateHelloInterval ();
+    TestHelloIntervalTrace ();
+    TestSynchronizedDigests ();
+  }
+};
+
+
 // =============================================================================
 //                              GeoTemporalTestSuite
 // =============================================================================
@@ -8180,11 +9875,14 @@ public:
     AddTestCase (new AckHeaderTest, TestCase::QUICK);
     AddTestCase (new DataHeaderTest, TestCase::QUICK);
     AddTestCase (new DataAckHeaderTest, TestCase::QUICK);
+    AddTestCase (new AggregatedDataHeaderTest, TestCase::QUICK);
+    AddTestCase (new AggregatedAckHeaderTest, TestCase::QUICK);
     AddTestCase (new NeighborEntryTest, TestCase::QUICK);
     AddTestCase (new NeighborsTableTest, TestCase::QUICK);
     AddTestCase (new PacketQueueEntryTest, TestCase::QUICK);
     AddTestCase (new PacketsQueueTest, TestCase::QUICK);
     AddTestCase (new DuplicatedPacketDetectorTest, TestCase::QUICK);
+    AddTestCase (new RoutingProtocolTest, TestCase::QUICK);
   }
 };
 